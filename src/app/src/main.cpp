@@ -6,13 +6,16 @@
 #include "imgui_impl_glfw.h"
 #include "rocprofvis_core.h"
 #include "rocprofvis_core_assert.h"
+#include "rocprofvis_core_profile.h"
 #include "rocprofvis_imgui_backend.h"
 #define GLFW_INCLUDE_NONE
 #include "AMD_LOGO.h"
+#include "rocprofvis_batch_runner.h"
 #include "rocprofvis_cli_parser.h"
 #include "rocprofvis_version.h"
 #include "rocprofvis_view_module.h"
 #include "widgets/rocprofvis_image_helpers.h"
+#include "spdlog/sinks/stdout_color_sinks.h"
 #ifdef __APPLE__
 #include "rocprofvis_platform_helpers.h"
 #endif
@@ -194,6 +197,19 @@ parse_command_line_args(int argc, char** argv, RocProfVis::View::CLIParser& cli_
         "Set file dialog backend: 'auto' (default), 'native' (system file "
         "dialog), or 'imgui' (built-in). Use 'imgui' when running over SSH",
         true);
+    result &= cli_parser.AddOption(
+        "s", "batch",
+        "Run the queries in a batch script against --file without opening a "
+        "window, then exit",
+        true);
+    result &= cli_parser.AddOption(
+        "o", "output", "Write batch results as JSON to this path instead of stdout",
+        true);
+    result &= cli_parser.AddOption(
+        "p", "self-profile",
+        "Record a performance capture of Optiq itself and write it as a Chrome "
+        "trace to this path on exit",
+        true);
     result &= cli_parser.AddOption("h", "help",
         "Show this help message and exit", false);
     ROCPROFVIS_ASSERT(result);
@@ -240,6 +256,38 @@ main(int argc, char** argv)
         return app_result_code;
     }
 
+    std::string self_profile_path = cli_parser.GetOptionValue("self-profile");
+    if(!self_profile_path.empty())
+    {
+        RocProfVis::Core::Profiler::SetEnabled(true);
+    }
+
+    // Headless batch mode never touches GLFW or ImGui, so it runs on CPU-only hosts
+    if(cli_parser.WasOptionFound("batch"))
+    {
+        // Log to stderr so CI captures it, stdout may carry the JSON results
+        spdlog::set_default_logger(spdlog::stderr_color_mt("batch"));
+
+        std::string trace_path = cli_parser.GetOptionValue("file");
+        if(trace_path.empty())
+        {
+            spdlog::error("--batch requires a trace passed with --file");
+            return 1;
+        }
+        RocProfVis::View::BatchRunner batch_runner(trace_path,
+                                                   cli_parser.GetOptionValue("output"));
+        if(!batch_runner.LoadScript(cli_parser.GetOptionValue("batch")))
+        {
+            return 1;
+        }
+        app_result_code = batch_runner.Run();
+        if(!self_profile_path.empty())
+        {
+            RocProfVis::Core::Profiler::ExportChromeTrace(self_profile_path);
+        }
+        return app_result_code;
+    }
+
     std::string log_dir = rocprofvis_get_application_log_path();
 #ifndef NDEBUG
     std::filesystem::path log_path =
@@ -491,5 +539,10 @@ main(int argc, char** argv)
         app_result_code = 1;
     }
 
+    if(!self_profile_path.empty())
+    {
+        RocProfVis::Core::Profiler::ExportChromeTrace(self_profile_path);
+    }
+
     return app_result_code;
 }
@@ -0,0 +1,708 @@
+// Copyright Advanced Micro Devices, Inc.
+// SPDX-License-Identifier: MIT
+
+#include "rocprofvis_batch_runner.h"
+#include "rocprofvis_controller.h"
+#include "rocprofvis_json_utils.h"
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+namespace RocProfVis
+{
+namespace View
+{
+
+constexpr uint64_t DEFAULT_TOP_KERNEL_COUNT = 10;
+
+static rocprofvis_result_t
+WaitForFuture(rocprofvis_controller_future_t* future)
+{
+    rocprofvis_result_t result = rocprofvis_controller_future_wait(future, FLT_MAX);
+    if(result == kRocProfVisResultSuccess)
+    {
+        uint64_t future_result = kRocProfVisResultUnknownError;
+        result = rocprofvis_controller_get_uint64(future, kRPVControllerFutureResult, 0,
+                                                  &future_result);
+        if(result == kRocProfVisResultSuccess)
+        {
+            result = static_cast<rocprofvis_result_t>(future_result);
+        }
+    }
+    return result;
+}
+
+static std::string
+GetString(rocprofvis_handle_t* handle, uint32_t property, uint64_t index)
+{
+    std::string value;
+    uint32_t    length = 0;
+    if(rocprofvis_controller_get_string(handle, property, index, nullptr, &length) ==
+           kRocProfVisResultSuccess &&
+       length > 0)
+    {
+        value.resize(length);
+        rocprofvis_controller_get_string(handle, property, index,
+                                         const_cast<char*>(value.c_str()), &length);
+        value.resize(length);
+    }
+    return value;
+}
+
+// Commands that touch the same controller object run in order on one task, the
+// groups themselves run in parallel.
+static const char*
+GetCommandGroup(const std::string& name)
+{
+    if(name == "top-kernels" || name == "gpu-utilization")
+    {
+        return "summary";
+    }
+    if(name == "export-events")
+    {
+        return "event-table";
+    }
+    if(name == "export-samples")
+    {
+        return "sample-table";
+    }
+    if(name == "trim")
+    {
+        return "trim";
+    }
+    return "tracks";
+}
+
+BatchRunner::BatchRunner(const std::string& trace_path, const std::string& output_path)
+: m_trace_path(trace_path)
+, m_output_path(output_path)
+, m_controller(nullptr)
+, m_summary_metrics(nullptr)
+, m_start_ts(0)
+, m_end_ts(0)
+{}
+
+BatchRunner::~BatchRunner()
+{
+    if(m_summary_metrics)
+    {
+        rocprofvis_controller_summary_metric_free(m_summary_metrics);
+    }
+    if(m_controller)
+    {
+        rocprofvis_controller_free(m_controller);
+    }
+}
+
+bool
+BatchRunner::LoadScript(const std::string& script_path)
+{
+    std::ifstream file(script_path);
+    if(!file)
+    {
+        spdlog::error("Failed to open batch script: {}", script_path);
+        return false;
+    }
+    return ParseScript(file);
+}
+
+bool
+BatchRunner::ParseScript(std::istream& script)
+{
+    bool        valid = true;
+    std::string line;
+    while(std::getline(script, line))
+    {
+        size_t comment = line.find('#');
+        if(comment != std::string::npos)
+        {
+            line.resize(comment);
+        }
+
+        Command            command;
+        std::istringstream tokens(line);
+        if(!(tokens >> command.name))
+        {
+            continue;
+        }
+        std::string arg;
+        while(tokens >> arg)
+        {
+            command.args.push_back(arg);
+        }
+        command.line = line.substr(line.find_first_not_of(" \t"));
+
+        size_t expected_args = 0;
+        if(command.name == "top-kernels")
+        {
+            // The count is optional
+            expected_args = std::min<size_t>(command.args.size(), 1);
+        }
+        else if(command.name == "gpu-utilization" || command.name == "counter-stats")
+        {
+            expected_args = 0;
+        }
+        else if(command.name == "export-events" || command.name == "export-samples")
+        {
+            expected_args = 1;
+        }
+        else if(command.name == "trim")
+        {
+            expected_args = 3;
+        }
+        else
+        {
+            spdlog::error("Unknown batch command: {}", command.line);
+            valid = false;
+            continue;
+        }
+        if(command.args.size() != expected_args)
+        {
+            spdlog::error("Wrong number of arguments for batch command: {}",
+                          command.line);
+            valid = false;
+            continue;
+        }
+        m_commands.push_back(std::move(command));
+    }
+    return valid;
+}
+
+bool
+BatchRunner::LoadTrace()
+{
+    m_controller = rocprofvis_controller_alloc(m_trace_path.c_str(), nullptr);
+    if(!m_controller)
+    {
+        spdlog::error("Failed to open trace: {}", m_trace_path);
+        return false;
+    }
+
+    rocprofvis_controller_future_t* future = rocprofvis_controller_future_alloc();
+    rocprofvis_result_t result = rocprofvis_controller_load_async(m_controller, future);
+    if(result == kRocProfVisResultSuccess)
+    {
+        result = WaitForFuture(future);
+    }
+    rocprofvis_controller_future_free(future);
+
+    if(result != kRocProfVisResultSuccess)
+    {
+        spdlog::error("Failed to load trace: {} ({})", m_trace_path,
+                      static_cast<int>(result));
+        return false;
+    }
+    return ReadTimelineRange();
+}
+
+bool
+BatchRunner::ReadTimelineRange()
+{
+    rocprofvis_handle_t* timeline = nullptr;
+    rocprofvis_result_t  result   = rocprofvis_controller_get_object(
+        m_controller, kRPVControllerSystemTimeline, 0, &timeline);
+    if(result == kRocProfVisResultSuccess)
+    {
+        result = rocprofvis_controller_get_double(
+            timeline, kRPVControllerTimelineMinTimestamp, 0, &m_start_ts);
+    }
+    if(result == kRocProfVisResultSuccess)
+    {
+        result = rocprofvis_controller_get_double(
+            timeline, kRPVControllerTimelineMaxTimestamp, 0, &m_end_ts);
+    }
+    if(result != kRocProfVisResultSuccess)
+    {
+        spdlog::error("Failed to read the timeline range of {}", m_trace_path);
+        return false;
+    }
+    return true;
+}
+
+int
+BatchRunner::Run()
+{
+    jt::Json output;
+    output.setObject();
+    output["trace"] = m_trace_path;
+
+    bool loaded = LoadTrace();
+    output["loaded"] = loaded;
+
+    std::vector<jt::Json> results(m_commands.size());
+    bool                  succeeded = loaded;
+    if(loaded)
+    {
+        output["start_ts"] = m_start_ts;
+        output["end_ts"]   = m_end_ts;
+
+        std::map<std::string, std::vector<size_t>> groups;
+        for(size_t i = 0; i < m_commands.size(); i++)
+        {
+            groups[GetCommandGroup(m_commands[i].name)].push_back(i);
+        }
+
+        std::vector<std::future<bool>> tasks;
+        for(const auto& [group, indices] : groups)
+        {
+            tasks.push_back(std::async(std::launch::async, [this, &results, &indices]() {
+                bool group_succeeded = true;
+                for(size_t index : indices)
+                {
+                    const Command& command = m_commands[index];
+                    jt::Json&      entry   = results[index];
+                    std::string    error;
+                    jt::Json       result;
+                    result.setObject();
+
+                    spdlog::info("Batch: {}", command.line);
+                    rocprofvis_result_t code = RunCommand(command, result, error);
+
+                    entry.setObject();
+                    entry["command"] = command.line;
+                    entry["status"] =
+                        code == kRocProfVisResultSuccess ? "success" : "failed";
+                    if(code == kRocProfVisResultSuccess)
+                    {
+                        entry["result"] = result;
+                    }
+                    else
+                    {
+                        entry["error"] = error.empty()
+                                             ? "controller error " +
+                                                   std::to_string(static_cast<int>(code))
+                                             : error;
+                        group_succeeded = false;
+                    }
+                }
+                return group_succeeded;
+            }));
+        }
+        for(std::future<bool>& task : tasks)
+        {
+            succeeded &= task.get();
+        }
+    }
+    else
+    {
+        for(size_t i = 0; i < m_commands.size(); i++)
+        {
+            results[i].setObject();
+            results[i]["command"] = m_commands[i].line;
+            results[i]["status"]  = "skipped";
+        }
+    }
+
+    jt::Json& commands = output["commands"];
+    commands.setArray();
+    for(jt::Json& entry : results)
+    {
+        commands.getArray().push_back(entry);
+    }
+
+    if(m_output_path.empty())
+    {
+        std::cout << output.toStringPretty() << std::endl;
+    }
+    else if(!JsonUtils::WriteFile(m_output_path, output, true))
+    {
+        succeeded = false;
+    }
+    return succeeded ? 0 : 1;
+}
+
+rocprofvis_result_t
+BatchRunner::RunCommand(const Command& command, jt::Json& result, std::string& error)
+{
+    if(command.name == "top-kernels" || command.name == "gpu-utilization")
+    {
+        return RunSummary(command, result, error);
+    }
+    if(command.name == "counter-stats")
+    {
+        return RunCounterStats(result);
+    }
+    if(command.name == "export-events" || command.name == "export-samples")
+    {
+        return RunTableExport(command, result, error);
+    }
+    if(command.name == "trim")
+    {
+        return RunTrim(command, result, error);
+    }
+    return kRocProfVisResultInvalidArgument;
+}
+
+rocprofvis_result_t
+BatchRunner::RunSummary(const Command& command, jt::Json& result, std::string& error)
+{
+    rocprofvis_result_t code = kRocProfVisResultSuccess;
+
+    // Both summary commands read the same full-range metrics, fetch them only once
+    if(!m_summary_metrics)
+    {
+        rocprofvis_handle_t* summary = nullptr;
+        code = rocprofvis_controller_get_object(m_controller, kRPVControllerSystemSummary,
+                                                0, &summary);
+        if(code != kRocProfVisResultSuccess)
+        {
+            return code;
+        }
+
+        rocprofvis_controller_arguments_t* args = rocprofvis_controller_arguments_alloc();
+        rocprofvis_controller_set_double(args, kRPVControllerSummaryArgsStartTimestamp, 0,
+                                         m_start_ts);
+        rocprofvis_controller_set_double(args, kRPVControllerSummaryArgsEndTimestamp, 0,
+                                         m_end_ts);
+
+        rocprofvis_controller_summary_metrics_t* metrics =
+            rocprofvis_controller_summary_metrics_alloc();
+        rocprofvis_controller_future_t* future = rocprofvis_controller_future_alloc();
+        code = rocprofvis_controller_summary_fetch_async(
+            m_controller, static_cast<rocprofvis_controller_summary_t*>(summary), args,
+            future, metrics);
+        if(code == kRocProfVisResultSuccess)
+        {
+            code = WaitForFuture(future);
+        }
+        rocprofvis_controller_future_free(future);
+        rocprofvis_controller_arguments_free(args);
+
+        if(code != kRocProfVisResultSuccess)
+        {
+            rocprofvis_controller_summary_metric_free(metrics);
+            return code;
+        }
+        m_summary_metrics = metrics;
+    }
+
+    uint64_t top_count = DEFAULT_TOP_KERNEL_COUNT;
+    if(command.name == "top-kernels" && !command.args.empty())
+    {
+        try
+        {
+            top_count = std::stoull(command.args[0]);
+        } catch(const std::exception&)
+        {
+            error = "Invalid kernel count: " + command.args[0];
+            return kRocProfVisResultInvalidArgument;
+        }
+    }
+
+    jt::Json& gpus = result["gpus"];
+    gpus.setArray();
+
+    // Walk trace -> node -> processor and report the GPU processors
+    std::vector<rocprofvis_handle_t*> pending = { m_summary_metrics };
+    while(!pending.empty())
+    {
+        rocprofvis_handle_t* metrics = pending.back();
+        pending.pop_back();
+
+        uint64_t num_sub = 0;
+        rocprofvis_controller_get_uint64(
+            metrics, kRPVControllerSummaryMetricPropertyNumSubMetrics, 0, &num_sub);
+        for(uint64_t i = 0; i < num_sub; i++)
+        {
+            rocprofvis_handle_t* sub = nullptr;
+            if(rocprofvis_controller_get_object(
+                   metrics, kRPVControllerSummaryMetricPropertySubMetricsIndexed, i,
+                   &sub) == kRocProfVisResultSuccess &&
+               sub)
+            {
+                pending.push_back(sub);
+            }
+        }
+
+        uint64_t level     = 0;
+        uint64_t proc_type = 0;
+        rocprofvis_controller_get_uint64(
+            metrics, kRPVControllerSummaryMetricPropertyAggregationLevel, 0, &level);
+        if(level != kRPVControllerSummaryAggregationLevelProcessor ||
+           rocprofvis_controller_get_uint64(
+               metrics, kRPVControllerSummaryMetricPropertyProcessorType, 0,
+               &proc_type) != kRocProfVisResultSuccess ||
+           proc_type != kRPVControllerProcessorTypeGPU)
+        {
+            continue;
+        }
+
+        uint64_t id         = 0;
+        uint64_t type_index = 0;
+        rocprofvis_controller_get_uint64(metrics, kRPVControllerSummaryMetricPropertyId,
+                                         0, &id);
+        rocprofvis_controller_get_uint64(
+            metrics, kRPVControllerSummaryMetricPropertyProcessorTypeIndex, 0,
+            &type_index);
+
+        jt::Json gpu;
+        gpu.setObject();
+        gpu["id"]    = static_cast<long long>(id);
+        gpu["index"] = static_cast<long long>(type_index);
+        gpu["name"]  = GetString(metrics, kRPVControllerSummaryMetricPropertyName, 0);
+
+        if(command.name == "gpu-utilization")
+        {
+            double gfx_util = 0;
+            double mem_util = 0;
+            if(rocprofvis_controller_get_double(
+                   metrics, kRPVControllerSummaryMetricPropertyGpuGfxUtil, 0,
+                   &gfx_util) == kRocProfVisResultSuccess &&
+               rocprofvis_controller_get_double(
+                   metrics, kRPVControllerSummaryMetricPropertyGpuMemUtil, 0,
+                   &mem_util) == kRocProfVisResultSuccess)
+            {
+                gpu["gfx_util"] = gfx_util;
+                gpu["mem_util"] = mem_util;
+            }
+        }
+        else
+        {
+            uint64_t num_kernels = 0;
+            double   exec_total  = 0;
+            rocprofvis_controller_get_uint64(
+                metrics, kRPVControllerSummaryMetricPropertyNumKernels, 0, &num_kernels);
+            rocprofvis_controller_get_double(
+                metrics, kRPVControllerSummaryMetricPropertyKernelsExecTimeTotal, 0,
+                &exec_total);
+            gpu["exec_time_total"] = exec_total;
+
+            jt::Json& kernels = gpu["kernels"];
+            kernels.setArray();
+            for(uint64_t k = 0; k < num_kernels && k < top_count; k++)
+            {
+                uint64_t invocations = 0;
+                double   exec_sum    = 0;
+                double   exec_min    = 0;
+                double   exec_max    = 0;
+                double   exec_pct    = 0;
+                rocprofvis_controller_get_uint64(
+                    metrics, kRPVControllerSummaryMetricPropertyKernelInvocationsIndexed,
+                    k, &invocations);
+                rocprofvis_controller_get_double(
+                    metrics, kRPVControllerSummaryMetricPropertyKernelExecTimeSumIndexed,
+                    k, &exec_sum);
+                rocprofvis_controller_get_double(
+                    metrics, kRPVControllerSummaryMetricPropertyKernelExecTimeMinIndexed,
+                    k, &exec_min);
+                rocprofvis_controller_get_double(
+                    metrics, kRPVControllerSummaryMetricPropertyKernelExecTimeMaxIndexed,
+                    k, &exec_max);
+                rocprofvis_controller_get_double(
+                    metrics, kRPVControllerSummaryMetricPropertyKernelExecTimePctIndexed,
+                    k, &exec_pct);
+
+                jt::Json kernel;
+                kernel.setObject();
+                kernel["name"] = GetString(
+                    metrics, kRPVControllerSummaryMetricPropertyKernelNameIndexed, k);
+                kernel["invocations"] = static_cast<long long>(invocations);
+                kernel["exec_time_sum"] = exec_sum;
+                kernel["exec_time_min"] = exec_min;
+                kernel["exec_time_max"] = exec_max;
+                kernel["exec_time_pct"] = exec_pct;
+                kernels.getArray().push_back(kernel);
+            }
+        }
+        gpus.getArray().push_back(gpu);
+    }
+    return kRocProfVisResultSuccess;
+}
+
+rocprofvis_result_t
+BatchRunner::RunCounterStats(jt::Json& result)
+{
+    uint64_t            num_tracks = 0;
+    rocprofvis_result_t code       = rocprofvis_controller_get_uint64(
+        m_controller, kRPVControllerSystemNumTracks, 0, &num_tracks);
+    if(code != kRocProfVisResultSuccess)
+    {
+        return code;
+    }
+
+    jt::Json& counters = result["counters"];
+    counters.setArray();
+    for(uint64_t i = 0; i < num_tracks; i++)
+    {
+        rocprofvis_handle_t* track = nullptr;
+        uint64_t             type  = 0;
+        if(rocprofvis_controller_get_object(m_controller,
+                                            kRPVControllerSystemTrackIndexed, i,
+                                            &track) != kRocProfVisResultSuccess ||
+           !track ||
+           rocprofvis_controller_get_uint64(track, kRPVControllerTrackType, 0, &type) !=
+               kRocProfVisResultSuccess ||
+           type != kRPVControllerTrackTypeSamples)
+        {
+            continue;
+        }
+
+        uint64_t id          = 0;
+        uint64_t num_samples = 0;
+        double   min_value   = 0;
+        double   max_value   = 0;
+        double   min_ts      = 0;
+        double   max_ts      = 0;
+        rocprofvis_controller_get_uint64(track, kRPVControllerTrackId, 0, &id);
+        rocprofvis_controller_get_uint64(track, kRPVControllerTrackNumberOfEntries, 0,
+                                         &num_samples);
+        rocprofvis_controller_get_double(track, kRPVControllerTrackMinValue, 0,
+                                         &min_value);
+        rocprofvis_controller_get_double(track, kRPVControllerTrackMaxValue, 0,
+                                         &max_value);
+        rocprofvis_controller_get_double(track, kRPVControllerTrackMinTimestamp, 0,
+                                         &min_ts);
+        rocprofvis_controller_get_double(track, kRPVControllerTrackMaxTimestamp, 0,
+                                         &max_ts);
+
+        jt::Json counter;
+        counter.setObject();
+        counter["track_id"]  = static_cast<long long>(id);
+        counter["main_name"] = GetString(track, kRPVControllerTrackMainName, 0);
+        counter["sub_name"]  = GetString(track, kRPVControllerTrackSubName, 0);
+        counter["samples"]   = static_cast<long long>(num_samples);
+        counter["min_value"] = min_value;
+        counter["max_value"] = max_value;
+        counter["start_ts"]  = min_ts;
+        counter["end_ts"]    = max_ts;
+        counters.getArray().push_back(counter);
+    }
+    return kRocProfVisResultSuccess;
+}
+
+rocprofvis_result_t
+BatchRunner::RunTableExport(const Command& command, jt::Json& result, std::string& error)
+{
+    bool events = command.name == "export-events";
+
+    rocprofvis_handle_t* table = nullptr;
+    rocprofvis_result_t  code  = rocprofvis_controller_get_object(
+        m_controller, events ? kRPVControllerSystemEventTable : kRPVControllerSystemSampleTable,
+        0, &table);
+    uint64_t num_tracks = 0;
+    if(code == kRocProfVisResultSuccess)
+    {
+        code = rocprofvis_controller_get_uint64(m_controller,
+                                                kRPVControllerSystemNumTracks, 0,
+                                                &num_tracks);
+    }
+    if(code != kRocProfVisResultSuccess)
+    {
+        return code;
+    }
+
+    rocprofvis_controller_arguments_t* args = rocprofvis_controller_arguments_alloc();
+    rocprofvis_controller_set_uint64(
+        args, kRPVControllerTableArgsType, 0,
+        static_cast<uint64_t>(events ? kRPVControllerTableTypeEvents
+                                     : kRPVControllerTableTypeSamples));
+
+    uint64_t track_type  = events ? kRPVControllerTrackTypeEvents
+                                  : kRPVControllerTrackTypeSamples;
+    uint64_t table_tracks = 0;
+    for(uint64_t i = 0; i < num_tracks; i++)
+    {
+        rocprofvis_handle_t* track = nullptr;
+        uint64_t             type  = 0;
+        if(rocprofvis_controller_get_object(m_controller,
+                                            kRPVControllerSystemTrackIndexed, i,
+                                            &track) == kRocProfVisResultSuccess &&
+           track &&
+           rocprofvis_controller_get_uint64(track, kRPVControllerTrackType, 0, &type) ==
+               kRocProfVisResultSuccess &&
+           type == track_type)
+        {
+            rocprofvis_controller_set_uint64(args, kRPVControllerTableArgsNumTracks, 0,
+                                             table_tracks + 1);
+            rocprofvis_controller_set_object(args, kRPVControllerTableArgsTracksIndexed,
+                                             table_tracks++, track);
+        }
+    }
+    if(table_tracks == 0)
+    {
+        rocprofvis_controller_arguments_free(args);
+        error = events ? "Trace has no event tracks" : "Trace has no sample tracks";
+        return kRocProfVisResultNotLoaded;
+    }
+
+    rocprofvis_controller_set_double(args, kRPVControllerTableArgsStartTime, 0,
+                                     m_start_ts);
+    rocprofvis_controller_set_double(args, kRPVControllerTableArgsEndTime, 0, m_end_ts);
+    rocprofvis_controller_set_uint64(args, kRPVControllerTableArgsSortColumn, 0, 0);
+    rocprofvis_controller_set_uint64(args, kRPVControllerTableArgsSortOrder, 0,
+                                     kRPVControllerSortOrderAscending);
+    rocprofvis_controller_set_string(args, kRPVControllerTableArgsWhere, 0, "");
+    rocprofvis_controller_set_string(args, kRPVControllerTableArgsFilter, 0, "");
+    rocprofvis_controller_set_string(args, kRPVControllerTableArgsGroup, 0, "");
+    rocprofvis_controller_set_string(args, kRPVControllerTableArgsGroupColumns, 0, "");
+
+    const std::string&              path   = command.args[0];
+    rocprofvis_controller_future_t* future = rocprofvis_controller_future_alloc();
+    code = rocprofvis_controller_table_export_csv(
+        m_controller, static_cast<rocprofvis_controller_table_t*>(table), args, future,
+        path.c_str());
+    if(code == kRocProfVisResultSuccess)
+    {
+        code = WaitForFuture(future);
+    }
+    rocprofvis_controller_future_free(future);
+    rocprofvis_controller_arguments_free(args);
+
+    if(code == kRocProfVisResultSuccess)
+    {
+        result["path"]   = path;
+        result["tracks"] = static_cast<long long>(table_tracks);
+    }
+    return code;
+}
+
+rocprofvis_result_t
+BatchRunner::RunTrim(const Command& command, jt::Json& result, std::string& error)
+{
+    double start_offset = 0;
+    double end_offset   = 0;
+    try
+    {
+        start_offset = std::stod(command.args[0]);
+        end_offset   = std::stod(command.args[1]);
+    } catch(const std::exception&)
+    {
+        error = "Invalid trim range: " + command.args[0] + " " + command.args[1];
+        return kRocProfVisResultInvalidArgument;
+    }
+
+    double start_ts = m_start_ts + start_offset;
+    double end_ts   = std::min(m_start_ts + end_offset, m_end_ts);
+    if(start_offset < 0 || start_ts >= end_ts)
+    {
+        error = "Trim range is empty or outside the trace";
+        return kRocProfVisResultInvalidArgument;
+    }
+
+    const std::string&              path   = command.args[2];
+    rocprofvis_controller_future_t* future = rocprofvis_controller_future_alloc();
+    rocprofvis_result_t             code   = rocprofvis_controller_save_trimmed_trace(
+        m_controller, start_ts, end_ts, path.c_str(), future);
+    if(code == kRocProfVisResultSuccess)
+    {
+        code = WaitForFuture(future);
+    }
+    rocprofvis_controller_future_free(future);
+
+    if(code == kRocProfVisResultSuccess)
+    {
+        result["path"]     = path;
+        result["start_ts"] = start_ts;
+        result["end_ts"]   = end_ts;
+    }
+    return code;
+}
+
+}  // namespace View
+}  // namespace RocProfVis
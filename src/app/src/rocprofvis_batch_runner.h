@@ -0,0 +1,78 @@
+// Copyright Advanced Micro Devices, Inc.
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "json.h"
+#include "rocprofvis_controller_enums.h"
+#include "rocprofvis_controller_types.h"
+
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace RocProfVis
+{
+namespace View
+{
+
+// Runs a script of queries against a single trace without creating a window or an
+// ImGui context. Commands are grouped by the controller object they use: commands
+// within a group run sequentially in script order, the groups run in parallel. The
+// combined results are written as one JSON document.
+//
+// Script format: one command per line, '#' starts a comment.
+//   top-kernels [count]                 Top kernels per GPU over the whole trace
+//   gpu-utilization                     GFX and memory utilization per GPU
+//   counter-stats                       Min/max value and sample count per counter
+//   export-events <csv path>            All event tracks through the event table
+//   export-samples <csv path>           All sample tracks through the sample table
+//   trim <start ns> <end ns> <db path>  Trim, times are offsets from trace start
+class BatchRunner
+{
+    friend struct BatchRunnerTestPeer;
+
+public:
+    BatchRunner(const std::string& trace_path, const std::string& output_path);
+    ~BatchRunner();
+
+    bool LoadScript(const std::string& script_path);
+
+    // Returns the process exit code: 0 when the trace loaded and every command
+    // succeeded, 1 otherwise.
+    int Run();
+
+private:
+    struct Command
+    {
+        std::string              line;
+        std::string              name;
+        std::vector<std::string> args;
+    };
+
+    // Appends the commands of a script, returns false if any line was rejected.
+    bool ParseScript(std::istream& script);
+    bool LoadTrace();
+    bool ReadTimelineRange();
+
+    rocprofvis_result_t RunCommand(const Command& command, jt::Json& result,
+                                   std::string& error);
+    rocprofvis_result_t RunSummary(const Command& command, jt::Json& result,
+                                   std::string& error);
+    rocprofvis_result_t RunCounterStats(jt::Json& result);
+    rocprofvis_result_t RunTableExport(const Command& command, jt::Json& result,
+                                       std::string& error);
+    rocprofvis_result_t RunTrim(const Command& command, jt::Json& result,
+                                std::string& error);
+
+    std::string                              m_trace_path;
+    std::string                              m_output_path;
+    std::vector<Command>                     m_commands;
+    rocprofvis_controller_t*                 m_controller;
+    rocprofvis_controller_summary_metrics_t* m_summary_metrics;
+    double                                   m_start_ts;
+    double                                   m_end_ts;
+};
+
+}  // namespace View
+}  // namespace RocProfVis
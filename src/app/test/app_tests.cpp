@@ -23,6 +23,7 @@
 #include "rocprofvis_settings_manager.h"
 #include "rocprofvis_utils.h"
 #include "rocprofvis_data_provider.h"
+#include "rocprofvis_raw_track_data.h"
 #include "model/rocprofvis_trace_data_model.h"
 #include "model/rocprofvis_timeline_model.h"
 #include "compute/rocprofvis_compute_view.h"
@@ -1225,6 +1226,44 @@ void RegisterAppTests(ImGuiTestEngine* e)
         ctx->Yield(2);
     };
 
+    t = IM_REGISTER_TEST(e, "app", "sys_flame_geometry_rebuilds_on_data");
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        TraceView* tv = GetTraceViewOrSkip(ctx);
+        if (!tv) return;
+        TimelineView* tlv = TraceViewTestPeer{*tv}.TimelineViewPtr();
+        IM_CHECK(tlv != nullptr);
+        if (tlv == nullptr) return;
+
+        // Wait for a flame track with events that has drawn its geometry once.
+        FlameTrackItem* flame = nullptr;
+        for (int i = 0; i < 60 && flame == nullptr; i++)
+        {
+            for (FlameTrackItem* candidate :
+                 TimelineViewTestPeer{*tlv}.DisplayedFlameTracks())
+            {
+                FlameTrackItemTestPeer peer{*candidate};
+                if (peer.ChartItemCount() > 0 && peer.GeometryCacheBuilt())
+                {
+                    flame = candidate;
+                    break;
+                }
+            }
+            if (flame == nullptr) ctx->Yield(2);
+        }
+        if (flame == nullptr)
+        {
+            ctx->LogWarning("SKIP: no flame track has drawn events");
+            return;
+        }
+
+        // New data drops the cached geometry, the next frame builds it again.
+        FlameTrackItemTestPeer{*flame}.ReextractData();
+        IM_CHECK(!FlameTrackItemTestPeer{*flame}.GeometryCacheBuilt());
+        ctx->Yield(2);
+        IM_CHECK(FlameTrackItemTestPeer{*flame}.GeometryCacheBuilt());
+    };
+
     t = IM_REGISTER_TEST(e, "app", "sys_timeline_measure_tool");
     t->TestFunc = [](ImGuiTestContext* ctx)
     {
@@ -1510,6 +1549,322 @@ void RegisterAppTests(ImGuiTestEngine* e)
         IM_CHECK(ids.empty());
     };
 
+    t = IM_REGISTER_TEST(e, "app", "common_prefetch_plan");
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        IM_UNUSED(ctx);
+        using Direction = DataProviderTestPeer::Direction;
+
+        // Stopping keeps the prefetch, only moving another way drops it.
+        IM_CHECK(!DataProviderTestPeer::IsPrefetchStale(Direction::kRight, Direction::kNone));
+        IM_CHECK(!DataProviderTestPeer::IsPrefetchStale(Direction::kZoomOut, Direction::kNone));
+        IM_CHECK(!DataProviderTestPeer::IsPrefetchStale(Direction::kLeft, Direction::kLeft));
+        IM_CHECK(DataProviderTestPeer::IsPrefetchStale(Direction::kRight, Direction::kLeft));
+        IM_CHECK(DataProviderTestPeer::IsPrefetchStale(Direction::kZoomOut, Direction::kRight));
+
+        // Loaded 1000-1300 at 900 pixels with a 100 wide view.
+        double   start_ts   = 0;
+        double   end_ts     = 0;
+        uint32_t resolution = 0;
+
+        // Panning reads one more viewport at the pixel density of the loaded range.
+        DataProviderTestPeer::GetPrefetchRange(Direction::kRight, 100, 1000, 1300, 900,
+                                               start_ts, end_ts, resolution);
+        IM_CHECK(start_ts == 1300.0);
+        IM_CHECK(end_ts == 1400.0);
+        IM_CHECK(resolution == 300u);
+
+        DataProviderTestPeer::GetPrefetchRange(Direction::kLeft, 100, 1000, 1300, 900,
+                                               start_ts, end_ts, resolution);
+        IM_CHECK(start_ts == 900.0);
+        IM_CHECK(end_ts == 1000.0);
+        IM_CHECK(resolution == 300u);
+
+        // Zooming out doubles the range on the same pixels, the next coarser level
+        // of detail.
+        DataProviderTestPeer::GetPrefetchRange(Direction::kZoomOut, 100, 1000, 1300, 900,
+                                               start_ts, end_ts, resolution);
+        IM_CHECK(start_ts == 850.0);
+        IM_CHECK(end_ts == 1450.0);
+        IM_CHECK(resolution == 900u);
+    };
+
+    t = IM_REGISTER_TEST(e, "app", "common_counter_decimation");
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        IM_UNUSED(ctx);
+
+        // One pixel per 10 ns. Column 0 holds 5 samples, column 1 holds 2 and
+        // column 3 holds 1.
+        auto samples = std::make_shared<std::vector<TraceCounter>>(std::vector<TraceCounter>{
+            { 0, 5, 1 }, { 1, 9, 2 }, { 2, 1, 3 }, { 3, 4, 4 }, { 4, 6, 10 },
+            { 10, 2, 15 }, { 15, 3, 30 }, { 30, 7, 31 } });
+
+        auto result = LineTrackItemTestPeer::Decimate(samples, 0.0, 0.1);
+        IM_CHECK(result != nullptr);
+        if(result == nullptr) return;
+        IM_CHECK(result->source == samples);
+        IM_CHECK(!result->passthrough);
+
+        // Column 0 keeps first, max, min and last in time order, the middle
+        // sample 3 is dropped. Columns with fewer samples are kept as is.
+        const std::vector<size_t> expected_indices = { 0, 1, 2, 4, 5, 6, 7 };
+        IM_CHECK(result->source_indices == expected_indices);
+        IM_CHECK(result->points.size() == expected_indices.size());
+        if(result->points.size() != expected_indices.size()) return;
+        for(size_t i = 0; i < expected_indices.size(); i++)
+        {
+            const TraceCounter& source = (*samples)[expected_indices[i]];
+            IM_CHECK(result->points[i].m_start_ts == source.m_start_ts);
+            IM_CHECK(result->points[i].m_value == source.m_value);
+        }
+        // A point followed by one of the same column is stretched to reach it,
+        // the last point of a column keeps its own end.
+        IM_CHECK(result->points[2].m_end_ts == 4.0);
+        IM_CHECK(result->points[3].m_end_ts == 10.0);
+        IM_CHECK(result->points[4].m_end_ts == 15.0);
+        IM_CHECK(result->points[6].m_end_ts == 31.0);
+
+        // Columns are aligned to min_x, not to the first sample. Moving the column
+        // edges to 4 ns splits the first column, leaving nothing to drop.
+        auto shifted = LineTrackItemTestPeer::Decimate(samples, -6.0, 0.1);
+        IM_CHECK(shifted != nullptr);
+        if(shifted == nullptr) return;
+        IM_CHECK(shifted->passthrough);
+
+        // Zoomed in to one sample per column nothing is reduced.
+        auto passthrough = LineTrackItemTestPeer::Decimate(samples, 0.0, 10.0);
+        IM_CHECK(passthrough != nullptr);
+        if(passthrough == nullptr) return;
+        IM_CHECK(passthrough->passthrough);
+        IM_CHECK(passthrough->points.empty());
+
+        // A cancelled decimation returns no result.
+        std::atomic<bool> cancelled{ true };
+        IM_CHECK(LineTrackItemTestPeer::Decimate(samples, 0.0, 0.1, &cancelled) == nullptr);
+    };
+
+    t = IM_REGISTER_TEST(e, "app", "common_track_chunk_dedup");
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        IM_UNUSED(ctx);
+
+        auto make_event = [](uint64_t uuid) {
+            TraceEvent event = {};
+            event.m_id.uuid  = uuid;
+            return event;
+        };
+        auto event_ids = [](const RawTrackEventData& data) {
+            std::vector<uint64_t> ids;
+            for(const TraceEvent& event : data.GetData())
+            {
+                ids.push_back(event.m_id.uuid);
+            }
+            return ids;
+        };
+
+        // Overlapping chunks, each id is kept once where it was first received,
+        // chunks are ordered by index rather than by arrival.
+        RawTrackEventData data(1, 0.0, 100.0, 0, 3);
+        IM_CHECK(data.AddChunk(2, { make_event(5), make_event(6), make_event(5) }));
+        IM_CHECK(data.AddChunk(0, { make_event(1), make_event(2), make_event(6) }));
+        IM_CHECK(data.AddChunk(1, { make_event(2), make_event(3), make_event(4) }));
+        IM_CHECK((event_ids(data) == std::vector<uint64_t>{ 1, 2, 3, 4, 5, 6 }));
+
+        // A chunk index is only accepted once.
+        IM_CHECK(!data.AddChunk(1, { make_event(7) }));
+        IM_CHECK(data.GetData().size() == 6);
+
+        // Counter samples are keyed by their start time.
+        RawTrackSampleData samples(2, 0.0, 100.0, 0, 2);
+        IM_CHECK(samples.AddChunk(0, { { 1.0, 5.0, 2.0 }, { 2.0, 6.0, 3.0 } }));
+        IM_CHECK(samples.AddChunk(1, { { 2.0, 6.0, 3.0 }, { 3.0, 7.0, 4.0 } }));
+        IM_CHECK(samples.GetData().size() == 3);
+
+        // The set grows past its initial capacity and starts empty after Clear.
+        TrackIdSet<uint64_t> ids;
+        bool                 all_inserted = true;
+        for(uint64_t id = 0; id < 1000; id++)
+        {
+            all_inserted = ids.Insert(id * 64) && all_inserted;
+        }
+        IM_CHECK(all_inserted);
+        IM_CHECK(!ids.Insert(640));
+        IM_CHECK(ids.Size() == 1000);
+        IM_CHECK(ids.Contains(63936));
+        IM_CHECK(!ids.Contains(65));
+
+        ids.Clear();
+        IM_CHECK(ids.Size() == 0);
+        IM_CHECK(!ids.Contains(640));
+        IM_CHECK(ids.Insert(640));
+        IM_CHECK(ids.Insert(641));
+        IM_CHECK(ids.Size() == 2);
+    };
+
+    t = IM_REGISTER_TEST(e, "app", "common_flame_geometry_cache");
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        IM_UNUSED(ctx);
+        using GeometryKey   = FlameTrackItemTestPeer::GeometryKey;
+        using GeometryCache = FlameTrackItemTestPeer::GeometryCache;
+        auto needs_rebuild  = [](const GeometryCache& cache, const GeometryKey& key,
+                                double pan_x) {
+            return FlameTrackItemTestPeer::NeedsGeometryRebuild(cache, key, pan_x);
+        };
+
+        GeometryKey key   = {};
+        key.pixels_per_ns = 0.5;
+        key.graph_width   = 800.0f;
+        key.level_height  = 20.0f;
+        key.box_height    = 18.0f;
+        key.font_size     = 14.0f;
+        key.flame_color   = IM_COL32(255, 0, 0, 255);
+        key.text_color    = IM_COL32(255, 255, 255, 255);
+
+        // A cache that was never built, or dropped for new data, is built.
+        GeometryCache cache;
+        IM_CHECK(needs_rebuild(cache, key, 0.0));
+
+        cache.built = true;
+        cache.valid = true;
+        cache.key   = key;
+        IM_CHECK(!needs_rebuild(cache, key, 0.0));
+
+        // Scrolling replays within one view width either side, then rebuilds.
+        IM_CHECK(!needs_rebuild(cache, key, 800.0));
+        IM_CHECK(!needs_rebuild(cache, key, -800.0));
+        IM_CHECK(needs_rebuild(cache, key, 801.0));
+        IM_CHECK(needs_rebuild(cache, key, -801.0));
+
+        // Zoom, resize, color and range selection changes all rebuild.
+        GeometryKey zoomed   = key;
+        zoomed.pixels_per_ns = 0.25;
+        IM_CHECK(needs_rebuild(cache, zoomed, 0.0));
+        GeometryKey resized = key;
+        resized.graph_width = 900.0f;
+        IM_CHECK(needs_rebuild(cache, resized, 0.0));
+        GeometryKey recolored = key;
+        recolored.flame_color = IM_COL32(0, 255, 0, 255);
+        IM_CHECK(needs_rebuild(cache, recolored, 0.0));
+        GeometryKey color_mode = key;
+        color_mode.color_mode  = 1;
+        IM_CHECK(needs_rebuild(cache, color_mode, 0.0));
+        GeometryKey ranged         = key;
+        ranged.has_range_selection = true;
+        ranged.range_end_ns        = 100.0;
+        IM_CHECK(needs_rebuild(cache, ranged, 0.0));
+
+        // A cache that drew nothing has no span to scroll out of.
+        cache.valid = false;
+        IM_CHECK(!needs_rebuild(cache, key, 5000.0));
+    };
+
+    t = IM_REGISTER_TEST(e, "app", "common_flame_label_prefix");
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        IM_UNUSED(ctx);
+        auto visible_length = [](const std::string& label, float available_width) {
+            return FlameTrackItemTestPeer::VisibleLabelLength(label, available_width);
+        };
+
+        // Empty names draw nothing.
+        IM_CHECK(visible_length("", 100.0f) == 0);
+
+        const std::string  label  = "hipMemcpyAsync";
+        std::vector<float> widths = FlameTrackItemTestPeer::LabelPrefixWidths(label);
+        IM_CHECK(widths.size() == label.size());
+        if(widths.size() != label.size()) return;
+
+        // Widths are measured at the current font.
+        const float measured = ImGui::GetFont()
+                                   ->CalcTextSizeA(ImGui::GetFontSize(), FLT_MAX, 0.0f,
+                                                   label.c_str())
+                                   .x;
+        IM_CHECK(std::fabs(widths.back() - measured) < 0.5f);
+
+        // A label that fits exactly or with room to spare is drawn in full.
+        IM_CHECK(visible_length(label, widths.back()) == label.size());
+        IM_CHECK(visible_length(label, widths.back() + 50.0f) == label.size());
+
+        // The character cut by the edge is drawn for the clip rect to trim, one
+        // starting exactly on the edge is drawn as well.
+        IM_CHECK(visible_length(label, widths[3] - 0.5f) == 4);
+        IM_CHECK(visible_length(label, widths[3]) == 5);
+        IM_CHECK(visible_length(label, 0.0f) == 1);
+
+        // Multi-byte characters are never split.
+        const std::string  utf8        = "a\xc3\xa9z";
+        std::vector<float> utf8_widths = FlameTrackItemTestPeer::LabelPrefixWidths(utf8);
+        IM_CHECK(utf8_widths.size() == utf8.size());
+        if(utf8_widths.size() != utf8.size()) return;
+        IM_CHECK(utf8_widths[1] == utf8_widths[2]);
+        IM_CHECK(visible_length(utf8, utf8_widths[0] + 0.1f) == 3);
+        IM_CHECK(visible_length(utf8, utf8_widths[0] - 0.1f) == 1);
+    };
+
+    t = IM_REGISTER_TEST(e, "app", "common_batch_script_parse");
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        IM_UNUSED(ctx);
+
+        // Comments, blank lines and surrounding whitespace are skipped.
+        {
+            BatchRunner         runner("", "");
+            BatchRunnerTestPeer peer{ runner };
+            IM_CHECK(peer.Parse("# header\n"
+                                "\n"
+                                "  top-kernels 5   # per GPU\n"
+                                "top-kernels\n"
+                                "\tgpu-utilization\r\n"
+                                "counter-stats\n"
+                                "export-events /tmp/events.csv\n"
+                                "export-samples /tmp/samples.csv\n"
+                                "trim 10 20 /tmp/trim.db\n"));
+            IM_CHECK(peer.CommandCount() == 7);
+            if(peer.CommandCount() != 7) return;
+
+            IM_CHECK(peer.Name(0) == "top-kernels");
+            IM_CHECK(peer.Args(0) == std::vector<std::string>{ "5" });
+            IM_CHECK(peer.Line(0).rfind("top-kernels 5", 0) == 0);
+            IM_CHECK(peer.Name(1) == "top-kernels");
+            IM_CHECK(peer.Args(1).empty());
+            IM_CHECK(peer.Name(2) == "gpu-utilization");
+            IM_CHECK(peer.Args(2).empty());
+            IM_CHECK(peer.Name(3) == "counter-stats");
+            IM_CHECK(peer.Args(4) == std::vector<std::string>{ "/tmp/events.csv" });
+            IM_CHECK(peer.Args(5) == std::vector<std::string>{ "/tmp/samples.csv" });
+            IM_CHECK(peer.Name(6) == "trim");
+            IM_CHECK((peer.Args(6) == std::vector<std::string>{ "10", "20", "/tmp/trim.db" }));
+        }
+
+        // Unknown commands and wrong argument counts fail the script, the valid
+        // lines are still kept in order.
+        {
+            BatchRunner         runner("", "");
+            BatchRunnerTestPeer peer{ runner };
+            IM_CHECK(!peer.Parse("counter-stats\n"
+                                 "queue-utilization\n"
+                                 "top-kernels 1 2\n"
+                                 "gpu-utilization now\n"
+                                 "export-events\n"
+                                 "trim 10 20\n"
+                                 "export-samples a.csv\n"));
+            IM_CHECK(peer.CommandCount() == 2);
+            if(peer.CommandCount() != 2) return;
+            IM_CHECK(peer.Name(0) == "counter-stats");
+            IM_CHECK(peer.Name(1) == "export-samples");
+        }
+
+        // A script of comments only is valid and runs nothing.
+        {
+            BatchRunner         runner("", "");
+            BatchRunnerTestPeer peer{ runner };
+            IM_CHECK(peer.Parse("# nothing to do\n   \n"));
+            IM_CHECK(peer.CommandCount() == 0);
+        }
+    };
+
     t = IM_REGISTER_TEST(e, "app", "sys_shared_db_open_dedups_and_switches");
     t->TestFunc = [](ImGuiTestContext* ctx)
     {
@@ -0,0 +1,834 @@
+// Copyright Advanced Micro Devices, Inc.
+// SPDX-License-Identifier: MIT
+
+// Controller benchmark suite. Every trace is loaded from scratch once per iteration
+// and the operations the view performs in a typical session are timed through the
+// controller C API. The results of all traces are written as one JSON document for
+// regression tracking.
+//
+// Benchmarks on system traces:
+//   load             rocprofvis_controller_load_async until the future completes
+//   first_viewport   every graph over the whole trace at the viewport width
+//   zoom_out         every graph from a 1/1024 window up to the whole trace
+//   table_open       first page of the event table over all event tracks
+//   table_sort       the same page sorted on the duration column, descending
+//   table_filter     the same page with the SQL filter of --table_filter
+//   event_search     first page of the search results for --search
+//   summary          summary metrics over the whole trace
+// Compute traces only run the load benchmark.
+
+#include "json.h"
+#include "rocprofvis_controller.h"
+#include "rocprofvis_core.h"
+#include "rocprofvis_interface_types.h"
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+#if defined(_MSC_VER)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+constexpr uint32_t    BENCHMARK_SCHEMA_VERSION  = 1;
+constexpr uint32_t    DEFAULT_ITERATIONS        = 3;
+constexpr uint32_t    DEFAULT_VIEWPORT_WIDTH    = 1920;
+constexpr uint32_t    ZOOM_OUT_STEPS            = 10;
+constexpr uint64_t    TABLE_PAGE_ROWS           = 100;
+constexpr const char* DEFAULT_TABLE_FILTER      = "duration > 1000";
+constexpr const char* DEFAULT_SEARCH_TEXT       = "hip";
+constexpr const char* TABLE_SORT_COLUMN         = "duration";
+
+struct BenchmarkOptions
+{
+    std::vector<std::string> input_files;
+    std::string              output_file;
+    std::string              log_file;
+    uint32_t                 iterations     = DEFAULT_ITERATIONS;
+    uint32_t                 viewport_width = DEFAULT_VIEWPORT_WIDTH;
+    std::string              table_filter   = DEFAULT_TABLE_FILTER;
+    std::string              search_text    = DEFAULT_SEARCH_TEXT;
+};
+
+struct BenchmarkSamples
+{
+    std::vector<double> ms;
+    // entries, rows or results produced by the last successful run
+    uint64_t            items = 0;
+};
+
+struct TraceResult
+{
+    std::string                             path;
+    std::string                             type;
+    std::map<std::string, BenchmarkSamples> benchmarks;
+    std::vector<std::string>                errors;
+    uint64_t                                peak_rss_bytes      = 0;
+    uint64_t                                memory_report_bytes = 0;
+};
+
+static void
+PrintUsage(const char* program)
+{
+    std::cout
+        << "Usage: " << program << " --input_file <trace> [--input_file <trace> ...]\n"
+        << "  --output <path>          Write the JSON results to a file instead of stdout\n"
+        << "  --iterations <n>         Load and measure every trace n times (default "
+        << DEFAULT_ITERATIONS << ")\n"
+        << "  --viewport_width <px>    Graph resolution of timeline fetches (default "
+        << DEFAULT_VIEWPORT_WIDTH << ")\n"
+        << "  --table_filter <sql>     Filter of the table_filter benchmark (default \""
+        << DEFAULT_TABLE_FILTER << "\")\n"
+        << "  --search <text>          Text of the event_search benchmark (default \""
+        << DEFAULT_SEARCH_TEXT << "\")\n"
+        << "  --log <path>             Write the controller log to a file\n";
+}
+
+static bool
+ParseOptions(int argc, char** argv, BenchmarkOptions& options)
+{
+    for(int i = 1; i < argc; i++)
+    {
+        std::string arg   = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if(arg == "--help" || arg == "-h")
+        {
+            return false;
+        }
+        if(value == nullptr)
+        {
+            std::cerr << "Missing value for " << arg << std::endl;
+            return false;
+        }
+        if(arg == "--input_file")
+        {
+            options.input_files.push_back(value);
+        }
+        else if(arg == "--output")
+        {
+            options.output_file = value;
+        }
+        else if(arg == "--log")
+        {
+            options.log_file = value;
+        }
+        else if(arg == "--iterations")
+        {
+            options.iterations = std::max(1, std::atoi(value));
+        }
+        else if(arg == "--viewport_width")
+        {
+            options.viewport_width = std::max(1, std::atoi(value));
+        }
+        else if(arg == "--table_filter")
+        {
+            options.table_filter = value;
+        }
+        else if(arg == "--search")
+        {
+            options.search_text = value;
+        }
+        else
+        {
+            std::cerr << "Unknown option " << arg << std::endl;
+            return false;
+        }
+        i++;
+    }
+    return !options.input_files.empty();
+}
+
+// Process wide resident memory high-water mark in bytes
+static uint64_t
+GetPeakResidentMemory()
+{
+#if defined(_MSC_VER)
+    PROCESS_MEMORY_COUNTERS counters;
+    if(GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return counters.PeakWorkingSetSize;
+    }
+    return 0;
+#else
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+#if defined(__APPLE__)
+    return static_cast<uint64_t>(usage.ru_maxrss);
+#else
+    return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+static rocprofvis_result_t
+WaitForFuture(rocprofvis_controller_future_t* future)
+{
+    rocprofvis_result_t result = rocprofvis_controller_future_wait(future, FLT_MAX);
+    if(result == kRocProfVisResultSuccess)
+    {
+        uint64_t future_result = kRocProfVisResultUnknownError;
+        result = rocprofvis_controller_get_uint64(future, kRPVControllerFutureResult, 0,
+                                                  &future_result);
+        if(result == kRocProfVisResultSuccess)
+        {
+            result = static_cast<rocprofvis_result_t>(future_result);
+        }
+    }
+    return result;
+}
+
+static std::string
+GetString(rocprofvis_handle_t* handle, uint32_t property, uint64_t index)
+{
+    std::string value;
+    uint32_t    length = 0;
+    if(rocprofvis_controller_get_string(handle, property, index, nullptr, &length) ==
+           kRocProfVisResultSuccess &&
+       length > 0)
+    {
+        value.resize(length);
+        rocprofvis_controller_get_string(handle, property, index,
+                                         const_cast<char*>(value.c_str()), &length);
+        value.resize(length);
+    }
+    return value;
+}
+
+// Measures the operations of one iteration on a freshly loaded controller
+class TraceBenchmark
+{
+public:
+    TraceBenchmark(const BenchmarkOptions& options, TraceResult& result);
+    ~TraceBenchmark();
+
+    void Run();
+
+private:
+    typedef std::function<rocprofvis_result_t(uint64_t&)> Operation;
+
+    bool Measure(const char* name, const Operation& operation);
+    bool ReadTimeline();
+
+    rocprofvis_result_t Load(uint64_t& items);
+    rocprofvis_result_t FetchGraphs(double start_ts, double end_ts, uint64_t& items);
+    rocprofvis_result_t ZoomOut(uint64_t& items);
+    rocprofvis_result_t FetchEventTable(uint64_t sort_column, uint64_t sort_order,
+                                        const std::string& filter, uint64_t& items);
+    rocprofvis_result_t SearchEvents(uint64_t& items);
+    rocprofvis_result_t FetchSummary(uint64_t& items);
+    uint64_t            FindSortColumn();
+    uint64_t            GetMemoryReportBytes();
+
+    const BenchmarkOptions&           m_options;
+    TraceResult&                      m_result;
+    rocprofvis_controller_t*          m_controller;
+    double                            m_start_ts;
+    double                            m_end_ts;
+    std::vector<rocprofvis_handle_t*> m_graphs;
+    std::vector<rocprofvis_handle_t*> m_event_tracks;
+};
+
+TraceBenchmark::TraceBenchmark(const BenchmarkOptions& options, TraceResult& result)
+: m_options(options)
+, m_result(result)
+, m_controller(nullptr)
+, m_start_ts(0)
+, m_end_ts(0)
+{}
+
+TraceBenchmark::~TraceBenchmark()
+{
+    if(m_controller)
+    {
+        rocprofvis_controller_free(m_controller);
+    }
+}
+
+bool
+TraceBenchmark::Measure(const char* name, const Operation& operation)
+{
+    uint64_t items = 0;
+    auto     start = std::chrono::steady_clock::now();
+    rocprofvis_result_t result = operation(items);
+    auto     end   = std::chrono::steady_clock::now();
+    if(result != kRocProfVisResultSuccess)
+    {
+        m_result.errors.push_back(std::string(name) + " failed with result " +
+                                  std::to_string(static_cast<int>(result)));
+        spdlog::error("Benchmark {} failed on {}: {}", name, m_result.path,
+                      static_cast<int>(result));
+        return false;
+    }
+
+    BenchmarkSamples& samples = m_result.benchmarks[name];
+    samples.ms.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    samples.items = items;
+    return true;
+}
+
+rocprofvis_result_t
+TraceBenchmark::Load(uint64_t& items)
+{
+    m_controller = rocprofvis_controller_alloc(m_result.path.c_str(), nullptr);
+    if(!m_controller)
+    {
+        return kRocProfVisResultUnknownError;
+    }
+
+    rocprofvis_controller_future_t* future = rocprofvis_controller_future_alloc();
+    rocprofvis_result_t result = rocprofvis_controller_load_async(m_controller, future);
+    if(result == kRocProfVisResultSuccess)
+    {
+        result = WaitForFuture(future);
+    }
+    rocprofvis_controller_future_free(future);
+
+    // tracks of system traces, workloads of compute traces
+    if(result == kRocProfVisResultSuccess &&
+       rocprofvis_controller_get_uint64(m_controller, kRPVControllerSystemNumTracks, 0,
+                                        &items) != kRocProfVisResultSuccess)
+    {
+        rocprofvis_controller_get_uint64(m_controller, kRPVControllerNumWorkloads, 0,
+                                         &items);
+    }
+    return result;
+}
+
+bool
+TraceBenchmark::ReadTimeline()
+{
+    rocprofvis_handle_t* timeline = nullptr;
+    if(rocprofvis_controller_get_object(m_controller, kRPVControllerSystemTimeline, 0,
+                                        &timeline) != kRocProfVisResultSuccess ||
+       timeline == nullptr)
+    {
+        m_result.errors.push_back("timeline is not available");
+        return false;
+    }
+    rocprofvis_controller_get_double(timeline, kRPVControllerTimelineMinTimestamp, 0,
+                                     &m_start_ts);
+    rocprofvis_controller_get_double(timeline, kRPVControllerTimelineMaxTimestamp, 0,
+                                     &m_end_ts);
+
+    uint64_t num_graphs = 0;
+    rocprofvis_controller_get_uint64(timeline, kRPVControllerTimelineNumGraphs, 0,
+                                     &num_graphs);
+    m_graphs.clear();
+    for(uint64_t i = 0; i < num_graphs; i++)
+    {
+        rocprofvis_handle_t* graph = nullptr;
+        if(rocprofvis_controller_get_object(timeline, kRPVControllerTimelineGraphIndexed,
+                                            i, &graph) == kRocProfVisResultSuccess &&
+           graph)
+        {
+            m_graphs.push_back(graph);
+        }
+    }
+
+    uint64_t num_tracks = 0;
+    rocprofvis_controller_get_uint64(m_controller, kRPVControllerSystemNumTracks, 0,
+                                     &num_tracks);
+    m_event_tracks.clear();
+    for(uint64_t i = 0; i < num_tracks; i++)
+    {
+        rocprofvis_handle_t* track      = nullptr;
+        uint64_t             track_type = 0;
+        if(rocprofvis_controller_get_object(m_controller, kRPVControllerSystemTrackIndexed,
+                                            i, &track) == kRocProfVisResultSuccess &&
+           track &&
+           rocprofvis_controller_get_uint64(track, kRPVControllerTrackType, 0,
+                                            &track_type) == kRocProfVisResultSuccess &&
+           track_type == kRPVControllerTrackTypeEvents)
+        {
+            m_event_tracks.push_back(track);
+        }
+    }
+    return true;
+}
+
+rocprofvis_result_t
+TraceBenchmark::FetchGraphs(double start_ts, double end_ts, uint64_t& items)
+{
+    // issue every graph at once and then wait, like the timeline does for a new viewport
+    std::vector<rocprofvis_controller_future_t*> futures;
+    std::vector<rocprofvis_controller_array_t*>  arrays;
+    rocprofvis_result_t                          result = kRocProfVisResultSuccess;
+    for(rocprofvis_handle_t* graph : m_graphs)
+    {
+        rocprofvis_controller_future_t* future = rocprofvis_controller_future_alloc();
+        rocprofvis_controller_array_t*  array  = rocprofvis_controller_array_alloc(0);
+        rocprofvis_result_t fetch_result = rocprofvis_controller_graph_fetch_async(
+            m_controller, graph, start_ts, end_ts, m_options.viewport_width, future,
+            array);
+        if(fetch_result == kRocProfVisResultSuccess)
+        {
+            futures.push_back(future);
+            arrays.push_back(array);
+        }
+        else if(fetch_result == kRocProfVisResultOutOfRange)
+        {
+            // nothing of this graph in the window
+            rocprofvis_controller_array_free(array);
+            rocprofvis_controller_future_free(future);
+        }
+        else
+        {
+            result = fetch_result;
+            rocprofvis_controller_array_free(array);
+            rocprofvis_controller_future_free(future);
+        }
+    }
+
+    for(size_t i = 0; i < futures.size(); i++)
+    {
+        rocprofvis_result_t wait_result = WaitForFuture(futures[i]);
+        if(wait_result == kRocProfVisResultSuccess)
+        {
+            uint64_t num_entries = 0;
+            rocprofvis_controller_get_uint64(arrays[i], kRPVControllerArrayNumEntries, 0,
+                                             &num_entries);
+            items += num_entries;
+        }
+        else if(wait_result != kRocProfVisResultOutOfRange &&
+                result == kRocProfVisResultSuccess)
+        {
+            result = wait_result;
+        }
+        rocprofvis_controller_array_free(arrays[i]);
+        rocprofvis_controller_future_free(futures[i]);
+    }
+    return result;
+}
+
+rocprofvis_result_t
+TraceBenchmark::ZoomOut(uint64_t& items)
+{
+    double center = (m_start_ts + m_end_ts) / 2;
+    double range  = m_end_ts - m_start_ts;
+    for(int32_t step = ZOOM_OUT_STEPS; step >= 0; step--)
+    {
+        double half_window = range / static_cast<double>(uint64_t(1) << (step + 1));
+        rocprofvis_result_t result =
+            FetchGraphs(center - half_window, center + half_window, items);
+        if(result != kRocProfVisResultSuccess)
+        {
+            return result;
+        }
+    }
+    return kRocProfVisResultSuccess;
+}
+
+rocprofvis_result_t
+TraceBenchmark::FetchEventTable(uint64_t sort_column, uint64_t sort_order,
+                                const std::string& filter, uint64_t& items)
+{
+    rocprofvis_handle_t* table  = nullptr;
+    rocprofvis_result_t  result = rocprofvis_controller_get_object(
+        m_controller, kRPVControllerSystemEventTable, 0, &table);
+    if(result != kRocProfVisResultSuccess)
+    {
+        return result;
+    }
+
+    rocprofvis_controller_arguments_t* args = rocprofvis_controller_arguments_alloc();
+    rocprofvis_controller_set_uint64(args, kRPVControllerTableArgsType, 0,
+                                     kRPVControllerTableTypeEvents);
+    rocprofvis_controller_set_uint64(args, kRPVControllerTableArgsNumTracks, 0,
+                                     m_event_tracks.size());
+    for(size_t i = 0; i < m_event_tracks.size(); i++)
+    {
+        rocprofvis_controller_set_object(args, kRPVControllerTableArgsTracksIndexed, i,
+                                         m_event_tracks[i]);
+    }
+    rocprofvis_controller_set_double(args, kRPVControllerTableArgsStartTime, 0,
+                                     m_start_ts);
+    rocprofvis_controller_set_double(args, kRPVControllerTableArgsEndTime, 0, m_end_ts);
+    rocprofvis_controller_set_uint64(args, kRPVControllerTableArgsSortColumn, 0,
+                                     sort_column);
+    rocprofvis_controller_set_uint64(args, kRPVControllerTableArgsSortOrder, 0,
+                                     sort_order);
+    rocprofvis_controller_set_string(args, kRPVControllerTableArgsWhere, 0, "");
+    rocprofvis_controller_set_string(args, kRPVControllerTableArgsFilter, 0,
+                                     filter.c_str());
+    rocprofvis_controller_set_string(args, kRPVControllerTableArgsGroup, 0, "");
+    rocprofvis_controller_set_string(args, kRPVControllerTableArgsGroupColumns, 0, "");
+    rocprofvis_controller_set_uint64(args, kRPVControllerTableArgsStartIndex, 0, 0);
+    rocprofvis_controller_set_uint64(args, kRPVControllerTableArgsStartCount, 0,
+                                     TABLE_PAGE_ROWS);
+
+    rocprofvis_controller_future_t* future = rocprofvis_controller_future_alloc();
+    rocprofvis_controller_array_t*  array  = rocprofvis_controller_array_alloc(0);
+    result = rocprofvis_controller_table_fetch_async(m_controller, table, args, future,
+                                                     array);
+    if(result == kRocProfVisResultSuccess)
+    {
+        result = WaitForFuture(future);
+    }
+    if(result == kRocProfVisResultSuccess)
+    {
+        rocprofvis_controller_get_uint64(table, kRPVControllerTableNumRows, 0, &items);
+    }
+    rocprofvis_controller_array_free(array);
+    rocprofvis_controller_future_free(future);
+    rocprofvis_controller_arguments_free(args);
+    return result;
+}
+
+rocprofvis_result_t
+TraceBenchmark::SearchEvents(uint64_t& items)
+{
+    rocprofvis_handle_t* table  = nullptr;
+    rocprofvis_result_t  result = rocprofvis_controller_get_object(
+        m_controller, kRPVControllerSystemSearchResultsTable, 0, &table);
+    if(result != kRocProfVisResultSuccess)
+    {
+        return result;
+    }
+
+    const rocprofvis_dm_event_operation_t op_types[] = {
+        kRocProfVisDmOperationLaunch, kRocProfVisDmOperationDispatch,
+        kRocProfVisDmOperationLaunchSample
+    };
+    const uint64_t num_op_types = sizeof(op_types) / sizeof(op_types[0]);
+
+    rocprofvis_controller_arguments_t* args = rocprofvis_controller_arguments_alloc();
+    rocprofvis_controller_set_uint64(args, kRPVControllerTableArgsType, 0,
+                                     kRPVControllerTableTypeSearchResults);
+    rocprofvis_controller_set_double(args, kRPVControllerTableArgsStartTime, 0,
+                                     m_start_ts);
+    rocprofvis_controller_set_double(args, kRPVControllerTableArgsEndTime, 0, m_end_ts);
+    for(uint64_t i = 0; i < num_op_types; i++)
+    {
+        rocprofvis_controller_set_uint64(args, kRPVControllerTableArgsOpTypesIndexed, i,
+                                         op_types[i]);
+    }
+    rocprofvis_controller_set_uint64(args, kRPVControllerTableArgsNumOpTypes, 0,
+                                     num_op_types);
+    rocprofvis_controller_set_string(args,
+                                     kRPVControllerTableArgsStringTableFiltersIndexed, 0,
+                                     m_options.search_text.c_str());
+    rocprofvis_controller_set_uint64(args, kRPVControllerTableArgsNumStringTableFilters,
+                                     0, 1);
+    rocprofvis_controller_set_uint64(
+        args, kRPVControllerTableArgsStringTableFiltersIncludeSubstrings, 0, 1);
+    rocprofvis_controller_set_uint64(
+        args, kRPVControllerTableArgsStringTableFiltersIncludeCategory, 0, 0);
+    rocprofvis_controller_set_uint64(
+        args, kRPVControllerTableArgsStringTableFiltersPartialMatching, 0, 0);
+    rocprofvis_controller_set_uint64(args, kRPVControllerTableArgsSortColumn, 0, 0);
+    rocprofvis_controller_set_uint64(args, kRPVControllerTableArgsSortOrder, 0,
+                                     kRPVControllerSortOrderAscending);
+    rocprofvis_controller_set_string(args, kRPVControllerTableArgsWhere, 0, "");
+    rocprofvis_controller_set_string(args, kRPVControllerTableArgsFilter, 0, "");
+    rocprofvis_controller_set_string(args, kRPVControllerTableArgsGroup, 0, "");
+    rocprofvis_controller_set_string(args, kRPVControllerTableArgsGroupColumns, 0, "");
+    rocprofvis_controller_set_uint64(args, kRPVControllerTableArgsStartIndex, 0, 0);
+    rocprofvis_controller_set_uint64(args, kRPVControllerTableArgsStartCount, 0,
+                                     TABLE_PAGE_ROWS);
+
+    rocprofvis_controller_future_t* future = rocprofvis_controller_future_alloc();
+    rocprofvis_controller_array_t*  array  = rocprofvis_controller_array_alloc(0);
+    result = rocprofvis_controller_table_fetch_async(m_controller, table, args, future,
+                                                     array);
+    if(result == kRocProfVisResultSuccess)
+    {
+        result = WaitForFuture(future);
+    }
+    if(result == kRocProfVisResultSuccess)
+    {
+        rocprofvis_controller_get_uint64(table, kRPVControllerTableNumRows, 0, &items);
+    }
+    rocprofvis_controller_array_free(array);
+    rocprofvis_controller_future_free(future);
+    rocprofvis_controller_arguments_free(args);
+    return result;
+}
+
+rocprofvis_result_t
+TraceBenchmark::FetchSummary(uint64_t& items)
+{
+    rocprofvis_handle_t* summary = nullptr;
+    rocprofvis_result_t  result  = rocprofvis_controller_get_object(
+        m_controller, kRPVControllerSystemSummary, 0, &summary);
+    if(result != kRocProfVisResultSuccess)
+    {
+        return result;
+    }
+
+    rocprofvis_controller_arguments_t* args = rocprofvis_controller_arguments_alloc();
+    rocprofvis_controller_set_double(args, kRPVControllerSummaryArgsStartTimestamp, 0,
+                                     m_start_ts);
+    rocprofvis_controller_set_double(args, kRPVControllerSummaryArgsEndTimestamp, 0,
+                                     m_end_ts);
+
+    rocprofvis_controller_summary_metrics_t* metrics =
+        rocprofvis_controller_summary_metrics_alloc();
+    rocprofvis_controller_future_t* future = rocprofvis_controller_future_alloc();
+    result = rocprofvis_controller_summary_fetch_async(m_controller, summary, args,
+                                                       future, metrics);
+    if(result == kRocProfVisResultSuccess)
+    {
+        result = WaitForFuture(future);
+    }
+    if(result == kRocProfVisResultSuccess)
+    {
+        rocprofvis_controller_get_uint64(metrics,
+                                         kRPVControllerSummaryMetricPropertyNumSubMetrics,
+                                         0, &items);
+    }
+    rocprofvis_controller_future_free(future);
+    rocprofvis_controller_summary_metric_free(metrics);
+    rocprofvis_controller_arguments_free(args);
+    return result;
+}
+
+// Column the table_sort benchmark sorts on, known after the table has been fetched once
+uint64_t
+TraceBenchmark::FindSortColumn()
+{
+    rocprofvis_handle_t* table       = nullptr;
+    uint64_t             num_columns = 0;
+    rocprofvis_controller_get_object(m_controller, kRPVControllerSystemEventTable, 0,
+                                     &table);
+    if(table)
+    {
+        rocprofvis_controller_get_uint64(table, kRPVControllerTableNumColumns, 0,
+                                         &num_columns);
+    }
+    for(uint64_t i = 0; i < num_columns; i++)
+    {
+        std::string header = GetString(table, kRPVControllerTableColumnHeaderIndexed, i);
+        std::transform(header.begin(), header.end(), header.begin(), ::tolower);
+        if(header == TABLE_SORT_COLUMN)
+        {
+            return i;
+        }
+    }
+    return num_columns > 0 ? num_columns - 1 : 0;
+}
+
+uint64_t
+TraceBenchmark::GetMemoryReportBytes()
+{
+    uint64_t                              bytes  = 0;
+    rocprofvis_controller_memory_report_t* report = rocprofvis_controller_memory_report_alloc();
+    if(rocprofvis_controller_memory_report_fetch(m_controller, report) ==
+       kRocProfVisResultSuccess)
+    {
+        uint64_t num_entries = 0;
+        rocprofvis_controller_get_uint64(report, kRPVControllerMemoryReportNumEntries, 0,
+                                         &num_entries);
+        for(uint64_t i = 0; i < num_entries; i++)
+        {
+            uint64_t parent = 0;
+            rocprofvis_controller_get_uint64(report, kRPVControllerMemoryReportParentIndexed,
+                                             i, &parent);
+            if(parent == UINT64_MAX)
+            {
+                uint64_t entry_bytes = 0;
+                rocprofvis_controller_get_uint64(
+                    report, kRPVControllerMemoryReportBytesIndexed, i, &entry_bytes);
+                bytes += entry_bytes;
+            }
+        }
+    }
+    rocprofvis_controller_memory_report_free(report);
+    return bytes;
+}
+
+void
+TraceBenchmark::Run()
+{
+    if(!Measure("load", [this](uint64_t& items) { return Load(items); }))
+    {
+        return;
+    }
+
+    rocprofvis_controller_object_type_t type = kRPVControllerObjectTypeControllerSystem;
+    rocprofvis_controller_get_object_type(m_controller, &type);
+    m_result.type = (type == kRPVControllerObjectTypeControllerCompute) ? "compute"
+                                                                         : "system";
+    if(type == kRPVControllerObjectTypeControllerSystem && ReadTimeline())
+    {
+        Measure("first_viewport", [this](uint64_t& items) {
+            return FetchGraphs(m_start_ts, m_end_ts, items);
+        });
+        Measure("zoom_out", [this](uint64_t& items) { return ZoomOut(items); });
+        if(!m_event_tracks.empty() &&
+           Measure("table_open", [this](uint64_t& items) {
+               return FetchEventTable(0, kRPVControllerSortOrderAscending, "", items);
+           }))
+        {
+            uint64_t sort_column = FindSortColumn();
+            Measure("table_sort", [this, sort_column](uint64_t& items) {
+                return FetchEventTable(sort_column, kRPVControllerSortOrderDescending, "",
+                                       items);
+            });
+            Measure("table_filter", [this, sort_column](uint64_t& items) {
+                return FetchEventTable(sort_column, kRPVControllerSortOrderDescending,
+                                       m_options.table_filter, items);
+            });
+        }
+        Measure("event_search", [this](uint64_t& items) { return SearchEvents(items); });
+        Measure("summary", [this](uint64_t& items) { return FetchSummary(items); });
+    }
+
+    m_result.memory_report_bytes = std::max(m_result.memory_report_bytes,
+                                            GetMemoryReportBytes());
+}
+
+static jt::Json
+BenchmarkToJson(const BenchmarkSamples& samples)
+{
+    std::vector<double> sorted = samples.ms;
+    std::sort(sorted.begin(), sorted.end());
+    double total = 0;
+    for(double ms : sorted)
+    {
+        total += ms;
+    }
+    size_t middle = sorted.size() / 2;
+    double median = (sorted.size() % 2) ? sorted[middle]
+                                        : (sorted[middle - 1] + sorted[middle]) / 2;
+
+    jt::Json json;
+    json.setObject();
+    json["min_ms"]    = sorted.front();
+    json["median_ms"] = median;
+    json["mean_ms"]   = total / sorted.size();
+    json["max_ms"]    = sorted.back();
+    json["items"]     = samples.items;
+    jt::Json& values  = json["samples_ms"];
+    values.setArray();
+    for(double ms : samples.ms)
+    {
+        values.getArray().push_back(ms);
+    }
+    return json;
+}
+
+static jt::Json
+TraceToJson(const TraceResult& result)
+{
+    jt::Json json;
+    json.setObject();
+    json["file"] = std::filesystem::path(result.path).filename().string();
+    json["path"] = result.path;
+    std::error_code error;
+    json["file_bytes"] = static_cast<uint64_t>(std::filesystem::file_size(result.path, error));
+    json["type"]       = result.type;
+
+    jt::Json& benchmarks = json["benchmarks"];
+    benchmarks.setObject();
+    for(auto const& benchmark : result.benchmarks)
+    {
+        benchmarks[benchmark.first] = BenchmarkToJson(benchmark.second);
+    }
+
+    jt::Json& memory = json["memory"];
+    memory.setObject();
+    memory["peak_rss_bytes"]      = result.peak_rss_bytes;
+    memory["memory_report_bytes"] = result.memory_report_bytes;
+
+    jt::Json& errors = json["errors"];
+    errors.setArray();
+    for(const std::string& message : result.errors)
+    {
+        errors.getArray().push_back(message);
+    }
+    return json;
+}
+
+static std::string
+GetTimestamp()
+{
+    std::time_t now = std::time(nullptr);
+    char        buffer[32];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+    return buffer;
+}
+
+int
+main(int argc, char** argv)
+{
+    BenchmarkOptions options;
+    if(!ParseOptions(argc, argv, options))
+    {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    if(!options.log_file.empty())
+    {
+        rocprofvis_core_enable_log(options.log_file.c_str(), spdlog::level::info);
+    }
+    else
+    {
+        spdlog::set_level(spdlog::level::warn);
+    }
+
+    jt::Json output;
+    output.setObject();
+    output["schema_version"]   = BENCHMARK_SCHEMA_VERSION;
+    output["timestamp"]        = GetTimestamp();
+    output["iterations"]       = options.iterations;
+    output["viewport_width"]   = options.viewport_width;
+    output["hardware_threads"] = std::thread::hardware_concurrency();
+    jt::Json& traces           = output["traces"];
+    traces.setArray();
+
+    bool success = true;
+    for(const std::string& path : options.input_files)
+    {
+        TraceResult result;
+        result.path = path;
+        for(uint32_t i = 0; i < options.iterations; i++)
+        {
+            spdlog::info("Benchmarking {} iteration {}/{}", path, i + 1,
+                         options.iterations);
+            TraceBenchmark benchmark(options, result);
+            benchmark.Run();
+        }
+        // the high-water mark is process wide, run one trace per process to isolate it
+        result.peak_rss_bytes = GetPeakResidentMemory();
+        success               = success && result.errors.empty();
+        traces.getArray().push_back(TraceToJson(result));
+    }
+
+    if(options.output_file.empty())
+    {
+        std::cout << output.toStringPretty() << std::endl;
+    }
+    else
+    {
+        std::filesystem::path output_path(options.output_file);
+        if(output_path.has_parent_path())
+        {
+            std::error_code error;
+            std::filesystem::create_directories(output_path.parent_path(), error);
+        }
+        std::ofstream file(options.output_file);
+        if(!file)
+        {
+            std::cerr << "Failed to write " << options.output_file << std::endl;
+            return 1;
+        }
+        file << output.toStringPretty() << std::endl;
+    }
+    return success ? 0 : 1;
+}
@@ -68,6 +68,24 @@ rocprofvis_controller_arguments_t* rocprofvis_controller_arguments_alloc(void);
 */
 rocprofvis_controller_summary_metrics_t* rocprofvis_controller_summary_metrics_alloc(void);
 
+/*
+* Allocate a query telemetry snapshot.
+* @returns A valid query telemetry object, or nullptr.
+*/
+rocprofvis_controller_query_telemetry_t* rocprofvis_controller_query_telemetry_alloc(void);
+
+/*
+* Allocate a lock statistics snapshot.
+* @returns A valid lock statistics object, or nullptr.
+*/
+rocprofvis_controller_lock_stats_t* rocprofvis_controller_lock_stats_alloc(void);
+
+/*
+* Allocate a memory report.
+* @returns A valid memory report object, or nullptr.
+*/
+rocprofvis_controller_memory_report_t* rocprofvis_controller_memory_report_alloc(void);
+
 /*
 * Gets the property value from the provided object or returns an error.
 * @param object The object to access.
@@ -257,6 +275,66 @@ rocprofvis_result_t rocprofvis_controller_table_fetch_async(rocprofvis_controlle
 */
 rocprofvis_result_t rocprofvis_controller_table_export_csv(rocprofvis_controller_t* controller, rocprofvis_controller_table_t* table, rocprofvis_controller_arguments_t* args, rocprofvis_controller_future_t* result, char const* path);
 
+/*
+* Fetches all flow edges overlapping a time range, from the flow index built when the trace is loaded.
+* Arrays have to be owned by the caller, not the controller as this is a better match to an RPC API.
+* The output array holds pairs of flow control objects: the origin endpoint (direction 0) followed by its target endpoint (direction 1).
+* @param controller The controller.
+* @param args The arguments, see rocprofvis_controller_flow_arguments_t
+* @param result The future to wait on
+* @param output The array to write to
+* @returns kRocProfVisResultSuccess or an error code.
+*/
+rocprofvis_result_t rocprofvis_controller_flow_fetch_async(rocprofvis_controller_t* controller, rocprofvis_controller_arguments_t* args, rocprofvis_controller_future_t* result, rocprofvis_controller_array_t* output);
+/* JSON: FlowFetch
+{
+    controller: Int,
+    args: Object,
+}
+->
+{
+    results: Array[RPVFlowControl]
+}
+*/
+
+/*
+* Loads the data of several tracks for a time range into the controller, so that subsequent track and graph fetches are served from memory.
+* Tracks whose events come from the same database tables are read with a single query instead of one query per track.
+* @param controller The controller.
+* @param args The arguments, see rocprofvis_controller_track_load_arguments_t
+* @param result The future to wait on
+* @returns kRocProfVisResultSuccess or an error code.
+*/
+rocprofvis_result_t rocprofvis_controller_track_load_async(rocprofvis_controller_t* controller, rocprofvis_controller_arguments_t* args, rocprofvis_controller_future_t* result);
+/* JSON: TrackLoad
+{
+    controller: Int,
+    args: Object,
+}
+->
+{
+}
+*/
+
+/*
+* Loads the extended data, flow control and call stack of several events into the data model cache with a single request,
+* so that subsequent rocprofvis_controller_get_indexed_property_async calls for these events don't query the database.
+* @param controller The controller.
+* @param args The arguments, see rocprofvis_controller_event_prefetch_arguments_t
+* @param result The future to wait on
+* @returns kRocProfVisResultSuccess or an error code.
+*/
+rocprofvis_result_t rocprofvis_controller_event_prefetch_async(rocprofvis_controller_t* controller, rocprofvis_controller_arguments_t* args, rocprofvis_controller_future_t* result);
+/* JSON: EventPrefetch
+{
+    controller: Int,
+    args: Object,
+}
+->
+{
+}
+*/
+
 /*
 * Setup the summary based on the values in 'args' and fetch data.
 * @param controller The controller.
@@ -268,6 +346,71 @@ rocprofvis_result_t rocprofvis_controller_table_export_csv(rocprofvis_controller
 */
 rocprofvis_result_t rocprofvis_controller_summary_fetch_async(rocprofvis_controller_t* controller, rocprofvis_controller_summary_t* summary, rocprofvis_controller_arguments_t* args, rocprofvis_controller_future_t* result, rocprofvis_controller_summary_metrics_t* output);
 
+/*
+* Enables or disables SQL query telemetry for the trace database. Collection is off by default
+* and may be enabled before the trace is loaded to capture the load queries.
+* @param controller The controller.
+* @param enabled Non-zero to collect per-query statistics and query plans.
+* @param slow_query_ms Queries taking at least this many milliseconds go to the slow query log, 0 logs failed queries only.
+* @returns kRocProfVisResultSuccess or an error code.
+*/
+rocprofvis_result_t rocprofvis_controller_set_query_telemetry(rocprofvis_controller_t* controller, uint64_t enabled, double slow_query_ms);
+
+/*
+* Copy the query telemetry collected so far into the snapshot. Runs synchronously.
+* @param controller The controller.
+* @param output The query telemetry object to write to.
+* @returns kRocProfVisResultSuccess or an error code.
+*/
+rocprofvis_result_t rocprofvis_controller_query_telemetry_fetch(rocprofvis_controller_t* controller, rocprofvis_controller_query_telemetry_t* output);
+
+/*
+* Drop the query telemetry collected so far.
+* @param controller The controller.
+* @returns kRocProfVisResultSuccess or an error code.
+*/
+rocprofvis_result_t rocprofvis_controller_query_telemetry_clear(rocprofvis_controller_t* controller);
+
+/*
+* Enables or disables lock wait and hold time statistics. Statistics are process wide
+* and disabled by default.
+* @param enabled Non-zero to record lock statistics.
+* @returns kRocProfVisResultSuccess or an error code.
+*/
+rocprofvis_result_t rocprofvis_controller_set_lock_stats(uint64_t enabled);
+
+/*
+* Copy the lock statistics of every data model lock site into the snapshot. Runs synchronously.
+* @param output The lock statistics object to write to.
+* @returns kRocProfVisResultSuccess or an error code.
+*/
+rocprofvis_result_t rocprofvis_controller_lock_stats_fetch(rocprofvis_controller_lock_stats_t* output);
+
+/*
+* Zero the lock statistics of every lock site.
+* @returns kRocProfVisResultSuccess or an error code.
+*/
+rocprofvis_result_t rocprofvis_controller_lock_stats_reset(void);
+
+/*
+* Measure the memory held by the trace in the data model, database and controller
+* and write it to the report. Runs synchronously.
+* @param controller The controller.
+* @param output The memory report object to write to.
+* @returns kRocProfVisResultSuccess or an error code.
+*/
+rocprofvis_result_t rocprofvis_controller_memory_report_fetch(rocprofvis_controller_t* controller, rocprofvis_controller_memory_report_t* output);
+
+/*
+* Measure the memory held by the trace on a worker thread, see
+* rocprofvis_controller_memory_report_fetch. The report is complete once the future is.
+* @param controller The controller.
+* @param future The future to signal on completion.
+* @param output The memory report object to write to.
+* @returns kRocProfVisResultSuccess or an error code.
+*/
+rocprofvis_result_t rocprofvis_controller_memory_report_fetch_async(rocprofvis_controller_t* controller, rocprofvis_controller_future_t* future, rocprofvis_controller_memory_report_t* output);
+
 /*
 * Allocate a metrics container used for carrying compute trace metric data.
 * @returns A valid metrics container object, or nullptr.
@@ -452,6 +595,24 @@ rocprofvis_result_t rocprofvis_controller_remote_reset(
 */
 void rocprofvis_controller_summary_metric_free(rocprofvis_controller_summary_metrics_t* object);
 
+/*
+* Frees the provided query telemetry object
+* @param object The object to free.
+*/
+void rocprofvis_controller_query_telemetry_free(rocprofvis_controller_query_telemetry_t* object);
+
+/*
+* Frees the provided lock statistics object
+* @param object The object to free.
+*/
+void rocprofvis_controller_lock_stats_free(rocprofvis_controller_lock_stats_t* object);
+
+/*
+* Frees the provided memory report object
+* @param object The object to free.
+*/
+void rocprofvis_controller_memory_report_free(rocprofvis_controller_memory_report_t* object);
+
 void rocprofvis_controller_arguments_free(rocprofvis_controller_arguments_t* args);
 
 /*
@@ -122,6 +122,12 @@ typedef enum rocprofvis_controller_object_type_t
     kRPVControllerObjectTypeRoofline = 29,
     //PcSampling
     kRPVControllerObjectTypePCSampling = 30,
+    // SQL query telemetry snapshot
+    kRPVControllerObjectTypeQueryTelemetry = 31,
+    // Data model lock statistics snapshot
+    kRPVControllerObjectTypeLockStats = 32,
+    // Trace memory accounting snapshot
+    kRPVControllerObjectTypeMemoryReport = 33,
 #ifdef ROCPROFVIS_ENABLE_REMOTE
     // Remote connection object
     kRPVControllerObjectTypeRemoteConnection = 205,
@@ -902,8 +908,159 @@ typedef enum rocprofvis_controller_summary_arguments_t : uint32_t
 {
     kRPVControllerSummaryArgsStartTimestamp = 0x12000000,
     kRPVControllerSummaryArgsEndTimestamp,
+    // Optional, non-zero to refresh only the top kernels (uint64). Counter utilization
+    // is reused from the previous fetch, used to follow a range while it is dragged
+    kRPVControllerSummaryArgsKernelsOnly,
 } rocprofvis_controller_summary_arguments_t;
 
+/*
+ * Arguments to fetch flow edges for a time range
+ */
+typedef enum rocprofvis_controller_flow_arguments_t : uint32_t
+{
+    // Start of the time range (double)
+    kRPVControllerFlowArgsStartTime = 0x14000000,
+    // End of the time range (double)
+    kRPVControllerFlowArgsEndTime,
+    // Number of tracks to select edges for (uint64), 0 for all tracks
+    kRPVControllerFlowArgsNumTracks,
+    // Indexed track id (uint64). Edges with either endpoint on a selected track are returned
+    kRPVControllerFlowArgsTracksIndexed,
+} rocprofvis_controller_flow_arguments_t;
+
+/*
+ * Arguments to load the data of several tracks for a time range
+ */
+typedef enum rocprofvis_controller_track_load_arguments_t : uint32_t
+{
+    // Start of the time range (double)
+    kRPVControllerTrackLoadArgsStartTime = 0x15000000,
+    // End of the time range (double)
+    kRPVControllerTrackLoadArgsEndTime,
+    // Number of tracks to load (uint64)
+    kRPVControllerTrackLoadArgsNumTracks,
+    // Indexed track id (uint64)
+    kRPVControllerTrackLoadArgsTracksIndexed,
+    // Optional, horizontal resolution in pixels (uint64). Non-zero to also generate the
+    // graph level of detail that a graph fetch of the range at this resolution reads
+    kRPVControllerTrackLoadArgsResolution,
+} rocprofvis_controller_track_load_arguments_t;
+
+/*
+ * Arguments to prefetch the properties of several events
+ */
+typedef enum rocprofvis_controller_event_prefetch_arguments_t : uint32_t
+{
+    // Number of events to prefetch (uint64)
+    kRPVControllerEventPrefetchArgsNumEvents = 0x19000000,
+    // Indexed event id (uint64)
+    kRPVControllerEventPrefetchArgsEventsIndexed,
+} rocprofvis_controller_event_prefetch_arguments_t;
+
+/*
+ * Properties for a query telemetry snapshot
+ */
+typedef enum rocprofvis_controller_query_telemetry_properties_t : uint32_t
+{
+    __kRPVControllerQueryTelemetryPropertiesFirst = 0x16000000,
+    // Number of query templates (uint64), ordered by total time descending
+    kRPVControllerQueryTelemetryNumQueries = __kRPVControllerQueryTelemetryPropertiesFirst,
+    // Indexed query text with literals replaced by '?' (string)
+    kRPVControllerQueryTelemetryQueryTemplateIndexed,
+    // Indexed database file and connection number the query ran on, like "trace.db#2" (string)
+    kRPVControllerQueryTelemetryQueryConnectionIndexed,
+    // Indexed EXPLAIN QUERY PLAN output captured on first successful execution (string)
+    kRPVControllerQueryTelemetryQueryPlanIndexed,
+    // Indexed number of executions (uint64)
+    kRPVControllerQueryTelemetryQueryCountIndexed,
+    // Indexed total execution time in milliseconds (double)
+    kRPVControllerQueryTelemetryQueryTotalTimeIndexed,
+    // Indexed longest execution time in milliseconds (double)
+    kRPVControllerQueryTelemetryQueryMaxTimeIndexed,
+    // Indexed total rows returned (uint64)
+    kRPVControllerQueryTelemetryQueryRowsIndexed,
+    // Indexed total bytes returned (uint64)
+    kRPVControllerQueryTelemetryQueryBytesIndexed,
+    // Number of slow and failed query log entries (uint64), oldest first
+    kRPVControllerQueryTelemetryNumSlowQueries,
+    // Indexed full query text of a slow query (string)
+    kRPVControllerQueryTelemetrySlowQueryTextIndexed,
+    // Indexed database file and connection number of a slow query (string)
+    kRPVControllerQueryTelemetrySlowQueryConnectionIndexed,
+    // Indexed execution time of a slow query in milliseconds (double)
+    kRPVControllerQueryTelemetrySlowQueryTimeIndexed,
+    // Indexed rows returned by a slow query (uint64)
+    kRPVControllerQueryTelemetrySlowQueryRowsIndexed,
+    // Indexed bytes returned by a slow query (uint64)
+    kRPVControllerQueryTelemetrySlowQueryBytesIndexed,
+    // Indexed number of executions which returned an error or were interrupted,
+    // included in the count (uint64)
+    kRPVControllerQueryTelemetryQueryFailuresIndexed,
+    // Indexed error message of a logged query, empty if it succeeded (string)
+    kRPVControllerQueryTelemetrySlowQueryErrorIndexed,
+    __kRPVControllerQueryTelemetryPropertiesLast
+} rocprofvis_controller_query_telemetry_properties_t;
+
+/*
+ * Properties for a lock statistics snapshot. A site is a locking function, the class
+ * owning the mutex and the lock mode. Times are in nanoseconds.
+ */
+typedef enum rocprofvis_controller_lock_stats_properties_t : uint32_t
+{
+    __kRPVControllerLockStatsPropertiesFirst = 0x17000000,
+    // Number of lock sites (uint64), ordered by total wait time descending
+    kRPVControllerLockStatsNumSites = __kRPVControllerLockStatsPropertiesFirst,
+    // Indexed name of the locking function (string)
+    kRPVControllerLockStatsFunctionIndexed,
+    // Indexed class of the object owning the mutex (string)
+    kRPVControllerLockStatsOwnerClassIndexed,
+    // Indexed lock mode, 1 for shared and 0 for exclusive (uint64)
+    kRPVControllerLockStatsSharedIndexed,
+    // Indexed number of acquisitions (uint64)
+    kRPVControllerLockStatsCountIndexed,
+    // Indexed number of acquisitions which waited at least 1us (uint64)
+    kRPVControllerLockStatsContendedIndexed,
+    // Indexed total wait time (uint64)
+    kRPVControllerLockStatsTotalWaitIndexed,
+    // Indexed longest wait time (uint64)
+    kRPVControllerLockStatsMaxWaitIndexed,
+    // Indexed total hold time (uint64)
+    kRPVControllerLockStatsTotalHoldIndexed,
+    // Indexed longest hold time (uint64)
+    kRPVControllerLockStatsMaxHoldIndexed,
+    // Number of histogram buckets per site (uint64), bucket i counts times in [2^i, 2^(i+1))
+    kRPVControllerLockStatsNumHistogramBuckets,
+    // Wait time histogram count (uint64), index is site * num buckets + bucket
+    kRPVControllerLockStatsWaitHistogramIndexed,
+    // Hold time histogram count (uint64), index is site * num buckets + bucket
+    kRPVControllerLockStatsHoldHistogramIndexed,
+    __kRPVControllerLockStatsPropertiesLast
+} rocprofvis_controller_lock_stats_properties_t;
+
+/*
+ * Properties for a memory report. Entries form a tree listed parents first, the
+ * bytes and items of an entry include those of its children.
+ */
+typedef enum rocprofvis_controller_memory_report_properties_t : uint32_t
+{
+    __kRPVControllerMemoryReportPropertiesFirst = 0x18000000,
+    // Number of entries (uint64)
+    kRPVControllerMemoryReportNumEntries = __kRPVControllerMemoryReportPropertiesFirst,
+    // Indexed entry name (string)
+    kRPVControllerMemoryReportNameIndexed,
+    // Indexed parent entry index, UINT64_MAX for top level entries (uint64)
+    kRPVControllerMemoryReportParentIndexed,
+    // Indexed bytes used (uint64)
+    kRPVControllerMemoryReportBytesIndexed,
+    // Indexed number of items held, such as events, rows or strings (uint64)
+    kRPVControllerMemoryReportItemsIndexed,
+    // Bytes of event and sample pool storage this trace may hold before segments are evicted (uint64)
+    kRPVControllerMemoryReportTraceBudget,
+    // Bytes of pool storage shared by all open traces (uint64)
+    kRPVControllerMemoryReportTotalBudget,
+    __kRPVControllerMemoryReportPropertiesLast
+} rocprofvis_controller_memory_report_properties_t;
+
 typedef enum rocprofvis_controller_sort_order_t
 {
     kRPVControllerSortOrderAscending,
@@ -31,6 +31,9 @@ typedef rocprofvis_handle_t rocprofvis_controller_stream_t;
 typedef rocprofvis_handle_t rocprofvis_controller_counter_t;
 typedef rocprofvis_handle_t rocprofvis_controller_summary_t;
 typedef rocprofvis_handle_t rocprofvis_controller_summary_metrics_t;
+typedef rocprofvis_handle_t rocprofvis_controller_query_telemetry_t;
+typedef rocprofvis_handle_t rocprofvis_controller_lock_stats_t;
+typedef rocprofvis_handle_t rocprofvis_controller_memory_report_t;
 typedef rocprofvis_handle_t rocprofvis_controller_topology_node_t;
 typedef rocprofvis_handle_t rocprofvis_profiler_config_t;
 typedef rocprofvis_handle_t rocprofvis_profiler_t;
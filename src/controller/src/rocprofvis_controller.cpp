@@ -10,6 +10,9 @@
 #include "rocprofvis_controller_arguments.h"
 #include "rocprofvis_controller_table.h"
 #include "rocprofvis_controller_trace.h"
+#include "rocprofvis_controller_query_telemetry.h"
+#include "rocprofvis_controller_lock_stats.h"
+#include "rocprofvis_controller_memory_report.h"
 #include "rocprofvis_core_assert.h"
 // TEMPORARY (remote/SSH): remove guard when remote graduates.
 #ifdef ROCPROFVIS_ENABLE_REMOTE
@@ -46,6 +49,9 @@ typedef Reference<rocprofvis_controller_table_t, Table, kRPVControllerObjectType
 typedef Reference<rocprofvis_controller_arguments_t, Arguments, kRPVControllerObjectTypeArguments> ArgumentsRef;
 typedef Reference<rocprofvis_controller_table_t, Summary, kRPVControllerObjectTypeSummary> SummaryRef;
 typedef Reference<rocprofvis_controller_summary_metrics_t, SummaryMetrics, kRPVControllerObjectTypeSummaryMetrics> SummaryMetricsRef;
+typedef Reference<rocprofvis_controller_query_telemetry_t, QueryTelemetry, kRPVControllerObjectTypeQueryTelemetry> QueryTelemetryRef;
+typedef Reference<rocprofvis_controller_lock_stats_t, LockStats, kRPVControllerObjectTypeLockStats> LockStatsRef;
+typedef Reference<rocprofvis_controller_memory_report_t, MemoryReport, kRPVControllerObjectTypeMemoryReport> MemoryReportRef;
 typedef Reference<rocprofvis_controller_t, ComputeTrace, kRPVControllerObjectTypeControllerCompute> ComputeTraceRef;
 typedef Reference<rocprofvis_controller_t, MetricsContainer, kRPVControllerObjectTypeMetricsContainer> MetricsContainerRef;
 typedef Reference<rocprofvis_handle_t, PcSampling, kRPVControllerObjectTypePCSampling> PcSamplingRef;
@@ -307,6 +313,21 @@ rocprofvis_controller_summary_metrics_t* rocprofvis_controller_summary_metrics_a
     rocprofvis_controller_summary_metrics_t* summary = (rocprofvis_controller_summary_metrics_t*)new RocProfVis::Controller::SummaryMetrics();
     return summary;
 }
+rocprofvis_controller_query_telemetry_t* rocprofvis_controller_query_telemetry_alloc(void)
+{
+    rocprofvis_controller_query_telemetry_t* telemetry = (rocprofvis_controller_query_telemetry_t*)new RocProfVis::Controller::QueryTelemetry();
+    return telemetry;
+}
+rocprofvis_controller_lock_stats_t* rocprofvis_controller_lock_stats_alloc(void)
+{
+    rocprofvis_controller_lock_stats_t* lock_stats = (rocprofvis_controller_lock_stats_t*)new RocProfVis::Controller::LockStats();
+    return lock_stats;
+}
+rocprofvis_controller_memory_report_t* rocprofvis_controller_memory_report_alloc(void)
+{
+    rocprofvis_controller_memory_report_t* report = (rocprofvis_controller_memory_report_t*)new RocProfVis::Controller::MemoryReport();
+    return report;
+}
 rocprofvis_result_t rocprofvis_controller_future_wait(rocprofvis_controller_future_t* object, float timeout)
 {
     rocprofvis_result_t result = kRocProfVisResultUnknownError;
@@ -463,6 +484,52 @@ rocprofvis_result_t rocprofvis_controller_table_export_csv(
     return error;
 }
 
+rocprofvis_result_t rocprofvis_controller_flow_fetch_async(
+    rocprofvis_controller_t* controller, rocprofvis_controller_arguments_t* args,
+    rocprofvis_controller_future_t* result, rocprofvis_controller_array_t* output)
+{
+    rocprofvis_result_t error = kRocProfVisResultInvalidArgument;
+    RocProfVis::Controller::SystemTraceRef trace(controller);
+    RocProfVis::Controller::ArgumentsRef args_ref(args);
+    RocProfVis::Controller::FutureRef future(result);
+    RocProfVis::Controller::ArrayRef array(output);
+    if(trace.IsValid() && args_ref.IsValid() && future.IsValid() && array.IsValid())
+    {
+        error = trace->AsyncFetchFlowRange(*args_ref, *future, *array);
+    }
+    return error;
+}
+
+rocprofvis_result_t rocprofvis_controller_track_load_async(
+    rocprofvis_controller_t* controller, rocprofvis_controller_arguments_t* args,
+    rocprofvis_controller_future_t* result)
+{
+    rocprofvis_result_t error = kRocProfVisResultInvalidArgument;
+    RocProfVis::Controller::SystemTraceRef trace(controller);
+    RocProfVis::Controller::ArgumentsRef args_ref(args);
+    RocProfVis::Controller::FutureRef future(result);
+    if(trace.IsValid() && args_ref.IsValid() && future.IsValid())
+    {
+        error = trace->AsyncLoadTracks(*args_ref, *future);
+    }
+    return error;
+}
+
+rocprofvis_result_t rocprofvis_controller_event_prefetch_async(
+    rocprofvis_controller_t* controller, rocprofvis_controller_arguments_t* args,
+    rocprofvis_controller_future_t* result)
+{
+    rocprofvis_result_t error = kRocProfVisResultInvalidArgument;
+    RocProfVis::Controller::SystemTraceRef trace(controller);
+    RocProfVis::Controller::ArgumentsRef args_ref(args);
+    RocProfVis::Controller::FutureRef future(result);
+    if(trace.IsValid() && args_ref.IsValid() && future.IsValid())
+    {
+        error = trace->AsyncPrefetchEvents(*args_ref, *future);
+    }
+    return error;
+}
+
 rocprofvis_result_t rocprofvis_controller_summary_fetch_async(
     rocprofvis_controller_t* controller, rocprofvis_controller_summary_t* summary,
     rocprofvis_controller_arguments_t* args, rocprofvis_controller_future_t* result,
@@ -482,6 +549,128 @@ rocprofvis_result_t rocprofvis_controller_summary_fetch_async(
     return error;
 }
 
+rocprofvis_result_t rocprofvis_controller_set_query_telemetry(rocprofvis_controller_t* controller,
+                                                              uint64_t enabled,
+                                                              double   slow_query_ms)
+{
+    rocprofvis_result_t result = kRocProfVisResultInvalidArgument;
+    RocProfVis::Controller::SystemTraceRef system_trace(controller);
+    RocProfVis::Controller::ComputeTraceRef compute_trace(controller);
+    if(system_trace.IsValid())
+    {
+        result = system_trace->SetQueryTelemetry(enabled != 0, slow_query_ms);
+    }
+    else if(compute_trace.IsValid())
+    {
+        result = compute_trace->SetQueryTelemetry(enabled != 0, slow_query_ms);
+    }
+    return result;
+}
+
+rocprofvis_result_t rocprofvis_controller_query_telemetry_fetch(
+    rocprofvis_controller_t* controller, rocprofvis_controller_query_telemetry_t* output)
+{
+    rocprofvis_result_t result = kRocProfVisResultInvalidArgument;
+    RocProfVis::Controller::SystemTraceRef system_trace(controller);
+    RocProfVis::Controller::ComputeTraceRef compute_trace(controller);
+    RocProfVis::Controller::QueryTelemetryRef output_ref(output);
+    if(output_ref.IsValid())
+    {
+        if(system_trace.IsValid())
+        {
+            result = system_trace->FetchQueryTelemetry(*output_ref);
+        }
+        else if(compute_trace.IsValid())
+        {
+            result = compute_trace->FetchQueryTelemetry(*output_ref);
+        }
+    }
+    return result;
+}
+
+rocprofvis_result_t rocprofvis_controller_query_telemetry_clear(rocprofvis_controller_t* controller)
+{
+    rocprofvis_result_t result = kRocProfVisResultInvalidArgument;
+    RocProfVis::Controller::SystemTraceRef system_trace(controller);
+    RocProfVis::Controller::ComputeTraceRef compute_trace(controller);
+    if(system_trace.IsValid())
+    {
+        result = system_trace->ClearQueryTelemetry();
+    }
+    else if(compute_trace.IsValid())
+    {
+        result = compute_trace->ClearQueryTelemetry();
+    }
+    return result;
+}
+
+rocprofvis_result_t rocprofvis_controller_set_lock_stats(uint64_t enabled)
+{
+    rocprofvis_dm_set_lock_stats_enabled(enabled != 0);
+    return kRocProfVisResultSuccess;
+}
+
+rocprofvis_result_t rocprofvis_controller_lock_stats_fetch(rocprofvis_controller_lock_stats_t* output)
+{
+    rocprofvis_result_t result = kRocProfVisResultInvalidArgument;
+    RocProfVis::Controller::LockStatsRef output_ref(output);
+    if(output_ref.IsValid())
+    {
+        result = output_ref->Fetch();
+    }
+    return result;
+}
+
+rocprofvis_result_t rocprofvis_controller_lock_stats_reset(void)
+{
+    rocprofvis_dm_reset_lock_stats();
+    return kRocProfVisResultSuccess;
+}
+
+rocprofvis_result_t rocprofvis_controller_memory_report_fetch(
+    rocprofvis_controller_t* controller, rocprofvis_controller_memory_report_t* output)
+{
+    rocprofvis_result_t result = kRocProfVisResultInvalidArgument;
+    RocProfVis::Controller::SystemTraceRef system_trace(controller);
+    RocProfVis::Controller::ComputeTraceRef compute_trace(controller);
+    RocProfVis::Controller::MemoryReportRef output_ref(output);
+    if(output_ref.IsValid())
+    {
+        if(system_trace.IsValid())
+        {
+            result = system_trace->FetchMemoryReport(*output_ref);
+        }
+        else if(compute_trace.IsValid())
+        {
+            result = compute_trace->FetchMemoryReport(*output_ref);
+        }
+    }
+    return result;
+}
+
+rocprofvis_result_t rocprofvis_controller_memory_report_fetch_async(
+    rocprofvis_controller_t* controller, rocprofvis_controller_future_t* future,
+    rocprofvis_controller_memory_report_t* output)
+{
+    rocprofvis_result_t result = kRocProfVisResultInvalidArgument;
+    RocProfVis::Controller::SystemTraceRef system_trace(controller);
+    RocProfVis::Controller::ComputeTraceRef compute_trace(controller);
+    RocProfVis::Controller::FutureRef future_ref(future);
+    RocProfVis::Controller::MemoryReportRef output_ref(output);
+    if(output_ref.IsValid() && future_ref.IsValid())
+    {
+        if(system_trace.IsValid())
+        {
+            result = system_trace->AsyncFetchMemoryReport(*future_ref, *output_ref);
+        }
+        else if(compute_trace.IsValid())
+        {
+            result = compute_trace->AsyncFetchMemoryReport(*future_ref, *output_ref);
+        }
+    }
+    return result;
+}
+
 rocprofvis_controller_metrics_container_t* rocprofvis_controller_metrics_container_alloc(void)
 {
     rocprofvis_controller_metrics_container_t* container = (rocprofvis_controller_metrics_container_t*)new RocProfVis::Controller::MetricsContainer();
@@ -700,6 +889,33 @@ void rocprofvis_controller_summary_metric_free(rocprofvis_controller_summary_met
     }
 }
 
+void rocprofvis_controller_query_telemetry_free(rocprofvis_controller_query_telemetry_t* object)
+{
+    RocProfVis::Controller::QueryTelemetryRef telemetry(object);
+    if(telemetry.IsValid())
+    {
+        delete telemetry.Get();
+    }
+}
+
+void rocprofvis_controller_lock_stats_free(rocprofvis_controller_lock_stats_t* object)
+{
+    RocProfVis::Controller::LockStatsRef lock_stats(object);
+    if(lock_stats.IsValid())
+    {
+        delete lock_stats.Get();
+    }
+}
+
+void rocprofvis_controller_memory_report_free(rocprofvis_controller_memory_report_t* object)
+{
+    RocProfVis::Controller::MemoryReportRef report(object);
+    if(report.IsValid())
+    {
+        delete report.Get();
+    }
+}
+
 void rocprofvis_controller_arguments_free(rocprofvis_controller_arguments_t* args)
 {
     RocProfVis::Controller::ArgumentsRef arguments(args);
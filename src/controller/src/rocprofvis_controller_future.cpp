@@ -56,9 +56,9 @@ rocprofvis_result_t Future::Cancel()
     if(m_job)
     {
         result = JobSystem::Get().CancelJob(m_job);
-        m_cancelled = true;
         {
             std::unique_lock lock(m_mutex);
+            m_cancelled = true;
             if(m_db_futures.size() > 0)
             {
                 for(auto future : m_db_futures)
@@ -80,6 +80,11 @@ Future::AddDependentFuture(rocprofvis_db_future_t db_future)
 {
     std::unique_lock lock(m_mutex);
     m_db_futures.push_back(db_future);
+    // Queries issued by a job after it has been cancelled are interrupted right away
+    if(m_cancelled)
+    {
+        rocprofvis_db_future_cancel(db_future);
+    }
     return kRocProfVisResultSuccess;
 }
 
@@ -4,6 +4,7 @@
 #include "rocprofvis_controller_job_system.h"
 #include "rocprofvis_controller_future.h"
 #include "rocprofvis_core_assert.h"
+#include "rocprofvis_core_profile.h"
 
 #include <cfloat>
 #include <algorithm>
@@ -75,8 +76,9 @@ JobSystem::JobSystem()
     size_t thread_count = std::thread::hardware_concurrency();
     for (size_t i = 0; i < thread_count; ++i)
     {
-        m_workers.emplace_back([this]()
+        m_workers.emplace_back([this, i]()
         {
+            Core::Profiler::SetThreadName("Controller Job Worker " + std::to_string(i));
             while (true)
             {
                 Job* job = nullptr;
@@ -95,10 +97,12 @@ JobSystem::JobSystem()
                     {
                         job = m_jobs.front();
                         m_jobs.erase(m_jobs.begin());
+                        PROFILE_COUNTER("Controller job queue depth", m_jobs.size());
                     }
                 }
                 if (job)
                 {
+                    PROFILE_ZONE("controller", "Job");
                     job->Execute();
                 }
             }
@@ -158,6 +162,7 @@ rocprofvis_result_t JobSystem::EnqueueJob(Job* job)
         {
             std::unique_lock<std::mutex> lock(m_queue_mutex);
             m_jobs.push_back(job);
+            PROFILE_COUNTER("Controller job queue depth", m_jobs.size());
         }
         m_condition_variable.notify_one();
         result = kRocProfVisResultSuccess;
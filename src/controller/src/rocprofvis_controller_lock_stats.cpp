@@ -0,0 +1,250 @@
+// Copyright Advanced Micro Devices, Inc.
+// SPDX-License-Identifier: MIT
+
+#include "rocprofvis_controller_lock_stats.h"
+
+namespace RocProfVis
+{
+namespace Controller
+{
+
+LockStats::LockStats()
+: Handle(__kRPVControllerLockStatsPropertiesFirst, __kRPVControllerLockStatsPropertiesLast)
+, m_num_buckets(0)
+{}
+
+LockStats::~LockStats()
+{}
+
+rocprofvis_controller_object_type_t LockStats::GetType(void)
+{
+    return kRPVControllerObjectTypeLockStats;
+}
+
+void LockStats::CollectSite(const rocprofvis_dm_lock_stats_t* stats, void* user_data)
+{
+    LockStats* lock_stats = (LockStats*) user_data;
+    lock_stats->m_sites.push_back({ stats->function, stats->owner_class, stats->shared != 0,
+                                    stats->count, stats->contended, stats->total_wait_ns,
+                                    stats->max_wait_ns, stats->total_hold_ns,
+                                    stats->max_hold_ns });
+    lock_stats->m_num_buckets = stats->num_buckets;
+    lock_stats->m_wait_histograms.insert(lock_stats->m_wait_histograms.end(),
+                                         stats->wait_histogram,
+                                         stats->wait_histogram + stats->num_buckets);
+    lock_stats->m_hold_histograms.insert(lock_stats->m_hold_histograms.end(),
+                                         stats->hold_histogram,
+                                         stats->hold_histogram + stats->num_buckets);
+}
+
+rocprofvis_result_t LockStats::Fetch()
+{
+    rocprofvis_result_t result = kRocProfVisResultUnknownError;
+    m_sites.clear();
+    m_wait_histograms.clear();
+    m_hold_histograms.clear();
+    if(rocprofvis_dm_get_lock_stats(&LockStats::CollectSite, this) == kRocProfVisDmResultSuccess)
+    {
+        result = kRocProfVisResultSuccess;
+    }
+    return result;
+}
+
+rocprofvis_result_t LockStats::GetUInt64(rocprofvis_property_t property, uint64_t index, uint64_t* value)
+{
+    rocprofvis_result_t result = kRocProfVisResultInvalidArgument;
+    if(value)
+    {
+        switch(property)
+        {
+            case kRPVControllerCommonMemoryUsageInclusive:
+            case kRPVControllerCommonMemoryUsageExclusive:
+            {
+                *value = sizeof(LockStats) + m_sites.capacity() * sizeof(Site) +
+                         (m_wait_histograms.capacity() + m_hold_histograms.capacity()) *
+                             sizeof(uint64_t);
+                result = kRocProfVisResultSuccess;
+                break;
+            }
+            case kRPVControllerLockStatsNumSites:
+            {
+                *value = m_sites.size();
+                result = kRocProfVisResultSuccess;
+                break;
+            }
+            case kRPVControllerLockStatsNumHistogramBuckets:
+            {
+                *value = m_num_buckets;
+                result = kRocProfVisResultSuccess;
+                break;
+            }
+            case kRPVControllerLockStatsSharedIndexed:
+            {
+                if(index < m_sites.size())
+                {
+                    *value = m_sites[index].shared ? 1 : 0;
+                    result = kRocProfVisResultSuccess;
+                }
+                else
+                {
+                    result = kRocProfVisResultOutOfRange;
+                }
+                break;
+            }
+            case kRPVControllerLockStatsCountIndexed:
+            {
+                if(index < m_sites.size())
+                {
+                    *value = m_sites[index].count;
+                    result = kRocProfVisResultSuccess;
+                }
+                else
+                {
+                    result = kRocProfVisResultOutOfRange;
+                }
+                break;
+            }
+            case kRPVControllerLockStatsContendedIndexed:
+            {
+                if(index < m_sites.size())
+                {
+                    *value = m_sites[index].contended;
+                    result = kRocProfVisResultSuccess;
+                }
+                else
+                {
+                    result = kRocProfVisResultOutOfRange;
+                }
+                break;
+            }
+            case kRPVControllerLockStatsTotalWaitIndexed:
+            {
+                if(index < m_sites.size())
+                {
+                    *value = m_sites[index].total_wait_ns;
+                    result = kRocProfVisResultSuccess;
+                }
+                else
+                {
+                    result = kRocProfVisResultOutOfRange;
+                }
+                break;
+            }
+            case kRPVControllerLockStatsMaxWaitIndexed:
+            {
+                if(index < m_sites.size())
+                {
+                    *value = m_sites[index].max_wait_ns;
+                    result = kRocProfVisResultSuccess;
+                }
+                else
+                {
+                    result = kRocProfVisResultOutOfRange;
+                }
+                break;
+            }
+            case kRPVControllerLockStatsTotalHoldIndexed:
+            {
+                if(index < m_sites.size())
+                {
+                    *value = m_sites[index].total_hold_ns;
+                    result = kRocProfVisResultSuccess;
+                }
+                else
+                {
+                    result = kRocProfVisResultOutOfRange;
+                }
+                break;
+            }
+            case kRPVControllerLockStatsMaxHoldIndexed:
+            {
+                if(index < m_sites.size())
+                {
+                    *value = m_sites[index].max_hold_ns;
+                    result = kRocProfVisResultSuccess;
+                }
+                else
+                {
+                    result = kRocProfVisResultOutOfRange;
+                }
+                break;
+            }
+            case kRPVControllerLockStatsWaitHistogramIndexed:
+            {
+                if(index < m_wait_histograms.size())
+                {
+                    *value = m_wait_histograms[index];
+                    result = kRocProfVisResultSuccess;
+                }
+                else
+                {
+                    result = kRocProfVisResultOutOfRange;
+                }
+                break;
+            }
+            case kRPVControllerLockStatsHoldHistogramIndexed:
+            {
+                if(index < m_hold_histograms.size())
+                {
+                    *value = m_hold_histograms[index];
+                    result = kRocProfVisResultSuccess;
+                }
+                else
+                {
+                    result = kRocProfVisResultOutOfRange;
+                }
+                break;
+            }
+            default:
+            {
+                result = UnhandledProperty(property);
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+rocprofvis_result_t LockStats::GetString(rocprofvis_property_t property, uint64_t index, char* value, uint32_t* length)
+{
+    rocprofvis_result_t result = kRocProfVisResultInvalidArgument;
+    if(length)
+    {
+        switch(property)
+        {
+            case kRPVControllerLockStatsFunctionIndexed:
+            {
+                if(index < m_sites.size())
+                {
+                    result = GetStdStringImpl(value, length, m_sites[index].function);
+                }
+                else
+                {
+                    result = kRocProfVisResultOutOfRange;
+                }
+                break;
+            }
+            case kRPVControllerLockStatsOwnerClassIndexed:
+            {
+                if(index < m_sites.size())
+                {
+                    result = GetStdStringImpl(value, length, m_sites[index].owner_class);
+                }
+                else
+                {
+                    result = kRocProfVisResultOutOfRange;
+                }
+                break;
+            }
+            default:
+            {
+                result = UnhandledProperty(property);
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+}  // namespace Controller
+}  // namespace RocProfVis
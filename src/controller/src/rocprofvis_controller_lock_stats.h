@@ -0,0 +1,56 @@
+// Copyright Advanced Micro Devices, Inc.
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "rocprofvis_controller.h"
+#include "rocprofvis_controller_handle.h"
+#include "rocprofvis_c_interface.h"
+#include <string>
+#include <vector>
+
+namespace RocProfVis
+{
+namespace Controller
+{
+
+// Snapshot of the wait and hold time statistics of the data model locks
+class LockStats : public Handle
+{
+public:
+    LockStats();
+    virtual ~LockStats();
+
+    rocprofvis_controller_object_type_t GetType(void) final;
+
+    rocprofvis_result_t GetUInt64(rocprofvis_property_t property, uint64_t index, uint64_t* value) final;
+    rocprofvis_result_t GetString(rocprofvis_property_t property, uint64_t index, char* value, uint32_t* length) final;
+
+    // Replaces the snapshot with the current lock statistics
+    rocprofvis_result_t Fetch();
+
+private:
+    static void CollectSite(const rocprofvis_dm_lock_stats_t* stats, void* user_data);
+
+    struct Site
+    {
+        std::string function;
+        std::string owner_class;
+        bool        shared;
+        uint64_t    count;
+        uint64_t    contended;
+        uint64_t    total_wait_ns;
+        uint64_t    max_wait_ns;
+        uint64_t    total_hold_ns;
+        uint64_t    max_hold_ns;
+    };
+
+    std::vector<Site>     m_sites;
+    uint32_t              m_num_buckets;
+    // histograms of all sites, num buckets entries per site
+    std::vector<uint64_t> m_wait_histograms;
+    std::vector<uint64_t> m_hold_histograms;
+};
+
+}  // namespace Controller
+}  // namespace RocProfVis
@@ -0,0 +1,165 @@
+// Copyright Advanced Micro Devices, Inc.
+// SPDX-License-Identifier: MIT
+
+#include "rocprofvis_controller_memory_report.h"
+
+namespace RocProfVis
+{
+namespace Controller
+{
+
+MemoryReport::MemoryReport()
+: Handle(__kRPVControllerMemoryReportPropertiesFirst, __kRPVControllerMemoryReportPropertiesLast)
+, m_trace_budget(0)
+, m_total_budget(0)
+{}
+
+MemoryReport::~MemoryReport()
+{}
+
+rocprofvis_controller_object_type_t MemoryReport::GetType(void)
+{
+    return kRPVControllerObjectTypeMemoryReport;
+}
+
+void MemoryReport::Clear()
+{
+    m_entries.clear();
+    m_trace_budget = 0;
+    m_total_budget = 0;
+}
+
+uint64_t MemoryReport::AddEntry(const std::string& name, uint64_t parent)
+{
+    m_entries.push_back({ name, parent, 0, 0 });
+    return m_entries.size() - 1;
+}
+
+void MemoryReport::Accumulate(uint64_t index, uint64_t bytes, uint64_t items)
+{
+    while(index < m_entries.size())
+    {
+        m_entries[index].bytes += bytes;
+        m_entries[index].items += items;
+        index = m_entries[index].parent;
+    }
+}
+
+void MemoryReport::SetBudget(uint64_t trace_budget, uint64_t total_budget)
+{
+    m_trace_budget = trace_budget;
+    m_total_budget = total_budget;
+}
+
+rocprofvis_result_t MemoryReport::GetUInt64(rocprofvis_property_t property, uint64_t index, uint64_t* value)
+{
+    rocprofvis_result_t result = kRocProfVisResultInvalidArgument;
+    if(value)
+    {
+        switch(property)
+        {
+            case kRPVControllerCommonMemoryUsageInclusive:
+            case kRPVControllerCommonMemoryUsageExclusive:
+            {
+                *value = sizeof(MemoryReport) + m_entries.capacity() * sizeof(Entry);
+                result = kRocProfVisResultSuccess;
+                break;
+            }
+            case kRPVControllerMemoryReportNumEntries:
+            {
+                *value = m_entries.size();
+                result = kRocProfVisResultSuccess;
+                break;
+            }
+            case kRPVControllerMemoryReportParentIndexed:
+            {
+                if(index < m_entries.size())
+                {
+                    *value = m_entries[index].parent;
+                    result = kRocProfVisResultSuccess;
+                }
+                else
+                {
+                    result = kRocProfVisResultOutOfRange;
+                }
+                break;
+            }
+            case kRPVControllerMemoryReportBytesIndexed:
+            {
+                if(index < m_entries.size())
+                {
+                    *value = m_entries[index].bytes;
+                    result = kRocProfVisResultSuccess;
+                }
+                else
+                {
+                    result = kRocProfVisResultOutOfRange;
+                }
+                break;
+            }
+            case kRPVControllerMemoryReportItemsIndexed:
+            {
+                if(index < m_entries.size())
+                {
+                    *value = m_entries[index].items;
+                    result = kRocProfVisResultSuccess;
+                }
+                else
+                {
+                    result = kRocProfVisResultOutOfRange;
+                }
+                break;
+            }
+            case kRPVControllerMemoryReportTraceBudget:
+            {
+                *value = m_trace_budget;
+                result = kRocProfVisResultSuccess;
+                break;
+            }
+            case kRPVControllerMemoryReportTotalBudget:
+            {
+                *value = m_total_budget;
+                result = kRocProfVisResultSuccess;
+                break;
+            }
+            default:
+            {
+                result = UnhandledProperty(property);
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+rocprofvis_result_t MemoryReport::GetString(rocprofvis_property_t property, uint64_t index, char* value, uint32_t* length)
+{
+    rocprofvis_result_t result = kRocProfVisResultInvalidArgument;
+    if(length)
+    {
+        switch(property)
+        {
+            case kRPVControllerMemoryReportNameIndexed:
+            {
+                if(index < m_entries.size())
+                {
+                    result = GetStdStringImpl(value, length, m_entries[index].name);
+                }
+                else
+                {
+                    result = kRocProfVisResultOutOfRange;
+                }
+                break;
+            }
+            default:
+            {
+                result = UnhandledProperty(property);
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+}  // namespace Controller
+}  // namespace RocProfVis
@@ -0,0 +1,56 @@
+// Copyright Advanced Micro Devices, Inc.
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "rocprofvis_controller.h"
+#include "rocprofvis_controller_handle.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace RocProfVis
+{
+namespace Controller
+{
+
+// Hierarchical snapshot of the memory held by a trace. Entries are stored parents
+// first and their sizes include the sizes of all their children.
+class MemoryReport : public Handle
+{
+public:
+    // Parent index of top level entries
+    static constexpr uint64_t NO_PARENT = UINT64_MAX;
+
+    MemoryReport();
+    virtual ~MemoryReport();
+
+    rocprofvis_controller_object_type_t GetType(void) final;
+
+    rocprofvis_result_t GetUInt64(rocprofvis_property_t property, uint64_t index, uint64_t* value) final;
+    rocprofvis_result_t GetString(rocprofvis_property_t property, uint64_t index, char* value, uint32_t* length) final;
+
+    void     Clear();
+    // Adds an empty entry
+    // @return index of the new entry
+    uint64_t AddEntry(const std::string& name, uint64_t parent);
+    // Adds bytes and items to an entry and all of its ancestors
+    void     Accumulate(uint64_t index, uint64_t bytes, uint64_t items);
+    void     SetBudget(uint64_t trace_budget, uint64_t total_budget);
+
+private:
+    struct Entry
+    {
+        std::string name;
+        uint64_t    parent;
+        uint64_t    bytes;
+        uint64_t    items;
+    };
+
+    std::vector<Entry> m_entries;
+    uint64_t           m_trace_budget;
+    uint64_t           m_total_budget;
+};
+
+}  // namespace Controller
+}  // namespace RocProfVis
@@ -0,0 +1,324 @@
+// Copyright Advanced Micro Devices, Inc.
+// SPDX-License-Identifier: MIT
+
+#include "rocprofvis_controller_query_telemetry.h"
+
+namespace RocProfVis
+{
+namespace Controller
+{
+
+QueryTelemetry::QueryTelemetry()
+: Handle(__kRPVControllerQueryTelemetryPropertiesFirst, __kRPVControllerQueryTelemetryPropertiesLast)
+{}
+
+QueryTelemetry::~QueryTelemetry()
+{}
+
+rocprofvis_controller_object_type_t QueryTelemetry::GetType(void)
+{
+    return kRPVControllerObjectTypeQueryTelemetry;
+}
+
+void QueryTelemetry::CollectQueryStats(const rocprofvis_db_query_stats_t* stats, void* user_data)
+{
+    QueryTelemetry* telemetry = (QueryTelemetry*) user_data;
+    telemetry->m_queries.push_back({ stats->query_template, stats->connection, stats->plan,
+                                     stats->count, stats->failures, stats->total_ms, stats->max_ms,
+                                     stats->rows, stats->bytes });
+}
+
+void QueryTelemetry::CollectSlowQuery(const rocprofvis_db_slow_query_t* query, void* user_data)
+{
+    QueryTelemetry* telemetry = (QueryTelemetry*) user_data;
+    telemetry->m_slow_queries.push_back({ query->query, query->connection, query->duration_ms,
+                                          query->rows, query->bytes, query->error });
+}
+
+rocprofvis_result_t QueryTelemetry::Fetch(rocprofvis_dm_database_t db)
+{
+    rocprofvis_result_t result = kRocProfVisResultInvalidArgument;
+    m_queries.clear();
+    m_slow_queries.clear();
+    if(db)
+    {
+        rocprofvis_dm_result_t dm_result = rocprofvis_db_get_query_telemetry(
+            db, &QueryTelemetry::CollectQueryStats, &QueryTelemetry::CollectSlowQuery, this);
+        if(dm_result == kRocProfVisDmResultSuccess)
+        {
+            result = kRocProfVisResultSuccess;
+        }
+        else if(dm_result == kRocProfVisDmResultNotSupported)
+        {
+            result = kRocProfVisResultNotSupported;
+        }
+        else
+        {
+            result = kRocProfVisResultUnknownError;
+        }
+    }
+    return result;
+}
+
+rocprofvis_result_t QueryTelemetry::GetUInt64(rocprofvis_property_t property, uint64_t index, uint64_t* value)
+{
+    rocprofvis_result_t result = kRocProfVisResultInvalidArgument;
+    if(value)
+    {
+        switch(property)
+        {
+            case kRPVControllerCommonMemoryUsageInclusive:
+            case kRPVControllerCommonMemoryUsageExclusive:
+            {
+                *value = sizeof(QueryTelemetry) + m_queries.capacity() * sizeof(QueryStats) +
+                         m_slow_queries.capacity() * sizeof(SlowQuery);
+                result = kRocProfVisResultSuccess;
+                break;
+            }
+            case kRPVControllerQueryTelemetryNumQueries:
+            {
+                *value = m_queries.size();
+                result = kRocProfVisResultSuccess;
+                break;
+            }
+            case kRPVControllerQueryTelemetryQueryCountIndexed:
+            {
+                if(index < m_queries.size())
+                {
+                    *value = m_queries[index].count;
+                    result = kRocProfVisResultSuccess;
+                }
+                else
+                {
+                    result = kRocProfVisResultOutOfRange;
+                }
+                break;
+            }
+            case kRPVControllerQueryTelemetryQueryFailuresIndexed:
+            {
+                if(index < m_queries.size())
+                {
+                    *value = m_queries[index].failures;
+                    result = kRocProfVisResultSuccess;
+                }
+                else
+                {
+                    result = kRocProfVisResultOutOfRange;
+                }
+                break;
+            }
+            case kRPVControllerQueryTelemetryQueryRowsIndexed:
+            {
+                if(index < m_queries.size())
+                {
+                    *value = m_queries[index].rows;
+                    result = kRocProfVisResultSuccess;
+                }
+                else
+                {
+                    result = kRocProfVisResultOutOfRange;
+                }
+                break;
+            }
+            case kRPVControllerQueryTelemetryQueryBytesIndexed:
+            {
+                if(index < m_queries.size())
+                {
+                    *value = m_queries[index].bytes;
+                    result = kRocProfVisResultSuccess;
+                }
+                else
+                {
+                    result = kRocProfVisResultOutOfRange;
+                }
+                break;
+            }
+            case kRPVControllerQueryTelemetryNumSlowQueries:
+            {
+                *value = m_slow_queries.size();
+                result = kRocProfVisResultSuccess;
+                break;
+            }
+            case kRPVControllerQueryTelemetrySlowQueryRowsIndexed:
+            {
+                if(index < m_slow_queries.size())
+                {
+                    *value = m_slow_queries[index].rows;
+                    result = kRocProfVisResultSuccess;
+                }
+                else
+                {
+                    result = kRocProfVisResultOutOfRange;
+                }
+                break;
+            }
+            case kRPVControllerQueryTelemetrySlowQueryBytesIndexed:
+            {
+                if(index < m_slow_queries.size())
+                {
+                    *value = m_slow_queries[index].bytes;
+                    result = kRocProfVisResultSuccess;
+                }
+                else
+                {
+                    result = kRocProfVisResultOutOfRange;
+                }
+                break;
+            }
+            default:
+            {
+                result = UnhandledProperty(property);
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+rocprofvis_result_t QueryTelemetry::GetDouble(rocprofvis_property_t property, uint64_t index, double* value)
+{
+    rocprofvis_result_t result = kRocProfVisResultInvalidArgument;
+    if(value)
+    {
+        switch(property)
+        {
+            case kRPVControllerQueryTelemetryQueryTotalTimeIndexed:
+            {
+                if(index < m_queries.size())
+                {
+                    *value = m_queries[index].total_ms;
+                    result = kRocProfVisResultSuccess;
+                }
+                else
+                {
+                    result = kRocProfVisResultOutOfRange;
+                }
+                break;
+            }
+            case kRPVControllerQueryTelemetryQueryMaxTimeIndexed:
+            {
+                if(index < m_queries.size())
+                {
+                    *value = m_queries[index].max_ms;
+                    result = kRocProfVisResultSuccess;
+                }
+                else
+                {
+                    result = kRocProfVisResultOutOfRange;
+                }
+                break;
+            }
+            case kRPVControllerQueryTelemetrySlowQueryTimeIndexed:
+            {
+                if(index < m_slow_queries.size())
+                {
+                    *value = m_slow_queries[index].duration_ms;
+                    result = kRocProfVisResultSuccess;
+                }
+                else
+                {
+                    result = kRocProfVisResultOutOfRange;
+                }
+                break;
+            }
+            default:
+            {
+                result = UnhandledProperty(property);
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+rocprofvis_result_t QueryTelemetry::GetString(rocprofvis_property_t property, uint64_t index, char* value, uint32_t* length)
+{
+    rocprofvis_result_t result = kRocProfVisResultInvalidArgument;
+    if(length)
+    {
+        switch(property)
+        {
+            case kRPVControllerQueryTelemetryQueryTemplateIndexed:
+            {
+                if(index < m_queries.size())
+                {
+                    result = GetStdStringImpl(value, length, m_queries[index].query_template);
+                }
+                else
+                {
+                    result = kRocProfVisResultOutOfRange;
+                }
+                break;
+            }
+            case kRPVControllerQueryTelemetryQueryConnectionIndexed:
+            {
+                if(index < m_queries.size())
+                {
+                    result = GetStdStringImpl(value, length, m_queries[index].connection);
+                }
+                else
+                {
+                    result = kRocProfVisResultOutOfRange;
+                }
+                break;
+            }
+            case kRPVControllerQueryTelemetryQueryPlanIndexed:
+            {
+                if(index < m_queries.size())
+                {
+                    result = GetStdStringImpl(value, length, m_queries[index].plan);
+                }
+                else
+                {
+                    result = kRocProfVisResultOutOfRange;
+                }
+                break;
+            }
+            case kRPVControllerQueryTelemetrySlowQueryTextIndexed:
+            {
+                if(index < m_slow_queries.size())
+                {
+                    result = GetStdStringImpl(value, length, m_slow_queries[index].query);
+                }
+                else
+                {
+                    result = kRocProfVisResultOutOfRange;
+                }
+                break;
+            }
+            case kRPVControllerQueryTelemetrySlowQueryConnectionIndexed:
+            {
+                if(index < m_slow_queries.size())
+                {
+                    result = GetStdStringImpl(value, length, m_slow_queries[index].connection);
+                }
+                else
+                {
+                    result = kRocProfVisResultOutOfRange;
+                }
+                break;
+            }
+            case kRPVControllerQueryTelemetrySlowQueryErrorIndexed:
+            {
+                if(index < m_slow_queries.size())
+                {
+                    result = GetStdStringImpl(value, length, m_slow_queries[index].error);
+                }
+                else
+                {
+                    result = kRocProfVisResultOutOfRange;
+                }
+                break;
+            }
+            default:
+            {
+                result = UnhandledProperty(property);
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+}  // namespace Controller
+}  // namespace RocProfVis
@@ -0,0 +1,64 @@
+// Copyright Advanced Micro Devices, Inc.
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "rocprofvis_controller.h"
+#include "rocprofvis_controller_handle.h"
+#include "rocprofvis_c_interface.h"
+#include <string>
+#include <vector>
+
+namespace RocProfVis
+{
+namespace Controller
+{
+
+// Snapshot of the SQL query statistics and slow query log collected by the data model
+class QueryTelemetry : public Handle
+{
+public:
+    QueryTelemetry();
+    virtual ~QueryTelemetry();
+
+    rocprofvis_controller_object_type_t GetType(void) final;
+
+    rocprofvis_result_t GetUInt64(rocprofvis_property_t property, uint64_t index, uint64_t* value) final;
+    rocprofvis_result_t GetDouble(rocprofvis_property_t property, uint64_t index, double* value) final;
+    rocprofvis_result_t GetString(rocprofvis_property_t property, uint64_t index, char* value, uint32_t* length) final;
+
+    // Replaces the snapshot with the current telemetry of the database
+    rocprofvis_result_t Fetch(rocprofvis_dm_database_t db);
+
+private:
+    static void CollectQueryStats(const rocprofvis_db_query_stats_t* stats, void* user_data);
+    static void CollectSlowQuery(const rocprofvis_db_slow_query_t* query, void* user_data);
+
+    struct QueryStats
+    {
+        std::string query_template;
+        std::string connection;
+        std::string plan;
+        uint64_t    count;
+        uint64_t    failures;
+        double      total_ms;
+        double      max_ms;
+        uint64_t    rows;
+        uint64_t    bytes;
+    };
+    struct SlowQuery
+    {
+        std::string query;
+        std::string connection;
+        double      duration_ms;
+        uint64_t    rows;
+        uint64_t    bytes;
+        std::string error;
+    };
+
+    std::vector<QueryStats> m_queries;
+    std::vector<SlowQuery>  m_slow_queries;
+};
+
+}  // namespace Controller
+}  // namespace RocProfVis
@@ -2,8 +2,13 @@
 // SPDX-License-Identifier: MIT
 
 #include "rocprofvis_controller_trace.h"
+#include "rocprofvis_controller_future.h"
 #include "rocprofvis_controller_id.h"
+#include "rocprofvis_controller_job_system.h"
+#include "rocprofvis_controller_query_telemetry.h"
+#include "rocprofvis_controller_memory_report.h"
 #include "rocprofvis_core.h"
+#include <filesystem>
 
 namespace RocProfVis
 {
@@ -12,11 +17,17 @@ namespace Controller
 
 static IdGenerator<Trace> s_trace_id;
 
+static const char* s_memory_category_names[kRPVDMNumMemoryCategories] = {
+    "Events", "Samples", "Flow traces", "Stack traces", "Extended data", "Tables", "Strings"
+};
+
 Trace::Trace(uint32_t first_prop_index, uint32_t last_prop_index, const std::string& filename)
 : Handle(first_prop_index, last_prop_index)
 , m_id(s_trace_id.GetNextId())
 , m_dm_handle(nullptr)
 , m_trace_file(filename)
+, m_query_telemetry_enabled(false)
+, m_slow_query_ms(0.0)
 {}
 
 Trace::~Trace()
@@ -31,5 +42,145 @@ Trace::GetDMHandle() const
     return m_dm_handle;
 }
 
+rocprofvis_dm_database_t
+Trace::GetDatabase() const
+{
+    return m_dm_handle ? rocprofvis_dm_get_property_as_handle(m_dm_handle, kRPVDMDatabaseHandle, 0)
+                       : nullptr;
+}
+
+void
+Trace::ApplyQueryTelemetry(rocprofvis_dm_database_t db)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if(m_query_telemetry_enabled)
+    {
+        rocprofvis_db_set_query_telemetry(db, true, m_slow_query_ms);
+    }
+}
+
+rocprofvis_result_t
+Trace::SetQueryTelemetry(bool enabled, double slow_query_ms)
+{
+    rocprofvis_result_t result = kRocProfVisResultSuccess;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_query_telemetry_enabled = enabled;
+    m_slow_query_ms           = slow_query_ms;
+    rocprofvis_dm_database_t db = GetDatabase();
+    if(db && rocprofvis_db_set_query_telemetry(db, enabled, slow_query_ms) !=
+                 kRocProfVisDmResultSuccess)
+    {
+        result = kRocProfVisResultNotSupported;
+    }
+    return result;
+}
+
+rocprofvis_result_t
+Trace::FetchQueryTelemetry(QueryTelemetry& telemetry)
+{
+    rocprofvis_dm_database_t db = GetDatabase();
+    return db ? telemetry.Fetch(db) : kRocProfVisResultNotLoaded;
+}
+
+rocprofvis_result_t
+Trace::ClearQueryTelemetry()
+{
+    rocprofvis_result_t      result = kRocProfVisResultNotLoaded;
+    rocprofvis_dm_database_t db     = GetDatabase();
+    if(db)
+    {
+        result = rocprofvis_db_clear_query_telemetry(db) == kRocProfVisDmResultSuccess
+                     ? kRocProfVisResultSuccess
+                     : kRocProfVisResultNotSupported;
+    }
+    return result;
+}
+
+rocprofvis_result_t
+Trace::FetchMemoryReport(MemoryReport& report)
+{
+    report.Clear();
+    if(m_dm_handle == nullptr)
+    {
+        return kRocProfVisResultNotLoaded;
+    }
+
+    uint64_t root = report.AddEntry(std::filesystem::path(m_trace_file).filename().string(),
+                                    MemoryReport::NO_PARENT);
+    report.Accumulate(root, sizeof(*this), 0);
+
+    uint64_t model = report.AddEntry("Data model", root);
+    for(uint32_t category = 0; category < kRPVDMNumMemoryCategories; category++)
+    {
+        uint64_t entry = report.AddEntry(s_memory_category_names[category], model);
+        if(category == kRPVDMMemoryEvents || category == kRPVDMMemorySamples)
+        {
+            // break event and sample memory down per track, tracks without loaded data are left out
+            uint64_t num_tracks =
+                rocprofvis_dm_get_property_as_uint64(m_dm_handle, kRPVDMNumberOfTracksUInt64, 0);
+            for(uint64_t i = 0; i < num_tracks; i++)
+            {
+                rocprofvis_dm_track_t dm_track =
+                    rocprofvis_dm_get_property_as_handle(m_dm_handle, kRPVDMTrackHandleIndexed, i);
+                bool is_pmc = rocprofvis_dm_get_property_as_uint64(
+                                  dm_track, kRPVDMTrackCategoryEnumUInt64, 0) == kRocProfVisDmPmcTrack;
+                if(is_pmc != (category == kRPVDMMemorySamples))
+                {
+                    continue;
+                }
+                uint64_t bytes =
+                    rocprofvis_dm_get_property_as_uint64(dm_track, kRPVDMTrackMemoryFootprintUInt64, 0);
+                if(bytes > 0)
+                {
+                    std::string name =
+                        std::string(rocprofvis_dm_get_property_as_charptr(
+                            dm_track, kRPVDMTrackMainProcessNameCharPtr, 0)) +
+                        " " +
+                        rocprofvis_dm_get_property_as_charptr(dm_track,
+                                                              kRPVDMTrackSubProcessNameCharPtr, 0);
+                    report.Accumulate(report.AddEntry(name, entry), bytes,
+                                      rocprofvis_dm_get_property_as_uint64(
+                                          dm_track, kRPVDMTrackNumLoadedRecordsUInt64, 0));
+                }
+            }
+        }
+        else
+        {
+            report.Accumulate(entry,
+                              rocprofvis_dm_get_property_as_uint64(
+                                  m_dm_handle, kRPVDMTraceMemoryUsageUInt64Indexed, category),
+                              rocprofvis_dm_get_property_as_uint64(
+                                  m_dm_handle, kRPVDMTraceMemoryItemsUInt64Indexed, category));
+        }
+    }
+
+    rocprofvis_dm_database_t db = GetDatabase();
+    if(db)
+    {
+        report.Accumulate(report.AddEntry("Database", root),
+                          rocprofvis_db_get_memory_footprint(db), 0);
+    }
+    return kRocProfVisResultSuccess;
+}
+
+rocprofvis_result_t
+Trace::AsyncFetchMemoryReport(Future& future, MemoryReport& report)
+{
+    rocprofvis_result_t error = kRocProfVisResultUnknownError;
+
+    future.Set(JobSystem::Get().IssueJob(
+        [this, &report](Future* future) -> rocprofvis_result_t {
+            (void) future;
+            return FetchMemoryReport(report);
+        },
+        &future));
+
+    if(future.IsValid())
+    {
+        error = kRocProfVisResultSuccess;
+    }
+    return error;
+}
+
 }
 }
@@ -15,6 +15,8 @@ namespace Controller
 {
 
 class Future;
+class QueryTelemetry;
+class MemoryReport;
 
 class Trace : public Handle
 {
@@ -29,11 +31,26 @@ public:
 
     rocprofvis_dm_handle_t GetDMHandle() const;
 
+    // Enables SQL query telemetry, settings made before the trace loads are applied once the database opens
+    rocprofvis_result_t SetQueryTelemetry(bool enabled, double slow_query_ms);
+    rocprofvis_result_t FetchQueryTelemetry(QueryTelemetry& telemetry);
+    rocprofvis_result_t ClearQueryTelemetry();
+
+    // Measures the memory held by the data model and the database of the trace
+    virtual rocprofvis_result_t FetchMemoryReport(MemoryReport& report);
+    // Runs FetchMemoryReport on the job system, the report must outlive the future
+    rocprofvis_result_t AsyncFetchMemoryReport(Future& future, MemoryReport& report);
+
 protected:
+    rocprofvis_dm_database_t GetDatabase() const;
+    void                     ApplyQueryTelemetry(rocprofvis_dm_database_t db);
+
     uint64_t              m_id;
     rocprofvis_dm_trace_t m_dm_handle;
     std::mutex            m_mutex;
     std::string           m_trace_file;
+    bool                  m_query_telemetry_enabled;
+    double                m_slow_query_ms;
 };
 
 }  // namespace Controller
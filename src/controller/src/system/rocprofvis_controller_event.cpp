@@ -7,6 +7,7 @@
 #include "rocprofvis_controller_array.h"
 #include "rocprofvis_controller_ext_data.h"
 #include "rocprofvis_controller_flow_control.h"
+#include "rocprofvis_controller_future.h"
 #include "rocprofvis_controller_call_stack.h"
 #include "rocprofvis_controller_string_table.h"
 #include "json.h"
@@ -92,8 +93,8 @@ Event::FetchDataModelFlowTraceProperty(uint64_t event_id, Array& array,
                     if(kRocProfVisDmResultSuccess == rocprofvis_db_future_wait(object, UINT64_MAX))
                     {
                         if(kRocProfVisDmResultSuccess ==
-                               rocprofvis_dm_get_property_as_handle(
-                                   dm_trace_handle, kRPVDMFlowTraceHandleByEventID, event_id,
+                               rocprofvis_dm_pin_event_property(
+                                   dm_trace_handle, kRPVDMEventFlowTrace, dm_event_id,
                                    &dm_flowtrace) &&
                            dm_flowtrace != nullptr)
                         {
@@ -186,8 +187,13 @@ Event::FetchDataModelFlowTraceProperty(uint64_t event_id, Array& array,
                         result = kRocProfVisResultTimeout;
                     }
                 }
-                rocprofvis_dm_delete_event_property(
-                    dm_trace_handle, kRPVDMEventFlowTrace, dm_flowtrace);
+                // flow trace stays in data model event property cache for repeated requests,
+                // pin only keeps it from being evicted while read
+                if(dm_flowtrace != nullptr)
+                {
+                    rocprofvis_dm_unpin_event_property(dm_trace_handle, kRPVDMEventFlowTrace,
+                                                       dm_flowtrace);
+                }
             }
             rocprofvis_db_future_free(object);
         }
@@ -195,6 +201,170 @@ Event::FetchDataModelFlowTraceProperty(uint64_t event_id, Array& array,
     return result;
 }
 
+rocprofvis_result_t
+Event::FetchDataModelFlowRange(uint64_t start, uint64_t end, std::vector<uint32_t>& tracks,
+                               Array& array, rocprofvis_dm_trace_t dm_trace_handle,
+                               Future* future)
+{
+    rocprofvis_result_t result = kRocProfVisResultUnknownError;
+    if(dm_trace_handle && future)
+    {
+        rocprofvis_dm_database_t db =
+            rocprofvis_dm_get_property_as_handle(dm_trace_handle, kRPVDMDatabaseHandle, 0);
+        if(db != nullptr)
+        {
+            rocprofvis_db_future_t object = rocprofvis_db_future_alloc(nullptr);
+            if(object != nullptr)
+            {
+                rocprofvis_dm_result_t dm_result = rocprofvis_db_read_flow_range_async(
+                    db, start, end, static_cast<rocprofvis_db_num_of_tracks_t>(tracks.size()),
+                    tracks.data(), object);
+                if(kRocProfVisDmResultSuccess == dm_result)
+                {
+                    future->AddDependentFuture(object);
+                    dm_result = rocprofvis_db_future_wait(object, UINT64_MAX);
+                    future->RemoveDependentFuture(object);
+                }
+                rocprofvis_dm_event_id_t range_id;
+                range_id.value = rocprofvis_dm_hash_combine_timestamp(
+                    start, end, kRocProfVisDmHashedTimestampTagFlowRange);
+                rocprofvis_dm_flowtrace_t dm_flowtrace = nullptr;
+                rocprofvis_dm_pin_event_property(dm_trace_handle, kRPVDMEventFlowTrace,
+                                                 range_id, &dm_flowtrace);
+                if(dm_result == kRocProfVisDmResultNotSupported)
+                {
+                    // Database type without flow index, nothing to show
+                    result = array.SetUInt64(kRPVControllerArrayNumEntries, 0, 0);
+                }
+                else if(dm_result == kRocProfVisDmResultDbAbort || future->IsCancelled())
+                {
+                    result = kRocProfVisResultCancelled;
+                }
+                else if(dm_result == kRocProfVisDmResultSuccess && dm_flowtrace != nullptr)
+                {
+                    uint64_t records_count = 0;
+                    result = kRocProfVisResultUnknownError;
+                    if(kRocProfVisDmResultSuccess ==
+                       rocprofvis_dm_get_property_as_uint64(
+                           dm_flowtrace, kRPVDMNumberOfEndpointsUInt64, 0, &records_count))
+                    {
+                        // Endpoints are stored as origin / target pairs
+                        records_count -= records_count % 2;
+                        result = array.SetUInt64(kRPVControllerArrayNumEntries, 0,
+                                                 records_count);
+                        for(uint64_t index = 0;
+                            index < records_count && result == kRocProfVisResultSuccess;
+                            index++)
+                        {
+                            uint64_t id              = 0;
+                            uint64_t start_timestamp = 0;
+                            uint64_t end_timestamp   = 0;
+                            uint64_t track_id        = 0;
+                            uint64_t level           = 0;
+                            char*    category        = nullptr;
+                            char*    symbol          = nullptr;
+                            if(kRocProfVisDmResultSuccess ==
+                                   rocprofvis_dm_get_property_as_uint64(
+                                       dm_flowtrace, kRPVDMEndpointIDUInt64Indexed, index,
+                                       &id) &&
+                               kRocProfVisDmResultSuccess ==
+                                   rocprofvis_dm_get_property_as_uint64(
+                                       dm_flowtrace, kRPVDMEndpointTimestampUInt64Indexed,
+                                       index, &start_timestamp) &&
+                               kRocProfVisDmResultSuccess ==
+                                   rocprofvis_dm_get_property_as_uint64(
+                                       dm_flowtrace, kRPVDMEndpointEndTimestampUInt64Indexed,
+                                       index, &end_timestamp) &&
+                               kRocProfVisDmResultSuccess ==
+                                   rocprofvis_dm_get_property_as_uint64(
+                                       dm_flowtrace, kRPVDMEndpointTrackIDUInt64Indexed,
+                                       index, &track_id) &&
+                               kRocProfVisDmResultSuccess ==
+                                   rocprofvis_dm_get_property_as_charptr(
+                                       dm_flowtrace, kRPVDMEndpointCategoryCharPtrIndexed,
+                                       index, &category) &&
+                               kRocProfVisDmResultSuccess ==
+                                   rocprofvis_dm_get_property_as_charptr(
+                                       dm_flowtrace, kRPVDMEndpointSymbolCharPtrIndexed,
+                                       index, &symbol) &&
+                               kRocProfVisDmResultSuccess ==
+                                   rocprofvis_dm_get_property_as_uint64(
+                                       dm_flowtrace, kRPVDMEndpointLevelUInt64Indexed,
+                                       index, &level))
+                            {
+                                FlowControl* flow_control = new FlowControl(
+                                    id, start_timestamp, end_timestamp,
+                                    static_cast<uint32_t>(track_id),
+                                    static_cast<uint32_t>(level),
+                                    static_cast<uint32_t>(index % 2), category, symbol);
+                                result = array.SetOwnedObject(
+                                    kRPVControllerArrayEntryIndexed, index,
+                                    (rocprofvis_handle_t*) flow_control);
+                                if(result != kRocProfVisResultSuccess)
+                                {
+                                    delete flow_control;
+                                }
+                            }
+                            else
+                            {
+                                result = kRocProfVisResultUnknownError;
+                            }
+                        }
+                    }
+                }
+                if(dm_flowtrace != nullptr)
+                {
+                    rocprofvis_dm_unpin_event_property(dm_trace_handle,
+                                                       kRPVDMEventFlowTrace, dm_flowtrace);
+                    rocprofvis_dm_delete_event_property(dm_trace_handle,
+                                                        kRPVDMEventFlowTrace, dm_flowtrace);
+                }
+                rocprofvis_db_future_free(object);
+            }
+        }
+    }
+    return result;
+}
+
+rocprofvis_result_t
+Event::PrefetchDataModelProperties(std::vector<uint64_t> const& event_ids,
+                                   rocprofvis_dm_trace_t dm_trace_handle, Future* future)
+{
+    rocprofvis_result_t result = kRocProfVisResultUnknownError;
+    if(dm_trace_handle && future)
+    {
+        rocprofvis_dm_database_t db =
+            rocprofvis_dm_get_property_as_handle(dm_trace_handle, kRPVDMDatabaseHandle, 0);
+        if(db != nullptr)
+        {
+            rocprofvis_db_future_t object = rocprofvis_db_future_alloc(nullptr);
+            if(object != nullptr)
+            {
+                // Controller event ids are the data model ids
+                rocprofvis_dm_result_t dm_result = rocprofvis_db_read_event_properties_async(
+                    db, event_ids.size(), (const rocprofvis_dm_event_id_t*) event_ids.data(),
+                    object);
+                if(kRocProfVisDmResultSuccess == dm_result)
+                {
+                    future->AddDependentFuture(object);
+                    dm_result = rocprofvis_db_future_wait(object, UINT64_MAX);
+                    future->RemoveDependentFuture(object);
+                }
+                if(dm_result == kRocProfVisDmResultDbAbort || future->IsCancelled())
+                {
+                    result = kRocProfVisResultCancelled;
+                }
+                else if(dm_result == kRocProfVisDmResultSuccess)
+                {
+                    result = kRocProfVisResultSuccess;
+                }
+                rocprofvis_db_future_free(object);
+            }
+        }
+    }
+    return result;
+}
+
 rocprofvis_result_t
 Event::FetchDataModelStackTraceProperty(uint64_t event_id, Array& array,
                                           rocprofvis_dm_trace_t dm_trace_handle)
@@ -218,8 +388,8 @@ Event::FetchDataModelStackTraceProperty(uint64_t event_id, Array& array,
                     if(kRocProfVisDmResultSuccess == rocprofvis_db_future_wait(object, UINT64_MAX))
                     {
                         if(kRocProfVisDmResultSuccess ==
-                               rocprofvis_dm_get_property_as_handle(
-                                   dm_trace_handle, kRPVDMStackTraceHandleByEventID, event_id,
+                               rocprofvis_dm_pin_event_property(
+                                   dm_trace_handle, kRPVDMEventStackTrace, dm_event_id,
                                    &dm_stacktrace) &&
                            dm_stacktrace != nullptr)
                         {
@@ -316,7 +486,13 @@ Event::FetchDataModelStackTraceProperty(uint64_t event_id, Array& array,
                         result = kRocProfVisResultTimeout;
                     }
                 }
-                rocprofvis_dm_delete_event_property(dm_trace_handle, kRPVDMEventStackTrace, dm_stacktrace);
+                // stack trace stays in data model event property cache for repeated requests,
+                // pin only keeps it from being evicted while read
+                if(dm_stacktrace != nullptr)
+                {
+                    rocprofvis_dm_unpin_event_property(dm_trace_handle, kRPVDMEventStackTrace,
+                                                       dm_stacktrace);
+                }
             }
             rocprofvis_db_future_free(object);
         }
@@ -346,8 +522,8 @@ Event::FetchDataModelExtendedDataProperty(uint64_t event_id, Array& array, rocpr
                     if(kRocProfVisDmResultSuccess == rocprofvis_db_future_wait(object, UINT64_MAX))
                     {
                         if(kRocProfVisDmResultSuccess ==
-                               rocprofvis_dm_get_property_as_handle(
-                                   dm_trace_handle, kRPVDMExtInfoHandleByEventID, event_id,
+                               rocprofvis_dm_pin_event_property(
+                                   dm_trace_handle, kRPVDMEventExtData, dm_event_id,
                                    &dm_extdata) &&
                           dm_extdata != nullptr)
                         {
@@ -470,8 +646,13 @@ Event::FetchDataModelExtendedDataProperty(uint64_t event_id, Array& array, rocpr
                         result = kRocProfVisResultTimeout;
                     }
                 }
-                rocprofvis_dm_delete_event_property(dm_trace_handle,
-                                                        kRPVDMEventExtData, dm_extdata);
+                // extended data stays in data model event property cache for repeated requests,
+                // pin only keeps it from being evicted while read
+                if(dm_extdata != nullptr)
+                {
+                    rocprofvis_dm_unpin_event_property(dm_trace_handle, kRPVDMEventExtData,
+                                                       dm_extdata);
+                }
             }
             rocprofvis_db_future_free(object);
         }
@@ -21,6 +21,7 @@ namespace Controller
 {
 
 class Array;
+class Future;
 class Track;
 class Callstack;
 class FlowControl;
@@ -62,8 +63,10 @@ private:
 
 public:
     static rocprofvis_result_t FetchDataModelFlowTraceProperty(uint64_t event_id, Array& array, rocprofvis_dm_trace_t dm_trace_handle);
+    static rocprofvis_result_t FetchDataModelFlowRange(uint64_t start, uint64_t end, std::vector<uint32_t>& tracks, Array& array, rocprofvis_dm_trace_t dm_trace_handle, Future* future);
     static rocprofvis_result_t FetchDataModelStackTraceProperty(uint64_t event_id, Array& array, rocprofvis_dm_trace_t dm_trace_handle);
     static rocprofvis_result_t FetchDataModelExtendedDataProperty(uint64_t event_id, Array& array, rocprofvis_dm_trace_t dm_trace_handle);
+    static rocprofvis_result_t PrefetchDataModelProperties(std::vector<uint64_t> const& event_ids, rocprofvis_dm_trace_t dm_trace_handle, Future* future);
 
 private:
     static std::string FromJson(const char* key, jt::Json& json);
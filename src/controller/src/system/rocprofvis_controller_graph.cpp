@@ -659,16 +659,7 @@ Graph::Fetch(uint32_t pixels, double start, double end, Array& array, uint64_t&
     array.GetVector().clear();
     if(m_track)
     {
-        uint32_t lod      = 0;
-        double   duration = (end - start);
-        while(duration > (pixels * kGraphScaleFactor))
-        {
-            duration /= kGraphScaleFactor;
-            lod++;
-        }
-
-        // calculate data for LOD 1 even LOD 0 is requested
-        lod = std::max(lod, (uint32_t)1);
+        uint32_t lod = GetLOD(pixels, start, end);
 
         result = GenerateLOD(lod, start, end, future);
 
@@ -701,6 +692,32 @@ Graph::Fetch(uint32_t pixels, double start, double end, Array& array, uint64_t&
 }
 
 
+rocprofvis_result_t
+Graph::Prefetch(uint32_t pixels, double start, double end, Future* future)
+{
+    rocprofvis_result_t result = kRocProfVisResultUnknownError;
+    if(m_track)
+    {
+        result = GenerateLOD(GetLOD(pixels, start, end), start, end, future);
+    }
+    return result;
+}
+
+uint32_t
+Graph::GetLOD(uint32_t pixels, double start, double end)
+{
+    uint32_t lod      = 0;
+    double   duration = (end - start);
+    while(duration > (pixels * kGraphScaleFactor))
+    {
+        duration /= kGraphScaleFactor;
+        lod++;
+    }
+
+    // calculate data for LOD 1 even LOD 0 is requested
+    return std::max(lod, (uint32_t)1);
+}
+
 rocprofvis_controller_object_type_t
 Graph::GetType(void)
 {
@@ -22,6 +22,7 @@ class Graph : public Handle
     rocprofvis_result_t GenerateLOD(uint32_t lod_to_generate, double start_ts, double end_ts, std::vector<Data>& entries, Future* future);
     rocprofvis_result_t GenerateLOD(uint32_t lod_to_generate, double start, double end, Future* future);
     void Insert(uint32_t lod, double timestamp, uint8_t level, Handle* object);
+    static uint32_t GetLOD(uint32_t pixels, double start, double end);
 
 public:
     Graph(Handle* ctx, rocprofvis_controller_graph_type_t type, uint64_t id);
@@ -31,6 +32,8 @@ public:
     virtual ~Graph();
 
     rocprofvis_result_t Fetch(uint32_t pixels, double start, double end, Array& array, uint64_t& index, Future* future);
+    // Generates the level of detail a Fetch with the same arguments reads, without fetching it
+    rocprofvis_result_t Prefetch(uint32_t pixels, double start, double end, Future* future);
 
     rocprofvis_controller_object_type_t GetType(void) final;
     rocprofvis_result_t                 CombineEventInfo(std::vector<Event*>& events,
@@ -34,9 +34,16 @@ MemoryManager::MemoryManager(uint64_t id)
 , m_lru_mgmt_shutdown(false)
 , m_mem_mgmt_initialized(false)
 , m_mem_block_size(1024)
+, m_lru_size_limit(0)
 , m_id(id)
 , m_trace_weight(1.0)
 { 
+    for(int type = 0; type < kRocProfVisNumberOfObjectTypes; type++)
+    {
+        m_pool_bytes[type]   = 0;
+        m_pool_objects[type] = 0;
+        m_pool_count[type]   = 0;
+    }
     //for(int type = 0; type < kRocProfVisNumberOfObjectTypes; type++)
     //{
     //    m_current_pool[type] = m_object_pools.end();
@@ -181,6 +188,22 @@ MemoryManager::UpdateSizeLimit()
     }
 }
 
+size_t
+MemoryManager::GetMemoryLimit()
+{
+    std::unique_lock<std::mutex> lock(m_lru_cond_mutex);
+    return m_lru_size_limit;
+}
+
+void
+MemoryManager::GetPoolUsage(rocprofvis_object_type_t type, uint64_t& bytes, uint64_t& objects,
+                            uint64_t& pools) const
+{
+    bytes   = m_pool_bytes[type];
+    objects = m_pool_objects[type];
+    pools   = m_pool_count[type];
+}
+
 void
 MemoryManager::Configure(double weight)
 {
@@ -485,6 +508,8 @@ MemoryManager::Allocate(size_t size, rocprofvis_object_type_t type, SegmentTimel
         {
             m_current_pool[type][pool_idetifier] = current_pool;
             m_lru_storage_memory_used += size * current_pool->m_bitmask.Size();
+            m_pool_bytes[type] += size * current_pool->m_bitmask.Size();
+            m_pool_count[type]++;
             first_zero_bit = current_pool->m_pos++;
         }
         else
@@ -496,6 +521,7 @@ MemoryManager::Allocate(size_t size, rocprofvis_object_type_t type, SegmentTimel
     {
         char* ptr = (char*) current_pool->m_base + (first_zero_bit * size);
         current_pool->m_bitmask.Set(first_zero_bit);
+        m_pool_objects[type]++;
         return ptr;
     }
     throw std::runtime_error("Allocation problem!");
@@ -548,6 +574,12 @@ void MemoryManager::CleanUp() {
             delete pool;
         }
     }
+    for(int type = 0; type < kRocProfVisNumberOfObjectTypes; type++)
+    {
+        m_pool_bytes[type]   = 0;
+        m_pool_objects[type] = 0;
+        m_pool_count[type]   = 0;
+    }
 }
 
 Event*
@@ -653,11 +685,14 @@ MemoryManager::Delete(Handle* handle, SegmentTimeline* owner)
     handle->~Handle();
     uint64_t index = (static_cast<char*>(ptr) - base) / pool->m_size;
     pool->m_bitmask.Clear(index);
+    m_pool_objects[pool->m_type]--;
 
     if(pool->m_bitmask.None())
     {
 
         m_lru_storage_memory_used -= total_size;
+        m_pool_bytes[pool->m_type] -= total_size;
+        m_pool_count[pool->m_type]--;
 
         pool_map.erase(it);                         
         m_current_pool[pool->m_type].erase(pool_idetifier);  
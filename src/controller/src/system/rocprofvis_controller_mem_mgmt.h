@@ -144,6 +144,15 @@ namespace RocProfVis
             Event*              NewEvent(uint64_t id, double start_ts, double end_ts, SegmentTimeline* owner);
             Sample*             NewSample(rocprofvis_controller_primitive_type_t type, uint64_t id, double timestamp, SegmentTimeline* owner);
             SampleLOD*          NewSampleLOD(rocprofvis_controller_primitive_type_t type, uint64_t id, double timestamp, std::vector<Sample*>& children, SegmentTimeline* owner);
+
+            // Pool storage reserved for an object type, live objects placed in it and number of pools
+            void                GetPoolUsage(rocprofvis_object_type_t type, uint64_t& bytes, uint64_t& objects, uint64_t& pools) const;
+            // Pool storage of all object types, the LRU evicts segments when this exceeds the limit
+            size_t              GetMemoryUsed() const { return m_lru_storage_memory_used; }
+            // Share of the kUseVailMemoryPercent budget given to this trace
+            size_t              GetMemoryLimit();
+            // kUseVailMemoryPercent of the physical memory available when the first trace loaded
+            static size_t       GetMemoryBudget() { return s_physical_memory_avail; }
             
             
 
@@ -170,6 +179,9 @@ namespace RocProfVis
             std::map<uint64_t, MemoryPool*>                             m_current_pool[kRocProfVisNumberOfObjectTypes];
             std::set<SegmentTimeline*>                                  m_short_tracks;
             std::mutex                                                  m_pool_mutex;
+            std::atomic<uint64_t>                                       m_pool_bytes[kRocProfVisNumberOfObjectTypes];
+            std::atomic<uint64_t>                                       m_pool_objects[kRocProfVisNumberOfObjectTypes];
+            std::atomic<uint64_t>                                       m_pool_count[kRocProfVisNumberOfObjectTypes];
 
             void            ManageLRU();
             void*           Allocate(size_t size, rocprofvis_object_type_t type, SegmentTimeline *owner);
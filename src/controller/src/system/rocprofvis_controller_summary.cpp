@@ -42,7 +42,9 @@ rocprofvis_result_t Summary::Fetch(rocprofvis_dm_trace_t dm_handle, Arguments& a
         result = args.GetDouble(kRPVControllerSummaryArgsEndTimestamp, 0, &m_end_ts);
         if(result == kRocProfVisResultSuccess)
         {
-            result = FetchMetrics(dm_handle, future);
+            uint64_t kernels_only = 0;
+            args.GetUInt64(kRPVControllerSummaryArgsKernelsOnly, 0, &kernels_only);
+            result = FetchMetrics(dm_handle, kernels_only != 0, future);
             if(result == kRocProfVisResultSuccess && !future->IsCancelled())
             {
                 output = m_metrics;
@@ -105,7 +107,7 @@ rocprofvis_result_t Summary::GetObject(rocprofvis_property_t property, uint64_t
     return result;
 }
 
-rocprofvis_result_t Summary::FetchMetrics(rocprofvis_dm_trace_t dm_handle, Future* future)
+rocprofvis_result_t Summary::FetchMetrics(rocprofvis_dm_trace_t dm_handle, bool kernels_only, Future* future)
 {
     rocprofvis_result_t result = kRocProfVisResultUnknownError;
     m_metrics.Reset();
@@ -217,12 +219,12 @@ rocprofvis_result_t Summary::FetchMetrics(rocprofvis_dm_trace_t dm_handle, Futur
                                                                                 case kRPVControllerProcessorTypeGPU:
                                                                                 {
                                                                                     if(counter_name.find("device_busy_gfx") != std::string::npos && 
-                                                                                       kRocProfVisResultSuccess == FetchCounterAverage(dm_handle, counter, data, future))
+                                                                                       kRocProfVisResultSuccess == GetCounterAverage(dm_handle, counter, kernels_only, data, future))
                                                                                     {
                                                                                         processor_metrics.SetDouble(kRPVControllerSummaryMetricPropertyGpuGfxUtil, 0, (double)data);
                                                                                     }
                                                                                     else if(counter_name.find("device_memory_usage") != std::string::npos && 
-                                                                                            kRocProfVisResultSuccess == FetchCounterAverage(dm_handle, counter, data, future))
+                                                                                            kRocProfVisResultSuccess == GetCounterAverage(dm_handle, counter, kernels_only, data, future))
                                                                                     {
                                                                                         processor_metrics.SetDouble(kRPVControllerSummaryMetricPropertyGpuMemUtil, 0, (double)data);
                                                                                     }
@@ -313,6 +315,10 @@ rocprofvis_result_t Summary::FetchMetrics(rocprofvis_dm_trace_t dm_handle, Futur
                             {
                                 FetchTopKernels(dm_handle, node, nullptr, node_metrics, future);
                             }
+                            else
+                            {
+                                FetchAggregatedTopKernels(dm_handle, node, node_metrics, future);
+                            }
                             if(!node_metrics.Empty())
                             {
                                 result = m_metrics.GetUInt64(kRPVControllerSummaryMetricPropertyNumSubMetrics, 0, &uint64_data);
@@ -351,6 +357,7 @@ rocprofvis_result_t Summary::FetchMetrics(rocprofvis_dm_trace_t dm_handle, Futur
             }
             else
             {
+                FetchAggregatedTopKernels(dm_handle, nullptr, m_metrics, future);
                 m_metrics.AggregateSubMetrics();
             }            
         }
@@ -358,6 +365,26 @@ rocprofvis_result_t Summary::FetchMetrics(rocprofvis_dm_trace_t dm_handle, Futur
     return result;
 }
 
+rocprofvis_result_t Summary::GetCounterAverage(rocprofvis_dm_trace_t dm_handle, Counter* counter, bool kernels_only, float& average, Future* future)
+{
+    rocprofvis_result_t result = kRocProfVisResultUnknownError;
+    auto it = m_counter_averages.find(counter);
+    if(kernels_only && it != m_counter_averages.end())
+    {
+        average = it->second;
+        result = kRocProfVisResultSuccess;
+    }
+    else
+    {
+        result = FetchCounterAverage(dm_handle, counter, average, future);
+        if(result == kRocProfVisResultSuccess)
+        {
+            m_counter_averages[counter] = average;
+        }
+    }
+    return result;
+}
+
 rocprofvis_result_t Summary::FetchCounterAverage(rocprofvis_dm_trace_t dm_handle, Counter* counter, float& average, Future* future) const
 {
     rocprofvis_result_t result = kRocProfVisResultInvalidArgument;
@@ -501,183 +528,242 @@ rocprofvis_result_t Summary::FetchCounterAverage(rocprofvis_dm_trace_t dm_handle
 rocprofvis_result_t Summary::FetchTopKernels(rocprofvis_dm_trace_t dm_handle, Node* node, Processor* processor, SummaryMetrics& output, Future* future) const
 {
     rocprofvis_result_t result = kRocProfVisResultUnknownError;
-    rocprofvis_db_future_t object2wait = rocprofvis_db_future_alloc(nullptr);
-    if(object2wait)
+    rocprofvis_dm_database_t db = rocprofvis_dm_get_property_as_handle(dm_handle, kRPVDMDatabaseHandle, 0);
+    if(db)
     {
-        rocprofvis_dm_database_t db  = rocprofvis_dm_get_property_as_handle(dm_handle, kRPVDMDatabaseHandle, 0);
-        if(db)
+        uint64_t node_id = KERNEL_SUMMARY_ANY_ID;
+        uint64_t agent_id = KERNEL_SUMMARY_ANY_ID;
+        std::string where_str;
+        result = kRocProfVisResultSuccess;
+        if(node)
         {
-            rocprofvis_dm_result_t dm_result = kRocProfVisDmResultUnknownError;
-            uint32_t op[1] = { TABLE_QUERY_PACK_OP_TYPE(kRocProfVisDmOperationDispatch) };
-            std::string where_str;
-            if(node)
+            result = node->GetUInt64(kRPVControllerNodeId, 0, &node_id);
+            if(result == kRocProfVisResultSuccess)
             {
-                uint64_t node_id = 0;
-                result = node->GetUInt64(kRPVControllerNodeId, 0, &node_id);
-                if(result == kRocProfVisResultSuccess)
+                where_str = "nodeId = " + std::to_string(node_id);
+                if(processor)
                 {
-                    where_str = "nodeId = " + std::to_string(node_id);
-                    if(processor)
+                    result = processor->GetUInt64(kRPVControllerProcessorId, 0, &agent_id);
+                    if(result == kRocProfVisResultSuccess)
                     {
-                        uint64_t agent_id = 0;
-                        result = processor->GetUInt64(kRPVControllerProcessorId, 0, &agent_id);
-                        if(result == kRocProfVisResultSuccess)
-                        {
-                            where_str += " AND agentId = " + std::to_string(agent_id & TOPOLOGY_ID_MASK);
-                        }
+                        agent_id &= TOPOLOGY_ID_MASK;
+                        where_str += " AND agentId = " + std::to_string(agent_id);
                     }
                 }
             }
-            rocprofvis_dm_table_id_t table_id = 0;
-            std::string sort_column = "total_duration";
-            char* query = nullptr;
-            dm_result = rocprofvis_db_build_table_query(db, kRPVDMTableUseCaseEventTrackTable, 
-                                                        static_cast<rocprofvis_dm_timestamp_t>(m_start_ts), static_cast<rocprofvis_dm_timestamp_t>(m_end_ts), 
-                                                        1, (rocprofvis_db_track_selection_t)op, 
-                                                        where_str.empty() ? nullptr : where_str.c_str(), nullptr, 
-                                                        "name, COUNT(*) AS num_invocations, AVG(duration) AS avg_duration, MIN(duration) AS min_duration, MAX(duration) AS max_duration, SUM(duration) AS total_duration", "name", 
-                                                        sort_column.c_str(), kRPVDMSortOrderDesc,
-                                                        0, 0, false, &query);
+        }
+        if(result == kRocProfVisResultSuccess)
+        {
+            // Kernel statistics buckets answer any range without scanning all dispatches, 
+            // the table query is used when the database has no kernel statistics
+            result = FetchTopKernelsFromSummary(dm_handle, db, node_id, agent_id, output, future);
+            if(result == kRocProfVisResultNotSupported)
+            {
+                result = FetchTopKernelsFromTable(dm_handle, db, where_str, output, future);
+            }
+        }
+    }
+    return result;
+}
+
+rocprofvis_result_t Summary::FetchAggregatedTopKernels(rocprofvis_dm_trace_t dm_handle, Node* node, SummaryMetrics& output, Future* future) const
+{
+    // Only kernel statistics are read here, without them the top kernels of the sub metrics are merged by AggregateSubMetrics
+    rocprofvis_result_t result = kRocProfVisResultNotSupported;
+    rocprofvis_dm_database_t db = rocprofvis_dm_get_property_as_handle(dm_handle, kRPVDMDatabaseHandle, 0);
+    if(db)
+    {
+        uint64_t node_id = KERNEL_SUMMARY_ANY_ID;
+        result = node ? node->GetUInt64(kRPVControllerNodeId, 0, &node_id) : kRocProfVisResultSuccess;
+        if(result == kRocProfVisResultSuccess)
+        {
+            result = FetchTopKernelsFromSummary(dm_handle, db, node_id, KERNEL_SUMMARY_ANY_ID, output, future);
+        }
+    }
+    return result;
+}
+
+rocprofvis_result_t Summary::FetchTopKernelsFromSummary(rocprofvis_dm_trace_t dm_handle, rocprofvis_dm_database_t db, uint64_t node_id, uint64_t agent_id, SummaryMetrics& output, Future* future) const
+{
+    rocprofvis_result_t result = kRocProfVisResultUnknownError;
+    rocprofvis_db_future_t object2wait = rocprofvis_db_future_alloc(nullptr);
+    if(object2wait)
+    {
+        rocprofvis_dm_table_id_t table_id = 0;
+        rocprofvis_dm_result_t dm_result = rocprofvis_db_read_kernel_summary_async(db, 
+                                                    static_cast<rocprofvis_dm_timestamp_t>(m_start_ts), static_cast<rocprofvis_dm_timestamp_t>(m_end_ts), 
+                                                    node_id, agent_id, object2wait, &table_id);
+        if(dm_result == kRocProfVisDmResultSuccess)
+        {
+            future->AddDependentFuture(object2wait);
+            dm_result = rocprofvis_db_future_wait(object2wait, UINT64_MAX);
+            if(dm_result == kRocProfVisDmResultSuccess)
+            {
+                result = ReadTopKernels(dm_handle, table_id, nullptr, output, future);
+            }
+            else if(dm_result == kRocProfVisDmResultNotSupported)
+            {
+                result = kRocProfVisResultNotSupported;
+            }
+            future->RemoveDependentFuture(object2wait);
+        }
+        else if(dm_result == kRocProfVisDmResultNotSupported)
+        {
+            result = kRocProfVisResultNotSupported;
+        }
+        rocprofvis_db_future_free(object2wait);
+    }
+    return result;
+}
+
+rocprofvis_result_t Summary::FetchTopKernelsFromTable(rocprofvis_dm_trace_t dm_handle, rocprofvis_dm_database_t db, const std::string& where_str, SummaryMetrics& output, Future* future) const
+{
+    rocprofvis_result_t result = kRocProfVisResultUnknownError;
+    rocprofvis_db_future_t object2wait = rocprofvis_db_future_alloc(nullptr);
+    if(object2wait)
+    {
+        rocprofvis_dm_result_t dm_result = kRocProfVisDmResultUnknownError;
+        uint32_t op[1] = { TABLE_QUERY_PACK_OP_TYPE(kRocProfVisDmOperationDispatch) };
+        rocprofvis_dm_table_id_t table_id = 0;
+        std::string sort_column = "total_duration";
+        char* query = nullptr;
+        dm_result = rocprofvis_db_build_table_query(db, kRPVDMTableUseCaseEventTrackTable, 
+                                                    static_cast<rocprofvis_dm_timestamp_t>(m_start_ts), static_cast<rocprofvis_dm_timestamp_t>(m_end_ts), 
+                                                    1, (rocprofvis_db_track_selection_t)op, 
+                                                    where_str.empty() ? nullptr : where_str.c_str(), nullptr, 
+                                                    "name, COUNT(*) AS num_invocations, AVG(duration) AS avg_duration, MIN(duration) AS min_duration, MAX(duration) AS max_duration, SUM(duration) AS total_duration", "name", 
+                                                    sort_column.c_str(), kRPVDMSortOrderDesc,
+                                                    0, 0, false, &query);
+        if(dm_result == kRocProfVisDmResultSuccess)
+        {
+            dm_result = rocprofvis_db_execute_query_async(db, query, "Fetch kernel summary", object2wait, &table_id);
             if(dm_result == kRocProfVisDmResultSuccess)
             {
-                dm_result = rocprofvis_db_execute_query_async(db, query, "Fetch kernel summary", object2wait, &table_id);
+                future->AddDependentFuture(object2wait);
+                dm_result = rocprofvis_db_future_wait(object2wait, UINT64_MAX);
                 if(dm_result == kRocProfVisDmResultSuccess)
                 {
-                    future->AddDependentFuture(object2wait);
-                    dm_result = rocprofvis_db_future_wait(object2wait, UINT64_MAX);
-                    if(dm_result == kRocProfVisDmResultSuccess)
-                    {
-                        uint64_t num_tables = rocprofvis_dm_get_property_as_uint64(dm_handle, kRPVDMNumberOfTablesUInt64, 0);
-                        if(num_tables > 0)
+                    result = ReadTopKernels(dm_handle, table_id, query, output, future);
+                }
+                future->RemoveDependentFuture(object2wait);
+            }
+        }
+        free(query);
+        rocprofvis_db_future_free(object2wait);
+    }
+    return result;
+}
+
+rocprofvis_result_t Summary::ReadTopKernels(rocprofvis_dm_trace_t dm_handle, rocprofvis_dm_table_id_t table_id, const char* query, SummaryMetrics& output, Future* future) const
+{
+    rocprofvis_result_t result = kRocProfVisResultUnknownError;
+    uint64_t num_tables = rocprofvis_dm_get_property_as_uint64(dm_handle, kRPVDMNumberOfTablesUInt64, 0);
+    if(num_tables > 0)
+    {
+        rocprofvis_dm_table_t table = rocprofvis_dm_get_property_as_handle(dm_handle, kRPVDMTableHandleByID, table_id);
+        if(table)
+        {
+            if(!future->IsCancelled())
+            {                    
+                const char* table_query = rocprofvis_dm_get_property_as_charptr(table, kRPVDMExtTableQueryCharPtr, 0);
+                uint64_t num_rows = rocprofvis_dm_get_property_as_uint64(table, kRPVDMNumberOfTableRowsUInt64, 0);
+                uint64_t num_columns = rocprofvis_dm_get_property_as_uint64(table, kRPVDMNumberOfTableColumnsUInt64, 0);
+                if(query == nullptr || strcmp(table_query, query) == 0)
+                {
+                    result = kRocProfVisResultSuccess;
+                    if(num_rows > 0)
+                    { 
+                        double exec_time_total = 0.0;
+                        uint64_t top_kernels_count = std::min(uint64_t(10), num_rows);
+                        output.SetUInt64(kRPVControllerSummaryMetricPropertyNumKernels, 0, top_kernels_count);                                        
+                        for(uint64_t i = 0; i < num_rows; i++)
                         {
-                            rocprofvis_dm_table_t table = rocprofvis_dm_get_property_as_handle(dm_handle, kRPVDMTableHandleByID, table_id);
-                            if(table)
+                            rocprofvis_dm_table_row_t table_row = rocprofvis_dm_get_property_as_handle(table, kRPVDMExtTableRowHandleIndexed, i);
+                            if(table_row != nullptr)
                             {
-                                if(!future->IsCancelled())
-                                {                    
-                                    const char* table_query = rocprofvis_dm_get_property_as_charptr(table, kRPVDMExtTableQueryCharPtr, 0);
-                                    uint64_t num_rows = rocprofvis_dm_get_property_as_uint64(table, kRPVDMNumberOfTableRowsUInt64, 0);
-                                    uint64_t num_columns = rocprofvis_dm_get_property_as_uint64(table, kRPVDMNumberOfTableColumnsUInt64, 0);
-                                    if(strcmp(table_query, query) == 0)
+                                uint64_t num_cells = rocprofvis_dm_get_property_as_uint64(table_row, kRPVDMNumberOfTableRowCellsUInt64, 0);                                        
+                                if(num_cells == num_columns)
+                                {
+                                    for(uint64_t j = 0; j < num_cells; j++)
                                     {
-                                        result = kRocProfVisResultSuccess;
-                                        if(num_rows > 0)
-                                        { 
-                                            double exec_time_total = 0.0;
-                                            uint64_t top_kernels_count = std::min(uint64_t(10), num_rows);
-                                            output.SetUInt64(kRPVControllerSummaryMetricPropertyNumKernels, 0, top_kernels_count);                                        
-                                            for(int i = 0; i < num_rows; i++)
+                                        char const* col_name = rocprofvis_dm_get_property_as_charptr(table, kRPVDMExtTableColumnNameCharPtrIndexed, j);
+                                        char const* value = rocprofvis_dm_get_property_as_charptr(table_row, kRPVDMExtTableRowCellValueCharPtrIndexed, j);
+                                        if(i < top_kernels_count)
+                                        {
+                                            if(strcmp(col_name, "name") == 0)
                                             {
-                                                rocprofvis_dm_table_row_t table_row = rocprofvis_dm_get_property_as_handle(table, kRPVDMExtTableRowHandleIndexed, i);
-                                                if(table_row != nullptr)
-                                                {
-                                                    uint64_t num_cells = rocprofvis_dm_get_property_as_uint64(table_row, kRPVDMNumberOfTableRowCellsUInt64, 0);                                        
-                                                    if(num_cells == num_columns)
-                                                    {
-                                                        for(int j = 0; j < num_cells; j++)
-                                                        {
-                                                            char const* col_name = rocprofvis_dm_get_property_as_charptr(table, kRPVDMExtTableColumnNameCharPtrIndexed, j);
-                                                            char const* value = rocprofvis_dm_get_property_as_charptr(table_row, kRPVDMExtTableRowCellValueCharPtrIndexed, j);
-                                                            if(i < top_kernels_count)
-                                                            {
-                                                                if(strcmp(col_name, "name") == 0)
-                                                                {
-                                                                    output.SetString(kRPVControllerSummaryMetricPropertyKernelNameIndexed, i, value);                                                            
-                                                                }
-                                                                else if(strcmp(col_name, "num_invocations") == 0)
-                                                                {
-                                                                    output.SetUInt64(kRPVControllerSummaryMetricPropertyKernelInvocationsIndexed, i, strtoull(value, NULL, 10));
-                                                                }
-                                                                else if(strcmp(col_name, "total_duration") == 0)
-                                                                {
-                                                                    double duration = strtod(value, NULL);
-                                                                    output.SetDouble(kRPVControllerSummaryMetricPropertyKernelExecTimeSumIndexed, i, duration);
-                                                                    exec_time_total += duration;                                                                
-                                                                }
-                                                                else if(strcmp(col_name, "min_duration") == 0)
-                                                                {
-                                                                    output.SetDouble(kRPVControllerSummaryMetricPropertyKernelExecTimeMinIndexed, i, strtod(value, NULL));
-                                                                }
-                                                                else if(strcmp(col_name, "max_duration") == 0)
-                                                                {
-                                                                    output.SetDouble(kRPVControllerSummaryMetricPropertyKernelExecTimeMaxIndexed, i, strtod(value, NULL));
-                                                                }
-                                                            }
-                                                            else if(strcmp(col_name, "total_duration") == 0)
-                                                            {
-                                                                exec_time_total += strtod(value, NULL);
-                                                            }
-                                                        }
-                                                    }
-                                                    else
-                                                    {
-                                                        result = kRocProfVisResultUnknownError;
-                                                    }                                        
-                                                }
-                                                else
-                                                {
-                                                    result = kRocProfVisResultUnknownError;
-                                                }
+                                                output.SetString(kRPVControllerSummaryMetricPropertyKernelNameIndexed, i, value);                                                            
                                             }
-                                            if(result == kRocProfVisResultSuccess)
+                                            else if(strcmp(col_name, "num_invocations") == 0)
                                             {
-                                                for(int i = 0; i < top_kernels_count; i ++)
-                                                {
-                                                    double exec_time_sum = 0.0;
-                                                    result = output.GetDouble(kRPVControllerSummaryMetricPropertyKernelExecTimeSumIndexed, i, &exec_time_sum);
-                                                    if(result == kRocProfVisResultSuccess)
-                                                    {
-                                                        output.SetDouble(kRPVControllerSummaryMetricPropertyKernelExecTimePctIndexed, i, exec_time_sum / exec_time_total);
-                                                    }
-                                                    else
-                                                    {
-                                                        break;
-                                                    }
-                                                }
-                                                output.SetDouble(kRPVControllerSummaryMetricPropertyKernelsExecTimeTotal, 0, exec_time_total);
-                                                output.PadTopKernels();
+                                                output.SetUInt64(kRPVControllerSummaryMetricPropertyKernelInvocationsIndexed, i, strtoull(value, NULL, 10));
+                                            }
+                                            else if(strcmp(col_name, "total_duration") == 0)
+                                            {
+                                                double duration = strtod(value, NULL);
+                                                output.SetDouble(kRPVControllerSummaryMetricPropertyKernelExecTimeSumIndexed, i, duration);
+                                                exec_time_total += duration;                                                                
+                                            }
+                                            else if(strcmp(col_name, "min_duration") == 0)
+                                            {
+                                                output.SetDouble(kRPVControllerSummaryMetricPropertyKernelExecTimeMinIndexed, i, strtod(value, NULL));
+                                            }
+                                            else if(strcmp(col_name, "max_duration") == 0)
+                                            {
+                                                output.SetDouble(kRPVControllerSummaryMetricPropertyKernelExecTimeMaxIndexed, i, strtod(value, NULL));
                                             }
                                         }
-                                    }
-                                    else
-                                    {
-                                        result = kRocProfVisResultUnknownError;
+                                        else if(strcmp(col_name, "total_duration") == 0)
+                                        {
+                                            exec_time_total += strtod(value, NULL);
+                                        }
                                     }
                                 }
-                                rocprofvis_dm_delete_table_at(dm_handle, table_id);
+                                else
+                                {
+                                    result = kRocProfVisResultUnknownError;
+                                }                                        
                             }
                             else
                             {
                                 result = kRocProfVisResultUnknownError;
                             }
                         }
-                        else
+                        if(result == kRocProfVisResultSuccess)
                         {
-                            result = kRocProfVisResultUnknownError;
+                            for(uint64_t i = 0; i < top_kernels_count; i ++)
+                            {
+                                double exec_time_sum = 0.0;
+                                result = output.GetDouble(kRPVControllerSummaryMetricPropertyKernelExecTimeSumIndexed, i, &exec_time_sum);
+                                if(result == kRocProfVisResultSuccess)
+                                {
+                                    output.SetDouble(kRPVControllerSummaryMetricPropertyKernelExecTimePctIndexed, i, exec_time_sum / exec_time_total);
+                                }
+                                else
+                                {
+                                    break;
+                                }
+                            }
+                            output.SetDouble(kRPVControllerSummaryMetricPropertyKernelsExecTimeTotal, 0, exec_time_total);
+                            output.PadTopKernels();
                         }
                     }
-                    else
-                    {
-                        result = kRocProfVisResultUnknownError;
-                    }                                    
                 }
                 else
                 {
                     result = kRocProfVisResultUnknownError;
                 }
             }
-            else
-            {
-                result = kRocProfVisResultUnknownError;
-            }
-            free(query);
+            rocprofvis_dm_delete_table_at(dm_handle, table_id);
         }
         else
         {
             result = kRocProfVisResultUnknownError;
         }
-        future->RemoveDependentFuture(object2wait);
-        rocprofvis_db_future_free(object2wait);
+    }
+    else
+    {
+        result = kRocProfVisResultUnknownError;
     }
     return result;
 }
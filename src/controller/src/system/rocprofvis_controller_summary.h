@@ -7,6 +7,7 @@
 #include "rocprofvis_controller.h"
 #include "rocprofvis_controller_handle.h"
 #include "rocprofvis_c_interface.h"
+#include <unordered_map>
 
 namespace RocProfVis
 {
@@ -36,9 +37,14 @@ public:
     rocprofvis_result_t GetObject(rocprofvis_property_t property, uint64_t index, rocprofvis_handle_t** value) final;
 
 private:
-    rocprofvis_result_t FetchMetrics(rocprofvis_dm_trace_t dm_handle, Future* future);
+    rocprofvis_result_t FetchMetrics(rocprofvis_dm_trace_t dm_handle, bool kernels_only, Future* future);
+    rocprofvis_result_t GetCounterAverage(rocprofvis_dm_trace_t dm_handle, Counter* counter, bool kernels_only, float& average, Future* future);
     rocprofvis_result_t FetchCounterAverage(rocprofvis_dm_trace_t dm_handle, Counter* counter, float& average, Future* future) const;
     rocprofvis_result_t FetchTopKernels(rocprofvis_dm_trace_t dm_handle, Node* node, Processor* processor, SummaryMetrics& output, Future* future) const;
+    rocprofvis_result_t FetchAggregatedTopKernels(rocprofvis_dm_trace_t dm_handle, Node* node, SummaryMetrics& output, Future* future) const;
+    rocprofvis_result_t FetchTopKernelsFromSummary(rocprofvis_dm_trace_t dm_handle, rocprofvis_dm_database_t db, uint64_t node_id, uint64_t agent_id, SummaryMetrics& output, Future* future) const;
+    rocprofvis_result_t FetchTopKernelsFromTable(rocprofvis_dm_trace_t dm_handle, rocprofvis_dm_database_t db, const std::string& where_str, SummaryMetrics& output, Future* future) const;
+    rocprofvis_result_t ReadTopKernels(rocprofvis_dm_trace_t dm_handle, rocprofvis_dm_table_id_t table_id, const char* query, SummaryMetrics& output, Future* future) const;
 
     Trace* m_ctx;
 
@@ -47,6 +53,8 @@ private:
 
     SummaryMetrics m_metrics;
     EventSearchTable* m_kernel_instance_table;
+    // counter averages of the last full fetch, reused by kernels only fetches
+    std::unordered_map<Counter*, float> m_counter_averages;
 };
 
 }
@@ -469,6 +469,9 @@ rocprofvis_result_t SummaryMetrics::AggregateSubMetrics()
     }
     else
     {
+        // Top kernels already set on this level were read from kernel statistics for the whole level,
+        // they are exact and only the utilization is taken from the sub metrics
+        const bool has_top_kernels = m_gpu.has_value();
         std::unordered_map<std::string_view, KernelMetrics> kernel_map;
         for(SummaryMetrics& sub : m_sub_metrics)
         {
@@ -481,14 +484,21 @@ rocprofvis_result_t SummaryMetrics::AggregateSubMetrics()
                     {
                         m_gpu.value().gfx_util = AddOptionals(m_gpu.value().gfx_util, sub.m_gpu.value().gfx_util);
                         m_gpu.value().mem_util = AddOptionals(m_gpu.value().mem_util, sub.m_gpu.value().mem_util);
-                        m_gpu.value().kernel_exec_time_total += sub.m_gpu.value().kernel_exec_time_total;
+                        if(!has_top_kernels)
+                        {
+                            m_gpu.value().kernel_exec_time_total += sub.m_gpu.value().kernel_exec_time_total;
+                        }
                     }
                 }
-                else
+                else if(sub.m_gpu)
                 {
                     m_gpu = sub.m_gpu;
                     m_gpu.value().top_kernels.clear();
                 }
+                if(has_top_kernels || !sub.m_gpu)
+                {
+                    continue;
+                }
                 for(const KernelMetrics& kernel : sub.m_gpu.value().top_kernels)
                 {
                     if(kernel.name != KERNEL_PADING_NAME)
@@ -518,19 +528,22 @@ rocprofvis_result_t SummaryMetrics::AggregateSubMetrics()
             {
                 m_gpu.value().mem_util.value() /= m_sub_metrics.size();
             }
-            for(const std::pair<std::string_view, KernelMetrics>& kernel : kernel_map)
-            {
-                m_gpu.value().top_kernels.emplace_back(kernel.second);
-            }
-            std::sort(m_gpu.value().top_kernels.begin(), m_gpu.value().top_kernels.end(), [](const KernelMetrics& a, const KernelMetrics& b){
-                return a.exec_time_sum > b.exec_time_sum;
-            });
-            m_gpu.value().top_kernels.resize(std::min(m_gpu.value().top_kernels.size(), (size_t)10));
-            for(KernelMetrics& kernel : m_gpu.value().top_kernels)
+            if(!has_top_kernels)
             {
-                kernel.exec_time_pct = static_cast<float>(kernel.exec_time_sum / m_gpu.value().kernel_exec_time_total);
+                for(const auto& kernel : kernel_map)
+                {
+                    m_gpu.value().top_kernels.emplace_back(kernel.second);
+                }
+                std::sort(m_gpu.value().top_kernels.begin(), m_gpu.value().top_kernels.end(), [](const KernelMetrics& a, const KernelMetrics& b){
+                    return a.exec_time_sum > b.exec_time_sum;
+                });
+                m_gpu.value().top_kernels.resize(std::min(m_gpu.value().top_kernels.size(), (size_t)10));
+                for(KernelMetrics& kernel : m_gpu.value().top_kernels)
+                {
+                    kernel.exec_time_pct = static_cast<float>(kernel.exec_time_sum / m_gpu.value().kernel_exec_time_total);
+                }
+                PadTopKernels();
             }
-            PadTopKernels();
         }
     }
     return result;
@@ -108,38 +108,10 @@ rocprofvis_result_t SystemTable::Fetch(rocprofvis_dm_trace_t dm_handle, uint64_t
                                     {
                                         ROCPROFVIS_ASSERT(m_columns.size() == num_columns);
 
-                                        std::vector<Data> row;
-                                        row.resize(m_columns.size());
-                                        for (uint32_t i = 0; i < num_rows; i++)
-                                        {
-                                            rocprofvis_dm_table_row_t table_row =
-                                                rocprofvis_dm_get_property_as_handle(
-                                                    table, kRPVDMExtTableRowHandleIndexed, i);
-                                            if(table_row != nullptr)
-                                            {
-                                                uint64_t num_cells = rocprofvis_dm_get_property_as_uint64(
-                                                    table_row, kRPVDMNumberOfTableRowCellsUInt64, 0);
-                                                ROCPROFVIS_ASSERT(num_cells == num_columns);
-                                                for(uint32_t j = 0; j < num_cells; j++)
-                                                {
-                                                    char const* value =
-                                                        rocprofvis_dm_get_property_as_charptr(
-                                                            table_row,
-                                                            kRPVDMExtTableRowCellValueCharPtrIndexed, j);
-                                                    ROCPROFVIS_ASSERT(value);
-
-                                                    Data& row_value = row[j];
-                                                    row_value.SetType(m_columns[j].m_type);
-                                                    row_value.SetString(value);
-                                                }
-
-                                                m_rows[index + i] = row;
-                                            }
-                                            else
-                                            {
-                                                dm_result = kRocProfVisDmResultUnknownError;
-                                            }
-                                        }
+                                        // one call for the whole page instead of a property lookup per cell
+                                        FetchedCells cells = { this, index, UINT64_MAX, nullptr };
+                                        dm_result = rocprofvis_dm_get_table_cells(
+                                            table, 0, num_rows, &StoreFetchedCell, &cells);
                                     }
                                     else
                                     {
@@ -220,6 +192,25 @@ rocprofvis_result_t SystemTable::Fetch(rocprofvis_dm_trace_t dm_handle, uint64_t
     return future->IsCancelled() ? kRocProfVisResultCancelled : result;
 }
 
+void SystemTable::StoreFetchedCell(uint64_t row, uint64_t column, const char* value, void* user_data)
+{
+    FetchedCells* cells = (FetchedCells*)user_data;
+    SystemTable*  table = cells->m_table;
+    if(cells->m_row == nullptr || cells->m_current_row != row)
+    {
+        cells->m_current_row = row;
+        cells->m_row = &table->m_rows[cells->m_first_row + row];
+        cells->m_row->resize(table->m_columns.size());
+    }
+    ROCPROFVIS_ASSERT(value && column < cells->m_row->size());
+    if(value && column < cells->m_row->size())
+    {
+        Data& row_value = (*cells->m_row)[column];
+        row_value.SetType(table->m_columns[column].m_type);
+        row_value.SetString(value);
+    }
+}
+
 rocprofvis_result_t SystemTable::Setup(rocprofvis_dm_trace_t dm_handle, Arguments& args, Future* future)
 {
     rocprofvis_result_t result = kRocProfVisResultInvalidArgument;
@@ -57,9 +57,21 @@ protected:
     virtual rocprofvis_dm_result_t BuildQuery(rocprofvis_dm_database_t db, TableArguments& args, uint64_t index, uint64_t count, bool count_only, char** out) const;
 
 private:
+    // Destination of the cells of a fetched range of rows
+    struct FetchedCells
+    {
+        SystemTable*       m_table;
+        uint64_t           m_first_row;
+        uint64_t           m_current_row;
+        std::vector<Data>* m_row;
+    };
+
     rocprofvis_result_t Setup(rocprofvis_dm_trace_t dm_handle, Arguments& args, Future* future) final;
     rocprofvis_result_t Fetch(rocprofvis_dm_trace_t dm_handle, uint64_t index, uint64_t count, Array& array, Future* future) final;
 
+    // rocprofvis_dm_get_table_cells callback, stores a cell in m_rows
+    static void StoreFetchedCell(uint64_t row, uint64_t column, const char* value, void* user_data);
+
     std::vector<uint32_t> m_tracks;
     rocprofvis_dm_table_use_case_enum_t m_use_case;
     double m_start_ts;
@@ -7,6 +7,7 @@
 #include "rocprofvis_controller_event.h"
 #include "rocprofvis_controller_future.h"
 #include "rocprofvis_controller_graph.h"
+#include "rocprofvis_controller_memory_report.h"
 #include "rocprofvis_controller_reference.h"
 #include "rocprofvis_controller_sample.h"
 #include "rocprofvis_controller_summary.h"
@@ -20,6 +21,7 @@
 #include "rocprofvis_core_assert.h"
 #include "rocprofvis_core_string_utils.h"
 #include <cfloat>
+#include <cmath>
 #include <cstdint>
 #include <cstring>
 #include <set>
@@ -106,6 +108,44 @@ MemoryManager* SystemTrace::GetMemoryManager(){
     return m_mem_mgmt;
 }
 
+rocprofvis_result_t SystemTrace::FetchMemoryReport(MemoryReport& report)
+{
+    rocprofvis_result_t result = Trace::FetchMemoryReport(report);
+    if(result == kRocProfVisResultSuccess)
+    {
+        // the trace entry comes first
+        uint64_t controller = report.AddEntry("Controller", 0);
+        report.Accumulate(controller, sizeof(SystemTrace) - sizeof(Trace), 0);
+
+        static const char* pool_names[kRocProfVisNumberOfObjectTypes] = {
+            "Event pool", "Sample pool", "Sample LOD pool"
+        };
+        for(uint32_t type = 0; type < kRocProfVisNumberOfObjectTypes; type++)
+        {
+            uint64_t bytes   = 0;
+            uint64_t objects = 0;
+            uint64_t pools   = 0;
+            m_mem_mgmt->GetPoolUsage((rocprofvis_object_type_t) type, bytes, objects, pools);
+            report.Accumulate(report.AddEntry(pool_names[type], controller), bytes, objects);
+        }
+
+        uint64_t track_bytes = 0;
+        for(Track* track : m_tracks)
+        {
+            uint64_t size = 0;
+            if(track->GetUInt64(kRPVControllerCommonMemoryUsageExclusive, 0, &size) ==
+               kRocProfVisResultSuccess)
+            {
+                track_bytes += size;
+            }
+        }
+        report.Accumulate(report.AddEntry("Tracks", controller), track_bytes, m_tracks.size());
+
+        report.SetBudget(m_mem_mgmt->GetMemoryLimit(), MemoryManager::GetMemoryBudget());
+    }
+    return result;
+}
+
 std::mutex& SystemTrace::GetTableMutex(rocprofvis_dm_table_use_case_enum_t use_case)
 {
     return m_table_mutex[use_case];
@@ -167,6 +207,7 @@ rocprofvis_result_t SystemTrace::LoadRocpd(Future* future) {
             if(nullptr != db && kRocProfVisDmResultSuccess ==
                                     rocprofvis_dm_bind_trace_to_database(m_dm_handle, db, m_config_path.c_str()))
             {
+                ApplyQueryTelemetry(db);
                 rocprofvis_db_future_t object2wait = rocprofvis_db_future_alloc(&Future::ProgressCallback, future);
                 if(nullptr != object2wait)
                 {
@@ -734,6 +775,176 @@ rocprofvis_result_t SystemTrace::AsyncFetch(Event& event, Future& future, Array&
     return error;
 }
 
+rocprofvis_result_t SystemTrace::AsyncFetchFlowRange(Arguments& args, Future& future, Array& array)
+{
+    rocprofvis_result_t   error      = kRocProfVisResultUnknownError;
+    rocprofvis_dm_trace_t dm_handle  = m_dm_handle;
+    double                start      = 0;
+    double                end        = 0;
+    uint64_t              num_tracks = 0;
+    std::vector<uint32_t> tracks;
+
+    // Arguments are copied up-front so the caller may release them once the job is issued
+    if(kRocProfVisResultSuccess == args.GetDouble(kRPVControllerFlowArgsStartTime, 0, &start) &&
+       kRocProfVisResultSuccess == args.GetDouble(kRPVControllerFlowArgsEndTime, 0, &end) &&
+       start <= end)
+    {
+        if(kRocProfVisResultSuccess ==
+           args.GetUInt64(kRPVControllerFlowArgsNumTracks, 0, &num_tracks))
+        {
+            tracks.reserve(num_tracks);
+            for(uint64_t i = 0; i < num_tracks; i++)
+            {
+                uint64_t track_id = 0;
+                if(kRocProfVisResultSuccess ==
+                   args.GetUInt64(kRPVControllerFlowArgsTracksIndexed, i, &track_id))
+                {
+                    tracks.push_back(static_cast<uint32_t>(track_id));
+                }
+            }
+        }
+
+        uint64_t start_ts = static_cast<uint64_t>(std::floor(start));
+        uint64_t end_ts   = static_cast<uint64_t>(std::ceil(end));
+        future.Set(JobSystem::Get().IssueJob([start_ts, end_ts, tracks, &array, dm_handle](Future* future) mutable -> rocprofvis_result_t {
+                rocprofvis_result_t result = kRocProfVisResultUnknownError;
+                result = Event::FetchDataModelFlowRange(start_ts, end_ts, tracks, array, dm_handle, future);
+                return result;
+            }, &future));
+
+        if(future.IsValid())
+        {
+            error = kRocProfVisResultSuccess;
+        }
+    }
+    else
+    {
+        error = kRocProfVisResultInvalidArgument;
+    }
+
+    return error;
+}
+
+rocprofvis_result_t SystemTrace::AsyncLoadTracks(Arguments& args, Future& future)
+{
+    rocprofvis_result_t error      = kRocProfVisResultUnknownError;
+    double              start      = 0;
+    double              end        = 0;
+    uint64_t            num_tracks = 0;
+    uint64_t            resolution = 0;
+    std::vector<Track*> tracks;
+    std::vector<Graph*> graphs;
+
+    // Arguments are copied up-front so the caller may release them once the job is issued
+    if(kRocProfVisResultSuccess == args.GetDouble(kRPVControllerTrackLoadArgsStartTime, 0, &start) &&
+       kRocProfVisResultSuccess == args.GetDouble(kRPVControllerTrackLoadArgsEndTime, 0, &end) &&
+       kRocProfVisResultSuccess == args.GetUInt64(kRPVControllerTrackLoadArgsNumTracks, 0, &num_tracks) &&
+       start <= end)
+    {
+        std::unordered_map<uint64_t, Track*> tracks_by_id;
+        for(Track* track : m_tracks)
+        {
+            uint64_t id = 0;
+            if(kRocProfVisResultSuccess == track->GetUInt64(kRPVControllerTrackId, 0, &id))
+            {
+                tracks_by_id[id] = track;
+            }
+        }
+        tracks.reserve(num_tracks);
+        for(uint64_t i = 0; i < num_tracks; i++)
+        {
+            uint64_t track_id = 0;
+            if(kRocProfVisResultSuccess ==
+               args.GetUInt64(kRPVControllerTrackLoadArgsTracksIndexed, i, &track_id))
+            {
+                auto it = tracks_by_id.find(track_id);
+                if(it != tracks_by_id.end())
+                {
+                    tracks.push_back(it->second);
+                }
+                rocprofvis_handle_t* graph = nullptr;
+                if(kRocProfVisResultSuccess ==
+                   m_timeline->GetObject(kRPVControllerTimelineGraphById, track_id, &graph))
+                {
+                    graphs.push_back((Graph*) graph);
+                }
+            }
+        }
+        if(kRocProfVisResultSuccess != args.GetUInt64(kRPVControllerTrackLoadArgsResolution, 0, &resolution))
+        {
+            resolution = 0;
+        }
+        if(resolution == 0)
+        {
+            graphs.clear();
+        }
+
+        future.Set(JobSystem::Get().IssueJob([start, end, tracks, graphs, resolution](Future* future) -> rocprofvis_result_t {
+                rocprofvis_result_t result = Track::LoadTracks(tracks, start, end, future);
+                // The level of detail is built from the loaded segments
+                for(Graph* graph : graphs)
+                {
+                    if(future->IsCancelled())
+                    {
+                        return kRocProfVisResultCancelled;
+                    }
+                    graph->Prefetch(static_cast<uint32_t>(resolution), start, end, future);
+                }
+                return result;
+            }, &future));
+
+        if(future.IsValid())
+        {
+            error = kRocProfVisResultSuccess;
+        }
+    }
+    else
+    {
+        error = kRocProfVisResultInvalidArgument;
+    }
+
+    return error;
+}
+
+rocprofvis_result_t SystemTrace::AsyncPrefetchEvents(Arguments& args, Future& future)
+{
+    rocprofvis_result_t   error      = kRocProfVisResultUnknownError;
+    rocprofvis_dm_trace_t dm_handle  = m_dm_handle;
+    uint64_t              num_events = 0;
+    std::vector<uint64_t> events;
+
+    // Arguments are copied up-front so the caller may release them once the job is issued
+    if(kRocProfVisResultSuccess ==
+       args.GetUInt64(kRPVControllerEventPrefetchArgsNumEvents, 0, &num_events))
+    {
+        events.reserve(num_events);
+        for(uint64_t i = 0; i < num_events; i++)
+        {
+            uint64_t event_id = 0;
+            if(kRocProfVisResultSuccess ==
+               args.GetUInt64(kRPVControllerEventPrefetchArgsEventsIndexed, i, &event_id))
+            {
+                events.push_back(event_id);
+            }
+        }
+
+        future.Set(JobSystem::Get().IssueJob([events, dm_handle](Future* future) -> rocprofvis_result_t {
+                return Event::PrefetchDataModelProperties(events, dm_handle, future);
+            }, &future));
+
+        if(future.IsValid())
+        {
+            error = kRocProfVisResultSuccess;
+        }
+    }
+    else
+    {
+        error = kRocProfVisResultInvalidArgument;
+    }
+
+    return error;
+}
+
 rocprofvis_result_t SystemTrace::AsyncFetch(rocprofvis_property_t property, Future& future, Array& array,
                   uint64_t index, uint64_t count)
 {
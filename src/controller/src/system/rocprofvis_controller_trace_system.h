@@ -73,6 +73,11 @@ public:
     rocprofvis_result_t AsyncFetch(rocprofvis_property_t property, Future& future,
                                           Array& array, uint64_t index, uint64_t count);
 
+    rocprofvis_result_t AsyncFetchFlowRange(Arguments& args, Future& future, Array& array);
+
+    rocprofvis_result_t AsyncLoadTracks(Arguments& args, Future& future);
+    rocprofvis_result_t AsyncPrefetchEvents(Arguments& args, Future& future);
+
     rocprofvis_controller_object_type_t GetType(void) final;
 
     // Handlers for getters.
@@ -84,6 +89,9 @@ public:
 
     MemoryManager* GetMemoryManager();
 
+    // Adds the controller object pools and track segment maps to the trace memory report
+    rocprofvis_result_t FetchMemoryReport(MemoryReport& report) override;
+
     std::mutex& GetTableMutex(rocprofvis_dm_table_use_case_enum_t use_case);
 
 private:
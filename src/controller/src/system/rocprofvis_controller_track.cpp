@@ -76,25 +76,92 @@ rocprofvis_result_t Track::GetBucketValues(size_t buckets_num, Array& array) {
     return result;
 }
 
-rocprofvis_result_t Track::FetchSegments(double start, double end, void* user_ptr, Future* future, FetchSegmentsFunc func)
+bool Track::GetSegmentRange(double& start, double& end, uint32_t& start_index, uint32_t& end_index)
+{
+    if(m_start_timestamp > end || m_end_timestamp < start)
+    {
+        return false;
+    }
+    if (m_segments.GetSegmentDuration() == 0)
+    {
+        uint32_t num_segments = (uint32_t)ceil((m_end_timestamp - m_start_timestamp) / kSegmentDuration);
+        m_segments.SetContext(this);
+        m_segments.Init(m_start_timestamp, kSegmentDuration, num_segments, m_num_entries);
+    }
+
+    start = std::max(start, m_start_timestamp);
+    end   = std::min(end, m_end_timestamp);
+
+    start_index = (uint32_t) floor((start - m_start_timestamp) / kSegmentDuration);
+    end_index   = (uint32_t) ceil((end - m_start_timestamp) / kSegmentDuration);
+    return true;
+}
+
+void Track::ReserveSegments(uint32_t start_index, uint32_t end_index, SegmentRanges& fetch_ranges)
+{
+    for(uint32_t i = start_index; i < end_index; i++)
+    {
+        if(!m_segments.IsValid(i) && !m_segments.IsProcessed(i))
+        {
+            m_segments.SetProcessed(i, true);
+            if(fetch_ranges.size() && fetch_ranges.back().second == i - 1)
+            {
+                fetch_ranges.back().second = i;
+            }
+            else
+            {
+                fetch_ranges.push_back(std::make_pair(i, i));
+            }
+        }
+    }
+}
+
+void Track::ReleaseSegments(std::pair<uint32_t, uint32_t> const& range, bool valid)
+{
+    {
+        std::unique_lock lock(*m_segments.GetMutex());
+        for(uint32_t i = range.first; i <= range.second; i++)
+        {
+            m_segments.SetProcessed(i, false);
+            m_segments.SetValid(i, valid);
+        }
+    }
+    m_cv.notify_all();
+}
+
+rocprofvis_result_t Track::FetchRanges(SegmentRanges const& fetch_ranges, Future* future)
 {
     rocprofvis_result_t result = kRocProfVisResultOutOfRange;
-    if(m_start_timestamp <= end && m_end_timestamp >= start)
+    for(auto& range : fetch_ranges)
     {
-        if (m_segments.GetSegmentDuration() == 0)
+        if(future->IsCancelled())
         {
-            uint32_t num_segments = (uint32_t)ceil((m_end_timestamp - m_start_timestamp) / kSegmentDuration);
-            m_segments.SetContext(this);
-            m_segments.Init(m_start_timestamp, kSegmentDuration, num_segments, m_num_entries);
+            result = kRocProfVisResultCancelled;
         }
+        else
+        {
+            double fetch_start =
+                m_start_timestamp + (range.first * kSegmentDuration);
+            double fetch_end =
+                m_start_timestamp + ((range.second + 1) * kSegmentDuration);
 
-        start = std::max(start, m_start_timestamp);
-        end   = std::min(end, m_end_timestamp);
+            result = FetchFromDataModel(fetch_start, fetch_end, future);
+            spdlog::debug("FetchFromDataModel for track {} ({}-{}) = {}, cancelled={}",m_id,fetch_start, fetch_end,(uint32_t)result, future->IsCancelled());
 
-        std::vector<std::pair<uint32_t, uint32_t>> fetch_ranges;
+        }
+        ReleaseSegments(range, result == kRocProfVisResultSuccess);
+    }
+    return result;
+}
 
-        uint32_t start_index = (uint32_t) floor((start - m_start_timestamp) / kSegmentDuration);
-        uint32_t end_index   = (uint32_t) ceil((end - m_start_timestamp) / kSegmentDuration);
+rocprofvis_result_t Track::FetchSegments(double start, double end, void* user_ptr, Future* future, FetchSegmentsFunc func)
+{
+    rocprofvis_result_t result = kRocProfVisResultOutOfRange;
+    uint32_t start_index = 0;
+    uint32_t end_index   = 0;
+    if(GetSegmentRange(start, end, start_index, end_index))
+    {
+        SegmentRanges fetch_ranges;
 
         {
             std::unique_lock lock(*m_segments.GetMutex());
@@ -108,60 +175,12 @@ rocprofvis_result_t Track::FetchSegments(double start, double end, void* user_pt
                 }
                 return true;
             });
-            for(uint32_t i = start_index; i < end_index; i++)
-            {
-                if(!m_segments.IsValid(i))
-                {
-                    m_segments.SetProcessed(i, true);
-                    if(fetch_ranges.size())
-                    {
-                        auto& last_range = fetch_ranges.back();
-                        if(last_range.second == i - 1)
-                        {
-                            last_range.second = i;
-                        }
-                        else
-                        {
-                            fetch_ranges.push_back(std::make_pair(i, i));
-                        }
-                    }
-                    else
-                    {
-                        fetch_ranges.push_back(std::make_pair(i, i));
-                    }
-                }
-            }
+            ReserveSegments(start_index, end_index, fetch_ranges);
         }
 
         if(fetch_ranges.size())
         {
-            for(auto& range : fetch_ranges)
-            {
-                if(future->IsCancelled())
-                {
-                    result = kRocProfVisResultCancelled;
-                }
-                else
-                {
-                    double fetch_start =
-                        m_start_timestamp + (range.first * kSegmentDuration);
-                    double fetch_end =
-                        m_start_timestamp + ((range.second + 1) * kSegmentDuration);
-
-                    result = FetchFromDataModel(fetch_start, fetch_end, future);
-                    spdlog::debug("FetchFromDataModel for track {} ({}-{}) = {}, cancelled={}",m_id,fetch_start, fetch_end,(uint32_t)result, future->IsCancelled());
-
-                }
-                {
-                    std::unique_lock lock(*m_segments.GetMutex());
-                    for(uint32_t i = range.first; i <= range.second; i++)
-                    {
-                        m_segments.SetProcessed(i, false);
-                        m_segments.SetValid(i, result == kRocProfVisResultSuccess );
-                    }
-                }
-                m_cv.notify_all();
-            }
+            result = FetchRanges(fetch_ranges, future);
         }
         else
         {
@@ -195,6 +214,230 @@ rocprofvis_result_t Track::FetchSegments(double start, double end, void* user_pt
     return result;
 }
 
+rocprofvis_result_t Track::LoadTracks(std::vector<Track*> const& tracks, double start, double end, Future* future)
+{
+    // Limits the size of the row demultiplexing expression and of a single result set
+    constexpr size_t   max_tracks_per_query = 64;
+    constexpr uint32_t max_events_per_query = 1000000;
+
+    struct TrackLoad
+    {
+        Track*        track;
+        SegmentRanges ranges;
+        uint32_t      num_events;
+    };
+
+    // Contiguous run of reserved segments of one track
+    struct TrackRun
+    {
+        Track*                         track;
+        std::pair<uint32_t, uint32_t> range;
+        double                         start;
+        double                         end;
+        uint32_t                       num_events;
+    };
+
+    // Tracks are read together only if their rows come from the same data model queries
+    std::map<std::pair<uint64_t, uint64_t>, std::vector<TrackRun>> groups;
+    std::vector<TrackLoad> singles;
+    for(Track* track : tracks)
+    {
+        double   track_start = start;
+        double   track_end   = end;
+        uint32_t start_index = 0;
+        uint32_t end_index   = 0;
+        TrackLoad load = { track, {}, 0 };
+        if(track->GetSegmentRange(track_start, track_end, start_index, end_index))
+        {
+            // Segments already being fetched are skipped, the fetch owning them completes them
+            std::unique_lock lock(*track->m_segments.GetMutex());
+            track->ReserveSegments(start_index, end_index, load.ranges);
+        }
+        if(load.ranges.empty())
+        {
+            continue;
+        }
+        uint64_t dm_track_type = rocprofvis_dm_get_property_as_uint64(
+            track->m_dm_handle, kRPVDMTrackCategoryEnumUInt64, 0);
+        if(kRocProfVisDmPmcTrack == dm_track_type)
+        {
+            singles.push_back(std::move(load));
+            continue;
+        }
+        for(auto& range : load.ranges)
+        {
+            TrackRun run = { track, range,
+                             track->m_start_timestamp + (range.first * kSegmentDuration),
+                             track->m_start_timestamp + ((range.second + 1) * kSegmentDuration),
+                             0 };
+            run.num_events = track->GetNumberOfEventsForTimeRange(run.start, run.end);
+            if(run.num_events == 0)
+            {
+                track->ReleaseSegments(range, true);
+            }
+            else
+            {
+                groups[std::make_pair(track->m_node, dm_track_type)].push_back(run);
+            }
+        }
+    }
+
+    // Runs are queried together only where they overlap, a query never spans time
+    // that none of its tracks asked for
+    std::vector<std::vector<TrackRun>> clusters;
+    for(auto& group : groups)
+    {
+        std::vector<TrackRun>& runs = group.second;
+        std::sort(runs.begin(), runs.end(), [](TrackRun const& a, TrackRun const& b) {
+            return a.start < b.start;
+        });
+        double           cluster_end = 0;
+        std::set<Track*> cluster_tracks;
+        for(TrackRun& run : runs)
+        {
+            if(cluster_tracks.empty() || run.start > cluster_end ||
+               (cluster_tracks.size() == max_tracks_per_query && cluster_tracks.count(run.track) == 0))
+            {
+                clusters.emplace_back();
+                cluster_tracks.clear();
+                cluster_end = run.end;
+            }
+            clusters.back().push_back(run);
+            cluster_tracks.insert(run.track);
+            cluster_end = std::max(cluster_end, run.end);
+        }
+    }
+
+    rocprofvis_result_t result = kRocProfVisResultSuccess;
+    for(std::vector<TrackRun>& cluster : clusters)
+    {
+        // Runs of each track in the cluster, in track order of the request
+        std::vector<TrackLoad> loads;
+        double   query_start = DBL_MAX;
+        double   query_end   = 0;
+        uint32_t num_events  = 0;
+        for(TrackRun& run : cluster)
+        {
+            auto it = std::find_if(loads.begin(), loads.end(), [&run](TrackLoad const& load) {
+                return load.track == run.track;
+            });
+            if(it == loads.end())
+            {
+                loads.push_back({ run.track, {}, 0 });
+                it = loads.end() - 1;
+            }
+            it->ranges.push_back(run.range);
+            it->num_events += run.num_events;
+            query_start = std::min(query_start, run.start);
+            query_end   = std::max(query_end, run.end);
+            num_events += run.num_events;
+        }
+        if(loads.size() == 1 || num_events > max_events_per_query || future->IsCancelled())
+        {
+            singles.insert(singles.end(), std::make_move_iterator(loads.begin()), std::make_move_iterator(loads.end()));
+            continue;
+        }
+
+        std::vector<uint32_t> track_ids;
+        track_ids.reserve(loads.size());
+        for(TrackLoad& load : loads)
+        {
+            std::sort(load.ranges.begin(), load.ranges.end());
+            track_ids.push_back(static_cast<uint32_t>(load.track->m_id));
+        }
+
+        rocprofvis_dm_track_t dm_handle = loads.front().track->m_dm_handle;
+        rocprofvis_dm_trace_t trace = rocprofvis_dm_get_property_as_handle(
+            dm_handle, kRPVDMTrackTraceHandle, 0);
+        rocprofvis_dm_database_t db = rocprofvis_dm_get_property_as_handle(
+            dm_handle, kRPVDMTrackDatabaseHandle, 0);
+        rocprofvis_dm_result_t dm_result = kRocProfVisDmResultUnknownError;
+        rocprofvis_db_future_t object2wait = rocprofvis_db_future_alloc(nullptr);
+        if(nullptr != object2wait)
+        {
+            dm_result = rocprofvis_db_read_trace_slice_async(
+                db, (uint64_t) query_start, (uint64_t) query_end,
+                kRocProfVisDmHashedTimestampTagTrackSlice,
+                (rocprofvis_db_num_of_tracks_t) track_ids.size(), track_ids.data(), object2wait);
+            if(kRocProfVisDmResultSuccess == dm_result)
+            {
+                future->AddDependentFuture(object2wait);
+                dm_result = rocprofvis_db_future_wait(object2wait, UINT64_MAX);
+                future->RemoveDependentFuture(object2wait);
+            }
+            rocprofvis_db_future_free(object2wait);
+        }
+        spdlog::debug("LoadTracks for {} tracks ({}-{}) = {}", track_ids.size(), query_start, query_end, (uint32_t) dm_result);
+
+        if(kRocProfVisDmResultSuccess != dm_result)
+        {
+            if(dm_result == kRocProfVisDmResultDbAbort || future->IsCancelled())
+            {
+                for(TrackLoad& load : loads)
+                {
+                    for(auto& range : load.ranges)
+                    {
+                        load.track->ReleaseSegments(range, false);
+                    }
+                }
+                result = kRocProfVisResultCancelled;
+            }
+            else
+            {
+                // Tracks that cannot be read together are loaded one by one
+                singles.insert(singles.end(), std::make_move_iterator(loads.begin()), std::make_move_iterator(loads.end()));
+            }
+            continue;
+        }
+
+        for(TrackLoad& load : loads)
+        {
+            Track* track = load.track;
+            rocprofvis_result_t track_result = kRocProfVisResultSuccess;
+            rocprofvis_dm_slice_t slice = rocprofvis_dm_get_property_as_handle(
+                track->m_dm_handle, kRPVDMSliceHandleTimed,
+                rocprofvis_dm_hash_combine_timestamp((uint64_t) query_start, (uint64_t) query_end, kRocProfVisDmHashedTimestampTagTrackSlice));
+            if(nullptr != slice)
+            {
+                uint64_t dm_track_type = rocprofvis_dm_get_property_as_uint64(
+                    track->m_dm_handle, kRPVDMTrackCategoryEnumUInt64, 0);
+                track->AddSliceEntries(slice, dm_track_type, &load.ranges, future, track_result);
+                if (kRocProfVisDmResultSuccess != rocprofvis_dm_delete_time_slice_handle(trace, static_cast<rocprofvis_dm_track_id_t>(track->m_id), slice))
+                {
+                    track_result = kRocProfVisResultUnknownError;
+                }
+            }
+            else
+            {
+                track_result = kRocProfVisResultNotLoaded;
+            }
+            if(future->IsCancelled())
+            {
+                track_result = kRocProfVisResultCancelled;
+            }
+            for(auto& range : load.ranges)
+            {
+                track->ReleaseSegments(range, track_result == kRocProfVisResultSuccess);
+            }
+            if(track_result != kRocProfVisResultSuccess)
+            {
+                result = track_result;
+            }
+        }
+    }
+
+    for(TrackLoad& load : singles)
+    {
+        rocprofvis_result_t track_result = load.track->FetchRanges(load.ranges, future);
+        if(track_result != kRocProfVisResultSuccess)
+        {
+            result = track_result;
+        }
+    }
+
+    return future->IsCancelled() ? kRocProfVisResultCancelled : result;
+}
+
 struct FetchEventsArgs
 {
     Array*             m_array;
@@ -243,6 +486,162 @@ uint32_t Track::GetNumberOfEventsForTimeRange(double start, double end)
     return num_events;
 }
 
+bool Track::OverlapsRanges(SegmentRanges const& ranges, double start, double end) const
+{
+    for(auto& range : ranges)
+    {
+        // Same overlap condition as the data model slice query
+        if(start < m_start_timestamp + ((range.second + 1) * kSegmentDuration) &&
+           end > m_start_timestamp + (range.first * kSegmentDuration))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Track::AddSliceEntries(rocprofvis_dm_slice_t slice, uint64_t dm_track_type, SegmentRanges const* filter, Future* future, rocprofvis_result_t& result)
+{
+    uint64_t num_records = rocprofvis_dm_get_property_as_uint64(
+        slice, kRPVDMNumberOfRecordsUInt64, 0);
+
+    if(num_records > 0)
+    {
+        switch(dm_track_type)
+        {
+            case kRocProfVisDmRegionTrack:
+            case kRocProfVisDmRegionMainTrack:
+            case kRocProfVisDmRegionSampleTrack:
+            case kRocProfVisDmKernelDispatchTrack:
+            case kRocProfVisDmMemoryAllocationTrack:
+            case kRocProfVisDmMemoryCopyTrack:
+            case kRocProfVisDmStreamTrack:
+            {
+                uint64_t index = 0;
+
+                for(uint64_t record_index = 0; record_index < num_records; record_index++)
+                {
+                    if(future->IsCancelled()) break;                         
+                    double timestamp =
+                        (double) rocprofvis_dm_get_property_as_uint64(
+                            slice, kRPVDMTimestampUInt64Indexed, record_index);
+                    double duration =
+                        (double) rocprofvis_dm_get_property_as_int64(
+                            slice, kRPVDMEventDurationInt64Indexed, record_index);
+                    if(duration < 0) continue;
+                    if(filter && !OverlapsRanges(*filter, timestamp, timestamp + duration)) continue;
+
+                    uint64_t event_id =
+                        rocprofvis_dm_get_property_as_uint64(
+                            slice, kRPVDMEventIdUInt64Indexed, record_index);
+                    Event* new_event =
+                        m_ctx->GetMemoryManager()->NewEvent(
+                            event_id, timestamp,
+                                                    timestamp + duration, GetSegments());
+                    if(new_event)
+                    {
+                        result = new_event->SetUInt64(
+                            kRPVControllerEventLevel, 0,
+                            rocprofvis_dm_get_property_as_uint64(
+                                slice, kRPVDMEventLevelUInt64Indexed, record_index));
+                        result = new_event->SetString(
+                            kRPVControllerEventCategory, 0,
+                            rocprofvis_dm_get_property_as_charptr(
+                                slice,
+                                kRPVDMEventTypeStringCharPtrIndexed, record_index));
+                        ROCPROFVIS_ASSERT(result ==
+                                            kRocProfVisResultSuccess);
+
+                        result = new_event->SetString(
+                            kRPVControllerEventName, 0,
+                            rocprofvis_dm_get_property_as_charptr(
+                                slice,
+                                kRPVDMEventSymbolStringCharPtrIndexed, record_index));
+                        ROCPROFVIS_ASSERT(result ==
+                                            kRocProfVisResultSuccess);
+
+                        result = SetObject(
+                            kRPVControllerTrackEntry, index++,
+                            (rocprofvis_handle_t*) new_event);
+                        if( result == kRocProfVisResultOutOfRange)
+                        {
+                            spdlog::warn(
+                                "Track::FetchFromDataModel: Skipping Event "
+                                "id {} on track id {}, event is out of range",
+                                event_id, m_id);
+                        }
+                        else
+                        {
+                            ROCPROFVIS_ASSERT(result ==
+                                              kRocProfVisResultSuccess);
+                        }
+                    }
+                    else
+                    {
+                        result = kRocProfVisResultMemoryAllocError;
+                        break;
+                    }
+                }
+
+                break;
+            }
+            case kRocProfVisDmPmcTrack:
+            {
+                uint64_t index = 0;
+                uint64_t sample_id = 0;
+                double timestamp =
+                    (double) rocprofvis_dm_get_property_as_uint64(
+                        slice, kRPVDMTimestampUInt64Indexed, 0);
+                double value = rocprofvis_dm_get_property_as_double(
+                    slice, kRPVDMPmcValueDoubleIndexed, 0);
+                double last_timestamp = timestamp;
+                double last_value = value;
+                std::string str;
+                for(uint64_t record_index = 1; record_index < num_records; record_index++)
+                {
+                    if(future->IsCancelled()) break;
+                    timestamp = (record_index == num_records) ? last_timestamp :
+                        (double) rocprofvis_dm_get_property_as_uint64(
+                            slice, kRPVDMTimestampUInt64Indexed, record_index);
+                    value = (record_index == num_records) ? last_value : 
+                        rocprofvis_dm_get_property_as_double(
+                        slice, kRPVDMPmcValueDoubleIndexed, record_index);
+                    if (timestamp <= last_timestamp)
+                    {
+                        continue;
+                    }
+                    Sample* new_sample = m_ctx->GetMemoryManager()->NewSample(
+                        kRPVControllerPrimitiveTypeDouble,
+                                    sample_id++, last_timestamp, GetSegments());
+                    if(new_sample)
+                    {
+                        new_sample->SetDouble(
+                            kRPVControllerSampleValue, 0, last_value);
+                        new_sample->SetDouble(
+                            kRPVControllerSampleEndTimestamp, 0, timestamp);
+                        SetObject(
+                            kRPVControllerTrackEntry, index++,
+                            (rocprofvis_handle_t*) new_sample);
+                    }
+                    else
+                    {
+                        result = kRocProfVisResultMemoryAllocError;
+                        break;
+                    }
+                    last_value = value;
+                    last_timestamp = timestamp;
+                }
+
+                break;
+            }
+            default:
+            {
+                break;
+            }
+        }
+    }
+}
+
 rocprofvis_result_t Track::FetchFromDataModel(double start, double end, Future* future)
 {
     rocprofvis_result_t result = kRocProfVisResultOutOfRange;
@@ -302,143 +701,7 @@ rocprofvis_result_t Track::FetchFromDataModel(double start, double end, Future*
                 rocprofvis_dm_hash_combine_timestamp(fetch_start + (i * time_per_query), fetch_start + ((i+1) * time_per_query), kRocProfVisDmHashedTimestampTagTrackSlice));
             if(nullptr != slice)
             {
-                uint64_t num_records = rocprofvis_dm_get_property_as_uint64(
-                    slice, kRPVDMNumberOfRecordsUInt64, 0);
-
-                if(num_records > 0)
-                {
-                    switch(dm_track_type)
-                    {
-                        case kRocProfVisDmRegionTrack:
-                        case kRocProfVisDmRegionMainTrack:
-                        case kRocProfVisDmRegionSampleTrack:
-                        case kRocProfVisDmKernelDispatchTrack:
-                        case kRocProfVisDmMemoryAllocationTrack:
-                        case kRocProfVisDmMemoryCopyTrack:
-                        case kRocProfVisDmStreamTrack:
-                        {
-                            uint64_t index = 0;
-
-                            for(int record_index = 0; record_index < num_records; record_index++)
-                            {
-                                if(future->IsCancelled()) break;                         
-                                double timestamp =
-                                    (double) rocprofvis_dm_get_property_as_uint64(
-                                        slice, kRPVDMTimestampUInt64Indexed, record_index);
-                                double duration =
-                                    (double) rocprofvis_dm_get_property_as_int64(
-                                        slice, kRPVDMEventDurationInt64Indexed, record_index);
-                                if(duration < 0) continue;
-
-                                uint64_t event_id =
-                                    rocprofvis_dm_get_property_as_uint64(
-                                        slice, kRPVDMEventIdUInt64Indexed, record_index);
-                                Event* new_event =
-                                    m_ctx->GetMemoryManager()->NewEvent(
-                                        event_id, timestamp,
-                                                                timestamp + duration, GetSegments());
-                                if(new_event)
-                                {
-                                    result = new_event->SetUInt64(
-                                        kRPVControllerEventLevel, 0,
-                                        rocprofvis_dm_get_property_as_uint64(
-                                            slice, kRPVDMEventLevelUInt64Indexed, record_index));
-                                    result = new_event->SetString(
-                                        kRPVControllerEventCategory, 0,
-                                        rocprofvis_dm_get_property_as_charptr(
-                                            slice,
-                                            kRPVDMEventTypeStringCharPtrIndexed, record_index));
-                                    ROCPROFVIS_ASSERT(result ==
-                                                        kRocProfVisResultSuccess);
-
-                                    result = new_event->SetString(
-                                        kRPVControllerEventName, 0,
-                                        rocprofvis_dm_get_property_as_charptr(
-                                            slice,
-                                            kRPVDMEventSymbolStringCharPtrIndexed, record_index));
-                                    ROCPROFVIS_ASSERT(result ==
-                                                        kRocProfVisResultSuccess);
-
-                                    result = SetObject(
-                                        kRPVControllerTrackEntry, index++,
-                                        (rocprofvis_handle_t*) new_event);
-                                    if( result == kRocProfVisResultOutOfRange)
-                                    {
-                                        spdlog::warn(
-                                            "Track::FetchFromDataModel: Skipping Event "
-                                            "id {} on track id {}, event is out of range",
-                                            event_id, m_id);
-                                    }
-                                    else
-                                    {
-                                        ROCPROFVIS_ASSERT(result ==
-                                                          kRocProfVisResultSuccess);
-                                    }
-                                }
-                                else
-                                {
-                                    result = kRocProfVisResultMemoryAllocError;
-                                    break;
-                                }
-                            }
-
-                            break;
-                        }
-                        case kRocProfVisDmPmcTrack:
-                        {
-                            uint64_t index = 0;
-                            uint64_t sample_id = 0;
-                            double timestamp =
-                                (double) rocprofvis_dm_get_property_as_uint64(
-                                    slice, kRPVDMTimestampUInt64Indexed, 0);
-                            double value = rocprofvis_dm_get_property_as_double(
-                                slice, kRPVDMPmcValueDoubleIndexed, 0);
-                            double last_timestamp = timestamp;
-                            double last_value = value;
-                            std::string str;
-                            for(int record_index = 1; record_index < num_records; record_index++)
-                            {
-                                if(future->IsCancelled()) break;
-                                timestamp = (record_index == num_records) ? last_timestamp :
-                                    (double) rocprofvis_dm_get_property_as_uint64(
-                                        slice, kRPVDMTimestampUInt64Indexed, record_index);
-                                value = (record_index == num_records) ? last_value : 
-                                    rocprofvis_dm_get_property_as_double(
-                                    slice, kRPVDMPmcValueDoubleIndexed, record_index);
-                                if (timestamp <= last_timestamp)
-                                {
-                                    continue;
-                                }
-                                Sample* new_sample = m_ctx->GetMemoryManager()->NewSample(
-                                    kRPVControllerPrimitiveTypeDouble,
-                                                sample_id++, last_timestamp, GetSegments());
-                                if(new_sample)
-                                {
-                                    new_sample->SetDouble(
-                                        kRPVControllerSampleValue, 0, last_value);
-                                    new_sample->SetDouble(
-                                        kRPVControllerSampleEndTimestamp, 0, timestamp);
-                                    SetObject(
-                                        kRPVControllerTrackEntry, index++,
-                                        (rocprofvis_handle_t*) new_sample);
-                                }
-                                else
-                                {
-                                    result = kRocProfVisResultMemoryAllocError;
-                                    break;
-                                }
-                                last_value = value;
-                                last_timestamp = timestamp;
-                            }
-
-                            break;
-                        }
-                        default:
-                        {
-                            break;
-                        }
-                    }
-                }
+                AddSliceEntries(slice, dm_track_type, nullptr, future, result);
 
                 if (kRocProfVisDmResultSuccess != rocprofvis_dm_delete_time_slice_handle(trace, static_cast<rocprofvis_dm_track_id_t>(m_id), slice))
                 {
@@ -35,6 +35,11 @@ public:
     rocprofvis_result_t FetchSegments(double start, double end, void* user_ptr, Future* future, FetchSegmentsFunc func);
     rocprofvis_result_t Fetch(double start, double end, Array& array, uint64_t& index, Future* future);
 
+    // Loads missing segments of the tracks in the time range. Overlapping runs of missing
+    // segments of tracks with rows in the same data model tables are read with a single
+    // slice query, others are fetched one by one.
+    static rocprofvis_result_t LoadTracks(std::vector<Track*> const& tracks, double start, double end, Future* future);
+
     rocprofvis_controller_object_type_t GetType(void) final;
     rocprofvis_dm_track_t GetDmHandle(void);
     Handle* GetContext(void) override;
@@ -77,7 +82,18 @@ private:
     std::condition_variable_any  m_cv;
 
 private:
+    // Inclusive ranges of segment indices
+    typedef std::vector<std::pair<uint32_t, uint32_t>> SegmentRanges;
+
+    bool GetSegmentRange(double& start, double& end, uint32_t& start_index, uint32_t& end_index);
+    // Marks segments neither valid nor being processed as processed, segment mutex must be held
+    void ReserveSegments(uint32_t start_index, uint32_t end_index, SegmentRanges& fetch_ranges);
+    void ReleaseSegments(std::pair<uint32_t, uint32_t> const& range, bool valid);
+    rocprofvis_result_t FetchRanges(SegmentRanges const& fetch_ranges, Future* future);
     rocprofvis_result_t FetchFromDataModel(double start, double end, Future* future);
+    // Adds slice records as track entries, records outside of filter ranges are skipped
+    void AddSliceEntries(rocprofvis_dm_slice_t slice, uint64_t dm_track_type, SegmentRanges const* filter, Future* future, rocprofvis_result_t& result);
+    bool OverlapsRanges(SegmentRanges const& ranges, double start, double end) const;
 
     uint32_t GetNumberOfEventsForTimeRange(double start, double end);
 };
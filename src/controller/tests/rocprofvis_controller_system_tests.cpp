@@ -13,10 +13,14 @@
 #include <catch2/catch_session.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <cfloat>
+#include <cmath>
 #include <chrono>
 #include <filesystem>
+#include <limits>
 #include <memory>
+#include <set>
 #include <thread>
+#include <tuple>
 #include <unordered_map>
 #include <vector>
 
@@ -1498,6 +1502,207 @@ TEST_CASE_PERSISTENT_FIXTURE(RocProfVisControllerFixture, "System Trace Controll
         }
     }
 
+    // Loads all tracks of a second controller with track load requests, first a narrow
+    // range for every other track and then a wider range for all of them, so the
+    // coalesced queries see tracks with different missing runs. Every track must then
+    // return the same entries as the fully loaded fixture controller. A last load with
+    // a resolution must leave the graph level of detail ready for a graph fetch.
+    // Fixture Reads: m_controller
+    SECTION("Load Tracks")
+    {
+        rocprofvis_controller_t* controller =
+            rocprofvis_controller_alloc(g_input_file.c_str(), nullptr);
+        REQUIRE(nullptr != controller);
+        rocprofvis_controller_future_t* future = rocprofvis_controller_future_alloc();
+        REQUIRE(future != nullptr);
+        REQUIRE(rocprofvis_controller_load_async(controller, future) ==
+                kRocProfVisResultSuccess);
+        REQUIRE(rocprofvis_controller_future_wait(future, FLT_MAX) ==
+                kRocProfVisResultSuccess);
+        rocprofvis_controller_future_free(future);
+
+        rocprofvis_handle_t* timeline_handle = nullptr;
+        REQUIRE(rocprofvis_controller_get_object(controller, kRPVControllerSystemTimeline,
+                                                 0, &timeline_handle) ==
+                kRocProfVisResultSuccess);
+        double min_ts = 0;
+        double max_ts = 0;
+        REQUIRE(rocprofvis_controller_get_double(timeline_handle,
+                                                 kRPVControllerTimelineMinTimestamp, 0,
+                                                 &min_ts) == kRocProfVisResultSuccess);
+        REQUIRE(rocprofvis_controller_get_double(timeline_handle,
+                                                 kRPVControllerTimelineMaxTimestamp, 0,
+                                                 &max_ts) == kRocProfVisResultSuccess);
+        double width = max_ts - min_ts;
+
+        uint64_t num_tracks = 0;
+        REQUIRE(rocprofvis_controller_get_uint64(controller, kRPVControllerSystemNumTracks,
+                                                 0, &num_tracks) ==
+                kRocProfVisResultSuccess);
+        std::vector<uint64_t> track_ids;
+        for(uint64_t track_idx = 0; track_idx < num_tracks; track_idx++)
+        {
+            rocprofvis_handle_t* track_handle = nullptr;
+            REQUIRE(rocprofvis_controller_get_object(controller,
+                                                     kRPVControllerSystemTrackIndexed,
+                                                     track_idx, &track_handle) ==
+                    kRocProfVisResultSuccess);
+            uint64_t track_id = 0;
+            REQUIRE(rocprofvis_controller_get_uint64(track_handle, kRPVControllerTrackId, 0,
+                                                     &track_id) ==
+                    kRocProfVisResultSuccess);
+            track_ids.push_back(track_id);
+        }
+
+        auto load_tracks = [&](std::vector<uint64_t> const& ids, double start_ts,
+                               double end_ts, uint64_t resolution) {
+            rocprofvis_controller_arguments_t* args = rocprofvis_controller_arguments_alloc();
+            REQUIRE(args != nullptr);
+            rocprofvis_controller_set_double(args, kRPVControllerTrackLoadArgsStartTime, 0,
+                                             start_ts);
+            rocprofvis_controller_set_double(args, kRPVControllerTrackLoadArgsEndTime, 0,
+                                             end_ts);
+            rocprofvis_controller_set_uint64(args, kRPVControllerTrackLoadArgsNumTracks, 0,
+                                             ids.size());
+            for(uint64_t i = 0; i < ids.size(); i++)
+            {
+                rocprofvis_controller_set_uint64(
+                    args, kRPVControllerTrackLoadArgsTracksIndexed, i, ids[i]);
+            }
+            rocprofvis_controller_set_uint64(args, kRPVControllerTrackLoadArgsResolution, 0,
+                                             resolution);
+            rocprofvis_controller_future_t* load_future = rocprofvis_controller_future_alloc();
+            REQUIRE(load_future != nullptr);
+            REQUIRE(rocprofvis_controller_track_load_async(controller, args, load_future) ==
+                    kRocProfVisResultSuccess);
+            REQUIRE(rocprofvis_controller_future_wait(load_future, FLT_MAX) ==
+                    kRocProfVisResultSuccess);
+            uint64_t future_result = 0;
+            REQUIRE(rocprofvis_controller_get_uint64(load_future,
+                                                     kRPVControllerFutureResult, 0,
+                                                     &future_result) ==
+                    kRocProfVisResultSuccess);
+            spdlog::info("Loaded {} tracks {}-{}: {}", ids.size(), start_ts, end_ts,
+                         future_result);
+            REQUIRE((future_result == kRocProfVisResultSuccess ||
+                     future_result == kRocProfVisResultOutOfRange));
+            rocprofvis_controller_future_free(load_future);
+            rocprofvis_controller_arguments_free(args);
+        };
+
+        // Sorted ids of the entries the track returns for the range
+        auto fetch_ids = [&](rocprofvis_controller_t* owner, uint64_t track_idx,
+                             double start_ts, double end_ts) {
+            rocprofvis_handle_t* track_handle = nullptr;
+            REQUIRE(rocprofvis_controller_get_object(owner,
+                                                     kRPVControllerSystemTrackIndexed,
+                                                     track_idx, &track_handle) ==
+                    kRocProfVisResultSuccess);
+            uint64_t track_type = 0;
+            REQUIRE(rocprofvis_controller_get_uint64(track_handle, kRPVControllerTrackType,
+                                                     0, &track_type) ==
+                    kRocProfVisResultSuccess);
+            rocprofvis_controller_array_t* array = rocprofvis_controller_array_alloc(0);
+            REQUIRE(array != nullptr);
+            rocprofvis_controller_future_t* fetch_future =
+                rocprofvis_controller_future_alloc();
+            REQUIRE(fetch_future != nullptr);
+            REQUIRE(rocprofvis_controller_track_fetch_async(
+                        owner, (rocprofvis_controller_track_t*) track_handle, start_ts,
+                        end_ts, fetch_future, array) == kRocProfVisResultSuccess);
+            REQUIRE(rocprofvis_controller_future_wait(fetch_future, FLT_MAX) ==
+                    kRocProfVisResultSuccess);
+            uint64_t num_entries = 0;
+            REQUIRE(rocprofvis_controller_get_uint64(array, kRPVControllerArrayNumEntries,
+                                                     0, &num_entries) ==
+                    kRocProfVisResultSuccess);
+            std::vector<uint64_t> ids;
+            for(uint64_t i = 0; i < num_entries; i++)
+            {
+                rocprofvis_handle_t* entry = nullptr;
+                REQUIRE(rocprofvis_controller_get_object(array,
+                                                         kRPVControllerArrayEntryIndexed, i,
+                                                         &entry) ==
+                        kRocProfVisResultSuccess);
+                uint64_t id = 0;
+                REQUIRE(rocprofvis_controller_get_uint64(
+                            entry,
+                            track_type == kRPVControllerTrackTypeEvents
+                                ? (rocprofvis_property_t) kRPVControllerEventId
+                                : (rocprofvis_property_t) kRPVControllerSampleId,
+                            0, &id) == kRocProfVisResultSuccess);
+                ids.push_back(id);
+            }
+            std::sort(ids.begin(), ids.end());
+            rocprofvis_controller_future_free(fetch_future);
+            rocprofvis_controller_array_free(array);
+            return ids;
+        };
+
+        std::vector<uint64_t> every_other;
+        for(size_t i = 0; i < track_ids.size(); i += 2)
+        {
+            every_other.push_back(track_ids[i]);
+        }
+        load_tracks(every_other, min_ts + width * 0.45, min_ts + width * 0.55, 0);
+        load_tracks(track_ids, min_ts + width * 0.3, min_ts + width * 0.7, 0);
+
+        double start_ts = min_ts + width * 0.3;
+        double end_ts   = min_ts + width * 0.7;
+        for(uint64_t track_idx = 0; track_idx < num_tracks; track_idx++)
+        {
+            std::vector<uint64_t> loaded   = fetch_ids(controller, track_idx, start_ts, end_ts);
+            std::vector<uint64_t> expected = fetch_ids(m_controller, track_idx, start_ts, end_ts);
+            spdlog::info("Track {} loaded {} entries, expected {}", track_ids[track_idx],
+                         loaded.size(), expected.size());
+            REQUIRE(loaded == expected);
+        }
+
+        // A load with a resolution also generates the graph level of detail, so the
+        // graph fetch that follows at that resolution only reads it
+        constexpr uint64_t resolution = 500;
+        load_tracks(track_ids, min_ts, max_ts, resolution);
+        for(uint64_t track_id : track_ids)
+        {
+            rocprofvis_handle_t* graph_handle = nullptr;
+            REQUIRE(rocprofvis_controller_get_object(timeline_handle,
+                                                     kRPVControllerTimelineGraphById,
+                                                     track_id, &graph_handle) ==
+                    kRocProfVisResultSuccess);
+            uint64_t lod_usage = 0;
+            REQUIRE(rocprofvis_controller_get_uint64(
+                        graph_handle, kRPVControllerCommonMemoryUsageInclusive, 0,
+                        &lod_usage) == kRocProfVisResultSuccess);
+
+            rocprofvis_controller_array_t* array = rocprofvis_controller_array_alloc(0);
+            REQUIRE(array != nullptr);
+            rocprofvis_controller_future_t* graph_future =
+                rocprofvis_controller_future_alloc();
+            REQUIRE(graph_future != nullptr);
+            REQUIRE(rocprofvis_controller_graph_fetch_async(
+                        controller, graph_handle, min_ts, max_ts, resolution, graph_future,
+                        array) == kRocProfVisResultSuccess);
+            REQUIRE(rocprofvis_controller_future_wait(graph_future, FLT_MAX) ==
+                    kRocProfVisResultSuccess);
+            uint64_t num_entries = 0;
+            REQUIRE(rocprofvis_controller_get_uint64(array, kRPVControllerArrayNumEntries,
+                                                     0, &num_entries) ==
+                    kRocProfVisResultSuccess);
+            uint64_t fetched_usage = 0;
+            REQUIRE(rocprofvis_controller_get_uint64(
+                        graph_handle, kRPVControllerCommonMemoryUsageInclusive, 0,
+                        &fetched_usage) == kRocProfVisResultSuccess);
+            spdlog::info("Graph {} level of detail {} bytes, {} entries", track_id,
+                         lod_usage, num_entries);
+            REQUIRE((num_entries == 0 || lod_usage > 0));
+            REQUIRE(fetched_usage == lod_usage);
+            rocprofvis_controller_future_free(graph_future);
+            rocprofvis_controller_array_free(array);
+        }
+
+        rocprofvis_controller_free(controller);
+    }
+
     // Reads the full system topology: nodes (hostname, OS info), processors (product,
     // type, queues, counters), and processes (command, threads, streams).
     // Fixture Reads: m_controller
@@ -2598,6 +2803,101 @@ TEST_CASE_PERSISTENT_FIXTURE(RocProfVisControllerFixture, "System Trace Controll
         }
     }
 
+    // Prefetches the properties of the first events of every event track in one
+    // request, then fetches the extended data of each of them.
+    // Fixture Reads: m_controller, m_track_data
+    SECTION("Event Prefetch")
+    {
+        uint64_t            num_tracks = 0;
+        rocprofvis_result_t result     = rocprofvis_controller_get_uint64(
+            m_controller, kRPVControllerSystemNumTracks, 0, &num_tracks);
+        REQUIRE(result == kRocProfVisResultSuccess);
+
+        std::vector<uint64_t> event_ids;
+        for(uint32_t ti = 0; ti < num_tracks && event_ids.size() < 64; ti++)
+        {
+            rocprofvis_handle_t* track_handle = nullptr;
+            result                            = rocprofvis_controller_get_object(
+                m_controller, kRPVControllerSystemTrackIndexed, ti, &track_handle);
+            REQUIRE(result == kRocProfVisResultSuccess);
+
+            uint64_t track_type = 0;
+            result              = rocprofvis_controller_get_uint64(
+                track_handle, kRPVControllerTrackType, 0, &track_type);
+            REQUIRE(result == kRocProfVisResultSuccess);
+
+            if(track_type == kRPVControllerTrackTypeEvents && m_track_data[ti] != nullptr)
+            {
+                uint64_t num_entries = 0;
+                result               = rocprofvis_controller_get_uint64(
+                    m_track_data[ti], kRPVControllerArrayNumEntries, 0, &num_entries);
+                REQUIRE(result == kRocProfVisResultSuccess);
+
+                for(uint64_t i = 0; i < num_entries && i < 8; i++)
+                {
+                    rocprofvis_handle_t* entry = nullptr;
+                    result                     = rocprofvis_controller_get_object(
+                        m_track_data[ti], kRPVControllerArrayEntryIndexed, i, &entry);
+                    REQUIRE(result == kRocProfVisResultSuccess);
+
+                    uint64_t event_id = 0;
+                    result            = rocprofvis_controller_get_uint64(
+                        entry, kRPVControllerEventId, 0, &event_id);
+                    REQUIRE(result == kRocProfVisResultSuccess);
+                    event_ids.push_back(event_id);
+                }
+            }
+        }
+
+        if(!event_ids.empty())
+        {
+            spdlog::info("Prefetching properties of {0} events", event_ids.size());
+
+            rocprofvis_controller_arguments_t* args = rocprofvis_controller_arguments_alloc();
+            REQUIRE(args != nullptr);
+            rocprofvis_controller_set_uint64(args, kRPVControllerEventPrefetchArgsNumEvents,
+                                             0, event_ids.size());
+            for(uint64_t i = 0; i < event_ids.size(); i++)
+            {
+                rocprofvis_controller_set_uint64(
+                    args, kRPVControllerEventPrefetchArgsEventsIndexed, i, event_ids[i]);
+            }
+            rocprofvis_controller_future_t* future = rocprofvis_controller_future_alloc();
+            REQUIRE(future != nullptr);
+            result = rocprofvis_controller_event_prefetch_async(m_controller, args, future);
+            REQUIRE(result == kRocProfVisResultSuccess);
+            result = rocprofvis_controller_future_wait(future, FLT_MAX);
+            REQUIRE(result == kRocProfVisResultSuccess);
+            uint64_t future_result = 0;
+            result = rocprofvis_controller_get_uint64(future, kRPVControllerFutureResult, 0,
+                                                      &future_result);
+            REQUIRE(result == kRocProfVisResultSuccess);
+            REQUIRE(future_result == kRocProfVisResultSuccess);
+            rocprofvis_controller_future_free(future);
+            rocprofvis_controller_arguments_free(args);
+
+            for(uint64_t event_id : event_ids)
+            {
+                future = rocprofvis_controller_future_alloc();
+                REQUIRE(future != nullptr);
+                rocprofvis_controller_array_t* array = rocprofvis_controller_array_alloc(0);
+                REQUIRE(array != nullptr);
+                result = rocprofvis_controller_get_indexed_property_async(
+                    m_controller, m_controller, kRPVControllerSystemEventDataExtDataIndexed,
+                    event_id, 1, future, array);
+                REQUIRE(result == kRocProfVisResultSuccess);
+                result = rocprofvis_controller_future_wait(future, FLT_MAX);
+                REQUIRE(result == kRocProfVisResultSuccess);
+                result = rocprofvis_controller_get_uint64(
+                    future, kRPVControllerFutureResult, 0, &future_result);
+                REQUIRE(result == kRocProfVisResultSuccess);
+                REQUIRE(future_result == kRocProfVisResultSuccess);
+                rocprofvis_controller_array_free(array);
+                rocprofvis_controller_future_free(future);
+            }
+        }
+    }
+
     // Fetches summary metrics for the full timeline range including GPU utilization,
     // bandwidth, compute throughput, and per-kernel aggregated data.
     // Fixture Reads: m_controller
@@ -2884,6 +3184,657 @@ TEST_CASE_PERSISTENT_FIXTURE(RocProfVisControllerFixture, "System Trace Controll
         rocprofvis_controller_future_free(future);
     }
 
+    // Fetches the full summary and then a kernels only summary of a sub range, as the
+    // view does while a range is dragged. Node totals must add up to the trace total,
+    // and the kernels only fetch must reuse the counter utilization of the full fetch.
+    // Fixture Reads: m_controller
+    SECTION("Summary Kernels Only")
+    {
+        rocprofvis_handle_t* summary_handle = nullptr;
+        rocprofvis_result_t  result         = rocprofvis_controller_get_object(
+            m_controller, kRPVControllerSystemSummary, 0, &summary_handle);
+        REQUIRE(result == kRocProfVisResultSuccess);
+        REQUIRE(summary_handle != nullptr);
+
+        rocprofvis_handle_t* timeline_handle = nullptr;
+        result                               = rocprofvis_controller_get_object(
+            m_controller, kRPVControllerSystemTimeline, 0, &timeline_handle);
+        REQUIRE(result == kRocProfVisResultSuccess);
+        double start_ts = 0;
+        double end_ts   = 0;
+        REQUIRE(rocprofvis_controller_get_double(timeline_handle,
+                                                 kRPVControllerTimelineMinTimestamp, 0,
+                                                 &start_ts) == kRocProfVisResultSuccess);
+        REQUIRE(rocprofvis_controller_get_double(timeline_handle,
+                                                 kRPVControllerTimelineMaxTimestamp, 0,
+                                                 &end_ts) == kRocProfVisResultSuccess);
+
+        auto fetch_summary = [&](double range_start, double range_end, bool kernels_only) {
+            rocprofvis_controller_arguments_t* args = rocprofvis_controller_arguments_alloc();
+            REQUIRE(args != nullptr);
+            REQUIRE(rocprofvis_controller_set_double(args,
+                                                     kRPVControllerSummaryArgsStartTimestamp,
+                                                     0, range_start) == kRocProfVisResultSuccess);
+            REQUIRE(rocprofvis_controller_set_double(args,
+                                                     kRPVControllerSummaryArgsEndTimestamp, 0,
+                                                     range_end) == kRocProfVisResultSuccess);
+            REQUIRE(rocprofvis_controller_set_uint64(args,
+                                                     kRPVControllerSummaryArgsKernelsOnly, 0,
+                                                     kernels_only ? 1 : 0) ==
+                    kRocProfVisResultSuccess);
+            rocprofvis_controller_summary_metrics_t* metrics =
+                rocprofvis_controller_summary_metrics_alloc();
+            REQUIRE(metrics != nullptr);
+            rocprofvis_controller_future_t* future = rocprofvis_controller_future_alloc();
+            REQUIRE(future != nullptr);
+            REQUIRE(rocprofvis_controller_summary_fetch_async(
+                        m_controller, (rocprofvis_controller_summary_t*) summary_handle, args,
+                        future, metrics) == kRocProfVisResultSuccess);
+            REQUIRE(rocprofvis_controller_future_wait(future, FLT_MAX) ==
+                    kRocProfVisResultSuccess);
+            uint64_t future_result = 0;
+            REQUIRE(rocprofvis_controller_get_uint64(future, kRPVControllerFutureResult, 0,
+                                                     &future_result) ==
+                    kRocProfVisResultSuccess);
+            REQUIRE(future_result == kRocProfVisResultSuccess);
+            rocprofvis_controller_arguments_free(args);
+            rocprofvis_controller_future_free(future);
+            return metrics;
+        };
+
+        // Utilization of every processor in visiting order, NaN when not reported
+        auto collect_util = [&](rocprofvis_handle_t* metrics_handle, auto& self,
+                                std::vector<double>& util) -> void {
+            uint64_t num_sub = 0;
+            REQUIRE(rocprofvis_controller_get_uint64(
+                        metrics_handle, kRPVControllerSummaryMetricPropertyNumSubMetrics, 0,
+                        &num_sub) == kRocProfVisResultSuccess);
+            if(num_sub == 0)
+            {
+                double gfx_util = std::numeric_limits<double>::quiet_NaN();
+                rocprofvis_controller_get_double(
+                    metrics_handle, kRPVControllerSummaryMetricPropertyGpuGfxUtil, 0,
+                    &gfx_util);
+                util.push_back(gfx_util);
+            }
+            for(uint64_t i = 0; i < num_sub; i++)
+            {
+                rocprofvis_handle_t* sub_metric = nullptr;
+                REQUIRE(rocprofvis_controller_get_object(
+                            metrics_handle,
+                            kRPVControllerSummaryMetricPropertySubMetricsIndexed, i,
+                            &sub_metric) == kRocProfVisResultSuccess);
+                self(sub_metric, self, util);
+            }
+        };
+
+        auto exec_time_total = [&](rocprofvis_handle_t* metrics_handle) {
+            double total = 0;
+            rocprofvis_controller_get_double(
+                metrics_handle, kRPVControllerSummaryMetricPropertyKernelsExecTimeTotal, 0,
+                &total);
+            return total;
+        };
+
+        rocprofvis_controller_summary_metrics_t* full =
+            fetch_summary(start_ts, end_ts, false);
+        std::vector<double> full_util;
+        collect_util(full, collect_util, full_util);
+
+        uint64_t num_nodes = 0;
+        REQUIRE(rocprofvis_controller_get_uint64(
+                    full, kRPVControllerSummaryMetricPropertyNumSubMetrics, 0,
+                    &num_nodes) == kRocProfVisResultSuccess);
+        double node_total = 0;
+        for(uint64_t i = 0; i < num_nodes; i++)
+        {
+            rocprofvis_handle_t* node_metric = nullptr;
+            REQUIRE(rocprofvis_controller_get_object(
+                        full, kRPVControllerSummaryMetricPropertySubMetricsIndexed, i,
+                        &node_metric) == kRocProfVisResultSuccess);
+            node_total += exec_time_total(node_metric);
+        }
+        double trace_total = exec_time_total(full);
+        spdlog::info("Kernel time total {} over {} nodes {}", trace_total, num_nodes,
+                     node_total);
+        if(num_nodes > 0)
+        {
+            REQUIRE(std::abs(trace_total - node_total) <= trace_total * 1e-9);
+        }
+
+        double range = end_ts - start_ts;
+        rocprofvis_controller_summary_metrics_t* partial =
+            fetch_summary(start_ts + range / 3, start_ts + 2 * range / 3, true);
+        std::vector<double> partial_util;
+        collect_util(partial, collect_util, partial_util);
+        REQUIRE(partial_util.size() == full_util.size());
+        for(size_t i = 0; i < full_util.size(); i++)
+        {
+            REQUIRE((std::isnan(full_util[i]) ? std::isnan(partial_util[i])
+                                              : partial_util[i] == full_util[i]));
+        }
+        REQUIRE(exec_time_total(partial) <= trace_total);
+
+        rocprofvis_controller_summary_metric_free(partial);
+        rocprofvis_controller_summary_metric_free(full);
+    }
+
+    // Enables query telemetry, runs a summary fetch and checks the queries it recorded:
+    // per connection statistics with plans and no failures, an empty log while only
+    // failures are logged, and a slow query log once every query counts as slow.
+    // Clears and disables telemetry afterwards.
+    // Fixture Reads: m_controller
+    SECTION("Query Telemetry")
+    {
+        rocprofvis_controller_query_telemetry_t* telemetry =
+            rocprofvis_controller_query_telemetry_alloc();
+        REQUIRE(telemetry != nullptr);
+
+        rocprofvis_handle_t* summary_handle = nullptr;
+        rocprofvis_result_t  result         = rocprofvis_controller_get_object(
+            m_controller, kRPVControllerSystemSummary, 0, &summary_handle);
+        REQUIRE(result == kRocProfVisResultSuccess);
+        rocprofvis_handle_t* timeline_handle = nullptr;
+        result                               = rocprofvis_controller_get_object(
+            m_controller, kRPVControllerSystemTimeline, 0, &timeline_handle);
+        REQUIRE(result == kRocProfVisResultSuccess);
+        double start_ts = 0;
+        double end_ts   = 0;
+        REQUIRE(rocprofvis_controller_get_double(timeline_handle,
+                                                 kRPVControllerTimelineMinTimestamp, 0,
+                                                 &start_ts) == kRocProfVisResultSuccess);
+        REQUIRE(rocprofvis_controller_get_double(timeline_handle,
+                                                 kRPVControllerTimelineMaxTimestamp, 0,
+                                                 &end_ts) == kRocProfVisResultSuccess);
+
+        auto fetch_summary = [&]() {
+            rocprofvis_controller_arguments_t* args = rocprofvis_controller_arguments_alloc();
+            REQUIRE(args != nullptr);
+            REQUIRE(rocprofvis_controller_set_double(args,
+                                                     kRPVControllerSummaryArgsStartTimestamp,
+                                                     0, start_ts) == kRocProfVisResultSuccess);
+            REQUIRE(rocprofvis_controller_set_double(args,
+                                                     kRPVControllerSummaryArgsEndTimestamp, 0,
+                                                     end_ts) == kRocProfVisResultSuccess);
+            rocprofvis_controller_summary_metrics_t* metrics =
+                rocprofvis_controller_summary_metrics_alloc();
+            REQUIRE(metrics != nullptr);
+            rocprofvis_controller_future_t* future = rocprofvis_controller_future_alloc();
+            REQUIRE(future != nullptr);
+            REQUIRE(rocprofvis_controller_summary_fetch_async(
+                        m_controller, (rocprofvis_controller_summary_t*) summary_handle, args,
+                        future, metrics) == kRocProfVisResultSuccess);
+            REQUIRE(rocprofvis_controller_future_wait(future, FLT_MAX) ==
+                    kRocProfVisResultSuccess);
+            uint64_t future_result = 0;
+            REQUIRE(rocprofvis_controller_get_uint64(future, kRPVControllerFutureResult, 0,
+                                                     &future_result) ==
+                    kRocProfVisResultSuccess);
+            REQUIRE(future_result == kRocProfVisResultSuccess);
+            rocprofvis_controller_future_free(future);
+            rocprofvis_controller_summary_metric_free(metrics);
+            rocprofvis_controller_arguments_free(args);
+        };
+        auto get_string = [&](rocprofvis_property_t property, uint64_t index) {
+            uint32_t length = 0;
+            REQUIRE(rocprofvis_controller_get_string(telemetry, property, index, nullptr,
+                                                     &length) == kRocProfVisResultSuccess);
+            std::string value(length, '\0');
+            if(length > 0)
+            {
+                REQUIRE(rocprofvis_controller_get_string(telemetry, property, index,
+                                                         &value[0], &length) ==
+                        kRocProfVisResultSuccess);
+            }
+            return value;
+        };
+
+        // Nothing is recorded while telemetry is off
+        result = rocprofvis_controller_query_telemetry_clear(m_controller);
+        REQUIRE(result == kRocProfVisResultSuccess);
+        fetch_summary();
+        uint64_t num_queries = 0;
+        REQUIRE(rocprofvis_controller_query_telemetry_fetch(m_controller, telemetry) ==
+                kRocProfVisResultSuccess);
+        REQUIRE(rocprofvis_controller_get_uint64(
+                    telemetry, kRPVControllerQueryTelemetryNumQueries, 0, &num_queries) ==
+                kRocProfVisResultSuccess);
+        REQUIRE(num_queries == 0);
+
+        // Threshold 0 logs failed queries only
+        result = rocprofvis_controller_set_query_telemetry(m_controller, 1, 0.0);
+        REQUIRE(result == kRocProfVisResultSuccess);
+        fetch_summary();
+        REQUIRE(rocprofvis_controller_query_telemetry_fetch(m_controller, telemetry) ==
+                kRocProfVisResultSuccess);
+        REQUIRE(rocprofvis_controller_get_uint64(
+                    telemetry, kRPVControllerQueryTelemetryNumQueries, 0, &num_queries) ==
+                kRocProfVisResultSuccess);
+        REQUIRE(num_queries > 0);
+        spdlog::info("Query templates recorded: {0}", num_queries);
+
+        uint64_t num_logged = 0;
+        REQUIRE(rocprofvis_controller_get_uint64(
+                    telemetry, kRPVControllerQueryTelemetryNumSlowQueries, 0, &num_logged) ==
+                kRocProfVisResultSuccess);
+        REQUIRE(num_logged == 0);
+
+        uint64_t num_plans     = 0;
+        double   previous_time = DBL_MAX;
+        for(uint64_t i = 0; i < num_queries; i++)
+        {
+            std::string query_template =
+                get_string(kRPVControllerQueryTelemetryQueryTemplateIndexed, i);
+            REQUIRE(!query_template.empty());
+
+            // Labels name the connection: "<database file>#<connection number>"
+            std::string connection =
+                get_string(kRPVControllerQueryTelemetryQueryConnectionIndexed, i);
+            size_t hash = connection.rfind('#');
+            REQUIRE(hash != std::string::npos);
+            REQUIRE(hash + 1 < connection.size());
+            REQUIRE(connection.find_first_not_of("0123456789", hash + 1) ==
+                    std::string::npos);
+
+            num_plans += get_string(kRPVControllerQueryTelemetryQueryPlanIndexed, i).empty()
+                             ? 0
+                             : 1;
+
+            uint64_t count    = 0;
+            uint64_t failures = 0;
+            REQUIRE(rocprofvis_controller_get_uint64(
+                        telemetry, kRPVControllerQueryTelemetryQueryCountIndexed, i,
+                        &count) == kRocProfVisResultSuccess);
+            REQUIRE(rocprofvis_controller_get_uint64(
+                        telemetry, kRPVControllerQueryTelemetryQueryFailuresIndexed, i,
+                        &failures) == kRocProfVisResultSuccess);
+            REQUIRE(count > 0);
+            REQUIRE(failures == 0);
+
+            double total_time = 0;
+            double max_time   = 0;
+            REQUIRE(rocprofvis_controller_get_double(
+                        telemetry, kRPVControllerQueryTelemetryQueryTotalTimeIndexed, i,
+                        &total_time) == kRocProfVisResultSuccess);
+            REQUIRE(rocprofvis_controller_get_double(
+                        telemetry, kRPVControllerQueryTelemetryQueryMaxTimeIndexed, i,
+                        &max_time) == kRocProfVisResultSuccess);
+            REQUIRE(max_time <= total_time);
+            REQUIRE(total_time <= previous_time);
+            previous_time = total_time;
+        }
+        REQUIRE(num_plans > 0);
+
+        uint64_t num_queries_out_of_range = 0;
+        result = rocprofvis_controller_get_uint64(
+            telemetry, kRPVControllerQueryTelemetryQueryCountIndexed, num_queries,
+            &num_queries_out_of_range);
+        REQUIRE(result == kRocProfVisResultOutOfRange);
+
+        // With a tiny threshold every execution of the next fetch is logged as slow
+        result = rocprofvis_controller_query_telemetry_clear(m_controller);
+        REQUIRE(result == kRocProfVisResultSuccess);
+        result = rocprofvis_controller_set_query_telemetry(m_controller, 1, 1e-9);
+        REQUIRE(result == kRocProfVisResultSuccess);
+        fetch_summary();
+        REQUIRE(rocprofvis_controller_query_telemetry_fetch(m_controller, telemetry) ==
+                kRocProfVisResultSuccess);
+        REQUIRE(rocprofvis_controller_get_uint64(
+                    telemetry, kRPVControllerQueryTelemetryNumQueries, 0, &num_queries) ==
+                kRocProfVisResultSuccess);
+        uint64_t total_count = 0;
+        for(uint64_t i = 0; i < num_queries; i++)
+        {
+            uint64_t count = 0;
+            REQUIRE(rocprofvis_controller_get_uint64(
+                        telemetry, kRPVControllerQueryTelemetryQueryCountIndexed, i,
+                        &count) == kRocProfVisResultSuccess);
+            total_count += count;
+        }
+        REQUIRE(rocprofvis_controller_get_uint64(
+                    telemetry, kRPVControllerQueryTelemetryNumSlowQueries, 0, &num_logged) ==
+                kRocProfVisResultSuccess);
+        // The log keeps the newest 256 entries
+        REQUIRE(total_count > 0);
+        REQUIRE(num_logged == std::min<uint64_t>(total_count, 256));
+        for(uint64_t i = 0; i < num_logged; i++)
+        {
+            REQUIRE(!get_string(kRPVControllerQueryTelemetrySlowQueryTextIndexed, i).empty());
+            REQUIRE(get_string(kRPVControllerQueryTelemetrySlowQueryErrorIndexed, i).empty());
+            double duration = 0;
+            REQUIRE(rocprofvis_controller_get_double(
+                        telemetry, kRPVControllerQueryTelemetrySlowQueryTimeIndexed, i,
+                        &duration) == kRocProfVisResultSuccess);
+            REQUIRE(duration >= 1e-9);
+        }
+
+        result = rocprofvis_controller_query_telemetry_clear(m_controller);
+        REQUIRE(result == kRocProfVisResultSuccess);
+        result = rocprofvis_controller_query_telemetry_fetch(m_controller, telemetry);
+        REQUIRE(result == kRocProfVisResultSuccess);
+        result = rocprofvis_controller_get_uint64(
+            telemetry, kRPVControllerQueryTelemetryNumQueries, 0, &num_queries);
+        REQUIRE(result == kRocProfVisResultSuccess);
+        REQUIRE(num_queries == 0);
+
+        result = rocprofvis_controller_set_query_telemetry(m_controller, 0, 0.0);
+        REQUIRE(result == kRocProfVisResultSuccess);
+
+        rocprofvis_controller_query_telemetry_free(telemetry);
+    }
+
+    // Fetches extended event data with lock statistics off and on and validates the
+    // recorded sites: keyed once per function, class and mode, counts match the
+    // histograms and sites are ordered by total wait. Reset and disable stop recording.
+    // Fixture Reads: m_controller
+    SECTION("Lock Statistics")
+    {
+        rocprofvis_controller_lock_stats_t* lock_stats = rocprofvis_controller_lock_stats_alloc();
+        REQUIRE(lock_stats != nullptr);
+
+        uint64_t            num_tracks = 0;
+        rocprofvis_result_t result     = rocprofvis_controller_get_uint64(
+            m_controller, kRPVControllerSystemNumTracks, 0, &num_tracks);
+        REQUIRE(result == kRocProfVisResultSuccess);
+
+        uint64_t event_id = 0;
+        bool     found    = false;
+        for(uint32_t ti = 0; ti < num_tracks && !found; ti++)
+        {
+            uint64_t num_entries = 0;
+            if(m_track_data[ti] != nullptr &&
+               rocprofvis_controller_get_uint64(m_track_data[ti],
+                                                kRPVControllerArrayNumEntries, 0,
+                                                &num_entries) == kRocProfVisResultSuccess &&
+               num_entries > 0)
+            {
+                rocprofvis_handle_t* entry = nullptr;
+                REQUIRE(rocprofvis_controller_get_object(m_track_data[ti],
+                                                         kRPVControllerArrayEntryIndexed, 0,
+                                                         &entry) == kRocProfVisResultSuccess);
+                found = rocprofvis_controller_get_uint64(entry, kRPVControllerEventId, 0,
+                                                         &event_id) == kRocProfVisResultSuccess;
+            }
+        }
+        REQUIRE(found);
+
+        // Reading extended data locks the data model trace and event property tables
+        auto fetch_ext_data = [&]() {
+            rocprofvis_controller_future_t* future = rocprofvis_controller_future_alloc();
+            REQUIRE(future != nullptr);
+            rocprofvis_controller_array_t* array = rocprofvis_controller_array_alloc(0);
+            REQUIRE(array != nullptr);
+            REQUIRE(rocprofvis_controller_get_indexed_property_async(
+                        m_controller, m_controller, kRPVControllerSystemEventDataExtDataIndexed,
+                        event_id, 1, future, array) == kRocProfVisResultSuccess);
+            REQUIRE(rocprofvis_controller_future_wait(future, FLT_MAX) ==
+                    kRocProfVisResultSuccess);
+            rocprofvis_controller_array_free(array);
+            rocprofvis_controller_future_free(future);
+        };
+        auto fetch_num_sites = [&]() {
+            uint64_t num_sites = 0;
+            REQUIRE(rocprofvis_controller_lock_stats_fetch(lock_stats) ==
+                    kRocProfVisResultSuccess);
+            REQUIRE(rocprofvis_controller_get_uint64(lock_stats, kRPVControllerLockStatsNumSites,
+                                                     0, &num_sites) == kRocProfVisResultSuccess);
+            return num_sites;
+        };
+        auto get_string = [&](rocprofvis_property_t property, uint64_t index) {
+            uint32_t length = 0;
+            REQUIRE(rocprofvis_controller_get_string(lock_stats, property, index, nullptr,
+                                                     &length) == kRocProfVisResultSuccess);
+            std::string value(length, '\0');
+            if(length > 0)
+            {
+                REQUIRE(rocprofvis_controller_get_string(lock_stats, property, index,
+                                                         &value[0], &length) ==
+                        kRocProfVisResultSuccess);
+            }
+            return value;
+        };
+        auto get_uint64 = [&](rocprofvis_property_t property, uint64_t index) {
+            uint64_t value = 0;
+            REQUIRE(rocprofvis_controller_get_uint64(lock_stats, property, index, &value) ==
+                    kRocProfVisResultSuccess);
+            return value;
+        };
+
+        // Statistics are off by default
+        REQUIRE(rocprofvis_controller_lock_stats_reset() == kRocProfVisResultSuccess);
+        fetch_ext_data();
+        REQUIRE(fetch_num_sites() == 0);
+
+        REQUIRE(rocprofvis_controller_set_lock_stats(1) == kRocProfVisResultSuccess);
+        REQUIRE(rocprofvis_controller_lock_stats_reset() == kRocProfVisResultSuccess);
+        fetch_ext_data();
+        uint64_t num_sites = fetch_num_sites();
+        REQUIRE(num_sites > 0);
+        uint64_t num_buckets = get_uint64(kRPVControllerLockStatsNumHistogramBuckets, 0);
+        REQUIRE(num_buckets > 0);
+        spdlog::info("Lock sites recorded: {0}", num_sites);
+
+        std::set<std::tuple<std::string, std::string, uint64_t>> sites;
+        uint64_t previous_wait = UINT64_MAX;
+        for(uint64_t i = 0; i < num_sites; i++)
+        {
+            std::string function    = get_string(kRPVControllerLockStatsFunctionIndexed, i);
+            std::string owner_class = get_string(kRPVControllerLockStatsOwnerClassIndexed, i);
+            uint64_t    shared      = get_uint64(kRPVControllerLockStatsSharedIndexed, i);
+            REQUIRE(!function.empty());
+            REQUIRE(shared <= 1);
+            REQUIRE(sites.insert({ function, owner_class, shared }).second);
+
+            uint64_t count      = get_uint64(kRPVControllerLockStatsCountIndexed, i);
+            uint64_t contended  = get_uint64(kRPVControllerLockStatsContendedIndexed, i);
+            uint64_t total_wait = get_uint64(kRPVControllerLockStatsTotalWaitIndexed, i);
+            uint64_t max_wait   = get_uint64(kRPVControllerLockStatsMaxWaitIndexed, i);
+            uint64_t total_hold = get_uint64(kRPVControllerLockStatsTotalHoldIndexed, i);
+            uint64_t max_hold   = get_uint64(kRPVControllerLockStatsMaxHoldIndexed, i);
+            REQUIRE(count > 0);
+            REQUIRE(contended <= count);
+            REQUIRE(max_wait <= total_wait);
+            REQUIRE(max_hold <= total_hold);
+            REQUIRE(total_wait <= previous_wait);
+            previous_wait = total_wait;
+
+            // Every acquisition lands in one wait bucket, every release in one hold bucket
+            uint64_t waits = 0;
+            uint64_t holds = 0;
+            for(uint64_t b = 0; b < num_buckets; b++)
+            {
+                waits += get_uint64(kRPVControllerLockStatsWaitHistogramIndexed,
+                                    i * num_buckets + b);
+                holds += get_uint64(kRPVControllerLockStatsHoldHistogramIndexed,
+                                    i * num_buckets + b);
+            }
+            REQUIRE(waits == count);
+            REQUIRE(holds <= count);
+        }
+
+        uint64_t out_of_range = 0;
+        result = rocprofvis_controller_get_uint64(
+            lock_stats, kRPVControllerLockStatsCountIndexed, num_sites, &out_of_range);
+        REQUIRE(result == kRocProfVisResultOutOfRange);
+
+        REQUIRE(rocprofvis_controller_lock_stats_reset() == kRocProfVisResultSuccess);
+        REQUIRE(fetch_num_sites() == 0);
+
+        REQUIRE(rocprofvis_controller_set_lock_stats(0) == kRocProfVisResultSuccess);
+        fetch_ext_data();
+        REQUIRE(fetch_num_sites() == 0);
+
+        rocprofvis_controller_lock_stats_free(lock_stats);
+    }
+
+    // Fetches the trace memory report asynchronously and validates its layout: the
+    // trace entry comes first, parents precede and include their children, the data
+    // model lists every memory category and the controller counts every track.
+    // Fixture Reads: m_controller
+    SECTION("Memory Report")
+    {
+        struct Entry
+        {
+            std::string name;
+            uint64_t    parent;
+            uint64_t    bytes;
+            uint64_t    items;
+        };
+        auto read_report = [&](rocprofvis_controller_memory_report_t* report) {
+            uint64_t num_entries = 0;
+            REQUIRE(rocprofvis_controller_get_uint64(report, kRPVControllerMemoryReportNumEntries,
+                                                     0, &num_entries) ==
+                    kRocProfVisResultSuccess);
+            std::vector<Entry> entries(num_entries);
+            for(uint64_t i = 0; i < num_entries; i++)
+            {
+                uint32_t length = 0;
+                REQUIRE(rocprofvis_controller_get_string(report,
+                                                         kRPVControllerMemoryReportNameIndexed,
+                                                         i, nullptr, &length) ==
+                        kRocProfVisResultSuccess);
+                REQUIRE(length > 0);
+                entries[i].name.resize(length);
+                REQUIRE(rocprofvis_controller_get_string(
+                            report, kRPVControllerMemoryReportNameIndexed, i,
+                            &entries[i].name[0], &length) == kRocProfVisResultSuccess);
+                REQUIRE(rocprofvis_controller_get_uint64(
+                            report, kRPVControllerMemoryReportParentIndexed, i,
+                            &entries[i].parent) == kRocProfVisResultSuccess);
+                REQUIRE(rocprofvis_controller_get_uint64(
+                            report, kRPVControllerMemoryReportBytesIndexed, i,
+                            &entries[i].bytes) == kRocProfVisResultSuccess);
+                REQUIRE(rocprofvis_controller_get_uint64(
+                            report, kRPVControllerMemoryReportItemsIndexed, i,
+                            &entries[i].items) == kRocProfVisResultSuccess);
+            }
+            return entries;
+        };
+        auto children_of = [](std::vector<Entry> const& entries, uint64_t parent) {
+            std::vector<uint64_t> children;
+            for(uint64_t i = 0; i < entries.size(); i++)
+            {
+                if(entries[i].parent == parent)
+                {
+                    children.push_back(i);
+                }
+            }
+            return children;
+        };
+        auto find_child = [&](std::vector<Entry> const& entries, uint64_t parent,
+                              const char* name) {
+            for(uint64_t child : children_of(entries, parent))
+            {
+                if(entries[child].name == name)
+                {
+                    return child;
+                }
+            }
+            return UINT64_MAX;
+        };
+
+        rocprofvis_controller_memory_report_t* report =
+            rocprofvis_controller_memory_report_alloc();
+        REQUIRE(report != nullptr);
+        rocprofvis_controller_future_t* future = rocprofvis_controller_future_alloc();
+        REQUIRE(future != nullptr);
+        REQUIRE(rocprofvis_controller_memory_report_fetch_async(m_controller, future, report) ==
+                kRocProfVisResultSuccess);
+        REQUIRE(rocprofvis_controller_future_wait(future, FLT_MAX) == kRocProfVisResultSuccess);
+        uint64_t future_result = 0;
+        REQUIRE(rocprofvis_controller_get_uint64(future, kRPVControllerFutureResult, 0,
+                                                 &future_result) == kRocProfVisResultSuccess);
+        REQUIRE(future_result == kRocProfVisResultSuccess);
+        std::vector<Entry> entries = read_report(report);
+        REQUIRE(entries.size() > 1);
+
+        // Tree: one root, parents first, sizes include the children
+        std::vector<uint64_t> child_bytes(entries.size(), 0);
+        std::vector<uint64_t> child_items(entries.size(), 0);
+        for(uint64_t i = 0; i < entries.size(); i++)
+        {
+            if(i == 0)
+            {
+                REQUIRE(entries[i].parent == UINT64_MAX);
+            }
+            else
+            {
+                REQUIRE(entries[i].parent < i);
+                child_bytes[entries[i].parent] += entries[i].bytes;
+                child_items[entries[i].parent] += entries[i].items;
+            }
+        }
+        for(uint64_t i = 0; i < entries.size(); i++)
+        {
+            REQUIRE(child_bytes[i] <= entries[i].bytes);
+            REQUIRE(child_items[i] <= entries[i].items);
+        }
+        REQUIRE(entries[0].bytes > 0);
+        REQUIRE(entries[0].name.find_first_of("/\\") == std::string::npos);
+
+        // The data model lists every category in order, events are broken down per
+        // track with tracks without loaded data left out, the string table is never empty
+        uint64_t model = find_child(entries, 0, "Data model");
+        REQUIRE(model != UINT64_MAX);
+        std::vector<uint64_t> categories = children_of(entries, model);
+        const std::vector<std::string> category_names = {
+            "Events", "Samples", "Flow traces", "Stack traces", "Extended data", "Tables", "Strings"
+        };
+        REQUIRE(categories.size() == category_names.size());
+        for(size_t i = 0; i < categories.size(); i++)
+        {
+            REQUIRE(entries[categories[i]].name == category_names[i]);
+        }
+        uint64_t events = categories[0];
+        for(uint64_t track : children_of(entries, events))
+        {
+            REQUIRE(entries[track].bytes > 0);
+        }
+        REQUIRE(child_items[events] == entries[events].items);
+        REQUIRE(entries[categories[6]].items > 0);
+        REQUIRE(entries[categories[6]].bytes > 0);
+
+        // The controller counts every track and holds the loaded events in its pool,
+        // the database reports its caches
+        uint64_t num_tracks = 0;
+        REQUIRE(rocprofvis_controller_get_uint64(m_controller, kRPVControllerSystemNumTracks, 0,
+                                                 &num_tracks) == kRocProfVisResultSuccess);
+        uint64_t controller = find_child(entries, 0, "Controller");
+        REQUIRE(controller != UINT64_MAX);
+        uint64_t tracks = find_child(entries, controller, "Tracks");
+        REQUIRE(tracks != UINT64_MAX);
+        REQUIRE(entries[tracks].items == num_tracks);
+        uint64_t event_pool = find_child(entries, controller, "Event pool");
+        REQUIRE(event_pool != UINT64_MAX);
+        REQUIRE(entries[event_pool].items > 0);
+        uint64_t database = find_child(entries, 0, "Database");
+        REQUIRE(database != UINT64_MAX);
+        REQUIRE(entries[database].bytes > 0);
+
+        uint64_t trace_budget = 0;
+        uint64_t total_budget = 0;
+        REQUIRE(rocprofvis_controller_get_uint64(report, kRPVControllerMemoryReportTraceBudget,
+                                                 0, &trace_budget) == kRocProfVisResultSuccess);
+        REQUIRE(rocprofvis_controller_get_uint64(report, kRPVControllerMemoryReportTotalBudget,
+                                                 0, &total_budget) == kRocProfVisResultSuccess);
+        REQUIRE(total_budget > 0);
+        REQUIRE(trace_budget <= total_budget);
+
+        // The synchronous fetch builds the same tree
+        REQUIRE(rocprofvis_controller_memory_report_fetch(m_controller, report) ==
+                kRocProfVisResultSuccess);
+        std::vector<Entry> sync_entries = read_report(report);
+        REQUIRE(sync_entries.size() == entries.size());
+        for(uint64_t i = 0; i < entries.size(); i++)
+        {
+            REQUIRE(sync_entries[i].name == entries[i].name);
+            REQUIRE(sync_entries[i].parent == entries[i].parent);
+        }
+
+        rocprofvis_controller_future_free(future);
+        rocprofvis_controller_memory_report_free(report);
+    }
+
     // Swaps two graph entries in the timeline, verifies the reorder by reading back
     // the graph IDs, then restores the original order.
     // Fixture Reads: m_controller
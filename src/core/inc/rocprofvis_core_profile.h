@@ -5,7 +5,9 @@
 #pragma once
 
 #include "rocprofvis_core_assert.h"
+#include <atomic>
 #include <chrono>
+#include <string>
 
 namespace RocProfVis
 {
@@ -31,5 +33,77 @@ private:
 #define PROFILE_PROP_ACCESS(property, index)
 #endif
 
+// Runtime self-profiling. Zones and counters are always compiled in and cost a
+// single relaxed load while capture is off. Each thread records into its own ring
+// buffer, so the newest events are kept when a capture runs for a long time. A
+// thread's buffer goes to the next new thread once it exits.
+// Names and categories must outlive the capture (string literals).
+class Profiler
+{
+public:
+    // Events kept per thread before the oldest are overwritten
+    static constexpr size_t EVENTS_PER_THREAD = 16384;
+
+    static bool IsEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+    static void SetEnabled(bool enabled);
+
+    // Drops every recorded event and frees the buffers of exited threads, names of
+    // running threads are kept
+    static void Clear();
+
+    // Names the calling thread in exported captures
+    static void SetThreadName(const std::string& name);
+
+    // Nanoseconds on the capture clock
+    static uint64_t Now();
+
+    static void RecordZone(const char* category, const char* name, uint64_t start_ns,
+                           uint64_t end_ns);
+    static void RecordCounter(const char* name, double value);
+
+    // Writes the recorded events as Chrome trace JSON, returns false if the file
+    // could not be written
+    static bool ExportChromeTrace(const std::string& path);
+
+private:
+    static std::atomic<bool> s_enabled;
+};
+
+class ProfileZone
+{
+public:
+    ProfileZone(const char* category, const char* name)
+    : m_category(category)
+    , m_name(Profiler::IsEnabled() ? name : nullptr)
+    , m_start_ns(m_name ? Profiler::Now() : 0)
+    {}
+    ~ProfileZone()
+    {
+        if(m_name)
+        {
+            Profiler::RecordZone(m_category, m_name, m_start_ns, Profiler::Now());
+        }
+    }
+
+private:
+    const char* m_category;
+    const char* m_name;
+    uint64_t    m_start_ns;
+};
+
+#define PROFILE_ZONE_CONCAT_INNER(a, b) a##b
+#define PROFILE_ZONE_CONCAT(a, b) PROFILE_ZONE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(category, name)                                                     \
+    RocProfVis::Core::ProfileZone PROFILE_ZONE_CONCAT(profile_zone_, __LINE__)(category, \
+                                                                               name)
+#define PROFILE_COUNTER(name, value)                                                     \
+    do                                                                                   \
+    {                                                                                    \
+        if(RocProfVis::Core::Profiler::IsEnabled())                                      \
+        {                                                                                \
+            RocProfVis::Core::Profiler::RecordCounter(name, static_cast<double>(value)); \
+        }                                                                                \
+    } while(0)
+
 }  // namespace Core
 }  // namespace RocProfVis
\ No newline at end of file
@@ -4,6 +4,13 @@
 #include "rocprofvis_core_profile.h"
 #include "rocprofvis_core.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 namespace RocProfVis
 {
 namespace Core
@@ -35,5 +42,307 @@ TimeRecorder::~TimeRecorder() {
 
 #endif
 
+namespace
+{
+
+enum class ProfileEventType : uint8_t
+{
+    kZone,
+    kCounter
+};
+
+struct ProfileEvent
+{
+    const char* category;
+    const char* name;
+    uint64_t    start_ns;
+    union
+    {
+        uint64_t duration_ns;
+        double   value;
+    };
+    ProfileEventType type;
+};
+
+// Only the owning thread writes, the mutex is uncontended unless a capture is
+// being exported or cleared at the same time.
+struct ThreadBuffer
+{
+    std::mutex                mutex;
+    std::vector<ProfileEvent> events;
+    size_t                    next         = 0;
+    bool                      wrapped      = false;
+    uint32_t                  thread_index = 0;
+    std::string               thread_name;
+};
+
+struct ProfilerState
+{
+    std::mutex                                 mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    // Buffers of exited threads, handed to the next new thread
+    std::vector<std::shared_ptr<ThreadBuffer>> free_buffers;
+    uint32_t                                   next_thread_index = 1;
+    std::chrono::steady_clock::time_point      epoch = std::chrono::steady_clock::now();
+};
+
+// Function local so that static workers (e.g. the controller job system) can record
+// during static initialization
+ProfilerState&
+GetState()
+{
+    static ProfilerState state;
+    return state;
+}
+
+// Set once the calling thread has returned its buffer, later records are dropped
+thread_local bool t_buffer_returned = false;
+
+// Returns the buffer to the free list when its thread exits. Threads started per
+// request (e.g. slice fetches) then reuse a few buffers instead of adding one each.
+struct ThreadBufferLease
+{
+    std::shared_ptr<ThreadBuffer> buffer;
+
+    ~ThreadBufferLease()
+    {
+        t_buffer_returned = true;
+        if(buffer)
+        {
+            ProfilerState&              state = GetState();
+            std::lock_guard<std::mutex> lock(state.mutex);
+            state.free_buffers.push_back(std::move(buffer));
+        }
+    }
+};
+
+// Buffers are shared with the state so events survive thread exit, nullptr while
+// the thread is exiting
+ThreadBuffer*
+GetThreadBuffer()
+{
+    if(t_buffer_returned)
+    {
+        return nullptr;
+    }
+    thread_local ThreadBufferLease lease;
+    if(!lease.buffer)
+    {
+        ProfilerState&              state = GetState();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if(!state.free_buffers.empty())
+        {
+            // Events of the exited thread stay until the ring overwrites them
+            lease.buffer = std::move(state.free_buffers.back());
+            state.free_buffers.pop_back();
+            std::lock_guard<std::mutex> buffer_lock(lease.buffer->mutex);
+            lease.buffer->thread_name.clear();
+        }
+        else
+        {
+            lease.buffer               = std::make_shared<ThreadBuffer>();
+            lease.buffer->thread_index = state.next_thread_index++;
+            state.buffers.push_back(lease.buffer);
+        }
+    }
+    return lease.buffer.get();
+}
+
+void
+Record(const ProfileEvent& event)
+{
+    ThreadBuffer* buffer = GetThreadBuffer();
+    if(!buffer)
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(buffer->mutex);
+    if(buffer->events.empty())
+    {
+        buffer->events.resize(Profiler::EVENTS_PER_THREAD);
+    }
+    buffer->events[buffer->next] = event;
+    if(++buffer->next == buffer->events.size())
+    {
+        buffer->next    = 0;
+        buffer->wrapped = true;
+    }
+}
+
+void
+WriteJsonString(std::ofstream& out, const std::string& text)
+{
+    out << '"';
+    for(char c : text)
+    {
+        if(c == '"' || c == '\\')
+        {
+            out << '\\' << c;
+        }
+        else if(static_cast<unsigned char>(c) < 0x20)
+        {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out << escaped;
+        }
+        else
+        {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+}  // namespace
+
+std::atomic<bool> Profiler::s_enabled(false);
+
+void
+Profiler::SetEnabled(bool enabled)
+{
+    s_enabled.store(enabled, std::memory_order_relaxed);
+    spdlog::info("Self-profiling capture {}", enabled ? "started" : "stopped");
+}
+
+void
+Profiler::Clear()
+{
+    ProfilerState&              state = GetState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    // Buffers of exited threads are released, new threads allocate again
+    for(const std::shared_ptr<ThreadBuffer>& buffer : state.free_buffers)
+    {
+        state.buffers.erase(std::find(state.buffers.begin(), state.buffers.end(), buffer));
+    }
+    state.free_buffers.clear();
+    for(std::shared_ptr<ThreadBuffer>& buffer : state.buffers)
+    {
+        std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+        buffer->next    = 0;
+        buffer->wrapped = false;
+    }
+}
+
+void
+Profiler::SetThreadName(const std::string& name)
+{
+    ThreadBuffer* buffer = GetThreadBuffer();
+    if(!buffer)
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(buffer->mutex);
+    buffer->thread_name = name;
+}
+
+uint64_t
+Profiler::Now()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now() - GetState().epoch)
+                                     .count());
+}
+
+void
+Profiler::RecordZone(const char* category, const char* name, uint64_t start_ns,
+                     uint64_t end_ns)
+{
+    ProfileEvent event;
+    event.category    = category;
+    event.name        = name;
+    event.start_ns    = start_ns;
+    event.duration_ns = end_ns - start_ns;
+    event.type        = ProfileEventType::kZone;
+    Record(event);
+}
+
+void
+Profiler::RecordCounter(const char* name, double value)
+{
+    ProfileEvent event;
+    event.category = "counter";
+    event.name     = name;
+    event.start_ns = Now();
+    event.value    = value;
+    event.type     = ProfileEventType::kCounter;
+    Record(event);
+}
+
+bool
+Profiler::ExportChromeTrace(const std::string& path)
+{
+    std::ofstream out(path, std::ios::binary);
+    if(!out)
+    {
+        spdlog::error("Failed to open self-profiling capture for writing: {}", path);
+        return false;
+    }
+
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        ProfilerState&              state = GetState();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        buffers = state.buffers;
+    }
+
+    // Chrome trace timestamps are microseconds
+    char   number[64];
+    size_t event_count = 0;
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    for(std::shared_ptr<ThreadBuffer>& buffer : buffers)
+    {
+        std::vector<ProfileEvent> events;
+        std::string               thread_name;
+        {
+            std::lock_guard<std::mutex> lock(buffer->mutex);
+            if(buffer->wrapped)
+            {
+                events.assign(buffer->events.begin() + buffer->next, buffer->events.end());
+            }
+            events.insert(events.end(), buffer->events.begin(),
+                          buffer->events.begin() + buffer->next);
+            thread_name = buffer->thread_name.empty()
+                              ? "Thread " + std::to_string(buffer->thread_index)
+                              : buffer->thread_name;
+        }
+
+        out << (event_count++ ? ",\n" : "\n")
+            << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+            << buffer->thread_index << ",\"args\":{\"name\":";
+        WriteJsonString(out, thread_name);
+        out << "}}";
+
+        for(const ProfileEvent& event : events)
+        {
+            out << ",\n{\"name\":";
+            WriteJsonString(out, event.name);
+            out << ",\"cat\":";
+            WriteJsonString(out, event.category);
+            std::snprintf(number, sizeof(number), "%.3f", event.start_ns / 1000.0);
+            out << ",\"pid\":1,\"tid\":" << buffer->thread_index << ",\"ts\":" << number;
+            if(event.type == ProfileEventType::kZone)
+            {
+                std::snprintf(number, sizeof(number), "%.3f", event.duration_ns / 1000.0);
+                out << ",\"ph\":\"X\",\"dur\":" << number << "}";
+            }
+            else
+            {
+                std::snprintf(number, sizeof(number), "%.17g", event.value);
+                out << ",\"ph\":\"C\",\"args\":{\"value\":" << number << "}}";
+            }
+            event_count++;
+        }
+    }
+    out << "\n]}\n";
+
+    if(!out)
+    {
+        spdlog::error("Failed to write self-profiling capture: {}", path);
+        return false;
+    }
+    spdlog::info("Wrote {} self-profiling events to {}", event_count, path);
+    return true;
+}
+
 }  // namespace Core
 }  // namespace RocProfVis
\ No newline at end of file
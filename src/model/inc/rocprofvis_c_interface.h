@@ -57,6 +57,7 @@ rocprofvis_dm_result_t  rocprofvis_dm_get_property_as_double(
                                     ); 
 
 // Method to get object property value as char*. Value is returned as pointer reference.
+// Text of numeric table cells is only valid until the next numeric cell read on the same thread.
 rocprofvis_dm_result_t  rocprofvis_dm_get_property_as_charptr(
                                     rocprofvis_dm_handle_t,                 // object handle	
                                     rocprofvis_dm_property_t,               // property enumeration
@@ -65,6 +65,47 @@ rocprofvis_dm_database_t rocprofvis_db_open_database_multi(
 rocprofvis_dm_size_t rocprofvis_db_get_memory_footprint(
                                     rocprofvis_dm_database_t);
 
+/****************************************************************************************************
+ * @brief Enables or disables per-query telemetry collection. Disabled by default.
+ * 
+ * @param database database handle
+ * @param enabled true to collect query statistics and plans
+ * @param slow_query_ms queries taking at least this many milliseconds are logged, 0 logs failed queries only
+ * @return status of operation
+ * 
+ ***************************************************************************************************/
+rocprofvis_dm_result_t rocprofvis_db_set_query_telemetry(
+                                    rocprofvis_dm_database_t,
+                                    bool,
+                                    double);
+
+/****************************************************************************************************
+ * @brief Reports collected query telemetry. Statistics are ordered by total time descending,
+ *        slow and failed queries oldest first.
+ * 
+ * @param database database handle
+ * @param stats_callback called once per query template and connection, may be null
+ * @param slow_query_callback called once per slow or failed query log entry, may be null
+ * @param user_data passed to both callbacks
+ * @return status of operation
+ * 
+ ***************************************************************************************************/
+rocprofvis_dm_result_t rocprofvis_db_get_query_telemetry(
+                                    rocprofvis_dm_database_t,
+                                    rocprofvis_db_query_stats_callback_t,
+                                    rocprofvis_db_slow_query_callback_t,
+                                    void* user_data);
+
+/****************************************************************************************************
+ * @brief Drops collected query statistics and the slow query log
+ * 
+ * @param database database handle
+ * @return status of operation
+ * 
+ ***************************************************************************************************/
+rocprofvis_dm_result_t rocprofvis_db_clear_query_telemetry(
+                                    rocprofvis_dm_database_t);
+
 /****************************************************************************************************
  * @brief Allocates future object, to be used for asynchronous operations
  * 
@@ -257,7 +298,10 @@ rocprofvis_dm_result_t rocprofvis_db_trim_save_async(rocprofvis_dm_database_t da
  * @param object future handle allocated by rocprofvis_db_future_alloc
  * @return status of operation
  *
- * @note Object will stay in trace memory until deleted.
+ * @note Object stays in trace event property cache until deleted or evicted as least recently used.
+ *          Future resolves immediately if property is already cached and waits for property
+ *          still being loaded by another request.
+ *          Property handle is obtained with rocprofvis_dm_pin_event_property.
  *          Use rocprofvis_dm_delete_event_property_for or
  *          rocprofvis_dm_delete_all_event_properties_for for deletion
  ***************************************************************************************************/
@@ -267,6 +311,82 @@ rocprofvis_dm_result_t  rocprofvis_db_read_event_property_async(
                                     rocprofvis_dm_event_id_t,
                                     rocprofvis_db_future_t);
 
+/****************************************************************************************************
+ * @brief Asynchronous call to prefetch extended data, flow trace and stack trace of multiple events
+ *
+ * @param database database handle
+ * @param num number of event ids
+ * @param event_ids array of 60-bit event ids and 4-bit operation types
+ * @param object future handle allocated by rocprofvis_db_future_alloc
+ * @return status of operation
+ *
+ * @note Properties of all events are loaded by a single request into trace event property cache,
+ *          already cached properties and properties being loaded by another request are skipped.
+ *          Number of events is limited by cache capacity.
+ *          Properties are then accessed with rocprofvis_db_read_event_property_async, which
+ *          resolves immediately for cached ones.
+ ***************************************************************************************************/
+rocprofvis_dm_result_t  rocprofvis_db_read_event_properties_async(
+                                    rocprofvis_dm_database_t,
+                                    uint64_t,
+                                    const rocprofvis_dm_event_id_t*,
+                                    rocprofvis_db_future_t);
+
+/****************************************************************************************************
+ * @brief Asynchronous call to read all flow edges for provided time frame and tracks selection
+ *
+ * @param database database handle
+ * @param start begining of the time frame
+ * @param end end of the time frame
+ * @param num number of tracks in rocprofvis_db_track_selection_t array (uint32*), 0 for all tracks
+ * @param tracks tracks selection array (uint32*). Edge is selected if any of its endpoints is on selected track
+ * @param object future handle allocated by rocprofvis_db_future_alloc
+ * @return status of operation
+ *
+ * @note Edges are read from the flow index built at metadata load and stored as consecutive
+ *          origin and target endpoints of a flow trace object. The flow trace object is accessed with
+ *          kRPVDMFlowTraceHandleByEventID, using 
+ *          rocprofvis_dm_hash_combine_timestamp(start, end, kRocProfVisDmHashedTimestampTagFlowRange) as event id.
+ *          Object will stay in trace memory until deleted.
+ *          Use rocprofvis_dm_delete_event_property for deletion
+ ***************************************************************************************************/
+rocprofvis_dm_result_t  rocprofvis_db_read_flow_range_async(
+                                    rocprofvis_dm_database_t,
+                                    rocprofvis_dm_timestamp_t,
+                                    rocprofvis_dm_timestamp_t,
+                                    rocprofvis_db_num_of_tracks_t,
+                                    rocprofvis_db_track_selection_t,
+                                    rocprofvis_db_future_t);
+
+/****************************************************************************************************
+ * @brief Asynchronous call to read per-kernel statistics of kernel dispatches overlapping provided time frame
+ *
+ * @param database database handle
+ * @param start begining of the time frame
+ * @param end end of the time frame
+ * @param node_id node ID filter, KERNEL_SUMMARY_ANY_ID for all nodes
+ * @param agent_id agent ID filter, KERNEL_SUMMARY_ANY_ID for all agents
+ * @param object future handle allocated by rocprofvis_db_future_alloc
+ * @param id new id is assigned to the table and returned using this reference pointer
+ * @return status of operation, future result is kRocProfVisDmResultNotSupported 
+ *          if database has no kernel statistics
+ *
+ * @note Table has columns name, num_invocations, avg_duration, min_duration, max_duration,
+ *          total_duration and stddev_duration, rows are sorted by total_duration in descending order.
+ *          Statistics are summed from time buckets built at metadata load, dispatches of the partially
+ *          covered edge buckets are read from database.
+ *          Object will stay in trace memory until deleted.
+ *          Use rocprofvis_dm_delete_table_at or rocprofvis_dm_delete_all_tables for deletion
+ ***************************************************************************************************/
+rocprofvis_dm_result_t  rocprofvis_db_read_kernel_summary_async(
+                                    rocprofvis_dm_database_t,
+                                    rocprofvis_dm_timestamp_t,
+                                    rocprofvis_dm_timestamp_t,
+                                    uint64_t,
+                                    uint64_t,
+                                    rocprofvis_db_future_t,
+                                    rocprofvis_dm_table_id_t*);
+
 /****************************************************************************************************
  * @brief Asynchronous call to read a table result of specified SQL query
  *
@@ -309,6 +429,36 @@ rocprofvis_dm_result_t  rocprofvis_db_execute_compute_query_async(
                                   rocprofvis_db_future_t,
                                   rocprofvis_dm_table_id_t*);
 
+/************************************Data model lock statistics*************************************/
+
+/****************************************************************************************************
+ * @brief Enables or disables lock wait and hold time statistics. Disabled by default.
+ *
+ * @param enabled true to record statistics
+ *
+ ***************************************************************************************************/
+void rocprofvis_dm_set_lock_stats_enabled(bool);
+
+/****************************************************************************************************
+ * @brief Reports lock statistics of every call site which acquired a lock since the last reset,
+ *        ordered by total wait time descending. Statistics are process wide.
+ *
+ * @param callback called once per call site
+ * @param user_data passed to the callback
+ *
+ * @return status of operation
+ *
+ ***************************************************************************************************/
+rocprofvis_dm_result_t rocprofvis_dm_get_lock_stats(
+                                    rocprofvis_dm_lock_stats_callback_t,
+                                    void* user_data);
+
+/****************************************************************************************************
+ * @brief Zeroes lock statistics of every call site
+ *
+ ***************************************************************************************************/
+void rocprofvis_dm_reset_lock_stats(void);
+
 /************************************Data model trace interface*************************************/
 
 /****************************************************************************************************
@@ -387,7 +537,8 @@ rocprofvis_dm_result_t  rocprofvis_dm_delete_all_time_slices(
                                     rocprofvis_dm_trace_t);                                      
 
 /****************************************************************************************************
- * @brief Delete event property object of specified type
+ * @brief Pin loaded event property object of specified type, so it is neither evicted from
+ *        trace event property cache nor deleted while in use
  *
  * @param trace trace object handle created with rocprofvis_dm_create_trace()
  * @param type type of property
@@ -395,10 +546,49 @@ rocprofvis_dm_result_t  rocprofvis_dm_delete_all_time_slices(
  *                             kRPVDMEventStackTrace,
  *                             kRPVDMEventExtData,
  * @param event_id 60-bit event id and 4-bit operation type
+ * @param object pointer receiving property object handle
+ *
+ * @return status of operation, kRocProfVisDmResultNotLoaded if property is not cached or still loading
+ *
+ * @note Every pinned object must be released with rocprofvis_dm_unpin_event_property
+ ***************************************************************************************************/
+rocprofvis_dm_result_t  rocprofvis_dm_pin_event_property( 
+                                    rocprofvis_dm_trace_t,
+                                    rocprofvis_dm_event_property_type_t,
+                                    rocprofvis_dm_event_id_t,
+                                    rocprofvis_dm_handle_t*);
+
+/****************************************************************************************************
+ * @brief Release event property object pinned with rocprofvis_dm_pin_event_property
+ *
+ * @param trace trace object handle created with rocprofvis_dm_create_trace()
+ * @param type type of property
+ *                             kRPVDMEventFlowTrace,
+ *                             kRPVDMEventStackTrace,
+ *                             kRPVDMEventExtData,
+ * @param object property object handle
  *
  * @return status of operation
  *
  ***************************************************************************************************/
+rocprofvis_dm_result_t  rocprofvis_dm_unpin_event_property( 
+                                    rocprofvis_dm_trace_t,
+                                    rocprofvis_dm_event_property_type_t,
+                                    rocprofvis_dm_handle_t);
+
+/****************************************************************************************************
+ * @brief Delete event property object of specified type
+ *
+ * @param trace trace object handle created with rocprofvis_dm_create_trace()
+ * @param type type of property
+ *                             kRPVDMEventFlowTrace,
+ *                             kRPVDMEventStackTrace,
+ *                             kRPVDMEventExtData,
+ * @param event_id 60-bit event id and 4-bit operation type
+ *
+ * @return status of operation, kRocProfVisDmResultResourceBusy if object is pinned
+ *
+ ***************************************************************************************************/
 rocprofvis_dm_result_t  rocprofvis_dm_delete_event_property_for( 
                                     rocprofvis_dm_trace_t,
                                     rocprofvis_dm_event_property_type_t,
@@ -413,7 +603,7 @@ rocprofvis_dm_result_t  rocprofvis_dm_delete_event_property_for(
 *                             kRPVDMEventExtData,
 * @param object reference
 *
-* @return status of operation
+* @return status of operation, kRocProfVisDmResultResourceBusy if object is pinned
 *
 ***************************************************************************************************/
 rocprofvis_dm_result_t  rocprofvis_dm_delete_event_property( 
@@ -432,6 +622,7 @@ rocprofvis_dm_result_t  rocprofvis_dm_delete_event_property(
  *
  * @return status of operation
  *
+ * @note Pinned objects are not deleted
  ***************************************************************************************************/
 rocprofvis_dm_result_t  rocprofvis_dm_delete_all_event_properties_for( 
                                     rocprofvis_dm_trace_t,
@@ -464,6 +655,27 @@ rocprofvis_dm_result_t  rocprofvis_dm_delete_table_at(
 rocprofvis_dm_result_t  rocprofvis_dm_delete_all_tables( 
                                     rocprofvis_dm_trace_t);  
 
+/****************************************************************************************************
+ * @brief Reads the cells of a range of table rows as strings.
+ *        Equivalent to reading kRPVDMExtTableRowCellValueCharPtrIndexed of every cell,
+ *        but takes the table lock once and does no per cell property lookup.
+ *
+ * @param table table object handle
+ * @param first_row index of first row
+ * @param num_rows number of rows, clamped to the number of rows of the table
+ * @param callback called for every cell, row by row
+ * @param user_data passed to the callback
+ *
+ * @return status of operation
+ *
+ ***************************************************************************************************/
+rocprofvis_dm_result_t  rocprofvis_dm_get_table_cells(
+                                    rocprofvis_dm_table_t,
+                                    uint64_t,
+                                    uint64_t,
+                                    rocprofvis_dm_table_cell_callback_t,
+                                    void* user_data);
+
 /****************************************************************************************************
  * @brief Combine a (start, end) timestamp pair and a tag into a single hashed value
  *
@@ -535,6 +747,10 @@ double  rocprofvis_dm_get_property_as_double(
 
 /****************************************************************************************************
  * @brief Return property value as char*.
+ *        Strings stay valid as long as the object owning them. The exception is
+ *        kRPVDMExtTableRowCellValueCharPtrIndexed of a numeric cell: its text lives in a
+ *        per thread buffer which the next numeric cell read on the same thread overwrites,
+ *        so the caller copies it before reading another cell.
  *
  * @param handle any object handle
  * @param property enumeration of properties for specified handle type
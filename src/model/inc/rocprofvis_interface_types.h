@@ -11,6 +11,8 @@
 #define TABLE_QUERY_PACK_OP_TYPE(rocprofvis_dm_event_operation_t_op_type) (rocprofvis_dm_event_operation_t_op_type << 28)
 #define TABLE_QUERY_UNPACK_OP_TYPE(rocprofvis_dm_track_id_t_track_id) (rocprofvis_dm_track_id_t_track_id >> 28)
 #define TABLE_QUERY_UNPACK_TRACK_ID(rocprofvis_dm_track_id_t_track_id) (rocprofvis_dm_track_id_t_track_id & 0x0FFFFFFF)
+// Kernel summary node or agent filter value selecting all nodes or agents
+#define KERNEL_SUMMARY_ANY_ID UINT64_MAX
 
 /*******************************Types******************************/
 
@@ -218,8 +220,31 @@ typedef enum  rocprofvis_dm_trace_property_t {
     kRPVDStreamQueueMappingInfoTableHandleIndexed,
     // Topology handle
     kRPVDMTopologyHandle,
+    // Bytes used by a memory category, index is rocprofvis_dm_memory_category_t
+    kRPVDMTraceMemoryUsageUInt64Indexed,
+    // Number of items held by a memory category, index is rocprofvis_dm_memory_category_t
+    kRPVDMTraceMemoryItemsUInt64Indexed,
 } rocprofvis_dm_trace_property_t;
 
+// Memory accounting categories of a trace
+typedef enum rocprofvis_dm_memory_category_t {
+    // Event track slices, items are loaded events
+    kRPVDMMemoryEvents,
+    // Counter track slices, items are loaded samples
+    kRPVDMMemorySamples,
+    // Flow traces, items are flow trace objects
+    kRPVDMMemoryFlowTraces,
+    // Stack traces, items are stack trace objects
+    kRPVDMMemoryStackTraces,
+    // Extended data, items are extended data objects
+    kRPVDMMemoryExtData,
+    // Query result tables, items are table rows
+    kRPVDMMemoryTables,
+    // String table, items are strings
+    kRPVDMMemoryStrings,
+    kRPVDMNumMemoryCategories
+} rocprofvis_dm_memory_category_t;
+
 // Track properties
 typedef enum rocprofvis_dm_track_property_t {
     // Track total number of records
@@ -280,6 +305,8 @@ typedef enum rocprofvis_dm_track_property_t {
     kRPVDMTrackFileIdUInt64,
     // Track Order Ranking ID
     kRPVDMTrackOrderRankingUInt64,
+    // Number of records held by the loaded slices of the track
+    kRPVDMTrackNumLoadedRecordsUInt64,
 } rocprofvis_dm_track_property_t;
 
 // Slice properties
@@ -398,7 +425,8 @@ typedef enum rocprofvis_dm_table_property_t {
 typedef enum rocprofvis_dm_table_row_property_t {
     // Number of cells
     kRPVDMNumberOfTableRowCellsUInt64,
-    // Row cell value by specified index
+    // Row cell value by specified index. Numeric cells are formatted into a per thread
+    // buffer, overwritten by the next numeric cell read on the same thread; copy the text
     kRPVDMExtTableRowCellValueCharPtrIndexed
 } rocprofvis_dm_table_row_property_t;
 
@@ -437,6 +465,8 @@ typedef enum rocprofvis_dm_hashed_timestamp_tag_t
     kRocProfVisDmHashedTimestampTagTrackSlice = 0,
     // Controller analysis fetches
     kRocProfVisDmHashedTimestampTagAnalysis = 1,
+    // Flow edges read from the flow index for a time range
+    kRocProfVisDmHashedTimestampTagFlowRange = 2,
 } rocprofvis_dm_hashed_timestamp_tag_t;
 
 // Event id structure
@@ -464,6 +494,81 @@ typedef void ( *rocprofvis_db_progress_callback_t)(
                 void*
 );
 
+// Aggregated statistics of one query template on one connection, reported by query telemetry callback
+typedef struct rocprofvis_db_query_stats_t
+{
+    // query text with literals replaced by '?'
+    const char* query_template;
+    // database file and number of the connection the query ran on, like "trace.db#2"
+    const char* connection;
+    // EXPLAIN QUERY PLAN output captured on first successful execution
+    const char* plan;
+    uint64_t    count;
+    // executions which returned an error or were interrupted, included in count
+    uint64_t    failures;
+    double      total_ms;
+    double      max_ms;
+    uint64_t    rows;
+    uint64_t    bytes;
+} rocprofvis_db_query_stats_t;
+
+// Single query execution slower than the slow query threshold, or failed
+typedef struct rocprofvis_db_slow_query_t
+{
+    const char* query;
+    const char* connection;
+    double      duration_ms;
+    uint64_t    rows;
+    uint64_t    bytes;
+    // error message, empty if the query succeeded
+    const char* error;
+} rocprofvis_db_slow_query_t;
+
+// Query telemetry callbacks, pointers are valid for the duration of the call only
+typedef void ( *rocprofvis_db_query_stats_callback_t)(
+                const rocprofvis_db_query_stats_t*,
+                void*
+);
+typedef void ( *rocprofvis_db_slow_query_callback_t)(
+                const rocprofvis_db_slow_query_t*,
+                void*
+);
+
+// Wait and hold time statistics of one lock call site (locking function, owner class and lock mode).
+// Histogram bucket i counts durations in [2^i, 2^(i+1)) nanoseconds, the last bucket everything above.
+typedef struct rocprofvis_dm_lock_stats_t
+{
+    const char*     function;
+    const char*     owner_class;
+    // 1 for shared (reader) locks, 0 for exclusive locks
+    uint32_t        shared;
+    uint32_t        num_buckets;
+    uint64_t        count;
+    // acquisitions which waited at least 1us
+    uint64_t        contended;
+    uint64_t        total_wait_ns;
+    uint64_t        max_wait_ns;
+    uint64_t        total_hold_ns;
+    uint64_t        max_hold_ns;
+    const uint64_t* wait_histogram;
+    const uint64_t* hold_histogram;
+} rocprofvis_dm_lock_stats_t;
+
+// Lock statistics callback, pointers are valid for the duration of the call only
+typedef void ( *rocprofvis_dm_lock_stats_callback_t)(
+                const rocprofvis_dm_lock_stats_t*,
+                void*
+);
+
+// Table cell callback, called with row index, column index and cell value.
+// Value is valid for the duration of the call only
+typedef void ( *rocprofvis_dm_table_cell_callback_t)(
+                uint64_t,
+                uint64_t,
+                const char*,
+                void*
+);
+
 /*******************************Compute******************************/
 
 // Compute database query result items enumeration
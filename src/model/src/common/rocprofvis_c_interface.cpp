@@ -228,6 +228,109 @@ rocprofvis_dm_size_t rocprofvis_db_get_memory_footprint(rocprofvis_dm_database_t
     return db->GetMemoryFootprint();
 }
 
+/****************************************************************************************************
+ * @brief Enables or disables per-query telemetry collection. Disabled by default.
+ * 
+ * @param database database handle
+ * @param enabled true to collect query statistics and plans
+ * @param slow_query_ms queries taking at least this many milliseconds are logged, 0 logs failed queries only
+ * @return status of operation
+ * 
+ ***************************************************************************************************/
+rocprofvis_dm_result_t rocprofvis_db_set_query_telemetry(rocprofvis_dm_database_t database,
+                                                         bool enabled, double slow_query_ms){
+    ROCPROFVIS_ASSERT_MSG_RETURN(database,
+                                 RocProfVis::DataModel::ERROR_DATABASE_CANNOT_BE_NULL,
+                                 kRocProfVisDmResultInvalidParameter);
+    RocProfVis::DataModel::Database* db = (RocProfVis::DataModel::Database*) database;
+    RocProfVis::DataModel::QueryTelemetry* telemetry = db->GetQueryTelemetry();
+    if(telemetry == nullptr)
+    {
+        return kRocProfVisDmResultNotSupported;
+    }
+    telemetry->SetSlowQueryThreshold(slow_query_ms);
+    telemetry->SetEnabled(enabled);
+    return kRocProfVisDmResultSuccess;
+}
+
+/****************************************************************************************************
+ * @brief Reports collected query telemetry. Statistics are ordered by total time descending,
+ *        slow and failed queries oldest first.
+ * 
+ * @param database database handle
+ * @param stats_callback called once per query template and connection, may be null
+ * @param slow_query_callback called once per slow or failed query log entry, may be null
+ * @param user_data passed to both callbacks
+ * @return status of operation
+ * 
+ ***************************************************************************************************/
+rocprofvis_dm_result_t rocprofvis_db_get_query_telemetry(
+                                    rocprofvis_dm_database_t database,
+                                    rocprofvis_db_query_stats_callback_t stats_callback,
+                                    rocprofvis_db_slow_query_callback_t slow_query_callback,
+                                    void* user_data){
+    ROCPROFVIS_ASSERT_MSG_RETURN(database,
+                                 RocProfVis::DataModel::ERROR_DATABASE_CANNOT_BE_NULL,
+                                 kRocProfVisDmResultInvalidParameter);
+    RocProfVis::DataModel::Database* db = (RocProfVis::DataModel::Database*) database;
+    RocProfVis::DataModel::QueryTelemetry* telemetry = db->GetQueryTelemetry();
+    if(telemetry == nullptr)
+    {
+        return kRocProfVisDmResultNotSupported;
+    }
+    if(stats_callback != nullptr)
+    {
+        for(auto const& stats : telemetry->GetStats())
+        {
+            rocprofvis_db_query_stats_t entry = { stats.query_template.c_str(),
+                                                  stats.connection.c_str(),
+                                                  stats.plan.c_str(),
+                                                  stats.count,
+                                                  stats.failures,
+                                                  stats.total_ms,
+                                                  stats.max_ms,
+                                                  stats.rows,
+                                                  stats.bytes };
+            stats_callback(&entry, user_data);
+        }
+    }
+    if(slow_query_callback != nullptr)
+    {
+        for(auto const& query : telemetry->GetSlowQueries())
+        {
+            rocprofvis_db_slow_query_t entry = { query.query.c_str(),
+                                                 query.connection.c_str(),
+                                                 query.duration_ms,
+                                                 query.rows,
+                                                 query.bytes,
+                                                 query.error.c_str() };
+            slow_query_callback(&entry, user_data);
+        }
+    }
+    return kRocProfVisDmResultSuccess;
+}
+
+/****************************************************************************************************
+ * @brief Drops collected query statistics and the slow query log
+ * 
+ * @param database database handle
+ * @return status of operation
+ * 
+ ***************************************************************************************************/
+rocprofvis_dm_result_t rocprofvis_db_clear_query_telemetry(rocprofvis_dm_database_t database){
+    ROCPROFVIS_ASSERT_MSG_RETURN(database,
+                                 RocProfVis::DataModel::ERROR_DATABASE_CANNOT_BE_NULL,
+                                 kRocProfVisDmResultInvalidParameter);
+    RocProfVis::DataModel::Database* db = (RocProfVis::DataModel::Database*) database;
+    RocProfVis::DataModel::QueryTelemetry* telemetry = db->GetQueryTelemetry();
+    if(telemetry == nullptr)
+    {
+        return kRocProfVisDmResultNotSupported;
+    }
+    telemetry->Clear();
+    return kRocProfVisDmResultSuccess;
+}
+
 /****************************************************************************************************
  * @brief Allocates future object, to be used for asynchronous operations
  * 
@@ -540,7 +643,9 @@ rocprofvis_dm_result_t rocprofvis_db_trim_save_async(rocprofvis_dm_database_t da
  * @param object future handle allocated by rocprofvis_db_future_alloc
  * @return status of operation
  * 
- * @note Object will stay in trace memory until deleted. 
+ * @note Object stays in trace event property cache until deleted or evicted as least recently used. 
+ *          Future waits for property still being loaded by another request.
+ *          Use rocprofvis_dm_pin_event_property to access it.
  *          Use rocprofvis_dm_delete_event_property_for or 
  *          rocprofvis_dm_delete_all_event_properties_for for deletion
  * 
@@ -558,6 +663,97 @@ rocprofvis_dm_result_t  rocprofvis_db_read_event_property_async(
     return db->ReadEventPropertyAsync(type, event_id, object);
 }
 
+/****************************************************************************************************
+ * @brief Asynchronous call to prefetch extended data, flow trace and stack trace of multiple events
+ *                                                     
+ * @param database database handle
+ * @param num number of event ids
+ * @param event_ids array of 60-bit event ids and 4-bit operation types
+ * @param object future handle allocated by rocprofvis_db_future_alloc
+ * @return status of operation
+ * 
+ * @note Properties of all events are loaded by a single request into trace event property cache,
+ *          already cached properties are skipped. Number of events is limited by cache capacity.
+ * 
+ ***************************************************************************************************/
+rocprofvis_dm_result_t  rocprofvis_db_read_event_properties_async(
+                                        rocprofvis_dm_database_t database,
+                                        uint64_t num,
+                                        const rocprofvis_dm_event_id_t* event_ids,
+                                        rocprofvis_db_future_t object){
+    PROFILE;
+    ROCPROFVIS_ASSERT_MSG_RETURN(database,
+                                 RocProfVis::DataModel::ERROR_DATABASE_CANNOT_BE_NULL,
+                                 kRocProfVisDmResultInvalidParameter);
+    RocProfVis::DataModel::Database* db = (RocProfVis::DataModel::Database*) database;
+    return db->ReadEventPropertiesAsync(num, event_ids, object);
+}
+
+/****************************************************************************************************
+ * @brief Asynchronous call to read all flow edges for provided time frame and tracks selection
+ *                                                     
+ * @param database database handle
+ * @param start begining of the time frame
+ * @param end end of the time frame
+ * @param num number of tracks in tracks selection array, 0 for all tracks
+ * @param tracks tracks selection array
+ * @param object future handle allocated by rocprofvis_db_future_alloc
+ * @return status of operation
+ * 
+ * @note Object will stay in trace memory until deleted. 
+ *          Use rocprofvis_dm_delete_event_property for deletion
+ ***************************************************************************************************/
+rocprofvis_dm_result_t  rocprofvis_db_read_flow_range_async(
+                                        rocprofvis_dm_database_t database,
+                                        rocprofvis_dm_timestamp_t start,
+                                        rocprofvis_dm_timestamp_t end,
+                                        rocprofvis_db_num_of_tracks_t num,
+                                        rocprofvis_db_track_selection_t tracks,
+                                        rocprofvis_db_future_t object){
+    PROFILE;
+    ROCPROFVIS_ASSERT_MSG_RETURN(database,
+                                 RocProfVis::DataModel::ERROR_DATABASE_CANNOT_BE_NULL,
+                                 kRocProfVisDmResultInvalidParameter);
+    ROCPROFVIS_ASSERT_MSG_RETURN(num == 0 || tracks,
+                                 "Error! Tracks selection cannot be null.",
+                                 kRocProfVisDmResultInvalidParameter);
+    RocProfVis::DataModel::Database* db = (RocProfVis::DataModel::Database*) database;
+    return db->ReadFlowRangeAsync(start, end, num, tracks, object);
+}
+
+/****************************************************************************************************
+ * @brief Asynchronous call to read per-kernel statistics of kernel dispatches overlapping provided time frame
+ *                                                     
+ * @param database database handle
+ * @param start begining of the time frame
+ * @param end end of the time frame
+ * @param node_id node ID filter, KERNEL_SUMMARY_ANY_ID for all nodes
+ * @param agent_id agent ID filter, KERNEL_SUMMARY_ANY_ID for all agents
+ * @param object future handle allocated by rocprofvis_db_future_alloc
+ * @param id new id is assigned to the table and returned using this reference pointer
+ * @return status of operation
+ * 
+ * @note Object will stay in trace memory until deleted. 
+ *          Use rocprofvis_dm_delete_table_at or rocprofvis_dm_delete_all_tables for deletion
+ ***************************************************************************************************/
+rocprofvis_dm_result_t  rocprofvis_db_read_kernel_summary_async(
+                                        rocprofvis_dm_database_t database,
+                                        rocprofvis_dm_timestamp_t start,
+                                        rocprofvis_dm_timestamp_t end,
+                                        uint64_t node_id,
+                                        uint64_t agent_id,
+                                        rocprofvis_db_future_t object,
+                                        rocprofvis_dm_table_id_t* id){
+    PROFILE;
+    ROCPROFVIS_ASSERT_MSG_RETURN(database,
+                                 RocProfVis::DataModel::ERROR_DATABASE_CANNOT_BE_NULL,
+                                 kRocProfVisDmResultInvalidParameter);
+    ROCPROFVIS_ASSERT_MSG_RETURN(id, "Error! Table id pointer cannot be null.",
+                                 kRocProfVisDmResultInvalidParameter);
+    RocProfVis::DataModel::Database* db = (RocProfVis::DataModel::Database*) database;
+    return db->ReadKernelSummaryAsync(start, end, node_id, agent_id, object, id);
+}
+
 /****************************************************************************************************
  * @brief Asynchronous call to read a table result of specified SQL query
  *                                                     
@@ -617,6 +813,61 @@ rocprofvis_dm_result_t  rocprofvis_db_execute_compute_query_async(
 }
 
 
+/****************************************LOCK STATISTICS********************************************/
+
+/****************************************************************************************************
+ * @brief Enables or disables lock wait and hold time statistics. Disabled by default.
+ *
+ * @param enabled true to record statistics
+ *
+ ***************************************************************************************************/
+void rocprofvis_dm_set_lock_stats_enabled(bool enabled){
+    RocProfVis::DataModel::LockStats::SetEnabled(enabled);
+}
+
+/****************************************************************************************************
+ * @brief Reports lock statistics of every call site which acquired a lock since the last reset,
+ *        ordered by total wait time descending. Statistics are process wide.
+ *
+ * @param callback called once per call site
+ * @param user_data passed to the callback
+ *
+ * @return status of operation
+ *
+ ***************************************************************************************************/
+rocprofvis_dm_result_t rocprofvis_dm_get_lock_stats(
+                                    rocprofvis_dm_lock_stats_callback_t callback,
+                                    void* user_data){
+    ROCPROFVIS_ASSERT_MSG_RETURN(callback,
+                                 RocProfVis::DataModel::ERROR_REFERENCE_POINTER_CANNOT_BE_NULL,
+                                 kRocProfVisDmResultInvalidParameter);
+    for(auto const& site : RocProfVis::DataModel::LockStats::Snapshot())
+    {
+        rocprofvis_dm_lock_stats_t entry = { site.function.c_str(),
+                                             site.owner_class.c_str(),
+                                             site.shared ? 1u : 0u,
+                                             RocProfVis::DataModel::LockStats::NUM_BUCKETS,
+                                             site.count,
+                                             site.contended,
+                                             site.total_wait_ns,
+                                             site.max_wait_ns,
+                                             site.total_hold_ns,
+                                             site.max_hold_ns,
+                                             site.wait_histogram.data(),
+                                             site.hold_histogram.data() };
+        callback(&entry, user_data);
+    }
+    return kRocProfVisDmResultSuccess;
+}
+
+/****************************************************************************************************
+ * @brief Zeroes lock statistics of every call site
+ *
+ ***************************************************************************************************/
+void rocprofvis_dm_reset_lock_stats(void){
+    RocProfVis::DataModel::LockStats::Reset();
+}
+
 /*******************************************TRACE INTERFACE*****************************************/
 
 /****************************************************************************************************
@@ -743,6 +994,56 @@ rocprofvis_dm_result_t rocprofvis_dm_delete_all_time_slices(
     return ((RocProfVis::DataModel::Trace*)trace)->DeleteAllSlices();
 }
 
+/****************************************************************************************************
+ * @brief Pin loaded event property object of specified type, so it is neither evicted nor deleted while in use
+ *                                                     
+ * @param trace trace object handle created with rocprofvis_dm_create_trace()
+ * @param type type of property
+ *                             kEventFlowTrace,
+ *                             kEventStackTrace,
+ *                             kEventExtData,
+ * @param event_id 60-bit event id and 4-bit operation type
+ * @param object pointer receiving property object handle
+ * 
+ * @return status of operation
+ * 
+ ***************************************************************************************************/
+rocprofvis_dm_result_t  rocprofvis_dm_pin_event_property(
+                                        rocprofvis_dm_trace_t trace,
+                                        rocprofvis_dm_event_property_type_t type,
+                                        rocprofvis_dm_event_id_t event_id,
+                                        rocprofvis_dm_handle_t* object){
+    PROFILE;
+    ROCPROFVIS_ASSERT_MSG_RETURN(trace, RocProfVis::DataModel::ERROR_TRACE_CANNOT_BE_NULL,
+                                 kRocProfVisDmResultInvalidParameter);
+    ROCPROFVIS_ASSERT_MSG_RETURN(object, RocProfVis::DataModel::ERROR_REFERENCE_POINTER_CANNOT_BE_NULL,
+                                 kRocProfVisDmResultInvalidParameter);
+    return ((RocProfVis::DataModel::Trace*)trace)->PinEventProperty(type, event_id, *object);
+}
+
+/****************************************************************************************************
+ * @brief Release event property object pinned with rocprofvis_dm_pin_event_property
+ *                                                     
+ * @param trace trace object handle created with rocprofvis_dm_create_trace()
+ * @param type type of property
+ *                             kEventFlowTrace,
+ *                             kEventStackTrace,
+ *                             kEventExtData,
+ * @param object property object handle
+ * 
+ * @return status of operation
+ * 
+ ***************************************************************************************************/
+rocprofvis_dm_result_t  rocprofvis_dm_unpin_event_property(
+                                        rocprofvis_dm_trace_t trace,
+                                        rocprofvis_dm_event_property_type_t type,
+                                        rocprofvis_dm_handle_t object){
+    PROFILE;
+    ROCPROFVIS_ASSERT_MSG_RETURN(trace, RocProfVis::DataModel::ERROR_TRACE_CANNOT_BE_NULL,
+                                 kRocProfVisDmResultInvalidParameter);
+    return ((RocProfVis::DataModel::Trace*)trace)->UnpinEventProperty(type, object);
+}
+
 /****************************************************************************************************
  * @brief Delete event property object of specified type
  *                                                     
@@ -846,6 +1147,37 @@ rocprofvis_dm_result_t  rocprofvis_dm_delete_all_tables(
     return ((RocProfVis::DataModel::Trace*)trace)->DeleteAllTables();
 }
 
+/****************************************************************************************************
+ * @brief Reads the cells of a range of table rows as strings.
+ *        Equivalent to reading kRPVDMExtTableRowCellValueCharPtrIndexed of every cell,
+ *        but takes the table lock once and does no per cell property lookup.
+ *
+ * @param table table object handle
+ * @param first_row index of first row
+ * @param num_rows number of rows, clamped to the number of rows of the table
+ * @param callback called for every cell, row by row
+ * @param user_data passed to the callback
+ *
+ * @return status of operation
+ *
+ ***************************************************************************************************/
+rocprofvis_dm_result_t  rocprofvis_dm_get_table_cells(
+                                        rocprofvis_dm_table_t table,
+                                        uint64_t first_row,
+                                        uint64_t num_rows,
+                                        rocprofvis_dm_table_cell_callback_t callback,
+                                        void* user_data){
+    PROFILE;
+    ROCPROFVIS_ASSERT_MSG_RETURN(table, RocProfVis::DataModel::ERROR_TABLE_CANNOT_BE_NULL,
+                                 kRocProfVisDmResultInvalidParameter);
+    ROCPROFVIS_ASSERT_MSG_RETURN(callback,
+                                 RocProfVis::DataModel::ERROR_REFERENCE_POINTER_CANNOT_BE_NULL,
+                                 kRocProfVisDmResultInvalidParameter);
+    RocProfVis::DataModel::Table* _table = (RocProfVis::DataModel::Table*)table;
+    std::shared_lock<std::shared_mutex> lock(*_table->Mutex());
+    return _table->GetCells(first_row, num_rows, callback, user_data);
+}
+
 rocprofvis_dm_hashed_timestamp rocprofvis_dm_hash_combine_timestamp(
                                         rocprofvis_dm_timestamp_t start,
                                         rocprofvis_dm_timestamp_t end,
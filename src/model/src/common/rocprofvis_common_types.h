@@ -69,6 +69,10 @@ typedef union{
 #define TRACK_ID_STORE_ID 6
 #define TRACK_ID_RECORD_COUNT 7
 
+// Bounds of each event property cache (flow traces, stack traces, extended data) located in trace object
+#define EVENT_PROPERTY_CACHE_MAX_ITEMS 16384
+#define EVENT_PROPERTY_CACHE_MAX_BYTES (128ull << 20)
+
 typedef struct
 {
     uint64_t id;
@@ -219,6 +223,9 @@ typedef rocprofvis_dm_result_t (*rocprofvis_dm_add_table_column_func_t) (const r
 typedef rocprofvis_dm_result_t (*rocprofvis_dm_add_table_column_enum_func_t) (const rocprofvis_dm_table_t object, rocprofvis_db_table_column_enum_t column_enum);
 typedef rocprofvis_dm_result_t (*rocprofvis_dm_add_table_column_type_func_t) (const rocprofvis_dm_table_t object, rocprofvis_db_data_type_t column_type);
 typedef rocprofvis_dm_result_t (*rocprofvis_dm_add_table_row_cell_func_t) (const rocprofvis_dm_table_t object, rocprofvis_dm_charptr_t cell_value);
+typedef rocprofvis_dm_result_t (*rocprofvis_dm_add_table_row_cell_uint64_func_t) (const rocprofvis_dm_table_row_t object, uint64_t cell_value);
+typedef rocprofvis_dm_result_t (*rocprofvis_dm_add_table_row_cell_int64_func_t) (const rocprofvis_dm_table_row_t object, int64_t cell_value);
+typedef rocprofvis_dm_result_t (*rocprofvis_dm_add_table_row_cell_double_func_t) (const rocprofvis_dm_table_row_t object, double cell_value);
 typedef rocprofvis_dm_result_t (*rocprofvis_db_find_cached_table_value_func_t) (const rocprofvis_dm_database_t object, rocprofvis_dm_charptr_t table, 
                                                                                 const rocprofvis_dm_id_t id, rocprofvis_dm_charptr_t column, rocprofvis_dm_node_id_t node, rocprofvis_dm_charptr_t* value);
 typedef size_t (*rocprofvis_db_get_cached_num_instances_func_t) (const rocprofvis_dm_database_t object, rocprofvis_dm_charptr_t table, rocprofvis_dm_node_id_t node);
@@ -230,6 +237,7 @@ typedef rocprofvis_dm_result_t (*rocprofvis_dm_check_event_property_exists_t) (c
                                                                     rocprofvis_dm_event_property_type_t type, const rocprofvis_dm_event_id_t event_id);
 typedef rocprofvis_dm_result_t (*rocprofvis_dm_check_table_exists_t) (const rocprofvis_dm_trace_t object,  const rocprofvis_dm_table_id_t table_id);
 typedef rocprofvis_dm_result_t (*rocprofvis_dm_complete_slice_func_t) (const rocprofvis_dm_slice_t object);
+typedef rocprofvis_dm_result_t (*rocprofvis_dm_complete_event_property_func_t) (const rocprofvis_dm_trace_t object, const rocprofvis_dm_event_property_type_t type, const rocprofvis_dm_event_id_t event_id, bool success);
 typedef rocprofvis_dm_result_t (*rocprofvis_dm_remove_slice_func_t) (const rocprofvis_dm_trace_t trace, const rocprofvis_dm_track_id_t track_id, const rocprofvis_dm_slice_t object);
 typedef const char*  (*rocprofvis_dm_get_string_func_t) (const rocprofvis_dm_trace_t object, uint32_t index);
 typedef const size_t  (*rocprofvis_dm_get_string_order_func_t) (const rocprofvis_dm_trace_t object, uint32_t index);
@@ -275,11 +283,15 @@ typedef struct
         rocprofvis_dm_add_table_column_enum_func_t FuncAddTableColumnEnum; // Called by database query callback to add new column enumeration constant to a table object
         rocprofvis_dm_add_table_column_type_func_t FuncAddTableColumnType; // Called by database query callback to add new column type constant to a table object
         rocprofvis_dm_add_table_row_cell_func_t FuncAddTableRowCell;    // Called by database query callback to add new cell to a table row
+        rocprofvis_dm_add_table_row_cell_uint64_func_t FuncAddTableRowCellUInt64; // Called to add numeric cell to a table row, formatted only when read
+        rocprofvis_dm_add_table_row_cell_int64_func_t FuncAddTableRowCellInt64;   // Called to add numeric cell to a table row, formatted only when read
+        rocprofvis_dm_add_table_row_cell_double_func_t FuncAddTableRowCellDouble; // Called to add numeric cell to a table row, formatted only when read
         rocprofvis_dm_add_event_level_func_t FuncAddEventLevel;         // Called by database query callback to add event level to a map array located in trace object
         rocprofvis_dm_check_slice_exists_t FuncCheckSliceExists;        // Called by database async interface before quering a slice with the same parameters
         rocprofvis_dm_check_event_property_exists_t FuncCheckEventPropertyExists;        // Called by database async interface before quering an event property with the same parameters
         rocprofvis_dm_check_table_exists_t FuncCheckTableExists;        // Called by database async interface before quering a table with the same parameters
         rocprofvis_dm_complete_slice_func_t FuncCompleteSlice;        // Set complete state for slice
+        rocprofvis_dm_complete_event_property_func_t FuncCompleteEventProperty; // Set complete state for event property object loaded by calling thread, removes it on failure
         rocprofvis_dm_remove_slice_func_t FuncRemoveSlice;          // Remove slice if query has been cancelled
         rocprofvis_dm_get_string_func_t FuncGetString;              // Get string from string array by index
         rocprofvis_dm_get_string_order_func_t FuncGetStringOrder;   // Get order of string in sorted array;
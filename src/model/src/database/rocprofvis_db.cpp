@@ -3,11 +3,15 @@
 
 #include "rocprofvis_db.h"
 #include "rocprofvis_db_profile.h"
+#include "rocprofvis_c_interface.h"
 #include <cstdio>
 #include <fstream> 
 #include <sstream>
 #include <cstring>
 #include <cfloat>
+#include <chrono>
+#include <thread>
+#include <algorithm>
 
 namespace RocProfVis
 {
@@ -164,12 +168,20 @@ rocprofvis_dm_result_t   Database::ReadEventPropertyAsync(
     ROCPROFVIS_ASSERT_MSG_RETURN(future, ERROR_FUTURE_CANNOT_BE_NULL, kRocProfVisDmResultInvalidParameter);
     ROCPROFVIS_ASSERT_MSG_RETURN(!future->IsWorking(), ERROR_FUTURE_CANNOT_BE_USED, kRocProfVisDmResultResourceBusy);
     rocprofvis_dm_result_t result =  BindObject()->FuncCheckEventPropertyExists(BindObject()->trace_object, type, event_id);
-    if(result != kRocProfVisDmResultNotLoaded)
+    if(result == kRocProfVisDmResultSuccess)
     {
-        return future->SetPromise(kRocProfVisDmResultResourceBusy);
+        return future->SetPromise(result);
     }
     try {
-        future->SetWorker(std::move(std::thread(ReadEventPropertyStatic, this, type, event_id, future)));
+        if(result == kRocProfVisDmResultResourceBusy)
+        {
+            // property is being loaded by another request, resolve once that load completes
+            future->SetWorker(std::move(std::thread(WaitEventPropertyStatic, this, type, event_id, future)));
+        }
+        else
+        {
+            future->SetWorker(std::move(std::thread(ReadEventPropertyStatic, this, type, event_id, future)));
+        }
     }
     catch (std::exception ex)
     {
@@ -178,6 +190,73 @@ rocprofvis_dm_result_t   Database::ReadEventPropertyAsync(
     return kRocProfVisDmResultSuccess;
 }
 
+rocprofvis_dm_result_t   Database::ReadEventPropertiesAsync(
+                                                    uint64_t num,
+                                                    const rocprofvis_dm_event_id_t* event_ids,
+                                                    rocprofvis_db_future_t object){
+    Future* future = (Future*) object;
+    ROCPROFVIS_ASSERT_MSG_RETURN(future, ERROR_FUTURE_CANNOT_BE_NULL, kRocProfVisDmResultInvalidParameter);
+    ROCPROFVIS_ASSERT_MSG_RETURN(num == 0 || event_ids, "Event ids cannot be NULL!", kRocProfVisDmResultInvalidParameter);
+    ROCPROFVIS_ASSERT_MSG_RETURN(!future->IsWorking(), ERROR_FUTURE_CANNOT_BE_USED, kRocProfVisDmResultResourceBusy);
+    try {
+        std::vector<rocprofvis_dm_event_id_t> ids(event_ids, event_ids + std::min<uint64_t>(num, EVENT_PROPERTY_CACHE_MAX_ITEMS));
+        future->SetWorker(std::move(std::thread(ReadEventPropertiesStatic, this, std::move(ids), future)));
+    }
+    catch (const std::exception& ex)
+    {
+        ROCPROFVIS_ASSERT_ALWAYS_MSG_RETURN(ex.what(), kRocProfVisDmResultUnknownError);
+    }
+    return kRocProfVisDmResultSuccess;
+}
+
+rocprofvis_dm_result_t   Database::ReadFlowRangeAsync(
+                                                    rocprofvis_dm_timestamp_t start,
+                                                    rocprofvis_dm_timestamp_t end,
+                                                    rocprofvis_db_num_of_tracks_t num,
+                                                    rocprofvis_db_track_selection_t tracks,
+                                                    rocprofvis_db_future_t object){
+    Future* future = (Future*) object;
+    ROCPROFVIS_ASSERT_MSG_RETURN(future, ERROR_FUTURE_CANNOT_BE_NULL, kRocProfVisDmResultInvalidParameter);
+    ROCPROFVIS_ASSERT_MSG_RETURN(!future->IsWorking(), ERROR_FUTURE_CANNOT_BE_USED, kRocProfVisDmResultResourceBusy);
+    try {
+        std::vector<uint32_t> track_selection(tracks, tracks + num);
+        future->SetWorker(std::move(std::thread(ReadFlowRangeStatic, this, start, end, std::move(track_selection), future)));
+    }
+    catch (const std::exception& ex)
+    {
+        ROCPROFVIS_ASSERT_ALWAYS_MSG_RETURN(ex.what(), kRocProfVisDmResultUnknownError);
+    }
+    return kRocProfVisDmResultSuccess;
+}
+
+rocprofvis_dm_result_t   Database::ReadKernelSummaryAsync(
+                                                    rocprofvis_dm_timestamp_t start,
+                                                    rocprofvis_dm_timestamp_t end,
+                                                    uint64_t node_id,
+                                                    uint64_t agent_id,
+                                                    rocprofvis_db_future_t object,
+                                                    rocprofvis_dm_table_id_t* id){
+    Future* future = (Future*) object;
+    ROCPROFVIS_ASSERT_MSG_RETURN(future, ERROR_FUTURE_CANNOT_BE_NULL, kRocProfVisDmResultInvalidParameter);
+    ROCPROFVIS_ASSERT_MSG_RETURN(!future->IsWorking(), ERROR_FUTURE_CANNOT_BE_USED, kRocProfVisDmResultResourceBusy);
+    std::string key = "-- KERNEL SUMMARY " + std::to_string(start) + " " + std::to_string(end) + " " +
+        std::to_string(node_id) + " " + std::to_string(agent_id);
+    *id = std::hash<std::string>{}(key);
+    rocprofvis_dm_result_t   result = BindObject()->FuncCheckTableExists(BindObject()->trace_object, *id);
+    if(result != kRocProfVisDmResultNotLoaded)
+    {
+        return future->SetPromise(result);
+    }
+    try {
+        future->SetWorker(std::move(std::thread(ReadKernelSummaryStatic, this, std::move(key), start, end, node_id, agent_id, future)));
+    }
+    catch (const std::exception& ex)
+    {
+        ROCPROFVIS_ASSERT_ALWAYS_MSG_RETURN(ex.what(), kRocProfVisDmResultUnknownError);
+    }
+    return kRocProfVisDmResultSuccess;
+}
+
 rocprofvis_dm_result_t Database::BuildEventSearchQuery(
     rocprofvis_dm_timestamp_t start, rocprofvis_dm_timestamp_t end,
     rocprofvis_db_num_of_tracks_t num, rocprofvis_db_track_selection_t ops,
@@ -408,18 +487,155 @@ rocprofvis_dm_result_t   Database::ReadEventPropertyStatic(
                                                     rocprofvis_dm_event_property_type_t type,
                                                     rocprofvis_dm_event_id_t event_id,
                                                     Future* object){
+    return db->ReadEventProperty(type, event_id, object);
+}
+
+rocprofvis_dm_result_t   Database::WaitEventPropertyStatic(
+                                                    Database* db, 
+                                                    rocprofvis_dm_event_property_type_t type,
+                                                    rocprofvis_dm_event_id_t event_id,
+                                                    Future* object){
+    return db->WaitEventProperty(type, event_id, object);
+}
+
+rocprofvis_dm_result_t   Database::ReadEventPropertiesStatic(
+                                                    Database* db, 
+                                                    std::vector<rocprofvis_dm_event_id_t> event_ids,
+                                                    Future* object){
+    return db->ReadEventProperties(event_ids, object);
+}
+
+rocprofvis_dm_result_t   Database::ReadEventProperty(
+                                                    rocprofvis_dm_event_property_type_t type,
+                                                    rocprofvis_dm_event_id_t event_id,
+                                                    Future* object){
+    rocprofvis_dm_result_t result = kRocProfVisDmResultNotSupported;
     switch (type) {
         case kRPVDMEventFlowTrace:
-            return db->ReadFlowTraceInfo(event_id,object);
+            result = ReadFlowTraceInfo(event_id,object);
+            break;
         case kRPVDMEventStackTrace:
-            return db->ReadStackTraceInfo(event_id,object);
+            result = ReadStackTraceInfo(event_id,object);
+            break;
         case kRPVDMEventExtData:
-            return db->ReadExtEventInfo(event_id,object);           
+            result = ReadExtEventInfo(event_id,object);
+            break;
+        default:
+            ROCPROFVIS_ASSERT_ALWAYS_MSG_RETURN(ERROR_UNSUPPORTED_PROPERTY, kRocProfVisDmResultNotSupported); 
     }  
-    ROCPROFVIS_ASSERT_ALWAYS_MSG_RETURN(ERROR_UNSUPPORTED_PROPERTY, kRocProfVisDmResultNotSupported); 
+    // property object becomes evictable once completed, partially loaded object is removed
+    BindObject()->FuncCompleteEventProperty(BindObject()->trace_object, type, event_id, result == kRocProfVisDmResultSuccess);
+    return result;
+}
+
+rocprofvis_dm_result_t   Database::WaitEventProperty(
+                                                    rocprofvis_dm_event_property_type_t type,
+                                                    rocprofvis_dm_event_id_t event_id,
+                                                    Future* object){
+    rocprofvis_dm_result_t result = kRocProfVisDmResultResourceBusy;
+    while ((result = BindObject()->FuncCheckEventPropertyExists(BindObject()->trace_object, type, event_id)) == kRocProfVisDmResultResourceBusy)
+    {
+        if (object->Interrupted())
+        {
+            return object->SetPromise(kRocProfVisDmResultDbAbort);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if (result == kRocProfVisDmResultNotLoaded)
+    {
+        // load of another request failed or property has been deleted meanwhile
+        return ReadEventProperty(type, event_id, object);
+    }
+    return object->SetPromise(result);
+}
+
+rocprofvis_dm_result_t   Database::ReadEventProperties(
+                                                    std::vector<rocprofvis_dm_event_id_t>& event_ids,
+                                                    Future* object){
+    static const rocprofvis_dm_event_property_type_t types[] = {kRPVDMEventExtData, kRPVDMEventFlowTrace, kRPVDMEventStackTrace};
+    ROCPROFVIS_ASSERT_MSG_RETURN(object, ERROR_FUTURE_CANNOT_BE_NULL, kRocProfVisDmResultInvalidParameter);
+    // node and operation type are the high bits of the id
+    std::sort(event_ids.begin(), event_ids.end(), [](const rocprofvis_dm_event_id_t& a, const rocprofvis_dm_event_id_t& b) {
+        return a.bitfield.event_node != b.bitfield.event_node ? a.bitfield.event_node < b.bitfield.event_node :
+            a.bitfield.event_op != b.bitfield.event_op ? a.bitfield.event_op < b.bitfield.event_op :
+            a.bitfield.event_id < b.bitfield.event_id; });
+    double step = event_ids.empty() ? 0 : 100.0 / event_ids.size();
+    for (const rocprofvis_dm_event_id_t& event_id : event_ids)
+    {
+        for (rocprofvis_dm_event_property_type_t type : types)
+        {
+            if (object->Interrupted())
+            {
+                ShowProgress(0, "Event properties not loaded!", kRPVDbError, object);
+                return object->SetPromise(kRocProfVisDmResultDbAbort);
+            }
+            if (BindObject()->FuncCheckEventPropertyExists(BindObject()->trace_object, type, event_id) != kRocProfVisDmResultNotLoaded)
+            {
+                continue;
+            }
+            // every property read sets its own promise, property not available for event operation type is not an error
+            Future* sub_future = object->AddSubFuture();
+            ReadEventProperty(type, event_id, sub_future);
+            object->DeleteSubFuture(sub_future);
+        }
+        ShowProgress(step, "Loading event properties", kRPVDbBusy, object);
+    }
+    ShowProgress(0, "Event properties successfully loaded!", kRPVDbSuccess, object);
+    return object->SetPromise(kRocProfVisDmResultSuccess);
+}
+
+
+rocprofvis_dm_result_t   Database::ReadFlowRangeStatic(
+                                                    Database* db, 
+                                                    rocprofvis_dm_timestamp_t start,
+                                                    rocprofvis_dm_timestamp_t end,
+                                                    std::vector<uint32_t> tracks,
+                                                    Future* object){
+    rocprofvis_dm_result_t result = db->ReadFlowRange(start, end, tracks, object);
+    rocprofvis_dm_event_id_t range_id;
+    range_id.value = rocprofvis_dm_hash_combine_timestamp(start, end, kRocProfVisDmHashedTimestampTagFlowRange);
+    db->BindObject()->FuncCompleteEventProperty(db->BindObject()->trace_object, kRPVDMEventFlowTrace, range_id, result == kRocProfVisDmResultSuccess);
+    return result;
+}
+
+rocprofvis_dm_result_t   Database::ReadFlowRange(
+                                                    rocprofvis_dm_timestamp_t start,
+                                                    rocprofvis_dm_timestamp_t end,
+                                                    const std::vector<uint32_t>& tracks,
+                                                    Future* object){
+    (void) start;
+    (void) end;
+    (void) tracks;
+    object->SetPromise(kRocProfVisDmResultNotSupported);
+    return kRocProfVisDmResultNotSupported;
 }
 
+rocprofvis_dm_result_t   Database::ReadKernelSummaryStatic(
+                                                    Database* db, 
+                                                    std::string key,
+                                                    rocprofvis_dm_timestamp_t start,
+                                                    rocprofvis_dm_timestamp_t end,
+                                                    uint64_t node_id,
+                                                    uint64_t agent_id,
+                                                    Future* object){
+    return db->ReadKernelSummary(key.c_str(), start, end, node_id, agent_id, object);
+}
 
+rocprofvis_dm_result_t   Database::ReadKernelSummary(
+                                                    rocprofvis_dm_charptr_t key,
+                                                    rocprofvis_dm_timestamp_t start,
+                                                    rocprofvis_dm_timestamp_t end,
+                                                    uint64_t node_id,
+                                                    uint64_t agent_id,
+                                                    Future* object){
+    (void) key;
+    (void) start;
+    (void) end;
+    (void) node_id;
+    (void) agent_id;
+    object->SetPromise(kRocProfVisDmResultNotSupported);
+    return kRocProfVisDmResultNotSupported;
+}
 
 rocprofvis_dm_result_t   Database::ExecuteQueryStatic(
                                                     Database* db,
@@ -495,18 +711,23 @@ rocprofvis_dm_table_row_t Database::GetInfoTableRowHandle(rocprofvis_dm_table_t
 const char* Database::GetInfoTableRowCellValue(rocprofvis_dm_table_row_t object, size_t column_index){
     TableCache::Row * row = (TableCache::Row*)object;
     ROCPROFVIS_ASSERT_MSG_RETURN(row, ERROR_TABLE_ROW_CANNOT_BE_NULL, 0);
-    return row->values[column_index].c_str();
+    return row->table->GetRowCell(row, static_cast<uint32_t>(column_index));
 }
 
 const size_t Database::GetInfoTableRowNumCells(rocprofvis_dm_table_row_t object){
     TableCache::Row * row = (TableCache::Row*)object;
     ROCPROFVIS_ASSERT_MSG_RETURN(row, ERROR_TABLE_ROW_CANNOT_BE_NULL, 0);
-    return row->values.size();
+    return row->table->NumColumns();
 }
 
 rocprofvis_dm_size_t DatabaseCache::GetMemoryFootprint()
 {
-    size_t size = 0;
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    size_t size = sizeof(DatabaseCache);
+    for (auto& table : tables)
+    {
+        size += table.first.capacity() + table.second.GetMemoryFootprint();
+    }
     return size;
 }
 
@@ -62,31 +62,7 @@ typedef struct rocprofvis_db_string_id_t
 } rocprofvis_db_string_id_t;
 
 class Database;
-
-// Helper class to lock processes in order of database instances
-class OrderedMutex {
-public:
-    void init(uint32_t num_instances) { for (uint32_t i = 0; i < num_instances; i++) { m_instances.insert(i); } }
-
-    void lock(uint32_t id) {
-        std::unique_lock<std::mutex> lock(m_lock);
-        m_cv.wait(lock, [&] { return id == *m_instances.begin(); }); 
-    }
-
-    void unlock(uint32_t id) {
-        {
-            std::lock_guard<std::mutex> lock(m_lock);
-            m_instances.erase(id);
-        }
-        m_cv.notify_all();
-    }
-
-
-private:
-    std::set<uint32_t> m_instances;
-    std::mutex m_lock;
-    std::condition_variable m_cv;
-};
+class QueryTelemetry;
 
 class Database
 {
@@ -111,6 +87,9 @@ class Database
         // Get amount of memory used by database resource
         // @return memory size
         virtual rocprofvis_dm_size_t    GetMemoryFootprint(void); 
+        // Get query telemetry collector
+        // @return pointer to collector, nullptr if database does not support it
+        virtual QueryTelemetry*         GetQueryTelemetry() { return nullptr; }
 
         // Bind database to trace
         // @param binding_info - pointer to binding info structure 
@@ -168,6 +147,44 @@ class Database
                                                                 rocprofvis_dm_event_property_type_t type,
                                                                 rocprofvis_dm_event_id_t event_id,
                                                                 rocprofvis_db_future_t object);
+        // Asynchronously read all event properties (extdata, flowtrace, stacktrace) for a list of event IDs in a single request.
+        // Properties already cached or being loaded are skipped, number of events is limited by event property cache capacity
+        // @param num - number of event IDs
+        // @param event_ids - array of 60-bit event ids and 4-bit operation types
+        // @param object - future object providing asynchronous execution mechanism 
+        // @return status of operation
+        rocprofvis_dm_result_t          ReadEventPropertiesAsync(
+                                                                uint64_t num,
+                                                                const rocprofvis_dm_event_id_t* event_ids,
+                                                                rocprofvis_db_future_t object);
+        // Asynchronously read all flow edges (origin and target endpoints) for specified time frame and tracks
+        // @param start - start timestamp of time frame 
+        // @param end - end timestamp of time frame 
+        // @param num - number of tracks, 0 for all tracks
+        // @param tracks - uint32_t array with track IDs  
+        // @param object - future object providing asynchronous execution mechanism 
+        // @return status of operation
+        rocprofvis_dm_result_t          ReadFlowRangeAsync(
+                                                                rocprofvis_dm_timestamp_t start,
+                                                                rocprofvis_dm_timestamp_t end,
+                                                                rocprofvis_db_num_of_tracks_t num,
+                                                                rocprofvis_db_track_selection_t tracks,
+                                                                rocprofvis_db_future_t object);
+        // Asynchronously read per-kernel statistics of dispatches overlapping time frame and store results into Table object
+        // @param start - start timestamp of time frame 
+        // @param end - end timestamp of time frame 
+        // @param node_id - node ID filter, KERNEL_SUMMARY_ANY_ID for all nodes
+        // @param agent_id - agent ID filter, KERNEL_SUMMARY_ANY_ID for all agents
+        // @param object - future object providing asynchronous execution mechanism 
+        // @param id new id is assigned to the table and returned using this reference pointer
+        // @return status of operation
+        rocprofvis_dm_result_t          ReadKernelSummaryAsync(
+                                                                rocprofvis_dm_timestamp_t start,
+                                                                rocprofvis_dm_timestamp_t end,
+                                                                uint64_t node_id,
+                                                                uint64_t agent_id,
+                                                                rocprofvis_db_future_t object,
+                                                                rocprofvis_dm_table_id_t* id);
         // Asynchronously run any table query and store results into Table object 
         // @param query - database query 
         // @param description - database description
@@ -321,6 +338,56 @@ class Database
                                                                 rocprofvis_dm_event_property_type_t type,
                                                                 rocprofvis_dm_event_id_t event_id,
                                                                 Future* object);
+        //static method to wait for event property being loaded by another request. Required to launch a unique thread for asynchronous wait
+        // @param db - pointer to database object
+        // @param type - event property type (flowtrace, stacktrace, extdata) 
+        // @param event_id - 60-bit event id and 4-bit operation type
+        // @param object - future object providing asynchronous execution mechanism 
+        // @return status of operation
+        static rocprofvis_dm_result_t   WaitEventPropertyStatic(
+                                                                Database* db, 
+                                                                rocprofvis_dm_event_property_type_t type,
+                                                                rocprofvis_dm_event_id_t event_id,
+                                                                Future* object);
+        //static method to read properties of multiple events. Required to launch a unique thread for asynchronous event properties read
+        // @param db - pointer to database object
+        // @param event_ids - vector of 60-bit event ids and 4-bit operation types
+        // @param object - future object providing asynchronous execution mechanism 
+        // @return status of operation
+        static rocprofvis_dm_result_t   ReadEventPropertiesStatic(
+                                                                Database* db, 
+                                                                std::vector<rocprofvis_dm_event_id_t> event_ids,
+                                                                Future* object);
+        //static method to read flow edges. Required to launch a unique thread for asynchronous flow edges read
+        // @param db - pointer to database object
+        // @param start - start timestamp of time frame 
+        // @param end - end timestamp of time frame 
+        // @param tracks - vector of track IDs, empty for all tracks
+        // @param object - future object providing asynchronous execution mechanism 
+        // @return status of operation
+        static rocprofvis_dm_result_t   ReadFlowRangeStatic(
+                                                                Database* db, 
+                                                                rocprofvis_dm_timestamp_t start,
+                                                                rocprofvis_dm_timestamp_t end,
+                                                                std::vector<uint32_t> tracks,
+                                                                Future* object);
+        //static method to read kernel statistics. Required to launch a unique thread for asynchronous kernel summary read
+        // @param db - pointer to database object
+        // @param key - table key, used as table query
+        // @param start - start timestamp of time frame 
+        // @param end - end timestamp of time frame 
+        // @param node_id - node ID filter
+        // @param agent_id - agent ID filter
+        // @param object - future object providing asynchronous execution mechanism 
+        // @return status of operation
+        static rocprofvis_dm_result_t   ReadKernelSummaryStatic(
+                                                                Database* db, 
+                                                                std::string key,
+                                                                rocprofvis_dm_timestamp_t start,
+                                                                rocprofvis_dm_timestamp_t end,
+                                                                uint64_t node_id,
+                                                                uint64_t agent_id,
+                                                                Future* object);
         //static method to launch any query. Required to launch a unique thread for asynchronous database query
         // @param db - pointer to database object
         // @param query - database query 
@@ -402,21 +469,74 @@ class Database
                                                                 bool right_neighbor,
                                                                 Future* object);
 
-        // worker method to read flow trace info, called from ReadEventPropertyStatic
+        // worker method to read event property of specified type and complete it in trace object, called from ReadEventPropertyStatic, WaitEventProperty and ReadEventProperties
+        // @param type - event property type (flowtrace, stacktrace, extdata) 
+        // @param event_id - 60-bit event id and 4-bit operation type  
+        // @param object - future object providing asynchronous execution mechanism 
+        // @return status of operation
+        rocprofvis_dm_result_t          ReadEventProperty(
+                                                                rocprofvis_dm_event_property_type_t type,
+                                                                rocprofvis_dm_event_id_t event_id,
+                                                                Future* object);
+        // worker method to wait until event property being loaded by another request is completed, called from WaitEventPropertyStatic.
+        // Property is read if that load failed
+        // @param type - event property type (flowtrace, stacktrace, extdata) 
+        // @param event_id - 60-bit event id and 4-bit operation type  
+        // @param object - future object providing asynchronous execution mechanism 
+        // @return status of operation
+        rocprofvis_dm_result_t          WaitEventProperty(
+                                                                rocprofvis_dm_event_property_type_t type,
+                                                                rocprofvis_dm_event_id_t event_id,
+                                                                Future* object);
+        // worker method to read all properties of multiple events, called from ReadEventPropertiesStatic.
+        // Events are read grouped by node and operation type, so consecutive reads use the same tables
+        // @param event_ids - vector of 60-bit event ids and 4-bit operation types
+        // @param object - future object providing asynchronous execution mechanism 
+        // @return status of operation
+        rocprofvis_dm_result_t          ReadEventProperties(
+                                                                std::vector<rocprofvis_dm_event_id_t>& event_ids,
+                                                                Future* object);
+        // worker method to read flow trace info, called from ReadEventProperty
         // @param event_id - 60-bit event id and 4-bit operation type  
         // @param object - future object providing asynchronous execution mechanism 
         // @return status of operation
         virtual rocprofvis_dm_result_t  ReadFlowTraceInfo(
                                                                 rocprofvis_dm_event_id_t event_id,
                                                                 Future* object) = 0;
-        // worker method to read stack trace info, called from ReadEventPropertyStatic
+        // worker method to read flow edges for time frame, called from ReadFlowRangeStatic
+        // @param start - start timestamp of time frame 
+        // @param end - end timestamp of time frame 
+        // @param tracks - vector of track IDs, empty for all tracks
+        // @param object - future object providing asynchronous execution mechanism 
+        // @return status of operation
+        virtual rocprofvis_dm_result_t  ReadFlowRange(
+                                                                rocprofvis_dm_timestamp_t start,
+                                                                rocprofvis_dm_timestamp_t end,
+                                                                const std::vector<uint32_t>& tracks,
+                                                                Future* object);
+        // worker method to read kernel statistics for time frame, called from ReadKernelSummaryStatic
+        // @param key - table key, used as table query
+        // @param start - start timestamp of time frame 
+        // @param end - end timestamp of time frame 
+        // @param node_id - node ID filter
+        // @param agent_id - agent ID filter
+        // @param object - future object providing asynchronous execution mechanism 
+        // @return status of operation
+        virtual rocprofvis_dm_result_t  ReadKernelSummary(
+                                                                rocprofvis_dm_charptr_t key,
+                                                                rocprofvis_dm_timestamp_t start,
+                                                                rocprofvis_dm_timestamp_t end,
+                                                                uint64_t node_id,
+                                                                uint64_t agent_id,
+                                                                Future* object);
+        // worker method to read stack trace info, called from ReadEventProperty
         // @param event_id - 60-bit event id and 4-bit operation type  
         // @param object - future object providing asynchronous execution mechanism 
         // @return status of operation
         virtual rocprofvis_dm_result_t  ReadStackTraceInfo(
                                                                 rocprofvis_dm_event_id_t event_id,
                                                                 Future* object) = 0;
-        // worker method to read extended info, called from ReadEventPropertyStatic
+        // worker method to read extended info, called from ReadEventProperty
         // @param event_id - 60-bit event id and 4-bit operation type  
         // @param object - future object providing asynchronous execution mechanism 
         // @return status of operation
@@ -4,21 +4,40 @@
 #include "rocprofvis_db_cache.h"
 #include "rocprofvis_db.h"
 #include "rocprofvis_db_query_builder.h"
+#include <cstdlib>
 
 namespace RocProfVis
 {
 namespace DataModel
 {
 
-    uint32_t TableCache::AddColumn(const std::string& name, rocprofvis_db_data_type_t type)
+    uint32_t TableCache::InternString(const char* value)
+    {
+        auto it = m_string_ids.find(value);
+        if (it != m_string_ids.end())
+        {
+            return it->second;
+        }
+        uint32_t index = static_cast<uint32_t>(m_strings.size());
+        m_strings.emplace_back(value);
+        m_string_ids[m_strings.back()] = index;
+        return index;
+    }
+
+    uint32_t TableCache::AddColumn(const char* name, rocprofvis_db_data_type_t type)
     {
         uint32_t index = 0;
         auto it = m_column_index.find(name);
         if (it == m_column_index.end())
         {
+            if (m_strings.empty())
+            {
+                // string pool index 0 is the empty string of cells never set
+                InternString("");
+            }
             index = static_cast<uint32_t>(m_columns.size());
-            m_column_index[name] = index;
-            m_columns.push_back( std::make_pair(name,type) );
+            m_columns.push_back({ InternString(name), type, {}, {} });
+            m_column_index[m_strings[m_columns.back().name]] = index;
         }
         else
         {
@@ -33,64 +52,95 @@ namespace DataModel
         if (it == m_row_index.end())
         {
             m_row_index[id] = static_cast<uint32_t>(m_rows.size());
-            m_rows.push_back({ id });
-            m_rows.back().values.resize(m_columns.size());
+            m_rows.push_back({ id, this });
         }
     }
 
-    void TableCache::AddCell(uint32_t column_index, uint64_t row_id, std::string cell)
+    void TableCache::AddCell(uint32_t column_index, uint64_t row_id, const char* cell)
     {
-        auto it = m_row_index.find(row_id);
-        if (it != m_row_index.end())
+        if (column_index >= m_columns.size())
         {
-            if (column_index >= m_rows[it->second].values.size())
-            {
-                m_rows[it->second].values.resize(m_columns.size());
-            }
-            m_rows[it->second].values[column_index] = cell;
+            return;
         }
-        else
+        auto it = m_row_index.find(row_id);
+        if (it == m_row_index.end())
         {
             AddRow(row_id);
-            m_rows.back().values[column_index] = cell;
+            it = m_row_index.find(row_id);
+        }
+        Column& column = m_columns[column_index];
+        if (it->second >= column.strings.size())
+        {
+            column.strings.resize(m_rows.size(), 0);
+        }
+        column.strings[it->second] = InternString(cell ? cell : "");
+        if (column.type == kRPVDataTypeInt)
+        {
+            if (it->second >= column.integers.size())
+            {
+                column.integers.resize(m_rows.size(), 0);
+            }
+            column.integers[it->second] = cell ? std::atoll(cell) : 0;
         }
     }
 
-    const char* TableCache::GetCell(uint64_t row_id, std::string column_name)
+    uint32_t TableCache::FindColumn(const char* column_name) const
     {
-        auto it_row = m_row_index.find(row_id);
-        auto it_column = m_column_index.find(column_name);
-        if (it_row != m_row_index.end() && it_column!=m_column_index.end())
-        {
-            return m_rows[it_row->second].values[it_column->second].c_str();
-        }
-        return "";
+        auto it = m_column_index.find(column_name);
+        return it != m_column_index.end() ? it->second : INVALID_INDEX;
+    }
+
+    uint32_t TableCache::FindRow(uint64_t row_id) const
+    {
+        auto it = m_row_index.find(row_id);
+        return it != m_row_index.end() ? it->second : INVALID_INDEX;
+    }
+
+    const char* TableCache::GetCell(uint64_t row_id, const char* column_name)
+    {
+        return GetCell(FindRow(row_id), FindColumn(column_name));
     }
 
     const char* TableCache::GetCell(uint64_t row_index, uint32_t column_index)
     {
         if (row_index < m_rows.size() && column_index < m_columns.size())
         {
-            return m_rows[row_index].values[column_index].c_str();
+            const Column& column = m_columns[column_index];
+            if (row_index < column.strings.size())
+            {
+                return m_strings[column.strings[row_index]].c_str();
+            }
         }
         return "";
     }
 
-    const char* TableCache::GetCellByIndex(uint64_t row_index, std::string column_name)
+    int64_t TableCache::GetCellInt(uint64_t row_index, uint32_t column_index)
     {
-        auto it_column = m_column_index.find(column_name);
-        if (row_index < m_rows.size() && it_column!=m_column_index.end())
+        if (row_index < m_rows.size() && column_index < m_columns.size())
         {
-            return m_rows[row_index].values[it_column->second].c_str();
+            const Column& column = m_columns[column_index];
+            if (column.type == kRPVDataTypeInt)
+            {
+                return row_index < column.integers.size() ? column.integers[row_index] : 0;
+            }
+            if (row_index < column.strings.size())
+            {
+                return std::atoll(m_strings[column.strings[row_index]].c_str());
+            }
         }
-        return "";
+        return 0;
+    }
+
+    const char* TableCache::GetCellByIndex(uint64_t row_index, const char* column_name)
+    {
+        return GetCell(row_index, FindColumn(column_name));
     }
 
     const char* TableCache::GetColumnName(uint32_t column_index)
     {
         if (column_index < m_columns.size())
         {
-            return m_columns[column_index].first.c_str();
+            return m_strings[m_columns[column_index].name].c_str();
         }
         return "";
     }
@@ -99,7 +149,7 @@ namespace DataModel
     {
         if (column_index < m_columns.size())
         {
-            return m_columns[column_index].second;
+            return m_columns[column_index].type;
         }
         return kRPVDataTypeNull;
     }
@@ -113,36 +163,67 @@ namespace DataModel
         return nullptr;
     }
 
-    void DatabaseCache::AddTableCell(const char* table_name, uint64_t row_id, uint32_t column_index, std::string cell_value)
+    const char* TableCache::GetRowCell(const Row* row, uint32_t column_index)
+    {
+        return GetCell(static_cast<uint64_t>(row - m_rows.data()), column_index);
+    }
+
+    rocprofvis_dm_size_t TableCache::GetMemoryFootprint()
+    {
+        rocprofvis_dm_size_t size = sizeof(TableCache);
+        for (auto const& column : m_columns)
+        {
+            size += sizeof(Column) + column.strings.capacity() * sizeof(uint32_t) +
+                    column.integers.capacity() * sizeof(int64_t);
+        }
+        size += m_rows.capacity() * sizeof(Row);
+        for (auto const& str : m_strings)
+        {
+            size += sizeof(std::string) + (str.capacity() > 15 ? str.capacity() : 0);
+        }
+        // node based maps, one allocation per entry plus the bucket array
+        size += m_column_index.size() * (sizeof(std::string_view) + sizeof(uint32_t) + 2 * sizeof(void*)) +
+                m_column_index.bucket_count() * sizeof(void*);
+        size += m_row_index.size() * (sizeof(uint64_t) + sizeof(uint32_t) + 2 * sizeof(void*)) +
+                m_row_index.bucket_count() * sizeof(void*);
+        size += m_string_ids.size() * (sizeof(std::string_view) + sizeof(uint32_t) + 2 * sizeof(void*)) +
+                m_string_ids.bucket_count() * sizeof(void*);
+        return size;
+    }
+
+    void DatabaseCache::AddTableCell(const char* table_name, uint64_t row_id, uint32_t column_index, const char* cell_value)
     {
         std::unique_lock<std::shared_mutex> lock(m_mutex);
         tables[table_name].AddCell(column_index, row_id, cell_value);
     }
-    void DatabaseCache::AddTableCell(const char* table_name, uint64_t row_id, std::string column_name, rocprofvis_db_data_type_t column_type, std::string cell_value)
+    void DatabaseCache::AddTableCell(const char* table_name, uint64_t row_id, const char* column_name, rocprofvis_db_data_type_t column_type, const char* cell_value)
     {
         std::unique_lock<std::shared_mutex> lock(m_mutex);
-        uint32_t column_index = tables[table_name].AddColumn(column_name, column_type);
-        tables[table_name].AddCell(column_index, row_id, cell_value);
+        TableCache& table = tables[table_name];
+        uint32_t column_index = table.AddColumn(column_name, column_type);
+        table.AddCell(column_index, row_id, cell_value);
     }
     void DatabaseCache::AddTableRow(const char* table_name, uint64_t row_id)
     {
         std::unique_lock<std::shared_mutex> lock(m_mutex);
         tables[table_name].AddRow(row_id);
     }
-    void DatabaseCache::AddTableColumn(const char* table_name, std::string column_name, rocprofvis_db_data_type_t column_type)
+    void DatabaseCache::AddTableColumn(const char* table_name, const char* column_name, rocprofvis_db_data_type_t column_type)
     {
         std::unique_lock<std::shared_mutex> lock(m_mutex);
         tables[table_name].AddColumn(column_name, column_type);
     }
-    const char* DatabaseCache::GetTableCell(const char* table_name, uint64_t row_id, std::string column_name)
+    const char* DatabaseCache::GetTableCell(const char* table_name, uint64_t row_id, const char* column_name)
     {
-        std::unique_lock<std::shared_mutex> lock(m_mutex);
-        return tables[table_name].GetCell(row_id,column_name);
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        auto it = tables.find(table_name);
+        return it != tables.end() ? it->second.GetCell(row_id, column_name) : "";
     }
-    const char* DatabaseCache::GetTableCellByIndex(const char* table_name, uint32_t row_index, std::string column_name)
+    const char* DatabaseCache::GetTableCellByIndex(const char* table_name, uint32_t row_index, const char* column_name)
     {
-        std::unique_lock<std::shared_mutex> lock(m_mutex);
-        return tables[table_name].GetCellByIndex(row_index,column_name);
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        auto it = tables.find(table_name);
+        return it != tables.end() ? it->second.GetCellByIndex(row_index, column_name) : "";
     }
 
     void* DatabaseCache::GetTableHandle(const char* table_name)
@@ -151,7 +232,7 @@ namespace DataModel
         return &tables[table_name];
     }
 
-    rocprofvis_dm_result_t DatabaseCache::PopulateTrackExtendedDataTemplate(Database * db, uint32_t db_instance_id, std::string table_name, uint64_t process_id ){
+    rocprofvis_dm_result_t DatabaseCache::PopulateTrackExtendedDataTemplate(Database * db, uint32_t db_instance_id, const char* table_name, uint64_t process_id ){
         rocprofvis_dm_track_params_t* track_properties = db->TrackPropertiesLast();
         TableCache& table = tables[table_name];
         uint32_t num_columns = table.NumColumns();
@@ -161,7 +242,7 @@ namespace DataModel
             rocprofvis_db_ext_data_t record;
             record.name = table.GetColumnName(i);
             record.data     = str_id.c_str();
-            record.category = table_name.c_str();
+            record.category = table_name;
             record.type  = table.GetColumnType(i);
             record.db_instance = db_instance_id;
             rocprofvis_dm_result_t result = db->BindObject()->FuncAddExtDataRecord(track_properties->extdata, record);
@@ -170,10 +251,12 @@ namespace DataModel
         return PopulateTrackTopologyData(db, &track_properties->track_indentifiers, db_instance_id, table_name, process_id);
     }
 
-    rocprofvis_dm_result_t DatabaseCache::PopulateTrackTopologyData(Database * db, rocprofvis_dm_track_identifiers_t * track_indentifiers, uint32_t db_instance_id, std::string table_name, uint64_t process_id ){
+    rocprofvis_dm_result_t DatabaseCache::PopulateTrackTopologyData(Database * db, rocprofvis_dm_track_identifiers_t * track_indentifiers, uint32_t db_instance_id, const char* table_name, uint64_t process_id ){
         (void) db_instance_id;
         TableCache& table = tables[table_name];
         uint32_t num_columns = table.NumColumns();
+        // resolve the row once, cells of a missing row read as empty strings
+        uint32_t row_index = table.FindRow(process_id);
         for (uint32_t i = 0; i < num_columns; i++)
         { 
             const char* name = table.GetColumnName(i);
@@ -182,9 +265,9 @@ namespace DataModel
                 db->BindObject()->trace_object, 
                 track_indentifiers, 
                 (rocprofvis_db_topology_data_type_t)type, 
-                table_name.c_str(),
+                table_name,
                 name,
-                (void*)table.GetCell(process_id, name));
+                (void*)table.GetCell(row_index, i));
             if (result != kRocProfVisDmResultSuccess) return result;
         }
         return kRocProfVisDmResultSuccess;
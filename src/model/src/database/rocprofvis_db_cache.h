@@ -4,6 +4,8 @@
 #pragma once
 
 #include "rocprofvis_common_types.h"
+#include <deque>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 #include <shared_mutex>
@@ -20,27 +22,45 @@ typedef std::map<std::string, table_map_t> ref_map_t;
 
 class Database;
 
-// Helper class to manage cached information tables (node, agent, queue, process, thread information)
+// Helper class to manage cached information tables (node, agent, queue, process, thread information).
+// Cells are kept column wise as indices into a table string pool, so repeated values are stored once,
+// and integer columns also keep the parsed value. Columns and rows can be resolved to indices once
+// and then read without name or id lookups.
 
 class TableCache
 {
 public:
+    // Row handle returned by GetRow, cells are read with GetRowCell
     struct Row {
         uint64_t id;
-        std::vector<std::string> values;
+        TableCache* table;
     };
 
-    uint32_t AddColumn(const std::string& name, rocprofvis_db_data_type_t type);
+    TableCache() = default;
+    // string pool lookups refer to the pool of this object, tables are never copied
+    TableCache(const TableCache&) = delete;
+    TableCache& operator=(const TableCache&) = delete;
+
+    uint32_t AddColumn(const char* name, rocprofvis_db_data_type_t type);
 
     void AddRow(uint64_t id);
 
-    void AddCell(uint32_t column_index, uint64_t row_id, std::string cell);
+    void AddCell(uint32_t column_index, uint64_t row_id, const char* cell);
+
+    // @return index of column, INVALID_INDEX if there is no column with this name
+    uint32_t FindColumn(const char* column_name) const;
+
+    // @return index of row, INVALID_INDEX if there is no row with this id
+    uint32_t FindRow(uint64_t row_id) const;
 
-    const char* GetCell(uint64_t row_id, std::string column_name);
+    const char* GetCell(uint64_t row_id, const char* column_name);
 
     const char* GetCell(uint64_t row_index, uint32_t column_index);
 
-    const char* GetCellByIndex(uint64_t row_index, std::string column_name);
+    // @return integer value of a cell, parsed from its string if the column is not an integer column
+    int64_t GetCellInt(uint64_t row_index, uint32_t column_index);
+
+    const char* GetCellByIndex(uint64_t row_index, const char* column_name);
 
     const char* GetColumnName(uint32_t column_index);
 
@@ -48,31 +68,54 @@ public:
 
     void* GetRow(uint64_t row_index);
 
+    const char* GetRowCell(const Row* row, uint32_t column_index);
+
     uint32_t NumColumns() { return static_cast<uint32_t>(m_columns.size()); }
     size_t NumRows() { return m_rows.size(); }
 
+    // Get amount of memory used by columns, rows, cells, string pool and lookup maps
+    rocprofvis_dm_size_t GetMemoryFootprint();
+
 private:
-    std::vector<std::pair<std::string, rocprofvis_db_data_type_t>> m_columns;
+    struct Column {
+        // string pool index of column name
+        uint32_t name;
+        rocprofvis_db_data_type_t type;
+        // string pool index of every cell, indexed by row
+        std::vector<uint32_t> strings;
+        // parsed value of every cell, integer columns only
+        std::vector<int64_t> integers;
+    };
+
+    // Add a string to the string pool, equal strings share one entry
+    // @return string pool index
+    uint32_t InternString(const char* value);
+
+    std::vector<Column> m_columns;
     std::vector<Row> m_rows;
-    std::unordered_map<std::string, uint32_t> m_column_index;
+    // keys refer to column names in the string pool
+    std::unordered_map<std::string_view, uint32_t> m_column_index;
     std::unordered_map<uint64_t, uint32_t> m_row_index;
+    // string pool, deque keeps the strings referenced by m_string_ids in place
+    std::deque<std::string> m_strings;
+    std::unordered_map<std::string_view, uint32_t> m_string_ids;
 };
 
 class DatabaseCache 
 {
     public:
-        void AddTableCell(const char* table_name, uint64_t row_id, uint32_t column_index, std::string cell_value);
-        void AddTableCell(const char* table_name, uint64_t row_id, std::string column_name, rocprofvis_db_data_type_t column_type, std::string cell_value);
+        void AddTableCell(const char* table_name, uint64_t row_id, uint32_t column_index, const char* cell_value);
+        void AddTableCell(const char* table_name, uint64_t row_id, const char* column_name, rocprofvis_db_data_type_t column_type, const char* cell_value);
         void AddTableRow(const char* table_name, uint64_t row_id);
-        void AddTableColumn(const char* table_name, std::string column_name, rocprofvis_db_data_type_t column_type);
-        const char* GetTableCell(const char* table_name, uint64_t row_id, std::string column_name);
-        const char* GetTableCellByIndex(const char* table_name, uint32_t row_index, std::string column_name);
+        void AddTableColumn(const char* table_name, const char* column_name, rocprofvis_db_data_type_t column_type);
+        const char* GetTableCell(const char* table_name, uint64_t row_id, const char* column_name);
+        const char* GetTableCellByIndex(const char* table_name, uint32_t row_index, const char* column_name);
         void* GetTableHandle(const char* table_name);
       
         // Populate track extended data objects and topology tree with table content
-        rocprofvis_dm_result_t PopulateTrackExtendedDataTemplate(Database * db, uint32_t node_id, std::string table_name, uint64_t instance_id ); 
+        rocprofvis_dm_result_t PopulateTrackExtendedDataTemplate(Database * db, uint32_t node_id, const char* table_name, uint64_t instance_id ); 
         // Populate track extended data objects and topology tree with table content
-        rocprofvis_dm_result_t PopulateTrackTopologyData(Database * db, rocprofvis_dm_track_identifiers_t * track_indentifiers, uint32_t db_instance_id, std::string table_name, uint64_t process_id );
+        rocprofvis_dm_result_t PopulateTrackTopologyData(Database * db, rocprofvis_dm_track_identifiers_t * track_indentifiers, uint32_t db_instance_id, const char* table_name, uint64_t process_id );
         // Get amount of memory used by the cached values map
         rocprofvis_dm_size_t    GetMemoryFootprint(void); 
 
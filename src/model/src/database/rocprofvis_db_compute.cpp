@@ -1478,21 +1478,21 @@ void ComputeQueryFactory::ParseMetricParam(std::string metric_str, uint32_t work
 					s.median = static_cast<double>(s.durations[n / 2]);
 				rocprofvis_dm_table_row_t row = BindObject()->FuncAddTableRow(table);
 
-				result = BindObject()->FuncAddTableRowCell(row, std::to_string(kernel).c_str());
+				result = BindObject()->FuncAddTableRowCellUInt64(row, kernel);
 				if (kRocProfVisDmResultSuccess != result) break;
 				result = BindObject()->FuncAddTableRowCell(row, s.name.c_str());
 				if (kRocProfVisDmResultSuccess != result) break;
-				result = BindObject()->FuncAddTableRowCell(row, std::to_string(s.count).c_str());
+				result = BindObject()->FuncAddTableRowCellUInt64(row, s.count);
 				if (kRocProfVisDmResultSuccess != result) break;
-				result = BindObject()->FuncAddTableRowCell(row, std::to_string(s.sum).c_str());
+				result = BindObject()->FuncAddTableRowCellUInt64(row, s.sum);
 				if (kRocProfVisDmResultSuccess != result) break;
-				result = BindObject()->FuncAddTableRowCell(row, std::to_string(s.mean).c_str());
+				result = BindObject()->FuncAddTableRowCellDouble(row, s.mean);
 				if (kRocProfVisDmResultSuccess != result) break;
-				result = BindObject()->FuncAddTableRowCell(row, std::to_string(s.min).c_str());
+				result = BindObject()->FuncAddTableRowCellUInt64(row, s.min);
 				if (kRocProfVisDmResultSuccess != result) break;
-				result = BindObject()->FuncAddTableRowCell(row, std::to_string(s.max).c_str());
+				result = BindObject()->FuncAddTableRowCellUInt64(row, s.max);
 				if (kRocProfVisDmResultSuccess != result) break;
-				result = BindObject()->FuncAddTableRowCell(row, std::to_string(s.median).c_str());
+				result = BindObject()->FuncAddTableRowCellDouble(row, s.median);
 				if (kRocProfVisDmResultSuccess != result) break;
 			}
 		}
@@ -1757,26 +1757,23 @@ void ComputeQueryFactory::ParseMetricParam(std::string metric_str, uint32_t work
 			for (auto& mrow : metrics_rows)
 			{
 				rocprofvis_dm_table_row_t row = BindObject()->FuncAddTableRow(table);
-				result = BindObject()->FuncAddTableRowCell(row, std::to_string(mrow.kernel_uuid).c_str());
+				result = BindObject()->FuncAddTableRowCellUInt64(row, mrow.kernel_uuid);
 				if (kRocProfVisDmResultSuccess != result) break;
 
 				result = BindObject()->FuncAddTableRowCell(row, mrow.stats.name.c_str());
 				if (kRocProfVisDmResultSuccess != result) break;
 
-				result = BindObject()->FuncAddTableRowCell(row, std::to_string(mrow.stats.sum).c_str());
+				result = BindObject()->FuncAddTableRowCellUInt64(row, mrow.stats.sum);
 				if (kRocProfVisDmResultSuccess != result) break;
 
-				result = BindObject()->FuncAddTableRowCell(row, std::to_string(mrow.stats.count).c_str());
+				result = BindObject()->FuncAddTableRowCellUInt64(row, mrow.stats.count);
 				if (kRocProfVisDmResultSuccess != result) break;
 
 				for (double value : mrow.metrics)
 				{
-					std::string str;
-					if (!std::isnan(value))
-					{
-						str = std::to_string(value);
-					}
-					result = BindObject()->FuncAddTableRowCell(row,  str.c_str());
+					// missing metric values stay empty cells
+					result = std::isnan(value) ? BindObject()->FuncAddTableRowCell(row, "")
+					                           : BindObject()->FuncAddTableRowCellDouble(row, value);
 					if (kRocProfVisDmResultSuccess != result) break;
 
 				}
@@ -244,6 +244,38 @@ namespace DataModel
     }
 
 
+    bool PackedTable::IsSqlStringReference(uint32_t column_index) {
+        switch (column_index)
+        {
+        case Builder::SCHEMA_INDEX_NODE_ID:
+        case Builder::SCHEMA_INDEX_CATEGORY:
+        case Builder::SCHEMA_INDEX_CATEGORY_RPD:
+        case Builder::SCHEMA_INDEX_EVENT_NAME:
+        case Builder::SCHEMA_INDEX_EVENT_NAME_RPD:
+        case Builder::SCHEMA_INDEX_EVENT_ARGS_RPD:
+        case Builder::SCHEMA_INDEX_COUNTER_ID_RPD:
+        case Builder::SCHEMA_INDEX_CATEGORY_PERFETTO:
+        case Builder::SCHEMA_INDEX_EVENT_NAME_PERFETTO:
+        case Builder::SCHEMA_INDEX_STREAM_NAME:
+        case Builder::SCHEMA_INDEX_QUEUE_NAME:
+        case Builder::SCHEMA_INDEX_EVENT_SYMBOL:
+        case Builder::SCHEMA_INDEX_AGENT_ABS_INDEX:
+        case Builder::SCHEMA_INDEX_AGENT_SRC_ABS_INDEX:
+        case Builder::SCHEMA_INDEX_AGENT_TYPE:
+        case Builder::SCHEMA_INDEX_AGENT_SRC_TYPE:
+        case Builder::SCHEMA_INDEX_AGENT_TYPE_INDEX:
+        case Builder::SCHEMA_INDEX_AGENT_SRC_TYPE_INDEX:
+        case Builder::SCHEMA_INDEX_AGENT_NAME:
+        case Builder::SCHEMA_INDEX_AGENT_SRC_NAME:
+        case Builder::SCHEMA_INDEX_COUNTER_ID:
+        case Builder::SCHEMA_INDEX_MEM_TYPE:
+        case Builder::SCHEMA_INDEX_LEVEL:
+            return true;
+        default:
+            return false;
+        }
+    }
+
     bool PackedTable::SetupAggregation(std::string agg_spec, int num_threads)
     {       
         auto agg_params = FilterExpression::ParseAggregationSpec(agg_spec);
@@ -746,6 +778,11 @@ namespace DataModel
             }
         }
 
+        SortMergedColumns();
+    }
+
+    void PackedTable::SortMergedColumns()
+    {
         std::sort(m_merged_columns.begin(), m_merged_columns.end(),
             [&](MergedColumnDef& a, MergedColumnDef& b) {
 
@@ -754,6 +791,16 @@ namespace DataModel
         );
     }
 
+    void PackedTable::TakeRows(PackedTable& table)
+    {
+        m_rows.reserve(m_rows.size() + table.m_rows.size());
+        for (auto& r : table.m_rows)
+        {
+            m_rows.push_back(std::move(r));
+        }
+        table.ClearRows();
+    }
+
     void PackedTable::Merge(std::vector<std::unique_ptr<PackedTable>>& tables)
     {
         ManageColumns(tables);
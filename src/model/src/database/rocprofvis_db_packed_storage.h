@@ -148,6 +148,8 @@ namespace DataModel
 
         void AddColumn(const std::string& name, ColumnType type, uint8_t sql_index, uint8_t schema_index);
         void AddMergedColumn(const std::string& name, uint8_t op, ColumnType type, uint8_t offset, uint8_t schema_index);
+        // Orders merged columns by schema index, as done by ManageColumns
+        void SortMergedColumns();
         void AddRow();
 
         void Validate(size_t col);
@@ -170,6 +172,11 @@ namespace DataModel
         DbInstance* GetDbInstanceForRow(QueryManager * db, int row_index);
         DbInstance* GetDbInstanceForRow(QueryManager* db, PackedRow* row);
         uint32_t SortedIndex(uint32_t index) { return m_sort_order[index]; };
+        uint64_t GetEventIdValue(size_t row) const { return m_rows[row]->Get<uint64_t>(1); };
+        void SetMergedColumns(const std::vector<MergedColumnDef>& columns) { m_merged_columns = columns; };
+        // Moves all rows of another table, used to process a query result in chunks
+        void TakeRows(PackedTable& table);
+        void ClearRows() { m_rows.clear(); m_sort_order.clear(); m_currentRow = static_cast<size_t>(INVALID_INDEX_64); };
 
         void Merge(std::vector<std::unique_ptr<PackedTable>>& tables);
         void ManageColumns(std::vector<std::unique_ptr<PackedTable>>& tables);
@@ -188,6 +195,8 @@ namespace DataModel
         void RemoveRowsForSetOfTracks(std::set<uint32_t> & selected_tracks, std::set<uint32_t> & unselected_tracks, bool remove_all);
 
         static const char* ConvertSqlStringReference(QueryManager* db, uint32_t column_index, uint64_t index, uint32_t node_id, bool & numeric_string);
+        // True if ConvertSqlStringReference resolves values of the schema column to strings
+        static bool IsSqlStringReference(uint32_t column_index);
 
         void ResetTrackIdetifiers() { 
             track_ids_indices.nid_index = track_ids_indices.process_index = track_ids_indices.sub_process_index = track_ids_indices.stream_index = track_ids_indices.pid_index = INVALID_INDEX; 
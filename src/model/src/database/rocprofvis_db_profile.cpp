@@ -129,7 +129,7 @@ int ProfileDatabase::CallbackCacheTable(void *data, int argc, sqlite3_stmt* stmt
         rocprofvis_db_data_type_t col_type = (rocprofvis_db_data_type_t)sqlite3_column_type(stmt, i);
         if (col_type == kRPVDataTypeNull && strcmp(azColName[i],"name") == 0)
         {
-            ref_tables->AddTableCell(callback_params->query[kRPVCacheTableName].c_str(), id, i, callback_params->query[kRPVCacheTableName]);
+            ref_tables->AddTableCell(callback_params->query[kRPVCacheTableName].c_str(), id, i, callback_params->query[kRPVCacheTableName].c_str());
         }
         else
         {
@@ -151,18 +151,12 @@ int ProfileDatabase::CallBackAddTrack(void *data, int argc, sqlite3_stmt* stmt,
     ROCPROFVIS_ASSERT_MSG_RETURN(callback_params->db_instance != nullptr, ERROR_NODE_KEY_CANNOT_BE_NULL, 1);
     ProfileDatabase* db = (ProfileDatabase*)callback_params->db;
     if(callback_params->future->Interrupted()) return SQLITE_ABORT;
-    db->m_add_track_mutex.lock(callback_params->db_instance->GuidIndex());
     track_params.track_indentifiers.db_instance = callback_params->db_instance;
     track_params.load_id.insert(callback_params->track_id);
-    track_params.track_indentifiers.track_id = (rocprofvis_dm_track_id_t)db->NumTracks();
     track_params.track_indentifiers.category = (rocprofvis_dm_track_category_t)db->Sqlite3ColumnInt(func, stmt, azColName,TRACK_ID_CATEGORY);
     track_params.op = db->Sqlite3ColumnInt(func, stmt, azColName,TRACK_ID_OPERATION);
     track_params.track_indentifiers.process_id = db->Sqlite3ColumnInt(func, stmt, azColName,TRACK_ID_PROCESS);
     track_params.record_count=db->Sqlite3ColumnInt(func, stmt, azColName,TRACK_ID_RECORD_COUNT);
-    if (track_params.op < kRocProfVisDmNumOperation)
-    {
-        db->TraceProperties()->events_count[track_params.op] += track_params.record_count;
-    }
     for (int i = 0; i < NUMBER_OF_TRACK_IDENTIFICATION_PARAMETERS; i++) {
         track_params.track_indentifiers.tag[i] = azColName[i];
         char* arg = (char*) db->Sqlite3ColumnText(func, stmt, azColName, i);
@@ -178,7 +172,7 @@ int ProfileDatabase::CallBackAddTrack(void *data, int argc, sqlite3_stmt* stmt,
     track_params.max_value = 0;
     track_params.min_value = DBL_MAX;
 
-    db->ProcessTrack(track_params, callback_params->query);
+    db->CollectTrack(callback_params, track_params, false);
 
     callback_params->future->CountThisRow();
     return 0;
@@ -191,33 +185,19 @@ int ProfileDatabase::CallBackLoadTrack(void *data, int argc, sqlite3_stmt* stmt,
     rocprofvis_dm_track_params_t track_params = {0};
     rocprofvis_db_sqlite_callback_parameters* callback_params = (rocprofvis_db_sqlite_callback_parameters*)data;
     ROCPROFVIS_ASSERT_MSG_RETURN(callback_params->db_instance != nullptr, ERROR_NODE_KEY_CANNOT_BE_NULL, 1);
-    uint32_t db_instance = callback_params->db_instance->GuidIndex();
     ProfileDatabase* db = (ProfileDatabase*)callback_params->db;
     if(callback_params->future->Interrupted()) return SQLITE_ABORT;
-    //std::string guid = db->Sqlite3ColumnText(func, stmt, azColName,kRpvDbTrackLoadGuid);
-    //db->m_add_track_mutex.lock(guid);
-    db->m_add_track_mutex.lock(callback_params->db_instance->GuidIndex());
     track_params.track_indentifiers.db_instance = callback_params->db_instance;
     track_params.load_id.insert(callback_params->track_id);
-    track_params.track_indentifiers.track_id = (rocprofvis_dm_track_id_t)db->NumTracks();
     track_params.track_indentifiers.category = (rocprofvis_dm_track_category_t)db->Sqlite3ColumnInt(func, stmt, azColName,kRpvDbTrackLoadCategory);
     track_params.op = static_cast<rocprofvis_dm_op_t>(track_params.record_count=db->Sqlite3ColumnInt(func, stmt, azColName,kRpvDbTrackLoadOp));
     track_params.track_indentifiers.process_id = db->Sqlite3ColumnInt(func, stmt, azColName,kRpvDbTrackLoadPID);
     track_params.record_count=db->Sqlite3ColumnInt(func, stmt, azColName,kRpvDbTrackLoadRecordCount);
-    if (track_params.op < kRocProfVisDmNumOperation)
-    {
-        db->TraceProperties()->events_count[track_params.op] += track_params.record_count;
-    }
     track_params.min_ts=db->Sqlite3ColumnInt64(func, stmt, azColName,kRpvDbTrackLoadMinTs);
     track_params.max_ts=db->Sqlite3ColumnInt64(func, stmt, azColName,kRpvDbTrackLoadMaxTs);
     track_params.min_value=db->Sqlite3ColumnDouble(func, stmt, azColName,kRpvDbTrackLoadMinValue);
     track_params.max_value=db->Sqlite3ColumnDouble(func, stmt, azColName,kRpvDbTrackLoadMaxValue);
 
-    db->TraceProperties()->db_inst_start_time[db_instance] = std::min(db->TraceProperties()->db_inst_start_time[db_instance], track_params.min_ts);
-    db->TraceProperties()->db_inst_end_time[db_instance]  = std::max(db->TraceProperties()->db_inst_end_time[db_instance],track_params.max_ts);
-
-    db->TraceProperties()->trace_duration  = std::max(db->TraceProperties()->trace_duration,db->TraceProperties()->db_inst_end_time[db_instance]-db->TraceProperties()->db_inst_start_time[db_instance]);
-
     track_params.track_indentifiers.id[TRACK_ID_NODE] = db->Sqlite3ColumnInt64(func, stmt, azColName,kRpvDbTrackLoadNodeId);
     track_params.track_indentifiers.id[TRACK_ID_PID_OR_AGENT] = db->Sqlite3ColumnInt64(func, stmt, azColName,kRpvDbTrackLoadProcessId);
     track_params.track_indentifiers.is_numeric[TRACK_ID_NODE] = true;
@@ -233,12 +213,64 @@ int ProfileDatabase::CallBackLoadTrack(void *data, int argc, sqlite3_stmt* stmt,
     track_params.track_indentifiers.tag[TRACK_ID_PID_OR_AGENT] = db->Sqlite3ColumnText(func, stmt, azColName,kRpvDbTrackLoadProcessTag);
     track_params.track_indentifiers.tag[TRACK_ID_TID_OR_QUEUE] = db->Sqlite3ColumnText(func, stmt, azColName,kRpvDbTrackLoadSubprocessTag);
 
-    db->ProcessTrack(track_params, callback_params->query);
+    db->CollectTrack(callback_params, track_params, true);
 
     callback_params->future->CountThisRow();
     return 0;
 }
 
+void ProfileDatabase::BeginTrackDiscovery(uint32_t num_instances, uint32_t num_stages)
+{
+    m_num_discovery_instances = num_instances;
+    m_discovered_tracks.clear();
+    m_discovered_tracks.resize(num_instances * num_stages);
+}
+
+void ProfileDatabase::CollectTrack(rocprofvis_db_sqlite_callback_parameters* callback_params, rocprofvis_dm_track_params_t& track_params, bool restored)
+{
+    // every load stage of a database instance has its own entry, no lock is needed
+    uint32_t index = callback_params->track_id * m_num_discovery_instances + callback_params->db_instance->GuidIndex();
+    ROCPROFVIS_ASSERT_MSG_RETURN(index < m_discovered_tracks.size(), ERROR_INDEX_OUT_OF_RANGE, );
+    DiscoveredTracks& discovered = m_discovered_tracks[index];
+    if (discovered.tracks.empty())
+    {
+        discovered.query = callback_params->query;
+    }
+    discovered.restored = restored;
+    discovered.tracks.push_back(std::move(track_params));
+}
+
+rocprofvis_dm_result_t ProfileDatabase::MergeDiscoveredTracks()
+{
+    rocprofvis_dm_result_t result = kRocProfVisDmResultSuccess;
+    for (DiscoveredTracks& discovered : m_discovered_tracks)
+    {
+        for (rocprofvis_dm_track_params_t& track_params : discovered.tracks)
+        {
+            if (track_params.op < kRocProfVisDmNumOperation)
+            {
+                TraceProperties()->events_count[track_params.op] += track_params.record_count;
+            }
+            if (discovered.restored)
+            {
+                uint32_t db_instance = ((DbInstance*)track_params.track_indentifiers.db_instance)->GuidIndex();
+                TraceProperties()->db_inst_start_time[db_instance] = std::min(TraceProperties()->db_inst_start_time[db_instance], track_params.min_ts);
+                TraceProperties()->db_inst_end_time[db_instance]  = std::max(TraceProperties()->db_inst_end_time[db_instance],track_params.max_ts);
+                TraceProperties()->trace_duration  = std::max(TraceProperties()->trace_duration,TraceProperties()->db_inst_end_time[db_instance]-TraceProperties()->db_inst_start_time[db_instance]);
+            }
+            track_params.track_indentifiers.track_id = (rocprofvis_dm_track_id_t)NumTracks();
+            if (ProcessTrack(track_params, discovered.query) != 0)
+            {
+                result = kRocProfVisDmResultUnknownError;
+                break;
+            }
+        }
+        if (result != kRocProfVisDmResultSuccess) break;
+    }
+    m_discovered_tracks.clear();
+    return result;
+}
+
 int
 ProfileDatabase::CallbackGetTrackRecordsCount(void* data, int argc, sqlite3_stmt* stmt,
         char** azColName)
@@ -318,6 +350,9 @@ int ProfileDatabase::CallbackAddAnyRecord(void* data, int argc, sqlite3_stmt* st
     ProfileDatabase* db = (ProfileDatabase*)callback_params->db;
     if(callback_params->future->Interrupted()) return SQLITE_ABORT;
     uint32_t track = db->Sqlite3ColumnInt(func, stmt, azColName, argc-1);
+    slice_array_t* slices = (slice_array_t*) callback_params->handle;
+    auto it_slice = slices->find(track);
+    if (it_slice == slices->end()) return 0;
     rocprofvis_db_record_data_t record;
     record.event.id.bitfield.event_op = db->Sqlite3ColumnInt(func, stmt, azColName, 0);
     record.event.id.bitfield.event_node = callback_params->db_instance->GuidIndex();
@@ -339,7 +374,7 @@ int ProfileDatabase::CallbackAddAnyRecord(void* data, int argc, sqlite3_stmt* st
         callback_params->future->SetRuntimeStorageValue(kRPVFutureStorageSampleValue, record.pmc.value);
     }
     if(db->BindObject()->FuncAddRecord(
-        (*(slice_array_t*) callback_params->handle)[track],
+        it_slice->second,
         record) != kRocProfVisDmResultSuccess)
         return 1;
     callback_params->future->CountThisRow();
@@ -716,20 +751,43 @@ void ProfileDatabase::BuildSliceQueryMap(
         }
         q += tuple;
         q += " IN (";
-        tuple = "(";
-        for (int k = 0; k < NUMBER_OF_TRACK_IDENTIFICATION_PARAMETERS; k++) {
-            if (props->track_indentifiers.tag[k] != "const") {
-                if (tuple.length() > 1) tuple += ",";
-                std::string id = props->track_indentifiers.is_numeric[k] ? std::to_string(props->track_indentifiers.id[k]) : std::string("'") + props->track_indentifiers.name[k] + "'";
-                tuple += id;
-
-            }
-        }
-        tuple += ")";
         DbInstance* instance = (DbInstance*)props->track_indentifiers.db_instance;
         if (slice_query_map[q][instance->GuidIndex()].length() > 0) slice_query_map[q][instance->GuidIndex()] += ", ";
-        slice_query_map[q][instance->GuidIndex()] += tuple;
+        slice_query_map[q][instance->GuidIndex()] += BuildTrackIdTuple(props);
+    }
+}
+
+std::string ProfileDatabase::BuildTrackIdTuple(rocprofvis_dm_track_params_t* props)
+{
+    std::string tuple = "(";
+    for (int k = 0; k < NUMBER_OF_TRACK_IDENTIFICATION_PARAMETERS; k++) {
+        if (props->track_indentifiers.tag[k] != "const") {
+            if (tuple.length() > 1) tuple += ",";
+            std::string id = props->track_indentifiers.is_numeric[k] ? std::to_string(props->track_indentifiers.id[k]) : std::string("'") + props->track_indentifiers.name[k] + "'";
+            tuple += id;
+
+        }
     }
+    tuple += ")";
+    return tuple;
+}
+
+rocprofvis_dm_string_t ProfileDatabase::BuildSliceTrackCondition(rocprofvis_dm_track_params_t* props)
+{
+    // Row values are compared to track identifiers the same way as the IN list of the slice query
+    std::string tuple = "(";
+    for (int k = 0; k < NUMBER_OF_TRACK_IDENTIFICATION_PARAMETERS; k++) {
+        if (props->track_indentifiers.tag[k] != "const") {
+            if (tuple.length() > 1) tuple += ",";
+            tuple += props->track_indentifiers.tag[k];
+        }
+    }
+    tuple += ")";
+    if (tuple.length() == 2)
+    {
+        return "";
+    }
+    return tuple + "=" + BuildTrackIdTuple(props);
 }
 
 
@@ -1109,8 +1167,6 @@ rocprofvis_dm_result_t ProfileDatabase::BuildHistogram(Future* future, uint32_t
         double bucket_value;
     } store_params;
 
-    rocprofvis_dm_result_t result = kRocProfVisDmResultSuccess;
-
     uint64_t trace_length = TraceProperties()->trace_duration;
 
     uint64_t bucket_size = (trace_length + desired_bins) / desired_bins;
@@ -1125,27 +1181,29 @@ rocprofvis_dm_result_t ProfileDatabase::BuildHistogram(Future* future, uint32_t
     const char* histogram_table_name = GetMetadataVersionControl()->GetHistogramTableName();
     
 
-    for (auto& file_node : m_db_nodes)
+    // Every file loads or rebuilds the histogram of its own tracks in its own thread,
+    // tracks of one file are never touched by another file's thread
+    std::vector<rocprofvis_dm_result_t> results(m_db_nodes.size(), kRocProfVisDmResultSuccess);
+    auto task = [&](uint32_t file_node_id)
     {
+        rocprofvis_dm_result_t result = kRocProfVisDmResultSuccess;
         std::vector<store_params> v;
-        TemporaryDbInstance db_instance(file_node->node_id);
-        if (false == GetMetadataVersionControl()->MustRebuildHistogram(file_node->node_id))
+        TemporaryDbInstance db_instance(file_node_id);
+        if (false == GetMetadataVersionControl()->MustRebuildHistogram(file_node_id))
         {
-            result = ExecuteSQLQuery(future, &db_instance, (std::string("SELECT * FROM ") + histogram_table_name).c_str(), &CallBackLoadHistogram);
+            Future* sub_future = future->AddSubFuture();
+            result = ExecuteSQLQuery(sub_future, &db_instance, (std::string("SELECT * FROM ") + histogram_table_name).c_str(), &CallBackLoadHistogram);
+            future->DeleteSubFuture(sub_future);
         }
         else
         {
             guid_list_t guids_per_file;
 
-            for (int i = 0; i < NumTracks(); i++)
+            for (GuidInfo& guid_info : DbInstances())
             {
-                DbInstance* track_db_instance = (DbInstance*)TrackPropertiesAt(i)->track_indentifiers.db_instance;
-                for (GuidInfo& guid_info : DbInstances())
+                if (guid_info.first.FileIndex() == file_node_id)
                 {
-                    if (guid_info.first.FileIndex() == track_db_instance->FileIndex())
-                    {
-                        guids_per_file.push_back(guid_info);
-                    }
+                    guids_per_file.push_back(guid_info);
                 }
             }
 
@@ -1188,6 +1246,11 @@ rocprofvis_dm_result_t ProfileDatabase::BuildHistogram(Future* future, uint32_t
                 // use last known value for all missing buckets in counter's track histogram
                 for (int i = 0; i < NumTracks(); i++)
                 {
+                    DbInstance* track_db_instance = (DbInstance*)TrackPropertiesAt(i)->track_indentifiers.db_instance;
+                    if (file_node_id != track_db_instance->FileIndex())
+                    {
+                        continue;
+                    }
                     auto & data = TrackPropertiesAt(i)->histogram;
 
                     if (data.size() > 1)
@@ -1215,7 +1278,7 @@ rocprofvis_dm_result_t ProfileDatabase::BuildHistogram(Future* future, uint32_t
                 for (int i = 0; i < NumTracks(); i++)
                 {
                     DbInstance* track_db_instance = (DbInstance*)TrackPropertiesAt(i)->track_indentifiers.db_instance;
-                    if (file_node->node_id == track_db_instance->FileIndex())
+                    if (file_node_id == track_db_instance->FileIndex())
                     {
                         for (auto& [key, value] : TrackPropertiesAt(i)->histogram)
                         {
@@ -1241,11 +1304,21 @@ rocprofvis_dm_result_t ProfileDatabase::BuildHistogram(Future* future, uint32_t
                         sqlite3_bind_int(stmt, 4, p.events_count);
                         sqlite3_bind_double(stmt, 5, p.bucket_value);
                     },
-                    file_node->node_id);
+                    file_node_id);
 
             }        
         }      
+        results[file_node_id] = result;
+    };
+
+    std::vector<std::thread> threads;
+    for (auto& file_node : m_db_nodes)
+    {
+        threads.emplace_back(task, file_node->node_id);
     }
+    for (auto& t : threads)
+        t.join();
+
     for (int i = 0; i < NumTracks(); i++)
     {
         for (auto& [key, value] : TrackPropertiesAt(i)->histogram)
@@ -1253,7 +1326,14 @@ rocprofvis_dm_result_t ProfileDatabase::BuildHistogram(Future* future, uint32_t
             TraceProperties()->histogram[key] += value.first;
         }
     }
-    return result;
+    for (auto file_result : results)
+    {
+        if (file_result != kRocProfVisDmResultSuccess)
+        {
+            return file_result;
+        }
+    }
+    return kRocProfVisDmResultSuccess;
 }
 
 void
@@ -76,6 +76,8 @@ class ProfileDatabase : public QueryManager
              slice_query_map_t& slice_query_map, 
              rocprofvis_dm_track_params_t* props,
              rocprofvis_db_query_type_t query_type) override;
+        rocprofvis_dm_string_t BuildSliceTrackCondition(
+            rocprofvis_dm_track_params_t* props) override;
     
 
         // method to build a query to read time slice of records for single track 
@@ -150,6 +152,18 @@ class ProfileDatabase : public QueryManager
         // build histogram
         rocprofvis_dm_result_t BuildHistogram(Future* future, uint32_t desired_bins);
 
+        // prepare track discovery of num_stages load stages for num_instances database instances.
+        // Discovery callbacks only collect track parameters, so database files can be discovered in parallel
+        void BeginTrackDiscovery(uint32_t num_instances, uint32_t num_stages);
+
+        // keep track parameters found by discovery callback, called by one thread per load stage and database instance
+        // @param restored - true if parameters are loaded from saved track information
+        void CollectTrack(rocprofvis_db_sqlite_callback_parameters* callback_params, rocprofvis_dm_track_params_t& track_params, bool restored);
+
+        // add collected tracks in order of load stage, then database instance, which is the order of a sequential load
+        // @return status of operation
+        rocprofvis_dm_result_t MergeDiscoveredTracks();
+
         // hash histogram query and schema for version control 
         uint64_t GetHistogramQueryAndSchemaHash();
 
@@ -167,10 +181,24 @@ class ProfileDatabase : public QueryManager
         std::unordered_map<uint32_t, std::vector<rocprofvis_db_event_level_t>> m_event_levels[kRocProfVisDmNumOperation];
         std::unordered_map<uint32_t, std::unordered_map<uint64_t, size_t>> m_event_levels_id_to_index[kRocProfVisDmNumOperation];
         std::mutex   m_level_lock;
-        OrderedMutex m_add_track_mutex;
         std::mutex m_lock;
 
     private:
+        // track parameters found by discovery of one load stage and database instance
+        struct DiscoveredTracks {
+            // track queries of the load stage
+            std::vector<rocprofvis_dm_string_t> query;
+            std::vector<rocprofvis_dm_track_params_t> tracks;
+            // parameters are loaded from saved track information
+            bool restored = false;
+        };
+        // indexed by load stage, then database instance
+        std::vector<DiscoveredTracks> m_discovered_tracks;
+        uint32_t m_num_discovery_instances = 1;
+
+        // builds "(id1,id2,...)" tuple of track identifiers, matching the tuple of track tags
+        static std::string BuildTrackIdTuple(rocprofvis_dm_track_params_t* props);
+
         inline static SQLInsertParams s_histogram_schema_params = { 
             { "id", "INTEGER PRIMARY KEY" },
             { "track_number", "INTEGER" },
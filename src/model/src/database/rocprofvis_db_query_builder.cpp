@@ -112,6 +112,11 @@ namespace DataModel
         return BuildQuery("SELECT DISTINCT ", params.NUM_PARAMS, params.parameters, params.from,
              "");
     }
+    std::string Builder::Select(rocprofvis_db_sqlite_kernel_stats_query_format params) 
+    {
+        return BuildQuery(g_select_str, params.NUM_PARAMS, params.parameters, params.from,
+             "");
+    }
     
 
     std::string Builder::SelectAll(std::string query)
@@ -154,6 +154,13 @@ typedef struct rocprofvis_db_sqlite_stream_to_hw_format
     std::vector<std::string>   from;
 } rocprofvis_db_sqlite_stream_to_hw_format;
 
+typedef struct rocprofvis_db_sqlite_kernel_stats_query_format
+{
+    static constexpr const int NUM_PARAMS = 5;
+    std::string                parameters[NUM_PARAMS];
+    std::vector<std::string>   from;
+} rocprofvis_db_sqlite_kernel_stats_query_format;
+
 typedef struct rocprofvis_db_perfetto_slice_query_format
 {
     static constexpr const int NUM_PARAMS = 9;
@@ -186,6 +193,7 @@ class Builder
         static constexpr const char* STREAM_ID_SERVICE_NAME = "streamId";
         static constexpr const char* NODE_ID_SERVICE_NAME = "nodeId";
         static constexpr const char* NODE_ID_PUBLIC_NAME = "nodeId";
+        static constexpr const char* KERNEL_ID_SERVICE_NAME = "kernelId";
         static constexpr const char* OPERATION_SERVICE_NAME = "__op";
         static constexpr const char* TRACK_CATEGORY_SERVICE_NAME = "trackCategory";
         static constexpr const char* CATEGORY_PUBLIC_NAME = "category";
@@ -448,6 +456,7 @@ class Builder
         static std::string Select(rocprofvis_db_sqlite_essential_data_query_format params);
         static std::string Select(rocprofvis_db_sqlite_argument_data_query_format params);
         static std::string Select(rocprofvis_db_sqlite_stream_to_hw_format params);
+        static std::string Select(rocprofvis_db_sqlite_kernel_stats_query_format params);
         static std::string Select(rocprofvis_db_sqlite_memory_alloc_activity_query_format);
         static std::string Select(rocprofvis_db_sqlite_mem_act_subquery_format params);
         static std::string Select(rocprofvis_db_perfetto_slice_query_format params);
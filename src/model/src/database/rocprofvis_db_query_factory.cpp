@@ -1991,6 +1991,231 @@ namespace DataModel
         }
     }
 
+    // Flow endpoints of all events sharing correlation (stack) id with a GPU operation.
+    // Second column carries the stack id, used to pair launch with dispatch, memory copy and memory allocation endpoints
+    std::string QueryFactory::GetRocprofDataFlowIndexQuery()
+    {
+        std::string gpu_stack_ids = std::string("SELECT E2.stack_id") + 
+            Builder::From("rocpd_event", "E2") + 
+            Builder::InnerJoin("rocpd_kernel_dispatch", "K2", "K2.event_id = E2.id") +
+            " UNION SELECT E2.stack_id" + 
+            Builder::From("rocpd_event", "E2") + 
+            Builder::InnerJoin("rocpd_memory_copy", "M2", "M2.event_id = E2.id") +
+            " UNION SELECT E2.stack_id" + 
+            Builder::From("rocpd_event", "E2") + 
+            Builder::InnerJoin("roc_optiq_memory_allocate", "M2", "M2.event_id = E2.id");
+
+        if (IsVersionGreaterOrEqual("4"))
+        {
+            return Builder::SelectAll(
+                Builder::Select(rocprofvis_db_sqlite_dataflow_query_format(
+                    { {
+                            Builder::QParamOperation(kRocProfVisDmOperationLaunch),
+                            Builder::QParam("E.stack_id", "id"),
+                            Builder::QParam("R.id"),
+                            Builder::QParam("T.nid", Builder::NODE_ID_SERVICE_NAME),
+                            Builder::QParam("T.pid", Builder::PROCESS_ID_SERVICE_NAME),
+                            Builder::QParam("T.tid", Builder::THREAD_ID_SERVICE_NAME),
+                            Builder::QParam("TS.value", "start"),
+                            Builder::QParam("E.category_id"),
+                            Builder::QParam("R.name_id"),
+                            Builder::QParam("L.level"),
+                            Builder::QParam("TE.value", "end"),
+                        },
+                    { 
+                        Builder::From("rocpd_region", "R"),
+                        Builder::InnerJoin("rocpd_event", "E", "R.event_id = E.id AND E.stack_id != 0"),
+                        Builder::InnerJoin("rocpd_track", "T", "T.id = R.track_id"),
+                        Builder::InnerJoin("rocpd_timestamp", "TS", "TS.id = R.start_id"),
+                        Builder::InnerJoin("rocpd_timestamp", "TE", "TE.id = R.end_id"), 
+                        Builder::InnerJoin(Builder::LevelTable("launch"), "L", "R.id = L.eid") },
+                    { Builder::Where(
+                        "E.stack_id", " IN ", "(" + gpu_stack_ids + ")")
+                    } })) +
+                Builder::Union() +
+                Builder::Select(rocprofvis_db_sqlite_dataflow_query_format(
+                    { {
+                            Builder::QParamOperation(kRocProfVisDmOperationDispatch),
+                            Builder::QParam("E.stack_id"),
+                            Builder::QParam("K.id"),
+                            Builder::QParam("T.nid", Builder::NODE_ID_SERVICE_NAME),
+                            Builder::QParam("T.agent_id", Builder::AGENT_ID_SERVICE_NAME),
+                            Builder::QParam("T.queue_id", Builder::QUEUE_ID_SERVICE_NAME),
+                            Builder::QParam("TS.value"),
+                            Builder::QParam("E.category_id"),
+                            Builder::QParam("K.kernel_id"),
+                            Builder::QParam("L.level"),
+                            Builder::QParam("TE.value"),
+                        },
+                    { 
+                        Builder::From("rocpd_kernel_dispatch", "K"),
+                        Builder::InnerJoin("rocpd_event", "E", "K.event_id = E.id AND E.stack_id != 0"),
+                        Builder::InnerJoin("rocpd_track", "T", "T.id = K.track_id"),
+                        Builder::InnerJoin("rocpd_timestamp", "TS", "TS.id = K.start_id"),
+                        Builder::InnerJoin("rocpd_timestamp", "TE", "TE.id = K.end_id"),
+                        Builder::InnerJoin(Builder::LevelTable("dispatch"), "L", "K.id = L.eid") },
+                    { Builder::Blank() } })) +
+                Builder::Union() +
+                Builder::Select(rocprofvis_db_sqlite_dataflow_query_format(
+                    { {
+                            Builder::QParamOperation(kRocProfVisDmOperationMemoryCopy),
+                            Builder::QParam("E.stack_id"),
+                            Builder::QParam("M.id"),
+                            Builder::QParam("T.nid", Builder::NODE_ID_SERVICE_NAME),
+                            Builder::QParam("M.dst_agent_id", Builder::AGENT_ID_SERVICE_NAME),
+                            Builder::QParam("T.queue_id", Builder::QUEUE_ID_SERVICE_NAME),
+                            Builder::QParam("TS.value"),
+                            Builder::QParam("E.category_id"),
+                            Builder::QParam("M.name_id"),
+                            Builder::QParam("L.level"),
+                            Builder::QParam("TE.value"),
+                        },
+                    { 
+                        Builder::From("rocpd_memory_copy", "M"),
+                        Builder::InnerJoin("rocpd_event", "E", "M.event_id = E.id AND E.stack_id != 0"),
+                        Builder::InnerJoin("rocpd_track", "T", "T.id = M.track_id"),
+                        Builder::InnerJoin("rocpd_timestamp", "TS", "TS.id = M.start_id"),
+                        Builder::InnerJoin("rocpd_timestamp", "TE", "TE.id = M.end_id"), 
+                        Builder::InnerJoin(Builder::LevelTable("mem_copy"), "L", "M.id = L.eid") },
+                    { Builder::Blank() } })) +
+                Builder::Union() +
+                Builder::Select(rocprofvis_db_sqlite_dataflow_query_format(
+                    { {
+                            Builder::QParamOperation(kRocProfVisDmOperationMemoryAllocate),
+                            Builder::QParam("E.stack_id"),
+                            Builder::QParam("M.id"),
+                            Builder::QParam("T.nid", Builder::NODE_ID_SERVICE_NAME),
+                            Builder::QParam("T.agent_id", Builder::AGENT_ID_SERVICE_NAME),
+                            Builder::QParam("T.queue_id", Builder::QUEUE_ID_SERVICE_NAME),
+                            Builder::QParam("TS.value"),
+                            Builder::QParam("E.category_id"),
+                            Builder::QParam("E.category_id"), // This should be name_id, but Alloc table does not have column
+                            Builder::QParam("L.level"),
+                            Builder::QParam("TE.value"),
+                        },
+                    { 
+                        Builder::From("roc_optiq_memory_allocate", "M"),
+                        Builder::InnerJoin("rocpd_event", "E", "M.event_id = E.id AND E.stack_id != 0"),
+                        Builder::InnerJoin("rocpd_track", "T", "T.id = M.track_id"),
+                        Builder::InnerJoin("rocpd_timestamp", "TS", "TS.id = M.start_id"),
+                        Builder::InnerJoin("rocpd_timestamp", "TE", "TE.id = M.end_id"),
+                        Builder::InnerJoin(Builder::LevelTable("mem_alloc"), "L", "M.id = L.eid") },
+                    { Builder::Blank() } })));
+        }
+        else
+        {
+            return Builder::SelectAll(
+                Builder::Select(rocprofvis_db_sqlite_dataflow_query_format(
+                    { {
+                            Builder::QParamOperation(kRocProfVisDmOperationLaunch),
+                            Builder::QParam("E.stack_id", "id"),
+                            Builder::QParam("R.id"),
+                            Builder::QParam("R.nid", Builder::NODE_ID_SERVICE_NAME),
+                            Builder::QParam("R.pid", Builder::PROCESS_ID_SERVICE_NAME),
+                            Builder::QParam("R.tid", Builder::THREAD_ID_SERVICE_NAME),
+                            Builder::QParam("R.start"),
+                            Builder::QParam("E.category_id"),
+                            Builder::QParam("R.name_id"),
+                            Builder::QParam("L.level"),
+                            Builder::QParam("R.end"),
+                        },
+                    { 
+                        Builder::From("rocpd_region", "R"),
+                        Builder::InnerJoin("rocpd_event", "E", "R.event_id = E.id AND E.stack_id != 0"),
+                        Builder::InnerJoin(Builder::LevelTable("launch"), "L", "R.id = L.eid") },
+                    { Builder::Where(
+                        "E.stack_id", " IN ", "(" + gpu_stack_ids + ")")
+                    } })) +
+                Builder::Union() +
+                Builder::Select(rocprofvis_db_sqlite_dataflow_query_format(
+                    { {
+                            Builder::QParamOperation(kRocProfVisDmOperationDispatch),
+                            Builder::QParam("E.stack_id"),
+                            Builder::QParam("K.id"),
+                            Builder::QParam("K.nid", Builder::NODE_ID_SERVICE_NAME),
+                            Builder::QParam("K.agent_id", Builder::AGENT_ID_SERVICE_NAME),
+                            Builder::QParam("K.queue_id", Builder::QUEUE_ID_SERVICE_NAME),
+                            Builder::QParam("K.start"),
+                            Builder::QParam("E.category_id"),
+                            Builder::QParam("K.kernel_id"),
+                            Builder::QParam("L.level"),
+                            Builder::QParam("K.end"),
+                        },
+                    { 
+                        Builder::From("rocpd_kernel_dispatch", "K"),
+                        Builder::InnerJoin("rocpd_event", "E", "K.event_id = E.id AND E.stack_id != 0"),
+                        Builder::InnerJoin(Builder::LevelTable("dispatch"), "L", "K.id = L.eid") },
+                    { Builder::Blank() } })) +
+                Builder::Union() +
+                Builder::Select(rocprofvis_db_sqlite_dataflow_query_format(
+                    { {
+                            Builder::QParamOperation(kRocProfVisDmOperationMemoryCopy),
+                            Builder::QParam("E.stack_id"),
+                            Builder::QParam("M.id"),
+                            Builder::QParam("M.nid", Builder::NODE_ID_SERVICE_NAME),
+                            Builder::QParam("M.dst_agent_id", Builder::AGENT_ID_SERVICE_NAME),
+                            Builder::QParam("M.queue_id", Builder::QUEUE_ID_SERVICE_NAME),
+                            Builder::QParam("M.start"),
+                            Builder::QParam("E.category_id"),
+                            Builder::QParam("M.name_id"),
+                            Builder::QParam("L.level"),
+                            Builder::QParam("M.end"),
+                        },
+                    { 
+                        Builder::From("rocpd_memory_copy", "M"),
+                        Builder::InnerJoin("rocpd_event", "E", "M.event_id = E.id AND E.stack_id != 0"),
+                        Builder::InnerJoin(Builder::LevelTable("mem_copy"), "L", "M.id = L.eid") },
+                    { Builder::Blank() } })) +
+                Builder::Union() +
+                Builder::Select(rocprofvis_db_sqlite_dataflow_query_format(
+                    { {
+                            Builder::QParamOperation(kRocProfVisDmOperationMemoryAllocate),
+                            Builder::QParam("E.stack_id"),
+                            Builder::QParam("M.id"),
+                            Builder::QParam("M.nid", Builder::NODE_ID_SERVICE_NAME),
+                            Builder::QParam("M.agent_id", Builder::AGENT_ID_SERVICE_NAME),
+                            Builder::QParam("M.queue_id", Builder::QUEUE_ID_SERVICE_NAME),
+                            Builder::QParam("M.start"),
+                            Builder::QParam("E.category_id"),
+                            Builder::QParam("E.category_id"), // This should be name_id, but Alloc table does not have column
+                            Builder::QParam("L.level"),
+                            Builder::QParam("M.end"),
+                        },
+                    { 
+                        Builder::From("roc_optiq_memory_allocate", "M"),
+                        Builder::InnerJoin("rocpd_event", "E", "M.event_id = E.id AND E.stack_id != 0"),
+                        Builder::InnerJoin(Builder::LevelTable("mem_alloc"), "L", "M.id = L.eid") },
+                    { Builder::Blank() } })));
+        }
+    }
+
+    std::string QueryFactory::GetRocprofKernelStatsQuery()
+    {
+        if (IsVersionGreaterOrEqual("4"))
+        {
+            return Builder::Select(rocprofvis_db_sqlite_kernel_stats_query_format(
+                { { Builder::QParam("K.kernel_id", Builder::KERNEL_ID_SERVICE_NAME),
+                    Builder::QParam("T.nid", Builder::NODE_ID_SERVICE_NAME),
+                    Builder::QParam("T.agent_id", Builder::AGENT_ID_SERVICE_NAME),
+                    Builder::QParam("TS.value", Builder::START_SERVICE_NAME),
+                    Builder::QParam("TE.value", Builder::END_SERVICE_NAME) },
+                { Builder::From("rocpd_kernel_dispatch", "K"),
+                    Builder::InnerJoin("rocpd_track", "T", "T.id = K.track_id"),
+                    Builder::InnerJoin("rocpd_timestamp", "TS", "TS.id = K.start_id"),
+                    Builder::InnerJoin("rocpd_timestamp", "TE", "TE.id = K.end_id") } }));
+        }
+        else
+        {
+            return Builder::Select(rocprofvis_db_sqlite_kernel_stats_query_format(
+                { { Builder::QParam("K.kernel_id", Builder::KERNEL_ID_SERVICE_NAME),
+                    Builder::QParam("K.nid", Builder::NODE_ID_SERVICE_NAME),
+                    Builder::QParam("K.agent_id", Builder::AGENT_ID_SERVICE_NAME),
+                    Builder::QParam("K.start", Builder::START_SERVICE_NAME),
+                    Builder::QParam("K.end", Builder::END_SERVICE_NAME) },
+                { Builder::From("rocpd_kernel_dispatch", "K") } }));
+        }
+    }
+
     std::string QueryFactory::GetRocprofEssentialInfoQueryForRegionEvent(uint64_t event_id, bool is_sample_track) {
         if (IsVersionGreaterOrEqual("4"))
         {
@@ -28,6 +28,7 @@ public:
     std::string GetRocprofKernelDispatchSliceQuery();
     std::string GetRocprofKernelDispatchSliceQueryForStream();
     std::string GetRocprofKernelDispatchTableQuery();
+    std::string GetRocprofKernelStatsQuery();
 
     std::string GetRocprofMemoryAllocTrackQuery();
     std::string GetRocprofMemoryAllocTrackQueryForStream();
@@ -65,6 +66,7 @@ public:
     std::string GetRocprofDataFlowQueryForKernelDispatchEvent(uint64_t event_id);
     std::string GetRocprofDataFlowQueryForMemoryAllocEvent(uint64_t event_id);
     std::string GetRocprofDataFlowQueryForMemoryCopyEvent(uint64_t event_id);
+    std::string GetRocprofDataFlowIndexQuery();
 
     std::string GetRocprofEssentialInfoQueryForRegionEvent(uint64_t event_id, bool is_sample_track);
     std::string GetRocprofEssentialInfoQueryForKernelDispatchEvent(uint64_t event_id);
@@ -94,7 +94,6 @@ int QueryManager::CallbackRunQuery(void *data, int argc, sqlite3_stmt* stmt, cha
 
 
 rocprofvis_dm_result_t QueryManager::BuildSliceQuery(rocprofvis_dm_timestamp_t start, rocprofvis_dm_timestamp_t end, rocprofvis_db_num_of_tracks_t num, rocprofvis_db_track_selection_t tracks, rocprofvis_dm_string_t& query, slice_array_t& slices) {
-    (void) num;
     slice_query_map_t slice_query_map;
     bool timed_query = false;
     bool pmc_query = false;
@@ -109,15 +108,38 @@ rocprofvis_dm_result_t QueryManager::BuildSliceQuery(rocprofvis_dm_timestamp_t s
     {
         pmc_query = true;
     }
-    BuildSliceQueryMap(slice_query_map, props, props->track_indentifiers.category ==  kRocProfVisDmStreamTrack? kRPVRocpdQuerySliceByStream : kRPVRocpdQuerySliceByQueue);
-    if (start > props->min_ts || end < props->max_ts)
+
+    // Rows of a multi-track query are matched back to their track by the track identifiers
+    std::string track_id = std::to_string(*tracks);
+    if (num > 1)
     {
-        timed_query = true;
+        track_id = "CASE";
+    }
+    for (uint32_t i = 0; i < num; i++)
+    {
+        props = TrackPropertiesAt(tracks[i]);
+        BuildSliceQueryMap(slice_query_map, props, props->track_indentifiers.category ==  kRocProfVisDmStreamTrack? kRPVRocpdQuerySliceByStream : kRPVRocpdQuerySliceByQueue);
+        if (start > props->min_ts || end < props->max_ts)
+        {
+            timed_query = true;
+        }
+        if (num > 1)
+        {
+            std::string condition = BuildSliceTrackCondition(props);
+            ROCPROFVIS_ASSERT_MSG_RETURN(!condition.empty(), ERROR_UNSUPPORTED_FEATURE, kRocProfVisDmResultNotSupported);
+            track_id += " WHEN ";
+            track_id += condition;
+            track_id += " THEN ";
+            track_id += std::to_string(tracks[i]);
+        }
+    }
+    if (num > 1)
+    {
+        track_id += " END";
     }
-
 
     query = "SELECT *, ";
-    query += std::to_string(*tracks);
+    query += track_id;
     query += " as track_id FROM(";
     for (auto it_query = slice_query_map.begin(); it_query != slice_query_map.end(); ++it_query) {
         if (it_query!=slice_query_map.begin()) query += " UNION ALL ";
@@ -605,9 +627,10 @@ rocprofvis_dm_result_t  QueryManager::ReadTraceSlice(
     ROCPROFVIS_ASSERT_MSG_RETURN(future, ERROR_FUTURE_CANNOT_BE_NULL, kRocProfVisDmResultInvalidParameter);
     ROCPROFVIS_ASSERT_MSG(BindObject()->trace_properties, ERROR_TRACE_PROPERTIES_CANNOT_BE_NULL);
     ROCPROFVIS_ASSERT_MSG(BindObject()->trace_properties->metadata_loaded, ERROR_METADATA_IS_NOT_LOADED);
-    // We never used multiple tracks request for single slice. And with multinode support it becomes very cumbersome. 
-    // Disabling this feature, but leave the interface untouched for now
-    ROCPROFVIS_ASSERT_MSG(num == 1, ERROR_UNSUPPORTED_FEATURE);
+    if (num > 1)
+    {
+        return ReadMultiTrackSlice(start, end, tag, num, tracks, future);
+    }
 
     rocprofvis_dm_track_params_t* props = TrackPropertiesAt(*tracks);
     if(props->track_indentifiers.category == kRocProfVisDmPmcTrack)
@@ -645,6 +668,55 @@ rocprofvis_dm_result_t  QueryManager::ReadTraceSlice(
     return future->SetPromise(future->Interrupted() ? kRocProfVisDmResultDbAbort : kRocProfVisDmResultDbAccessFailed);    
 }
 
+rocprofvis_dm_result_t QueryManager::ReadMultiTrackSlice(
+    rocprofvis_dm_timestamp_t start,
+    rocprofvis_dm_timestamp_t end,
+    rocprofvis_dm_hashed_timestamp_tag_t tag,
+    rocprofvis_db_num_of_tracks_t num,
+    rocprofvis_db_track_selection_t tracks,
+    Future* future) {
+    rocprofvis_dm_track_params_t* first = TrackPropertiesAt(*tracks);
+    for (uint32_t i = 0; i < num; i++)
+    {
+        rocprofvis_dm_track_params_t* props = TrackPropertiesAt(tracks[i]);
+        if (props->track_indentifiers.category == kRocProfVisDmPmcTrack ||
+            props->track_indentifiers.category != first->track_indentifiers.category ||
+            props->track_indentifiers.db_instance != first->track_indentifiers.db_instance ||
+            BuildSliceTrackCondition(props).empty())
+        {
+            return future->SetPromise(kRocProfVisDmResultNotSupported);
+        }
+    }
+
+    slice_array_t slices;
+    for (uint32_t i = 0; i < num; i++)
+    {
+        slices[tracks[i]] = BindObject()->FuncAddSlice(BindObject()->trace_object, tracks[i], start, end, tag);
+    }
+    std::string slice_query;
+    rocprofvis_dm_result_t result = BuildSliceQuery(start, end, num, tracks, slice_query, slices);
+    if (result == kRocProfVisDmResultSuccess)
+    {
+        result = ExecuteSQLQuery(future, (DbInstance*)first->track_indentifiers.db_instance, slice_query.c_str(), &slices, m_callback_add_any_record);
+    }
+    for (auto& slice : slices)
+    {
+        BindObject()->FuncCompleteSlice(slice.second);
+        if (result != kRocProfVisDmResultSuccess)
+        {
+            BindObject()->FuncRemoveSlice(BindObject()->trace_object, slice.first, slice.second);
+        }
+    }
+    if (result == kRocProfVisDmResultSuccess)
+    {
+        ShowProgress(100 - future->Progress(), "Time slices successfully loaded!", kRPVDbSuccess, future);
+        return future->SetPromise(kRocProfVisDmResultSuccess);
+    }
+
+    ShowProgress(0, "Not all tracks are loaded!", kRPVDbError, future );
+    return future->SetPromise(future->Interrupted() ? kRocProfVisDmResultDbAbort : kRocProfVisDmResultDbAccessFailed);
+}
+
 rocprofvis_dm_result_t
 QueryManager::ReadTracePMCSlice(rocprofvis_dm_timestamp_t            start,
     rocprofvis_dm_timestamp_t            end,
@@ -902,7 +974,8 @@ QueryManager::ExecuteQueriesAsync(
     std::vector<std::pair<DbInstance*, std::string>>& queries,
     Future* parent,
     rocprofvis_dm_handle_t handle,
-    RpvSqliteExecuteQueryCallback callback)
+    RpvSqliteExecuteQueryCallback callback,
+    std::function<void(uint32_t)> on_query_done)
 {
     rocprofvis_dm_result_t result = kRocProfVisDmResultSuccess;
     // Register each worker as a sub-future of the parent so it is reachable by
@@ -919,7 +992,7 @@ QueryManager::ExecuteQueriesAsync(
                 std::thread(ExecuteSQLQueryStaticWithHandle, this,
                     futures[i],
                     queries[i].first,
-                    queries[i].second.c_str(), handle, i, callback)));
+                    queries[i].second.c_str(), handle, i, callback, on_query_done)));
         } catch(const std::exception& ex)
         {
             // The worker thread never started, so the sub-future's promise will
@@ -1034,16 +1107,34 @@ rocprofvis_dm_result_t QueryManager::ExportTableCSV(rocprofvis_dm_charptr_t quer
     ROCPROFVIS_ASSERT_MSG_RETURN(future, ERROR_FUTURE_CANNOT_BE_NULL, kRocProfVisDmResultInvalidParameter);
     ROCPROFVIS_ASSERT_MSG_RETURN(BindObject()->trace_object, ERROR_TRACE_CANNOT_BE_NULL, kRocProfVisDmResultInvalidParameter);
     rocprofvis_dm_result_t result = kRocProfVisDmResultInvalidParameter;
+    std::unordered_map<uint32_t, std::unordered_map<std::string, rocprofvis_db_compound_query_info>> queries;
+    std::vector<rocprofvis_db_compound_query_command> commands;
+    std::set<uint32_t> tracks;
+    bool is_compound = TableProcessor::IsCompoundQuery(query, queries, tracks,  commands);
+    auto group_it = std::find_if(commands.begin(), commands.end(), [](rocprofvis_db_compound_query_command& cmd) { return cmd.name == "GROUP" && !cmd.parameter.empty(); });
+    if (is_compound && group_it == commands.end())
+    {
+        // Plain row export is streamed straight to the file, the table shown by the view is left untouched
+        ShowProgress(0, "Exporting table rows", kRPVDbBusy, future);
+        TableProcessor exporter(this);
+        result = exporter.ExportStreamed(future, queries, commands, file_path);
+        if (result == kRocProfVisDmResultSuccess)
+        {
+            ShowProgress(100, "CSV export success", kRPVDbSuccess, future);
+        }
+        else
+        {
+            ShowProgress(0, "CSV export failed", kRPVDbError, future);
+        }
+        return future->SetPromise(future->Interrupted() ? kRocProfVisDmResultDbAbort : result);
+    }
+    // Aggregated export is small, it is produced from the materialized table
     Future* internal_future = future->AddSubFuture();
     result = ExecuteQuery(query, "ExportTableCSV", internal_future);
     future->WaitAndDeleteSubFuture(internal_future);
     if (result == kRocProfVisDmResultSuccess)
     {
         rocprofvis_db_compound_table_type data_type = kRPVTableDataTypeEvent;
-        std::unordered_map<uint32_t, std::unordered_map<std::string, rocprofvis_db_compound_query_info>> queries;
-        std::vector<rocprofvis_db_compound_query_command> commands;
-        std::set<uint32_t> tracks;
-        TableProcessor::IsCompoundQuery(query, queries, tracks,  commands);
         auto it = std::find_if(commands.begin(), commands.end(), [](rocprofvis_db_compound_query_command& cmd) { return cmd.name == "TYPE"; });
         if (it != commands.end())
         {
@@ -241,6 +241,12 @@ class QueryManager : public SqliteDatabase
             rocprofvis_dm_track_params_t* props,
             rocprofvis_db_query_type_t query_type) = 0;
 
+        // builds SQL condition matching slice query rows of the track, used to split rows of multi-track slice query 
+        // @param props - track properties
+        // @return condition string or empty string if rows of different tracks cannot be distinguished
+        virtual rocprofvis_dm_string_t BuildSliceTrackCondition(
+            rocprofvis_dm_track_params_t* props) { (void) props; return ""; }
+
         // Searches for strings matching the passed in list of filter strings and builds a WHERE IN clause for the table query.
         // @param num_string_table_filters - number of filter strings
         // @param string_table_filters - array of filter strings
@@ -307,6 +313,21 @@ class QueryManager : public SqliteDatabase
             bool left_neighbor,
             bool right_neighbor,
             Future* object) override;
+        // worker method to read time slice of multiple tracks with one query
+        // All tracks must belong to the same database instance and track category
+        // @param start - start timestamp of time slice 
+        // @param end - end timestamp of time slice 
+        // @param num - number of tracks
+        // @param tracks - uint32_t array with track IDs  
+        // @param object - future object providing asynchronous execution mechanism   
+        // @return status of operation, kRocProfVisDmResultNotSupported if tracks cannot be read together 
+        rocprofvis_dm_result_t  ReadMultiTrackSlice(
+            rocprofvis_dm_timestamp_t start,
+            rocprofvis_dm_timestamp_t end,
+            rocprofvis_dm_hashed_timestamp_tag_t tag,
+            rocprofvis_db_num_of_tracks_t num,
+            rocprofvis_db_track_selection_t tracks,
+            Future* object);
 
         // ------------------------------SQL query callbacks-----------------------------------
         // @param data - pointer to callback caller argument
@@ -347,11 +368,13 @@ class QueryManager : public SqliteDatabase
             guid_list_t run_for_db_instances);
       
         // executes set of queries asynchronously
+        // on_query_done is called from the worker thread with the query index once the query has finished
         rocprofvis_dm_result_t ExecuteQueriesAsync(
             std::vector<std::pair<DbInstance*, std::string>>& queries,
             Future* parent,
             rocprofvis_dm_handle_t handle,
-            RpvSqliteExecuteQueryCallback callback);
+            RpvSqliteExecuteQueryCallback callback,
+            std::function<void(uint32_t)> on_query_done = nullptr);
 
         // needs to be defined as override. Used by public interface method
         rocprofvis_dm_result_t  ExecuteComputeQuery(
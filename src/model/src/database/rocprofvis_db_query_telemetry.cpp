@@ -0,0 +1,209 @@
+// Copyright Advanced Micro Devices, Inc.
+// SPDX-License-Identifier: MIT
+
+#include "rocprofvis_db_query_telemetry.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+namespace RocProfVis
+{
+namespace DataModel
+{
+
+QueryTelemetry::QueryTelemetry()
+: m_enabled(false)
+, m_slow_query_ms(DEFAULT_SLOW_QUERY_MS)
+{}
+
+// Appends placeholder, a list of literals like "IN (1, 2, 3)" collapses to a single '?'
+static void AppendPlaceholder(std::string& out)
+{
+    size_t len = out.length();
+    if(len >= 2 && out[len - 1] == ',' && out[len - 2] == '?')
+    {
+        out.pop_back();
+        return;
+    }
+    if(len >= 3 && out[len - 1] == ' ' && out[len - 2] == ',' && out[len - 3] == '?')
+    {
+        out.resize(len - 2);
+        return;
+    }
+    out += '?';
+}
+
+std::string QueryTelemetry::MakeTemplate(const char* query)
+{
+    std::string out;
+    if(query == nullptr)
+    {
+        return out;
+    }
+    size_t length = strlen(query);
+    out.reserve(length);
+    size_t i = 0;
+    while(i < length)
+    {
+        char c = query[i];
+        if(isspace((unsigned char) c))
+        {
+            while(i < length && isspace((unsigned char) query[i])) i++;
+            if(!out.empty() && out.back() != ' ')
+            {
+                out += ' ';
+            }
+            continue;
+        }
+        if(c == '\'')
+        {
+            // string literal, '' is an escaped quote
+            i++;
+            while(i < length)
+            {
+                if(query[i] == '\'')
+                {
+                    if(i + 1 < length && query[i + 1] == '\'')
+                    {
+                        i += 2;
+                        continue;
+                    }
+                    break;
+                }
+                i++;
+            }
+            i++;
+            AppendPlaceholder(out);
+            continue;
+        }
+        if(c == '"' || c == '`' || c == '[')
+        {
+            // quoted identifier, copied as is
+            char close = c == '[' ? ']' : c;
+            size_t end = i + 1;
+            while(end < length && query[end] != close) end++;
+            end = std::min(end + 1, length);
+            out.append(query + i, end - i);
+            i = end;
+            continue;
+        }
+        if(isalpha((unsigned char) c) || c == '_')
+        {
+            // identifier or keyword, digits inside it are not literals
+            size_t end = i;
+            while(end < length && (isalnum((unsigned char) query[end]) || query[end] == '_' || query[end] == '$')) end++;
+            out.append(query + i, end - i);
+            i = end;
+            continue;
+        }
+        if(isdigit((unsigned char) c) ||
+           (c == '.' && i + 1 < length && isdigit((unsigned char) query[i + 1])))
+        {
+            while(i < length && (isalnum((unsigned char) query[i]) || query[i] == '.')) i++;
+            AppendPlaceholder(out);
+            continue;
+        }
+        out += c;
+        i++;
+    }
+    while(!out.empty() && out.back() == ' ')
+    {
+        out.pop_back();
+    }
+    return out;
+}
+
+bool QueryTelemetry::Record(const std::string& query_template, const char* query,
+                            const char* connection, double duration_ms, uint64_t rows,
+                            uint64_t bytes, const char* error)
+{
+    bool first_seen = false;
+    bool failed = error != nullptr;
+    double slow_query_ms = SlowQueryThreshold();
+    bool slow = slow_query_ms > 0 && duration_ms >= slow_query_ms;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        StatsKey key(query_template, connection);
+        auto it = m_stats.find(key);
+        if(it == m_stats.end())
+        {
+            QueryStats stats = { query_template, connection, "", 0, 0, 0.0, 0.0, 0, 0 };
+            it = m_stats.emplace(std::move(key), std::move(stats)).first;
+        }
+        QueryStats& stats = it->second;
+        stats.count++;
+        stats.failures += failed ? 1 : 0;
+        stats.total_ms += duration_ms;
+        stats.max_ms = std::max(stats.max_ms, duration_ms);
+        stats.rows += rows;
+        stats.bytes += bytes;
+        // plan is captured once, on the first execution that succeeded
+        first_seen = !failed && stats.count - stats.failures == 1;
+
+        if(slow || failed)
+        {
+            if(m_slow_queries.size() == SLOW_QUERY_LOG_SIZE)
+            {
+                m_slow_queries.pop_front();
+            }
+            m_slow_queries.push_back({ query, connection, duration_ms, rows, bytes,
+                                       failed ? error : "" });
+        }
+    }
+    if(failed)
+    {
+        // interrupted queries fail as well, they are expected when requests are cancelled
+        spdlog::debug("Failed query: {:.1f} ms, {} rows on {}: {}: {}", duration_ms, rows,
+                      connection, error, query);
+    }
+    else if(slow)
+    {
+        spdlog::warn("Slow query: {:.1f} ms, {} rows, {} bytes on {}: {}", duration_ms, rows,
+                     bytes, connection, query);
+    }
+    return first_seen;
+}
+
+void QueryTelemetry::SetPlan(const std::string& query_template, const char* connection,
+                             std::string&& plan)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_stats.find(StatsKey(query_template, connection));
+    if(it != m_stats.end())
+    {
+        it->second.plan = std::move(plan);
+    }
+}
+
+std::vector<QueryTelemetry::QueryStats> QueryTelemetry::GetStats() const
+{
+    std::vector<QueryStats> stats;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        stats.reserve(m_stats.size());
+        for(auto const& it : m_stats)
+        {
+            stats.push_back(it.second);
+        }
+    }
+    std::sort(stats.begin(), stats.end(), [](QueryStats const& a, QueryStats const& b) {
+        return a.total_ms > b.total_ms;
+    });
+    return stats;
+}
+
+std::vector<QueryTelemetry::SlowQuery> QueryTelemetry::GetSlowQueries() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return std::vector<SlowQuery>(m_slow_queries.begin(), m_slow_queries.end());
+}
+
+void QueryTelemetry::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.clear();
+    m_slow_queries.clear();
+}
+
+}  // namespace DataModel
+}  // namespace RocProfVis
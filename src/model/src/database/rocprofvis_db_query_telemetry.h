@@ -0,0 +1,107 @@
+// Copyright Advanced Micro Devices, Inc.
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "rocprofvis_common_types.h"
+#include <atomic>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace RocProfVis
+{
+namespace DataModel
+{
+
+// Opt-in collector of per-query statistics for SQLite backed databases.
+// Queries are grouped by template (literals replaced with '?') and connection,
+// the query plan is captured the first time a template succeeds on a connection.
+// Failed executions are counted with their template and always go to the query log.
+class QueryTelemetry
+{
+    public:
+        // aggregated statistics of a single query template on a single connection
+        typedef struct QueryStats
+        {
+            std::string query_template;
+            std::string connection;
+            std::string plan;
+            uint64_t    count;
+            // executions which returned an error or were interrupted, included in count
+            uint64_t    failures;
+            double      total_ms;
+            double      max_ms;
+            uint64_t    rows;
+            uint64_t    bytes;
+        } QueryStats;
+
+        // single execution which took longer than the slow query threshold or failed
+        typedef struct SlowQuery
+        {
+            std::string query;
+            std::string connection;
+            double      duration_ms;
+            uint64_t    rows;
+            uint64_t    bytes;
+            // error message, empty if the query succeeded
+            std::string error;
+        } SlowQuery;
+
+        // Maximum number of entries kept in the slow query log
+        static constexpr size_t SLOW_QUERY_LOG_SIZE = 256;
+        // Default slow query threshold in milliseconds
+        static constexpr double DEFAULT_SLOW_QUERY_MS = 250.0;
+
+        QueryTelemetry();
+
+        // Enable or disable collection. Collection is disabled by default.
+        void        SetEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+        bool        IsEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+        // Queries taking at least this many milliseconds go to the slow query log, 0 logs failed queries only
+        void        SetSlowQueryThreshold(double ms) { m_slow_query_ms.store(ms, std::memory_order_relaxed); }
+        double      SlowQueryThreshold() const { return m_slow_query_ms.load(std::memory_order_relaxed); }
+
+        // Replace numeric and string literals with '?' and collapse whitespace
+        // @param query - SQL query text
+        // @return query template
+        static std::string MakeTemplate(const char* query);
+
+        // Record one query execution
+        // @param query_template - template made by MakeTemplate
+        // @param query - full query text, kept for the slow query log
+        // @param connection - connection label
+        // @param duration_ms - execution time in milliseconds
+        // @param rows - number of rows returned
+        // @param bytes - number of bytes returned
+        // @param error - error message of a failed execution, nullptr if the query succeeded
+        // @return true if the template succeeded for the first time on this connection and its plan should be captured
+        bool        Record(const std::string& query_template, const char* query,
+                           const char* connection, double duration_ms, uint64_t rows,
+                           uint64_t bytes, const char* error = nullptr);
+        // Store query plan of a template captured after the first Record call
+        void        SetPlan(const std::string& query_template, const char* connection,
+                            std::string&& plan);
+
+        // @return copy of aggregated statistics, ordered by total time descending
+        std::vector<QueryStats> GetStats() const;
+        // @return copy of slow and failed query log, oldest first
+        std::vector<SlowQuery>  GetSlowQueries() const;
+        // Drop all collected statistics and the slow query log
+        void        Clear();
+
+    private:
+        typedef std::pair<std::string, std::string> StatsKey;
+
+        std::atomic<bool>            m_enabled;
+        std::atomic<double>          m_slow_query_ms;
+        mutable std::mutex           m_mutex;
+        std::map<StatsKey, QueryStats> m_stats;
+        std::deque<SlowQuery>        m_slow_queries;
+};
+
+}  // namespace DataModel
+}  // namespace RocProfVis
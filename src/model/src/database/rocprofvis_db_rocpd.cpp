@@ -255,10 +255,10 @@ rocprofvis_dm_result_t  RocpdDatabase::ReadTraceMetadata(Future* future)
         if (kRocProfVisDmResultSuccess != ExecuteSQLQuery(future, DbInstancePtrAt(0),
             "SELECT DISTINCT pid, gpuId, queueId FROM rocpd_api_ops INNER JOIN api ON rocpd_api_ops.api_id = api.id INNER JOIN op ON rocpd_api_ops.op_id = op.id;", &CallBackAgentToProcess)) break;
 
+        BeginTrackDiscovery(1, 3);
         ShowProgress(5, "Adding HIP API tracks", kRPVDbBusy, future );
-        m_add_track_mutex.init(1);
         if(kRocProfVisDmResultSuccess != ExecuteSQLQuery(
-            future, DbInstancePtrAt(0), load_id++,
+            future, DbInstancePtrAt(0), load_id,
             { 
                         // Track query by pid/tid
                       GetEventTrackQuery(kRocProfVisDmRegionTrack),   
@@ -275,11 +275,11 @@ rocprofvis_dm_result_t  RocpdDatabase::ReadTraceMetadata(Future* future)
                      
             },
                         &CallBackAddTrack, &CallBackLoadTrack)) break;
+        load_id++;
 
         ShowProgress(5, "Adding kernel dispatch tracks", kRPVDbBusy, future );
-        m_add_track_mutex.init(1);
         if (kRocProfVisDmResultSuccess != ExecuteSQLQuery(
-            future, DbInstancePtrAt(0),  load_id++,
+            future, DbInstancePtrAt(0),  load_id,
             {
                         // Track query by agent/queue
                      GetEventTrackQuery(kRocProfVisDmKernelDispatchTrack),  
@@ -295,11 +295,11 @@ rocprofvis_dm_result_t  RocpdDatabase::ReadTraceMetadata(Future* future)
                          GetEventOperationQuery(kRocProfVisDmOperationDispatch)
             },
                         &CallBackAddTrack, &CallBackLoadTrack)) break;
+        load_id++;
 
         ShowProgress(5, "Adding performance counters tracks", kRPVDbBusy, future );
-        m_add_track_mutex.init(1);
         if (kRocProfVisDmResultSuccess != ExecuteSQLQuery(
-            future, DbInstancePtrAt(0), load_id++,
+            future, DbInstancePtrAt(0), load_id,
             { 
                         // Track query by agent/monitorType
                      GetEventTrackQuery(kRocProfVisDmPmcTrack),
@@ -314,6 +314,9 @@ rocprofvis_dm_result_t  RocpdDatabase::ReadTraceMetadata(Future* future)
                          GetEventOperationQuery(kRocProfVisDmOperationNoOp)
             },
                         &CallBackAddTrack, &CallBackLoadTrack)) break;
+        load_id++;
+
+        if (kRocProfVisDmResultSuccess != MergeDiscoveredTracks()) break;
 
         // Create track rankings based on load_id and db instance
         CreateTracksOrderRanking();
@@ -402,7 +405,7 @@ rocprofvis_dm_result_t  RocpdDatabase::ReadTraceMetadata(Future* future)
         SaveTrackProperties(future);
 
         ShowProgress(5, "Collecting track histogram", kRPVDbBusy, future);
-        BuildHistogram(future, 500);
+        if (kRocProfVisDmResultSuccess != BuildHistogram(future, 500)) break;
 
         TraceProperties()->metadata_loaded=true;
         BindObject()->FuncMetadataLoaded(BindObject()->trace_object);
@@ -2,10 +2,13 @@
 // SPDX-License-Identifier: MIT
 
 #include "rocprofvis_db_rocprof.h"
+#include "rocprofvis_c_interface.h"
 #include "rocprofvis_shared_types.h"
+#include <cmath>
 #include <sstream>
 #include <string.h>
 #include <filesystem>
+#include <unordered_set>
 
 namespace RocProfVis
 {
@@ -452,6 +455,17 @@ uint64_t RocprofDatabase::GetMemoryActivityTableSchemaHash()
     return std::hash<std::string>{}(hash_str);
 }
 
+uint64_t RocprofDatabase::GetKernelStatsQueryAndSchemaHash()
+{
+    std::string hash_str = BuildKernelStatsQuery("0", "1");
+    for (auto param : s_kernel_stats_schema_params)
+    {
+        hash_str += param.column;
+        hash_str += param.type;
+    }
+    return std::hash<std::string>{}(hash_str);
+}
+
 rocprofvis_dm_result_t RocprofDatabase::CreateAgentFriendlyMemoryAllocationTable(Future* future)
 {
     rocprofvis_dm_result_t result = kRocProfVisDmResultSuccess;
@@ -567,29 +581,16 @@ RocprofDatabase::CallbackNodeEnumeration(void* data, int argc, sqlite3_stmt* stm
 rocprofvis_dm_result_t
 RocprofDatabase::CreateIndexes()
 { 
-    std::vector<std::string> vec;
-    uint32_t file_node_id = INVALID_INDEX;
-    rocprofvis_dm_result_t result = kRocProfVisDmResultNotLoaded;
+    // statements are collected per file first, every file is then indexed by its own thread
+    std::vector<std::vector<std::string>> statements(m_db_nodes.size());
+    std::vector<rocprofvis_dm_result_t> results(m_db_nodes.size(), kRocProfVisDmResultSuccess);
     std::vector<std::thread> threads;
     auto task = [&](uint32_t db_node_id) {
-        result = ExecuteTransaction( vec, db_node_id);
+        results[db_node_id] = ExecuteTransaction(statements[db_node_id], db_node_id);
         };
     for (auto& guid_info : DbInstances())
     {
-        if (file_node_id == -1)
-        {
-            file_node_id = guid_info.first.FileIndex();
-        }
-        else
-        if (file_node_id != guid_info.first.FileIndex() && vec.size() > 0)
-        {
-            threads.emplace_back(task, file_node_id);            
-            vec.clear();
-            if (result != kRocProfVisDmResultSuccess)
-            {
-                break;
-            }
-        }
+        std::vector<std::string>& vec = statements[guid_info.first.FileIndex()];
         if(m_query_factory.IsVersionGreaterOrEqual("4"))
         {
             vec.push_back(std::string("CREATE INDEX IF NOT EXISTS rocpd_region_track_idx_") + guid_info.second +
@@ -598,6 +599,11 @@ RocprofDatabase::CreateIndexes()
                      " ON rocpd_track_" + guid_info.second + "(nid,agent_id,queue_id);");
             vec.push_back(std::string("CREATE INDEX IF NOT EXISTS rocpd_stream_idx_") + guid_info.second +
                      " ON rocpd_track_" + guid_info.second + "(nid,pid,stream_id);");
+            // kernel summary edge scans search dispatches by start time
+            vec.push_back(std::string("CREATE INDEX IF NOT EXISTS rocpd_timestamp_value_idx_") + guid_info.second +
+                     " ON rocpd_timestamp_" + guid_info.second + "(value);");
+            vec.push_back(std::string("CREATE INDEX IF NOT EXISTS rocpd_kernel_dispatch_start_idx_") + guid_info.second +
+                     " ON rocpd_kernel_dispatch_" + guid_info.second + "(start_id);");
         } else
         {
             vec.push_back(std::string("CREATE INDEX IF NOT EXISTS rocpd_region_idx_") + guid_info.second +
@@ -606,6 +612,9 @@ RocprofDatabase::CreateIndexes()
                      " ON rocpd_kernel_dispatch_" + guid_info.second + "(nid,agent_id,queue_id);");
             vec.push_back(std::string("CREATE INDEX IF NOT EXISTS rocpd_kernel_dispatch_stream_idx_") + guid_info.second +
                      " ON rocpd_kernel_dispatch_" + guid_info.second + "(nid,pid,stream_id);");
+            // kernel summary edge scans search dispatches by start time
+            vec.push_back(std::string("CREATE INDEX IF NOT EXISTS rocpd_kernel_dispatch_start_idx_") + guid_info.second +
+                     " ON rocpd_kernel_dispatch_" + guid_info.second + "(start);");
             vec.push_back(std::string("CREATE INDEX IF NOT EXISTS rocpd_memory_allocate_idx_") + guid_info.second +
                      " ON rocpd_memory_allocate_" + guid_info.second + "(nid,agent_id,queue_id);");
             vec.push_back(std::string("CREATE INDEX IF NOT EXISTS rocpd_memory_allocate_stream_idx_") + guid_info.second +
@@ -631,12 +640,22 @@ RocprofDatabase::CreateIndexes()
         vec.push_back(std::string("CREATE INDEX IF NOT EXISTS rocpd_region_stack_idx_") + guid_info.second +
                     " ON rocpd_event_" + guid_info.second + "(stack_id);");
     }
-    if (vec.size() > 0 && file_node_id!=-1)
+    for (uint32_t file_node_id = 0; file_node_id < statements.size(); file_node_id++)
     {
-        threads.emplace_back(task, file_node_id);            
+        if (statements[file_node_id].size() > 0)
+        {
+            threads.emplace_back(task, file_node_id);
+        }
     }
     for (auto& t : threads)
         t.join();
+    for (auto result : results)
+    {
+        if (result != kRocProfVisDmResultSuccess)
+        {
+            return result;
+        }
+    }
     return kRocProfVisDmResultSuccess;
 }
 
@@ -716,16 +735,20 @@ rocprofvis_dm_result_t RocprofDatabase::LoadMemoryActivityData(Future* future) {
 rocprofvis_dm_result_t RocprofDatabase::PopulateStreamToHardwareFlowProperties(uint32_t stream_track_index, uint32_t db_instance ){
     TableCache* table = (TableCache*)CachedTables(db_instance)->GetTableHandle("StreamToHw");
     uint32_t stream_id = static_cast<uint32_t>(TrackPropertiesAt(stream_track_index)->track_indentifiers.id[TRACK_ID_STREAM]);
+    uint32_t stream_column = table->FindColumn(Builder::STREAM_ID_SERVICE_NAME);
+    uint32_t op_column = table->FindColumn(Builder::OPERATION_SERVICE_NAME);
+    uint32_t agent_column = table->FindColumn(Builder::AGENT_ID_SERVICE_NAME);
+    uint32_t queue_column = table->FindColumn(Builder::QUEUE_ID_SERVICE_NAME);
 
     for (int ind = 0; ind < table->NumRows(); ind++)
     {
-        uint64_t id = std::atoll(table->GetCellByIndex(ind, Builder::STREAM_ID_SERVICE_NAME));
+        uint64_t id = table->GetCellInt(ind, stream_column);
         if (id == stream_id)
         {
-            uint32_t op = static_cast<uint32_t>(std::atoll(table->GetCellByIndex(ind, Builder::OPERATION_SERVICE_NAME)));
-            std::string agent = table->GetCellByIndex(ind, Builder::AGENT_ID_SERVICE_NAME);
+            uint32_t op = static_cast<uint32_t>(table->GetCellInt(ind, op_column));
+            const char* agent = table->GetCell(ind, agent_column);
             uint32_t agent_id = 0;
-            if (agent.empty() && op == kRocProfVisDmOperationMemoryAllocate)
+            if (agent[0] == 0 && op == kRocProfVisDmOperationMemoryAllocate)
             {
                 auto it = m_memfree_stream_to_agent[db_instance].find(stream_id);
                 if (it != m_memfree_stream_to_agent[db_instance].end())
@@ -735,9 +758,9 @@ rocprofvis_dm_result_t RocprofDatabase::PopulateStreamToHardwareFlowProperties(u
             }
             else
             {
-                agent_id = static_cast<uint32_t>(std::atoll(table->GetCellByIndex(ind, Builder::AGENT_ID_SERVICE_NAME)));
+                agent_id = static_cast<uint32_t>(table->GetCellInt(ind, agent_column));
             }
-            uint32_t queue_id = static_cast<uint32_t>(std::atoll(table->GetCellByIndex(ind, Builder::QUEUE_ID_SERVICE_NAME)));
+            uint32_t queue_id = static_cast<uint32_t>(table->GetCellInt(ind, queue_column));
             uint32_t track;
             if (TrackTracker()->FindTrack(
                 TrackTracker()->SearchCategoryMaskLookup((rocprofvis_dm_event_operation_t)op), 
@@ -764,10 +787,12 @@ rocprofvis_dm_result_t RocprofDatabase::PopulateUnusedAgents(uint32_t db_instanc
     rocprofvis_dm_result_t result = kRocProfVisDmResultSuccess;
     const char* table_name = "Agent";
     TableCache* table = (TableCache*)CachedTables(db_instance)->GetTableHandle(table_name);
+    uint32_t id_column = table->FindColumn("id");
+    uint32_t node_column = table->FindColumn("nid");
     for (uint64_t i = 0; i < table->NumRows(); i++)
     {
-        uint64_t agent_id = std::atoll(table->GetCellByIndex(i, "id"));
-        uint64_t node_id = std::atoll(table->GetCellByIndex(i,"nid"));
+        uint64_t agent_id = table->GetCellInt(i, id_column);
+        uint64_t node_id = table->GetCellInt(i, node_column);
         bool agent_in_use = false;
         for (int track_id = 0; track_id < NumTracks(); track_id++)
         {
@@ -922,253 +947,126 @@ rocprofvis_dm_result_t  RocprofDatabase::ReadTraceMetadata(Future* future)
             m_query_factory.GetRocprofPerformanceCountersTrackQuery() +
             m_query_factory.GetRocprofSMIPerformanceCountersTrackQuery() +
             m_query_factory.GetRocprofMemoryActivityTrackQuery();
-        uint32_t load_id = 0;
+        // Every database file walks through all track categories in its own thread, using its own
+        // connections. Category index is the load_id, tracks are added in order of load_id
+        // and then db instance, so track ids do not depend on which file finishes first.
+        std::vector<std::pair<const char*, std::vector<std::string>>> track_categories = {
+            { "Adding HIP API tracks", {
+                m_query_factory.GetRocprofRegionTrackQuery(false),
+                "",
+                m_query_factory.GetRocprofRegionLevelQuery(false),
+                m_query_factory.GetRocprofRegionSliceQuery(false),
+                "",
+                m_query_factory.GetRocprofRegionTableQuery(false),
+            } },
+            { "Adding HIP API Sample tracks", {
+                m_query_factory.GetRocprofRegionTrackQuery(true),
+                "",
+                m_query_factory.GetRocprofRegionLevelQuery(true),
+                m_query_factory.GetRocprofRegionSliceQuery(true),
+                "",
+                m_query_factory.GetRocprofRegionTableQuery(true),
+            } },
+            { "Adding kernel dispatch tracks", {
+                m_query_factory.GetRocprofKernelDispatchTrackQuery(),
+                m_query_factory.GetRocprofKernelDispatchTrackQueryForStream(),
+                m_query_factory.GetRocprofKernelDispatchLevelQuery(),
+                m_query_factory.GetRocprofKernelDispatchSliceQuery(),
+                m_query_factory.GetRocprofKernelDispatchSliceQueryForStream(),
+                m_query_factory.GetRocprofKernelDispatchTableQuery(),
+            } },
+            { "Adding memory allocation tracks", {
+                m_query_factory.GetRocprofMemoryAllocTrackQuery(),
+                m_query_factory.GetRocprofMemoryAllocTrackQueryForStream(),
+                m_query_factory.GetRocprofMemoryAllocLevelQuery(),
+                m_query_factory.GetRocprofMemoryAllocSliceQuery(),
+                m_query_factory.GetRocprofMemoryAllocSliceQueryForStream(),
+                m_query_factory.GetRocprofMemoryAllocTableQuery(),
+            } },
+            { "Adding memory copy tracks", {
+                m_query_factory.GetRocprofMemoryCopyTrackQuery(),
+                m_query_factory.GetRocprofMemoryCopyTrackQueryForStream(),
+                m_query_factory.GetRocprofMemoryCopyLevelQuery(),
+                m_query_factory.GetRocprofMemoryCopySliceQuery(),
+                m_query_factory.GetRocprofMemoryCopySliceQueryForStream(),
+                m_query_factory.GetRocprofMemoryCopyTableQuery(),
+            } },
+            // PMC schema is not fully defined yet
+            { "Adding performance counters tracks", {
+                m_query_factory.GetRocprofPerformanceCountersTrackQuery(),
+                "",
+                m_query_factory.GetRocprofPerformanceCountersLevelQuery(),
+                m_query_factory.GetRocprofPerformanceCountersSliceQuery(),
+                "",
+                m_query_factory.GetRocprofPerformanceCountersTableQuery(),
+            } },
+            { "Adding performance smi counters tracks", {
+                m_query_factory.GetRocprofSMIPerformanceCountersTrackQuery(),
+                "",
+                m_query_factory.GetRocprofSMIPerformanceCountersLevelQuery(),
+                m_query_factory.GetRocprofSMIPerformanceCountersSliceQuery(),
+                "",
+                m_query_factory.GetRocprofSMIPerformanceCountersTableQuery(),
+            } },
+            { "Adding memory allocation activity tracks", {
+                m_query_factory.GetRocprofMemoryActivityTrackQuery(),
+                "",
+                m_query_factory.GetRocprofMemoryActivityLevelQuery(),
+                m_query_factory.GetRocprofMemoryActivitySliceQuery(),
+                "",
+                m_query_factory.GetRocprofMemoryActivityTableQuery(),
+            } },
+        };
 
-        ShowProgress(5, "Adding HIP API tracks", kRPVDbBusy, future );
         {
             std::vector<std::thread> threads;
-            m_add_track_mutex.init(NumDbInstances());
-            auto task = [&](DbInstance* db_instance)
+            uint32_t num_load_ids = static_cast<uint32_t>(track_categories.size());
+            // file threads only collect track parameters, tracks are added once all files are discovered
+            BeginTrackDiscovery(NumDbInstances(), num_load_ids);
+            std::vector<rocprofvis_dm_result_t> results(m_db_nodes.size(), kRocProfVisDmResultSuccess);
+            auto task = [&](uint32_t file_node_id)
                 {
                     Future* sub_future = future->AddSubFuture();
-                    result = ExecuteSQLQuery(sub_future, db_instance, load_id,
+                    for (uint32_t load_id = 0; load_id < num_load_ids && results[file_node_id] == kRocProfVisDmResultSuccess; load_id++)
+                    {
+                        // progress is reported by the last file
+                        if (file_node_id == m_db_nodes.size() - 1)
                         {
-                            m_query_factory.GetRocprofRegionTrackQuery(false),
-                            "",
-                            m_query_factory.GetRocprofRegionLevelQuery(false),
-                            m_query_factory.GetRocprofRegionSliceQuery(false),
-                            "",
-                            m_query_factory.GetRocprofRegionTableQuery(false),
-                        },
-                        &CallBackAddTrack, &CallBackLoadTrack);
-                    future->DeleteSubFuture(sub_future);
-                    m_add_track_mutex.unlock(db_instance->GuidIndex());
-                };
-            for (auto& guid_info : DbInstances())
-            {
-                threads.emplace_back(task, &guid_info.first);
-            }
-            for (auto& t : threads)
-                t.join();
-            load_id++;
-        }
-
-
-        ShowProgress(5, "Adding HIP API Sample tracks", kRPVDbBusy, future );
-        {
-            std::vector<std::thread> threads;
-            m_add_track_mutex.init(NumDbInstances());
-            auto task = [&](DbInstance* db_instance)
-                {
-
-                    Future* sub_future = future->AddSubFuture();
-                    result = ExecuteSQLQuery(sub_future, db_instance, load_id,
-                    { 
-                        m_query_factory.GetRocprofRegionTrackQuery(true),
-                        "",
-                        m_query_factory.GetRocprofRegionLevelQuery(true),
-                        m_query_factory.GetRocprofRegionSliceQuery(true),
-                        "",
-                        m_query_factory.GetRocprofRegionTableQuery(true),
-                    },
-                    &CallBackAddTrack, &CallBackLoadTrack);
-                    future->DeleteSubFuture(sub_future);
-                    m_add_track_mutex.unlock(db_instance->GuidIndex());
-                };
-            for (auto& guid_info : DbInstances())
-            {
-                threads.emplace_back(task, &guid_info.first);
-            }
-            for (auto& t : threads)
-                t.join();
-            load_id++;
-        }
-
-        ShowProgress(5, "Adding kernel dispatch tracks", kRPVDbBusy, future );
-        {
-            std::vector<std::thread> threads;
-            m_add_track_mutex.init(NumDbInstances());
-            auto task = [&](DbInstance* db_instance)
-                {
-                    Future* sub_future = future->AddSubFuture();
-                    result = ExecuteSQLQuery(sub_future, db_instance, load_id,
-                    { 
-                        m_query_factory.GetRocprofKernelDispatchTrackQuery(),
-                        m_query_factory.GetRocprofKernelDispatchTrackQueryForStream(),
-                        m_query_factory.GetRocprofKernelDispatchLevelQuery(),
-                        m_query_factory.GetRocprofKernelDispatchSliceQuery(),
-                        m_query_factory.GetRocprofKernelDispatchSliceQueryForStream(),
-                        m_query_factory.GetRocprofKernelDispatchTableQuery(),
-                    },
-                    &CallBackAddTrack, &CallBackLoadTrack);
-                    future->DeleteSubFuture(sub_future);
-                    m_add_track_mutex.unlock(db_instance->GuidIndex());
-                };
-            for (auto& guid_info : DbInstances())
-            {
-                threads.emplace_back(task, &guid_info.first);
-            }
-            for (auto& t : threads)
-                t.join();
-            load_id++;
-        }
-
-        ShowProgress(5, "Adding memory allocation tracks", kRPVDbBusy, future );
-        {
-            std::vector<std::thread> threads;
-            m_add_track_mutex.init(NumDbInstances());
-            auto task = [&](DbInstance* db_instance)
-                {
-                    Future* sub_future = future->AddSubFuture();
-                    result = ExecuteSQLQuery(sub_future, db_instance, load_id,
-                    { 
-                        m_query_factory.GetRocprofMemoryAllocTrackQuery(),
-                        m_query_factory.GetRocprofMemoryAllocTrackQueryForStream(),
-                        m_query_factory.GetRocprofMemoryAllocLevelQuery(),
-                        m_query_factory.GetRocprofMemoryAllocSliceQuery(),
-                        m_query_factory.GetRocprofMemoryAllocSliceQueryForStream(),
-                        m_query_factory.GetRocprofMemoryAllocTableQuery(),
-                    },
-                    &CallBackAddTrack, &CallBackLoadTrack);
-                    future->DeleteSubFuture(sub_future);
-                    m_add_track_mutex.unlock(db_instance->GuidIndex());
-                };
-            for (auto& guid_info : DbInstances())
-            {
-                threads.emplace_back(task, &guid_info.first);
-            }
-            for (auto& t : threads)
-                t.join();
-            load_id++;
-        }
-
-        /*
-// This will not work if full track is not requested
-// Comment out for now. Will need to fetch all data, then cut samples outside of time frame.
-        ShowProgress(5, "Adding Memory allocation graph tracks", kRPVDbBusy, future );
-        if (kRocProfVisDmResultSuccess != ExecuteSQLQuery(future, 
-                    "select DISTINCT nid as nodeId, agent_id as agentId, -1 as const, 1 as category from rocpd_memory_allocate;", 
-                    "select 0 as op, start, sum(CASE WHEN type = 'FREE' THEN (select -size from rocpd_memory_allocate MA1 where MA.address == MA1.address limit 1) ELSE size END) over (ORDER BY start ROWS BETWEEN UNBOUNDED PRECEDING AND CURRENT ROW) as current, start as end, 0, 0, nid as nodeId, coalesce(agent_id, 0) as agentId, -1 as queue  from rocpd_memory_allocate MA ", 
-                    &CallBackAddTrack)) break;
-*/
-   
-        ShowProgress(5, "Adding memory copy tracks", kRPVDbBusy, future );
-        {
-            std::vector<std::thread> threads;
-            m_add_track_mutex.init(NumDbInstances());
-            auto task = [&](DbInstance* db_instance)
-                {
-                    Future* sub_future = future->AddSubFuture();
-                    result = ExecuteSQLQuery(sub_future, db_instance, load_id,
-                    { 
-                        m_query_factory.GetRocprofMemoryCopyTrackQuery(),
-                        m_query_factory.GetRocprofMemoryCopyTrackQueryForStream(),
-                        m_query_factory.GetRocprofMemoryCopyLevelQuery(),
-                        m_query_factory.GetRocprofMemoryCopySliceQuery(),
-                        m_query_factory.GetRocprofMemoryCopySliceQueryForStream(),
-                        m_query_factory.GetRocprofMemoryCopyTableQuery(),
-                    },
-                    &CallBackAddTrack, &CallBackLoadTrack);
+                            ShowProgress(5, track_categories[load_id].first, kRPVDbBusy, future);
+                        }
+                        for (auto& guid_info : DbInstances())
+                        {
+                            if (guid_info.first.FileIndex() != file_node_id)
+                            {
+                                continue;
+                            }
+                            results[file_node_id] = ExecuteSQLQuery(sub_future, &guid_info.first, load_id, track_categories[load_id].second,
+                                &CallBackAddTrack, &CallBackLoadTrack);
+                            if (results[file_node_id] != kRocProfVisDmResultSuccess) break;
+                        }
+                    }
                     future->DeleteSubFuture(sub_future);
-                    m_add_track_mutex.unlock(db_instance->GuidIndex());
                 };
-            for (auto& guid_info : DbInstances())
+            for (auto& file_node : m_db_nodes)
             {
-                threads.emplace_back(task, &guid_info.first);
+                threads.emplace_back(task, file_node->node_id);
             }
             for (auto& t : threads)
                 t.join();
-            load_id++;
-        }
-
-        // PMC schema is not fully defined yet
-        ShowProgress(5, "Adding performance counters tracks", kRPVDbBusy, future );
-        {
-            std::vector<std::thread> threads;
-            m_add_track_mutex.init(NumDbInstances());
-            auto task = [&](DbInstance* db_instance)
-                {
-                    Future* sub_future = future->AddSubFuture();
-                    result = ExecuteSQLQuery(sub_future, db_instance, load_id,
-                    { 
-                        m_query_factory.GetRocprofPerformanceCountersTrackQuery(),
-                        "",
-                        m_query_factory.GetRocprofPerformanceCountersLevelQuery(),
-                        m_query_factory.GetRocprofPerformanceCountersSliceQuery(),
-                        "",
-                        m_query_factory.GetRocprofPerformanceCountersTableQuery(),
-                    },
-                    &CallBackAddTrack, &CallBackLoadTrack);
-                    future->DeleteSubFuture(sub_future);
-                    m_add_track_mutex.unlock(db_instance->GuidIndex());
-                };
-            for (auto& guid_info : DbInstances())
+            for (auto file_result : results)
             {
-                threads.emplace_back(task, &guid_info.first);
-            }
-            for (auto& t : threads)
-                t.join();
-            load_id++;
-        }
-                   
-        // PMC schema is not fully defined yet
-        ShowProgress(5, "Adding performance smi counters tracks", kRPVDbBusy, future );
-        {
-            std::vector<std::thread> threads;
-            m_add_track_mutex.init(NumDbInstances());
-            auto task = [&](DbInstance* db_instance)
+                if (file_result != kRocProfVisDmResultSuccess)
                 {
-                    Future* sub_future = future->AddSubFuture();
-                    result = ExecuteSQLQuery(sub_future, db_instance, load_id,
-                    { 
-                        m_query_factory.GetRocprofSMIPerformanceCountersTrackQuery(),
-                        "",
-                        m_query_factory.GetRocprofSMIPerformanceCountersLevelQuery(),
-                        m_query_factory.GetRocprofSMIPerformanceCountersSliceQuery(),
-                        "",
-                        m_query_factory.GetRocprofSMIPerformanceCountersTableQuery(),
-                    },
-                    &CallBackAddTrack, &CallBackLoadTrack);
-                    future->DeleteSubFuture(sub_future);
-                    m_add_track_mutex.unlock(db_instance->GuidIndex());
-                };
-            for (auto& guid_info : DbInstances())
-            {
-                threads.emplace_back(task, &guid_info.first);
+                    result = file_result;
+                    break;
+                }
             }
-            for (auto& t : threads)
-                t.join();
-            load_id++;
-        }
-
-        ShowProgress(5, "Adding memory allocation activity tracks", kRPVDbBusy, future );
-        {
-            std::vector<std::thread> threads;
-            m_add_track_mutex.init(NumDbInstances());
-            auto task = [&](DbInstance* db_instance)
-                {
-                    Future* sub_future = future->AddSubFuture();
-                    result = ExecuteSQLQuery(sub_future, db_instance, load_id,
-                        { 
-                            m_query_factory.GetRocprofMemoryActivityTrackQuery(),
-                            "",
-                            m_query_factory.GetRocprofMemoryActivityLevelQuery(),
-                            m_query_factory.GetRocprofMemoryActivitySliceQuery(),
-                            "",
-                            m_query_factory.GetRocprofMemoryActivityTableQuery(),
-                        },
-                        &CallBackAddTrack, &CallBackLoadTrack);
-                    future->DeleteSubFuture(sub_future);
-                    m_add_track_mutex.unlock(db_instance->GuidIndex());
-                };
-            for (auto& guid_info : DbInstances())
+            if (result == kRocProfVisDmResultSuccess)
             {
-                threads.emplace_back(task, &guid_info.first);
+                result = MergeDiscoveredTracks();
             }
-            for (auto& t : threads)
-                t.join();
-            load_id++;
         }
+        if (result != kRocProfVisDmResultSuccess) break;
 
         // Create track rankings based on load_id and db instance
         CreateTracksOrderRanking();
@@ -1197,7 +1095,6 @@ rocprofvis_dm_result_t  RocprofDatabase::ReadTraceMetadata(Future* future)
         BindObject()->FuncAddString(BindObject()->trace_object, ""); // 0 index string
         {
             std::vector<std::thread> threads;
-            m_add_track_mutex.init(NumDbInstances());
             auto task = [&](DbInstance* db_instance)
                 {
                     Future* sub_future = future->AddSubFuture();
@@ -1217,7 +1114,6 @@ rocprofvis_dm_result_t  RocprofDatabase::ReadTraceMetadata(Future* future)
         ShowProgress(10, "Loading kenel symbols", kRPVDbBusy, future );
         {
             std::vector<std::thread> threads;
-            m_add_track_mutex.init(NumDbInstances());
             auto task = [&](DbInstance* db_instance)
                 {
                     Future* sub_future = future->AddSubFuture();
@@ -1251,9 +1147,10 @@ rocprofvis_dm_result_t  RocprofDatabase::ReadTraceMetadata(Future* future)
             if (m_metadata_version_control.MustRebuildLevels(guid_info.first.FileIndex()))
             {
                 calculate_level_for_guids.push_back(guid_info);
+                // containers are created here, the per file writers below only look them up
                 for (auto prop : table_properties)
                 {
-                    m_event_levels[kRocProfVisDmOperationLaunch][guid_info.first.GuidIndex()].reserve(
+                    m_event_levels[prop.second][guid_info.first.GuidIndex()].reserve(
                         TraceProperties()->events_count[prop.second]);
                 }
             }
@@ -1275,45 +1172,52 @@ rocprofvis_dm_result_t  RocprofDatabase::ReadTraceMetadata(Future* future)
 
             for (int j = 0; j < kRocProfVisDmNumOperation; j++)
             {
-                for (auto it = m_event_levels[j].begin(); it != m_event_levels[j].end(); ++it)
+                m_event_levels_id_to_index[j].clear();
+            }
+
+            // every file sorts and saves the levels of its own db instances
+            std::vector<std::thread> threads;
+            auto task = [&](uint32_t file_node_id)
                 {
-                    if (it->second.size() > 0)
+                    for (auto prop : table_properties)
                     {
-                        std::sort(it->second.begin(),
-                            it->second.end(),
-                            [](const rocprofvis_db_event_level_t& a,
-                                const rocprofvis_db_event_level_t& b) {
-                                    return a.id < b.id;
-                            });
+                        for (auto& guid_info : calculate_level_for_guids)
+                        {
+                            if (guid_info.first.FileIndex() != file_node_id)
+                            {
+                                continue;
+                            }
+                            std::vector<rocprofvis_db_event_level_t>& event_levels =
+                                m_event_levels[prop.second].at(guid_info.first.GuidIndex());
+                            std::sort(event_levels.begin(),
+                                event_levels.end(),
+                                [](const rocprofvis_db_event_level_t& a,
+                                    const rocprofvis_db_event_level_t& b) {
+                                        return a.id < b.id;
+                                });
+                            CreateSQLTable(
+                                (prop.first + guid_info.second).c_str(), s_level_schema_params,
+                                event_levels.size(),
+                                [&](sqlite3_stmt* stmt, int index) {
+                                    sqlite3_bind_int64(stmt, 1, event_levels[index].id);
+                                    sqlite3_bind_int(stmt, 2, event_levels[index].level_for_queue);
+                                    sqlite3_bind_int(stmt, 3, event_levels[index].level_for_stream);
+                                    sqlite3_bind_int(stmt, 4, static_cast<int>(event_levels[index].parent_id));
+                                }, file_node_id);
+                            event_levels.clear();
+                            event_levels.shrink_to_fit();
+                        }
                     }
-                }
-            }
-
-            for (auto prop : table_properties)
+                };
+            for (auto& file_node : m_db_nodes)
             {
-                for (auto& guid_info : DbInstances())
+                if (m_metadata_version_control.MustRebuildLevels(file_node->node_id))
                 {
-                    CreateSQLTable(
-                        (prop.first + guid_info.second).c_str(), s_level_schema_params,
-                        m_event_levels[prop.second][guid_info.first.GuidIndex()].size(),
-                        [&](sqlite3_stmt* stmt, int index) {
-                            sqlite3_bind_int64(
-                                stmt, 1,
-                                m_event_levels[prop.second][guid_info.first.GuidIndex()][index].id);
-                            sqlite3_bind_int(
-                                stmt, 2,
-                                m_event_levels[prop.second][guid_info.first.GuidIndex()][index].level_for_queue);
-                            sqlite3_bind_int(
-                                stmt, 3,
-                                m_event_levels[prop.second][guid_info.first.GuidIndex()][index].level_for_stream);
-                            sqlite3_bind_int(
-                                stmt, 4,
-                                static_cast<int>(m_event_levels[prop.second][guid_info.first.GuidIndex()][index].parent_id));
-                        }, guid_info.first.FileIndex());
-                    m_event_levels[prop.second][guid_info.first.GuidIndex()].clear();
-                    m_event_levels_id_to_index[prop.second][guid_info.first.GuidIndex()].clear();
+                    threads.emplace_back(task, file_node->node_id);
                 }
             }
+            for (auto& t : threads)
+                t.join();
         }
 
         if (!TraceProperties()->tracks_info_restored)
@@ -1339,7 +1243,13 @@ rocprofvis_dm_result_t  RocprofDatabase::ReadTraceMetadata(Future* future)
 
 
         ShowProgress(5, "Collecting track histogram", kRPVDbBusy, future);
-        BuildHistogram(future, 500);
+        if (kRocProfVisDmResultSuccess != BuildHistogram(future, 500)) break;
+
+        ShowProgress(5, "Building flow index", kRPVDbBusy, future);
+        if (kRocProfVisDmResultSuccess != BuildFlowIndex(future)) break;
+
+        ShowProgress(2, "Building kernel statistics", kRPVDbBusy, future);
+        if (kRocProfVisDmResultSuccess != BuildKernelStats(future)) break;
 
         TraceProperties()->metadata_loaded=true;
         BindObject()->FuncMetadataLoaded(BindObject()->trace_object);
@@ -1405,6 +1315,692 @@ rocprofvis_dm_result_t  RocprofDatabase::ReadFlowTraceInfo(
     return future->SetPromise(future->Interrupted() ? kRocProfVisDmResultDbAbort : kRocProfVisDmResultDbAccessFailed);
 }
 
+int RocprofDatabase::CallbackAddFlowIndexEndpoint(void* data, int argc, sqlite3_stmt* stmt, char** azColName){
+    ROCPROFVIS_ASSERT_MSG_RETURN(data, ERROR_SQL_QUERY_PARAMETERS_CANNOT_BE_NULL, 1);
+    ROCPROFVIS_ASSERT_MSG_RETURN(argc == rocprofvis_db_sqlite_dataflow_query_format::NUM_PARAMS,
+        ERROR_DATABASE_QUERY_PARAMETERS_MISMATCH, 1);
+    void*  func = (void*)&CallbackAddFlowIndexEndpoint;
+    rocprofvis_db_sqlite_callback_parameters* callback_params = (rocprofvis_db_sqlite_callback_parameters*)data;
+    ROCPROFVIS_ASSERT_MSG_RETURN(callback_params->db_instance != nullptr, ERROR_NODE_KEY_CANNOT_BE_NULL, 1);
+    uint32_t db_instance = callback_params->db_instance->GuidIndex();
+    RocprofDatabase* db = (RocprofDatabase*)callback_params->db;
+    std::vector<rocprofvis_db_flow_index_endpoint_t>* endpoints = (std::vector<rocprofvis_db_flow_index_endpoint_t>*)callback_params->handle;
+    if(callback_params->future->Interrupted()) return SQLITE_ABORT;
+    rocprofvis_db_flow_index_endpoint_t endpoint;
+    rocprofvis_db_flow_data_t& record = endpoint.data;
+
+    record.id.bitfield.event_op = db->Sqlite3ColumnInt(func, stmt, azColName, 0);
+    record.id.bitfield.event_node = db_instance;
+    if (db->TrackTracker()->FindTrack(
+        db->TrackTracker()->SearchCategoryMaskLookup((rocprofvis_dm_event_operation_t)record.id.bitfield.event_op),
+        db->Sqlite3ColumnInt(func, stmt, azColName, 4), 
+        db->Sqlite3ColumnInt(func, stmt, azColName, 5), 
+        db_instance, record.track_id))
+    {
+        endpoint.stack_id = db->Sqlite3ColumnInt64(func, stmt, azColName, 1);
+        record.id.bitfield.event_id = db->Sqlite3ColumnInt64(func, stmt, azColName, 2);
+        record.time = db->Sqlite3ColumnInt64(func, stmt, azColName, 6);
+        record.time -= db->TraceProperties()->db_inst_start_time[db_instance];
+        record.category_id = db->Sqlite3ColumnInt64(func, stmt, azColName, 7);
+        record.symbol_id = db->Sqlite3ColumnInt64(func, stmt, azColName, 8);
+        record.level = static_cast<rocprofvis_dm_event_level_t>(db->Sqlite3ColumnInt64(func, stmt, azColName, 9));
+        record.end_time = db->Sqlite3ColumnInt64(func, stmt, azColName, 10);  
+        record.end_time -= db->TraceProperties()->db_inst_start_time[db_instance];
+        if(kRocProfVisDmResultSuccess != db->RemapStringIds(record)) return 0;
+        endpoints->push_back(endpoint);
+    }
+    callback_params->future->CountThisRow();
+    return 0;
+}
+
+rocprofvis_dm_result_t RocprofDatabase::BuildFlowIndex(Future* future)
+{
+    ROCPROFVIS_ASSERT_MSG_RETURN(future, ERROR_FUTURE_CANNOT_BE_NULL, kRocProfVisDmResultInvalidParameter);
+    m_flow_index.clear();
+    m_flow_track_index.clear();
+    std::string query = m_query_factory.GetRocprofDataFlowIndexQuery();
+    for (auto& guid_info : DbInstances())
+    {
+        std::vector<rocprofvis_db_flow_index_endpoint_t> endpoints;
+        rocprofvis_dm_result_t result = ExecuteSQLQuery(future, &guid_info.first, query.c_str(), (rocprofvis_dm_handle_t)&endpoints, &CallbackAddFlowIndexEndpoint);
+        if (result == kRocProfVisDmResultDbAbort)
+        {
+            return result;
+        }
+        if (result != kRocProfVisDmResultSuccess)
+        {
+            // Older databases may lack some of the joined tables, flow arrows are then available per event only
+            spdlog::warn("Flow index is not available for database instance {}", guid_info.first.GuidIndex());
+            continue;
+        }
+        // Group endpoints by correlation id, launch endpoints first within a group, each part in time order
+        std::sort(endpoints.begin(), endpoints.end(),
+            [](const rocprofvis_db_flow_index_endpoint_t& a, const rocprofvis_db_flow_index_endpoint_t& b) {
+                bool a_target = a.data.id.bitfield.event_op != kRocProfVisDmOperationLaunch;
+                bool b_target = b.data.id.bitfield.event_op != kRocProfVisDmOperationLaunch;
+                if (a.stack_id != b.stack_id) return a.stack_id < b.stack_id;
+                if (a_target != b_target) return a_target < b_target;
+                return a.data.time < b.data.time;
+            });
+        size_t group_start = 0;
+        while (group_start < endpoints.size())
+        {
+            size_t group_end = group_start;
+            size_t first_target = endpoints.size();
+            while (group_end < endpoints.size() && endpoints[group_end].stack_id == endpoints[group_start].stack_id)
+            {
+                if (first_target == endpoints.size() && endpoints[group_end].data.id.bitfield.event_op != kRocProfVisDmOperationLaunch)
+                {
+                    first_target = group_end;
+                }
+                group_end++;
+            }
+            // One edge per target, from the last launch that precedes it. Pairing every launch with every
+            // target would grow the index quadratically for correlation ids shared by many endpoints
+            size_t origin = group_start;
+            for (size_t target = first_target; group_start < first_target && target < group_end; target++)
+            {
+                while (origin + 1 < first_target && endpoints[origin + 1].data.time <= endpoints[target].data.time)
+                {
+                    origin++;
+                }
+                rocprofvis_db_flow_index_edge_t edge;
+                edge.origin = endpoints[origin].data;
+                edge.target = endpoints[target].data;
+                edge.start = std::min(edge.origin.time, edge.target.time);
+                edge.end = std::max(edge.origin.end_time, edge.target.end_time);
+                m_flow_index.push_back(edge);
+            }
+            group_start = group_end;
+        }
+    }
+    std::sort(m_flow_index.begin(), m_flow_index.end(),
+        [](const rocprofvis_db_flow_index_edge_t& a, const rocprofvis_db_flow_index_edge_t& b) {
+            return a.start < b.start;
+        });
+    m_flow_index.shrink_to_fit();
+    // Edge lists inherit the start time order of m_flow_index
+    for (uint32_t index = 0; index < m_flow_index.size(); index++)
+    {
+        const rocprofvis_db_flow_index_edge_t& edge = m_flow_index[index];
+        for (uint32_t track_id : { edge.origin.track_id, edge.target.track_id })
+        {
+            rocprofvis_db_flow_track_index_t& track_index = m_flow_track_index.emplace(track_id, rocprofvis_db_flow_track_index_t{ {}, 0 }).first->second;
+            if (track_index.edges.empty() || track_index.edges.back() != index)
+            {
+                track_index.edges.push_back(index);
+                track_index.max_span = std::max(track_index.max_span, edge.end - edge.start);
+            }
+        }
+    }
+    spdlog::debug("Flow index contains {} edges", m_flow_index.size());
+    return kRocProfVisDmResultSuccess;
+}
+
+rocprofvis_dm_result_t RocprofDatabase::ReadFlowRange(
+        rocprofvis_dm_timestamp_t start,
+        rocprofvis_dm_timestamp_t end,
+        const std::vector<uint32_t>& tracks,
+        Future* future)
+{
+    ROCPROFVIS_ASSERT_MSG_RETURN(future, ERROR_FUTURE_CANNOT_BE_NULL, kRocProfVisDmResultInvalidParameter);
+    while (true)
+    {
+        ROCPROFVIS_ASSERT_MSG_BREAK(BindObject()->trace_properties, ERROR_TRACE_PROPERTIES_CANNOT_BE_NULL);
+        ROCPROFVIS_ASSERT_MSG_BREAK(BindObject()->trace_properties->metadata_loaded, ERROR_METADATA_IS_NOT_LOADED);
+        rocprofvis_dm_event_id_t range_id;
+        range_id.value = rocprofvis_dm_hash_combine_timestamp(start, end, kRocProfVisDmHashedTimestampTagFlowRange);
+        rocprofvis_dm_flowtrace_t flowtrace = BindObject()->FuncAddFlowTrace(BindObject()->trace_object, range_id);
+        ROCPROFVIS_ASSERT_MSG_BREAK(flowtrace, ERROR_FLOW_TRACE_CANNOT_BE_NULL);
+        std::unordered_set<uint32_t> track_selection(tracks.begin(), tracks.end());
+        bool interrupted = false;
+        for (auto& track_index : m_flow_track_index)
+        {
+            if (!track_selection.empty() && track_selection.find(track_index.first) == track_selection.end())
+            {
+                continue;
+            }
+            const std::vector<uint32_t>& edges = track_index.second.edges;
+            rocprofvis_dm_timestamp_t search_start = start > track_index.second.max_span ? start - track_index.second.max_span : 0;
+            auto it = std::lower_bound(edges.begin(), edges.end(), search_start,
+                [this](uint32_t index, rocprofvis_dm_timestamp_t time) {
+                    return m_flow_index[index].start < time;
+                });
+            for (; it != edges.end() && m_flow_index[*it].start <= end; ++it)
+            {
+                if (future->Interrupted())
+                {
+                    interrupted = true;
+                    break;
+                }
+                const rocprofvis_db_flow_index_edge_t& edge = m_flow_index[*it];
+                if (edge.end < start)
+                {
+                    continue;
+                }
+                // An edge is listed under both of its tracks, report it from the origin track when that one is searched too
+                if (edge.origin.track_id != track_index.first &&
+                    (track_selection.empty() || track_selection.find(edge.origin.track_id) != track_selection.end()))
+                {
+                    continue;
+                }
+                rocprofvis_db_flow_data_t origin = edge.origin;
+                rocprofvis_db_flow_data_t target = edge.target;
+                if (BindObject()->FuncAddFlow(flowtrace, origin) != kRocProfVisDmResultSuccess ||
+                    BindObject()->FuncAddFlow(flowtrace, target) != kRocProfVisDmResultSuccess)
+                {
+                    interrupted = true;
+                    break;
+                }
+            }
+            if (interrupted) break;
+        }
+        if (interrupted) break;
+        ShowProgress(100, "Flow range successfully loaded!", kRPVDbSuccess, future);
+        return future->SetPromise(kRocProfVisDmResultSuccess);
+    }
+    ShowProgress(0, "Flow range not loaded!", kRPVDbError, future);
+    return future->SetPromise(future->Interrupted() ? kRocProfVisDmResultDbAbort : kRocProfVisDmResultDbAccessFailed);
+}
+
+int RocprofDatabase::CallbackAddKernelStats(void* data, int argc, sqlite3_stmt* stmt, char** azColName){
+    ROCPROFVIS_ASSERT_MSG_RETURN(data, ERROR_SQL_QUERY_PARAMETERS_CANNOT_BE_NULL, 1);
+    ROCPROFVIS_ASSERT_MSG_RETURN(argc == s_kernel_stats_schema_params.size(), ERROR_DATABASE_QUERY_PARAMETERS_MISMATCH, 1);
+    void*  func = (void*)&CallbackAddKernelStats;
+    rocprofvis_db_sqlite_callback_parameters* callback_params = (rocprofvis_db_sqlite_callback_parameters*)data;
+    ROCPROFVIS_ASSERT_MSG_RETURN(callback_params->db_instance != nullptr, ERROR_NODE_KEY_CANNOT_BE_NULL, 1);
+    RocprofDatabase* db = (RocprofDatabase*)callback_params->db;
+    // containers of all db instances are created before queries are launched, workers only append to their own
+    auto* kernel_stats = (std::unordered_map<uint32_t, std::vector<rocprofvis_db_kernel_stats_t>>*)callback_params->handle;
+    if(callback_params->future->Interrupted()) return SQLITE_ABORT;
+    rocprofvis_db_kernel_stats_t stats;
+    stats.bucket = db->Sqlite3ColumnInt(func, stmt, azColName, 0);
+    stats.node_id = db->Sqlite3ColumnInt(func, stmt, azColName, 1);
+    stats.agent_id = db->Sqlite3ColumnInt(func, stmt, azColName, 2);
+    stats.kernel_id = db->Sqlite3ColumnInt(func, stmt, azColName, 3);
+    stats.count = db->Sqlite3ColumnInt64(func, stmt, azColName, 4);
+    stats.total = db->Sqlite3ColumnInt64(func, stmt, azColName, 5);
+    stats.min = db->Sqlite3ColumnInt64(func, stmt, azColName, 6);
+    stats.max = db->Sqlite3ColumnInt64(func, stmt, azColName, 7);
+    stats.sum_sq = db->Sqlite3ColumnDouble(func, stmt, azColName, 8);
+    kernel_stats->at(callback_params->db_instance->GuidIndex()).push_back(stats);
+    callback_params->future->CountThisRow();
+    return 0;
+}
+
+std::string RocprofDatabase::BuildKernelStatsQuery(const std::string& bucket, const std::string& where)
+{
+    std::string duration = std::string("(") + Builder::END_SERVICE_NAME + " - " + Builder::START_SERVICE_NAME + ")";
+    std::string query = "SELECT " + bucket + " AS bucket, ";
+    query += Builder::NODE_ID_SERVICE_NAME;
+    query += ", ";
+    query += Builder::AGENT_ID_SERVICE_NAME;
+    query += ", ";
+    query += Builder::KERNEL_ID_SERVICE_NAME;
+    query += ", COUNT(*), SUM(" + duration + "), MIN(" + duration + "), MAX(" + duration + "), SUM(CAST(" + duration + " AS REAL) * " + duration + ")";
+    query += " FROM (" + m_query_factory.GetRocprofKernelStatsQuery() + ") WHERE " + where;
+    query += " GROUP BY bucket, ";
+    query += Builder::NODE_ID_SERVICE_NAME;
+    query += ", ";
+    query += Builder::AGENT_ID_SERVICE_NAME;
+    query += ", ";
+    query += Builder::KERNEL_ID_SERVICE_NAME;
+    return query + ";";
+}
+
+rocprofvis_dm_result_t RocprofDatabase::BuildKernelStats(Future* future)
+{
+    ROCPROFVIS_ASSERT_MSG_RETURN(future, ERROR_FUTURE_CANNOT_BE_NULL, kRocProfVisDmResultInvalidParameter);
+    m_kernel_stats.clear();
+    m_kernel_stats_reach.clear();
+    m_kernel_stats_ready = false;
+    uint64_t bucket_size = TraceProperties()->histogram_bucket_size;
+    if (bucket_size == 0)
+    {
+        return kRocProfVisDmResultSuccess;
+    }
+
+    // one query per db instance, either aggregating dispatches or loading previously saved buckets
+    std::vector<std::pair<DbInstance*, std::string>> queries;
+    std::vector<GuidInfo*> rebuild_guids;
+    for (auto& guid_info : DbInstances())
+    {
+        uint32_t guid_index = guid_info.first.GuidIndex();
+        m_kernel_stats[guid_index].clear();
+        if (false == m_metadata_version_control.MustRebuildKernelStats(guid_info.first.FileIndex()))
+        {
+            queries.push_back({ &guid_info.first, std::string("SELECT * FROM ") + 
+                m_metadata_version_control.GetKernelStatsTableName() + GuidAt(guid_index) + ";" });
+        }
+        else
+        {
+            std::string start_time = std::to_string(TraceProperties()->db_inst_start_time[guid_index]);
+            queries.push_back({ &guid_info.first, BuildKernelStatsQuery(
+                std::string("(") + Builder::START_SERVICE_NAME + " - " + start_time + ") / " + std::to_string(bucket_size),
+                std::string(Builder::START_SERVICE_NAME) + " >= " + start_time) });
+            rebuild_guids.push_back(&guid_info);
+        }
+    }
+
+    rocprofvis_dm_result_t result = ExecuteQueriesAsync(queries, future, (rocprofvis_dm_handle_t)&m_kernel_stats, &CallbackAddKernelStats);
+    if (result != kRocProfVisDmResultSuccess)
+    {
+        m_kernel_stats.clear();
+        if (future->Interrupted())
+        {
+            return kRocProfVisDmResultDbAbort;
+        }
+        // Older databases may lack some of the joined tables, kernel summary then falls back to table queries
+        spdlog::warn("Kernel statistics are not available");
+        return kRocProfVisDmResultSuccess;
+    }
+
+    size_t num_buckets = 0;
+    for (auto& [guid_index, kernel_stats] : m_kernel_stats)
+    {
+        std::sort(kernel_stats.begin(), kernel_stats.end(),
+            [](const rocprofvis_db_kernel_stats_t& a, const rocprofvis_db_kernel_stats_t& b) {
+                return a.bucket < b.bucket;
+            });
+        // running maximum of the latest possible end of dispatches, monotonic in bucket order
+        std::vector<rocprofvis_db_kernel_stats_reach_t>& reach = m_kernel_stats_reach[guid_index];
+        rocprofvis_dm_timestamp_t max_end = 0;
+        for (auto& stats : kernel_stats)
+        {
+            max_end = std::max(max_end, (stats.bucket + 1) * bucket_size + stats.max);
+            if (reach.empty() || reach.back().bucket != stats.bucket)
+            {
+                reach.push_back({ stats.bucket, max_end });
+            }
+            else
+            {
+                reach.back().max_end = max_end;
+            }
+        }
+        reach.shrink_to_fit();
+        kernel_stats.shrink_to_fit();
+        num_buckets += kernel_stats.size();
+    }
+
+    for (GuidInfo* guid_info : rebuild_guids)
+    {
+        std::vector<rocprofvis_db_kernel_stats_t>& kernel_stats = m_kernel_stats[guid_info->first.GuidIndex()];
+        result = CreateSQLTable(
+            (m_metadata_version_control.GetKernelStatsTableName() + guid_info->second).c_str(), s_kernel_stats_schema_params,
+            kernel_stats.size(),
+            [&](sqlite3_stmt* stmt, int index) {
+                rocprofvis_db_kernel_stats_t& stats = kernel_stats[index];
+                sqlite3_bind_int(stmt, 1, stats.bucket);
+                sqlite3_bind_int(stmt, 2, stats.node_id);
+                sqlite3_bind_int(stmt, 3, stats.agent_id);
+                sqlite3_bind_int(stmt, 4, stats.kernel_id);
+                sqlite3_bind_int64(stmt, 5, stats.count);
+                sqlite3_bind_int64(stmt, 6, stats.total);
+                sqlite3_bind_int64(stmt, 7, stats.min);
+                sqlite3_bind_int64(stmt, 8, stats.max);
+                sqlite3_bind_double(stmt, 9, stats.sum_sq);
+            }, guid_info->first.FileIndex());
+        if (result != kRocProfVisDmResultSuccess)
+        {
+            spdlog::warn("Kernel statistics could not be saved for database instance {}", guid_info->first.GuidIndex());
+        }
+    }
+    m_kernel_stats_ready = true;
+    spdlog::debug("Kernel statistics contain {} buckets", num_buckets);
+    return kRocProfVisDmResultSuccess;
+}
+
+rocprofvis_dm_result_t RocprofDatabase::ReadKernelSummary(
+        rocprofvis_dm_charptr_t key,
+        rocprofvis_dm_timestamp_t start,
+        rocprofvis_dm_timestamp_t end,
+        uint64_t node_id,
+        uint64_t agent_id,
+        Future* future)
+{
+    ROCPROFVIS_ASSERT_MSG_RETURN(future, ERROR_FUTURE_CANNOT_BE_NULL, kRocProfVisDmResultInvalidParameter);
+    struct kernel_summary_t
+    {
+        uint64_t count = 0;
+        uint64_t total = 0;
+        uint64_t min = UINT64_MAX;
+        uint64_t max = 0;
+        double sum_sq = 0;
+    };
+    while (true)
+    {
+        ROCPROFVIS_ASSERT_MSG_BREAK(BindObject()->trace_properties, ERROR_TRACE_PROPERTIES_CANNOT_BE_NULL);
+        ROCPROFVIS_ASSERT_MSG_BREAK(BindObject()->trace_properties->metadata_loaded, ERROR_METADATA_IS_NOT_LOADED);
+        if (!m_kernel_stats_ready)
+        {
+            ShowProgress(100, "Kernel statistics are not available!", kRPVDbSuccess, future);
+            return future->SetPromise(kRocProfVisDmResultNotSupported);
+        }
+        auto matches = [node_id, agent_id](const rocprofvis_db_kernel_stats_t& stats) {
+            return (node_id == KERNEL_SUMMARY_ANY_ID || stats.node_id == node_id) &&
+                (agent_id == KERNEL_SUMMARY_ANY_ID || stats.agent_id == agent_id);
+        };
+        std::unordered_map<std::string, kernel_summary_t> kernels;
+        auto add = [&](uint32_t guid_index, const rocprofvis_db_kernel_stats_t& stats) {
+            uint64_t string_index = 0;
+            RemapStringId(stats.kernel_id, rocprofvis_db_string_type_t::kRPVStringTypeKernelSymbol, guid_index, string_index);
+            const char* name = BindObject()->FuncGetString(BindObject()->trace_object, static_cast<uint32_t>(string_index));
+            kernel_summary_t& summary = kernels[name ? name : "N/A"];
+            summary.count += stats.count;
+            summary.total += stats.total;
+            summary.min = std::min(summary.min, stats.min);
+            summary.max = std::max(summary.max, stats.max);
+            summary.sum_sq += stats.sum_sq;
+        };
+
+        // Buckets completely inside the time frame are summed from memory. Dispatches starting in
+        // partially covered buckets, or before the time frame but ending inside it, are read from database
+        uint64_t bucket_size = TraceProperties()->histogram_bucket_size;
+        uint64_t first_bucket = (start + bucket_size - 1) / bucket_size;
+        uint64_t last_bucket = std::max(first_bucket, (end + 1) / bucket_size);
+        std::unordered_map<uint32_t, std::vector<rocprofvis_db_kernel_stats_t>> edges;
+        std::vector<std::pair<DbInstance*, std::string>> queries;
+        for (auto& guid_info : DbInstances())
+        {
+            uint32_t guid_index = guid_info.first.GuidIndex();
+            const std::vector<rocprofvis_db_kernel_stats_t>& kernel_stats = m_kernel_stats[guid_index];
+            auto it = std::lower_bound(kernel_stats.begin(), kernel_stats.end(), first_bucket,
+                [](const rocprofvis_db_kernel_stats_t& stats, uint64_t bucket) {
+                    return stats.bucket < bucket;
+                });
+            for (; it != kernel_stats.end() && it->bucket < last_bucket; ++it)
+            {
+                if (matches(*it)) add(guid_index, *it);
+            }
+
+            uint64_t start_time = TraceProperties()->db_inst_start_time[guid_index];
+            uint64_t fetch_start = start + start_time;
+            uint64_t fetch_end = end + start_time;
+            // dispatches starting before the time frame can only cross its start from the first bucket
+            // whose latest dispatch end reaches it, so the backward scan is bounded by the data around the range
+            const std::vector<rocprofvis_db_kernel_stats_reach_t>& reach = m_kernel_stats_reach[guid_index];
+            auto reach_it = std::lower_bound(reach.begin(), reach.end(), start,
+                [](const rocprofvis_db_kernel_stats_reach_t& entry, rocprofvis_dm_timestamp_t time) {
+                    return entry.max_end < time;
+                });
+            uint64_t search_start = fetch_start;
+            if (reach_it != reach.end())
+            {
+                search_start = std::min<uint64_t>(fetch_start, start_time + reach_it->bucket * bucket_size);
+            }
+            std::string where = std::string(Builder::START_SERVICE_NAME) + " >= " + std::to_string(search_start) + " AND " + 
+                Builder::START_SERVICE_NAME + " <= " + std::to_string(fetch_end) + " AND " +
+                Builder::END_SERVICE_NAME + " >= " + std::to_string(fetch_start) + " AND (" +
+                Builder::START_SERVICE_NAME + " < " + std::to_string(start_time + first_bucket * bucket_size) + " OR " +
+                Builder::START_SERVICE_NAME + " >= " + std::to_string(start_time + last_bucket * bucket_size) + ")";
+            if (node_id != KERNEL_SUMMARY_ANY_ID)
+            {
+                where += std::string(" AND ") + Builder::NODE_ID_SERVICE_NAME + " = " + std::to_string(node_id);
+            }
+            if (agent_id != KERNEL_SUMMARY_ANY_ID)
+            {
+                where += std::string(" AND ") + Builder::AGENT_ID_SERVICE_NAME + " = " + std::to_string(agent_id);
+            }
+            edges[guid_index].clear();
+            queries.push_back({ &guid_info.first, BuildKernelStatsQuery("0", where) });
+        }
+        if (kRocProfVisDmResultSuccess != ExecuteQueriesAsync(queries, future, (rocprofvis_dm_handle_t)&edges, &CallbackAddKernelStats)) break;
+        for (auto& [guid_index, kernel_stats] : edges)
+        {
+            for (auto& stats : kernel_stats)
+            {
+                add(guid_index, stats);
+            }
+        }
+
+        std::vector<std::pair<const std::string*, const kernel_summary_t*>> sorted;
+        sorted.reserve(kernels.size());
+        for (auto& [name, summary] : kernels)
+        {
+            sorted.push_back({ &name, &summary });
+        }
+        std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+            return a.second->total > b.second->total;
+        });
+
+        rocprofvis_dm_table_t table = BindObject()->FuncAddTable(BindObject()->trace_object, key, "Kernel summary");
+        ROCPROFVIS_ASSERT_MSG_BREAK(table, ERROR_TABLE_CANNOT_BE_NULL);
+        bool failed = false;
+        for (const char* column : { "name", "num_invocations", "avg_duration", "min_duration", "max_duration", "total_duration", "stddev_duration" })
+        {
+            failed |= BindObject()->FuncAddTableColumn(table, column) != kRocProfVisDmResultSuccess;
+        }
+        for (auto& [name, summary] : sorted)
+        {
+            if (failed) break;
+            double avg = (double)summary->total / summary->count;
+            double variance = std::max(0.0, summary->sum_sq / summary->count - avg * avg);
+            rocprofvis_dm_table_row_t row = BindObject()->FuncAddTableRow(table);
+            if (row == nullptr)
+            {
+                failed = true;
+                break;
+            }
+            failed |= BindObject()->FuncAddTableRowCell(row, name->c_str()) != kRocProfVisDmResultSuccess;
+            failed |= BindObject()->FuncAddTableRowCellUInt64(row, summary->count) != kRocProfVisDmResultSuccess;
+            failed |= BindObject()->FuncAddTableRowCellDouble(row, avg) != kRocProfVisDmResultSuccess;
+            for (uint64_t cell : { summary->min, summary->max, summary->total })
+            {
+                failed |= BindObject()->FuncAddTableRowCellUInt64(row, cell) != kRocProfVisDmResultSuccess;
+            }
+            failed |= BindObject()->FuncAddTableRowCellDouble(row, std::sqrt(variance)) != kRocProfVisDmResultSuccess;
+        }
+        if (failed) break;
+        ShowProgress(100, "Kernel summary successfully loaded!", kRPVDbSuccess, future);
+        return future->SetPromise(kRocProfVisDmResultSuccess);
+    }
+    ShowProgress(0, "Kernel summary not loaded!", kRPVDbError, future);
+    return future->SetPromise(future->Interrupted() ? kRocProfVisDmResultDbAbort : kRocProfVisDmResultDbAccessFailed);
+}
+
+std::string RocprofDatabase::BuildTrimTableQuery(const std::string& table,
+    const std::vector<std::string>& sorted_tables,
+    rocprofvis_dm_timestamp_t fetch_start,
+    rocprofvis_dm_timestamp_t fetch_end)
+{
+    enum fixed_table_indices_t {
+        kKernelDispatchTable,
+        kMemoryAllocateTable,
+        kMemoryCopyTable,
+        kRegionTable,
+        kSampleTable,
+        kEventTable,
+        kTimestampTable
+    };
+
+    std::string query;
+    if (strstr(table.c_str(), "rocpd_kernel_dispatch") ||
+        strstr(table.c_str(), "rocpd_memory_allocate") ||
+        strstr(table.c_str(), "rocpd_memory_copy") ||
+        strstr(table.c_str(), "rocpd_region"))
+    {
+        query = "INSERT INTO ";
+        query += table;
+        query += " SELECT X.* FROM oldDb.";
+        query += table;
+        if (m_query_factory.IsVersionGreaterOrEqual("4"))
+        {
+            query += " X INNER JOIN oldDb.";
+            query += sorted_tables[kTimestampTable];
+            query += " TS ON X.start_id == TS.id ";
+            query += " INNER JOIN oldDb.";
+            query += sorted_tables[kTimestampTable];
+            query += " TE ON X.end_id == TE.id ";
+            query += " WHERE TS.value < ";
+            query += std::to_string(fetch_end);
+            query += " AND TE.value > ";
+            query += std::to_string(fetch_start);
+        }
+        else
+        {
+            query += " X WHERE start < ";
+            query += std::to_string(fetch_end);
+            query += " AND end > ";
+            query += std::to_string(fetch_start);
+        }
+
+        query += ";";
+    }
+    else if (strstr(table.c_str(), "rocpd_sample"))
+    {
+        query = "INSERT INTO ";
+        query += table;
+        query += " SELECT S.* FROM oldDb.";
+        query += table;
+        query += " S LEFT JOIN oldDb.";
+        query += sorted_tables[kRegionTable]; 
+        query += " R ON  S.event_id = R.event_id AND S.guid = R.guid ";
+        if (m_query_factory.IsVersionGreaterOrEqual("4"))
+        {
+            query += " INNER JOIN oldDb.";
+            query += sorted_tables[kTimestampTable]; 
+            query += " TS ON S.timestamp_id == TS.id ";
+            query += " INNER JOIN oldDb.";
+            query += sorted_tables[kTimestampTable]; 
+            query += " RS ON R.start_id == RS.id ";
+            query += " WHERE (TS.value < ";
+            query += std::to_string(fetch_end);
+            query += " AND TS.value > ";
+            query += std::to_string(fetch_start);
+            query += ") OR RS.value == TS.value";
+        }
+        else
+        {
+            query += " WHERE (timestamp < ";
+            query += std::to_string(fetch_end);
+            query += " AND timestamp > ";
+            query += std::to_string(fetch_start);
+            query += ") OR R.start == S.timestamp";
+        }
+        query += ";";
+    }
+    else if (strstr(table.c_str(), "rocpd_event"))
+    {
+        // This will make target rocpd_event table limited to selected events only 
+        query = "INSERT INTO ";
+        query += table;
+        query += " SELECT DISTINCT E.* FROM oldDb.";
+        query += table;
+        query += " E LEFT JOIN oldDb.";
+        query += sorted_tables[kKernelDispatchTable];
+        query += " K ON E.id = K.event_id LEFT JOIN oldDb.";
+        query += sorted_tables[kMemoryAllocateTable];
+        query += " MA ON E.id = MA.event_id LEFT JOIN oldDb.";
+        query += sorted_tables[kMemoryCopyTable];
+        query += " MC ON E.id = MC.event_id LEFT JOIN oldDb.";
+        query += sorted_tables[kRegionTable];
+        query += " R ON E.id = R.event_id  LEFT JOIN oldDb.";
+        query += sorted_tables[kSampleTable];
+        query += " S ON E.id = S.event_id ";
+        query += " WHERE K.event_id IS NOT NULL OR MA.event_id IS NOT NULL OR MC.event_id IS NOT NULL OR R.event_id IS NOT NULL OR S.event_id IS NOT NULL;";
+    }
+    else if (strstr(table.c_str(), "rocpd_arg") ||
+        strstr(table.c_str(), "rocpd_pmc_event"))
+    {
+        // This will make target rocpd_arg and rocpd_pmc_event table limited to selected events only 
+        query = "INSERT INTO ";
+        query += table;
+        query += " SELECT X.* FROM oldDb.";
+        query += table;
+        query += " X LEFT JOIN oldDb.";
+        query += sorted_tables[kEventTable];
+        query += " E ON E.id = X.event_id ";
+        query += " WHERE E.id IS NOT NULL;";
+    }
+    else
+    {
+        // Untouched table. Identical schema lets sqlite use its transfer optimization (page level copy)
+        query = "INSERT INTO ";
+        query += table;
+        query += " SELECT * FROM oldDb.";
+        query += table;
+        query += ";";
+    }
+    return query;
+}
+
+rocprofvis_dm_result_t RocprofDatabase::TrimWorkerStatic(RocprofDatabase* db,
+    rocprofvis_db_trim_context_t* context,
+    rocprofvis_db_trim_part_t* part,
+    Future* future)
+{
+    return future->SetPromise(db->TrimWorker(*context, *part, future));
+}
+
+rocprofvis_dm_result_t RocprofDatabase::TrimWorker(rocprofvis_db_trim_context_t& context,
+    rocprofvis_db_trim_part_t& part,
+    Future* future)
+{
+    TemporaryDbInstance tmp_db_instance(0);
+    uint32_t attached_file = INVALID_INDEX;
+
+    std::filesystem::remove(part.path);
+    RocprofDatabase part_db(part.path.c_str());
+    rocprofvis_dm_result_t result = part_db.Open();
+    if (result == kRocProfVisDmResultSuccess)
+    {
+        // Part database is temporary, no need to wait for disk on every commit
+        result = part_db.ExecuteSQLQuery(future, &tmp_db_instance, "PRAGMA synchronous = OFF;");
+    }
+
+    while (result == kRocProfVisDmResultSuccess)
+    {
+        size_t task_index = context.next_task.fetch_add(1);
+        if (task_index >= context.tasks.size()) break;
+        if (future->Interrupted())
+        {
+            result = kRocProfVisDmResultDbAbort;
+            break;
+        }
+
+        rocprofvis_db_trim_task_t& task = context.tasks[task_index];
+        if (task.file_index != attached_file)
+        {
+            // Tasks are ordered by file, so a worker rarely has to switch source database
+            if (attached_file != INVALID_INDEX)
+            {
+                result = part_db.ExecuteSQLQuery(future, &tmp_db_instance, "DETACH oldDb;");
+                if (result != kRocProfVisDmResultSuccess) break;
+                attached_file = INVALID_INDEX;
+            }
+            std::filesystem::path p(m_db_nodes[task.file_index]->filepath);
+            p = p.lexically_normal();
+            result = part_db.ExecuteSQLQuery(future, &tmp_db_instance, (std::string("ATTACH DATABASE '") + p.generic_string() + "' as 'oldDb';").c_str());
+            if (result != kRocProfVisDmResultSuccess) break;
+            attached_file = task.file_index;
+        }
+
+        // Same table may come from several files, create it once per part and append the rows
+        bool table_created = std::find(part.tables.begin(), part.tables.end(), task.table) != part.tables.end();
+        if (!table_created)
+        {
+            result = part_db.ExecuteSQLQuery(future, &tmp_db_instance, task.create_sql.c_str());
+            if (result != kRocProfVisDmResultSuccess) break;
+        }
+        result = part_db.ExecuteSQLQuery(future, &tmp_db_instance, task.insert_query.c_str());
+        if (result != kRocProfVisDmResultSuccess) break;
+
+        if (!table_created)
+        {
+            part.tables.push_back(task.table);
+        }
+        std::lock_guard<std::mutex> lock(context.progress_mutex);
+        std::string msg = "Copied table " + task.table + " (" + std::to_string(++context.completed_tasks) + " of " + std::to_string(context.tasks.size()) + ")";
+        ShowProgress(1, msg.c_str(), kRPVDbBusy, context.future);
+    }
+
+    if (attached_file != INVALID_INDEX)
+    {
+        part_db.ExecuteSQLQuery(future, &tmp_db_instance, "DETACH oldDb;");
+    }
+    return result;
+}
+
 rocprofvis_dm_result_t RocprofDatabase::SaveTrimmedData(rocprofvis_dm_timestamp_t start,
     rocprofvis_dm_timestamp_t end,
     rocprofvis_dm_charptr_t new_db_path, Future* future)
@@ -1421,12 +2017,25 @@ rocprofvis_dm_result_t RocprofDatabase::SaveTrimmedData(rocprofvis_dm_timestamp_
         kRocProfVisDmResultInvalidParameter);
     rocprofvis_dm_result_t result = kRocProfVisDmResultInvalidParameter;
 
-    std::string query;
     rocprofvis_db_sqlite_trim_parameters trim_tables;
     rocprofvis_db_sqlite_trim_parameters trim_views;
+    rocprofvis_db_sqlite_trim_parameters trim_indexes;
+    rocprofvis_db_sqlite_trim_parameters trim_index_tables;
     rocprofvis_db_sqlite_trim_parameters rocpd_trim_views;
     TemporaryDbInstance tmp_db_instance(0);
+    rocprofvis_db_trim_context_t context;
+    std::vector<rocprofvis_db_trim_part_t> parts;
+    context.future = future;
 
+    auto RemoveParts = [&]()
+        {
+            for (auto& part : parts)
+            {
+                std::filesystem::remove(part.path);
+                std::filesystem::remove(part.path + "-wal");
+                std::filesystem::remove(part.path + "-shm");
+            }
+        };
 
     std::filesystem::remove(new_db_path);
 
@@ -1449,6 +2058,12 @@ rocprofvis_dm_result_t RocprofDatabase::SaveTrimmedData(rocprofvis_dm_timestamp_
             ShowProgress(1, "Iterate over views", kRPVDbBusy, future);
             result = ExecuteSQLQuery(future, &db_instance, "SELECT name, sql FROM sqlite_master WHERE type='view';", "", (rocprofvis_dm_handle_t)&trim_views, &CallbackTrimTableQuery);
             if (result != kRocProfVisDmResultSuccess) break;
+
+            ShowProgress(1, "Iterate over indexes", kRPVDbBusy, future);
+            result = ExecuteSQLQuery(future, &db_instance, "SELECT name, sql FROM sqlite_master WHERE type='index' AND sql IS NOT NULL;", "", (rocprofvis_dm_handle_t)&trim_indexes, &CallbackTrimTableQuery);
+            if (result != kRocProfVisDmResultSuccess) break;
+            result = ExecuteSQLQuery(future, &db_instance, "SELECT name, tbl_name FROM sqlite_master WHERE type='index' AND sql IS NOT NULL;", "", (rocprofvis_dm_handle_t)&trim_index_tables, &CallbackTrimTableQuery);
+            if (result != kRocProfVisDmResultSuccess) break;
         }
 
         if (result != kRocProfVisDmResultSuccess) break;
@@ -1485,6 +2100,7 @@ rocprofvis_dm_result_t RocprofDatabase::SaveTrimmedData(rocprofvis_dm_timestamp_
 
         if (result != kRocProfVisDmResultSuccess) break;
 
+        std::set<std::string> created_tables;
         for(auto const& table : trim_tables.tables)
         {
             if(!IsSqliteTable(table.first) && !GetMetadataVersionControl()->DisposeTableWhenTrimming(table.first))
@@ -1492,6 +2108,7 @@ rocprofvis_dm_result_t RocprofDatabase::SaveTrimmedData(rocprofvis_dm_timestamp_
                 if(result == kRocProfVisDmResultSuccess)
                 {
                     result = rpDb.ExecuteSQLQuery(future,&tmp_db_instance,  table.second.c_str());
+                    created_tables.insert(table.first);
                 }
                 else
                 {
@@ -1503,18 +2120,6 @@ rocprofvis_dm_result_t RocprofDatabase::SaveTrimmedData(rocprofvis_dm_timestamp_
         if (result != kRocProfVisDmResultSuccess) break;
 
         std::vector<std::string> order = {"rocpd_kernel_dispatch", "rocpd_memory_allocate", "rocpd_memory_copy", "rocpd_region", "rocpd_sample", "rocpd_event", "rocpd_timestamp"};
-        enum fixed_table_indices_t {
-            kKernelDispatchTable,
-            kMemoryAllocateTable,
-            kMemoryCopyTable,
-            kRegionTable,
-            kSampleTable,
-            kEventTable,
-            kTimestampTable
-        };
-        std::unordered_map<std::string, size_t> priority;
-        for (size_t i = 0; i < order.size(); ++i)
-            priority[order[i]] = i;
 
         auto get_priority = [&](const std::string& s) -> size_t
             {
@@ -1526,8 +2131,9 @@ rocprofvis_dm_result_t RocprofDatabase::SaveTrimmedData(rocprofvis_dm_timestamp_
                 return order.size(); 
             };
 
-
-
+        // Every table copy reads only from the source database, so tables are independent units of work.
+        // Files can share table names, so a table is queued once per source file.
+        std::set<std::pair<size_t, std::string>> queued_tables;
         for (auto& guid_info : DbInstances())
         {
             std::vector<std::string> sorted_tables;
@@ -1549,156 +2155,93 @@ rocprofvis_dm_result_t RocprofDatabase::SaveTrimmedData(rocprofvis_dm_timestamp_
                     return a < b; 
                 });
 
-            ShowProgress(0, "Attaching old DB to new", kRPVDbBusy, future);
-
             rocprofvis_dm_timestamp_t fecth_start = start + TraceProperties()->db_inst_start_time[guid_info.first.GuidIndex()];
             rocprofvis_dm_timestamp_t fetch_end = end + TraceProperties()->db_inst_start_time[guid_info.first.GuidIndex()];
             auto& file_node = m_db_nodes[guid_info.first.FileIndex()];
 
-            std::filesystem::path p(file_node->filepath);
-            p = p.lexically_normal();
-
-            result = rpDb.ExecuteSQLQuery(future, &tmp_db_instance, (std::string("ATTACH DATABASE '") + p.generic_string() + "' as 'oldDb';").c_str());
-
-            if (result != kRocProfVisDmResultSuccess) break;
-
             for (auto const& table : sorted_tables)
             {
-                if (!IsSqliteTable(table) && !GetMetadataVersionControl()->DisposeTableWhenTrimming(table) && CheckTableExists(table, file_node->node_id) )
+                if (!IsSqliteTable(table) && !GetMetadataVersionControl()->DisposeTableWhenTrimming(table) && CheckTableExists(table, file_node->node_id) &&
+                    queued_tables.insert({ guid_info.first.FileIndex(), table }).second)
                 {
-                    if (result == kRocProfVisDmResultSuccess)
-                    {
-                        std::string msg = "Copy table " + table;
-                        ShowProgress(1, msg.c_str(), kRPVDbBusy, future);
-
-                        if (result == kRocProfVisDmResultSuccess)
-                        {
-                            if (strstr(table.c_str(), "rocpd_kernel_dispatch") ||
-                                strstr(table.c_str(), "rocpd_memory_allocate") ||
-                                strstr(table.c_str(), "rocpd_memory_copy") ||
-                                strstr(table.c_str(), "rocpd_region"))
-                            {
-                                query = "INSERT INTO ";
-                                query += table;
-                                query += " SELECT X.* FROM oldDb.";
-                                query += table;
-                                if (m_query_factory.IsVersionGreaterOrEqual("4"))
-                                {
-                                    query += " X INNER JOIN oldDb.";
-                                    query += sorted_tables[kTimestampTable];
-                                    query += " TS ON X.start_id == TS.id ";
-                                    query += " INNER JOIN oldDb.";
-                                    query += sorted_tables[kTimestampTable];
-                                    query += " TE ON X.end_id == TE.id ";
-                                    query += " WHERE TS.value < ";
-                                    query += std::to_string(fetch_end);
-                                    query += " AND TE.value > ";
-                                    query += std::to_string(fecth_start);
-                                }
-                                else
-                                {
-                                    query += " X WHERE start < ";
-                                    query += std::to_string(fetch_end);
-                                    query += " AND end > ";
-                                    query += std::to_string(fecth_start);
-                                }
-
-                                query += ";";
-                            }
-                            else if (strstr(table.c_str(), "rocpd_sample"))
-                            {
-                                query = "INSERT INTO ";
-                                query += table;
-                                query += " SELECT S.* FROM oldDb.";
-                                query += table;
-                                query += " S LEFT JOIN oldDb.";
-                                query += sorted_tables[kRegionTable]; 
-                                query += " R ON  S.event_id = R.event_id AND S.guid = R.guid ";
-                                if (m_query_factory.IsVersionGreaterOrEqual("4"))
-                                {
-                                    query += " INNER JOIN oldDb.";
-                                    query += sorted_tables[kTimestampTable]; 
-                                    query += " TS ON S.timestamp_id == TS.id ";
-                                    query += " INNER JOIN oldDb.";
-                                    query += sorted_tables[kTimestampTable]; 
-                                    query += " RS ON R.start_id == RS.id ";
-                                    query += " WHERE (TS.value < ";
-                                    query += std::to_string(fetch_end);
-                                    query += " AND TS.value > ";
-                                    query += std::to_string(fecth_start);
-                                    query += ") OR RS.value == TS.value";
-                                }
-                                else
-                                {
-                                    query += " WHERE (timestamp < ";
-                                    query += std::to_string(fetch_end);
-                                    query += " AND timestamp > ";
-                                    query += std::to_string(fecth_start);
-                                    query += ") OR R.start == S.timestamp";
-                                }
-                                query += ";";
-                            }
-                            else if (strstr(table.c_str(), "rocpd_event"))
-                            {
-                                // This will make target rocpd_event table limited to selected events only 
-                                query = "INSERT INTO ";
-                                query += table;
-                                query += " SELECT DISTINCT E.* FROM oldDb.";
-                                query += table;
-                                query += " E LEFT JOIN oldDb.";
-                                query += sorted_tables[kKernelDispatchTable];
-                                query += " K ON E.id = K.event_id LEFT JOIN oldDb.";
-                                query += sorted_tables[kMemoryAllocateTable];
-                                query += " MA ON E.id = MA.event_id LEFT JOIN oldDb.";
-                                query += sorted_tables[kMemoryCopyTable];
-                                query += " MC ON E.id = MC.event_id LEFT JOIN oldDb.";
-                                query += sorted_tables[kRegionTable];
-                                query += " R ON E.id = R.event_id  LEFT JOIN oldDb.";
-                                query += sorted_tables[kSampleTable];
-                                query += " S ON E.id = S.event_id ";
-                                query += " WHERE K.event_id IS NOT NULL OR MA.event_id IS NOT NULL OR MC.event_id IS NOT NULL OR R.event_id IS NOT NULL OR S.event_id IS NOT NULL;";
-                            }
-                            else if (strstr(table.c_str(), "rocpd_arg") ||
-                                strstr(table.c_str(), "rocpd_pmc_event"))
-                            {
-                                // This will make target rocpd_arg and rocpd_pmc_event table limited to selected events only 
-                                query = "INSERT INTO ";
-                                query += table;
-                                query += " SELECT X.* FROM oldDb.";
-                                query += table;
-                                query += " X LEFT JOIN oldDb.";
-                                query += sorted_tables[kEventTable];
-                                query += " E ON E.id = X.event_id ";
-                                query += " WHERE E.id IS NOT NULL;";
-                            }
-                            else
-                            {
-                                query = "INSERT INTO ";
-                                query += table;
-                                query += " SELECT * FROM oldDb.";
-                                query += table;
-                                query += ";";
-                            }
-
-                            result = rpDb.ExecuteSQLQuery(future,&tmp_db_instance, query.c_str());
-                        }
-                        else
-                        {
-                            break;
-                        }
-                    }
-                    else
-                    {
-                        break;
-                    }
+                    context.tasks.push_back({ guid_info.first.FileIndex(), table, trim_tables.tables[table],
+                        BuildTrimTableQuery(table, sorted_tables, fecth_start, fetch_end) });
+                }
+            }
+        }
+        std::stable_sort(context.tasks.begin(), context.tasks.end(),
+            [](const rocprofvis_db_trim_task_t& a, const rocprofvis_db_trim_task_t& b) { return a.file_index < b.file_index; });
+
+        size_t worker_count = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), TRIM_MAX_WORKERS);
+        worker_count = std::min(worker_count, context.tasks.size());
+        parts.resize(worker_count);
+        std::vector<Future*> futures(worker_count, nullptr);
+        ShowProgress(1, "Copying tables", kRPVDbBusy, future);
+        for (size_t i = 0; i < worker_count; i++)
+        {
+            parts[i].path = std::string(new_db_path) + ".part" + std::to_string(i);
+            futures[i] = future->AddSubFuture();
+            try
+            {
+                futures[i]->SetWorker(std::move(
+                    std::thread(TrimWorkerStatic, this, &context, &parts[i], futures[i])));
+            } catch(const std::exception& ex)
+            {
+                future->DeleteSubFuture(futures[i]);
+                futures[i] = nullptr;
+                result = kRocProfVisDmResultUnknownError;
+                ROCPROFVIS_ASSERT_MSG_BREAK(false, ex.what());
+            }
+        }
+        for (size_t i = 0; i < worker_count; i++)
+        {
+            if (futures[i] != nullptr)
+            {
+                rocprofvis_dm_result_t worker_result = future->WaitAndDeleteSubFuture(futures[i]);
+                if (result == kRocProfVisDmResultSuccess)
+                {
+                    result = worker_result;
                 }
+                futures[i] = nullptr;
             }
+        }
 
-            ShowProgress(0, "Detaching old DB", kRPVDbBusy, future);
-            result = rpDb.ExecuteSQLQuery(future,&tmp_db_instance, "DETACH oldDb;");
+        if (result != kRocProfVisDmResultSuccess) break;
 
+        // Bulk load into empty tables without indexes, then build indexes once
+        result = rpDb.ExecuteSQLQuery(future, &tmp_db_instance, "PRAGMA synchronous = OFF;");
+        for (auto& part : parts)
+        {
             if (result != kRocProfVisDmResultSuccess) break;
+            if (part.tables.empty()) continue;
 
+            ShowProgress(1, "Merging copied tables", kRPVDbBusy, future);
+            result = rpDb.ExecuteSQLQuery(future, &tmp_db_instance, (std::string("ATTACH DATABASE '") + part.path + "' as 'partDb';").c_str());
+            for (auto const& table : part.tables)
+            {
+                if (result != kRocProfVisDmResultSuccess) break;
+                std::string query = "INSERT INTO " + table + " SELECT * FROM partDb." + table + ";";
+                result = rpDb.ExecuteSQLQuery(future, &tmp_db_instance, query.c_str());
+            }
+            rocprofvis_dm_result_t detach_result = rpDb.ExecuteSQLQuery(future, &tmp_db_instance, "DETACH partDb;");
+            if (result == kRocProfVisDmResultSuccess)
+            {
+                result = detach_result;
+            }
+        }
+
+        if (result != kRocProfVisDmResultSuccess) break;
+
+        for (auto const& index : trim_indexes.tables)
+        {
+            auto table_it = trim_index_tables.tables.find(index.first);
+            if (table_it != trim_index_tables.tables.end() && created_tables.count(table_it->second))
+            {
+                std::string msg = "Create index " + index.first;
+                ShowProgress(1, msg.c_str(), kRPVDbBusy, future);
+                result = rpDb.ExecuteSQLQuery(future, &tmp_db_instance, index.second.c_str());
+                if (result != kRocProfVisDmResultSuccess) break;
+            }
         }
 
         if (result != kRocProfVisDmResultSuccess) break;
@@ -1725,11 +2268,12 @@ rocprofvis_dm_result_t RocprofDatabase::SaveTrimmedData(rocprofvis_dm_timestamp_
 
         if (result != kRocProfVisDmResultSuccess) break;
 
+        RemoveParts();
         ShowProgress(100, "Trace trimmed successfully!", kRPVDbSuccess, future);
         return future->SetPromise(result);
     }
 
-
+    RemoveParts();
     ShowProgress(0, "Failed to trim track!", kRPVDbError, future);
     return future->SetPromise(result);
 }
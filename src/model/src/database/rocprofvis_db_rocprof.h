@@ -5,6 +5,7 @@
 
 #include "rocprofvis_db_profile.h"
 #include "rocprofvis_db_query_factory.h"
+#include <atomic>
 
 namespace RocProfVis
 {
@@ -59,6 +60,78 @@ typedef struct rocprofvis_db_memalloc_activity_t
     rocprofvis_db_memalloc_level_t level;
 }rocprofvis_db_memalloc_activity_t;
 
+// Flow index endpoint, as read from database, before pairing by correlation (stack) id
+typedef struct rocprofvis_db_flow_index_endpoint_t
+{
+    uint64_t stack_id;
+    rocprofvis_db_flow_data_t data;
+}rocprofvis_db_flow_index_endpoint_t;
+
+// Flow index edge. Start and end are the time hull of both endpoints, used for time range search
+typedef struct rocprofvis_db_flow_index_edge_t
+{
+    rocprofvis_dm_timestamp_t start;
+    rocprofvis_dm_timestamp_t end;
+    rocprofvis_db_flow_data_t origin;
+    rocprofvis_db_flow_data_t target;
+}rocprofvis_db_flow_index_edge_t;
+
+// Flow index of one track: edges with an endpoint on the track, sorted by edge start time
+typedef struct rocprofvis_db_flow_track_index_t
+{
+    std::vector<uint32_t> edges;
+    // longest edge time hull on this track, bounds the backward search for edges crossing time frame start
+    rocprofvis_dm_timestamp_t max_span;
+}rocprofvis_db_flow_track_index_t;
+
+// Statistics of one kernel symbol on one agent, aggregated over dispatches starting in one histogram bucket
+typedef struct rocprofvis_db_kernel_stats_t
+{
+    uint32_t bucket;
+    uint32_t node_id;
+    uint32_t agent_id;
+    uint32_t kernel_id;
+    uint64_t count;
+    uint64_t total;
+    uint64_t min;
+    uint64_t max;
+    double sum_sq;
+}rocprofvis_db_kernel_stats_t;
+
+// Latest possible end of dispatches starting in or before a histogram bucket, relative to db instance start
+typedef struct rocprofvis_db_kernel_stats_reach_t
+{
+    uint32_t bucket;
+    rocprofvis_dm_timestamp_t max_end;
+}rocprofvis_db_kernel_stats_reach_t;
+
+// Unit of work of parallel trace trimming, single table of single database file
+typedef struct rocprofvis_db_trim_task_t
+{
+    uint32_t file_index;
+    std::string table;
+    std::string create_sql;
+    std::string insert_query;
+}rocprofvis_db_trim_task_t;
+
+// State shared by trim workers
+typedef struct rocprofvis_db_trim_context_t
+{
+    std::vector<rocprofvis_db_trim_task_t> tasks;
+    std::atomic<size_t> next_task{0};
+    size_t completed_tasks = 0;
+    // serializes progress reports to parent future
+    std::mutex progress_mutex;
+    Future* future = nullptr;
+}rocprofvis_db_trim_context_t;
+
+// Temporary database written by single trim worker, merged into trimmed database at the end
+typedef struct rocprofvis_db_trim_part_t
+{
+    std::string path;
+    std::vector<std::string> tables;
+}rocprofvis_db_trim_part_t;
+
 class RocprofDatabase : public ProfileDatabase
 {
 
@@ -100,6 +173,32 @@ public:
     rocprofvis_dm_result_t  ReadFlowTraceInfo(
                                         rocprofvis_dm_event_id_t event_id,
                                         Future* object) override;
+    // worker method to read all flow edges for time frame from flow index
+    // @param start - start timestamp of time frame 
+    // @param end - end timestamp of time frame 
+    // @param tracks - vector of track IDs, empty for all tracks
+    // @param object - future object providing asynchronous execution mechanism 
+    // @return status of operation
+    rocprofvis_dm_result_t  ReadFlowRange(
+                                        rocprofvis_dm_timestamp_t start,
+                                        rocprofvis_dm_timestamp_t end,
+                                        const std::vector<uint32_t>& tracks,
+                                        Future* object) override;
+    // worker method to read kernel statistics for time frame from kernel statistics buckets
+    // @param key - table key, used as table query
+    // @param start - start timestamp of time frame 
+    // @param end - end timestamp of time frame 
+    // @param node_id - node ID filter
+    // @param agent_id - agent ID filter
+    // @param object - future object providing asynchronous execution mechanism 
+    // @return status of operation
+    rocprofvis_dm_result_t  ReadKernelSummary(
+                                        rocprofvis_dm_charptr_t key,
+                                        rocprofvis_dm_timestamp_t start,
+                                        rocprofvis_dm_timestamp_t end,
+                                        uint64_t node_id,
+                                        uint64_t agent_id,
+                                        Future* object) override;
     // worker method to read stack trace info
     // @param event_id - 60-bit event id and 4-bit operation type  
     // @param object - future object providing asynchronous execution mechanism 
@@ -139,9 +238,12 @@ public:
 protected:
 
     uint64_t GetMemoryActivityTableSchemaHash();
+    uint64_t GetKernelStatsQueryAndSchemaHash();
     std::string GetLevelSchemaHashStr();
 
 private:
+    // upper limit of concurrent table copies when trimming, each worker writes its own temporary database
+    static constexpr size_t TRIM_MAX_WORKERS = 8;
 
     // ------------------------------SQL query callbacks-----------------------------------
     // @param data - pointer to callback caller argument
@@ -158,6 +260,10 @@ private:
     static int CallbackNodeEnumeration(void* data, int argc, sqlite3_stmt* stmt, char** azColName);
     // sqlite3_exec callback to parse metadata table of new schema rocprof database
     static int CallbackParseMetadata(void* data, int argc, sqlite3_stmt* stmt, char** azColName);
+    // sqlite3_exec callback to collect flow endpoints with correlation id for flow index
+    static int CallbackAddFlowIndexEndpoint(void* data, int argc, sqlite3_stmt* stmt, char** azColName);
+    // sqlite3_exec callback to collect kernel statistics buckets
+    static int CallbackAddKernelStats(void* data, int argc, sqlite3_stmt* stmt, char** azColName);
 
     // ---------------------------------- Helpers ----------------------------------------
     rocprofvis_dm_result_t  Cleanup(Future* future, bool rebuild) override { return m_metadata_version_control.CleanupDatabase(future, rebuild); };
@@ -176,6 +282,41 @@ private:
     rocprofvis_dm_result_t CreateAgentFriendlyMemoryAllocationTable(Future* future);
     rocprofvis_dm_result_t LoadMemoryActivityData(Future* future);
     rocprofvis_dm_result_t GenerateInterdependencyTables(Future* future);
+    // method to build flow index, pairing launch endpoints with GPU operation endpoints of same correlation id
+    // @param future - future object providing asynchronous execution mechanism 
+    // @return status of operation
+    rocprofvis_dm_result_t BuildFlowIndex(Future* future);
+    // method to build or load kernel statistics, aggregated per histogram bucket, agent and kernel symbol
+    // @param future - future object providing asynchronous execution mechanism 
+    // @return status of operation
+    rocprofvis_dm_result_t BuildKernelStats(Future* future);
+    // method to build query aggregating kernel dispatches into kernel statistics rows
+    // @param bucket - bucket column expression
+    // @param where - filter applied to dispatches, in database time
+    // @return aggregation query
+    std::string BuildKernelStatsQuery(const std::string& bucket, const std::string& where);
+    // method to build query copying trimmed content of a table from source database attached as oldDb
+    // @param table - table name
+    // @param sorted_tables - tables of the same GUID, in order of trim dependency
+    // @param fetch_start - start timestamp of trimmed region, in database time
+    // @param fetch_end - end timestamp of trimmed region, in database time
+    // @return INSERT query
+    std::string BuildTrimTableQuery(const std::string& table,
+                                    const std::vector<std::string>& sorted_tables,
+                                    rocprofvis_dm_timestamp_t fetch_start,
+                                    rocprofvis_dm_timestamp_t fetch_end);
+    // worker method copying trim tasks into its own part database
+    // @param context - shared trim state
+    // @param part - part database owned by this worker
+    // @param future - future object of this worker
+    // @return status of operation
+    rocprofvis_dm_result_t TrimWorker(rocprofvis_db_trim_context_t& context,
+                                      rocprofvis_db_trim_part_t& part,
+                                      Future* future);
+    static rocprofvis_dm_result_t TrimWorkerStatic(RocprofDatabase* db,
+                                                   rocprofvis_db_trim_context_t* context,
+                                                   rocprofvis_db_trim_part_t* part,
+                                                   Future* future);
 
     const rocprofvis_event_data_category_map_t* GetCategoryEnumMap() override {
         return &s_rocprof_categorized_data;
@@ -213,6 +354,15 @@ private:
         memalloc_activity_t m_memalloc_activity;
         mem_free_stream_to_agent_t m_memfree_stream_to_agent;
         RocprofMetadataVersionControl m_metadata_version_control;
+        // flow edges of all db instances, one per target endpoint. Built once at metadata load, read-only afterwards
+        std::vector<rocprofvis_db_flow_index_edge_t> m_flow_index;
+        // per track edge lists into m_flow_index, so a search only walks the requested tracks
+        std::unordered_map<uint32_t, rocprofvis_db_flow_track_index_t> m_flow_track_index;
+        // kernel statistics of each db instance, sorted by bucket. Built once at metadata load, read-only afterwards
+        std::unordered_map<uint32_t, std::vector<rocprofvis_db_kernel_stats_t>> m_kernel_stats;
+        // reach of each db instance, one entry per non-empty bucket. Bounds the backward search for dispatches crossing time frame start
+        std::unordered_map<uint32_t, std::vector<rocprofvis_db_kernel_stats_reach_t>> m_kernel_stats_reach;
+        bool m_kernel_stats_ready = false;
 
         inline static const rocprofvis_event_data_category_map_t
             s_rocprof_categorized_data = {
@@ -322,6 +472,18 @@ private:
             { "track_id", "INTEGER" },
         };
 
+        inline static SQLInsertParams s_kernel_stats_schema_params = {
+            { "bucket", "INTEGER" },
+            { "node_id", "INTEGER" },
+            { "agent_id", "INTEGER" },
+            { "kernel_id", "INTEGER" },
+            { "count", "INTEGER" },
+            { "total", "INTEGER" },
+            { "min", "INTEGER" },
+            { "max", "INTEGER" },
+            { "sum_sq", "REAL" },
+        };
+
         inline static SQLInsertParams s_level_schema_params = { { "eid", "INTEGER PRIMARY KEY" }, { "level", "INTEGER" } , { "level_for_stream", "INTEGER" } , { "parent_id", "INTEGER" }};
 
         friend class RocprofMetadataVersionControl;
@@ -6,6 +6,7 @@
 #include "rocprofvis_shared_types.h"
 #include "rocprofvis_c_interface.h"
 #include <sstream>
+#include <chrono>
 
 namespace RocProfVis
 {
@@ -187,11 +188,15 @@ rocprofvis_dm_result_t SqliteDatabase::ExecuteSQLQueryStaticWithHandle(
     const char* query,
     rocprofvis_dm_handle_t handle,
     uint32_t query_index,
-    RpvSqliteExecuteQueryCallback callback)
+    RpvSqliteExecuteQueryCallback callback,
+    std::function<void(uint32_t)> on_query_done)
 {
-    return future->SetPromise(
-        db->ExecuteSQLQuery(future, db_instance, query, handle, query_index, callback)
-    );
+    rocprofvis_dm_result_t result = db->ExecuteSQLQuery(future, db_instance, query, handle, query_index, callback);
+    if (on_query_done)
+    {
+        on_query_done(query_index);
+    }
+    return future->SetPromise(result);
 }
 
 int
@@ -262,10 +267,28 @@ rocprofvis_dm_result_t SqliteDatabase::OpenConnection(uint32_t db_node_id, sqlit
     {
         sqlite3_exec(*connection, "PRAGMA journal_mode=WAL;", nullptr, nullptr, nullptr);
         sqlite3_exec(*connection, "PRAGMA synchronous = NORMAL;", nullptr, nullptr, nullptr);
+        std::lock_guard<std::mutex> lock(m_connection_labels_mutex);
+        m_connection_labels[*connection] = m_db_nodes[db_node_id]->filepath + "#" +
+                                           std::to_string(m_connection_labels.size());
     }
     return kRocProfVisDmResultSuccess;
 }
 
+std::string SqliteDatabase::ConnectionLabel(sqlite3* db)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_connection_labels_mutex);
+        auto it = m_connection_labels.find(db);
+        if(it != m_connection_labels.end())
+        {
+            return it->second;
+        }
+    }
+    // connection not opened by OpenConnection
+    const char* filename = sqlite3_db_filename(db, "main");
+    return filename != nullptr ? filename : "";
+}
+
 rocprofvis_dm_result_t SqliteDatabase::Close()
 {
     rocprofvis_dm_result_t result = kRocProfVisDmResultSuccess;
@@ -573,6 +596,7 @@ int SqliteDatabase::Sqlite3Exec(sqlite3* db, const char* query,
                             int (*callback)(void*, int, sqlite3_stmt*, char**),
                               void* user_data)
 {
+    PROFILE_ZONE("model", "SQL query");
     int rc=0;
     sqlite3_stmt* stmt = nullptr;
     rocprofvis_db_sqlite_callback_parameters* callback_params =
@@ -581,16 +605,34 @@ int SqliteDatabase::Sqlite3Exec(sqlite3* db, const char* query,
     {
         callback_params->future->LinkDatabase(this, db);
     }
+    bool     telemetry = m_query_telemetry.IsEnabled();
+    uint64_t row_count = 0;
+    uint64_t byte_count = 0;
+    auto     start_time = std::chrono::steady_clock::now();
     sqlite3_mutex_enter(sqlite3_db_mutex(db));
     rc = sqlite3_prepare_v2(db, query, -1, &stmt, nullptr);
-    if(rc == SQLITE_OK)
+    std::string error;
+    if(telemetry && rc != SQLITE_OK)
+    {
+        error = sqlite3_errmsg(db);
+    }
+    // sqlite3_interrupt has no effect on a statement which has not started yet,
+    // a future cancelled before this point must not run the query at all
+    if(rc == SQLITE_OK && callback_params->future != nullptr && callback_params->future->Interrupted())
+    {
+        sqlite3_finalize(stmt);
+        rc = SQLITE_ABORT;
+    }
+    else if(rc == SQLITE_OK)
     {
         int                cols = sqlite3_column_count(stmt);
         std::vector<std::string> col_names_strorage;
         std::vector<char*> col_names;
+        int                step_rc = SQLITE_OK;
 
-        while(sqlite3_step(stmt) == SQLITE_ROW)
+        while((step_rc = sqlite3_step(stmt)) == SQLITE_ROW)
         {
+            row_count++;
             if (col_names.size() == 0)
             {
                 for(int i = 0; i < cols; ++i)
@@ -624,7 +666,28 @@ int SqliteDatabase::Sqlite3Exec(sqlite3* db, const char* query,
                     break;
                 }
             }
+            if(telemetry)
+            {
+                // measured after the callback so text columns are not converted twice
+                for(int i = 0; i < cols; ++i)
+                {
+                    switch(sqlite3_column_type(stmt, i))
+                    {
+                        case SQLITE_INTEGER:
+                        case SQLITE_FLOAT: byte_count += sizeof(uint64_t); break;
+                        case SQLITE_TEXT:
+                        case SQLITE_BLOB: byte_count += sqlite3_column_bytes(stmt, i); break;
+                        default: break;
+                    }
+                }
+            }
+        }
+        // Interrupted query returns partial result, it must not be reported as complete
+        if(rc == SQLITE_OK && step_rc == SQLITE_INTERRUPT)
+        {
+            rc = SQLITE_ABORT;
         }
+        PROFILE_COUNTER("SQL rows per query", row_count);
 
         sqlite3_finalize(stmt);
     }
@@ -633,9 +696,56 @@ int SqliteDatabase::Sqlite3Exec(sqlite3* db, const char* query,
     {
         callback_params->future->LinkDatabase(nullptr, nullptr);
     }
+    if(telemetry)
+    {
+        double duration_ms = std::chrono::duration<double, std::milli>(
+                                 std::chrono::steady_clock::now() - start_time)
+                                 .count();
+        if(rc != SQLITE_OK && error.empty())
+        {
+            error = sqlite3_errstr(rc);
+        }
+        std::string connection = ConnectionLabel(db);
+        std::string query_template = QueryTelemetry::MakeTemplate(query);
+        if(m_query_telemetry.Record(query_template, query, connection.c_str(), duration_ms,
+                                    row_count, byte_count,
+                                    rc != SQLITE_OK ? error.c_str() : nullptr))
+        {
+            m_query_telemetry.SetPlan(query_template, connection.c_str(),
+                                      ExplainQueryPlan(db, query));
+        }
+    }
     return rc;
 }
 
+std::string SqliteDatabase::ExplainQueryPlan(sqlite3* db, const char* query)
+{
+    std::string   plan;
+    std::string   explain = std::string("EXPLAIN QUERY PLAN ") + query;
+    sqlite3_stmt* stmt    = nullptr;
+    sqlite3_mutex_enter(sqlite3_db_mutex(db));
+    if(sqlite3_prepare_v2(db, explain.c_str(), -1, &stmt, nullptr) == SQLITE_OK)
+    {
+        // columns are id, parent, notused, detail; a step is nested under its parent
+        std::map<int, int> depth;
+        while(sqlite3_step(stmt) == SQLITE_ROW)
+        {
+            int         id     = sqlite3_column_int(stmt, 0);
+            int         parent = sqlite3_column_int(stmt, 1);
+            const char* detail = (const char*) sqlite3_column_text(stmt, 3);
+            auto        it     = depth.find(parent);
+            int         level  = it != depth.end() ? it->second + 1 : 0;
+            depth[id]          = level;
+            plan.append(level * 2, ' ');
+            plan += detail != nullptr ? detail : "";
+            plan += '\n';
+        }
+    }
+    sqlite3_finalize(stmt);
+    sqlite3_mutex_leave(sqlite3_db_mutex(db));
+    return plan;
+}
+
 void SqliteDatabase::ReplaceAllSubstrings(std::string& str, const std::string& from, const std::string& to)
 {
     if (from.empty())
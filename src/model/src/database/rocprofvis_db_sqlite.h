@@ -9,6 +9,7 @@
 #include <mutex>
 #include <condition_variable>
 #include "rocprofvis_db_query_builder.h"
+#include "rocprofvis_db_query_telemetry.h"
 
 namespace RocProfVis
 {
@@ -81,6 +82,8 @@ class SqliteDatabase : public Database
         void  InterruptQuery(void* connection) override;
         // check if table present in database
         bool CheckTableExists(const std::string& table_name, uint32_t db_node_id);
+        // per-query statistics and slow query log, collected only when enabled
+        QueryTelemetry* GetQueryTelemetry() override { return &m_query_telemetry; }
 
     protected:
         // ---------------------------------------SQL operations-----------------------------------------
@@ -245,7 +248,8 @@ class SqliteDatabase : public Database
             const char* query,
             rocprofvis_dm_handle_t handle,
             uint32_t query_index,
-            RpvSqliteExecuteQueryCallback callback);
+            RpvSqliteExecuteQueryCallback callback,
+            std::function<void(uint32_t)> on_query_done);
 
 
         // ------------------------------Wrappers around SQL getters-------------------------------------
@@ -286,6 +290,15 @@ class SqliteDatabase : public Database
         int Sqlite3Exec(sqlite3* db, const char* query,
                                         int (*callback)(void*, int, sqlite3_stmt*, char**),
                                         void* user_data);
+        // runs EXPLAIN QUERY PLAN on the connection
+        // @param db - database connection
+        // @param query - SQL query
+        // @return plan as indented text, one step per line
+        std::string ExplainQueryPlan(sqlite3* db, const char* query);
+        // query telemetry label of a connection, database file and connection number
+        // @param db - database connection
+        // @return label like "trace.db#2"
+        std::string ConnectionLabel(sqlite3* db);
         // Method to open sqlite database connection
         // @connection - pointer to connection
         // @return status of operation
@@ -301,6 +314,10 @@ class SqliteDatabase : public Database
     protected:
 
         std::vector<std::unique_ptr<rocprofvis_db_sqlite_db_node_t>> m_db_nodes;
+        QueryTelemetry m_query_telemetry;
+        // labels of all connections opened by OpenConnection, numbered in open order
+        std::mutex m_connection_labels_mutex;
+        std::map<sqlite3*, std::string> m_connection_labels;
        
 };
 
@@ -0,0 +1,449 @@
+// Copyright Advanced Micro Devices, Inc.
+// SPDX-License-Identifier: MIT
+
+#include "rocprofvis_db_table_export.h"
+#include "spdlog/spdlog.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <queue>
+
+namespace RocProfVis
+{
+namespace DataModel
+{
+
+    std::unique_ptr<ExportWriter> ExportWriter::Create(const char* file_path)
+    {
+        std::string path = file_path;
+        std::string extension = COLUMNAR_FILE_EXTENSION;
+        if (path.size() >= extension.size() &&
+            path.compare(path.size() - extension.size(), extension.size(), extension) == 0)
+        {
+            return std::make_unique<ColumnarExportWriter>();
+        }
+        return std::make_unique<CsvExportWriter>();
+    }
+
+    bool ExportWriter::OpenStream(const char* file_path, bool binary)
+    {
+        // Stream buffer must be installed before the file is opened
+        m_buffer.resize(WRITE_BUFFER_SIZE);
+        m_file.rdbuf()->pubsetbuf(m_buffer.data(), m_buffer.size());
+        m_file.open(file_path, binary ? std::ios::out | std::ios::binary : std::ios::out);
+        return m_file.is_open();
+    }
+
+    bool CsvExportWriter::Open(const char* file_path, const std::vector<ExportColumn>& columns)
+    {
+        if (!OpenStream(file_path, false))
+        {
+            return false;
+        }
+        m_line.clear();
+        for (size_t i = 0; i < columns.size(); i++)
+        {
+            if (i > 0)
+            {
+                m_line += ", ";
+            }
+            m_line += columns[i].name;
+        }
+        m_line += "\n";
+        m_file.write(m_line.data(), m_line.size());
+        return m_file.good();
+    }
+
+    bool CsvExportWriter::WriteRow(const ExportRow& row)
+    {
+        m_line.clear();
+        for (size_t i = 0; i < row.cells.size(); i++)
+        {
+            const ExportCell& cell = row.cells[i];
+            if (i > 0)
+            {
+                m_line += ", ";
+            }
+            switch (cell.type)
+            {
+            case ExportCellType::UInt64:
+                m_line += std::to_string(cell.value.data.u64);
+                break;
+            case ExportCellType::Double:
+                m_line += std::to_string(cell.value.data.d);
+                break;
+            case ExportCellType::String:
+                m_line += cell.text;
+                break;
+            case ExportCellType::QuotedString:
+                m_line += '"';
+                m_line += cell.text;
+                m_line += '"';
+                break;
+            default:
+                break;
+            }
+        }
+        m_line += "\n";
+        m_file.write(m_line.data(), m_line.size());
+        return m_file.good();
+    }
+
+    bool CsvExportWriter::Close()
+    {
+        m_file.close();
+        return !m_file.fail();
+    }
+
+    bool ColumnarExportWriter::Open(const char* file_path, const std::vector<ExportColumn>& columns)
+    {
+        if (!OpenStream(file_path, true))
+        {
+            return false;
+        }
+        m_file.write(MAGIC, strlen(MAGIC));
+        uint32_t column_count = static_cast<uint32_t>(columns.size());
+        m_file.write((const char*)&column_count, sizeof(column_count));
+        m_columns.clear();
+        for (const ExportColumn& column : columns)
+        {
+            uint32_t name_length = static_cast<uint32_t>(column.name.size());
+            uint8_t type = static_cast<uint8_t>(column.type == ExportCellType::QuotedString ? ExportCellType::String : column.type);
+            m_file.write((const char*)&name_length, sizeof(name_length));
+            m_file.write(column.name.data(), name_length);
+            m_file.write((const char*)&type, sizeof(type));
+            ColumnData column_data;
+            column_data.type = (ExportCellType)type;
+            column_data.offsets.push_back(0);
+            m_columns.push_back(std::move(column_data));
+        }
+        m_row_count = 0;
+        return m_file.good();
+    }
+
+    bool ColumnarExportWriter::WriteRow(const ExportRow& row)
+    {
+        static const ExportCell empty_cell;
+        for (size_t i = 0; i < m_columns.size(); i++)
+        {
+            ColumnData& column = m_columns[i];
+            const ExportCell& cell = i < row.cells.size() ? row.cells[i] : empty_cell;
+            if (column.type == ExportCellType::String)
+            {
+                switch (cell.type)
+                {
+                case ExportCellType::UInt64:
+                    column.chars += std::to_string(cell.value.data.u64);
+                    break;
+                case ExportCellType::Double:
+                    column.chars += std::to_string(cell.value.data.d);
+                    break;
+                case ExportCellType::String:
+                case ExportCellType::QuotedString:
+                    column.chars += cell.text;
+                    break;
+                default:
+                    break;
+                }
+                column.offsets.push_back(column.chars.size());
+            }
+            else
+            {
+                Numeric value = {};
+                if (column.type == ExportCellType::Double)
+                {
+                    value.data.d = cell.type == ExportCellType::Double ? cell.value.data.d :
+                        cell.type == ExportCellType::UInt64 ? static_cast<double>(cell.value.data.u64) :
+                        std::numeric_limits<double>::quiet_NaN();
+                }
+                else
+                {
+                    value.data.u64 = cell.type == ExportCellType::UInt64 ? cell.value.data.u64 :
+                        cell.type == ExportCellType::Double ? static_cast<uint64_t>(cell.value.data.d) :
+                        cell.type == ExportCellType::Empty ? 0 : std::strtoull(cell.text.c_str(), nullptr, 10);
+                }
+                column.values.push_back(value.data.u64);
+            }
+        }
+        if (++m_row_count == ROW_GROUP_SIZE)
+        {
+            return FlushRowGroup();
+        }
+        return true;
+    }
+
+    bool ColumnarExportWriter::FlushRowGroup()
+    {
+        if (m_row_count == 0)
+        {
+            return true;
+        }
+        m_file.write((const char*)&m_row_count, sizeof(m_row_count));
+        for (ColumnData& column : m_columns)
+        {
+            if (column.type == ExportCellType::String)
+            {
+                m_file.write((const char*)column.offsets.data(), column.offsets.size() * sizeof(uint64_t));
+                m_file.write(column.chars.data(), column.chars.size());
+                column.offsets.resize(1);
+                column.chars.clear();
+            }
+            else
+            {
+                m_file.write((const char*)column.values.data(), column.values.size() * sizeof(uint64_t));
+                column.values.clear();
+            }
+        }
+        m_row_count = 0;
+        return m_file.good();
+    }
+
+    bool ColumnarExportWriter::Close()
+    {
+        bool result = FlushRowGroup();
+        uint64_t terminator = 0;
+        m_file.write((const char*)&terminator, sizeof(terminator));
+        m_file.close();
+        return result && !m_file.fail();
+    }
+
+    ExportRunSorter::~ExportRunSorter()
+    {
+        for (const std::string& path : m_temp_files)
+        {
+            std::remove(path.c_str());
+        }
+    }
+
+    bool ExportRunSorter::Less(const Numeric& a, const Numeric& b) const
+    {
+        if (m_key_is_double)
+        {
+            return m_ascending ? a.data.d < b.data.d : b.data.d < a.data.d;
+        }
+        return m_ascending ? a.data.u64 < b.data.u64 : b.data.u64 < a.data.u64;
+    }
+
+    std::string ExportRunSorter::NewRunPath()
+    {
+        std::string path = m_temp_prefix + ".run" + std::to_string(m_run_counter++) + ".tmp";
+        m_temp_files.push_back(path);
+        return path;
+    }
+
+    bool ExportRunSorter::Add(ExportRow&& row)
+    {
+        size_t row_memory = sizeof(ExportRow) + row.cells.size() * sizeof(ExportCell);
+        for (const ExportCell& cell : row.cells)
+        {
+            row_memory += cell.text.capacity();
+        }
+        m_rows.push_back(std::move(row));
+        m_rows_memory += row_memory;
+        if (m_rows_memory >= m_run_memory_budget)
+        {
+            return SpillRun();
+        }
+        return true;
+    }
+
+    bool ExportRunSorter::WriteRow(std::ofstream& file, const ExportRow& row)
+    {
+        uint16_t cell_count = static_cast<uint16_t>(row.cells.size());
+        file.write((const char*)&row.sort_key, sizeof(row.sort_key));
+        file.write((const char*)&cell_count, sizeof(cell_count));
+        for (const ExportCell& cell : row.cells)
+        {
+            file.write((const char*)&cell.type, sizeof(cell.type));
+            if (cell.type == ExportCellType::UInt64 || cell.type == ExportCellType::Double)
+            {
+                file.write((const char*)&cell.value, sizeof(cell.value));
+            }
+            else if (cell.type != ExportCellType::Empty)
+            {
+                uint32_t length = static_cast<uint32_t>(cell.text.size());
+                file.write((const char*)&length, sizeof(length));
+                file.write(cell.text.data(), length);
+            }
+        }
+        return file.good();
+    }
+
+    bool ExportRunSorter::ReadRow(std::ifstream& file, ExportRow& row)
+    {
+        uint16_t cell_count = 0;
+        if (!file.read((char*)&row.sort_key, sizeof(row.sort_key)) ||
+            !file.read((char*)&cell_count, sizeof(cell_count)))
+        {
+            return false;
+        }
+        row.cells.resize(cell_count);
+        for (ExportCell& cell : row.cells)
+        {
+            file.read((char*)&cell.type, sizeof(cell.type));
+            if (cell.type == ExportCellType::UInt64 || cell.type == ExportCellType::Double)
+            {
+                file.read((char*)&cell.value, sizeof(cell.value));
+            }
+            else if (cell.type != ExportCellType::Empty)
+            {
+                uint32_t length = 0;
+                file.read((char*)&length, sizeof(length));
+                cell.text.resize(length);
+                file.read(cell.text.data(), length);
+            }
+        }
+        return file.good();
+    }
+
+    bool ExportRunSorter::SpillRun()
+    {
+        if (m_rows.empty())
+        {
+            return true;
+        }
+        std::stable_sort(m_rows.begin(), m_rows.end(),
+            [this](const ExportRow& a, const ExportRow& b) { return Less(a.sort_key, b.sort_key); });
+
+        std::string path = NewRunPath();
+        std::vector<char> buffer(ExportWriter::WRITE_BUFFER_SIZE);
+        std::ofstream file;
+        file.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+        file.open(path, std::ios::out | std::ios::binary);
+        bool result = file.is_open();
+        for (size_t i = 0; result && i < m_rows.size(); i++)
+        {
+            result = WriteRow(file, m_rows[i]);
+        }
+        file.close();
+        m_rows.clear();
+        m_rows.shrink_to_fit();
+        m_rows_memory = 0;
+        m_runs.push_back(path);
+        if (!result)
+        {
+            spdlog::error("Failed to write export sort run {}", path);
+        }
+        return result && !file.fail();
+    }
+
+    bool ExportRunSorter::MergeRuns(const std::vector<std::string>& runs, ExportWriter* writer, const std::string& output_run)
+    {
+        struct RunReader
+        {
+            std::vector<char> buffer;
+            std::ifstream file;
+            ExportRow row;
+        };
+        std::vector<std::unique_ptr<RunReader>> readers;
+        auto greater = [&](size_t a, size_t b) {
+            if (Less(readers[a]->row.sort_key, readers[b]->row.sort_key)) return false;
+            if (Less(readers[b]->row.sort_key, readers[a]->row.sort_key)) return true;
+            return a > b;
+        };
+        std::priority_queue<size_t, std::vector<size_t>, decltype(greater)> heap(greater);
+
+        readers.reserve(runs.size());
+        for (const std::string& path : runs)
+        {
+            std::unique_ptr<RunReader> reader = std::make_unique<RunReader>();
+            reader->buffer.resize(ExportWriter::WRITE_BUFFER_SIZE / MAX_MERGE_FAN_IN);
+            reader->file.rdbuf()->pubsetbuf(reader->buffer.data(), reader->buffer.size());
+            reader->file.open(path, std::ios::in | std::ios::binary);
+            if (!reader->file.is_open())
+            {
+                spdlog::error("Failed to open export sort run {}", path);
+                return false;
+            }
+            readers.push_back(std::move(reader));
+            if (ReadRow(readers.back()->file, readers.back()->row))
+            {
+                heap.push(readers.size() - 1);
+            }
+        }
+
+        std::vector<char> buffer;
+        std::ofstream output;
+        if (writer == nullptr)
+        {
+            buffer.resize(ExportWriter::WRITE_BUFFER_SIZE);
+            output.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+            output.open(output_run, std::ios::out | std::ios::binary);
+            if (!output.is_open())
+            {
+                return false;
+            }
+        }
+
+        bool result = true;
+        while (result && !heap.empty())
+        {
+            size_t index = heap.top();
+            heap.pop();
+            result = writer ? writer->WriteRow(readers[index]->row) : WriteRow(output, readers[index]->row);
+            if (ReadRow(readers[index]->file, readers[index]->row))
+            {
+                heap.push(index);
+            }
+        }
+
+        readers.clear();
+        for (const std::string& path : runs)
+        {
+            std::remove(path.c_str());
+        }
+        if (writer == nullptr)
+        {
+            output.close();
+            result = result && !output.fail();
+        }
+        return result;
+    }
+
+    bool ExportRunSorter::Finish(ExportWriter& writer)
+    {
+        if (m_runs.empty())
+        {
+            // Everything fits in memory, no need to go through run files
+            std::stable_sort(m_rows.begin(), m_rows.end(),
+                [this](const ExportRow& a, const ExportRow& b) { return Less(a.sort_key, b.sort_key); });
+            for (const ExportRow& row : m_rows)
+            {
+                if (!writer.WriteRow(row))
+                {
+                    return false;
+                }
+            }
+            m_rows.clear();
+            return true;
+        }
+
+        if (!SpillRun())
+        {
+            return false;
+        }
+
+        // Reduce number of runs until final merge fits in fan-in limit
+        while (m_runs.size() > MAX_MERGE_FAN_IN)
+        {
+            std::vector<std::string> merged_runs;
+            for (size_t i = 0; i < m_runs.size(); i += MAX_MERGE_FAN_IN)
+            {
+                std::vector<std::string> group(m_runs.begin() + i,
+                    m_runs.begin() + std::min(m_runs.size(), i + MAX_MERGE_FAN_IN));
+                std::string path = NewRunPath();
+                if (!MergeRuns(group, nullptr, path))
+                {
+                    return false;
+                }
+                merged_runs.push_back(path);
+            }
+            m_runs = std::move(merged_runs);
+        }
+        return MergeRuns(m_runs, &writer, "");
+    }
+
+}  // namespace DataModel
+}  // namespace RocProfVis
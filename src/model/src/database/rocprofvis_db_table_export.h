@@ -0,0 +1,156 @@
+// Copyright Advanced Micro Devices, Inc.
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "rocprofvis_db_packed_storage.h"
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace RocProfVis
+{
+namespace DataModel
+{
+    // Type of a single exported cell. For columnar output the column type is one of
+    // UInt64, Double or String
+    enum class ExportCellType : uint8_t
+    {
+        Empty,
+        UInt64,
+        Double,
+        String,
+        QuotedString
+    };
+
+    struct ExportCell
+    {
+        ExportCellType type = ExportCellType::Empty;
+        Numeric value = {};
+        std::string text;
+    };
+
+    struct ExportRow
+    {
+        Numeric sort_key = {};
+        std::vector<ExportCell> cells;
+    };
+
+    struct ExportColumn
+    {
+        std::string name;
+        ExportCellType type;
+    };
+
+    // Sink for exported rows. Output is written through a large stream buffer,
+    // rows are never accumulated beyond a single row group
+    class ExportWriter
+    {
+    public:
+        static constexpr size_t WRITE_BUFFER_SIZE = 4 << 20;
+        // Extension selecting the columnar binary format instead of CSV
+        static constexpr const char* COLUMNAR_FILE_EXTENSION = ".rpvc";
+
+        virtual ~ExportWriter() = default;
+        virtual bool Open(const char* file_path, const std::vector<ExportColumn>& columns) = 0;
+        virtual bool WriteRow(const ExportRow& row) = 0;
+        virtual bool Close() = 0;
+
+        // Creates CSV or columnar writer depending on file extension
+        static std::unique_ptr<ExportWriter> Create(const char* file_path);
+
+    protected:
+        bool OpenStream(const char* file_path, bool binary);
+
+        std::vector<char> m_buffer;
+        std::ofstream m_file;
+    };
+
+    class CsvExportWriter : public ExportWriter
+    {
+    public:
+        bool Open(const char* file_path, const std::vector<ExportColumn>& columns) override;
+        bool WriteRow(const ExportRow& row) override;
+        bool Close() override;
+
+    private:
+        std::string m_line;
+    };
+
+    // Columnar binary layout, all values little-endian:
+    //   char[8]  magic "RPVCOL01"
+    //   uint32   column count
+    //   per column: uint32 name length, name bytes, uint8 type (1 - uint64, 2 - double, 3 - utf8)
+    //   row groups until a row group with 0 rows:
+    //     uint64 row count
+    //     per column: uint64/double columns - row count values,
+    //                 utf8 columns - (row count + 1) uint64 offsets followed by string bytes
+    // Every column of a row group can be loaded with numpy.frombuffer without parsing
+    class ColumnarExportWriter : public ExportWriter
+    {
+    public:
+        static constexpr size_t ROW_GROUP_SIZE = 65536;
+        static constexpr const char* MAGIC = "RPVCOL01";
+
+        bool Open(const char* file_path, const std::vector<ExportColumn>& columns) override;
+        bool WriteRow(const ExportRow& row) override;
+        bool Close() override;
+
+    private:
+        struct ColumnData
+        {
+            ExportCellType type;
+            std::vector<uint64_t> values;
+            std::vector<uint64_t> offsets;
+            std::string chars;
+        };
+
+        bool FlushRowGroup();
+
+        std::vector<ColumnData> m_columns;
+        uint64_t m_row_count = 0;
+    };
+
+    // External merge sort for exported rows. Rows are kept in memory until the run
+    // budget is reached, then sorted and spilled to a temporary run file next to the
+    // output. Finish() merges all runs into the writer
+    class ExportRunSorter
+    {
+    public:
+        static constexpr size_t RUN_MEMORY_BUDGET = 256 << 20;
+        static constexpr size_t MAX_MERGE_FAN_IN = 64;
+
+        ExportRunSorter(const std::string& temp_prefix, bool key_is_double, bool ascending,
+            size_t run_memory_budget = RUN_MEMORY_BUDGET)
+        : m_temp_prefix(temp_prefix), m_key_is_double(key_is_double), m_ascending(ascending),
+          m_run_memory_budget(run_memory_budget) {};
+        ~ExportRunSorter();
+
+        bool Add(ExportRow&& row);
+        bool Finish(ExportWriter& writer);
+
+        // Binary row format of run files
+        static bool WriteRow(std::ofstream& file, const ExportRow& row);
+        static bool ReadRow(std::ifstream& file, ExportRow& row);
+
+    private:
+        bool Less(const Numeric& a, const Numeric& b) const;
+        bool SpillRun();
+        bool MergeRuns(const std::vector<std::string>& runs, ExportWriter* writer, const std::string& output_run);
+        std::string NewRunPath();
+
+        std::string m_temp_prefix;
+        bool m_key_is_double;
+        bool m_ascending;
+        size_t m_run_memory_budget;
+        std::vector<ExportRow> m_rows;
+        size_t m_rows_memory = 0;
+        std::vector<std::string> m_runs;
+        std::vector<std::string> m_temp_files;
+        uint32_t m_run_counter = 0;
+    };
+
+}  // namespace DataModel
+}  // namespace RocProfVis
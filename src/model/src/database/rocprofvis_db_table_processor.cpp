@@ -5,6 +5,7 @@
 #include "rocprofvis_db_expression_filter.h"
 #include "rocprofvis_db_profile.h"
 #include "rocprofvis_shared_types.h"
+#include <cfloat>
 #include <sstream>
 #include <unordered_set>
 #include <fstream>
@@ -251,13 +252,13 @@ namespace DataModel
                         if (op == kRocProfVisDmOperationDispatch || op == kRocProfVisDmOperationMemoryAllocate || op == kRocProfVisDmOperationMemoryCopy)
                         {
                             Numeric val = m_merged_table.GetMergeTableValue(op, row_index, column_index, m_db);
-                            result = m_db->BindObject()->FuncAddTableRowCell(row, std::to_string(val.data.u64).c_str());
+                            result = m_db->BindObject()->FuncAddTableRowCellUInt64(row, val.data.u64);
                             if (result != kRocProfVisDmResultSuccess)
                                 break;
                         }
                         else
                         {
-                            result = m_db->BindObject()->FuncAddTableRowCell(row, "-1");
+                            result = m_db->BindObject()->FuncAddTableRowCellInt64(row, -1);
                             if (result != kRocProfVisDmResultSuccess)
                                 break;
                         }
@@ -285,19 +286,18 @@ namespace DataModel
                 if (columns[column_index].m_schema_index[op] == Builder::SCHEMA_INDEX_COUNTER_VALUE)
                 {
                     Numeric val = m_merged_table.GetMergeTableValue(op, row_index, column_index, m_db);
-                    std::string output = std::to_string(val.data.d);
                     if (to_file)
                     {
                         if (column_counter > 0)
                         {
                             *file << ", ";
                         }
-                        *file << output;
+                        *file << std::to_string(val.data.d);
                         column_counter++;
                     }
                     else
                     {
-                        result = m_db->BindObject()->FuncAddTableRowCell(row, output.c_str());
+                        result = m_db->BindObject()->FuncAddTableRowCellDouble(row, val.data.d);
                         if (result != kRocProfVisDmResultSuccess)
                             break;
                     }
@@ -308,15 +308,6 @@ namespace DataModel
                     bool numeric_string = false;
                     const char* str = columns[column_index].m_type[op] == ColumnType::Null ? "" :
                         PackedTable::ConvertSqlStringReference(m_db, columns[column_index].m_schema_index[op], val.data.u64, db_instance->GuidIndex(), numeric_string);
-                    std::string output;
-                    if (str == nullptr)
-                    {
-                        output += std::to_string(val.data.u64);
-                    }
-                    else
-                    {
-                        output = str;
-                    }
                     if (to_file)
                     {
                         if (columns[column_index].m_schema_index[op] != Builder::SCHEMA_INDEX_TRACK_ID)
@@ -325,15 +316,24 @@ namespace DataModel
                             {
                                 *file << ", ";
                             }
-                            if (str != nullptr && !numeric_string)  *file << '"';
-                            *file << output;
-                            if (str != nullptr && !numeric_string)  *file << '"';
+                            if (str == nullptr)
+                            {
+                                *file << val.data.u64;
+                            }
+                            else
+                            {
+                                if (!numeric_string)  *file << '"';
+                                *file << str;
+                                if (!numeric_string)  *file << '"';
+                            }
                             column_counter++;
                         }
                     }
                     else
                     {
-                        result = m_db->BindObject()->FuncAddTableRowCell(row, output.c_str());
+                        // numeric cells stay binary in the table until read
+                        result = str == nullptr ? m_db->BindObject()->FuncAddTableRowCellUInt64(row, val.data.u64)
+                                                : m_db->BindObject()->FuncAddTableRowCell(row, str);
                         if (result != kRocProfVisDmResultSuccess)
                             break;
                     }
@@ -435,26 +435,38 @@ namespace DataModel
             if (it == r.second.result.end())
                 continue;
             auto data = it->second;
-            std::string cell;
-            if (data.type == NotNumeric)
-            {
-                cell = m_merged_table.GetAggregationStringByIndex(static_cast<uint32_t>(data.numeric.data.u64));
-            } else
-            if (data.type == NumericUInt64)
-            {
-                cell = std::to_string(data.numeric.data.u64);
-            }
-            else
-            {
-                cell = std::to_string(data.numeric.data.d);
-            }
             if (to_file)
             {
+                std::string cell;
+                if (data.type == NotNumeric)
+                {
+                    cell = m_merged_table.GetAggregationStringByIndex(static_cast<uint32_t>(data.numeric.data.u64));
+                } else
+                if (data.type == NumericUInt64)
+                {
+                    cell = std::to_string(data.numeric.data.u64);
+                }
+                else
+                {
+                    cell = std::to_string(data.numeric.data.d);
+                }
                 *file << ", " << cell;
             }
             else
             {
-                result = m_db->BindObject()->FuncAddTableRowCell(row, cell.c_str());
+                if (data.type == NotNumeric)
+                {
+                    result = m_db->BindObject()->FuncAddTableRowCell(row, 
+                        m_merged_table.GetAggregationStringByIndex(static_cast<uint32_t>(data.numeric.data.u64)).c_str());
+                } else
+                if (data.type == NumericUInt64)
+                {
+                    result = m_db->BindObject()->FuncAddTableRowCellUInt64(row, data.numeric.data.u64);
+                }
+                else
+                {
+                    result = m_db->BindObject()->FuncAddTableRowCellDouble(row, data.numeric.data.d);
+                }
                 if (result != kRocProfVisDmResultSuccess)
                     break;
             }
@@ -462,53 +474,58 @@ namespace DataModel
         return result;
     };
 
-    rocprofvis_dm_result_t TableProcessor::ProcessCompoundQuery(rocprofvis_dm_table_t table, std::vector<rocprofvis_db_compound_query_command>& commands, bool updated)
+    void TableProcessor::FillRowMap(PackedTable& table, int row_index, std::unordered_map<std::string, FilterExpression::Value>& map)
     {
-        auto GetRowMap = [&](int row_index, std::unordered_map<std::string, FilterExpression::Value> & map)
+        DbInstance * db_instance = table.GetDbInstanceForRow(m_db, row_index);
+        ROCPROFVIS_ASSERT_MSG_RETURN(db_instance != nullptr, ERROR_NODE_KEY_CANNOT_BE_NULL, );
+        if (row_index < table.RowCount())
+        {
+            const auto& columns = table.GetMergedColumns();
+            uint8_t op = table.GetOperationValue(row_index);
+            for (int column_index = 0; column_index < table.MergedColumnCount(); column_index++)
             {
-                DbInstance * db_instance = m_merged_table.GetDbInstanceForRow(m_db, row_index);
-                ROCPROFVIS_ASSERT_MSG_RETURN(db_instance != nullptr, ERROR_NODE_KEY_CANNOT_BE_NULL, );
-                if (row_index < m_merged_table.RowCount())
+                if (columns[column_index].m_schema_index[op] == Builder::SCHEMA_INDEX_NULL)
                 {
-                    auto columns = m_merged_table.GetMergedColumns();
-                    uint8_t op = m_merged_table.GetOperationValue(row_index);
-                    for (int column_index = 0; column_index < m_merged_table.MergedColumnCount(); column_index++)
+                    map[columns[column_index].m_name] = "";
+                }
+                else
+                    if (columns[column_index].m_schema_index[op] == Builder::SCHEMA_INDEX_COUNTER_VALUE)
                     {
-                        if (columns[column_index].m_schema_index[op] == Builder::SCHEMA_INDEX_NULL)
+                        Numeric val = table.GetMergeTableValue(op, row_index, column_index, m_db);
+                        map[columns[column_index].m_name] = val.data.d;
+                    }
+                    else
+                    {
+                        Numeric val = table.GetMergeTableValue(op, row_index, column_index, m_db);
+                        bool numeric_string = false;
+                        const char* str = columns[column_index].m_type[op] == ColumnType::Null ? "" :
+                            PackedTable::ConvertSqlStringReference(m_db, columns[column_index].m_schema_index[op], val.data.u64, db_instance->GuidIndex(), numeric_string);
+                        if (str != nullptr)
                         {
-                            map[columns[column_index].m_name] = "";
-                        }
-                        else
-                            if (columns[column_index].m_schema_index[op] == Builder::SCHEMA_INDEX_COUNTER_VALUE)
+                            if (numeric_string)
                             {
-                                Numeric val = m_merged_table.GetMergeTableValue(op, row_index, column_index, m_db);
-                                map[columns[column_index].m_name] = val.data.d;
+                                map[columns[column_index].m_name] = std::stod(str);
                             }
                             else
                             {
-                                Numeric val = m_merged_table.GetMergeTableValue(op, row_index, column_index, m_db);
-                                bool numeric_string = false;
-                                const char* str = columns[column_index].m_type[op] == ColumnType::Null ? "" :
-                                    PackedTable::ConvertSqlStringReference(m_db, columns[column_index].m_schema_index[op], val.data.u64, db_instance->GuidIndex(), numeric_string);
-                                if (str != nullptr)
-                                {
-                                    if (numeric_string)
-                                    {
-                                        map[columns[column_index].m_name] = std::stod(str);
-                                    }
-                                    else
-                                    {
-                                        map[columns[column_index].m_name] = str;
-                                    }
-                                }
-                                else
-                                {
-                                    map[columns[column_index].m_name] = (double)val.data.u64;
-                                }
-
+                                map[columns[column_index].m_name] = str;
                             }
+                        }
+                        else
+                        {
+                            map[columns[column_index].m_name] = (double)val.data.u64;
+                        }
+
                     }
-                }
+            }
+        }
+    }
+
+    rocprofvis_dm_result_t TableProcessor::ProcessCompoundQuery(rocprofvis_dm_table_t table, std::vector<rocprofvis_db_compound_query_command>& commands, bool updated)
+    {
+        auto GetRowMap = [&](int row_index, std::unordered_map<std::string, FilterExpression::Value> & map)
+            {
+                FillRowMap(m_merged_table, row_index, map);
             };
 
         auto AddNumRecordsColumn = [&](rocprofvis_dm_table_row_t row, int num_rows)
@@ -658,6 +675,9 @@ namespace DataModel
                     uint32_t thread_count = std::thread::hardware_concurrency() - 1;
                     if (use_threads < thread_count)
                         thread_count = use_threads;
+                    // a single core host leaves no worker, aggregate on one thread
+                    if (thread_count == 0)
+                        thread_count = 1;
 
                     std::vector<std::thread> threads;
                     uint32_t rows_per_task = thread_count == 0 ? 0u : static_cast<uint32_t>(m_merged_table.RowCount() / thread_count);
@@ -813,6 +833,47 @@ namespace DataModel
         return kRocProfVisDmResultSuccess;
     }
 
+    struct TableProcessor::ExportState
+    {
+        // Column layout of one sub-query, taken from its first row
+        struct SubQuerySchema
+        {
+            bool known = false;
+            uint8_t op = 0;
+            std::vector<ColumnDef> columns;
+            // Rows flushed before the output is open, with all columns of the sub-query's own layout
+            // so the filter can be evaluated once the merged layout is known
+            std::vector<MergedColumnDef> spill_layout;
+            std::vector<uint32_t> spill_columns;
+            int spill_sort_column = -1;
+            std::string spill_path;
+            std::ofstream spill_file;
+        };
+
+        // Guards all members below, sub-queries run and flush chunks in parallel
+        std::mutex lock;
+        std::vector<SubQuerySchema> schemas;
+        size_t pending_schemas = 0;
+        // Set once every sub-query reported its layout, rows are spilled until then
+        bool output_open = false;
+        rocprofvis_dm_result_t result = kRocProfVisDmResultSuccess;
+        std::string file_path;
+        std::string sort_column_name;
+        // Merged column indices written to the output
+        std::vector<uint32_t> columns;
+        std::unique_ptr<ExportWriter> writer;
+        std::unique_ptr<ExportRunSorter> sorter;
+        bool filtered = false;
+        FilterExpression filter;
+        int sort_column = -1;
+        bool sort_ascending = true;
+        // Sub-queries may return the same event more than once. Seen event ids per node and operation
+        std::unordered_map<uint32_t, std::vector<bool>> seen_events;
+        std::unordered_set<uint64_t> seen_sparse_events;
+
+        static constexpr uint64_t MAX_DENSE_EVENT_ID = 1ULL << 28;
+    };
+
     int TableProcessor::CallbackRunCompoundQuery(void* data, int argc, sqlite3_stmt* stmt, char** azColName) {
         ROCPROFVIS_ASSERT_MSG_RETURN(data, ERROR_SQL_QUERY_PARAMETERS_CANNOT_BE_NULL, 1);
         rocprofvis_db_sqlite_callback_parameters* callback_params = (rocprofvis_db_sqlite_callback_parameters*)data;
@@ -826,8 +887,9 @@ namespace DataModel
         }
 
         int column_index = 0;
+        bool first_row = callback_params->future->GetProcessedRowsCount() == 0;
 
-        if (callback_params->future->GetProcessedRowsCount() == 0)
+        if (first_row)
         {
             table_processor->m_tables[callback_params->track_id]->ResetTrackIdetifiers();
 
@@ -944,6 +1006,23 @@ namespace DataModel
 
         callback_params->future->CountThisRow();
 
+        if (table_processor->m_export != nullptr)
+        {
+            if (first_row)
+            {
+                std::lock_guard<std::mutex> lock(table_processor->m_export->lock);
+                if (kRocProfVisDmResultSuccess != table_processor->SetExportSchema(callback_params->track_id, table_processor->m_tables[callback_params->track_id].get()))
+                {
+                    return 1;
+                }
+            }
+            if (table_processor->m_tables[callback_params->track_id]->RowCount() >= EXPORT_CHUNK_ROWS &&
+                kRocProfVisDmResultSuccess != table_processor->FlushExportChunk(callback_params->track_id))
+            {
+                return 1;
+            }
+        }
+
         return 0;
     }
 
@@ -1004,5 +1083,494 @@ namespace DataModel
         }
     }
 
+    rocprofvis_dm_result_t TableProcessor::ExtractExportCells(PackedTable& table, size_t row_index, DbInstance* db_instance, const std::vector<uint32_t>& columns, std::vector<ExportCell>& cells)
+    {
+        ROCPROFVIS_ASSERT_MSG_RETURN(db_instance != nullptr, ERROR_NODE_KEY_CANNOT_BE_NULL, kRocProfVisDmResultUnknownError);
+        const auto& merged_columns = table.GetMergedColumns();
+        uint8_t op = table.GetOperationValue(row_index);
+        cells.resize(columns.size());
+        for (size_t i = 0; i < columns.size(); i++)
+        {
+            uint32_t column_index = columns[i];
+            const MergedColumnDef& column = merged_columns[column_index];
+            ExportCell& cell = cells[i];
+            if (column.m_schema_index[op] == Builder::SCHEMA_INDEX_NULL)
+            {
+                cell.type = ExportCellType::Empty;
+            }
+            else
+            if (column.m_schema_index[op] == Builder::SCHEMA_INDEX_COUNTER_VALUE)
+            {
+                cell.type = ExportCellType::Double;
+                cell.value = table.GetMergeTableValue(op, row_index, column_index, m_db);
+            }
+            else
+            {
+                Numeric val = table.GetMergeTableValue(op, row_index, column_index, m_db);
+                bool numeric_string = false;
+                const char* str = column.m_type[op] == ColumnType::Null ? "" :
+                    PackedTable::ConvertSqlStringReference(m_db, column.m_schema_index[op], val.data.u64, db_instance->GuidIndex(), numeric_string);
+                if (str == nullptr)
+                {
+                    cell.type = ExportCellType::UInt64;
+                    cell.value = val;
+                }
+                else
+                {
+                    cell.type = numeric_string ? ExportCellType::String : ExportCellType::QuotedString;
+                    cell.text = str;
+                }
+            }
+        }
+        return kRocProfVisDmResultSuccess;
+    }
+
+    Numeric TableProcessor::ExtractExportSortKey(PackedTable& table, size_t row_index, DbInstance* db_instance, int sort_column)
+    {
+        // Same keys as PackedTable::SortByColumn
+        const std::string& name = m_export->sort_column_name;
+        uint8_t op = table.GetOperationValue(row_index);
+        bool has_value = sort_column >= 0 && table.GetMergedColumns()[sort_column].m_type[op] != ColumnType::Null;
+        Numeric key = {};
+        if (name == Builder::COUNTER_VALUE_PUBLIC_NAME)
+        {
+            key.data.d = has_value ? table.GetMergeTableValue(op, row_index, sort_column, m_db).data.d :
+                (m_export->sort_ascending ? DBL_MAX : 0);
+        }
+        else if (name == Builder::CATEGORY_PUBLIC_NAME || name == Builder::NAME_PUBLIC_NAME)
+        {
+            if (has_value)
+            {
+                uint64_t value = table.GetMergeTableValue(op, row_index, sort_column, m_db).data.u64;
+                uint64_t string_index = 0;
+                if (kRocProfVisDmResultSuccess == m_db->RemapStringId(value, rocprofvis_db_string_type_t::kRPVStringTypeNameOrCategory, db_instance->GuidIndex(), string_index))
+                {
+                    value = m_db->BindObject()->FuncGetStringOrder(m_db->BindObject()->trace_object, static_cast<uint32_t>(string_index));
+                }
+                key.data.u64 = value;
+            }
+        }
+        else
+        {
+            key.data.u64 = has_value ? table.GetMergeTableValue(op, row_index, sort_column, m_db).data.u64 :
+                (m_export->sort_ascending ? UINT64_MAX : 0);
+        }
+        return key;
+    }
+
+    rocprofvis_dm_result_t TableProcessor::FlushExportChunk(uint32_t query_index)
+    {
+        std::lock_guard<std::mutex> lock(m_export->lock);
+        if (kRocProfVisDmResultSuccess != m_export->result)
+        {
+            return m_export->result;
+        }
+        PackedTable& table = *m_tables[query_index];
+        ExportState::SubQuerySchema& schema = m_export->schemas[query_index];
+        // Until the column layout of all sub-queries is known rows go to a temporary file of the sub-query
+        bool spill = !m_export->output_open;
+        rocprofvis_dm_result_t result = kRocProfVisDmResultSuccess;
+        if (spill && schema.spill_path.empty())
+        {
+            result = OpenExportSpill(query_index);
+            if (kRocProfVisDmResultSuccess != result)
+            {
+                m_export->result = result;
+                return result;
+            }
+        }
+        std::unordered_map<std::string, FilterExpression::Value> row_map;
+        table.SetMergedColumns(spill ? schema.spill_layout : m_merged_table.GetMergedColumns());
+        try {
+            for (size_t row_index = 0; row_index < table.RowCount(); row_index++)
+            {
+                uint8_t op = table.GetOperationValue(row_index);
+                if (op > 0)
+                {
+                    rocprofvis_dm_event_id_t id;
+                    id.value = table.GetEventIdValue(row_index);
+                    bool seen = false;
+                    if (id.bitfield.event_id < ExportState::MAX_DENSE_EVENT_ID)
+                    {
+                        std::vector<bool>& seen_events = m_export->seen_events[static_cast<uint32_t>(id.bitfield.event_node << 4 | id.bitfield.event_op)];
+                        if (id.bitfield.event_id >= seen_events.size())
+                        {
+                            seen_events.resize(std::max<size_t>(id.bitfield.event_id + 1, seen_events.size() * 2));
+                        }
+                        seen = seen_events[id.bitfield.event_id];
+                        seen_events[id.bitfield.event_id] = true;
+                    }
+                    else
+                    {
+                        seen = !m_export->seen_sparse_events.insert(id.value).second;
+                    }
+                    if (seen)
+                    {
+                        continue;
+                    }
+                }
+
+                if (m_export->filtered && !spill)
+                {
+                    FillRowMap(table, static_cast<int>(row_index), row_map);
+                    if (!m_export->filter.Evaluate(row_map))
+                    {
+                        continue;
+                    }
+                }
+
+                DbInstance* db_instance = table.GetDbInstanceForRow(m_db, static_cast<int>(row_index));
+                ExportRow row;
+                result = ExtractExportCells(table, row_index, db_instance, spill ? schema.spill_columns : m_export->columns, row.cells);
+                if (kRocProfVisDmResultSuccess != result)
+                {
+                    break;
+                }
+                if (spill)
+                {
+                    if (!m_export->sort_column_name.empty())
+                    {
+                        row.sort_key = ExtractExportSortKey(table, row_index, db_instance, schema.spill_sort_column);
+                    }
+                    if (!ExportRunSorter::WriteRow(schema.spill_file, row))
+                    {
+                        result = kRocProfVisDmResultDbAccessFailed;
+                        break;
+                    }
+                }
+                else if (m_export->sorter)
+                {
+                    row.sort_key = ExtractExportSortKey(table, row_index, db_instance, m_export->sort_column);
+                    if (!m_export->sorter->Add(std::move(row)))
+                    {
+                        result = kRocProfVisDmResultDbAccessFailed;
+                        break;
+                    }
+                }
+                else if (!m_export->writer->WriteRow(row))
+                {
+                    result = kRocProfVisDmResultDbAccessFailed;
+                    break;
+                }
+            }
+        }
+        catch (const std::exception& e) {
+            spdlog::error("Error: {} ", e.what());
+            result = kRocProfVisDmResultUnknownError;
+        }
+        table.ClearRows();
+        m_export->result = result;
+        return result;
+    }
+
+    rocprofvis_dm_result_t TableProcessor::OpenExportSpill(uint32_t query_index)
+    {
+        ExportState::SubQuerySchema& schema = m_export->schemas[query_index];
+        PackedTable layout;
+        for (const ColumnDef& column : schema.columns)
+        {
+            layout.AddMergedColumn(column.m_name, schema.op, column.m_type, column.m_offset, column.m_schema_index);
+        }
+        layout.SortMergedColumns();
+        schema.spill_layout = layout.GetMergedColumns();
+        for (uint32_t column_index = 0; column_index < schema.spill_layout.size(); column_index++)
+        {
+            schema.spill_columns.push_back(column_index);
+            if (schema.spill_layout[column_index].m_name == m_export->sort_column_name)
+            {
+                schema.spill_sort_column = static_cast<int>(column_index);
+            }
+        }
+        schema.spill_path = m_export->file_path + ".query" + std::to_string(query_index) + ".tmp";
+        schema.spill_file.open(schema.spill_path, std::ios::out | std::ios::binary);
+        if (!schema.spill_file.is_open())
+        {
+            spdlog::error("Failed to open export spill file {}", schema.spill_path);
+            return kRocProfVisDmResultDbAccessFailed;
+        }
+        return kRocProfVisDmResultSuccess;
+    }
+
+    rocprofvis_dm_result_t TableProcessor::ReplayExportSpills()
+    {
+        const std::vector<MergedColumnDef>& merged_columns = m_merged_table.GetMergedColumns();
+        std::unordered_map<std::string, FilterExpression::Value> row_map;
+        rocprofvis_dm_result_t result = kRocProfVisDmResultSuccess;
+        for (ExportState::SubQuerySchema& schema : m_export->schemas)
+        {
+            if (schema.spill_path.empty())
+            {
+                continue;
+            }
+            schema.spill_file.close();
+            if (schema.spill_file.fail())
+            {
+                result = kRocProfVisDmResultDbAccessFailed;
+            }
+            // Cell of every merged column in the spilled rows, -1 if the sub-query has no such column
+            std::vector<int> cell_index(merged_columns.size(), -1);
+            for (size_t column_index = 0; column_index < merged_columns.size(); column_index++)
+            {
+                auto column_it = std::find_if(schema.spill_layout.begin(), schema.spill_layout.end(),
+                    [&](const MergedColumnDef& cdef) { return cdef.m_name == merged_columns[column_index].m_name; });
+                if (column_it != schema.spill_layout.end())
+                {
+                    cell_index[column_index] = static_cast<int>(std::distance(schema.spill_layout.begin(), column_it));
+                }
+            }
+            std::ifstream file(schema.spill_path, std::ios::in | std::ios::binary);
+            ExportRow spilled;
+            try {
+                while (kRocProfVisDmResultSuccess == result && ExportRunSorter::ReadRow(file, spilled))
+                {
+                    if (m_export->filtered)
+                    {
+                        // Same values as FillRowMap produces for the merged table
+                        for (size_t column_index = 0; column_index < merged_columns.size(); column_index++)
+                        {
+                            FilterExpression::Value& value = row_map[merged_columns[column_index].m_name];
+                            const ExportCell* cell = cell_index[column_index] < 0 ? nullptr : &spilled.cells[cell_index[column_index]];
+                            if (cell == nullptr || cell->type == ExportCellType::Empty)
+                            {
+                                value = "";
+                            }
+                            else if (cell->type == ExportCellType::Double)
+                            {
+                                value = cell->value.data.d;
+                            }
+                            else if (cell->type == ExportCellType::UInt64)
+                            {
+                                value = (double)cell->value.data.u64;
+                            }
+                            else if (cell->type == ExportCellType::String)
+                            {
+                                value = std::stod(cell->text);
+                            }
+                            else
+                            {
+                                value = cell->text;
+                            }
+                        }
+                        if (!m_export->filter.Evaluate(row_map))
+                        {
+                            continue;
+                        }
+                    }
+                    ExportRow row;
+                    row.sort_key = spilled.sort_key;
+                    row.cells.resize(m_export->columns.size());
+                    for (size_t i = 0; i < m_export->columns.size(); i++)
+                    {
+                        int index = cell_index[m_export->columns[i]];
+                        if (index >= 0)
+                        {
+                            row.cells[i] = std::move(spilled.cells[index]);
+                        }
+                    }
+                    if (m_export->sorter ? !m_export->sorter->Add(std::move(row)) : !m_export->writer->WriteRow(row))
+                    {
+                        result = kRocProfVisDmResultDbAccessFailed;
+                    }
+                }
+            }
+            catch (const std::exception& e) {
+                spdlog::error("Error: {} ", e.what());
+                result = kRocProfVisDmResultUnknownError;
+            }
+            if (kRocProfVisDmResultSuccess == result && !file.eof())
+            {
+                result = kRocProfVisDmResultDbAccessFailed;
+            }
+            file.close();
+            std::remove(schema.spill_path.c_str());
+            schema.spill_path.clear();
+            schema.spill_layout.clear();
+            schema.spill_columns.clear();
+        }
+        return result;
+    }
+
+    rocprofvis_dm_result_t TableProcessor::SetExportSchema(uint32_t query_index, PackedTable* table)
+    {
+        ExportState::SubQuerySchema& schema = m_export->schemas[query_index];
+        if (schema.known)
+        {
+            return m_export->result;
+        }
+        schema.known = true;
+        if (table != nullptr)
+        {
+            schema.columns = table->GetColumns();
+            schema.op = table->GetOperationValue(0);
+        }
+        if (--m_export->pending_schemas == 0 && kRocProfVisDmResultSuccess == m_export->result)
+        {
+            m_export->result = OpenExportOutput();
+        }
+        return m_export->result;
+    }
+
+    rocprofvis_dm_result_t TableProcessor::OpenExportOutput()
+    {
+        // Same layout as ManageColumns builds from the first row of every sub-query
+        m_merged_table.Clear();
+        for (const ExportState::SubQuerySchema& schema : m_export->schemas)
+        {
+            for (const ColumnDef& column : schema.columns)
+            {
+                m_merged_table.AddMergedColumn(column.m_name, schema.op, column.m_type, column.m_offset, column.m_schema_index);
+            }
+        }
+        m_merged_table.SortMergedColumns();
+        const std::vector<MergedColumnDef>& merged_columns = m_merged_table.GetMergedColumns();
+
+        std::vector<ExportColumn> export_columns;
+        for (uint32_t column_index = 0; column_index < merged_columns.size(); column_index++)
+        {
+            const MergedColumnDef& column = merged_columns[column_index];
+            if (column.m_max_schema_index == Builder::SCHEMA_INDEX_TRACK_ID || column.m_max_schema_index == Builder::SCHEMA_INDEX_STREAM_TRACK_ID)
+            {
+                continue;
+            }
+            ExportCellType type = ExportCellType::UInt64;
+            for (uint8_t op = 0; op < kRocProfVisDmNumOperation; op++)
+            {
+                if ((column.m_op_mask & ((uint32_t)1 << op)) == 0)
+                {
+                    continue;
+                }
+                if (column.m_schema_index[op] == Builder::SCHEMA_INDEX_COUNTER_VALUE)
+                {
+                    type = ExportCellType::Double;
+                    break;
+                }
+                if (column.m_type[op] == ColumnType::Null || PackedTable::IsSqlStringReference(column.m_schema_index[op]))
+                {
+                    type = ExportCellType::String;
+                }
+            }
+            export_columns.push_back({ column.m_name, type });
+            m_export->columns.push_back(column_index);
+        }
+
+        if (!m_export->sort_column_name.empty())
+        {
+            auto column_it = std::find_if(merged_columns.begin(), merged_columns.end(), [&](const MergedColumnDef& cdef) { return cdef.m_name == m_export->sort_column_name; });
+            if (column_it != merged_columns.end())
+            {
+                m_export->sort_column = static_cast<int>(std::distance(merged_columns.begin(), column_it));
+            }
+        }
+
+        m_export->writer = ExportWriter::Create(m_export->file_path.c_str());
+        if (!m_export->writer->Open(m_export->file_path.c_str(), export_columns))
+        {
+            return kRocProfVisDmResultDbAccessFailed;
+        }
+        if (m_export->sort_column >= 0)
+        {
+            m_export->sorter = std::make_unique<ExportRunSorter>(m_export->file_path,
+                merged_columns[m_export->sort_column].m_name == Builder::COUNTER_VALUE_PUBLIC_NAME, m_export->sort_ascending);
+        }
+        m_export->output_open = true;
+        return ReplayExportSpills();
+    }
+
+    rocprofvis_dm_result_t TableProcessor::ExportStreamed(Future* future,
+        std::unordered_map<uint32_t, std::unordered_map<std::string, rocprofvis_db_compound_query_info>>& queries,
+        std::vector<rocprofvis_db_compound_query_command>& commands,
+        rocprofvis_dm_charptr_t file_path)
+    {
+        std::vector<std::pair<DbInstance*, std::string>> sub_queries;
+        m_tables.clear();
+        for (const std::pair<const uint32_t, std::unordered_map<std::string, rocprofvis_db_compound_query_info>>& track : queries)
+        {
+            for (const std::pair<const std::string, rocprofvis_db_compound_query_info>& compound_query : track.second)
+            {
+                sub_queries.push_back({ m_db->DbInstancePtrAt(compound_query.second.guid_id), compound_query.first });
+                m_tables.push_back(std::make_unique<PackedTable>());
+            }
+        }
+
+        ExportState state;
+        state.schemas.resize(sub_queries.size());
+        state.pending_schemas = sub_queries.size();
+        state.file_path = file_path;
+
+        auto it = std::find_if(commands.begin(), commands.end(), [](rocprofvis_db_compound_query_command& cmd) { return cmd.name == "FILTER"; });
+        if (it != commands.end())
+        {
+            std::string filter_str = Trim(it->parameter);
+            if (!filter_str.empty())
+            {
+                try {
+                    state.filter = FilterExpression::Parse(filter_str);
+                    state.filtered = true;
+                }
+                catch (std::runtime_error e)
+                {
+                    spdlog::error("Error: {} ", e.what());
+                }
+            }
+        }
+
+        it = std::find_if(commands.begin(), commands.end(), [](rocprofvis_db_compound_query_command& cmd) { return cmd.name == "SORT"; });
+        if (it != commands.end())
+        {
+            state.sort_column_name = ParseSortCommand(it->parameter, state.sort_ascending);
+        }
+
+        // All sub-queries run in parallel, each into its own table, and rows are flushed from the
+        // callback every EXPORT_CHUNK_ROWS. The output is opened once every sub-query returned its
+        // first row or finished empty, chunks flushed before that are spilled and replayed on open
+        m_export = &state;
+        rocprofvis_dm_result_t result = kRocProfVisDmResultSuccess;
+        if (sub_queries.empty())
+        {
+            result = OpenExportOutput();
+        }
+        else
+        {
+            result = m_db->ExecuteQueriesAsync(sub_queries, future, (rocprofvis_dm_handle_t)this, &CallbackRunCompoundQuery,
+                [this](uint32_t query_index) {
+                    std::lock_guard<std::mutex> lock(m_export->lock);
+                    SetExportSchema(query_index, nullptr);
+                });
+            if (kRocProfVisDmResultSuccess == result)
+            {
+                result = state.result;
+            }
+            if (kRocProfVisDmResultSuccess == result && !state.output_open)
+            {
+                result = kRocProfVisDmResultUnknownError;
+            }
+        }
+        for (uint32_t i = 0; kRocProfVisDmResultSuccess == result && i < m_tables.size(); i++)
+        {
+            result = FlushExportChunk(i);
+        }
+        m_export = nullptr;
+        for (ExportState::SubQuerySchema& schema : state.schemas)
+        {
+            if (!schema.spill_path.empty())
+            {
+                schema.spill_file.close();
+                std::remove(schema.spill_path.c_str());
+            }
+        }
+
+        if (kRocProfVisDmResultSuccess == result && state.sorter && !state.sorter->Finish(*state.writer))
+        {
+            result = kRocProfVisDmResultDbAccessFailed;
+        }
+        if (state.writer && !state.writer->Close() && kRocProfVisDmResultSuccess == result)
+        {
+            result = kRocProfVisDmResultDbAccessFailed;
+        }
+        m_tables.clear();
+        m_merged_table.Clear();
+        return result;
+    }
+
 }  // namespace DataModel
 }  // namespace RocProfVis
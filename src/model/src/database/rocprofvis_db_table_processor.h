@@ -4,6 +4,7 @@
 #pragma once
 
 #include "rocprofvis_db_sqlite.h"
+#include "rocprofvis_db_table_export.h"
 
 namespace RocProfVis
 {
@@ -139,6 +140,13 @@ namespace DataModel
         void SaveCurrentQuery(std::unordered_map<uint32_t, std::unordered_map<std::string, rocprofvis_db_compound_query_info>>& queries) { m_current_queries = queries; };
         bool IsCurrentQuery(std::unordered_map<uint32_t, std::unordered_map<std::string, rocprofvis_db_compound_query_info>>& queries);
         rocprofvis_dm_result_t ExportToCSV(rocprofvis_dm_charptr_t file_path);
+        // Exports compound query result without materializing merged table. Rows are processed
+        // in chunks while the query is running, sorting uses external merge of spilled runs.
+        // Chunks ready before every sub-query reported its layout are spilled to temporary files
+        rocprofvis_dm_result_t ExportStreamed(Future* future,
+            std::unordered_map<uint32_t, std::unordered_map<std::string, rocprofvis_db_compound_query_info>>& queries,
+            std::vector<rocprofvis_db_compound_query_command>& commands,
+            rocprofvis_dm_charptr_t file_path);
 
     private:
         rocprofvis_dm_result_t ProcessCompoundQuery(rocprofvis_dm_table_t table, std::vector<rocprofvis_db_compound_query_command>& commands, bool updated);
@@ -148,6 +156,21 @@ namespace DataModel
         rocprofvis_dm_result_t AddTableColumns(bool to_file, rocprofvis_dm_handle_t handle);
         rocprofvis_dm_result_t AddAggregatedColumns(bool to_file, rocprofvis_dm_handle_t handle);
         rocprofvis_dm_result_t AddAggregatedCells(bool to_file, rocprofvis_dm_handle_t handle, uint32_t row_index);
+        void FillRowMap(PackedTable& table, int row_index, std::unordered_map<std::string, FilterExpression::Value>& map);
+        rocprofvis_dm_result_t ExtractExportCells(PackedTable& table, size_t row_index, DbInstance* db_instance, const std::vector<uint32_t>& columns, std::vector<ExportCell>& cells);
+        // Sort column is -1 when the table has no column named as the sort column
+        Numeric ExtractExportSortKey(PackedTable& table, size_t row_index, DbInstance* db_instance, int sort_column);
+        rocprofvis_dm_result_t FlushExportChunk(uint32_t query_index);
+        // Opens the temporary file holding rows of a sub-query flushed before the output is open. Caller holds ExportState::lock
+        rocprofvis_dm_result_t OpenExportSpill(uint32_t query_index);
+        // Moves spilled rows to the output once it is open. Caller holds ExportState::lock
+        rocprofvis_dm_result_t ReplayExportSpills();
+        // Records the column layout of a sub-query, table is null when the sub-query returned no rows.
+        // Opens the output once the layout of every sub-query is known. Caller holds ExportState::lock
+        rocprofvis_dm_result_t SetExportSchema(uint32_t query_index, PackedTable* table);
+        rocprofvis_dm_result_t OpenExportOutput();
+
+        struct ExportState;
 
     private:
         QueryManager* m_db;
@@ -163,8 +186,11 @@ namespace DataModel
         std::mutex m_lock;
         // track id, query string, query info.
         std::unordered_map<uint32_t, std::unordered_map<std::string, rocprofvis_db_compound_query_info>> m_current_queries;
+        // Set only while ExportStreamed is running
+        ExportState* m_export = nullptr;
 
         static constexpr const char* QUERY_COMMAND_TAG = "-- CMD:";
+        static constexpr size_t EXPORT_CHUNK_ROWS = 65536;
     };
 
 
@@ -86,6 +86,14 @@ namespace DataModel
             kRocOptiqTableVersionMemoryCopyLevel, 
             db->GetHistogramQueryAndSchemaHash(),
         };
+        m_roc_optiq_table_properties[kRocOptiqTableKernelStats] = {
+            "roc_optiq_kernel_stats_",
+            kRocOptiqTablePerGuid,
+            kRocOptiqTableDisposeWhenTrimmed,
+            kRocOptiqTableDependentOnHistogram, 
+            kRocOptiqTableVersionKernelStats, 
+            db->GetKernelStatsQueryAndSchemaHash(),
+        };
     }
 
     RocpdMetadataVersionControl::RocpdMetadataVersionControl(RocpdDatabase* db) : MetadataVersionControl(db) {
@@ -220,12 +228,16 @@ namespace DataModel
                 {
                     TableCache* table = (TableCache*)metadata_table.GetTableHandle(s_metadata_cache_table_name);
                     uint32_t dependency_mask = 0;
+                    uint32_t id_column = table->FindColumn("id");
+                    uint32_t name_column = table->FindColumn("name");
+                    uint32_t hash_column = table->FindColumn("hash");
+                    uint32_t version_column = table->FindColumn("version");
                     for (int i = 0; i < table->NumRows(); i++)
                     {
-                        uint32_t id = std::atol(table->GetCellByIndex(i, "id"));
-                        std::string base_name = table->GetCellByIndex(i, "name");
-                        uint64_t hash = std::atoll(table->GetCellByIndex(i, "hash"));
-                        uint32_t version = std::atol(table->GetCellByIndex(i, "version"));
+                        uint32_t id = static_cast<uint32_t>(table->GetCellInt(i, id_column));
+                        std::string base_name = table->GetCell(i, name_column);
+                        uint64_t hash = table->GetCellInt(i, hash_column);
+                        uint32_t version = static_cast<uint32_t>(table->GetCellInt(i, version_column));
                         roc_optiq_metadata_t& data = m_roc_optiq_table_properties[id];
 
                         if (data.type == kRocOptiqTablePerGuid)
@@ -65,6 +65,7 @@ namespace DataModel
             kRocOptiqTableVersionMemoryCopyLevel = kRocOptiqTableVersionForLevelCalculation,
             kRocOptiqTableVersionHistogram = 0x0001,
             kRocOptiqTableVersionTrackInfo = 0x0003,
+            kRocOptiqTableVersionKernelStats = 0x0001,
         };
 
         struct roc_optiq_metadata_t
@@ -120,6 +121,7 @@ namespace DataModel
             kRocOptiqTableMemoryAllocLevel,
             kRocOptiqTableMemoryCopyLevel,
             kRocOptiqTableHistogram,
+            kRocOptiqTableKernelStats,
 
             kRocOptiqNumTables
         };
@@ -146,6 +148,7 @@ namespace DataModel
             kRocOptiqTableDependentOnMemoryCopyLevel | 
             kRocOptiqTableDependentOnTrackInfo,
             kRocOptiqTableDependentOnHistogram = 1 << kRocOptiqTableHistogram,
+            kRocOptiqTableDependentOnKernelStats = 1 << kRocOptiqTableKernelStats,
 
         };
         RocprofMetadataVersionControl(RocprofDatabase* db);
@@ -160,6 +163,8 @@ namespace DataModel
         const char* GetTrackInfoTableName() override { return GetTableName(kRocOptiqTableTrackInfo); };
         bool MustRebuildHistogram(uint32_t file_node_id) override { return MustRebuild(file_node_id, kRocOptiqTableHistogram); }
         bool MustRebuildTrackInfo(uint32_t file_node_id) override { return MustRebuild(file_node_id, kRocOptiqTableTrackInfo); }
+        const char* GetKernelStatsTableName() { return GetTableName(kRocOptiqTableKernelStats); };
+        bool MustRebuildKernelStats(uint32_t file_node_id) { return MustRebuild(file_node_id, kRocOptiqTableKernelStats); }
          
     };
     class RocpdMetadataVersionControl : public MetadataVersionControl
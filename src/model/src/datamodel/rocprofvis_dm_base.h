@@ -4,7 +4,9 @@
 #pragma once
 
 #include "rocprofvis_common_types.h"
+#include "rocprofvis_dm_lock_stats.h"
 #include "shared_mutex"
+#include <type_traits>
 
 #define LOCK_WAITED_TOO_LONG_WARNING_TIME_LIMIT_US 5000
 #define LOCK_HELD_TOO_LONG_WARNING_TIME_LIMIT_US 500000
@@ -68,72 +70,36 @@ template <typename LockType>
 class TimedLock
 {
 public:
-    using clock = std::chrono::high_resolution_clock;
+    using clock = LockStats::clock;
     TimedLock() = default;
+    // func_name must be __func__ of the caller, lock statistics key call sites by its address
     template <typename MutexType>
     TimedLock(MutexType& mtx, const char* func_name, DmBase* object)
-#if defined(LOCK_WAITED_TOO_LONG_WARNING_TIME_LIMIT_US) || defined(LOCK_HELD_TOO_LONG_WARNING_TIME_LIMIT_US)
-    : m_start(std::chrono::high_resolution_clock::now())
+    : m_start(clock::now())
     , m_func_name(func_name)
     , m_owner_object(object)
-#endif
+    , m_site(LockStats::INVALID_SITE)
     , m_lock(mtx)
     {
-#ifdef LOCK_WAITED_TOO_LONG_WARNING_TIME_LIMIT_US
-        uint64_t us =
-            std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - m_start)
-                .count();
-        if(us >= LOCK_WAITED_TOO_LONG_WARNING_TIME_LIMIT_US)
-        {
-            spdlog::debug("Lock waited {}us for {}, class {}", us, m_func_name, typeid(*m_owner_object).name());
-        }
-#endif
+        OnAcquired("Lock");
     }
 
     ~TimedLock() {
-#ifdef LOCK_HELD_TOO_LONG_WARNING_TIME_LIMIT_US
-        uint64_t us =
-            std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - m_start)
-                .count();
-        if(us >= LOCK_HELD_TOO_LONG_WARNING_TIME_LIMIT_US)
+        if(m_lock.owns_lock())
         {
-            spdlog::debug("Lock was held for {}us by {}, class {}", us,
-                          m_func_name, typeid(*m_owner_object).name());
+            OnReleased("Lock");
         }
-
-#endif
     }
 
     void lock()
     {
-#ifdef LOCK_WAITED_TOO_LONG_WARNING_TIME_LIMIT_US
         m_start = clock::now();
-#endif
         m_lock.lock();
-#ifdef LOCK_WAITED_TOO_LONG_WARNING_TIME_LIMIT_US
-        uint64_t us =
-            std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - m_start)
-                .count();
-        if(us >= LOCK_WAITED_TOO_LONG_WARNING_TIME_LIMIT_US)
-        {
-            spdlog::debug("Manual lock waited {}us for {}, class {}", us, m_func_name, typeid(*m_owner_object).name());
-        }
-
-#endif
+        OnAcquired("Manual lock");
     }
 
     void unlock() { 
-#ifdef LOCK_HELD_TOO_LONG_WARNING_TIME_LIMIT_US
-        uint64_t us =
-            std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - m_start)
-                .count();
-        if(us >= LOCK_HELD_TOO_LONG_WARNING_TIME_LIMIT_US)
-        {
-            spdlog::debug("Manual lock was held for {}us by {}, class {}", us, m_func_name,
-                          typeid(*m_owner_object).name());
-        }
-
-#endif
+        OnReleased("Manual lock");
         m_lock.unlock(); 
     }
 
@@ -145,12 +111,64 @@ public:
     TimedLock& operator=(TimedLock&&)      = default;
 
 private:
-#if defined(LOCK_WAITED_TOO_LONG_WARNING_TIME_LIMIT_US) || defined(LOCK_HELD_TOO_LONG_WARNING_TIME_LIMIT_US)
-    std::chrono::high_resolution_clock::time_point m_start;
-    const char*                                    m_func_name;
-    DmBase*                                        m_owner_object;
+    static constexpr bool IS_SHARED =
+        std::is_same<LockType, std::shared_lock<std::shared_mutex>>::value;
+
+    void OnAcquired(const char* kind)
+    {
+        m_acquired = clock::now();
+        uint64_t wait_ns =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(m_acquired - m_start).count();
+        if(LockStats::IsEnabled())
+        {
+            if(m_site == LockStats::INVALID_SITE)
+            {
+                m_site = LockStats::GetSite(
+                    m_func_name, m_owner_object ? &typeid(*m_owner_object) : nullptr,
+                    IS_SHARED);
+            }
+            if(m_site != LockStats::INVALID_SITE)
+            {
+                LockStats::RecordWait(m_site, wait_ns);
+            }
+        }
+#ifdef LOCK_WAITED_TOO_LONG_WARNING_TIME_LIMIT_US
+        if(wait_ns / 1000 >= LOCK_WAITED_TOO_LONG_WARNING_TIME_LIMIT_US)
+        {
+            spdlog::debug("{} waited {}us for {}, class {}", kind, wait_ns / 1000, m_func_name,
+                          m_owner_object ? typeid(*m_owner_object).name() : "");
+        }
+#else
+        (void) kind;
+#endif
+    }
+
+    void OnReleased(const char* kind)
+    {
+        uint64_t hold_ns =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - m_acquired)
+                .count();
+        if(m_site != LockStats::INVALID_SITE && LockStats::IsEnabled())
+        {
+            LockStats::RecordHold(m_site, hold_ns);
+        }
+#ifdef LOCK_HELD_TOO_LONG_WARNING_TIME_LIMIT_US
+        if(hold_ns / 1000 >= LOCK_HELD_TOO_LONG_WARNING_TIME_LIMIT_US)
+        {
+            spdlog::debug("{} was held for {}us by {}, class {}", kind, hold_ns / 1000,
+                          m_func_name, m_owner_object ? typeid(*m_owner_object).name() : "");
+        }
+#else
+        (void) kind;
 #endif
-    LockType m_lock;
+    }
+
+    clock::time_point m_start;
+    clock::time_point m_acquired;
+    const char*       m_func_name    = nullptr;
+    DmBase*           m_owner_object = nullptr;
+    uint32_t          m_site         = LockStats::INVALID_SITE;
+    LockType          m_lock;
 };
 
 
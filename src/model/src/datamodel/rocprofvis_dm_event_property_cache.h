@@ -0,0 +1,293 @@
+// Copyright Advanced Micro Devices, Inc.
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "rocprofvis_dm_base.h"
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace RocProfVis
+{
+namespace DataModel
+{
+
+// EventPropertyCache is an event id keyed container of event property objects (FlowTrace, StackTrace, ExtData).
+// Objects are kept in least recently used order and the oldest completed objects are evicted once the number
+// of objects or their memory footprint goes over the cache bounds. An object is filled by the database thread
+// which added it and can only be evicted after that thread completed it. Readers pin a completed object while
+// they use it outside of the cache lock, pinned objects are neither evicted nor deleted.
+// The container is protected by the event property mutex of the trace: lookups take it shared, changes take it unique.
+// Usage order has its own mutex, so lookups under shared lock can still move an object to the front.
+template <class T>
+class EventPropertyCache
+{
+    struct Entry
+    {
+        std::shared_ptr<T>              object;
+        uint64_t                        event_id;
+        std::thread::id                 loader;
+        bool                            complete;
+        rocprofvis_dm_size_t            bytes;
+        uint32_t                        pins;
+    };
+    typedef std::list<Entry>            entry_list_t;
+    typedef typename entry_list_t::iterator entry_iterator_t;
+
+    public:
+        // vector array of objects removed from cache, to be released outside of the cache lock
+        typedef std::vector<std::shared_ptr<T>> released_list_t;
+
+        EventPropertyCache(rocprofvis_dm_size_t max_items, rocprofvis_dm_size_t max_bytes)
+        : m_max_items(max_items), m_max_bytes(max_bytes), m_bytes(0) {}
+
+        // Returns number of cached objects
+        rocprofvis_dm_size_t        Size() const { return m_entries.size(); }
+        // Returns maximum number of cached objects
+        rocprofvis_dm_size_t        MaxItems() const { return m_max_items; }
+
+        // Method to find object by event id
+        // @param event_id - 60-bit event id and 4-bit operation type
+        // @return pointer to object, nullptr if not cached
+        T*                          Find(uint64_t event_id) const
+        {
+            auto it = m_index.find(event_id);
+            return it != m_index.end() ? it->second->object.get() : nullptr;
+        }
+        // Method to find object by event id and make it most recently used
+        // @param event_id - 60-bit event id and 4-bit operation type
+        // @return pointer to object, nullptr if not cached
+        T*                          Touch(uint64_t event_id)
+        {
+            auto it = m_index.find(event_id);
+            if(it == m_index.end())
+            {
+                return nullptr;
+            }
+            std::unique_lock<std::mutex> lock(m_usage_lock);
+            m_entries.splice(m_entries.begin(), m_entries, it->second);
+            return it->second->object.get();
+        }
+        // Method to find completed object by event id, make it most recently used and pin it.
+        // Pinned object must be released with Unpin
+        // @param event_id - 60-bit event id and 4-bit operation type
+        // @return pointer to object, nullptr if not cached or still loading
+        T*                          Pin(uint64_t event_id)
+        {
+            auto it = m_index.find(event_id);
+            if(it == m_index.end() || !it->second->complete)
+            {
+                return nullptr;
+            }
+            std::unique_lock<std::mutex> lock(m_usage_lock);
+            m_entries.splice(m_entries.begin(), m_entries, it->second);
+            it->second->pins++;
+            return it->second->object.get();
+        }
+        // Method to release object pinned by Pin. Object is looked up starting from most recently used,
+        // which is usually the one pinned by caller
+        // @param object - object handle
+        // @return true if pinned object has been found
+        bool                        Unpin(const void* object)
+        {
+            std::unique_lock<std::mutex> lock(m_usage_lock);
+            for(Entry& entry : m_entries)
+            {
+                if(entry.object.get() == object && entry.pins > 0)
+                {
+                    entry.pins--;
+                    return true;
+                }
+            }
+            return false;
+        }
+        // Method to check loading state of object
+        // @param event_id - 60-bit event id and 4-bit operation type
+        // @return kRocProfVisDmResultSuccess if loaded, kRocProfVisDmResultResourceBusy if still loading, kRocProfVisDmResultNotLoaded if not cached
+        rocprofvis_dm_result_t      State(uint64_t event_id) const
+        {
+            auto it = m_index.find(event_id);
+            if(it == m_index.end())
+            {
+                return kRocProfVisDmResultNotLoaded;
+            }
+            return it->second->complete ? kRocProfVisDmResultSuccess : kRocProfVisDmResultResourceBusy;
+        }
+        // Method to add object loaded by calling thread. Object previously cached for the same event id
+        // stays in usage list until evicted or deleted, as it may still be in use
+        // @param event_id - 60-bit event id and 4-bit operation type
+        // @param object - new object
+        // @return pointer to added object
+        T*                          Add(uint64_t event_id, std::shared_ptr<T> object)
+        {
+            std::unique_lock<std::mutex> lock(m_usage_lock);
+            m_entries.push_front(Entry{ std::move(object), event_id, std::this_thread::get_id(), false, 0, 0 });
+            m_index[event_id] = m_entries.begin();
+            return m_entries.front().object.get();
+        }
+        // Method to complete object loaded by calling thread. Successfully loaded object is accounted and
+        // may cause eviction of least recently used objects, failed object is removed
+        // @param event_id - 60-bit event id and 4-bit operation type
+        // @param success - loading status
+        // @param released - reference to array receiving removed objects
+        // @return kRocProfVisDmResultSuccess if object loaded by calling thread has been found
+        rocprofvis_dm_result_t      Complete(uint64_t event_id, bool success, released_list_t& released)
+        {
+            entry_iterator_t entry = FindLoading(event_id);
+            if(entry == m_entries.end())
+            {
+                return kRocProfVisDmResultNotLoaded;
+            }
+            if(!success)
+            {
+                Erase(entry, released);
+                return kRocProfVisDmResultSuccess;
+            }
+            T* object = entry->object.get();
+            {
+                TimedLock<std::shared_lock<std::shared_mutex>> lock(*object->Mutex(), __func__, object);
+                entry->bytes = object->GetMemoryFootprint();
+            }
+            entry->complete = true;
+            m_bytes += entry->bytes;
+            Evict(entry, released);
+            return kRocProfVisDmResultSuccess;
+        }
+        // Method to remove object by event id
+        // @param event_id - 60-bit event id and 4-bit operation type
+        // @param released - reference to array receiving removed object
+        // @return kRocProfVisDmResultSuccess if removed, kRocProfVisDmResultResourceBusy if pinned, kRocProfVisDmResultNotLoaded if not cached
+        rocprofvis_dm_result_t      Remove(uint64_t event_id, released_list_t& released)
+        {
+            auto it = m_index.find(event_id);
+            if(it == m_index.end())
+            {
+                return kRocProfVisDmResultNotLoaded;
+            }
+            if(it->second->pins > 0)
+            {
+                return kRocProfVisDmResultResourceBusy;
+            }
+            Erase(it->second, released);
+            return kRocProfVisDmResultSuccess;
+        }
+        // Method to remove object by handle. Handle may be stale, so it is only compared, starting
+        // from most recently used object, which is usually the one just read by caller
+        // @param object - object handle
+        // @param released - reference to array receiving removed object
+        // @return kRocProfVisDmResultSuccess if removed, kRocProfVisDmResultResourceBusy if pinned, kRocProfVisDmResultNotLoaded if not cached
+        rocprofvis_dm_result_t      Remove(const void* object, released_list_t& released)
+        {
+            for(entry_iterator_t entry = m_entries.begin(); entry != m_entries.end(); ++entry)
+            {
+                if(entry->object.get() == object)
+                {
+                    if(entry->pins > 0)
+                    {
+                        return kRocProfVisDmResultResourceBusy;
+                    }
+                    Erase(entry, released);
+                    return kRocProfVisDmResultSuccess;
+                }
+            }
+            return kRocProfVisDmResultNotLoaded;
+        }
+        // Method to remove all objects, except pinned ones
+        // @param released - reference to array receiving removed objects
+        void                        Clear(released_list_t& released)
+        {
+            released.reserve(released.size() + m_entries.size());
+            for(entry_iterator_t entry = m_entries.begin(); entry != m_entries.end();)
+            {
+                entry_iterator_t removed = entry++;
+                if(removed->pins == 0)
+                {
+                    Erase(removed, released);
+                }
+            }
+        }
+        // Method to get amount of memory used by completed objects and cache structures.
+        // Objects are not read, as their footprint is accounted when completed
+        // @return used memory size
+        rocprofvis_dm_size_t        GetMemoryFootprint() const
+        {
+            std::unique_lock<std::mutex> lock(m_usage_lock);
+            return m_entries.size() * (sizeof(Entry) + 2 * sizeof(void*)) +
+                   m_index.size() * (sizeof(typename index_map_t::value_type) + sizeof(void*)) +
+                   m_index.bucket_count() * sizeof(void*) + m_bytes;
+        }
+
+    private:
+        typedef std::unordered_map<uint64_t, entry_iterator_t> index_map_t;
+
+        entry_iterator_t            FindLoading(uint64_t event_id)
+        {
+            auto it = m_index.find(event_id);
+            if(it != m_index.end() && !it->second->complete && it->second->loader == std::this_thread::get_id())
+            {
+                return it->second;
+            }
+            // another thread added newer object for the same event id
+            std::thread::id loader = std::this_thread::get_id();
+            for(entry_iterator_t entry = m_entries.begin(); entry != m_entries.end(); ++entry)
+            {
+                if(entry->event_id == event_id && !entry->complete && entry->loader == loader)
+                {
+                    return entry;
+                }
+            }
+            return m_entries.end();
+        }
+
+        void                        Erase(entry_iterator_t entry, released_list_t& released)
+        {
+            std::unique_lock<std::mutex> lock(m_usage_lock);
+            auto it = m_index.find(entry->event_id);
+            if(it != m_index.end() && it->second == entry)
+            {
+                m_index.erase(it);
+            }
+            if(entry->complete)
+            {
+                m_bytes -= entry->bytes;
+            }
+            released.push_back(std::move(entry->object));
+            m_entries.erase(entry);
+        }
+
+        void                        Evict(entry_iterator_t keep, released_list_t& released)
+        {
+            entry_iterator_t entry = m_entries.end();
+            while((m_entries.size() > m_max_items || m_bytes > m_max_bytes) && entry != m_entries.begin())
+            {
+                --entry;
+                // objects still being loaded are in use by database thread, pinned objects are in use by reader
+                if(entry == keep || !entry->complete || entry->pins > 0)
+                {
+                    continue;
+                }
+                entry_iterator_t evicted = entry++;
+                Erase(evicted, released);
+            }
+        }
+
+        // maximum number of cached objects
+        rocprofvis_dm_size_t        m_max_items;
+        // maximum memory footprint of completed objects
+        rocprofvis_dm_size_t        m_max_bytes;
+        // memory footprint of completed objects
+        rocprofvis_dm_size_t        m_bytes;
+        // list of objects, most recently used first
+        entry_list_t                m_entries;
+        // map of event id to most recently added object for the event
+        index_map_t                 m_index;
+        // usage order mutex
+        mutable std::mutex          m_usage_lock;
+};
+
+}  // namespace DataModel
+}  // namespace RocProfVis
@@ -0,0 +1,326 @@
+// Copyright Advanced Micro Devices, Inc.
+// SPDX-License-Identifier: MIT
+
+#include "rocprofvis_dm_lock_stats.h"
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#if defined(__GNUC__)
+#include <cxxabi.h>
+#include <cstdlib>
+#endif
+
+namespace RocProfVis
+{
+namespace DataModel
+{
+
+// a wait this long means another thread held the lock
+constexpr uint64_t LOCK_CONTENDED_WAIT_NS = 1000;
+
+enum LockSiteState : uint32_t
+{
+    kLockSiteEmpty,
+    kLockSiteClaimed,
+    kLockSiteReady
+};
+
+static std::string DemangleClassName(const std::type_info* type)
+{
+    if(type == nullptr)
+    {
+        return "";
+    }
+#if defined(__GNUC__)
+    int   status    = 0;
+    char* demangled = abi::__cxa_demangle(type->name(), nullptr, nullptr, &status);
+    if(status == 0 && demangled != nullptr)
+    {
+        std::string name = demangled;
+        free(demangled);
+        return name;
+    }
+#endif
+    return type->name();
+}
+
+std::atomic<bool>     LockStats::s_enabled(false);
+std::atomic<uint64_t> LockStats::s_dropped(0);
+std::atomic<uint64_t> LockStats::s_generation(0);
+LockStats::Site       LockStats::s_sites[LockStats::MAX_SITES];
+
+// Counters of one thread. Sites are allocated on first use and zeroed lazily by the
+// owning thread when it notices a Reset, counters of an older generation are ignored.
+class LockStats::ThreadCounters
+{
+public:
+    ThreadCounters();
+    ~ThreadCounters();
+
+    std::atomic<uint64_t>                         m_generation;
+    std::array<std::atomic<Counters*>, MAX_SITES> m_sites;
+};
+
+// Live threads and the counters of threads which exited since the last Reset.
+// Never destroyed, threads may exit after static destructors ran.
+struct LockStatsRegistry
+{
+    std::mutex                                   mutex;
+    std::vector<LockStats::ThreadCounters*>      threads;
+    std::vector<LockStats::SiteStats>            retired;
+};
+
+static LockStatsRegistry& Registry()
+{
+    static LockStatsRegistry* registry = new LockStatsRegistry();
+    return *registry;
+}
+
+// counters are written by their owning thread only, a plain read-modify-write is enough
+static inline void AddCounter(std::atomic<uint64_t>& counter, uint64_t value)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+static inline void MaxCounter(std::atomic<uint64_t>& counter, uint64_t value)
+{
+    if(value > counter.load(std::memory_order_relaxed))
+    {
+        counter.store(value, std::memory_order_relaxed);
+    }
+}
+
+LockStats::ThreadCounters::ThreadCounters()
+: m_generation(0)
+{
+    for(std::atomic<Counters*>& site : m_sites)
+    {
+        site.store(nullptr, std::memory_order_relaxed);
+    }
+    LockStatsRegistry&          registry = Registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    m_generation.store(s_generation.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    registry.threads.push_back(this);
+}
+
+LockStats::ThreadCounters::~ThreadCounters()
+{
+    LockStats::Retire(this);
+    for(std::atomic<Counters*>& site : m_sites)
+    {
+        delete site.load(std::memory_order_relaxed);
+    }
+}
+
+uint32_t LockStats::Bucket(uint64_t ns)
+{
+    uint32_t bucket = 0;
+    while(ns > 1 && bucket < NUM_BUCKETS - 1)
+    {
+        ns >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+uint32_t LockStats::GetSite(const char* func_name, const std::type_info* owner_type, bool shared)
+{
+    size_t hash = std::hash<const void*>()(func_name) ^
+                  (std::hash<const void*>()(owner_type) * 31) ^ (shared ? 0x9e3779b9 : 0);
+    for(uint32_t probe = 0; probe < MAX_SITES; probe++)
+    {
+        uint32_t index = (hash + probe) % MAX_SITES;
+        Site&    site  = s_sites[index];
+        uint32_t state = site.state.load(std::memory_order_acquire);
+        if(state == kLockSiteEmpty)
+        {
+            uint32_t expected = kLockSiteEmpty;
+            if(site.state.compare_exchange_strong(expected, kLockSiteClaimed,
+                                                  std::memory_order_acq_rel))
+            {
+                site.func_name  = func_name;
+                site.owner_type = owner_type;
+                site.shared     = shared;
+                site.state.store(kLockSiteReady, std::memory_order_release);
+                return index;
+            }
+            state = expected;
+        }
+        // another thread is filling this slot in, it may be the same site
+        while(state == kLockSiteClaimed)
+        {
+            state = site.state.load(std::memory_order_acquire);
+        }
+        if(site.func_name == func_name && site.owner_type == owner_type &&
+           site.shared == shared)
+        {
+            return index;
+        }
+    }
+    s_dropped.fetch_add(1, std::memory_order_relaxed);
+    return INVALID_SITE;
+}
+
+LockStats::ThreadCounters& LockStats::LocalCounters()
+{
+    static thread_local ThreadCounters counters;
+    return counters;
+}
+
+LockStats::Counters& LockStats::LocalSite(uint32_t site)
+{
+    ThreadCounters& thread     = LocalCounters();
+    uint64_t        generation = s_generation.load(std::memory_order_acquire);
+    if(thread.m_generation.load(std::memory_order_relaxed) != generation)
+    {
+        for(std::atomic<Counters*>& entry : thread.m_sites)
+        {
+            Counters* counters = entry.load(std::memory_order_relaxed);
+            if(counters)
+            {
+                counters->count.store(0, std::memory_order_relaxed);
+                counters->contended.store(0, std::memory_order_relaxed);
+                counters->total_wait_ns.store(0, std::memory_order_relaxed);
+                counters->max_wait_ns.store(0, std::memory_order_relaxed);
+                counters->total_hold_ns.store(0, std::memory_order_relaxed);
+                counters->max_hold_ns.store(0, std::memory_order_relaxed);
+                for(uint32_t i = 0; i < NUM_BUCKETS; i++)
+                {
+                    counters->wait_histogram[i].store(0, std::memory_order_relaxed);
+                    counters->hold_histogram[i].store(0, std::memory_order_relaxed);
+                }
+            }
+        }
+        thread.m_generation.store(generation, std::memory_order_release);
+    }
+    Counters* counters = thread.m_sites[site].load(std::memory_order_relaxed);
+    if(counters == nullptr)
+    {
+        counters = new Counters();
+        thread.m_sites[site].store(counters, std::memory_order_release);
+    }
+    return *counters;
+}
+
+void LockStats::RecordWait(uint32_t site, uint64_t wait_ns)
+{
+    Counters& counters = LocalSite(site);
+    AddCounter(counters.count, 1);
+    if(wait_ns >= LOCK_CONTENDED_WAIT_NS)
+    {
+        AddCounter(counters.contended, 1);
+    }
+    AddCounter(counters.total_wait_ns, wait_ns);
+    MaxCounter(counters.max_wait_ns, wait_ns);
+    AddCounter(counters.wait_histogram[Bucket(wait_ns)], 1);
+}
+
+void LockStats::RecordHold(uint32_t site, uint64_t hold_ns)
+{
+    Counters& counters = LocalSite(site);
+    AddCounter(counters.total_hold_ns, hold_ns);
+    MaxCounter(counters.max_hold_ns, hold_ns);
+    AddCounter(counters.hold_histogram[Bucket(hold_ns)], 1);
+}
+
+void LockStats::Accumulate(SiteStats& stats, Counters const& counters)
+{
+    stats.count += counters.count.load(std::memory_order_relaxed);
+    stats.contended += counters.contended.load(std::memory_order_relaxed);
+    stats.total_wait_ns += counters.total_wait_ns.load(std::memory_order_relaxed);
+    stats.max_wait_ns =
+        std::max(stats.max_wait_ns, counters.max_wait_ns.load(std::memory_order_relaxed));
+    stats.total_hold_ns += counters.total_hold_ns.load(std::memory_order_relaxed);
+    stats.max_hold_ns =
+        std::max(stats.max_hold_ns, counters.max_hold_ns.load(std::memory_order_relaxed));
+    for(uint32_t i = 0; i < NUM_BUCKETS; i++)
+    {
+        stats.wait_histogram[i] += counters.wait_histogram[i].load(std::memory_order_relaxed);
+        stats.hold_histogram[i] += counters.hold_histogram[i].load(std::memory_order_relaxed);
+    }
+}
+
+void LockStats::Retire(ThreadCounters* thread)
+{
+    LockStatsRegistry&          registry = Registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.threads.erase(
+        std::remove(registry.threads.begin(), registry.threads.end(), thread),
+        registry.threads.end());
+    if(thread->m_generation.load(std::memory_order_acquire) !=
+       s_generation.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+    registry.retired.resize(MAX_SITES, SiteStats());
+    for(uint32_t site = 0; site < MAX_SITES; site++)
+    {
+        Counters* counters = thread->m_sites[site].load(std::memory_order_relaxed);
+        if(counters)
+        {
+            Accumulate(registry.retired[site], *counters);
+        }
+    }
+}
+
+std::vector<LockStats::SiteStats> LockStats::Snapshot()
+{
+    std::vector<SiteStats> totals(MAX_SITES, SiteStats());
+    {
+        LockStatsRegistry&          registry = Registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        uint64_t generation = s_generation.load(std::memory_order_relaxed);
+        if(!registry.retired.empty())
+        {
+            totals = registry.retired;
+        }
+        for(ThreadCounters* thread : registry.threads)
+        {
+            // a thread which has not seen the last Reset still holds old counters
+            if(thread->m_generation.load(std::memory_order_acquire) != generation)
+            {
+                continue;
+            }
+            for(uint32_t site = 0; site < MAX_SITES; site++)
+            {
+                Counters* counters = thread->m_sites[site].load(std::memory_order_acquire);
+                if(counters)
+                {
+                    Accumulate(totals[site], *counters);
+                }
+            }
+        }
+    }
+    std::vector<SiteStats> stats;
+    for(uint32_t index = 0; index < MAX_SITES; index++)
+    {
+        Site& site = s_sites[index];
+        if(site.state.load(std::memory_order_acquire) != kLockSiteReady ||
+           totals[index].count == 0)
+        {
+            continue;
+        }
+        SiteStats& entry  = totals[index];
+        entry.function    = site.func_name ? site.func_name : "";
+        entry.owner_class = DemangleClassName(site.owner_type);
+        entry.shared      = site.shared;
+        stats.push_back(std::move(entry));
+    }
+    std::sort(stats.begin(), stats.end(), [](SiteStats const& a, SiteStats const& b) {
+        return a.total_wait_ns > b.total_wait_ns;
+    });
+    return stats;
+}
+
+void LockStats::Reset()
+{
+    // sites stay registered, every thread zeroes its own counters on its next record
+    LockStatsRegistry&          registry = Registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    s_generation.fetch_add(1, std::memory_order_release);
+    registry.retired.clear();
+    s_dropped.store(0, std::memory_order_relaxed);
+}
+
+}  // namespace DataModel
+}  // namespace RocProfVis
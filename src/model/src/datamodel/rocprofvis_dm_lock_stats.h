@@ -0,0 +1,110 @@
+// Copyright Advanced Micro Devices, Inc.
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "rocprofvis_common_types.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+namespace RocProfVis
+{
+namespace DataModel
+{
+
+// Process wide wait and hold time statistics of TimedLock, one entry per call site.
+// A call site is the __func__ pointer of the locking function, the class of the object
+// owning the mutex and the lock mode. Recording is off by default. When enabled, every
+// thread accumulates into its own counters, which only that thread writes, so recording
+// never touches a cache line shared with another thread. Snapshot sums the threads.
+class LockStats
+{
+    public:
+        // Histogram bucket i counts durations in [2^i, 2^(i+1)) nanoseconds, the last one everything above
+        static constexpr uint32_t NUM_BUCKETS = 32;
+        // Maximum number of distinct call sites, later sites are counted as dropped
+        static constexpr uint32_t MAX_SITES = 512;
+        // Site index returned when the site table is full
+        static constexpr uint32_t INVALID_SITE = UINT32_MAX;
+
+        typedef std::chrono::steady_clock clock;
+
+        // copy of a site taken by Snapshot
+        typedef struct SiteStats
+        {
+            std::string                         function;
+            std::string                         owner_class;
+            bool                                shared;
+            uint64_t                            count;
+            uint64_t                            contended;
+            uint64_t                            total_wait_ns;
+            uint64_t                            max_wait_ns;
+            uint64_t                            total_hold_ns;
+            uint64_t                            max_hold_ns;
+            std::array<uint64_t, NUM_BUCKETS>   wait_histogram;
+            std::array<uint64_t, NUM_BUCKETS>   hold_histogram;
+        } SiteStats;
+
+        static bool IsEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+        static void SetEnabled(bool enabled) { s_enabled.store(enabled, std::memory_order_relaxed); }
+
+        // Find or register a call site
+        // @param func_name - __func__ of the locking function, compared by pointer
+        // @return site index, INVALID_SITE if the table is full
+        static uint32_t GetSite(const char* func_name, const std::type_info* owner_type, bool shared);
+        // Record the time spent waiting for the lock into the calling thread counters
+        static void  RecordWait(uint32_t site, uint64_t wait_ns);
+        // Record the time the lock was held into the calling thread counters
+        static void  RecordHold(uint32_t site, uint64_t hold_ns);
+
+        // @return sum of all threads per site, ordered by total wait time descending
+        static std::vector<SiteStats> Snapshot();
+        // Zero the counters of every site
+        static void  Reset();
+        // @return number of lock acquisitions not recorded because the site table is full
+        static uint64_t Dropped() { return s_dropped.load(std::memory_order_relaxed); }
+
+    private:
+        struct Site
+        {
+            std::atomic<uint32_t>              state;
+            const char*                        func_name;
+            const std::type_info*              owner_type;
+            bool                               shared;
+        };
+
+        // counters of one site in one thread, written by the owning thread only
+        struct Counters
+        {
+            std::atomic<uint64_t>              count;
+            std::atomic<uint64_t>              contended;
+            std::atomic<uint64_t>              total_wait_ns;
+            std::atomic<uint64_t>              max_wait_ns;
+            std::atomic<uint64_t>              total_hold_ns;
+            std::atomic<uint64_t>              max_hold_ns;
+            std::array<std::atomic<uint64_t>, NUM_BUCKETS> wait_histogram;
+            std::array<std::atomic<uint64_t>, NUM_BUCKETS> hold_histogram;
+        };
+
+        class ThreadCounters;
+        friend struct LockStatsRegistry;
+
+        static uint32_t         Bucket(uint64_t ns);
+        static ThreadCounters&  LocalCounters();
+        static Counters&        LocalSite(uint32_t site);
+        static void             Accumulate(SiteStats& stats, Counters const& counters);
+        static void             Retire(ThreadCounters* thread);
+
+        static std::atomic<bool>     s_enabled;
+        static std::atomic<uint64_t> s_dropped;
+        static std::atomic<uint64_t> s_generation;
+        static Site                  s_sites[MAX_SITES];
+};
+
+}  // namespace DataModel
+}  // namespace RocProfVis
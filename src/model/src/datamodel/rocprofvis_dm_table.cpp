@@ -3,12 +3,19 @@
 
 #include "rocprofvis_dm_table.h"
 #include "rocprofvis_dm_trace.h"
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
 
 namespace RocProfVis
 {
 namespace DataModel
 {
 
+// large enough for "%f" of any double
+constexpr size_t CELL_TEXT_BUFFER_SIZE = 320;
+
 Table::Table(   Trace* ctx, 
                 rocprofvis_dm_charptr_t description,
                 rocprofvis_dm_charptr_t query)
@@ -17,15 +24,109 @@ Table::Table(   Trace* ctx,
 , m_description(description)
 {
     m_id = std::hash<std::string>{}(m_query);
+    // pool index 0 is the empty string, also the value of cells never set
+    m_strings.emplace_back();
+    m_string_ids[m_strings.back()] = 0;
 }
 
 rocprofvis_dm_size_t Table::GetMemoryFootprint(){
     size_t size = sizeof(Table);
-    for (int i=0; i < m_rows.size(); i++) size+=m_rows[i].get()->GetMemoryFootprint();
+    size += m_rows.size() * sizeof(TableRow);
     for (int i=0; i < m_columns.size(); i++) size+=m_columns[i].length();
+    for (ColumnCells& cells : m_cells) size += cells.values.capacity() * sizeof(uint64_t) + cells.kinds.capacity();
+    for (std::string& str : m_strings) size += sizeof(std::string) + str.capacity();
+    size += m_string_ids.size() * (sizeof(std::string_view) + sizeof(uint32_t) + sizeof(void*));
     return size;
 }
 
+uint32_t Table::InternString(rocprofvis_dm_charptr_t value){
+    auto it = m_string_ids.find(value);
+    if (it != m_string_ids.end())
+    {
+        return it->second;
+    }
+    uint32_t id = static_cast<uint32_t>(m_strings.size());
+    m_strings.emplace_back(value);
+    m_string_ids[m_strings.back()] = id;
+    return id;
+}
+
+rocprofvis_dm_result_t Table::SetCell(uint32_t row, uint32_t column, CellKind kind, uint64_t value){
+    try{
+        if (column >= m_cells.size())
+        {
+            m_cells.resize(column + 1);
+        }
+        ColumnCells& cells = m_cells[column];
+        if (row >= cells.values.size())
+        {
+            cells.values.resize(row + 1, 0);
+            cells.kinds.resize(row + 1, kCellString);
+        }
+        cells.values[row] = value;
+        cells.kinds[row] = kind;
+    }
+    catch(std::exception ex)
+    {
+        return kRocProfVisDmResultAllocFailure;
+    }
+    return kRocProfVisDmResultSuccess;
+}
+
+rocprofvis_dm_result_t Table::GetCellString(uint32_t row, uint32_t column, rocprofvis_dm_charptr_t & value){
+    // numeric text is only valid until the next numeric read on this thread, see
+    // rocprofvis_dm_get_property_as_charptr
+    static thread_local char cell_text[CELL_TEXT_BUFFER_SIZE];
+    ROCPROFVIS_ASSERT_MSG_RETURN(row < m_rows.size(), ERROR_INDEX_OUT_OF_RANGE, kRocProfVisDmResultNotLoaded);
+    if (column >= m_cells.size() || row >= m_cells[column].values.size())
+    {
+        value = m_strings[0].c_str();
+        return kRocProfVisDmResultSuccess;
+    }
+    uint64_t cell = m_cells[column].values[row];
+    switch(m_cells[column].kinds[row])
+    {
+        case kCellUInt64:
+            snprintf(cell_text, CELL_TEXT_BUFFER_SIZE, "%" PRIu64, cell);
+            value = cell_text;
+            break;
+        case kCellInt64:
+            snprintf(cell_text, CELL_TEXT_BUFFER_SIZE, "%" PRId64, static_cast<int64_t>(cell));
+            value = cell_text;
+            break;
+        case kCellDouble:
+        {
+            double number;
+            memcpy(&number, &cell, sizeof(double));
+            // same format as std::to_string, which produced the cell text before
+            snprintf(cell_text, CELL_TEXT_BUFFER_SIZE, "%f", number);
+            value = cell_text;
+            break;
+        }
+        default:
+            value = m_strings[cell].c_str();
+            break;
+    }
+    return kRocProfVisDmResultSuccess;
+}
+
+rocprofvis_dm_result_t Table::GetCells(uint64_t first_row, uint64_t num_rows, 
+                                       rocprofvis_dm_table_cell_callback_t callback, void* user_data){
+    ROCPROFVIS_ASSERT_MSG_RETURN(first_row <= m_rows.size(), ERROR_INDEX_OUT_OF_RANGE, kRocProfVisDmResultNotLoaded);
+    uint64_t end_row = first_row + std::min<uint64_t>(num_rows, m_rows.size() - first_row);
+    for (uint64_t row = first_row; row < end_row; row++)
+    {
+        uint32_t num_cells = static_cast<uint32_t>(m_rows[row].GetNumberOfCells());
+        for (uint32_t column = 0; column < num_cells; column++)
+        {
+            rocprofvis_dm_charptr_t value = nullptr;
+            GetCellString(static_cast<uint32_t>(row), column, value);
+            callback(row, column, value, user_data);
+        }
+    }
+    return kRocProfVisDmResultSuccess;
+}
+
 rocprofvis_dm_result_t Table::AddColumn(rocprofvis_dm_charptr_t column_name){
     try{
         m_columns.push_back(column_name);
@@ -61,13 +162,13 @@ rocprofvis_dm_result_t Table::AddColumnType(rocprofvis_db_data_type_t column_typ
 
 rocprofvis_dm_table_row_t Table::AddRow(){
     try{
-        m_rows.push_back(std::make_shared<TableRow>(this));
+        m_rows.emplace_back(this, static_cast<uint32_t>(m_rows.size()));
     }
     catch(std::exception ex)
     {
         ROCPROFVIS_ASSERT_ALWAYS_MSG_RETURN("Error! Failure allocating table row object", nullptr);
     }
-    return m_rows.back().get();
+    return &m_rows.back();
 }
 
 rocprofvis_dm_result_t Table::GetColumnNameAt(const rocprofvis_dm_property_index_t index, rocprofvis_dm_charptr_t & name){
@@ -91,7 +192,7 @@ rocprofvis_dm_result_t Table::GetColumnTypeAt(const rocprofvis_dm_property_index
 
 rocprofvis_dm_result_t   Table::GetRowHandleAt(const rocprofvis_dm_property_index_t index, rocprofvis_dm_handle_t & row){
     ROCPROFVIS_ASSERT_MSG_RETURN(index < m_rows.size(), ERROR_INDEX_OUT_OF_RANGE, kRocProfVisDmResultNotLoaded);
-    row = m_rows[index].get();
+    row = &m_rows[index];
     return kRocProfVisDmResultSuccess;    
 }
 
@@ -5,6 +5,9 @@
 
 #include "rocprofvis_common_types.h"
 #include "rocprofvis_dm_table_row.h"
+#include <deque>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace RocProfVis
@@ -57,9 +60,19 @@ private :
 
 };
 
-// Table is class of table object, container of TableRow objects
+// Table is class of table object, container of TableRow objects.
+// Cells are kept in typed column vectors: strings are interned in a table string pool and numeric
+// values stay binary until they are read as strings, so a page of numeric cells costs no string allocations.
 class Table : public DmBase {
     public:
+        // Kind of value held by a cell
+        enum CellKind : uint8_t
+        {
+            kCellString,
+            kCellUInt64,
+            kCellInt64,
+            kCellDouble
+        };
         // Table class constructor
         // @param  ctx - Trace object context
         // @param description - pointer to table description string
@@ -88,6 +101,32 @@ class Table : public DmBase {
         rocprofvis_dm_size_t                    GetNumberOfColumns() {return m_columns.size();};
         // Returns number of rows
         rocprofvis_dm_size_t                    GetNumberOfRows() {return m_rows.size();};
+        // Method to store a cell value, called by TableRow
+        // @param row - row index
+        // @param column - column index
+        // @param kind - kind of value
+        // @param value - string pool index, integer or bits of double, as given by kind
+        // @return status of operation
+        rocprofvis_dm_result_t                  SetCell(uint32_t row, uint32_t column, CellKind kind, uint64_t value);
+        // Method to add a string to the table string pool, equal strings share one entry
+        // @param value - pointer to string
+        // @return string pool index
+        uint32_t                                InternString(rocprofvis_dm_charptr_t value);
+        // Method to read a cell as string. Numeric cells are formatted into a per thread buffer,
+        // which stays valid until the next numeric cell is read on the same thread
+        // @param row - row index
+        // @param column - column index
+        // @param value - reference to cell value string
+        // @return status of operation
+        rocprofvis_dm_result_t                  GetCellString(uint32_t row, uint32_t column, rocprofvis_dm_charptr_t & value);
+        // Method to read all cells of a range of rows as strings, without per cell property lookups
+        // @param first_row - index of first row
+        // @param num_rows - number of rows, clamped to the end of table
+        // @param callback - called for every cell, row by row
+        // @param user_data - passed to the callback
+        // @return status of operation
+        rocprofvis_dm_result_t                  GetCells(uint64_t first_row, uint64_t num_rows, 
+                                                            rocprofvis_dm_table_cell_callback_t callback, void* user_data);
         // Method to get amount of memory used by Table class object
         // @return used memory size
         rocprofvis_dm_size_t                    GetMemoryFootprint();
@@ -135,6 +174,15 @@ class Table : public DmBase {
 #endif
 
     private:
+        // typed cells of one column, indexed by row
+        typedef struct ColumnCells
+        {
+            // string pool index, integer or bits of double
+            std::vector<uint64_t>                       values;
+            // CellKind of every value
+            std::vector<uint8_t>                        kinds;
+        } ColumnCells;
+
         // table id
         uint64_t                                       m_id;
         // pointer to Trace context object
@@ -145,8 +193,14 @@ class Table : public DmBase {
         std::vector<rocprofvis_db_table_column_enum_t>      m_column_enums;
         // vector array of column names
         std::vector<rocprofvis_db_data_type_t>              m_column_types;      
-        // vector array of row objects
-        std::vector<std::shared_ptr<TableRow>>              m_rows;
+        // row objects, deque keeps row handles stable while rows are added
+        std::deque<TableRow>                                m_rows;
+        // cell values, one entry per column
+        std::vector<ColumnCells>                            m_cells;
+        // string pool, deque keeps the strings referenced by m_string_ids in place
+        std::deque<std::string>                             m_strings;
+        // string pool lookup
+        std::unordered_map<std::string_view, uint32_t>      m_string_ids;
         // table query string
         std::string                                         m_query;
         // table description string
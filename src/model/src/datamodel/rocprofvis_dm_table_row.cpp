@@ -4,6 +4,7 @@
 #include "rocprofvis_dm_table_row.h"
 #include "rocprofvis_dm_table.h"
 #include "rocprofvis_dm_trace.h"
+#include <cstring>
 
 namespace RocProfVis
 {
@@ -16,27 +17,46 @@ std::shared_mutex* TableRow::Mutex()
 }
 
 rocprofvis_dm_size_t  TableRow::GetMemoryFootprint(){
-    size_t size = sizeof(TableRow);
-    for (int i=0; i < m_values.size(); i++) size+=m_values[i].length();
-    return size;
+    return sizeof(TableRow);
 }
 
 rocprofvis_dm_result_t  TableRow::AddCellValue(rocprofvis_dm_charptr_t value){
     try{
-        m_values.push_back(value);
+        uint32_t id = m_ctx->InternString(value);
+        rocprofvis_dm_result_t result = m_ctx->SetCell(m_index, m_num_cells, Table::kCellString, id);
+        if (result == kRocProfVisDmResultSuccess) m_num_cells++;
+        return result;
     }
     catch(std::exception ex)
     {
         return kRocProfVisDmResultAllocFailure;
     }
-    return kRocProfVisDmResultSuccess;
+}
+
+rocprofvis_dm_result_t  TableRow::AddCellValue(uint64_t value){
+    rocprofvis_dm_result_t result = m_ctx->SetCell(m_index, m_num_cells, Table::kCellUInt64, value);
+    if (result == kRocProfVisDmResultSuccess) m_num_cells++;
+    return result;
+}
+
+rocprofvis_dm_result_t  TableRow::AddCellValue(int64_t value){
+    rocprofvis_dm_result_t result = m_ctx->SetCell(m_index, m_num_cells, Table::kCellInt64, static_cast<uint64_t>(value));
+    if (result == kRocProfVisDmResultSuccess) m_num_cells++;
+    return result;
+}
+
+rocprofvis_dm_result_t  TableRow::AddCellValue(double value){
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(double));
+    rocprofvis_dm_result_t result = m_ctx->SetCell(m_index, m_num_cells, Table::kCellDouble, bits);
+    if (result == kRocProfVisDmResultSuccess) m_num_cells++;
+    return result;
 }
 
 
 rocprofvis_dm_result_t TableRow::GetValueAt(const rocprofvis_dm_property_index_t index, rocprofvis_dm_charptr_t & value){
-    ROCPROFVIS_ASSERT_MSG_RETURN(index < m_values.size(), ERROR_INDEX_OUT_OF_RANGE, kRocProfVisDmResultNotLoaded);
-    value = m_values[index].c_str();
-    return kRocProfVisDmResultSuccess;
+    ROCPROFVIS_ASSERT_MSG_RETURN(index < m_num_cells, ERROR_INDEX_OUT_OF_RANGE, kRocProfVisDmResultNotLoaded);
+    return m_ctx->GetCellString(m_index, static_cast<uint32_t>(index), value);
 }
 
 rocprofvis_dm_result_t TableRow::GetPropertyAsUint64(rocprofvis_dm_property_t property, rocprofvis_dm_property_index_t index, uint64_t* value){
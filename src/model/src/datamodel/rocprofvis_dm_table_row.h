@@ -39,21 +39,37 @@ private:
     rocprofvis_dm_table_row_t      m_handle;
 };
 
-// TableRow is class of table row object
+// TableRow is class of table row object. Cell values are stored column wise by the owning Table,
+// the row only keeps its position and number of cells
 class TableRow : public DmBase {
     public:
         // TableRow class constructor
         // @param  ctx - Table object context
-        TableRow(  Table* ctx) : m_ctx(ctx) {}; 
+        // @param  index - row index in table
+        TableRow(  Table* ctx, uint32_t index) : m_ctx(ctx), m_index(index), m_num_cells(0) {}; 
         // TableRow class destructor, not required unless declared as virtual
         ~TableRow(){}
-        // Method to add a cell to a row
+        // Method to add a string cell to a row
         // @param value pointer to table value string
         // @return status of operation
         rocprofvis_dm_result_t          AddCellValue(rocprofvis_dm_charptr_t value);
+        // Method to add an unsigned integer cell to a row, formatted when read as string
+        // @param value cell value
+        // @return status of operation
+        rocprofvis_dm_result_t          AddCellValue(uint64_t value);
+        // Method to add a signed integer cell to a row, formatted when read as string
+        // @param value cell value
+        // @return status of operation
+        rocprofvis_dm_result_t          AddCellValue(int64_t value);
+        // Method to add a floating point cell to a row, formatted when read as string
+        // @param value cell value
+        // @return status of operation
+        rocprofvis_dm_result_t          AddCellValue(double value);
         // Returns number of cells in a row
-        rocprofvis_dm_size_t            GetNumberOfCells() {return m_values.size();};
-        // Method to get amount of memory used by TableRow class object
+        rocprofvis_dm_size_t            GetNumberOfCells() {return m_num_cells;};
+        // Returns row index in table
+        uint32_t                        Index() {return m_index;};
+        // Method to get amount of memory used by TableRow class object, cells are accounted by Table
         // @return used memory size
         rocprofvis_dm_size_t            GetMemoryFootprint();
 
@@ -89,8 +105,10 @@ class TableRow : public DmBase {
     private:
         // Context pointer
         Table*                     m_ctx;
-        // Vector array of string values
-        std::vector<std::string>        m_values;
+        // Row index in table
+        uint32_t                        m_index;
+        // Number of cells added to the row
+        uint32_t                        m_num_cells;
 
         // Method to get pointer to table value string at provided index
         // @param index - record index
@@ -13,6 +13,9 @@ namespace DataModel
 {
 
 Trace::Trace()
+: m_flow_traces(EVENT_PROPERTY_CACHE_MAX_ITEMS, EVENT_PROPERTY_CACHE_MAX_BYTES)
+, m_stack_traces(EVENT_PROPERTY_CACHE_MAX_ITEMS, EVENT_PROPERTY_CACHE_MAX_BYTES)
+, m_ext_data(EVENT_PROPERTY_CACHE_MAX_ITEMS, EVENT_PROPERTY_CACHE_MAX_BYTES)
 {
     m_db = nullptr;
     m_parameters.trace_duration = 0;
@@ -45,11 +48,15 @@ rocprofvis_dm_result_t Trace::BindDatabase(rocprofvis_dm_database_t db, rocprofv
     m_binding_info.FuncAddTableColumnEnum = AddTableColumnEnum;
     m_binding_info.FuncAddTableColumnType = AddTableColumnType;
     m_binding_info.FuncAddTableRowCell = AddTableRowCell;
+    m_binding_info.FuncAddTableRowCellUInt64 = AddTableRowCellUInt64;
+    m_binding_info.FuncAddTableRowCellInt64 = AddTableRowCellInt64;
+    m_binding_info.FuncAddTableRowCellDouble = AddTableRowCellDouble;
     m_binding_info.FuncAddEventLevel = AddEventLevel;
     m_binding_info.FuncCheckEventPropertyExists = CheckEventPropertyExists;
     m_binding_info.FuncCheckSliceExists = CheckSliceExists;
     m_binding_info.FuncCheckTableExists = CheckTableExists;
     m_binding_info.FuncCompleteSlice  = CompleteSlice;
+    m_binding_info.FuncCompleteEventProperty = CompleteEventProperty;
     m_binding_info.FuncGetString = GetString;
     m_binding_info.FuncMetadataLoaded = MetadataLoaded;
     m_binding_info.FuncGetStringOrder = GetStringOrder;
@@ -87,191 +94,167 @@ rocprofvis_dm_result_t Trace::DeleteAllSlices(){
  
 rocprofvis_dm_result_t  Trace::DeleteEventPropertyFor(     rocprofvis_dm_event_property_type_t type,
                                                                 rocprofvis_dm_event_id_t event_id) {
+    rocprofvis_dm_result_t result = kRocProfVisDmResultNotLoaded;
     switch (type)
     {
         case kRPVDMEventFlowTrace:
         {
-            // To delete single vector array element thread-safe, we must retain a local copy 
-            // The element is protected by its own mutex and will be deleted outside the scope when mutex is unlocked
-            std::shared_ptr<FlowTrace> item;
+            // To delete single cached object thread-safe, we must retain a local copy 
+            // The object is protected by its own mutex and will be deleted outside the scope when mutex is unlocked
+            EventPropertyCache<FlowTrace>::released_list_t released;
             {
-                TimedLock<std::unique_lock<std::shared_mutex>> lock(*EventPropertyMutex(type),__func__, this);
-                auto it = std::find_if(
-                    m_flow_traces.begin(), m_flow_traces.end(),
-                                       [&event_id](std::shared_ptr<FlowTrace>& x) {
-                                           return x.get()->EventId().value == event_id.value;
-                                       });
-                if (it == m_flow_traces.end())
-                {
-                    return kRocProfVisDmResultNotLoaded;
-                }
-                item    = *it;
-                m_flow_traces.erase(it);
+                TimedLock<std::unique_lock<std::shared_mutex>> lock(*EventPropertyMutex(type), __func__, this);
+                result = m_flow_traces.Remove(event_id.value, released);
             }
-            return kRocProfVisDmResultSuccess;
+            return result;
         }
-        break;
         case kRPVDMEventStackTrace:
         {
-            // To delete single vector array element thread-safe, we must retain a local copy 
-            // The element is protected by its own mutex and will be deleted outside the scope when mutex is unlocked
-            std::shared_ptr<StackTrace> item;
+            // To delete single cached object thread-safe, we must retain a local copy 
+            // The object is protected by its own mutex and will be deleted outside the scope when mutex is unlocked
+            EventPropertyCache<StackTrace>::released_list_t released;
             {
                 TimedLock<std::unique_lock<std::shared_mutex>> lock(*EventPropertyMutex(type), __func__, this);
-                auto             it =
-                    std::find_if(m_stack_traces.begin(), m_stack_traces.end(),
-                                 [&event_id](std::shared_ptr<StackTrace>& x) {
-                                     return x.get()->EventId().value == event_id.value;
-                                 });
-                if(it == m_stack_traces.end())
-                {
-                    return kRocProfVisDmResultNotLoaded;
-                }
-                item = *it;
-                m_stack_traces.erase(it);
+                result = m_stack_traces.Remove(event_id.value, released);
             }
-            return kRocProfVisDmResultSuccess;
+            return result;
         }
-        break;
         case kRPVDMEventExtData:
         {
-            // To delete single vector array element thread-safe, we must retain a local copy 
-            // The element is protected by its own mutex and will be deleted outside the scope when mutex is unlocked
-            std::shared_ptr<ExtData> item;
+            // To delete single cached object thread-safe, we must retain a local copy 
+            // The object is protected by its own mutex and will be deleted outside the scope when mutex is unlocked
+            EventPropertyCache<ExtData>::released_list_t released;
             {
                 TimedLock<std::unique_lock<std::shared_mutex>> lock(*EventPropertyMutex(type), __func__, this);
-                auto             it =
-                    std::find_if(m_ext_data.begin(), m_ext_data.end(),
-                                 [&event_id](std::shared_ptr<ExtData>& x) {
-                                     return x.get()->EventId().value == event_id.value;
-                                 });
-                if(it == m_ext_data.end())
-                {
-                    return kRocProfVisDmResultNotLoaded;
-                }
-                item = *it;
-                m_ext_data.erase(it);
+                result = m_ext_data.Remove(event_id.value, released);
             }
-            return kRocProfVisDmResultSuccess;
-        }  
-        break;   
+            return result;
+        }
     }
     ROCPROFVIS_ASSERT_ALWAYS_MSG_RETURN(ERROR_UNSUPPORTED_PROPERTY, kRocProfVisDmResultNotSupported); 
 }
 
 rocprofvis_dm_result_t  Trace::DeleteEventProperty(     rocprofvis_dm_event_property_type_t type,
     rocprofvis_dm_handle_t object) {
+    rocprofvis_dm_result_t result = kRocProfVisDmResultNotLoaded;
     switch (type)
     {
-    case kRPVDMEventFlowTrace:
-    {
-        // To delete single vector array element thread-safe, we must retain a local copy 
-        // The element is protected by its own mutex and will be deleted outside the scope when mutex is unlocked
-        std::shared_ptr<FlowTrace> item;
+        case kRPVDMEventFlowTrace:
         {
-            TimedLock<std::unique_lock<std::shared_mutex>> lock(*EventPropertyMutex(type),__func__, this);
-            auto it = std::find_if(
-                m_flow_traces.begin(), m_flow_traces.end(),
-                [&object](std::shared_ptr<FlowTrace>& x) {
-                    return x.get() == object;
-                });
-            if (it == m_flow_traces.end())
+            // To delete single cached object thread-safe, we must retain a local copy 
+            // The object is protected by its own mutex and will be deleted outside the scope when mutex is unlocked
+            EventPropertyCache<FlowTrace>::released_list_t released;
             {
-                return kRocProfVisDmResultNotLoaded;
+                TimedLock<std::unique_lock<std::shared_mutex>> lock(*EventPropertyMutex(type), __func__, this);
+                result = m_flow_traces.Remove(object, released);
             }
-            item    = *it;
-            m_flow_traces.erase(it);
+            return result;
         }
-        return kRocProfVisDmResultSuccess;
-    }
-    break;
-    case kRPVDMEventStackTrace:
-    {
-        // To delete single vector array element thread-safe, we must retain a local copy 
-        // The element is protected by its own mutex and will be deleted outside the scope when mutex is unlocked
-        std::shared_ptr<StackTrace> item;
+        case kRPVDMEventStackTrace:
         {
-            TimedLock<std::unique_lock<std::shared_mutex>> lock(*EventPropertyMutex(type), __func__, this);
-            auto             it =
-                std::find_if(m_stack_traces.begin(), m_stack_traces.end(),
-                    [&object](std::shared_ptr<StackTrace>& x) {
-                        return x.get() ==object;
-                    });
-            if(it == m_stack_traces.end())
+            // To delete single cached object thread-safe, we must retain a local copy 
+            // The object is protected by its own mutex and will be deleted outside the scope when mutex is unlocked
+            EventPropertyCache<StackTrace>::released_list_t released;
             {
-                return kRocProfVisDmResultNotLoaded;
+                TimedLock<std::unique_lock<std::shared_mutex>> lock(*EventPropertyMutex(type), __func__, this);
+                result = m_stack_traces.Remove(object, released);
             }
-            item = *it;
-            m_stack_traces.erase(it);
+            return result;
         }
-        return kRocProfVisDmResultSuccess;
-    }
-    break;
-    case kRPVDMEventExtData:
-    {
-        // To delete single vector array element thread-safe, we must retain a local copy 
-        // The element is protected by its own mutex and will be deleted outside the scope when mutex is unlocked
-        std::shared_ptr<ExtData> item;
+        case kRPVDMEventExtData:
         {
-            TimedLock<std::unique_lock<std::shared_mutex>> lock(*EventPropertyMutex(type), __func__, this);
-            auto             it =
-                std::find_if(m_ext_data.begin(), m_ext_data.end(),
-                    [&object](std::shared_ptr<ExtData>& x) {
-                        return x.get() == object;
-                    });
-            if(it == m_ext_data.end())
+            // To delete single cached object thread-safe, we must retain a local copy 
+            // The object is protected by its own mutex and will be deleted outside the scope when mutex is unlocked
+            EventPropertyCache<ExtData>::released_list_t released;
             {
-                return kRocProfVisDmResultNotLoaded;
+                TimedLock<std::unique_lock<std::shared_mutex>> lock(*EventPropertyMutex(type), __func__, this);
+                result = m_ext_data.Remove(object, released);
             }
-            item = *it;
-            m_ext_data.erase(it);
+            return result;
         }
-        return kRocProfVisDmResultSuccess;
-    }  
-    break;   
     }
     ROCPROFVIS_ASSERT_ALWAYS_MSG_RETURN(ERROR_UNSUPPORTED_PROPERTY, kRocProfVisDmResultNotSupported); 
 }
 
+rocprofvis_dm_result_t  Trace::PinEventProperty(     rocprofvis_dm_event_property_type_t type,
+                                                                rocprofvis_dm_event_id_t event_id,
+                                                                rocprofvis_dm_handle_t & object) {
+    object = nullptr;
+    TimedLock<std::shared_lock<std::shared_mutex>> lock(*EventPropertyMutex(type), __func__, this);
+    switch (type)
+    {
+        case kRPVDMEventFlowTrace:
+            object = m_flow_traces.Pin(event_id.value);
+            break;
+        case kRPVDMEventStackTrace:
+            object = m_stack_traces.Pin(event_id.value);
+            break;
+        case kRPVDMEventExtData:
+            object = m_ext_data.Pin(event_id.value);
+            break;
+        default:
+            ROCPROFVIS_ASSERT_ALWAYS_MSG_RETURN(ERROR_UNSUPPORTED_PROPERTY, kRocProfVisDmResultNotSupported); 
+    }
+    return object != nullptr ? kRocProfVisDmResultSuccess : kRocProfVisDmResultNotLoaded;
+}
+
+rocprofvis_dm_result_t  Trace::UnpinEventProperty(     rocprofvis_dm_event_property_type_t type,
+                                                                rocprofvis_dm_handle_t object) {
+    bool found = false;
+    TimedLock<std::shared_lock<std::shared_mutex>> lock(*EventPropertyMutex(type), __func__, this);
+    switch (type)
+    {
+        case kRPVDMEventFlowTrace:
+            found = m_flow_traces.Unpin(object);
+            break;
+        case kRPVDMEventStackTrace:
+            found = m_stack_traces.Unpin(object);
+            break;
+        case kRPVDMEventExtData:
+            found = m_ext_data.Unpin(object);
+            break;
+        default:
+            ROCPROFVIS_ASSERT_ALWAYS_MSG_RETURN(ERROR_UNSUPPORTED_PROPERTY, kRocProfVisDmResultNotSupported); 
+    }
+    return found ? kRocProfVisDmResultSuccess : kRocProfVisDmResultNotLoaded;
+}
+
 rocprofvis_dm_result_t  Trace::DeleteAllEventPropertiesFor(rocprofvis_dm_event_property_type_t type){
     switch(type)
     {
         case kRPVDMEventFlowTrace:
         {
-            // To delete all vector array elements thread-safe, we must swap its content with local array while protected by main mutex
-            // The elements of local array are protected by their own mutexes and will be deleted outside the scope when mutexes are unlocked 
-            std::vector<std::shared_ptr<FlowTrace>> flow_traces;
+            // To delete all cached objects thread-safe, we must move them to local array while protected by main mutex
+            // The objects of local array are protected by their own mutexes and will be deleted outside the scope when mutexes are unlocked 
+            EventPropertyCache<FlowTrace>::released_list_t released;
             {
                 TimedLock<std::unique_lock<std::shared_mutex>> lock(*EventPropertyMutex(type), __func__, this);
-                flow_traces.swap(m_flow_traces);
+                m_flow_traces.Clear(released);
             }
             return kRocProfVisDmResultSuccess;
         }
-        break;
         case kRPVDMEventStackTrace:
         {
-            // To delete all vector array elements thread-safe, we must swap its content with local array while protected by main mutex
-            // The elements of local array are protected by their own mutexes and will be deleted outside the scope when mutexes are unlocked 
-            std::vector<std::shared_ptr<StackTrace>> stack_traces;
+            // To delete all cached objects thread-safe, we must move them to local array while protected by main mutex
+            // The objects of local array are protected by their own mutexes and will be deleted outside the scope when mutexes are unlocked 
+            EventPropertyCache<StackTrace>::released_list_t released;
             {
-                TimedLock<std::unique_lock<std::shared_mutex>> lock(*EventPropertyMutex(type), __func__,this);
-                stack_traces.swap(m_stack_traces);
+                TimedLock<std::unique_lock<std::shared_mutex>> lock(*EventPropertyMutex(type), __func__, this);
+                m_stack_traces.Clear(released);
             }
             return kRocProfVisDmResultSuccess;
         }
-        break;
         case kRPVDMEventExtData:
         {
-            // To delete all vector array elements thread-safe, we must swap its content with local array while protected by main mutex
-            // The elements of local array are protected by their own mutexes and will be deleted outside the scope when mutexes are unlocked 
-            std::vector<std::shared_ptr<ExtData>> ext_data;
+            // To delete all cached objects thread-safe, we must move them to local array while protected by main mutex
+            // The objects of local array are protected by their own mutexes and will be deleted outside the scope when mutexes are unlocked 
+            EventPropertyCache<ExtData>::released_list_t released;
             {
                 TimedLock<std::unique_lock<std::shared_mutex>> lock(*EventPropertyMutex(type), __func__, this);
-                ext_data.swap(m_ext_data);
+                m_ext_data.Clear(released);
             }
             return kRocProfVisDmResultSuccess;
         }
-        break;  
     }
     ROCPROFVIS_ASSERT_ALWAYS_MSG_RETURN(ERROR_UNSUPPORTED_PROPERTY, kRocProfVisDmResultNotSupported); 
 }
@@ -318,17 +301,17 @@ rocprofvis_dm_size_t Trace::GetMemoryFootprint(){
     {
         size+=m_tracks[i].get()->GetMemoryFootprint();
     }   
-    for (int i=0; i < m_flow_traces.size(); i++)
     {
-        size+=m_flow_traces[i].get()->GetMemoryFootprint();
+        TimedLock<std::shared_lock<std::shared_mutex>> lock(*EventPropertyMutex(kRPVDMEventFlowTrace), __func__, this);
+        size+=m_flow_traces.GetMemoryFootprint();
     }
-    for (int i=0; i < m_stack_traces.size(); i++)
     {
-        size+=m_stack_traces[i].get()->GetMemoryFootprint();
+        TimedLock<std::shared_lock<std::shared_mutex>> lock(*EventPropertyMutex(kRPVDMEventStackTrace), __func__, this);
+        size+=m_stack_traces.GetMemoryFootprint();
     }
-    for (int i=0; i < m_ext_data.size(); i++)
     {
-        size+=m_ext_data[i].get()->GetMemoryFootprint();
+        TimedLock<std::shared_lock<std::shared_mutex>> lock(*EventPropertyMutex(kRPVDMEventExtData), __func__, this);
+        size+=m_ext_data.GetMemoryFootprint();
     }
     for (int i=0; i < m_tables.size(); i++)
     {
@@ -341,6 +324,72 @@ rocprofvis_dm_size_t Trace::GetMemoryFootprint(){
     return size;
 }
 
+rocprofvis_dm_result_t Trace::GetMemoryUsage(rocprofvis_dm_memory_category_t category, uint64_t & bytes, uint64_t & items){
+    bytes = 0;
+    items = 0;
+    switch(category)
+    {
+        case kRPVDMMemoryEvents:
+        case kRPVDMMemorySamples:
+        {
+            for (int i=0; i < m_tracks.size(); i++)
+            {
+                Track* track = m_tracks[i].get();
+                bool is_pmc = track->Category() == kRocProfVisDmPmcTrack;
+                if (is_pmc == (category == kRPVDMMemorySamples))
+                {
+                    TimedLock<std::shared_lock<std::shared_mutex>> track_lock(*track->Mutex(), __func__, track);
+                    bytes+=track->GetMemoryFootprint();
+                    items+=track->GetNumberOfLoadedRecords();
+                }
+            }
+            return kRocProfVisDmResultSuccess;
+        }
+        case kRPVDMMemoryFlowTraces:
+        {
+            TimedLock<std::shared_lock<std::shared_mutex>> lock(*EventPropertyMutex(kRPVDMEventFlowTrace), __func__, this);
+            bytes = m_flow_traces.GetMemoryFootprint();
+            items = m_flow_traces.Size();
+            return kRocProfVisDmResultSuccess;
+        }
+        case kRPVDMMemoryStackTraces:
+        {
+            TimedLock<std::shared_lock<std::shared_mutex>> lock(*EventPropertyMutex(kRPVDMEventStackTrace), __func__, this);
+            bytes = m_stack_traces.GetMemoryFootprint();
+            items = m_stack_traces.Size();
+            return kRocProfVisDmResultSuccess;
+        }
+        case kRPVDMMemoryExtData:
+        {
+            TimedLock<std::shared_lock<std::shared_mutex>> lock(*EventPropertyMutex(kRPVDMEventExtData), __func__, this);
+            bytes = m_ext_data.GetMemoryFootprint();
+            items = m_ext_data.Size();
+            return kRocProfVisDmResultSuccess;
+        }
+        case kRPVDMMemoryTables:
+        {
+            for (int i=0; i < m_tables.size(); i++)
+            {
+                bytes+=m_tables[i].get()->GetMemoryFootprint();
+                items+=m_tables[i].get()->GetNumberOfRows();
+            }
+            return kRocProfVisDmResultSuccess;
+        }
+        case kRPVDMMemoryStrings:
+        {
+            for (int i=0; i < m_strings.size(); i++)
+            {
+                bytes+=sizeof(std::string) + m_strings[i].capacity() + 1;
+            }
+            bytes+=m_sorted_strings_lookup_array.capacity() * sizeof(uint32_t);
+            items = m_strings.size();
+            return kRocProfVisDmResultSuccess;
+        }
+        default:
+            ROCPROFVIS_ASSERT_ALWAYS_MSG_RETURN(ERROR_INDEX_OUT_OF_RANGE, kRocProfVisDmResultInvalidParameter);
+    }
+}
+
 rocprofvis_dm_result_t Trace::AddTrack(const rocprofvis_dm_trace_t object, rocprofvis_dm_track_params_t * params){
     ROCPROFVIS_ASSERT_MSG_RETURN(object, ERROR_TRACE_CANNOT_BE_NULL, kRocProfVisDmResultInvalidParameter);
     Trace* trace = (Trace*)object;
@@ -449,13 +498,12 @@ rocprofvis_dm_flowtrace_t Trace::AddFlowTrace(const rocprofvis_dm_trace_t object
     Trace* trace = (Trace*)object;
     TimedLock<std::unique_lock<std::shared_mutex>> lock(*trace->EventPropertyMutex(kRPVDMEventFlowTrace), __func__, trace);
     try{
-        trace->m_flow_traces.push_back(std::make_shared<FlowTrace>(trace, event_id));
+        return trace->m_flow_traces.Add(event_id.value, std::make_shared<FlowTrace>(trace, event_id));
     }
     catch(const std::exception&)
     {
         ROCPROFVIS_ASSERT_ALWAYS_MSG_RETURN( "Error! Failure allocating flowtrace object", nullptr);
     }
-    return trace->m_flow_traces.back().get();
 }  
 
 rocprofvis_dm_result_t Trace::AddStackFrame(const rocprofvis_dm_stacktrace_t object, rocprofvis_db_stack_data_t & data){
@@ -470,13 +518,12 @@ rocprofvis_dm_stacktrace_t Trace::AddStackTrace(const rocprofvis_dm_trace_t obje
     Trace* trace = (Trace*)object;
     TimedLock<std::unique_lock<std::shared_mutex>> lock(*trace->EventPropertyMutex(kRPVDMEventStackTrace), __func__, trace);
     try{
-        trace->m_stack_traces.push_back(std::make_shared<StackTrace>(trace, event_id));
+        return trace->m_stack_traces.Add(event_id.value, std::make_shared<StackTrace>(trace, event_id));
     }
     catch(const std::exception&)
     {
         ROCPROFVIS_ASSERT_ALWAYS_MSG_RETURN( "Error! Failure allocating stacktrace object", nullptr);
     }
-    return trace->m_stack_traces.back().get();
 }  
 
 rocprofvis_dm_extdata_t  Trace::AddExtData(const rocprofvis_dm_trace_t object, const rocprofvis_dm_event_id_t event_id){
@@ -484,13 +531,12 @@ rocprofvis_dm_extdata_t  Trace::AddExtData(const rocprofvis_dm_trace_t object, c
     Trace* trace = (Trace*)object;
     TimedLock<std::unique_lock<std::shared_mutex>> lock(*trace->EventPropertyMutex(kRPVDMEventExtData), __func__, trace);
     try{
-        trace->m_ext_data.push_back(std::make_shared<ExtData>(trace,event_id));
+        return trace->m_ext_data.Add(event_id.value, std::make_shared<ExtData>(trace, event_id));
     }
     catch(const std::exception&)
     {
         ROCPROFVIS_ASSERT_ALWAYS_MSG_RETURN( "Error! Failure allocating extended data object", nullptr);
     }
-    return trace->m_ext_data.back().get();
 }
 
 rocprofvis_dm_result_t Trace::AddTopologyNode(const rocprofvis_dm_trace_t object, rocprofvis_dm_track_identifiers_t* track_indentifiers) {
@@ -631,6 +677,27 @@ rocprofvis_dm_result_t Trace::AddTableRowCell(const rocprofvis_dm_table_row_t ob
     return table_row->AddCellValue(cell_value);
 }
 
+rocprofvis_dm_result_t Trace::AddTableRowCellUInt64(const rocprofvis_dm_table_row_t object, uint64_t cell_value){
+    ROCPROFVIS_ASSERT_MSG_RETURN(object, ERROR_TABLE_ROW_CANNOT_BE_NULL, kRocProfVisDmResultInvalidParameter);
+    TableRow* table_row = (TableRow*) object;
+    TimedLock<std::unique_lock<std::shared_mutex>> lock(*table_row->Mutex(), __func__, table_row);
+    return table_row->AddCellValue(cell_value);
+}
+
+rocprofvis_dm_result_t Trace::AddTableRowCellInt64(const rocprofvis_dm_table_row_t object, int64_t cell_value){
+    ROCPROFVIS_ASSERT_MSG_RETURN(object, ERROR_TABLE_ROW_CANNOT_BE_NULL, kRocProfVisDmResultInvalidParameter);
+    TableRow* table_row = (TableRow*) object;
+    TimedLock<std::unique_lock<std::shared_mutex>> lock(*table_row->Mutex(), __func__, table_row);
+    return table_row->AddCellValue(cell_value);
+}
+
+rocprofvis_dm_result_t Trace::AddTableRowCellDouble(const rocprofvis_dm_table_row_t object, double cell_value){
+    ROCPROFVIS_ASSERT_MSG_RETURN(object, ERROR_TABLE_ROW_CANNOT_BE_NULL, kRocProfVisDmResultInvalidParameter);
+    TableRow* table_row = (TableRow*) object;
+    TimedLock<std::unique_lock<std::shared_mutex>> lock(*table_row->Mutex(), __func__, table_row);
+    return table_row->AddCellValue(cell_value);
+}
+
 rocprofvis_dm_result_t Trace::CompleteSlice(const rocprofvis_dm_slice_t object)
 {
     ROCPROFVIS_ASSERT_MSG_RETURN(object, ERROR_SLICE_CANNOT_BE_NULL,
@@ -666,10 +733,11 @@ rocprofvis_dm_result_t Trace::CheckSliceExists(
                                  kRocProfVisDmResultInvalidParameter);
     Trace* trace = (Trace*) object;
     TimedLock<std::shared_lock<std::shared_mutex>> lock(*trace->Mutex(), __func__, trace);
-    // TODO: Change the interface to only accept a single track ID instead of array of track IDs.
-    // For now do a search for each of the passed in track IDs.
+    // Slice of a multi-track request exists only if it has been added to every track
+    std::vector<TrackSlice*> slices;
     for(int n = 0; n < num; n++)
     {
+        TrackSlice* found = nullptr;
         for(int i = 0; i < trace->m_tracks.size(); i++)
         {
             if(trace->m_tracks[i]->TrackId() == tracks[n])
@@ -681,17 +749,24 @@ rocprofvis_dm_result_t Trace::CheckSliceExists(
                 {
                     ROCPROFVIS_ASSERT_MSG_RETURN(slice_object, ERROR_SLICE_CANNOT_BE_NULL,
                                                     kRocProfVisDmResultUnknownError);
-                    TrackSlice* slice = (TrackSlice*) slice_object;
-                    lock.unlock();
-
-                    slice->WaitComplete();
-                    return kRocProfVisDmResultSuccess;
-
+                    found = (TrackSlice*) slice_object;
                 }
+                break;
             }
         }
+        if(found == nullptr)
+        {
+            return kRocProfVisDmResultNotLoaded;
+        }
+        slices.push_back(found);
     }
-    return kRocProfVisDmResultNotLoaded;
+    lock.unlock();
+
+    for(TrackSlice* slice : slices)
+    {
+        slice->WaitComplete();
+    }
+    return slices.empty() ? kRocProfVisDmResultNotLoaded : kRocProfVisDmResultSuccess;
 }
 
 rocprofvis_dm_result_t Trace::CheckEventPropertyExists(
@@ -704,49 +779,49 @@ rocprofvis_dm_result_t Trace::CheckEventPropertyExists(
     Trace* trace = (Trace*) object;
     TimedLock<std::shared_lock<std::shared_mutex>> lock(*trace->EventPropertyMutex(type), __func__, trace);
     switch(type)
+    {
+        case kRPVDMEventFlowTrace:
+            return trace->m_flow_traces.State(event_id.value);
+        case kRPVDMEventStackTrace:
+            return trace->m_stack_traces.State(event_id.value);
+        case kRPVDMEventExtData:
+            return trace->m_ext_data.State(event_id.value);
+    }
+    return kRocProfVisDmResultNotLoaded;
+}
+
+rocprofvis_dm_result_t Trace::CompleteEventProperty(
+                        const rocprofvis_dm_trace_t     object,
+                        const rocprofvis_dm_event_property_type_t type,
+                        const rocprofvis_dm_event_id_t event_id,
+                        bool success)
+{
+    ROCPROFVIS_ASSERT_MSG_RETURN(object, ERROR_TRACE_CANNOT_BE_NULL,
+                                 kRocProfVisDmResultInvalidParameter);
+    Trace* trace = (Trace*) object;
+    // Evicted objects are protected by their own mutexes and will be deleted outside the scope when mutexes are unlocked
+    switch(type)
     {
         case kRPVDMEventFlowTrace:
         {
-            
-            auto it = std::find_if(trace->m_flow_traces.begin(), trace->m_flow_traces.end(),
-                                      [&event_id](std::shared_ptr<FlowTrace>& x) {
-                                       return x.get()->EventId().value == event_id.value;
-                                   });
-            if(it != trace->m_flow_traces.end())
-            {
-                return kRocProfVisDmResultSuccess;
-            }
+            EventPropertyCache<FlowTrace>::released_list_t released;
+            TimedLock<std::unique_lock<std::shared_mutex>> lock(*trace->EventPropertyMutex(type), __func__, trace);
+            return trace->m_flow_traces.Complete(event_id.value, success, released);
         }
-        break;
         case kRPVDMEventStackTrace:
         {
-            auto it =
-                std::find_if(trace->m_stack_traces.begin(), trace->m_stack_traces.end(),
-                             [&event_id](std::shared_ptr<StackTrace>& x) {
-                                 return x.get()->EventId().value == event_id.value;
-                             });
-
-            if(it != trace->m_stack_traces.end())
-            {
-                return kRocProfVisDmResultSuccess;
-            }
+            EventPropertyCache<StackTrace>::released_list_t released;
+            TimedLock<std::unique_lock<std::shared_mutex>> lock(*trace->EventPropertyMutex(type), __func__, trace);
+            return trace->m_stack_traces.Complete(event_id.value, success, released);
         }
-        break;
         case kRPVDMEventExtData:
         {
-            auto it = std::find_if(trace->m_ext_data.begin(), trace->m_ext_data.end(),
-                                   [&event_id](std::shared_ptr<ExtData>& x) {
-                                 return x.get()->EventId().value == event_id.value;
-                             });
-
-            if(it != trace->m_ext_data.end())
-            {
-                return kRocProfVisDmResultSuccess;
-            }
+            EventPropertyCache<ExtData>::released_list_t released;
+            TimedLock<std::unique_lock<std::shared_mutex>> lock(*trace->EventPropertyMutex(type), __func__, trace);
+            return trace->m_ext_data.Complete(event_id.value, success, released);
         }
-        break;
     }
-    return kRocProfVisDmResultNotLoaded;
+    ROCPROFVIS_ASSERT_ALWAYS_MSG_RETURN(ERROR_UNSUPPORTED_PROPERTY, kRocProfVisDmResultNotSupported); 
 }
 
 rocprofvis_dm_result_t Trace::CheckTableExists(
@@ -817,7 +892,6 @@ rocprofvis_dm_result_t Trace::SearchStringIndices(rocprofvis_dm_num_string_table
 }
 
 rocprofvis_dm_result_t  Trace::GetPropertyAsUint64(rocprofvis_dm_property_t property, rocprofvis_dm_property_index_t index, uint64_t* value){
-    (void) index;
     ROCPROFVIS_ASSERT_MSG_RETURN(value, ERROR_REFERENCE_POINTER_CANNOT_BE_NULL, kRocProfVisDmResultInvalidParameter);
     switch(property)
     {
@@ -836,6 +910,16 @@ rocprofvis_dm_result_t  Trace::GetPropertyAsUint64(rocprofvis_dm_property_t prop
         case kRPVDMTraceMemoryFootprintUInt64:
             *value = GetMemoryFootprint();
             return kRocProfVisDmResultSuccess;
+        case kRPVDMTraceMemoryUsageUInt64Indexed:
+        {
+            uint64_t items = 0;
+            return GetMemoryUsage((rocprofvis_dm_memory_category_t)index, *value, items);
+        }
+        case kRPVDMTraceMemoryItemsUInt64Indexed:
+        {
+            uint64_t bytes = 0;
+            return GetMemoryUsage((rocprofvis_dm_memory_category_t)index, bytes, *value);
+        }
         case kRPVDMHistogramNumBuckets:
             *value = NumberOfHistogramBuckets();
             return kRocProfVisDmResultSuccess;
@@ -911,6 +995,10 @@ const char*  Trace::GetPropertySymbol(rocprofvis_dm_property_t property) {
             return "kRPVDMNumberOfTablesUInt64";
         case kRPVDMTraceMemoryFootprintUInt64:
             return "kRPVDMTraceMemoryFootprintUInt64";
+        case kRPVDMTraceMemoryUsageUInt64Indexed:
+            return "kRPVDMTraceMemoryUsageUInt64Indexed";
+        case kRPVDMTraceMemoryItemsUInt64Indexed:
+            return "kRPVDMTraceMemoryItemsUInt64Indexed";
         case kRPVDMTrackHandleIndexed:
             return "kRPVDMTrackHandleIndexed";
         case kRPVDMDatabaseHandle:
@@ -935,16 +1023,11 @@ const char*  Trace::GetPropertySymbol(rocprofvis_dm_property_t property) {
 
 
 rocprofvis_dm_result_t Trace::GetExtInfoHandle(rocprofvis_dm_event_id_t event_id, rocprofvis_dm_extdata_t & extinfo){
-    
     TimedLock<std::shared_lock<std::shared_mutex>> lock(*EventPropertyMutex(kRPVDMEventExtData), __func__, this);
-    auto it =
-        find_if(m_ext_data.begin(), m_ext_data.end(), 
-                        [&](std::shared_ptr<ExtData>& x) {
-        return x.get()->EventId().value == event_id.value;
-    });
-    if (it != m_ext_data.end())
+    ExtData* ext_data = m_ext_data.Touch(event_id.value);
+    if (ext_data != nullptr)
     {
-        extinfo = it->get();
+        extinfo = ext_data;
         return kRocProfVisDmResultSuccess;
     } 
     return kRocProfVisDmResultNotLoaded;
@@ -952,13 +1035,10 @@ rocprofvis_dm_result_t Trace::GetExtInfoHandle(rocprofvis_dm_event_id_t event_id
 
 rocprofvis_dm_result_t Trace::GetFlowTraceHandle(rocprofvis_dm_event_id_t event_id, rocprofvis_dm_flowtrace_t & flowtrace){
     TimedLock<std::shared_lock<std::shared_mutex>> lock(*EventPropertyMutex(kRPVDMEventFlowTrace), __func__, this);
-    auto it = find_if(m_flow_traces.begin(), m_flow_traces.end(),
-                      [&](std::shared_ptr<FlowTrace>& x) {
-        return x.get()->EventId().value == event_id.value;
-    });
-    if (it != m_flow_traces.end())
+    FlowTrace* flow_trace = m_flow_traces.Touch(event_id.value);
+    if (flow_trace != nullptr)
     {
-        flowtrace = it->get();
+        flowtrace = flow_trace;
         return kRocProfVisDmResultSuccess;
     } 
     return kRocProfVisDmResultNotLoaded;
@@ -966,13 +1046,10 @@ rocprofvis_dm_result_t Trace::GetFlowTraceHandle(rocprofvis_dm_event_id_t event_
 
 rocprofvis_dm_result_t Trace::GetStackTraceHandle(rocprofvis_dm_event_id_t event_id, rocprofvis_dm_stacktrace_t & stacktrace){
     TimedLock<std::shared_lock<std::shared_mutex>> lock(*EventPropertyMutex(kRPVDMEventStackTrace), __func__, this);
-    auto it = find_if(m_stack_traces.begin(), m_stack_traces.end(),
-                      [&](std::shared_ptr<StackTrace>& x) {
-        return x.get()->EventId().value == event_id.value;
-        });
-    if (it != m_stack_traces.end())
+    StackTrace* stack_trace = m_stack_traces.Touch(event_id.value);
+    if (stack_trace != nullptr)
     {
-        stacktrace = it->get();
+        stacktrace = stack_trace;
         return kRocProfVisDmResultSuccess;
     }
     return kRocProfVisDmResultNotLoaded;
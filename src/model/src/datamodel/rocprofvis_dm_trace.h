@@ -7,6 +7,7 @@
 #include "rocprofvis_dm_stack_trace.h"
 #include "rocprofvis_dm_track_slice.h"
 #include "rocprofvis_dm_ext_data.h"
+#include "rocprofvis_dm_event_property_cache.h"
 #include "rocprofvis_dm_track.h"
 #include "rocprofvis_dm_table.h"
 #include "rocprofvis_dm_topology.h"
@@ -83,6 +84,17 @@ class Trace : public DmBase{
         // @param object reference
         // @return status of operation 
         rocprofvis_dm_result_t                          DeleteEventProperty(rocprofvis_dm_event_property_type_t type, rocprofvis_dm_handle_t object);
+        // Method to pin flowtrace, stacktrace or extended data property object for event, so it is not evicted or deleted while in use
+        // @param type - property type (kEventFlowTrace, kEventStackTrace or kEventExtData)
+        // @param event_id - 60-bit event id and 4-bit operation type
+        // @param object - reference receiving object handle
+        // @return status of operation 
+        rocprofvis_dm_result_t                          PinEventProperty(rocprofvis_dm_event_property_type_t type, rocprofvis_dm_event_id_t event_id, rocprofvis_dm_handle_t & object);
+        // Method to release property object pinned with PinEventProperty
+        // @param type - property type (kEventFlowTrace, kEventStackTrace or kEventExtData)
+        // @param object - object handle
+        // @return status of operation 
+        rocprofvis_dm_result_t                          UnpinEventProperty(rocprofvis_dm_event_property_type_t type, rocprofvis_dm_handle_t object);
         // Method to delete flowtrace, stacktrace and extended data property objects for all events
         // @param type - property type (kEventFlowTrace, kEventStackTrace or kEventExtData)
         // @return status of operation 
@@ -153,6 +165,13 @@ class Trace : public DmBase{
         // Method to get amount of memory used by Trace object, includes memory footprint of all other data model objects
         // @return used memory size        
         rocprofvis_dm_size_t                            GetMemoryFootprint();
+        // Method to get amount of memory used by one category of data model objects.
+        // The caller holds Mutex() shared, event property categories take their own mutex
+        // @param category - memory category
+        // @param bytes - reference to used memory size
+        // @param items - reference to number of items in the category
+        // @return status of operation
+        rocprofvis_dm_result_t                          GetMemoryUsage(rocprofvis_dm_memory_category_t category, uint64_t & bytes, uint64_t & items);
         // Method to get the string ids of strings inside string table that match the passed in target strings
         // @param num - number of strings to search for
         // @param targets - array of strings to search for
@@ -265,6 +284,13 @@ class Trace : public DmBase{
         // @param cell_value - pointer to table value string
         // @return status of operation  
         static rocprofvis_dm_result_t                   AddTableRowCell(const rocprofvis_dm_table_row_t object, rocprofvis_dm_charptr_t cell_value);
+        // Static methods to add new numeric cell to table row object, formatted when read as string. Used by database component via binding interface
+        // @param object - table row object handle to add new cell to.
+        // @param cell_value - cell value
+        // @return status of operation  
+        static rocprofvis_dm_result_t                   AddTableRowCellUInt64(const rocprofvis_dm_table_row_t object, uint64_t cell_value);
+        static rocprofvis_dm_result_t                   AddTableRowCellInt64(const rocprofvis_dm_table_row_t object, int64_t cell_value);
+        static rocprofvis_dm_result_t                   AddTableRowCellDouble(const rocprofvis_dm_table_row_t object, double cell_value);
         // Static method to  add event level to a map array. Used by database component via binding interface
         // @param object - trace object handle to add new string to
         // @param event_id - 60-bit event id and 4-bit operation type
@@ -283,6 +309,13 @@ class Trace : public DmBase{
         static rocprofvis_dm_result_t                   CheckEventPropertyExists(const rocprofvis_dm_trace_t object, const rocprofvis_dm_event_property_type_t type, const rocprofvis_dm_event_id_t event_id);
         static rocprofvis_dm_result_t                   CheckTableExists(const rocprofvis_dm_trace_t object, const rocprofvis_dm_table_id_t table_id);
         static rocprofvis_dm_result_t                   CompleteSlice(const rocprofvis_dm_slice_t object);
+        // Static method to complete event property object loaded by calling thread. Used by database component via binding interface
+        // @param object - trace object handle
+        // @param type - type of property
+        // @param event_id - 60-bit event id and 4-bit operation type
+        // @param success - loading status, failed object is removed
+        // @return status of operation
+        static rocprofvis_dm_result_t                   CompleteEventProperty(const rocprofvis_dm_trace_t object, const rocprofvis_dm_event_property_type_t type, const rocprofvis_dm_event_id_t event_id, bool success);
         static rocprofvis_dm_result_t                   RemoveSlice(const rocprofvis_dm_trace_t trace, const rocprofvis_dm_track_id_t track_id, const rocprofvis_dm_slice_t object);
 
         void                                            BuildStringsOrderArray();
@@ -299,12 +332,12 @@ class Trace : public DmBase{
         rocprofvis_dm_database_t                        m_db;
         // vector array of Track objects
         std::vector<std::unique_ptr<Track>>             m_tracks;
-        // vector array of Flow trace objects
-        std::vector<std::shared_ptr<FlowTrace>>         m_flow_traces;
-        // vector array of Stack trace objects
-        std::vector<std::shared_ptr<StackTrace>>        m_stack_traces;
-        // vector array of Extended data objects
-        std::vector<std::shared_ptr<ExtData>>           m_ext_data;
+        // cache of Flow trace objects
+        EventPropertyCache<FlowTrace>                   m_flow_traces;
+        // cache of Stack trace objects
+        EventPropertyCache<StackTrace>                  m_stack_traces;
+        // cache of Extended data objects
+        EventPropertyCache<ExtData>                     m_ext_data;
         // vector array of Table objects
         std::vector<std::shared_ptr<Table>>             m_tables;
         // vector array of Table objects
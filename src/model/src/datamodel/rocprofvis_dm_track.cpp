@@ -157,6 +157,16 @@ rocprofvis_dm_size_t   Track::GetMemoryFootprint()
     return size;
 }
 
+rocprofvis_dm_size_t   Track::GetNumberOfLoadedRecords()
+{
+    rocprofvis_dm_size_t count = 0;
+    for (int i = 0; i < m_slices.size(); i++)
+    {
+        count+=m_slices[i].get()->GetNumberOfRecords();
+    }
+    return count;
+}
+
 
 rocprofvis_dm_charptr_t  Track::CategoryString(){
     switch(m_track_params->track_indentifiers.category)
@@ -233,6 +243,9 @@ rocprofvis_dm_result_t  Track::GetPropertyAsUint64(rocprofvis_dm_property_t prop
         case kRPVDMTrackMemoryFootprintUInt64:
             *value = GetMemoryFootprint();
             return kRocProfVisDmResultSuccess;
+        case kRPVDMTrackNumLoadedRecordsUInt64:
+            *value = GetNumberOfLoadedRecords();
+            return kRocProfVisDmResultSuccess;
         case kRPVDMTrackNumRecordsUInt64:
             *value = NumRecords();
             return kRocProfVisDmResultSuccess;
@@ -350,6 +363,8 @@ const char*  Track::GetPropertySymbol(rocprofvis_dm_property_t property) {
             return "kRPVDMNumberOfTrackExtDataRecordsUInt64";
         case kRPVDMTrackMemoryFootprintUInt64:
             return "kRPVDMTrackMemoryFootprintUInt64";
+        case kRPVDMTrackNumLoadedRecordsUInt64:
+            return "kRPVDMTrackNumLoadedRecordsUInt64";
         case kRPVDMTrackExtDataCategoryCharPtrIndexed:
             return "kRPVDMTrackExtDataCategoryCharPtrIndexed";
         case kRPVDMTrackExtDataNameCharPtrIndexed:
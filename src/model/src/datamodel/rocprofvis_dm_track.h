@@ -113,6 +113,9 @@ public:
     // Method to get amount of memory used by Track class object
     // @return used memory size
     rocprofvis_dm_size_t                                GetMemoryFootprint();
+    // Method to get number of records held by loaded slices
+    // @return number of records
+    rocprofvis_dm_size_t                                GetNumberOfLoadedRecords();
     // Method to read Track object property as uint64
     // @param property - property enumeration rocprofvis_dm_track_property_t
     // @param index - index of any indexed property
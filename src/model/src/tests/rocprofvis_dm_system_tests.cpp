@@ -2,16 +2,29 @@
 // SPDX-License-Identifier: MIT
 
 #include "rocprofvis_c_interface.h"
+#include "rocprofvis_db_cache.h"
 #include "rocprofvis_core.h"
+#include "rocprofvis_core_profile.h"
 #include "rocprofvis_db_future.h"
+#include "rocprofvis_db_query_telemetry.h"
+#include "rocprofvis_db_table_export.h"
+#include "rocprofvis_dm_base.h"
 #include "rocprofvis_error_handling.h"
 #include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <catch2/catch_session.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <cstdarg>
 #include <cstdio>
 #include <filesystem>
+#include <fstream>
+#include <map>
+#include <random>
+#include <set>
 #include <string.h>
+#include <thread>
+#include <tuple>
 #include <vector>
 
 #define MULTI_LINE_LOG_START auto multi_line_log = fmt::memory_buffer()
@@ -20,6 +33,7 @@
 #define MULTI_LINE_LOG_ARGS "{:.{}}", multi_line_log.data(), multi_line_log.size()
 
 std::string g_input_file = "sample/trace_70b_1024_32.rpd";
+std::string g_multi_file;
 bool        g_full_range = false;
 
 void
@@ -38,6 +52,8 @@ main(int argc, char** argv)
     using namespace Catch::Clara;
     auto cli = session.cli() |
                Opt(g_input_file, "input_file")["--input_file"]("Path to input file") |
+               Opt(g_multi_file, "multi_file")["--multi_file"](
+                   "Path to a multi-node index (.yaml) for the multi-file load test") |
                Opt(g_full_range, "full_range")["--full_range"](
                    "Whether to load/query the full trace range or only a segment");
 
@@ -224,6 +240,195 @@ DeleteSliceData(rocprofvis_dm_trace_t trace, rocprofvis_dm_timestamp_t start_tim
     rocprofvis_dm_delete_time_slice(trace, start_time, end_time);
 }
 
+struct FlowRangeEdge
+{
+    uint64_t origin_id;
+    uint64_t target_id;
+    uint64_t origin_track;
+    uint64_t target_track;
+    uint64_t start;
+    uint64_t end;
+
+    bool operator<(const FlowRangeEdge& other) const
+    {
+        return std::tie(origin_id, target_id) < std::tie(other.origin_id, other.target_id);
+    }
+    bool operator==(const FlowRangeEdge& other) const
+    {
+        return origin_id == other.origin_id && target_id == other.target_id;
+    }
+};
+
+// Reads the flow edges of a time range for the given tracks, sorted by endpoint ids.
+// Returns false when the database has no flow index.
+bool
+ReadFlowRange(rocprofvis_dm_trace_t trace, rocprofvis_dm_database_t db,
+              rocprofvis_dm_timestamp_t start_time, rocprofvis_dm_timestamp_t end_time,
+              std::vector<uint32_t> tracks, std::vector<FlowRangeEdge>& edges)
+{
+    edges.clear();
+    rocprofvis_db_future_t object2wait = rocprofvis_db_future_alloc(nullptr);
+    REQUIRE(nullptr != object2wait);
+    REQUIRE(kRocProfVisDmResultSuccess ==
+            rocprofvis_db_read_flow_range_async(
+                db, start_time, end_time, (rocprofvis_db_num_of_tracks_t) tracks.size(),
+                tracks.data(), object2wait));
+    rocprofvis_dm_result_t result = rocprofvis_db_future_wait(object2wait, UINT64_MAX);
+    rocprofvis_db_future_free(object2wait);
+    if(result == kRocProfVisDmResultNotSupported)
+    {
+        return false;
+    }
+    REQUIRE(kRocProfVisDmResultSuccess == result);
+
+    rocprofvis_dm_event_id_t range_id;
+    range_id.value = rocprofvis_dm_hash_combine_timestamp(
+        start_time, end_time, kRocProfVisDmHashedTimestampTagFlowRange);
+    rocprofvis_dm_flowtrace_t flowtrace = rocprofvis_dm_get_property_as_handle(
+        trace, kRPVDMFlowTraceHandleByEventID, range_id.value);
+    REQUIRE(nullptr != flowtrace);
+    uint64_t num_endpoints =
+        rocprofvis_dm_get_property_as_uint64(flowtrace, kRPVDMNumberOfEndpointsUInt64, 0);
+    REQUIRE(num_endpoints % 2 == 0);
+    for(uint64_t i = 0; i < num_endpoints; i += 2)
+    {
+        FlowRangeEdge edge;
+        edge.origin_id = rocprofvis_dm_get_property_as_uint64(
+            flowtrace, kRPVDMEndpointIDUInt64Indexed, i);
+        edge.target_id = rocprofvis_dm_get_property_as_uint64(
+            flowtrace, kRPVDMEndpointIDUInt64Indexed, i + 1);
+        edge.origin_track = rocprofvis_dm_get_property_as_uint64(
+            flowtrace, kRPVDMEndpointTrackIDUInt64Indexed, i);
+        edge.target_track = rocprofvis_dm_get_property_as_uint64(
+            flowtrace, kRPVDMEndpointTrackIDUInt64Indexed, i + 1);
+        edge.start = std::min(rocprofvis_dm_get_property_as_uint64(
+                                  flowtrace, kRPVDMEndpointTimestampUInt64Indexed, i),
+                              rocprofvis_dm_get_property_as_uint64(
+                                  flowtrace, kRPVDMEndpointTimestampUInt64Indexed, i + 1));
+        edge.end   = std::max(rocprofvis_dm_get_property_as_uint64(
+                                flowtrace, kRPVDMEndpointEndTimestampUInt64Indexed, i),
+                            rocprofvis_dm_get_property_as_uint64(
+                                flowtrace, kRPVDMEndpointEndTimestampUInt64Indexed, i + 1));
+        edges.push_back(edge);
+    }
+    rocprofvis_dm_delete_event_property(trace, kRPVDMEventFlowTrace, flowtrace);
+    std::sort(edges.begin(), edges.end());
+    return true;
+}
+
+struct KernelSummaryRow
+{
+    uint64_t count;
+    uint64_t total;
+    uint64_t min;
+    uint64_t max;
+
+    bool operator==(const KernelSummaryRow& other) const
+    {
+        return std::tie(count, total, min, max) ==
+               std::tie(other.count, other.total, other.min, other.max);
+    }
+};
+
+// Reads a kernel summary table into rows keyed by kernel name and deletes the table.
+void
+ReadKernelSummaryTable(rocprofvis_dm_trace_t trace, rocprofvis_dm_table_id_t table_id,
+                       std::map<std::string, KernelSummaryRow>& rows)
+{
+    rows.clear();
+    rocprofvis_dm_table_t table =
+        rocprofvis_dm_get_property_as_handle(trace, kRPVDMTableHandleByID, table_id);
+    REQUIRE(nullptr != table);
+    uint64_t num_columns =
+        rocprofvis_dm_get_property_as_uint64(table, kRPVDMNumberOfTableColumnsUInt64, 0);
+    uint64_t num_rows =
+        rocprofvis_dm_get_property_as_uint64(table, kRPVDMNumberOfTableRowsUInt64, 0);
+    std::map<std::string, uint64_t> columns;
+    for(uint64_t i = 0; i < num_columns; i++)
+    {
+        columns[rocprofvis_dm_get_property_as_charptr(
+            table, kRPVDMExtTableColumnNameCharPtrIndexed, i)] = i;
+    }
+    for(const char* column :
+        { "name", "num_invocations", "total_duration", "min_duration", "max_duration" })
+    {
+        REQUIRE(columns.count(column) == 1);
+    }
+    auto cell = [&](rocprofvis_dm_table_row_t row, const char* column) {
+        return rocprofvis_dm_get_property_as_charptr(
+            row, kRPVDMExtTableRowCellValueCharPtrIndexed, columns[column]);
+    };
+    auto number = [&](rocprofvis_dm_table_row_t row, const char* column) {
+        return (uint64_t) std::llround(strtod(cell(row, column), nullptr));
+    };
+    for(uint64_t i = 0; i < num_rows; i++)
+    {
+        rocprofvis_dm_table_row_t row =
+            rocprofvis_dm_get_property_as_handle(table, kRPVDMExtTableRowHandleIndexed, i);
+        REQUIRE(nullptr != row);
+        rows[cell(row, "name")] = { number(row, "num_invocations"),
+                                    number(row, "total_duration"),
+                                    number(row, "min_duration"),
+                                    number(row, "max_duration") };
+    }
+    rocprofvis_dm_delete_table_at(trace, table_id);
+}
+
+// Reads per-kernel statistics of a time range from the kernel statistics buckets.
+// Returns false when the database has no kernel statistics.
+bool
+ReadKernelSummary(rocprofvis_dm_trace_t trace, rocprofvis_dm_database_t db,
+                  rocprofvis_dm_timestamp_t start_time, rocprofvis_dm_timestamp_t end_time,
+                  std::map<std::string, KernelSummaryRow>& rows)
+{
+    rocprofvis_db_future_t object2wait = rocprofvis_db_future_alloc(nullptr);
+    REQUIRE(nullptr != object2wait);
+    rocprofvis_dm_table_id_t table_id = 0;
+    REQUIRE(kRocProfVisDmResultSuccess ==
+            rocprofvis_db_read_kernel_summary_async(db, start_time, end_time,
+                                                    KERNEL_SUMMARY_ANY_ID,
+                                                    KERNEL_SUMMARY_ANY_ID, object2wait,
+                                                    &table_id));
+    rocprofvis_dm_result_t result = rocprofvis_db_future_wait(object2wait, UINT64_MAX);
+    rocprofvis_db_future_free(object2wait);
+    if(result == kRocProfVisDmResultNotSupported)
+    {
+        return false;
+    }
+    REQUIRE(kRocProfVisDmResultSuccess == result);
+    ReadKernelSummaryTable(trace, table_id, rows);
+    return true;
+}
+
+// Reads the same per-kernel statistics with an aggregating query over all dispatches,
+// without the default row limit of table queries.
+void
+ReadKernelSummaryFromTable(rocprofvis_dm_trace_t trace, rocprofvis_dm_database_t db,
+                           rocprofvis_dm_timestamp_t start_time,
+                           rocprofvis_dm_timestamp_t end_time,
+                           std::map<std::string, KernelSummaryRow>& rows)
+{
+    uint32_t op[1] = { TABLE_QUERY_PACK_OP_TYPE(kRocProfVisDmOperationDispatch) };
+    char*    query = nullptr;
+    REQUIRE(kRocProfVisDmResultSuccess ==
+            rocprofvis_db_build_table_query(
+                db, kRPVDMTableUseCaseEventTrackTable, start_time, end_time, 1,
+                (rocprofvis_db_track_selection_t) op, nullptr, nullptr,
+                "name, COUNT(*) AS num_invocations, MIN(duration) AS min_duration, "
+                "MAX(duration) AS max_duration, SUM(duration) AS total_duration",
+                "name", "total_duration", kRPVDMSortOrderDesc, 1 << 30, 0, false, &query));
+    rocprofvis_db_future_t object2wait = rocprofvis_db_future_alloc(nullptr);
+    REQUIRE(nullptr != object2wait);
+    rocprofvis_dm_table_id_t table_id = 0;
+    REQUIRE(kRocProfVisDmResultSuccess ==
+            rocprofvis_db_execute_query_async(db, query, "Kernel summary reference",
+                                              object2wait, &table_id));
+    REQUIRE(kRocProfVisDmResultSuccess == rocprofvis_db_future_wait(object2wait, UINT64_MAX));
+    rocprofvis_db_future_free(object2wait);
+    free(query);
+    ReadKernelSummaryTable(trace, table_id, rows);
+}
+
 struct RocProfVisDMFixture
 {
     mutable rocprofvis_dm_trace_t           m_trace = nullptr;
@@ -950,6 +1155,65 @@ TEST_CASE_PERSISTENT_FIXTURE(RocProfVisDMFixture, "System Trace Data-Model Tests
                                     m_trace, kRPVDMEventExtData, dm_event_id);
                             }
                             rocprofvis_db_future_free(object2wait4extdata);
+
+                            spdlog::info("Testing concurrent reads and pinning of "
+                                         "extended data for event id = {}",
+                                         event_id);
+                            rocprofvis_db_future_t object2wait4first =
+                                rocprofvis_db_future_alloc(db_progress);
+                            rocprofvis_db_future_t object2wait4second =
+                                rocprofvis_db_future_alloc(db_progress);
+                            REQUIRE(object2wait4first);
+                            REQUIRE(object2wait4second);
+                            // second read of the same property waits for the first one
+                            REQUIRE(kRocProfVisDmResultSuccess ==
+                                    rocprofvis_db_read_event_property_async(
+                                        m_db, kRPVDMEventExtData, dm_event_id,
+                                        object2wait4first));
+                            REQUIRE(kRocProfVisDmResultSuccess ==
+                                    rocprofvis_db_read_event_property_async(
+                                        m_db, kRPVDMEventExtData, dm_event_id,
+                                        object2wait4second));
+                            REQUIRE(kRocProfVisDmResultSuccess ==
+                                    rocprofvis_db_future_wait(object2wait4second,
+                                                              UINT64_MAX));
+                            REQUIRE(kRocProfVisDmResultSuccess ==
+                                    rocprofvis_db_future_wait(object2wait4first,
+                                                              UINT64_MAX));
+                            rocprofvis_db_future_free(object2wait4first);
+                            rocprofvis_db_future_free(object2wait4second);
+
+                            rocprofvis_dm_extdata_t pinned = nullptr;
+                            REQUIRE(kRocProfVisDmResultSuccess ==
+                                    rocprofvis_dm_pin_event_property(
+                                        m_trace, kRPVDMEventExtData, dm_event_id,
+                                        &pinned));
+                            REQUIRE(pinned != nullptr);
+                            // pinned object is neither deleted nor cleared
+                            REQUIRE(kRocProfVisDmResultResourceBusy ==
+                                    rocprofvis_dm_delete_event_property_for(
+                                        m_trace, kRPVDMEventExtData, dm_event_id));
+                            REQUIRE(kRocProfVisDmResultResourceBusy ==
+                                    rocprofvis_dm_delete_event_property(
+                                        m_trace, kRPVDMEventExtData, pinned));
+                            rocprofvis_dm_delete_all_event_properties_for(
+                                m_trace, kRPVDMEventExtData);
+                            REQUIRE(rocprofvis_dm_get_property_as_handle(
+                                        m_trace, kRPVDMExtInfoHandleByEventID,
+                                        dm_event_id.value) == pinned);
+                            REQUIRE(kRocProfVisDmResultSuccess ==
+                                    rocprofvis_dm_unpin_event_property(
+                                        m_trace, kRPVDMEventExtData, pinned));
+                            REQUIRE(kRocProfVisDmResultNotLoaded ==
+                                    rocprofvis_dm_unpin_event_property(
+                                        m_trace, kRPVDMEventExtData, pinned));
+                            REQUIRE(kRocProfVisDmResultSuccess ==
+                                    rocprofvis_dm_delete_event_property_for(
+                                        m_trace, kRPVDMEventExtData, dm_event_id));
+                            REQUIRE(kRocProfVisDmResultNotLoaded ==
+                                    rocprofvis_dm_pin_event_property(
+                                        m_trace, kRPVDMEventExtData, dm_event_id,
+                                        &pinned));
                         }
                         else if(track_category ==
                                 rocprofvis_dm_track_category_t::kRocProfVisDmPmcTrack)
@@ -976,6 +1240,253 @@ TEST_CASE_PERSISTENT_FIXTURE(RocProfVisDMFixture, "System Trace Data-Model Tests
         }
     }
 
+    // Prefetches the properties of events collected from a time slice of the event
+    // tracks with a single request, then checks that extended data, flow trace and
+    // stack trace of every event are in the cache without any further read.
+    // Fixture Reads: m_trace, m_db, m_start_time, m_end_time
+    SECTION("Event Property Prefetch")
+    {
+        PrintHeader("Event Property Prefetch");
+        const rocprofvis_dm_event_property_type_t types[] = {
+            kRPVDMEventExtData, kRPVDMEventFlowTrace, kRPVDMEventStackTrace
+        };
+        std::vector<uint32_t> event_tracks;
+        uint64_t              num_tracks =
+            rocprofvis_dm_get_property_as_uint64(m_trace, kRPVDMNumberOfTracksUInt64, 0);
+        for(uint32_t i = 0; i < num_tracks; i++)
+        {
+            rocprofvis_dm_track_t track =
+                rocprofvis_dm_get_property_as_handle(m_trace, kRPVDMTrackHandleIndexed, i);
+            REQUIRE(track != nullptr);
+            rocprofvis_dm_track_category_t track_category =
+                (rocprofvis_dm_track_category_t) rocprofvis_dm_get_property_as_uint64(
+                    track, kRPVDMTrackCategoryEnumUInt64, 0);
+            if(track_category == kRocProfVisDmRegionTrack ||
+               track_category == kRocProfVisDmKernelDispatchTrack ||
+               track_category == kRocProfVisDmMemoryAllocationTrack ||
+               track_category == kRocProfVisDmMemoryCopyTrack)
+            {
+                event_tracks.push_back(i);
+            }
+        }
+        if(!event_tracks.empty())
+        {
+            std::vector<rocprofvis_dm_event_id_t> event_ids;
+            uint64_t hash_time = rocprofvis_dm_hash_combine_timestamp(
+                m_start_time, m_end_time, kRocProfVisDmHashedTimestampTagTrackSlice);
+            for(uint32_t track_index : event_tracks)
+            {
+                if(event_ids.size() >= 64) break;
+                rocprofvis_db_future_t slice_object = rocprofvis_db_future_alloc(db_progress);
+                REQUIRE(nullptr != slice_object);
+                REQUIRE(kRocProfVisDmResultSuccess ==
+                        rocprofvis_db_read_trace_slice_async(
+                            m_db, m_start_time, m_end_time,
+                            kRocProfVisDmHashedTimestampTagTrackSlice, 1, &track_index,
+                            slice_object));
+                REQUIRE(kRocProfVisDmResultSuccess ==
+                        rocprofvis_db_future_wait(slice_object, UINT64_MAX));
+                rocprofvis_db_future_free(slice_object);
+
+                rocprofvis_dm_track_t track = rocprofvis_dm_get_property_as_handle(
+                    m_trace, kRPVDMTrackHandleIndexed, track_index);
+                rocprofvis_dm_slice_t slice =
+                    rocprofvis_dm_get_property_as_handle(track, kRPVDMSliceHandleTimed, hash_time);
+                REQUIRE(slice != nullptr);
+                uint64_t num_records =
+                    rocprofvis_dm_get_property_as_uint64(slice, kRPVDMNumberOfRecordsUInt64, 0);
+                for(uint64_t j = 0; j < num_records && j < 8; j++)
+                {
+                    rocprofvis_dm_event_id_t dm_event_id;
+                    dm_event_id.value = rocprofvis_dm_get_property_as_uint64(
+                        slice, kRPVDMEventIdUInt64Indexed, j);
+                    event_ids.push_back(dm_event_id);
+                }
+            }
+            rocprofvis_dm_delete_all_time_slices(m_trace);
+            spdlog::info("Prefetch properties of {} events", event_ids.size());
+            REQUIRE(!event_ids.empty());
+
+            rocprofvis_db_future_t object2wait = rocprofvis_db_future_alloc(db_progress);
+            REQUIRE(nullptr != object2wait);
+
+            for(rocprofvis_dm_event_property_type_t type : types)
+            {
+                rocprofvis_dm_delete_all_event_properties_for(m_trace, type);
+            }
+            REQUIRE(kRocProfVisDmResultSuccess ==
+                    rocprofvis_db_read_event_properties_async(
+                        m_db, event_ids.size(), event_ids.data(), object2wait));
+            REQUIRE(kRocProfVisDmResultSuccess ==
+                    rocprofvis_db_future_wait(object2wait, UINT64_MAX));
+
+            std::vector<rocprofvis_dm_handle_t> properties;
+            for(const rocprofvis_dm_event_id_t& dm_event_id : event_ids)
+            {
+                for(rocprofvis_dm_event_property_type_t type : types)
+                {
+                    rocprofvis_dm_handle_t property = nullptr;
+                    REQUIRE(kRocProfVisDmResultSuccess ==
+                            rocprofvis_dm_pin_event_property(m_trace, type, dm_event_id,
+                                                             &property));
+                    REQUIRE(property != nullptr);
+                    properties.push_back(property);
+                    REQUIRE(kRocProfVisDmResultSuccess ==
+                            rocprofvis_dm_unpin_event_property(m_trace, type, property));
+                }
+            }
+
+            // cached properties are skipped, a second prefetch keeps the same objects
+            REQUIRE(kRocProfVisDmResultSuccess ==
+                    rocprofvis_db_read_event_properties_async(
+                        m_db, event_ids.size(), event_ids.data(), object2wait));
+            REQUIRE(kRocProfVisDmResultSuccess ==
+                    rocprofvis_db_future_wait(object2wait, UINT64_MAX));
+            size_t property_index = 0;
+            for(const rocprofvis_dm_event_id_t& dm_event_id : event_ids)
+            {
+                for(rocprofvis_dm_event_property_type_t type : types)
+                {
+                    rocprofvis_dm_handle_t property = nullptr;
+                    REQUIRE(kRocProfVisDmResultSuccess ==
+                            rocprofvis_dm_pin_event_property(m_trace, type, dm_event_id,
+                                                             &property));
+                    REQUIRE(property == properties[property_index++]);
+                    REQUIRE(kRocProfVisDmResultSuccess ==
+                            rocprofvis_dm_unpin_event_property(m_trace, type, property));
+                }
+            }
+
+            for(rocprofvis_dm_event_property_type_t type : types)
+            {
+                rocprofvis_dm_delete_all_event_properties_for(m_trace, type);
+            }
+            rocprofvis_db_future_free(object2wait);
+        }
+    }
+
+    // Reads flow edges by time range. Checks that every edge overlaps the range,
+    // that track filtered reads return each edge once and only for the requested
+    // tracks, and that the per-track reads add up to the unfiltered read.
+    // Skipped for databases without a flow index.
+    // Fixture Reads: m_trace, m_db
+    SECTION("Read Flow Range")
+    {
+        PrintHeader("Read flow range");
+        std::vector<FlowRangeEdge> all_edges;
+        if(!ReadFlowRange(m_trace, m_db, 0, UINT64_MAX, {}, all_edges))
+        {
+            spdlog::info("Flow index is not supported for this database");
+        }
+        else
+        {
+            spdlog::info("Trace has {} flow edges", all_edges.size());
+            REQUIRE(std::adjacent_find(all_edges.begin(), all_edges.end()) ==
+                    all_edges.end());
+
+            if(!all_edges.empty())
+            {
+                // Middle of the edge time span, so both halves of the search are used
+                uint64_t min_start = UINT64_MAX;
+                uint64_t max_end   = 0;
+                for(const FlowRangeEdge& edge : all_edges)
+                {
+                    min_start = std::min(min_start, edge.start);
+                    max_end   = std::max(max_end, edge.end);
+                }
+                uint64_t range_start = min_start + (max_end - min_start) / 3;
+                uint64_t range_end   = min_start + 2 * (max_end - min_start) / 3;
+                std::vector<FlowRangeEdge> range_edges;
+                REQUIRE(ReadFlowRange(m_trace, m_db, range_start, range_end, {},
+                                      range_edges));
+                size_t expected = 0;
+                for(const FlowRangeEdge& edge : all_edges)
+                {
+                    if(edge.start <= range_end && edge.end >= range_start) expected++;
+                }
+                REQUIRE(range_edges.size() == expected);
+                for(const FlowRangeEdge& edge : range_edges)
+                {
+                    REQUIRE(edge.start <= range_end);
+                    REQUIRE(edge.end >= range_start);
+                }
+
+                // An edge between two requested tracks is reported once
+                std::vector<FlowRangeEdge> pair_edges;
+                REQUIRE(ReadFlowRange(
+                    m_trace, m_db, 0, UINT64_MAX,
+                    { (uint32_t) all_edges[0].origin_track,
+                      (uint32_t) all_edges[0].target_track },
+                    pair_edges));
+                REQUIRE(std::binary_search(pair_edges.begin(), pair_edges.end(),
+                                           all_edges[0]));
+                REQUIRE(std::adjacent_find(pair_edges.begin(), pair_edges.end()) ==
+                        pair_edges.end());
+            }
+
+            std::vector<FlowRangeEdge> union_edges;
+            uint64_t                   num_tracks =
+                rocprofvis_dm_get_property_as_uint64(m_trace, kRPVDMNumberOfTracksUInt64, 0);
+            for(uint64_t i = 0; i < num_tracks; i++)
+            {
+                rocprofvis_dm_track_t track =
+                    rocprofvis_dm_get_property_as_handle(m_trace, kRPVDMTrackHandleIndexed, i);
+                REQUIRE(nullptr != track);
+                uint32_t track_id = (uint32_t) rocprofvis_dm_get_property_as_uint64(
+                    track, kRPVDMTrackIdUInt64, 0);
+                std::vector<FlowRangeEdge> track_edges;
+                REQUIRE(ReadFlowRange(m_trace, m_db, 0, UINT64_MAX, { track_id },
+                                      track_edges));
+                for(const FlowRangeEdge& edge : track_edges)
+                {
+                    REQUIRE((edge.origin_track == track_id || edge.target_track == track_id));
+                }
+                union_edges.insert(union_edges.end(), track_edges.begin(),
+                                   track_edges.end());
+            }
+            std::sort(union_edges.begin(), union_edges.end());
+            union_edges.erase(std::unique(union_edges.begin(), union_edges.end()),
+                              union_edges.end());
+            REQUIRE(union_edges == all_edges);
+        }
+    }
+
+    // Reads kernel summaries of the whole trace and of ranges whose edges fall inside
+    // statistics buckets, and compares them with an aggregating query over all dispatches.
+    // Skipped for databases without kernel statistics.
+    // Fixture Reads: m_trace, m_db, m_start_time, m_end_time
+    SECTION("Read Kernel Summary")
+    {
+        PrintHeader("Read kernel summary");
+        std::map<std::string, KernelSummaryRow> summary_rows;
+        if(!ReadKernelSummary(m_trace, m_db, m_start_time, m_end_time, summary_rows))
+        {
+            spdlog::info("Kernel statistics are not supported for this database");
+        }
+        else
+        {
+            rocprofvis_dm_timestamp_t span = m_end_time - m_start_time;
+            std::vector<std::pair<rocprofvis_dm_timestamp_t, rocprofvis_dm_timestamp_t>>
+                ranges = { { m_start_time, m_end_time },
+                           { m_start_time + span / 3 + 7, m_start_time + 2 * span / 3 + 13 },
+                           { m_start_time + span / 2, m_start_time + span / 2 + span / 1000 },
+                           { m_end_time - span / 7, m_end_time } };
+            for(auto& [start, end] : ranges)
+            {
+                std::map<std::string, KernelSummaryRow> table_rows;
+                REQUIRE(ReadKernelSummary(m_trace, m_db, start, end, summary_rows));
+                ReadKernelSummaryFromTable(m_trace, m_db, start, end, table_rows);
+                spdlog::info("Range [{}, {}] has {} kernels", start, end, table_rows.size());
+                REQUIRE(summary_rows.size() == table_rows.size());
+                for(auto& [name, row] : table_rows)
+                {
+                    REQUIRE(summary_rows.count(name) == 1);
+                    REQUIRE(summary_rows[name] == row);
+                }
+            }
+        }
+    }
+
     // Executes a SQL query against the database, validates the resulting table
     // has columns and rows, and prints the content.
     // Fixture Reads: m_trace, m_db
@@ -1066,6 +1577,31 @@ TEST_CASE_PERSISTENT_FIXTURE(RocProfVisDMFixture, "System Trace Data-Model Tests
                     }
                     spdlog::info(MULTI_LINE_LOG_ARGS);
                 }
+
+                // bulk row range read returns the same cells as the per cell getter
+                std::vector<std::vector<std::string>> bulk_rows(num_rows);
+                REQUIRE(rocprofvis_dm_get_table_cells(
+                            table, 0, num_rows,
+                            [](uint64_t row, uint64_t column, const char* value, void* user_data) {
+                                auto& rows = *(std::vector<std::vector<std::string>>*) user_data;
+                                REQUIRE(column == rows[row].size());
+                                rows[row].push_back(value);
+                            },
+                            &bulk_rows) == kRocProfVisDmResultSuccess);
+                for(int i = 0; i < num_rows; i++)
+                {
+                    rocprofvis_dm_table_row_t table_row = rocprofvis_dm_get_property_as_handle(
+                        table, kRPVDMExtTableRowHandleIndexed, i);
+                    REQUIRE(bulk_rows[i].size() ==
+                            rocprofvis_dm_get_property_as_uint64(
+                                table_row, kRPVDMNumberOfTableRowCellsUInt64, 0));
+                    for(int j = 0; j < bulk_rows[i].size(); j++)
+                    {
+                        REQUIRE(bulk_rows[i][j] ==
+                                rocprofvis_dm_get_property_as_charptr(
+                                    table_row, kRPVDMExtTableRowCellValueCharPtrIndexed, j));
+                    }
+                }
                 rocprofvis_dm_delete_all_tables(m_trace);
             }
         }
@@ -1182,6 +1718,89 @@ TEST_CASE_PERSISTENT_FIXTURE(RocProfVisDMFixture, "System Trace Data-Model Tests
         rocprofvis_db_future_free(object2wait);
     }
 
+    // Exports an ungrouped, filtered and sorted table query over two operations, which
+    // streams rows of every sub-query straight to the file, and checks the file has as
+    // many rows as the record count of the same query.
+    // Fixture Reads: m_trace, m_db, m_start_time, m_end_time
+    SECTION("Table Streamed Export")
+    {
+        CheckMemoryFootprint(m_trace);
+
+        uint32_t op[2] = { TABLE_QUERY_PACK_OP_TYPE(kRocProfVisDmOperationLaunch),
+                           TABLE_QUERY_PACK_OP_TYPE(kRocProfVisDmOperationDispatch) };
+        char*    query = nullptr;
+        rocprofvis_dm_result_t build_result = rocprofvis_db_build_table_query(
+            m_db, kRPVDMTableUseCaseEventTrackTable, m_start_time, m_end_time, 2,
+            (rocprofvis_db_track_selection_t) op, nullptr, "duration > 1000", nullptr, nullptr,
+            "duration", kRPVDMSortOrderAsc, 0, 0, false, &query);
+        REQUIRE(kRocProfVisDmResultSuccess == build_result);
+        REQUIRE(query != nullptr);
+        char* count_query = nullptr;
+        build_result      = rocprofvis_db_build_table_query(
+            m_db, kRPVDMTableUseCaseEventTrackTable, m_start_time, m_end_time, 2,
+            (rocprofvis_db_track_selection_t) op, nullptr, "duration > 1000", nullptr, nullptr,
+            "duration", kRPVDMSortOrderAsc, 0, 0, true, &count_query);
+        REQUIRE(kRocProfVisDmResultSuccess == build_result);
+        REQUIRE(count_query != nullptr);
+
+        rocprofvis_db_future_t object2wait = rocprofvis_db_future_alloc(db_progress);
+        REQUIRE(nullptr != object2wait);
+        rocprofvis_dm_table_id_t table_id = 0;
+        REQUIRE(kRocProfVisDmResultSuccess ==
+                rocprofvis_db_execute_query_async(m_db, count_query, "Streamed export count",
+                                                  object2wait, &table_id));
+        REQUIRE(kRocProfVisDmResultSuccess ==
+                rocprofvis_db_future_wait(object2wait, UINT64_MAX));
+        rocprofvis_dm_table_t table =
+            rocprofvis_dm_get_property_as_handle(m_trace, kRPVDMTableHandleByID, table_id);
+        REQUIRE(table != nullptr);
+        REQUIRE(std::string("NumRecords") ==
+                rocprofvis_dm_get_property_as_charptr(
+                    table, kRPVDMExtTableColumnNameCharPtrIndexed, 0));
+        rocprofvis_dm_table_row_t count_row =
+            rocprofvis_dm_get_property_as_handle(table, kRPVDMExtTableRowHandleIndexed, 0);
+        REQUIRE(count_row != nullptr);
+        uint64_t num_rows = std::stoull(rocprofvis_dm_get_property_as_charptr(
+            count_row, kRPVDMExtTableRowCellValueCharPtrIndexed, 0));
+        rocprofvis_dm_delete_all_tables(m_trace);
+        rocprofvis_db_future_free(object2wait);
+        free(count_query);
+
+        const char* csv_path = "sample/test_streamed_export.csv";
+        object2wait          = rocprofvis_db_future_alloc(db_progress);
+        REQUIRE(nullptr != object2wait);
+        REQUIRE(kRocProfVisDmResultSuccess ==
+                rocprofvis_db_export_table_csv_async(m_db, query, csv_path, object2wait));
+        REQUIRE(kRocProfVisDmResultSuccess ==
+                rocprofvis_db_future_wait(object2wait, UINT64_MAX));
+
+        std::ifstream file(csv_path);
+        REQUIRE(file.is_open());
+        std::string line;
+        REQUIRE(std::getline(file, line));
+        REQUIRE(line.find("duration") != std::string::npos);
+        uint64_t num_lines = 0;
+        while(std::getline(file, line))
+        {
+            num_lines++;
+        }
+        file.close();
+        spdlog::info(ANSI_COLOR_GREEN "Streamed export rows: {}, records: {}", num_lines,
+                     num_rows);
+        REQUIRE(num_lines == num_rows);
+
+        // Temporary files of sub-queries flushed before the output was opened are removed
+        for(const auto& entry : std::filesystem::directory_iterator("sample"))
+        {
+            REQUIRE(entry.path().filename().string().find("test_streamed_export.csv.") ==
+                    std::string::npos);
+        }
+
+        std::filesystem::remove(csv_path);
+        free(query);
+        rocprofvis_db_future_free(object2wait);
+    }
+
     // Stress-tests concurrent read and delete operations on time slices across
     // multiple iterations to validate thread safety.
     // Fixture Reads:  m_trace, m_db, m_start_time, m_end_time, m_num_tracks
@@ -1263,3 +1882,670 @@ TEST_CASE_PERSISTENT_FIXTURE(RocProfVisDMFixture, "System Trace Data-Model Tests
         rocprofvis_dm_delete_trace(m_trace);
     }
 }
+
+// Keeps rows handed over by ExportRunSorter
+class CaptureExportWriter : public RocProfVis::DataModel::ExportWriter
+{
+public:
+    bool Open(const char*, const std::vector<RocProfVis::DataModel::ExportColumn>&) override
+    {
+        return true;
+    }
+    bool WriteRow(const RocProfVis::DataModel::ExportRow& row) override
+    {
+        rows.push_back(row);
+        return true;
+    }
+    bool Close() override { return true; }
+
+    std::vector<RocProfVis::DataModel::ExportRow> rows;
+};
+
+template <typename T>
+T
+ReadColumnarValue(std::ifstream& file)
+{
+    T value{};
+    file.read((char*) &value, sizeof(value));
+    return value;
+}
+
+TEST_CASE("Table Export Writers")
+{
+    using namespace RocProfVis::DataModel;
+    std::filesystem::path temp_dir = std::filesystem::temp_directory_path();
+
+    // Sorts rows through many spilled runs, more than one merge pass can take.
+    // Checks key order, that rows with equal keys keep their input order and that
+    // run files are removed.
+    SECTION("External Sort")
+    {
+        const uint64_t num_rows = 20000;
+        std::string    prefix   = (temp_dir / "rocprofvis_export_sort_test").string();
+        for(bool ascending : { true, false })
+        {
+            CaptureExportWriter writer;
+            {
+                // Tiny budget, every run holds a few dozen rows
+                ExportRunSorter sorter(prefix, false, ascending, 4096);
+                for(uint64_t i = 0; i < num_rows; i++)
+                {
+                    ExportRow row;
+                    row.sort_key.data.u64 = (i * 7919) % 1000;
+                    row.cells.resize(2);
+                    row.cells[0].type           = ExportCellType::UInt64;
+                    row.cells[0].value.data.u64 = i;
+                    row.cells[1].type           = ExportCellType::QuotedString;
+                    row.cells[1].text           = "row " + std::to_string(i);
+                    REQUIRE(sorter.Add(std::move(row)));
+                }
+                REQUIRE(sorter.Finish(writer));
+            }
+            REQUIRE(writer.rows.size() == num_rows);
+            for(size_t i = 1; i < writer.rows.size(); i++)
+            {
+                const ExportRow& prev = writer.rows[i - 1];
+                const ExportRow& row  = writer.rows[i];
+                REQUIRE(row.cells.size() == 2);
+                REQUIRE(row.cells[1].text ==
+                        "row " + std::to_string(row.cells[0].value.data.u64));
+                if(prev.sort_key.data.u64 == row.sort_key.data.u64)
+                {
+                    REQUIRE(prev.cells[0].value.data.u64 < row.cells[0].value.data.u64);
+                }
+                else
+                {
+                    REQUIRE((prev.sort_key.data.u64 < row.sort_key.data.u64) == ascending);
+                }
+            }
+            for(const auto& entry : std::filesystem::directory_iterator(temp_dir))
+            {
+                REQUIRE(entry.path().filename().string().rfind(
+                            "rocprofvis_export_sort_test.run", 0) != 0);
+            }
+        }
+
+        // Rows that fit the budget are sorted in memory, double keys
+        CaptureExportWriter writer;
+        ExportRunSorter     sorter(prefix, true, false);
+        for(double key : { 0.5, -2.0, 3.25, 0.5 })
+        {
+            ExportRow row;
+            row.sort_key.data.d = key;
+            REQUIRE(sorter.Add(std::move(row)));
+        }
+        REQUIRE(sorter.Finish(writer));
+        REQUIRE(writer.rows.size() == 4);
+        REQUIRE(writer.rows[0].sort_key.data.d == 3.25);
+        REQUIRE(writer.rows[3].sort_key.data.d == -2.0);
+    }
+
+    // Writes two row groups and reads them back following the layout documented
+    // in rocprofvis_db_table_export.h.
+    SECTION("Columnar Writer")
+    {
+        std::string path = (temp_dir / "rocprofvis_export_test.rpvc").string();
+        std::unique_ptr<ExportWriter> writer = ExportWriter::Create(path.c_str());
+        REQUIRE(dynamic_cast<ColumnarExportWriter*>(writer.get()) != nullptr);
+        std::vector<ExportColumn> columns = { { "id", ExportCellType::UInt64 },
+                                              { "value", ExportCellType::Double },
+                                              { "name", ExportCellType::QuotedString } };
+        REQUIRE(writer->Open(path.c_str(), columns));
+        const uint64_t num_rows = ColumnarExportWriter::ROW_GROUP_SIZE + 10;
+        for(uint64_t i = 0; i < num_rows; i++)
+        {
+            ExportRow row;
+            row.cells.resize(3);
+            row.cells[0].type           = ExportCellType::UInt64;
+            row.cells[0].value.data.u64 = i;
+            row.cells[1].type           = ExportCellType::Double;
+            row.cells[1].value.data.d   = i * 0.5;
+            // Every 7th name is left empty
+            if(i % 7 != 0)
+            {
+                row.cells[2].type = ExportCellType::QuotedString;
+                row.cells[2].text = "kernel_" + std::to_string(i);
+            }
+            REQUIRE(writer->WriteRow(row));
+        }
+        REQUIRE(writer->Close());
+
+        std::ifstream file(path, std::ios::in | std::ios::binary);
+        REQUIRE(file.is_open());
+        char magic[8];
+        file.read(magic, sizeof(magic));
+        REQUIRE(std::string(magic, sizeof(magic)) == ColumnarExportWriter::MAGIC);
+        REQUIRE(ReadColumnarValue<uint32_t>(file) == columns.size());
+        const uint8_t expected_types[] = { 1, 2, 3 };
+        for(size_t c = 0; c < columns.size(); c++)
+        {
+            uint32_t    name_length = ReadColumnarValue<uint32_t>(file);
+            std::string name(name_length, '\0');
+            file.read(name.data(), name_length);
+            REQUIRE(name == columns[c].name);
+            REQUIRE(ReadColumnarValue<uint8_t>(file) == expected_types[c]);
+        }
+
+        uint64_t first_row = 0;
+        for(uint64_t group_rows : { (uint64_t) ColumnarExportWriter::ROW_GROUP_SIZE,
+                                    (uint64_t) 10 })
+        {
+            REQUIRE(ReadColumnarValue<uint64_t>(file) == group_rows);
+            std::vector<uint64_t> ids(group_rows);
+            std::vector<double>   values(group_rows);
+            std::vector<uint64_t> offsets(group_rows + 1);
+            file.read((char*) ids.data(), group_rows * sizeof(uint64_t));
+            file.read((char*) values.data(), group_rows * sizeof(double));
+            file.read((char*) offsets.data(), offsets.size() * sizeof(uint64_t));
+            REQUIRE(offsets[0] == 0);
+            std::string chars(offsets.back(), '\0');
+            file.read(chars.data(), chars.size());
+            REQUIRE(file.good());
+            for(uint64_t r = 0; r < group_rows; r++)
+            {
+                uint64_t i = first_row + r;
+                REQUIRE(ids[r] == i);
+                REQUIRE(values[r] == i * 0.5);
+                std::string name = chars.substr(offsets[r], offsets[r + 1] - offsets[r]);
+                REQUIRE(name == (i % 7 != 0 ? "kernel_" + std::to_string(i) : ""));
+            }
+            first_row += group_rows;
+        }
+        REQUIRE(ReadColumnarValue<uint64_t>(file) == 0);
+        file.close();
+        std::filesystem::remove(path);
+    }
+}
+
+TEST_CASE("Query Telemetry")
+{
+    using namespace RocProfVis::DataModel;
+
+    // Literals become '?', literal lists collapse and whitespace is normalized.
+    // Digits inside identifiers and quoted identifiers are kept.
+    SECTION("Templates")
+    {
+        REQUIRE(QueryTelemetry::MakeTemplate("SELECT  *\n FROM t1 WHERE id = 42 AND name = 'it''s';") ==
+                "SELECT * FROM t1 WHERE id = ? AND name = ?;");
+        REQUIRE(QueryTelemetry::MakeTemplate("select a from b where c in (1, 2, 3.5)") ==
+                "select a from b where c in (?)");
+        REQUIRE(QueryTelemetry::MakeTemplate("select \"col 7\" from [t 2] limit 10") ==
+                "select \"col 7\" from [t 2] limit ?");
+        REQUIRE(QueryTelemetry::MakeTemplate(nullptr).empty());
+    }
+
+    // Statistics are kept per template and connection. The plan is requested on the
+    // first successful execution only, failures are counted and always logged.
+    SECTION("Record")
+    {
+        QueryTelemetry telemetry;
+        telemetry.SetSlowQueryThreshold(0);
+        const std::string query_template = QueryTelemetry::MakeTemplate("select 1");
+
+        // A failed first execution does not capture the plan
+        REQUIRE(!telemetry.Record(query_template, "select 1", "trace.db#0", 3.0, 0, 0,
+                                  "no such table"));
+        REQUIRE(telemetry.Record(query_template, "select 1", "trace.db#0", 1.0, 1, 8));
+        REQUIRE(!telemetry.Record(query_template, "select 2", "trace.db#0", 2.0, 1, 8));
+        // Another connection is a separate entry with its own plan
+        REQUIRE(telemetry.Record(query_template, "select 3", "trace.db#1", 10.0, 2, 16));
+        telemetry.SetPlan(query_template, "trace.db#0", "SCAN t");
+
+        std::vector<QueryTelemetry::QueryStats> stats = telemetry.GetStats();
+        REQUIRE(stats.size() == 2);
+        // Ordered by total time descending
+        REQUIRE(stats[0].connection == "trace.db#1");
+        REQUIRE(stats[0].count == 1);
+        REQUIRE(stats[0].failures == 0);
+        REQUIRE(stats[0].plan.empty());
+        REQUIRE(stats[1].connection == "trace.db#0");
+        REQUIRE(stats[1].query_template == query_template);
+        REQUIRE(stats[1].count == 3);
+        REQUIRE(stats[1].failures == 1);
+        REQUIRE(stats[1].total_ms == 6.0);
+        REQUIRE(stats[1].max_ms == 3.0);
+        REQUIRE(stats[1].rows == 2);
+        REQUIRE(stats[1].bytes == 16);
+        REQUIRE(stats[1].plan == "SCAN t");
+
+        // Threshold 0 logs the failure only
+        std::vector<QueryTelemetry::SlowQuery> logged = telemetry.GetSlowQueries();
+        REQUIRE(logged.size() == 1);
+        REQUIRE(logged[0].query == "select 1");
+        REQUIRE(logged[0].connection == "trace.db#0");
+        REQUIRE(logged[0].error == "no such table");
+
+        telemetry.Clear();
+        REQUIRE(telemetry.GetStats().empty());
+        REQUIRE(telemetry.GetSlowQueries().empty());
+    }
+
+    // Executions at or above the threshold are logged without an error, the log keeps
+    // the newest entries.
+    SECTION("Slow Query Log")
+    {
+        QueryTelemetry telemetry;
+        telemetry.SetSlowQueryThreshold(5.0);
+        telemetry.Record("select ?", "select 1", "trace.db#0", 4.9, 0, 0);
+        REQUIRE(telemetry.GetSlowQueries().empty());
+        for(size_t i = 0; i < QueryTelemetry::SLOW_QUERY_LOG_SIZE + 3; i++)
+        {
+            telemetry.Record("select ?", ("select " + std::to_string(i)).c_str(),
+                             "trace.db#0", 5.0, 0, 0);
+        }
+        std::vector<QueryTelemetry::SlowQuery> logged = telemetry.GetSlowQueries();
+        REQUIRE(logged.size() == QueryTelemetry::SLOW_QUERY_LOG_SIZE);
+        REQUIRE(logged.front().query == "select 3");
+        REQUIRE(logged.back().query ==
+                "select " + std::to_string(QueryTelemetry::SLOW_QUERY_LOG_SIZE + 2));
+        REQUIRE(logged.back().error.empty());
+    }
+}
+
+TEST_CASE("Lock Statistics")
+{
+    using namespace RocProfVis::DataModel;
+    typedef TimedLock<std::unique_lock<std::shared_mutex>> ExclusiveLock;
+    typedef TimedLock<std::shared_lock<std::shared_mutex>> SharedLock;
+
+    // Two call sites with the same name: sites are keyed by the __func__ address
+    static const char read_site[]       = "ReadEvents";
+    static const char other_read_site[] = "ReadEvents";
+    std::shared_mutex mutex;
+
+    auto find_site = [](std::vector<LockStats::SiteStats> const& stats,
+                        const char* function, bool shared, uint64_t count) {
+        return std::count_if(stats.begin(), stats.end(), [&](LockStats::SiteStats const& s) {
+            return s.function == function && s.shared == shared && s.count == count;
+        });
+    };
+
+    // Nothing is recorded until statistics are enabled
+    SECTION("Disabled By Default")
+    {
+        REQUIRE(!LockStats::IsEnabled());
+        LockStats::Reset();
+        {
+            ExclusiveLock lock(mutex, read_site, nullptr);
+        }
+        REQUIRE(LockStats::Snapshot().empty());
+    }
+
+    // Every thread records into its own counters. Snapshot sums running threads and
+    // threads which already exited, Reset drops both.
+    SECTION("Per Thread Accumulation")
+    {
+        constexpr int NUM_THREADS = 4;
+        constexpr int NUM_LOCKS   = 1000;
+        LockStats::SetEnabled(true);
+        LockStats::Reset();
+
+        std::atomic<int>         num_done(0);
+        std::atomic<bool>        exit_threads(false);
+        std::vector<std::thread> threads;
+        for(int t = 0; t < NUM_THREADS; t++)
+        {
+            threads.emplace_back([&]() {
+                for(int i = 0; i < NUM_LOCKS; i++)
+                {
+                    ExclusiveLock lock(mutex, read_site, nullptr);
+                }
+                {
+                    SharedLock lock(mutex, read_site, nullptr);
+                }
+                num_done++;
+                while(!exit_threads)
+                {
+                    std::this_thread::yield();
+                }
+            });
+        }
+        {
+            ExclusiveLock lock(mutex, other_read_site, nullptr);
+        }
+        while(num_done < NUM_THREADS)
+        {
+            std::this_thread::yield();
+        }
+
+        auto check = [&](std::vector<LockStats::SiteStats> const& stats) {
+            REQUIRE(stats.size() == 3);
+            REQUIRE(find_site(stats, read_site, false, NUM_THREADS * NUM_LOCKS) == 1);
+            REQUIRE(find_site(stats, read_site, true, NUM_THREADS) == 1);
+            REQUIRE(find_site(stats, other_read_site, false, 1) == 1);
+            for(LockStats::SiteStats const& site : stats)
+            {
+                uint64_t waits = 0;
+                uint64_t holds = 0;
+                for(uint32_t b = 0; b < LockStats::NUM_BUCKETS; b++)
+                {
+                    waits += site.wait_histogram[b];
+                    holds += site.hold_histogram[b];
+                }
+                REQUIRE(site.owner_class.empty());
+                REQUIRE(waits == site.count);
+                REQUIRE(holds == site.count);
+                REQUIRE(site.contended <= site.count);
+                REQUIRE(site.max_wait_ns <= site.total_wait_ns);
+                REQUIRE(site.max_hold_ns <= site.total_hold_ns);
+            }
+            REQUIRE(stats.front().total_wait_ns >= stats.back().total_wait_ns);
+        };
+        check(LockStats::Snapshot());
+
+        exit_threads = true;
+        for(std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        check(LockStats::Snapshot());
+
+        LockStats::Reset();
+        REQUIRE(LockStats::Snapshot().empty());
+        {
+            ExclusiveLock lock(mutex, read_site, nullptr);
+        }
+        std::vector<LockStats::SiteStats> stats = LockStats::Snapshot();
+        REQUIRE(stats.size() == 1);
+        REQUIRE(find_site(stats, read_site, false, 1) == 1);
+
+        LockStats::SetEnabled(false);
+        {
+            ExclusiveLock lock(mutex, read_site, nullptr);
+        }
+        REQUIRE(find_site(LockStats::Snapshot(), read_site, false, 1) == 1);
+        LockStats::Reset();
+    }
+}
+
+// Number of occurrences of pattern in the file at path
+size_t
+CountInFile(const std::string& path, const std::string& pattern)
+{
+    std::ifstream file(path, std::ios::binary);
+    std::string   text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    size_t        count = 0;
+    for(size_t pos = text.find(pattern); pos != std::string::npos;
+        pos        = text.find(pattern, pos + pattern.size()))
+    {
+        count++;
+    }
+    return count;
+}
+
+TEST_CASE("Self Profiling")
+{
+    using RocProfVis::Core::Profiler;
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "rocprofvis_self_profile_test.json").string();
+
+    Profiler::SetEnabled(true);
+    Profiler::Clear();
+    // Running threads of earlier tests, e.g. named job workers, keep their buffers
+    REQUIRE(Profiler::ExportChromeTrace(path));
+    const size_t num_buffers = CountInFile(path, "\"ph\":\"M\"");
+
+    // Threads started one after the other reuse the buffer of the exited thread
+    constexpr int NUM_THREADS = 50;
+    for(int i = 0; i < NUM_THREADS; i++)
+    {
+        std::thread([] { PROFILE_ZONE("test", "Short lived thread"); }).join();
+    }
+    REQUIRE(Profiler::ExportChromeTrace(path));
+    REQUIRE(CountInFile(path, "\"ph\":\"M\"") == num_buffers + 1);
+    REQUIRE(CountInFile(path, "\"Short lived thread\"") == NUM_THREADS);
+
+    // Running threads each hold a buffer
+    constexpr int            NUM_RUNNING = 4;
+    std::atomic<int>         num_recorded(0);
+    std::vector<std::thread> threads;
+    for(int i = 0; i < NUM_RUNNING; i++)
+    {
+        threads.emplace_back([&num_recorded] {
+            {
+                PROFILE_ZONE("test", "Running thread");
+            }
+            num_recorded++;
+            while(num_recorded < NUM_RUNNING)
+            {
+                std::this_thread::yield();
+            }
+        });
+    }
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    REQUIRE(Profiler::ExportChromeTrace(path));
+    REQUIRE(CountInFile(path, "\"ph\":\"M\"") == num_buffers + NUM_RUNNING);
+
+    // Clear releases the buffers of exited threads
+    Profiler::Clear();
+    REQUIRE(Profiler::ExportChromeTrace(path));
+    REQUIRE(CountInFile(path, "\"ph\":\"M\"") == num_buffers);
+
+    Profiler::SetEnabled(false);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Table Cache")
+{
+    using namespace RocProfVis::DataModel;
+
+    // Names and ids resolve to indices once, unknown ones give INVALID_INDEX
+    // and read as empty cells.
+    SECTION("Lookups")
+    {
+        TableCache table;
+        REQUIRE(table.AddColumn("id", kRPVDataTypeInt) == 0);
+        REQUIRE(table.AddColumn("name", kRPVDataTypeString) == 1);
+        REQUIRE(table.AddColumn("id", kRPVDataTypeInt) == 0);
+        table.AddCell(0, 7, "42");
+        table.AddCell(1, 7, "gpu");
+        table.AddCell(1, 3, "cpu");
+
+        REQUIRE(table.NumColumns() == 2);
+        REQUIRE(table.NumRows() == 2);
+        REQUIRE(table.FindColumn("name") == 1);
+        REQUIRE(table.FindColumn("missing") == INVALID_INDEX);
+        REQUIRE(table.FindRow(7) == 0);
+        REQUIRE(table.FindRow(3) == 1);
+        REQUIRE(table.FindRow(5) == INVALID_INDEX);
+        REQUIRE(std::string(table.GetColumnName(1)) == "name");
+        REQUIRE(table.GetColumnType(0) == kRPVDataTypeInt);
+        REQUIRE(table.GetColumnType(2) == kRPVDataTypeNull);
+
+        REQUIRE(std::string(table.GetCell(7, "name")) == "gpu");
+        REQUIRE(std::string(table.GetCellByIndex(1, "name")) == "cpu");
+        REQUIRE(std::string(table.GetCell(5, "name")).empty());
+        REQUIRE(std::string(table.GetCell(uint64_t(0), table.FindColumn("missing"))).empty());
+        // Row 3 never set the integer column
+        REQUIRE(std::string(table.GetCell(uint64_t(1), uint32_t(0))).empty());
+
+        REQUIRE(table.GetCellInt(0, 0) == 42);
+        REQUIRE(table.GetCellInt(1, 0) == 0);
+        // String columns are parsed on read
+        table.AddCell(1, 3, "-12");
+        REQUIRE(table.GetCellInt(1, 1) == -12);
+        REQUIRE(table.GetCellInt(INVALID_INDEX, 0) == 0);
+        REQUIRE(table.GetCellInt(0, INVALID_INDEX) == 0);
+
+        const TableCache::Row* row = (const TableCache::Row*) table.GetRow(1);
+        REQUIRE(row != nullptr);
+        REQUIRE(row->id == 3);
+        REQUIRE(row->table == &table);
+        REQUIRE(std::string(table.GetRowCell(row, 1)) == "-12");
+        REQUIRE(table.GetRow(2) == nullptr);
+    }
+
+    // Equal cell values and column names share one string pool entry.
+    SECTION("Interning")
+    {
+        TableCache table;
+        uint32_t type  = table.AddColumn("type", kRPVDataTypeString);
+        uint32_t other = table.AddColumn("other", kRPVDataTypeString);
+        std::string value = "N/A";
+        table.AddCell(type, 1, value.c_str());
+        value = "N/A";
+        table.AddCell(type, 2, value.c_str());
+        table.AddCell(other, 2, "N/A");
+        table.AddCell(other, 3, "type");
+        table.AddCell(type, 3, nullptr);
+
+        REQUIRE(table.GetCell(uint64_t(0), type) == table.GetCell(uint64_t(1), type));
+        REQUIRE(table.GetCell(uint64_t(0), type) == table.GetCell(uint64_t(1), other));
+        REQUIRE(table.GetCell(uint64_t(2), other) == table.GetColumnName(type));
+        // Null and never set cells are the same empty string
+        REQUIRE(table.GetCell(uint64_t(2), type) == table.GetCell(uint64_t(0), other));
+        REQUIRE(std::string(table.GetCell(uint64_t(2), type)).empty());
+
+        // Repeated values do not grow the pool
+        rocprofvis_dm_size_t footprint = table.GetMemoryFootprint();
+        for(uint64_t row = 4; row < 8; row++)
+        {
+            table.AddCell(type, row, "N/A");
+        }
+        TableCache distinct;
+        distinct.AddColumn("type", kRPVDataTypeString);
+        distinct.AddColumn("other", kRPVDataTypeString);
+        for(uint64_t row = 1; row < 8; row++)
+        {
+            distinct.AddCell(0, row, ("a value long enough to be allocated " + std::to_string(row)).c_str());
+        }
+        REQUIRE(table.GetMemoryFootprint() > footprint);
+        REQUIRE(distinct.GetMemoryFootprint() > table.GetMemoryFootprint());
+    }
+
+    // Every cell reads byte identical to a row wise table of strings keyed by
+    // row id and column name, the layout the cache replaced.
+    SECTION("Byte Identical")
+    {
+        const char* names[] = { "node_id", "name", "type", "pid", "extdata" };
+        const rocprofvis_db_data_type_t types[] = { kRPVDataTypeInt, kRPVDataTypeString,
+                                                    kRPVDataTypeString, kRPVDataTypeInt,
+                                                    kRPVDataTypeString };
+        const char* values[] = { "", "0", "-1", "4096", "N/A", "GPU", "CPU",
+                                 "{\"key\": \"a, b\"}", "name with spaces", "\xc3\xa9t\xc3\xa9",
+                                 "9223372036854775807" };
+        std::map<uint64_t, std::map<std::string, std::string>> reference;
+        std::vector<uint64_t> row_ids;
+        TableCache table;
+        std::mt19937 random(1234);
+        uint32_t num_columns = 0;
+        for(int i = 0; i < 20000; i++)
+        {
+            // Columns are added while rows are filled, rows are set sparsely and overwritten
+            if(num_columns < 5 && i % 4000 == 0)
+            {
+                REQUIRE(table.AddColumn(names[num_columns], types[num_columns]) == num_columns);
+                num_columns++;
+            }
+            uint64_t row_id = (random() % 3000) * 17;
+            uint32_t column = random() % num_columns;
+            std::string value = values[random() % (sizeof(values) / sizeof(values[0]))];
+            if(random() % 8 == 0)
+            {
+                value += std::to_string(random() % 100);
+            }
+            if(reference.find(row_id) == reference.end())
+            {
+                row_ids.push_back(row_id);
+            }
+            reference[row_id][names[column]] = value;
+            table.AddCell(column, row_id, value.c_str());
+        }
+
+        REQUIRE(table.NumRows() == row_ids.size());
+        for(size_t index = 0; index < row_ids.size(); index++)
+        {
+            uint64_t row_id = row_ids[index];
+            REQUIRE(table.FindRow(row_id) == index);
+            for(uint32_t column = 0; column < num_columns; column++)
+            {
+                auto it = reference[row_id].find(names[column]);
+                std::string expected = it != reference[row_id].end() ? it->second : "";
+                const char* by_id = table.GetCell(row_id, names[column]);
+                const char* by_index = table.GetCell(uint64_t(index), column);
+                REQUIRE(strlen(by_id) == expected.size());
+                REQUIRE(memcmp(by_id, expected.data(), expected.size()) == 0);
+                REQUIRE(by_index == by_id);
+                REQUIRE(table.GetCellByIndex(index, names[column]) == by_id);
+                REQUIRE(table.GetCellInt(index, column) == std::atoll(expected.c_str()));
+            }
+        }
+    }
+}
+
+// Identity and bounds of a track, in the order the trace reports them
+using TrackSignature = std::tuple<std::string, std::string, std::string, uint64_t, uint64_t,
+                                  uint64_t, uint64_t, uint64_t>;
+
+std::vector<TrackSignature>
+LoadTrackSignatures(const char* path)
+{
+    rocprofvis_dm_trace_t trace = rocprofvis_dm_create_trace();
+    REQUIRE(nullptr != trace);
+    rocprofvis_dm_database_t db = rocprofvis_db_open_database(path, kAutodetect);
+    REQUIRE(nullptr != db);
+    REQUIRE(kRocProfVisDmResultSuccess ==
+            rocprofvis_dm_bind_trace_to_database(trace, db, nullptr));
+
+    rocprofvis_db_future_t object2wait = rocprofvis_db_future_alloc(db_progress);
+    REQUIRE(nullptr != object2wait);
+    REQUIRE(kRocProfVisDmResultSuccess == rocprofvis_db_read_metadata_async(db, object2wait));
+    REQUIRE(kRocProfVisDmResultSuccess == rocprofvis_db_future_wait(object2wait, UINT64_MAX));
+    rocprofvis_db_future_free(object2wait);
+
+    std::vector<TrackSignature> tracks;
+    uint64_t num_tracks =
+        rocprofvis_dm_get_property_as_uint64(trace, kRPVDMNumberOfTracksUInt64, 0);
+    for(uint64_t i = 0; i < num_tracks; i++)
+    {
+        rocprofvis_dm_track_t track =
+            rocprofvis_dm_get_property_as_handle(trace, kRPVDMTrackHandleIndexed, i);
+        REQUIRE(nullptr != track);
+        REQUIRE(rocprofvis_dm_get_property_as_uint64(track, kRPVDMTrackIdUInt64, 0) == i);
+        tracks.emplace_back(
+            rocprofvis_dm_get_property_as_charptr(track, kRPVDMTrackCategoryEnumCharPtr, 0),
+            rocprofvis_dm_get_property_as_charptr(track, kRPVDMTrackMainProcessNameCharPtr, 0),
+            rocprofvis_dm_get_property_as_charptr(track, kRPVDMTrackSubProcessNameCharPtr, 0),
+            rocprofvis_dm_get_property_as_uint64(track, kRPVDMTrackNodeIdUInt64, 0),
+            rocprofvis_dm_get_property_as_uint64(track, kRPVDMTrackInstanceIdUInt64, 0),
+            rocprofvis_dm_get_property_as_uint64(track, kRPVDMTrackNumRecordsUInt64, 0),
+            rocprofvis_dm_get_property_as_uint64(track, kRPVDMTrackMinimumTimestampUInt64, 0),
+            rocprofvis_dm_get_property_as_uint64(track, kRPVDMTrackMaximumTimestampUInt64, 0));
+    }
+    rocprofvis_dm_delete_trace(trace);
+    return tracks;
+}
+
+TEST_CASE("Multi-File Load")
+{
+    if(g_multi_file.empty())
+    {
+        spdlog::info("No --multi_file given, skipping multi-file load");
+        return;
+    }
+
+    // Tracks of every file are merged once all file threads are done, so two
+    // loads of the same trace list the same tracks in the same order. The
+    // first load of a freshly generated trace discovers the tracks, later
+    // loads may restore them from the files.
+    PrintHeader("Load %s", g_multi_file.c_str());
+    std::vector<TrackSignature> first = LoadTrackSignatures(g_multi_file.c_str());
+    PrintHeader("Reload %s", g_multi_file.c_str());
+    std::vector<TrackSignature> second = LoadTrackSignatures(g_multi_file.c_str());
+
+    REQUIRE(!first.empty());
+    REQUIRE(first == second);
+
+    std::set<uint64_t> instances;
+    uint64_t           num_records = 0;
+    for(const TrackSignature& track : first)
+    {
+        instances.insert(std::get<4>(track));
+        num_records += std::get<5>(track);
+    }
+    REQUIRE(instances.size() > 1);
+    REQUIRE(num_records > 0);
+}
@@ -0,0 +1,1838 @@
+// Copyright Advanced Micro Devices, Inc.
+// SPDX-License-Identifier: MIT
+
+// Synthetic trace generator. Writes system trace databases of arbitrary size in the
+// rocprofiler-sdk schema (rocprof, schema version 3) or the legacy rocpd schema so
+// the loaders can be stress tested without capturing a real workload.
+//
+// Every thread of every process runs a sequence of call trees: markers nest down to
+// --depth levels with --fanout children each and the leaves are HIP API calls. A leaf
+// launches a kernel, a memory copy or an allocation on a GPU queue of the thread, and
+// the GPU operation shares the correlation id of its API call for --flow_density of
+// the launches. Every GPU is also sampled at --smi_rate Hz for --smi_counters SMI
+// counters, and kernel dispatches can carry --dispatch_counters PMC values.
+//
+// Rows are written through prepared statements inside large transactions with the
+// journal and syncs turned off. With an --output ending in .yaml every node gets its
+// own database, generated in parallel, plus the rocprofiler-sdk multi-node index;
+// otherwise all nodes share one database with one table set per node GUID.
+
+#include "sqlite3.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+constexpr uint64_t TRACE_BASE_TIMESTAMP    = 1700000000000000000ull;
+constexpr uint64_t ROWS_PER_TRANSACTION    = 1ull << 20;
+constexpr uint64_t PROGRESS_REGION_STEP    = 1ull << 22;
+constexpr uint32_t ROCPROF_SCHEMA_VERSION  = 3;
+constexpr uint32_t ROCPD_SCHEMA_VERSION    = 2;
+constexpr uint64_t ALLOCATION_BASE_ADDRESS = 0x7f0000000000ull;
+
+enum class TraceFormat
+{
+    Rocprof,
+    Rocpd
+};
+
+enum class LeafKind
+{
+    Call,
+    Launch,
+    Copy,
+    Allocate,
+    Free
+};
+
+struct GeneratorOptions
+{
+    std::string output_file;
+    TraceFormat format             = TraceFormat::Rocprof;
+    uint32_t    nodes              = 1;
+    uint32_t    processes          = 1;
+    uint32_t    threads            = 4;
+    uint32_t    gpus               = 8;
+    uint32_t    queues             = 4;
+    uint64_t    regions_per_thread = 100000;
+    uint32_t    depth              = 3;
+    uint32_t    fanout             = 4;
+    uint32_t    kernel_names       = 1000;
+    uint32_t    marker_names       = 64;
+    double      launch_ratio       = 0.4;
+    double      copy_ratio         = 0.05;
+    double      alloc_ratio        = 0.02;
+    double      flow_density       = 1.0;
+    uint32_t    args_per_call      = 2;
+    uint32_t    smi_counters       = 4;
+    double      smi_rate           = 100.0;
+    uint32_t    dispatch_counters  = 0;
+    uint64_t    seed               = 1;
+};
+
+static const char* s_hip_api_names[] = {
+    "hipGetDevice",          "hipSetDevice",         "hipStreamSynchronize",
+    "hipEventRecord",        "hipEventSynchronize",  "hipMemsetAsync",
+    "hipStreamWaitEvent",    "hipPointerGetAttributes", "hipGetLastError",
+    "hipDeviceSynchronize",  "hipFuncGetAttributes", "hipStreamQuery"
+};
+static const char* s_kernel_name_stems[] = {
+    "Cijk_Ailk_Bljk_HHS_BH_MT128x128x32", "elementwise_kernel", "reduce_kernel",
+    "attention_fwd_kernel",               "layer_norm_fwd",     "softmax_warp_forward",
+    "ncclDevKernel_AllReduce_Sum",        "rotary_embedding_kernel"
+};
+static const char* s_smi_counter_names[] = {
+    "GPU_UTIL", "MEM_UTIL", "POWER", "TEMPERATURE", "SCLK", "MCLK", "VRAM_USED", "FAN_SPEED"
+};
+constexpr uint32_t NUM_SMI_COUNTER_NAMES = sizeof(s_smi_counter_names) / sizeof(s_smi_counter_names[0]);
+static const char* s_dispatch_counter_names[] = {
+    "SQ_WAVES", "SQ_INSTS_VALU", "SQ_INSTS_SALU", "GRBM_GUI_ACTIVE", "TCC_HIT_sum",
+    "TCC_MISS_sum", "FETCH_SIZE", "WRITE_SIZE"
+};
+constexpr uint32_t NUM_DISPATCH_COUNTER_NAMES =
+    sizeof(s_dispatch_counter_names) / sizeof(s_dispatch_counter_names[0]);
+
+// splitmix64, cheap enough to not show up next to sqlite
+class Random
+{
+public:
+    explicit Random(uint64_t seed)
+    : m_state(seed)
+    {}
+
+    uint64_t Next()
+    {
+        uint64_t z = (m_state += 0x9e3779b97f4a7c15ull);
+        z          = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z          = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+    double   Uniform() { return (Next() >> 11) * (1.0 / 9007199254740992.0); }
+    uint64_t Range(uint64_t low, uint64_t high) { return low + Next() % (high - low + 1); }
+    bool     Chance(double probability) { return Uniform() < probability; }
+    // Index in [0, count) skewed towards low indices, a few hot kernels dominate real traces
+    uint32_t Skewed(uint32_t count)
+    {
+        double u = Uniform();
+        return std::min(count - 1, static_cast<uint32_t>(count * u * u * u));
+    }
+
+private:
+    uint64_t m_state;
+};
+
+// Names shared by all nodes, ids in the databases are the index + 1
+struct TraceNames
+{
+    std::vector<std::string> markers;
+    std::vector<std::string> kernels;
+    std::vector<std::string> api_calls;
+};
+
+struct ProcessShape
+{
+    uint64_t              pid;
+    std::vector<uint64_t> tids;
+};
+
+// Identifiers of one node. GPU agents are 1..gpus and the CPU agent follows them,
+// queues and streams are numbered per process and GPU.
+struct NodeShape
+{
+    uint32_t                  index;
+    uint64_t                  id;
+    std::string               guid;
+    std::string               hostname;
+    std::vector<ProcessShape> processes;
+    uint32_t                  gpus;
+    uint32_t                  queues;
+    uint32_t                  smi_counters;
+    uint32_t                  dispatch_counters;
+
+    uint64_t GpuAgentId(uint32_t gpu) const { return gpu + 1; }
+    uint64_t CpuAgentId() const { return gpus + 1; }
+    uint64_t QueueId(uint32_t process, uint32_t gpu, uint32_t queue) const
+    {
+        return (static_cast<uint64_t>(process) * gpus + gpu) * queues + queue + 1;
+    }
+    // SMI counters of all GPUs first, then the dispatch counters of all GPUs
+    uint64_t SmiCounterId(uint32_t gpu, uint32_t counter) const
+    {
+        return static_cast<uint64_t>(gpu) * smi_counters + counter + 1;
+    }
+    uint64_t DispatchCounterId(uint32_t gpu, uint32_t counter) const
+    {
+        return static_cast<uint64_t>(gpus) * smi_counters +
+               static_cast<uint64_t>(gpu) * dispatch_counters + counter + 1;
+    }
+};
+
+struct Region
+{
+    uint64_t id;
+    uint64_t parent_id;
+    uint32_t process;
+    uint64_t pid;
+    uint64_t tid;
+    uint64_t start;
+    uint64_t end;
+    bool     is_marker;
+    uint32_t name;
+    LeafKind kind;
+};
+
+struct GpuOperation
+{
+    uint64_t id;
+    // id of the launching region, 0 when the operation has no flow
+    uint64_t correlation_id;
+    const Region* launch;
+    uint32_t gpu;
+    uint32_t queue;
+    uint64_t start;
+    uint64_t end;
+    uint32_t kernel;
+    uint64_t size;
+    uint64_t address;
+    std::vector<double> counters;
+};
+
+struct CounterSample
+{
+    uint32_t            gpu;
+    uint64_t            timestamp;
+    std::vector<double> values;
+};
+
+struct GeneratorStats
+{
+    std::atomic<uint64_t> regions{ 0 };
+    std::atomic<uint64_t> gpu_operations{ 0 };
+    std::atomic<uint64_t> samples{ 0 };
+    std::atomic<uint64_t> rows{ 0 };
+};
+
+static void
+PrintUsage(const char* program)
+{
+    GeneratorOptions defaults;
+    std::cout
+        << "Usage: " << program << " --output <path.db|path.rpd|path.yaml> [options]\n"
+        << "  --format <rocprof|rocpd>     Database schema (default rocprof)\n"
+        << "  --nodes <n>                  Nodes, one GUID each, rocprof only (default "
+        << defaults.nodes << ")\n"
+        << "  --processes <n>              Processes per node (default " << defaults.processes << ")\n"
+        << "  --threads <n>                Threads per process (default " << defaults.threads << ")\n"
+        << "  --gpus <n>                   GPUs per node (default " << defaults.gpus << ")\n"
+        << "  --queues <n>                 Queues per GPU and process (default " << defaults.queues << ")\n"
+        << "  --regions_per_thread <n>     Host regions of every thread (default "
+        << defaults.regions_per_thread << ")\n"
+        << "  --depth <n>                  Nesting depth of the call trees (default " << defaults.depth << ")\n"
+        << "  --fanout <n>                 Children of every marker region (default " << defaults.fanout << ")\n"
+        << "  --kernel_names <n>           Distinct kernel names (default " << defaults.kernel_names << ")\n"
+        << "  --marker_names <n>           Distinct marker names (default " << defaults.marker_names << ")\n"
+        << "  --launch_ratio <f>           API calls launching a kernel (default " << defaults.launch_ratio << ")\n"
+        << "  --copy_ratio <f>             API calls launching a memory copy (default " << defaults.copy_ratio << ")\n"
+        << "  --alloc_ratio <f>            API calls allocating memory (default " << defaults.alloc_ratio << ")\n"
+        << "  --flow_density <f>           GPU operations linked to their launch (default "
+        << defaults.flow_density << ")\n"
+        << "  --args_per_call <n>          Arguments of every API call, rocprof only (default "
+        << defaults.args_per_call << ")\n"
+        << "  --smi_counters <n>           SMI counters sampled on every GPU (default "
+        << defaults.smi_counters << ")\n"
+        << "  --smi_rate <hz>              SMI sampling rate (default " << defaults.smi_rate << ")\n"
+        << "  --dispatch_counters <n>      PMC values of every kernel dispatch, rocprof only (default "
+        << defaults.dispatch_counters << ")\n"
+        << "  --seed <n>                   Random seed (default " << defaults.seed << ")\n";
+}
+
+static bool
+ParseOptions(int argc, char** argv, GeneratorOptions& options)
+{
+    for(int i = 1; i < argc; i++)
+    {
+        std::string arg   = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if(arg == "--help" || arg == "-h")
+        {
+            return false;
+        }
+        if(value == nullptr)
+        {
+            std::cerr << "Missing value for " << arg << std::endl;
+            return false;
+        }
+        if(arg == "--output")
+        {
+            options.output_file = value;
+        }
+        else if(arg == "--format")
+        {
+            std::string format = value;
+            if(format == "rocprof")
+            {
+                options.format = TraceFormat::Rocprof;
+            }
+            else if(format == "rocpd")
+            {
+                options.format = TraceFormat::Rocpd;
+            }
+            else
+            {
+                std::cerr << "Unknown format " << format << std::endl;
+                return false;
+            }
+        }
+        else if(arg == "--nodes")
+        {
+            options.nodes = std::max(1, std::atoi(value));
+        }
+        else if(arg == "--processes")
+        {
+            options.processes = std::max(1, std::atoi(value));
+        }
+        else if(arg == "--threads")
+        {
+            options.threads = std::max(1, std::atoi(value));
+        }
+        else if(arg == "--gpus")
+        {
+            options.gpus = std::max(1, std::atoi(value));
+        }
+        else if(arg == "--queues")
+        {
+            options.queues = std::max(1, std::atoi(value));
+        }
+        else if(arg == "--regions_per_thread")
+        {
+            options.regions_per_thread = std::strtoull(value, nullptr, 10);
+        }
+        else if(arg == "--depth")
+        {
+            options.depth = std::max(1, std::atoi(value));
+        }
+        else if(arg == "--fanout")
+        {
+            options.fanout = std::max(1, std::atoi(value));
+        }
+        else if(arg == "--kernel_names")
+        {
+            options.kernel_names = std::max(1, std::atoi(value));
+        }
+        else if(arg == "--marker_names")
+        {
+            options.marker_names = std::max(1, std::atoi(value));
+        }
+        else if(arg == "--launch_ratio")
+        {
+            options.launch_ratio = std::atof(value);
+        }
+        else if(arg == "--copy_ratio")
+        {
+            options.copy_ratio = std::atof(value);
+        }
+        else if(arg == "--alloc_ratio")
+        {
+            options.alloc_ratio = std::atof(value);
+        }
+        else if(arg == "--flow_density")
+        {
+            options.flow_density = std::atof(value);
+        }
+        else if(arg == "--args_per_call")
+        {
+            options.args_per_call = std::max(0, std::atoi(value));
+        }
+        else if(arg == "--smi_counters")
+        {
+            options.smi_counters = std::min<uint32_t>(std::max(0, std::atoi(value)), NUM_SMI_COUNTER_NAMES);
+        }
+        else if(arg == "--smi_rate")
+        {
+            options.smi_rate = std::max(0.0, std::atof(value));
+        }
+        else if(arg == "--dispatch_counters")
+        {
+            options.dispatch_counters =
+                std::min<uint32_t>(std::max(0, std::atoi(value)), NUM_DISPATCH_COUNTER_NAMES);
+        }
+        else if(arg == "--seed")
+        {
+            options.seed = std::strtoull(value, nullptr, 10);
+        }
+        else
+        {
+            std::cerr << "Unknown option " << arg << std::endl;
+            return false;
+        }
+        i++;
+    }
+    if(options.output_file.empty())
+    {
+        return false;
+    }
+    if(options.format == TraceFormat::Rocpd && options.nodes > 1)
+    {
+        std::cerr << "The rocpd schema has no nodes, use --format rocprof" << std::endl;
+        return false;
+    }
+    if(options.launch_ratio + options.copy_ratio + options.alloc_ratio > 1.0)
+    {
+        std::cerr << "--launch_ratio, --copy_ratio and --alloc_ratio add up to more than 1"
+                  << std::endl;
+        return false;
+    }
+    return true;
+}
+
+static bool
+EndsWith(const std::string& value, const char* suffix)
+{
+    size_t length = strlen(suffix);
+    return value.size() >= length && value.compare(value.size() - length, length, suffix) == 0;
+}
+
+static TraceNames
+BuildNames(const GeneratorOptions& options)
+{
+    TraceNames names;
+    for(uint32_t i = 0; i < options.marker_names; i++)
+    {
+        names.markers.push_back("roctx_range_" + std::to_string(i));
+    }
+    constexpr uint32_t num_stems = sizeof(s_kernel_name_stems) / sizeof(s_kernel_name_stems[0]);
+    for(uint32_t i = 0; i < options.kernel_names; i++)
+    {
+        names.kernels.push_back(std::string(s_kernel_name_stems[i % num_stems]) + "_" +
+                                std::to_string(i / num_stems) + "(float const*, float*, int)");
+    }
+    for(const char* name : s_hip_api_names)
+    {
+        names.api_calls.push_back(name);
+    }
+    return names;
+}
+
+static std::string
+MakeGuid(Random& random)
+{
+    char     guid[40];
+    uint64_t high = random.Next();
+    uint64_t low  = random.Next();
+    snprintf(guid, sizeof(guid), "%08x-%04x-%04x-%04x-%012llx", static_cast<uint32_t>(high >> 32),
+             static_cast<uint32_t>(high >> 16) & 0xffff, static_cast<uint32_t>(high) & 0xffff,
+             static_cast<uint32_t>(low >> 48), static_cast<unsigned long long>(low & 0xffffffffffffull));
+    return guid;
+}
+
+static NodeShape
+BuildNodeShape(const GeneratorOptions& options, uint32_t index)
+{
+    Random    random(options.seed * 1000003 + index);
+    NodeShape node;
+    node.index             = index;
+    node.id                = index + 1;
+    node.guid              = MakeGuid(random);
+    node.hostname          = "synthetic-node-" + std::to_string(index);
+    node.gpus              = options.gpus;
+    node.queues            = options.queues;
+    node.smi_counters      = options.smi_rate > 0 ? options.smi_counters : 0;
+    node.dispatch_counters = options.dispatch_counters;
+    // process ids are spaced so the thread ids of one process never reach the next one
+    uint64_t pid_stride = (static_cast<uint64_t>(options.threads) / 1000 + 1) * 1000;
+    for(uint32_t p = 0; p < options.processes; p++)
+    {
+        ProcessShape process;
+        process.pid = 10000 + p * pid_stride;
+        for(uint32_t t = 0; t < options.threads; t++)
+        {
+            // the main thread id equals the process id
+            process.tids.push_back(process.pid + t);
+        }
+        node.processes.push_back(process);
+    }
+    return node;
+}
+
+// One sqlite connection tuned for bulk loading. Statements stepped through Step are
+// counted and the open transaction is committed every ROWS_PER_TRANSACTION rows.
+class Database
+{
+public:
+    explicit Database(GeneratorStats& stats)
+    : m_conn(nullptr)
+    , m_stats(stats)
+    , m_rows_in_transaction(0)
+    {}
+    ~Database() { Close(); }
+
+    bool Open(const std::string& path)
+    {
+        std::error_code error;
+        std::filesystem::remove(path, error);
+        if(sqlite3_open(path.c_str(), &m_conn) != SQLITE_OK)
+        {
+            std::cerr << "Cannot create " << path << ": " << sqlite3_errmsg(m_conn) << std::endl;
+            return false;
+        }
+        return Exec("PRAGMA page_size = 65536;") && Exec("PRAGMA journal_mode = OFF;") &&
+               Exec("PRAGMA synchronous = OFF;") && Exec("PRAGMA locking_mode = EXCLUSIVE;") &&
+               Exec("PRAGMA temp_store = MEMORY;") && Exec("PRAGMA cache_size = -262144;") &&
+               Exec("BEGIN;");
+    }
+
+    bool Close()
+    {
+        bool result = true;
+        if(m_conn)
+        {
+            result = Exec("COMMIT;");
+            sqlite3_close(m_conn);
+            m_conn = nullptr;
+        }
+        return result;
+    }
+
+    bool Exec(const std::string& query)
+    {
+        char* error = nullptr;
+        if(sqlite3_exec(m_conn, query.c_str(), nullptr, nullptr, &error) != SQLITE_OK)
+        {
+            std::cerr << "Query failed: " << (error ? error : "") << "\n  " << query << std::endl;
+            sqlite3_free(error);
+            return false;
+        }
+        return true;
+    }
+
+    sqlite3_stmt* Prepare(const std::string& query)
+    {
+        sqlite3_stmt* stmt = nullptr;
+        if(sqlite3_prepare_v2(m_conn, query.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
+        {
+            std::cerr << "Prepare failed: " << sqlite3_errmsg(m_conn) << "\n  " << query
+                      << std::endl;
+            return nullptr;
+        }
+        m_statements.push_back(stmt);
+        return stmt;
+    }
+
+    void FinalizeStatements()
+    {
+        for(sqlite3_stmt* stmt : m_statements)
+        {
+            sqlite3_finalize(stmt);
+        }
+        m_statements.clear();
+    }
+
+    bool Step(sqlite3_stmt* stmt)
+    {
+        int rc = sqlite3_step(stmt);
+        sqlite3_reset(stmt);
+        if(rc != SQLITE_DONE)
+        {
+            std::cerr << "Insert failed: " << sqlite3_errmsg(m_conn) << std::endl;
+            return false;
+        }
+        m_stats.rows.fetch_add(1, std::memory_order_relaxed);
+        if(++m_rows_in_transaction == ROWS_PER_TRANSACTION)
+        {
+            m_rows_in_transaction = 0;
+            return Exec("COMMIT;") && Exec("BEGIN;");
+        }
+        return true;
+    }
+
+private:
+    sqlite3*                   m_conn;
+    GeneratorStats&            m_stats;
+    uint64_t                   m_rows_in_transaction;
+    std::vector<sqlite3_stmt*> m_statements;
+};
+
+static void
+BindText(sqlite3_stmt* stmt, int index, const std::string& value)
+{
+    sqlite3_bind_text(stmt, index, value.c_str(), static_cast<int>(value.size()), SQLITE_STATIC);
+}
+
+static void
+BindInt(sqlite3_stmt* stmt, int index, uint64_t value)
+{
+    sqlite3_bind_int64(stmt, index, static_cast<sqlite3_int64>(value));
+}
+
+// Receives the events of one node in the schema of the output database
+class TraceWriter
+{
+public:
+    virtual ~TraceWriter() = default;
+
+    virtual bool WriteRegion(const Region& region)                                  = 0;
+    virtual bool WriteDispatch(const GpuOperation& dispatch)                        = 0;
+    virtual bool WriteCopy(const GpuOperation& copy)                                = 0;
+    virtual bool WriteAllocation(const GpuOperation& allocation, bool is_free)      = 0;
+    virtual bool WriteCounterSample(const CounterSample& sample)                    = 0;
+};
+
+// rocprofiler-sdk schema, every table is suffixed with the node GUID
+class RocprofWriter : public TraceWriter
+{
+public:
+    RocprofWriter(Database& db, const NodeShape& node, const TraceNames& names,
+                  uint32_t args_per_call);
+
+    bool Initialize();
+    bool WriteRegion(const Region& region) override;
+    bool WriteDispatch(const GpuOperation& dispatch) override;
+    bool WriteCopy(const GpuOperation& copy) override;
+    bool WriteAllocation(const GpuOperation& allocation, bool is_free) override;
+    bool WriteCounterSample(const CounterSample& sample) override;
+
+    // Views over the tables of all nodes in the database
+    static bool CreateViews(Database& db, const std::vector<std::string>& suffixes);
+
+private:
+    enum StringId
+    {
+        kCategoryMarker = 1,
+        kCategoryHipApi,
+        kCategoryKernelDispatch,
+        kCategoryMemoryCopy,
+        kCategoryMemoryAllocation,
+        kCategorySmi,
+        kCopyHostToDevice,
+        kSmiTrackName,
+        kFirstNameString
+    };
+
+    bool     CreateTables();
+    bool     WriteTopology();
+    bool     WriteEvent(uint64_t id, uint64_t category, uint64_t stack_id, uint64_t parent_stack_id);
+    uint64_t ApiCallNameId(LeafKind kind, uint32_t name) const;
+    uint64_t MarkerNameId(uint32_t name) const { return m_marker_base + name; }
+
+    Database&         m_db;
+    const NodeShape&  m_node;
+    const TraceNames& m_names;
+    uint32_t          m_args_per_call;
+    std::string       m_suffix;
+    uint64_t          m_marker_base;
+    uint64_t          m_api_base;
+    uint64_t          m_event_id;
+    uint64_t          m_arg_id;
+    uint64_t          m_pmc_event_id;
+    uint64_t          m_allocation_id;
+    uint64_t          m_sample_id;
+    sqlite3_stmt*     m_insert_event;
+    sqlite3_stmt*     m_insert_arg;
+    sqlite3_stmt*     m_insert_region;
+    sqlite3_stmt*     m_insert_dispatch;
+    sqlite3_stmt*     m_insert_copy;
+    sqlite3_stmt*     m_insert_allocation;
+    sqlite3_stmt*     m_insert_sample;
+    sqlite3_stmt*     m_insert_pmc_event;
+};
+
+RocprofWriter::RocprofWriter(Database& db, const NodeShape& node, const TraceNames& names,
+                             uint32_t args_per_call)
+: m_db(db)
+, m_node(node)
+, m_names(names)
+, m_args_per_call(args_per_call)
+, m_suffix(node.guid)
+, m_marker_base(kFirstNameString)
+, m_api_base(kFirstNameString + names.markers.size())
+, m_event_id(0)
+, m_arg_id(0)
+, m_pmc_event_id(0)
+, m_allocation_id(0)
+, m_sample_id(0)
+, m_insert_event(nullptr)
+, m_insert_arg(nullptr)
+, m_insert_region(nullptr)
+, m_insert_dispatch(nullptr)
+, m_insert_copy(nullptr)
+, m_insert_allocation(nullptr)
+, m_insert_sample(nullptr)
+, m_insert_pmc_event(nullptr)
+{
+    std::replace(m_suffix.begin(), m_suffix.end(), '-', '_');
+    m_suffix = "_" + m_suffix;
+}
+
+bool
+RocprofWriter::CreateTables()
+{
+    const std::string guid = " TEXT DEFAULT '" + m_node.guid + "' NOT NULL";
+    const std::string ext  = " JSONB DEFAULT '{}' NOT NULL";
+    std::string       s    = m_suffix;
+    return m_db.Exec("CREATE TABLE rocpd_metadata" + s +
+                     " (id INTEGER PRIMARY KEY, tag TEXT NOT NULL, value TEXT NOT NULL);") &&
+           m_db.Exec("CREATE TABLE rocpd_string" + s + " (id INTEGER PRIMARY KEY, guid" + guid +
+                     ", string TEXT NOT NULL UNIQUE ON CONFLICT ABORT);") &&
+           m_db.Exec("CREATE TABLE rocpd_info_node" + s + " (id INTEGER PRIMARY KEY, guid" + guid +
+                     ", hash BIGINT NOT NULL UNIQUE, machine_id TEXT NOT NULL UNIQUE, system_name TEXT,"
+                     " hostname TEXT, release TEXT, version TEXT, hardware_name TEXT, domain_name TEXT);") &&
+           m_db.Exec("CREATE TABLE rocpd_info_process" + s + " (id INTEGER PRIMARY KEY, guid" + guid +
+                     ", nid INTEGER NOT NULL, ppid INTEGER, pid INTEGER NOT NULL, init BIGINT, fini BIGINT,"
+                     " start BIGINT, \"end\" BIGINT, command TEXT, environment" + ext + ", extdata" + ext + ");") &&
+           m_db.Exec("CREATE TABLE rocpd_info_thread" + s + " (id INTEGER PRIMARY KEY, guid" + guid +
+                     ", nid INTEGER NOT NULL, ppid INTEGER, pid INTEGER NOT NULL, tid INTEGER NOT NULL,"
+                     " name TEXT, start BIGINT, \"end\" BIGINT, extdata" + ext + ");") &&
+           m_db.Exec("CREATE TABLE rocpd_info_agent" + s + " (id INTEGER PRIMARY KEY, guid" + guid +
+                     ", nid INTEGER NOT NULL, pid INTEGER NOT NULL, type TEXT CHECK (type IN ('CPU', 'GPU')),"
+                     " absolute_index INTEGER, logical_index INTEGER, type_index INTEGER, uuid INTEGER,"
+                     " name TEXT, model_name TEXT, vendor_name TEXT, product_name TEXT, user_name TEXT,"
+                     " extdata" + ext + ");") &&
+           m_db.Exec("CREATE TABLE rocpd_info_queue" + s + " (id INTEGER PRIMARY KEY, guid" + guid +
+                     ", nid INTEGER NOT NULL, pid INTEGER NOT NULL, name TEXT, extdata" + ext + ");") &&
+           m_db.Exec("CREATE TABLE rocpd_info_stream" + s + " (id INTEGER PRIMARY KEY, guid" + guid +
+                     ", nid INTEGER NOT NULL, pid INTEGER NOT NULL, name TEXT, extdata" + ext + ");") &&
+           m_db.Exec("CREATE TABLE rocpd_info_pmc" + s + " (id INTEGER PRIMARY KEY, guid" + guid +
+                     ", nid INTEGER NOT NULL, pid INTEGER NOT NULL, agent_id INTEGER, target_arch TEXT,"
+                     " event_code INTEGER, instance_id INTEGER, name TEXT NOT NULL, symbol TEXT NOT NULL,"
+                     " description TEXT, long_description TEXT DEFAULT '', component TEXT, units TEXT DEFAULT '',"
+                     " value_type TEXT, block TEXT, expression TEXT, is_constant INTEGER, is_derived INTEGER,"
+                     " extdata" + ext + ");") &&
+           m_db.Exec("CREATE TABLE rocpd_info_code_object" + s + " (id INTEGER PRIMARY KEY, guid" + guid +
+                     ", nid INTEGER NOT NULL, pid INTEGER NOT NULL, agent_id INTEGER, uri TEXT,"
+                     " load_base BIGINT, load_size BIGINT, load_delta BIGINT, storage_type TEXT,"
+                     " extdata" + ext + ");") &&
+           m_db.Exec("CREATE TABLE rocpd_info_kernel_symbol" + s + " (id INTEGER PRIMARY KEY, guid" + guid +
+                     ", nid INTEGER NOT NULL, pid INTEGER NOT NULL, code_object_id INTEGER NOT NULL,"
+                     " kernel_name TEXT, display_name TEXT, kernel_object INTEGER,"
+                     " kernarg_segment_size INTEGER, kernarg_segment_alignment INTEGER,"
+                     " group_segment_size INTEGER, private_segment_size INTEGER, sgpr_count INTEGER,"
+                     " arch_vgpr_count INTEGER, accum_vgpr_count INTEGER, extdata" + ext + ");") &&
+           m_db.Exec("CREATE TABLE rocpd_track" + s + " (id INTEGER PRIMARY KEY, guid" + guid +
+                     ", nid INTEGER NOT NULL, pid INTEGER, tid INTEGER, name_id INTEGER, extdata" + ext + ");") &&
+           m_db.Exec("CREATE TABLE rocpd_event" + s + " (id INTEGER PRIMARY KEY, guid" + guid +
+                     ", category_id INTEGER, stack_id INTEGER, parent_stack_id INTEGER,"
+                     " correlation_id INTEGER, call_stack" + ext + ", line_info" + ext +
+                     ", extdata" + ext + ");") &&
+           m_db.Exec("CREATE TABLE rocpd_arg" + s + " (id INTEGER PRIMARY KEY, guid" + guid +
+                     ", event_id INTEGER NOT NULL, position INTEGER NOT NULL, type TEXT NOT NULL,"
+                     " name TEXT NOT NULL, value TEXT, extdata" + ext + ");") &&
+           m_db.Exec("CREATE TABLE rocpd_pmc_event" + s + " (id INTEGER PRIMARY KEY, guid" + guid +
+                     ", event_id INTEGER, pmc_id INTEGER NOT NULL, value REAL DEFAULT 0.0,"
+                     " extdata" + ext + ");") &&
+           m_db.Exec("CREATE TABLE rocpd_region" + s + " (id INTEGER PRIMARY KEY, guid" + guid +
+                     ", nid INTEGER NOT NULL, pid INTEGER NOT NULL, tid INTEGER NOT NULL,"
+                     " start BIGINT NOT NULL, \"end\" BIGINT NOT NULL, name_id INTEGER NOT NULL,"
+                     " event_id INTEGER, extdata" + ext + ");") &&
+           m_db.Exec("CREATE TABLE rocpd_sample" + s + " (id INTEGER PRIMARY KEY, guid" + guid +
+                     ", track_id INTEGER NOT NULL, timestamp BIGINT NOT NULL, event_id INTEGER,"
+                     " extdata" + ext + ");") &&
+           m_db.Exec("CREATE TABLE rocpd_kernel_dispatch" + s + " (id INTEGER PRIMARY KEY, guid" + guid +
+                     ", nid INTEGER NOT NULL, pid INTEGER NOT NULL, tid INTEGER, agent_id INTEGER NOT NULL,"
+                     " kernel_id INTEGER NOT NULL, dispatch_id INTEGER NOT NULL, queue_id INTEGER NOT NULL,"
+                     " stream_id INTEGER NOT NULL, start BIGINT NOT NULL, \"end\" BIGINT NOT NULL,"
+                     " private_segment_size INTEGER, group_segment_size INTEGER, workgroup_size_x INTEGER,"
+                     " workgroup_size_y INTEGER, workgroup_size_z INTEGER, grid_size_x INTEGER,"
+                     " grid_size_y INTEGER, grid_size_z INTEGER, region_name_id INTEGER, event_id INTEGER,"
+                     " extdata" + ext + ");") &&
+           m_db.Exec("CREATE TABLE rocpd_memory_copy" + s + " (id INTEGER PRIMARY KEY, guid" + guid +
+                     ", nid INTEGER NOT NULL, pid INTEGER NOT NULL, tid INTEGER, start BIGINT NOT NULL,"
+                     " \"end\" BIGINT NOT NULL, name_id INTEGER NOT NULL, dst_agent_id INTEGER,"
+                     " dst_address INTEGER, src_agent_id INTEGER, src_address INTEGER, size INTEGER NOT NULL,"
+                     " queue_id INTEGER, stream_id INTEGER, region_name_id INTEGER, event_id INTEGER,"
+                     " extdata" + ext + ");") &&
+           m_db.Exec("CREATE TABLE rocpd_memory_allocate" + s + " (id INTEGER PRIMARY KEY, guid" + guid +
+                     ", nid INTEGER NOT NULL, pid INTEGER NOT NULL, tid INTEGER, agent_id INTEGER,"
+                     " type TEXT CHECK (type IN ('ALLOC', 'FREE', 'REALLOC', 'RECLAIM')),"
+                     " level TEXT CHECK (level IN ('REAL', 'VIRTUAL', 'SCRATCH')), start BIGINT NOT NULL,"
+                     " \"end\" BIGINT NOT NULL, address INTEGER, size INTEGER NOT NULL, queue_id INTEGER,"
+                     " stream_id INTEGER, event_id INTEGER, extdata" + ext + ");");
+}
+
+bool
+RocprofWriter::WriteTopology()
+{
+    std::string s   = m_suffix;
+    uint64_t    nid = m_node.id;
+    bool        ok  = m_db.Exec("INSERT INTO rocpd_metadata" + s + " (tag, value) VALUES ('schema_version', '" +
+                                std::to_string(ROCPROF_SCHEMA_VERSION) + "'), ('uuid', '" + s +
+                                "'), ('guid', '" + m_node.guid + "');");
+    ok = ok && m_db.Exec("INSERT INTO rocpd_info_node" + s + " (id, hash, machine_id, system_name, hostname,"
+                         " release, version, hardware_name, domain_name) VALUES (" + std::to_string(nid) + ", " +
+                         std::to_string(nid * 7919) + ", '" + m_node.guid + "', 'Linux', '" + m_node.hostname +
+                         "', '6.8.0', '#1 SMP', 'x86_64', '(none)');");
+
+    sqlite3_stmt* insert_string = m_db.Prepare("INSERT INTO rocpd_string" + s + " (id, string) VALUES (?, ?);");
+    const char*   fixed_strings[] = { "MARKER_CORE_API",   "HIP_RUNTIME_API_EXT", "KERNEL_DISPATCH",
+                                      "MEMORY_COPY",       "MEMORY_ALLOCATION",   "AMD_SMI",
+                                      "MEMORY_COPY_HOST_TO_DEVICE", "SMI" };
+    uint64_t      string_id       = 1;
+    for(const char* value : fixed_strings)
+    {
+        BindInt(insert_string, 1, string_id++);
+        sqlite3_bind_text(insert_string, 2, value, -1, SQLITE_STATIC);
+        ok = ok && m_db.Step(insert_string);
+    }
+    for(const std::string& value : m_names.markers)
+    {
+        BindInt(insert_string, 1, string_id++);
+        BindText(insert_string, 2, value);
+        ok = ok && m_db.Step(insert_string);
+    }
+    for(const std::string& value : m_names.api_calls)
+    {
+        BindInt(insert_string, 1, string_id++);
+        BindText(insert_string, 2, value);
+        ok = ok && m_db.Step(insert_string);
+    }
+    for(const char* value : { "hipLaunchKernel", "hipMemcpyAsync", "hipMalloc", "hipFree" })
+    {
+        BindInt(insert_string, 1, string_id++);
+        sqlite3_bind_text(insert_string, 2, value, -1, SQLITE_STATIC);
+        ok = ok && m_db.Step(insert_string);
+    }
+
+    sqlite3_stmt* insert_process =
+        m_db.Prepare("INSERT INTO rocpd_info_process" + s +
+                     " (id, nid, ppid, pid, init, fini, start, \"end\", command) VALUES (?, ?, 1, ?, ?, ?, ?, ?, ?);");
+    sqlite3_stmt* insert_thread =
+        m_db.Prepare("INSERT INTO rocpd_info_thread" + s +
+                     " (id, nid, ppid, pid, tid, name, start, \"end\") VALUES (?, ?, 1, ?, ?, ?, ?, ?);");
+    sqlite3_stmt* insert_queue =
+        m_db.Prepare("INSERT INTO rocpd_info_queue" + s + " (id, nid, pid, name) VALUES (?, ?, ?, ?);");
+    sqlite3_stmt* insert_stream =
+        m_db.Prepare("INSERT INTO rocpd_info_stream" + s + " (id, nid, pid, name) VALUES (?, ?, ?, ?);");
+    for(uint32_t p = 0; p < m_node.processes.size(); p++)
+    {
+        const ProcessShape& process = m_node.processes[p];
+        std::string         command = "synthetic_workload --rank " + std::to_string(p);
+        BindInt(insert_process, 1, process.pid);
+        BindInt(insert_process, 2, nid);
+        BindInt(insert_process, 3, process.pid);
+        BindInt(insert_process, 4, TRACE_BASE_TIMESTAMP);
+        BindInt(insert_process, 5, TRACE_BASE_TIMESTAMP);
+        BindInt(insert_process, 6, TRACE_BASE_TIMESTAMP);
+        BindInt(insert_process, 7, TRACE_BASE_TIMESTAMP);
+        BindText(insert_process, 8, command);
+        ok = ok && m_db.Step(insert_process);
+        for(uint32_t t = 0; t < process.tids.size(); t++)
+        {
+            std::string name = t == 0 ? "synthetic_workload" : "worker_" + std::to_string(t);
+            BindInt(insert_thread, 1, process.tids[t]);
+            BindInt(insert_thread, 2, nid);
+            BindInt(insert_thread, 3, process.pid);
+            BindInt(insert_thread, 4, process.tids[t]);
+            BindText(insert_thread, 5, name);
+            BindInt(insert_thread, 6, TRACE_BASE_TIMESTAMP);
+            BindInt(insert_thread, 7, TRACE_BASE_TIMESTAMP);
+            ok = ok && m_db.Step(insert_thread);
+        }
+        for(uint32_t g = 0; g < m_node.gpus; g++)
+        {
+            for(uint32_t q = 0; q < m_node.queues; q++)
+            {
+                uint64_t    id     = m_node.QueueId(p, g, q);
+                std::string queue  = "Queue " + std::to_string(id);
+                std::string stream = "Stream " + std::to_string(id);
+                BindInt(insert_queue, 1, id);
+                BindInt(insert_queue, 2, nid);
+                BindInt(insert_queue, 3, process.pid);
+                BindText(insert_queue, 4, queue);
+                ok = ok && m_db.Step(insert_queue);
+                BindInt(insert_stream, 1, id);
+                BindInt(insert_stream, 2, nid);
+                BindInt(insert_stream, 3, process.pid);
+                BindText(insert_stream, 4, stream);
+                ok = ok && m_db.Step(insert_stream);
+            }
+        }
+    }
+
+    uint64_t      main_pid = m_node.processes.front().pid;
+    sqlite3_stmt* insert_agent =
+        m_db.Prepare("INSERT INTO rocpd_info_agent" + s +
+                     " (id, nid, pid, type, absolute_index, logical_index, type_index, uuid, name,"
+                     " model_name, vendor_name, product_name, user_name) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?);");
+    for(uint32_t a = 0; a <= m_node.gpus; a++)
+    {
+        bool        is_gpu  = a < m_node.gpus;
+        uint64_t    id      = is_gpu ? m_node.GpuAgentId(a) : m_node.CpuAgentId();
+        std::string name    = is_gpu ? "gfx942" : "AMD EPYC 9654";
+        std::string product = is_gpu ? "AMD Instinct MI300X" : "AMD EPYC 9654 96-Core Processor";
+        std::string model   = is_gpu ? "aqua_vanjaram" : "";
+        BindInt(insert_agent, 1, id);
+        BindInt(insert_agent, 2, nid);
+        BindInt(insert_agent, 3, main_pid);
+        sqlite3_bind_text(insert_agent, 4, is_gpu ? "GPU" : "CPU", -1, SQLITE_STATIC);
+        BindInt(insert_agent, 5, is_gpu ? a + 1 : 0);
+        BindInt(insert_agent, 6, is_gpu ? a + 1 : 0);
+        BindInt(insert_agent, 7, is_gpu ? a : 0);
+        BindInt(insert_agent, 8, nid * 1000 + id);
+        BindText(insert_agent, 9, name);
+        BindText(insert_agent, 10, model);
+        sqlite3_bind_text(insert_agent, 11, "AMD", -1, SQLITE_STATIC);
+        BindText(insert_agent, 12, product);
+        BindText(insert_agent, 13, product);
+        ok = ok && m_db.Step(insert_agent);
+    }
+
+    sqlite3_stmt* insert_pmc =
+        m_db.Prepare("INSERT INTO rocpd_info_pmc" + s +
+                     " (id, nid, pid, agent_id, target_arch, event_code, instance_id, name, symbol,"
+                     " description, component, units, value_type, block, expression, is_constant, is_derived)"
+                     " VALUES (?, ?, ?, ?, 'gfx942', 0, 0, ?, ?, ?, ?, '', 'float', ?, '', 0, 0);");
+    for(uint32_t g = 0; g < m_node.gpus; g++)
+    {
+        for(uint32_t c = 0; c < m_node.smi_counters + m_node.dispatch_counters; c++)
+        {
+            bool        is_smi = c < m_node.smi_counters;
+            std::string name   = is_smi ? s_smi_counter_names[c]
+                                        : s_dispatch_counter_names[c - m_node.smi_counters];
+            BindInt(insert_pmc, 1, is_smi ? m_node.SmiCounterId(g, c)
+                                          : m_node.DispatchCounterId(g, c - m_node.smi_counters));
+            BindInt(insert_pmc, 2, nid);
+            BindInt(insert_pmc, 3, main_pid);
+            BindInt(insert_pmc, 4, m_node.GpuAgentId(g));
+            BindText(insert_pmc, 5, name);
+            BindText(insert_pmc, 6, name);
+            BindText(insert_pmc, 7, name);
+            sqlite3_bind_text(insert_pmc, 8, is_smi ? "amd-smi" : "rocprofiler-sdk", -1, SQLITE_STATIC);
+            sqlite3_bind_text(insert_pmc, 9, is_smi ? "SMI" : "SQ", -1, SQLITE_STATIC);
+            ok = ok && m_db.Step(insert_pmc);
+        }
+    }
+
+    ok = ok && m_db.Exec("INSERT INTO rocpd_info_code_object" + s +
+                         " (id, nid, pid, agent_id, uri, load_base, load_size, load_delta, storage_type)"
+                         " VALUES (1, " + std::to_string(nid) + ", " + std::to_string(main_pid) +
+                         ", 1, 'file:///synthetic_workload#offset=0&size=0', 0, 0, 0, 'FILE');");
+    sqlite3_stmt* insert_symbol =
+        m_db.Prepare("INSERT INTO rocpd_info_kernel_symbol" + s +
+                     " (id, nid, pid, code_object_id, kernel_name, display_name, kernel_object,"
+                     " kernarg_segment_size, kernarg_segment_alignment, group_segment_size,"
+                     " private_segment_size, sgpr_count, arch_vgpr_count, accum_vgpr_count)"
+                     " VALUES (?, ?, ?, 1, ?, ?, ?, 64, 8, 0, 0, 32, 64, 0);");
+    for(uint32_t k = 0; k < m_names.kernels.size(); k++)
+    {
+        BindInt(insert_symbol, 1, k + 1);
+        BindInt(insert_symbol, 2, nid);
+        BindInt(insert_symbol, 3, main_pid);
+        BindText(insert_symbol, 4, m_names.kernels[k]);
+        BindText(insert_symbol, 5, m_names.kernels[k]);
+        BindInt(insert_symbol, 6, 0x1000 + k * 0x100);
+        ok = ok && m_db.Step(insert_symbol);
+    }
+
+    sqlite3_stmt* insert_track = m_db.Prepare("INSERT INTO rocpd_track" + s +
+                                              " (id, nid, pid, tid, name_id) VALUES (?, ?, ?, NULL, ?);");
+    for(uint32_t g = 0; g < m_node.gpus && m_node.smi_counters > 0; g++)
+    {
+        BindInt(insert_track, 1, g + 1);
+        BindInt(insert_track, 2, nid);
+        BindInt(insert_track, 3, main_pid);
+        BindInt(insert_track, 4, kSmiTrackName);
+        ok = ok && m_db.Step(insert_track);
+    }
+    return ok;
+}
+
+bool
+RocprofWriter::Initialize()
+{
+    std::string s = m_suffix;
+    if(!CreateTables() || !WriteTopology())
+    {
+        return false;
+    }
+    m_insert_event = m_db.Prepare("INSERT INTO rocpd_event" + s +
+                                  " (id, category_id, stack_id, parent_stack_id, correlation_id)"
+                                  " VALUES (?, ?, ?, ?, ?);");
+    m_insert_arg = m_db.Prepare("INSERT INTO rocpd_arg" + s +
+                                " (id, event_id, position, type, name, value) VALUES (?, ?, ?, ?, ?, ?);");
+    m_insert_region = m_db.Prepare("INSERT INTO rocpd_region" + s +
+                                   " (id, nid, pid, tid, start, \"end\", name_id, event_id)"
+                                   " VALUES (?, ?, ?, ?, ?, ?, ?, ?);");
+    m_insert_dispatch = m_db.Prepare(
+        "INSERT INTO rocpd_kernel_dispatch" + s +
+        " (id, nid, pid, tid, agent_id, kernel_id, dispatch_id, queue_id, stream_id, start, \"end\","
+        " private_segment_size, group_segment_size, workgroup_size_x, workgroup_size_y, workgroup_size_z,"
+        " grid_size_x, grid_size_y, grid_size_z, region_name_id, event_id)"
+        " VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, 0, ?, ?, 1, 1, ?, 1, 1, ?, ?);");
+    m_insert_copy = m_db.Prepare(
+        "INSERT INTO rocpd_memory_copy" + s +
+        " (id, nid, pid, tid, start, \"end\", name_id, dst_agent_id, dst_address, src_agent_id, src_address,"
+        " size, queue_id, stream_id, region_name_id, event_id)"
+        " VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?);");
+    m_insert_allocation = m_db.Prepare(
+        "INSERT INTO rocpd_memory_allocate" + s +
+        " (id, nid, pid, tid, agent_id, type, level, start, \"end\", address, size, queue_id, stream_id,"
+        " event_id) VALUES (?, ?, ?, ?, ?, ?, 'REAL', ?, ?, ?, ?, ?, ?, ?);");
+    m_insert_sample = m_db.Prepare("INSERT INTO rocpd_sample" + s +
+                                   " (id, track_id, timestamp, event_id) VALUES (?, ?, ?, ?);");
+    m_insert_pmc_event = m_db.Prepare("INSERT INTO rocpd_pmc_event" + s +
+                                      " (id, event_id, pmc_id, value) VALUES (?, ?, ?, ?);");
+    return m_insert_event && m_insert_arg && m_insert_region && m_insert_dispatch && m_insert_copy &&
+           m_insert_allocation && m_insert_sample && m_insert_pmc_event;
+}
+
+uint64_t
+RocprofWriter::ApiCallNameId(LeafKind kind, uint32_t name) const
+{
+    uint64_t launch_base = m_api_base + m_names.api_calls.size();
+    switch(kind)
+    {
+        case LeafKind::Launch: return launch_base;
+        case LeafKind::Copy: return launch_base + 1;
+        case LeafKind::Allocate: return launch_base + 2;
+        case LeafKind::Free: return launch_base + 3;
+        default: return m_api_base + name;
+    }
+}
+
+bool
+RocprofWriter::WriteEvent(uint64_t id, uint64_t category, uint64_t stack_id, uint64_t parent_stack_id)
+{
+    BindInt(m_insert_event, 1, id);
+    BindInt(m_insert_event, 2, category);
+    BindInt(m_insert_event, 3, stack_id);
+    BindInt(m_insert_event, 4, parent_stack_id);
+    BindInt(m_insert_event, 5, stack_id);
+    return m_db.Step(m_insert_event);
+}
+
+bool
+RocprofWriter::WriteRegion(const Region& region)
+{
+    uint64_t event_id = ++m_event_id;
+    uint64_t name_id  = region.is_marker ? MarkerNameId(region.name)
+                                         : ApiCallNameId(region.kind, region.name);
+    bool     ok       = WriteEvent(event_id, region.is_marker ? kCategoryMarker : kCategoryHipApi,
+                                   region.id, region.parent_id);
+    for(uint32_t a = 0; ok && !region.is_marker && a < m_args_per_call; a++)
+    {
+        std::string value = std::to_string(region.id * 31 + a);
+        BindInt(m_insert_arg, 1, ++m_arg_id);
+        BindInt(m_insert_arg, 2, event_id);
+        BindInt(m_insert_arg, 3, a);
+        sqlite3_bind_text(m_insert_arg, 4, a == 0 ? "hipStream_t" : "void*", -1, SQLITE_STATIC);
+        sqlite3_bind_text(m_insert_arg, 5, a == 0 ? "stream" : "ptr", -1, SQLITE_STATIC);
+        BindText(m_insert_arg, 6, value);
+        ok = m_db.Step(m_insert_arg);
+    }
+    BindInt(m_insert_region, 1, region.id);
+    BindInt(m_insert_region, 2, m_node.id);
+    BindInt(m_insert_region, 3, region.pid);
+    BindInt(m_insert_region, 4, region.tid);
+    BindInt(m_insert_region, 5, region.start);
+    BindInt(m_insert_region, 6, region.end);
+    BindInt(m_insert_region, 7, name_id);
+    BindInt(m_insert_region, 8, event_id);
+    return ok && m_db.Step(m_insert_region);
+}
+
+bool
+RocprofWriter::WriteDispatch(const GpuOperation& dispatch)
+{
+    uint64_t event_id = ++m_event_id;
+    uint64_t queue_id = m_node.QueueId(dispatch.launch->process, dispatch.gpu, dispatch.queue);
+    bool     ok = WriteEvent(event_id, kCategoryKernelDispatch, dispatch.correlation_id, 0);
+    BindInt(m_insert_dispatch, 1, dispatch.id);
+    BindInt(m_insert_dispatch, 2, m_node.id);
+    BindInt(m_insert_dispatch, 3, dispatch.launch->pid);
+    BindInt(m_insert_dispatch, 4, dispatch.launch->tid);
+    BindInt(m_insert_dispatch, 5, m_node.GpuAgentId(dispatch.gpu));
+    BindInt(m_insert_dispatch, 6, dispatch.kernel + 1);
+    BindInt(m_insert_dispatch, 7, dispatch.id);
+    BindInt(m_insert_dispatch, 8, queue_id);
+    BindInt(m_insert_dispatch, 9, queue_id);
+    BindInt(m_insert_dispatch, 10, dispatch.start);
+    BindInt(m_insert_dispatch, 11, dispatch.end);
+    BindInt(m_insert_dispatch, 12, (dispatch.kernel % 4) * 16384);
+    BindInt(m_insert_dispatch, 13, 256);
+    BindInt(m_insert_dispatch, 14, 256 * (1 + dispatch.kernel % 1024));
+    BindInt(m_insert_dispatch, 15, ApiCallNameId(LeafKind::Launch, 0));
+    BindInt(m_insert_dispatch, 16, event_id);
+    ok = ok && m_db.Step(m_insert_dispatch);
+    for(uint32_t c = 0; ok && c < dispatch.counters.size(); c++)
+    {
+        BindInt(m_insert_pmc_event, 1, ++m_pmc_event_id);
+        BindInt(m_insert_pmc_event, 2, event_id);
+        BindInt(m_insert_pmc_event, 3, m_node.DispatchCounterId(dispatch.gpu, c));
+        sqlite3_bind_double(m_insert_pmc_event, 4, dispatch.counters[c]);
+        ok = m_db.Step(m_insert_pmc_event);
+    }
+    return ok;
+}
+
+bool
+RocprofWriter::WriteCopy(const GpuOperation& copy)
+{
+    uint64_t event_id = ++m_event_id;
+    uint64_t queue_id = m_node.QueueId(copy.launch->process, copy.gpu, copy.queue);
+    bool     ok       = WriteEvent(event_id, kCategoryMemoryCopy, copy.correlation_id, 0);
+    BindInt(m_insert_copy, 1, copy.id);
+    BindInt(m_insert_copy, 2, m_node.id);
+    BindInt(m_insert_copy, 3, copy.launch->pid);
+    BindInt(m_insert_copy, 4, copy.launch->tid);
+    BindInt(m_insert_copy, 5, copy.start);
+    BindInt(m_insert_copy, 6, copy.end);
+    BindInt(m_insert_copy, 7, kCopyHostToDevice);
+    BindInt(m_insert_copy, 8, m_node.GpuAgentId(copy.gpu));
+    BindInt(m_insert_copy, 9, copy.address);
+    BindInt(m_insert_copy, 10, m_node.CpuAgentId());
+    BindInt(m_insert_copy, 11, copy.address ^ 0x100000000000ull);
+    BindInt(m_insert_copy, 12, copy.size);
+    BindInt(m_insert_copy, 13, queue_id);
+    BindInt(m_insert_copy, 14, queue_id);
+    BindInt(m_insert_copy, 15, ApiCallNameId(LeafKind::Copy, 0));
+    BindInt(m_insert_copy, 16, event_id);
+    return ok && m_db.Step(m_insert_copy);
+}
+
+bool
+RocprofWriter::WriteAllocation(const GpuOperation& allocation, bool is_free)
+{
+    uint64_t event_id = ++m_event_id;
+    uint64_t queue_id = m_node.QueueId(allocation.launch->process, allocation.gpu, allocation.queue);
+    bool     ok       = WriteEvent(event_id, kCategoryMemoryAllocation, allocation.correlation_id, 0);
+    BindInt(m_insert_allocation, 1, ++m_allocation_id);
+    BindInt(m_insert_allocation, 2, m_node.id);
+    BindInt(m_insert_allocation, 3, allocation.launch->pid);
+    BindInt(m_insert_allocation, 4, allocation.launch->tid);
+    BindInt(m_insert_allocation, 5, m_node.GpuAgentId(allocation.gpu));
+    sqlite3_bind_text(m_insert_allocation, 6, is_free ? "FREE" : "ALLOC", -1, SQLITE_STATIC);
+    BindInt(m_insert_allocation, 7, allocation.start);
+    BindInt(m_insert_allocation, 8, allocation.end);
+    BindInt(m_insert_allocation, 9, allocation.address);
+    BindInt(m_insert_allocation, 10, is_free ? 0 : allocation.size);
+    BindInt(m_insert_allocation, 11, queue_id);
+    BindInt(m_insert_allocation, 12, queue_id);
+    BindInt(m_insert_allocation, 13, event_id);
+    return ok && m_db.Step(m_insert_allocation);
+}
+
+bool
+RocprofWriter::WriteCounterSample(const CounterSample& sample)
+{
+    uint64_t event_id = ++m_event_id;
+    bool     ok       = WriteEvent(event_id, kCategorySmi, 0, 0);
+    BindInt(m_insert_sample, 1, ++m_sample_id);
+    BindInt(m_insert_sample, 2, sample.gpu + 1);
+    BindInt(m_insert_sample, 3, sample.timestamp);
+    BindInt(m_insert_sample, 4, event_id);
+    ok = ok && m_db.Step(m_insert_sample);
+    for(uint32_t c = 0; ok && c < sample.values.size(); c++)
+    {
+        BindInt(m_insert_pmc_event, 1, ++m_pmc_event_id);
+        BindInt(m_insert_pmc_event, 2, event_id);
+        BindInt(m_insert_pmc_event, 3, m_node.SmiCounterId(sample.gpu, c));
+        sqlite3_bind_double(m_insert_pmc_event, 4, sample.values[c]);
+        ok = m_db.Step(m_insert_pmc_event);
+    }
+    return ok;
+}
+
+bool
+RocprofWriter::CreateViews(Database& db, const std::vector<std::string>& suffixes)
+{
+    const char* tables[] = { "metadata",     "string",         "info_node",        "info_process",
+                             "info_thread",  "info_agent",     "info_queue",       "info_stream",
+                             "info_pmc",     "info_code_object", "info_kernel_symbol", "track",
+                             "event",        "arg",            "pmc_event",        "region",
+                             "sample",       "kernel_dispatch", "memory_copy",     "memory_allocate" };
+    bool        ok       = true;
+    for(const char* table : tables)
+    {
+        std::string query = std::string("CREATE VIEW rocpd_") + table + " AS ";
+        for(size_t i = 0; i < suffixes.size(); i++)
+        {
+            query += (i > 0 ? " UNION ALL " : "") + std::string("SELECT * FROM rocpd_") + table + suffixes[i];
+        }
+        ok = ok && db.Exec(query + ";");
+    }
+    // the views the event details are read from
+    ok = ok &&
+         db.Exec("CREATE VIEW regions AS SELECT R.id, R.guid, C.string AS category, S.string AS name,"
+                 " R.nid, R.pid, R.tid, R.start, R.end, (R.end - R.start) AS duration, E.stack_id,"
+                 " E.parent_stack_id, E.correlation_id AS corr_id, R.event_id, R.extdata"
+                 " FROM rocpd_region R INNER JOIN rocpd_event E ON E.id = R.event_id AND E.guid = R.guid"
+                 " INNER JOIN rocpd_string S ON S.id = R.name_id AND S.guid = R.guid"
+                 " LEFT JOIN rocpd_string C ON C.id = E.category_id AND C.guid = R.guid;") &&
+         db.Exec("CREATE VIEW kernels AS SELECT K.id, K.guid, C.string AS category, S.display_name AS name,"
+                 " K.nid, K.pid, K.tid, K.agent_id, A.absolute_index AS agent_abs_index, K.queue_id,"
+                 " K.stream_id, K.dispatch_id, K.start, K.end, (K.end - K.start) AS duration,"
+                 " K.grid_size_x AS grid_x, K.grid_size_y AS grid_y, K.grid_size_z AS grid_z,"
+                 " K.workgroup_size_x AS workgroup_x, K.workgroup_size_y AS workgroup_y,"
+                 " K.workgroup_size_z AS workgroup_z, K.group_segment_size AS lds_size,"
+                 " K.private_segment_size AS scratch_size, RN.string AS region, E.stack_id,"
+                 " E.correlation_id AS corr_id, K.event_id"
+                 " FROM rocpd_kernel_dispatch K INNER JOIN rocpd_event E ON E.id = K.event_id AND E.guid = K.guid"
+                 " INNER JOIN rocpd_info_kernel_symbol S ON S.id = K.kernel_id AND S.guid = K.guid"
+                 " INNER JOIN rocpd_info_agent A ON A.id = K.agent_id AND A.guid = K.guid"
+                 " LEFT JOIN rocpd_string C ON C.id = E.category_id AND C.guid = K.guid"
+                 " LEFT JOIN rocpd_string RN ON RN.id = K.region_name_id AND RN.guid = K.guid;") &&
+         db.Exec("CREATE VIEW memory_copies AS SELECT M.id, M.guid, C.string AS category, S.string AS name,"
+                 " M.nid, M.pid, M.tid, M.start, M.end, (M.end - M.start) AS duration, M.size,"
+                 " M.src_agent_id, M.src_address, M.dst_agent_id, M.dst_address, M.queue_id, M.stream_id,"
+                 " RN.string AS region_name, E.stack_id, E.correlation_id AS corr_id, M.event_id"
+                 " FROM rocpd_memory_copy M INNER JOIN rocpd_event E ON E.id = M.event_id AND E.guid = M.guid"
+                 " INNER JOIN rocpd_string S ON S.id = M.name_id AND S.guid = M.guid"
+                 " LEFT JOIN rocpd_string C ON C.id = E.category_id AND C.guid = M.guid"
+                 " LEFT JOIN rocpd_string RN ON RN.id = M.region_name_id AND RN.guid = M.guid;") &&
+         db.Exec("CREATE VIEW memory_allocations AS SELECT M.id, M.guid, C.string AS category, M.nid,"
+                 " M.pid, M.tid, M.agent_id, M.type, M.level, M.start, M.end, (M.end - M.start) AS duration,"
+                 " M.address, M.size, M.queue_id, M.stream_id, E.stack_id, E.correlation_id AS corr_id,"
+                 " M.event_id FROM rocpd_memory_allocate M"
+                 " INNER JOIN rocpd_event E ON E.id = M.event_id AND E.guid = M.guid"
+                 " LEFT JOIN rocpd_string C ON C.id = E.category_id AND C.guid = M.guid;");
+    return ok;
+}
+
+// Legacy rocpd (rpd) schema. It has no nodes, allocations or dispatch counters; GPU
+// operations are linked to their API call through rocpd_api_ops.
+class RocpdWriter : public TraceWriter
+{
+public:
+    RocpdWriter(Database& db, const NodeShape& node, const TraceNames& names);
+
+    bool Initialize();
+    bool WriteRegion(const Region& region) override;
+    bool WriteDispatch(const GpuOperation& dispatch) override;
+    bool WriteCopy(const GpuOperation& copy) override;
+    bool WriteAllocation(const GpuOperation& allocation, bool is_free) override;
+    bool WriteCounterSample(const CounterSample& sample) override;
+
+private:
+    enum StringId
+    {
+        kEmptyString = 1,
+        kKernelExecution,
+        kCopyHostToDevice,
+        kLaunchArgs,
+        kFirstNameString
+    };
+
+    bool     CreateSchema();
+    bool     WriteOperation(const GpuOperation& operation, uint64_t description_id, uint64_t type_id);
+    uint64_t ApiCallNameId(const Region& region) const;
+
+    Database&         m_db;
+    const NodeShape&  m_node;
+    const TraceNames& m_names;
+    uint64_t          m_api_base;
+    uint64_t          m_kernel_base;
+    uint64_t          m_op_id;
+    uint64_t          m_monitor_id;
+    sqlite3_stmt*     m_insert_api;
+    sqlite3_stmt*     m_insert_op;
+    sqlite3_stmt*     m_insert_api_op;
+    sqlite3_stmt*     m_insert_kernel_api;
+    sqlite3_stmt*     m_insert_copy_api;
+    sqlite3_stmt*     m_insert_monitor;
+};
+
+RocpdWriter::RocpdWriter(Database& db, const NodeShape& node, const TraceNames& names)
+: m_db(db)
+, m_node(node)
+, m_names(names)
+, m_api_base(kFirstNameString + names.markers.size())
+, m_kernel_base(kFirstNameString + names.markers.size() + names.api_calls.size() + 4)
+, m_op_id(0)
+, m_monitor_id(0)
+, m_insert_api(nullptr)
+, m_insert_op(nullptr)
+, m_insert_api_op(nullptr)
+, m_insert_kernel_api(nullptr)
+, m_insert_copy_api(nullptr)
+, m_insert_monitor(nullptr)
+{}
+
+bool
+RocpdWriter::CreateSchema()
+{
+    bool ok =
+        m_db.Exec("CREATE TABLE rocpd_string (id INTEGER NOT NULL PRIMARY KEY, string VARCHAR(4096) NOT NULL);") &&
+        m_db.Exec("CREATE TABLE rocpd_op (id INTEGER NOT NULL PRIMARY KEY, gpuId INTEGER NOT NULL,"
+                  " queueId INTEGER NOT NULL, sequenceId INTEGER NOT NULL, completionSignal VARCHAR(18) NOT NULL,"
+                  " start INTEGER NOT NULL, \"end\" INTEGER NOT NULL, description_id INTEGER NOT NULL,"
+                  " opType_id INTEGER NOT NULL);") &&
+        m_db.Exec("CREATE TABLE rocpd_api (id INTEGER NOT NULL PRIMARY KEY, pid INTEGER NOT NULL,"
+                  " tid INTEGER NOT NULL, start INTEGER NOT NULL, \"end\" INTEGER NOT NULL,"
+                  " apiName_id INTEGER NOT NULL, args_id INTEGER NOT NULL);") &&
+        m_db.Exec("CREATE TABLE rocpd_api_ops (id INTEGER NOT NULL PRIMARY KEY, api_id INTEGER NOT NULL,"
+                  " op_id INTEGER NOT NULL);") &&
+        m_db.Exec("CREATE TABLE rocpd_kernelapi (api_ptr_id INTEGER NOT NULL PRIMARY KEY,"
+                  " stream VARCHAR(18) NOT NULL, gridX INTEGER NOT NULL, gridY INTEGER NOT NULL,"
+                  " gridZ INTEGER NOT NULL, workgroupX INTEGER NOT NULL, workgroupY INTEGER NOT NULL,"
+                  " workgroupZ INTEGER NOT NULL, groupSegmentSize INTEGER NOT NULL,"
+                  " privateSegmentSize INTEGER NOT NULL, codeObject_id INTEGER NOT NULL,"
+                  " kernelName_id INTEGER NOT NULL, kernelArgAddress VARCHAR(18) NOT NULL,"
+                  " aquireFence VARCHAR(8) NOT NULL, releaseFence VARCHAR(8) NOT NULL);") &&
+        m_db.Exec("CREATE TABLE rocpd_copyapi (api_ptr_id INTEGER NOT NULL PRIMARY KEY,"
+                  " stream VARCHAR(18) NOT NULL, size INTEGER NOT NULL, width INTEGER NOT NULL,"
+                  " height INTEGER NOT NULL, kind INTEGER NOT NULL, dst VARCHAR(18) NOT NULL,"
+                  " src VARCHAR(18) NOT NULL, dstDevice INTEGER NOT NULL, srcDevice INTEGER NOT NULL,"
+                  " sync BOOL NOT NULL, pinned BOOL NOT NULL);") &&
+        m_db.Exec("CREATE TABLE rocpd_monitor (id INTEGER NOT NULL PRIMARY KEY, deviceType VARCHAR(16) NOT NULL,"
+                  " deviceId INTEGER NOT NULL, monitorType VARCHAR(16) NOT NULL, start INTEGER NOT NULL,"
+                  " \"end\" INTEGER NOT NULL, value VARCHAR(255) NOT NULL);") &&
+        m_db.Exec("CREATE TABLE rocpd_metadata (id INTEGER NOT NULL PRIMARY KEY, tag VARCHAR(4096) NOT NULL,"
+                  " value VARCHAR(4096) NOT NULL);") &&
+        m_db.Exec("INSERT INTO rocpd_metadata (tag, value) VALUES ('schema_version', '" +
+                  std::to_string(ROCPD_SCHEMA_VERSION) + "');");
+    ok = ok &&
+         m_db.Exec("CREATE VIEW api AS SELECT rocpd_api.id, pid, tid, start, end, A.string AS apiName,"
+                   " B.string AS args FROM rocpd_api INNER JOIN rocpd_string A ON A.id = rocpd_api.apiName_id"
+                   " INNER JOIN rocpd_string B ON B.id = rocpd_api.args_id;") &&
+         m_db.Exec("CREATE VIEW op AS SELECT rocpd_op.id, gpuId, queueId, sequenceId, start, end,"
+                   " A.string AS description, B.string AS opType FROM rocpd_op"
+                   " INNER JOIN rocpd_string A ON A.id = rocpd_op.description_id"
+                   " INNER JOIN rocpd_string B ON B.id = rocpd_op.opType_id;") &&
+         m_db.Exec("CREATE VIEW kernel AS SELECT B.id, gpuId, queueId, B.start, B.end, (B.end - B.start) AS duration,"
+                   " stream, gridX, gridY, gridZ, workgroupX, workgroupY, workgroupZ, groupSegmentSize,"
+                   " privateSegmentSize, D.string AS kernelName FROM rocpd_api_ops A"
+                   " INNER JOIN rocpd_op B ON B.id = A.op_id INNER JOIN rocpd_kernelapi C ON C.api_ptr_id = A.api_id"
+                   " INNER JOIN rocpd_string D ON D.id = C.kernelName_id;") &&
+         m_db.Exec("CREATE VIEW copy AS SELECT B.id, pid, tid, start, end, C.string AS apiName, stream, size,"
+                   " width, height, kind, dst, src, dstDevice, srcDevice, sync, pinned FROM rocpd_copyApi A"
+                   " INNER JOIN rocpd_api B ON B.id = A.api_ptr_id INNER JOIN rocpd_string C ON C.id = B.apiName_id;") &&
+         m_db.Exec("CREATE VIEW copyop AS SELECT B.id, gpuId, queueId, B.start, B.end, (B.end - B.start) AS duration,"
+                   " stream, size, width, height, kind, dst, src, dstDevice, srcDevice, sync, pinned,"
+                   " E.string AS apiName FROM rocpd_api_ops A INNER JOIN rocpd_op B ON B.id = A.op_id"
+                   " INNER JOIN rocpd_copyapi C ON C.api_ptr_id = A.api_id INNER JOIN rocpd_api D ON D.id = A.api_id"
+                   " INNER JOIN rocpd_string E ON E.id = D.apiName_id;");
+    if(!ok)
+    {
+        return false;
+    }
+
+    sqlite3_stmt* insert_string = m_db.Prepare("INSERT INTO rocpd_string (id, string) VALUES (?, ?);");
+    uint64_t      string_id     = 1;
+    auto          add_string    = [&](const std::string& value) {
+        BindInt(insert_string, 1, string_id++);
+        BindText(insert_string, 2, value);
+        return m_db.Step(insert_string);
+    };
+    ok = add_string("") && add_string("KernelExecution") && add_string("CopyHostToDevice") &&
+         add_string("stream=0x0");
+    for(const std::string& value : m_names.markers)
+    {
+        ok = ok && add_string(value);
+    }
+    for(const std::string& value : m_names.api_calls)
+    {
+        ok = ok && add_string(value);
+    }
+    for(const char* value : { "hipLaunchKernel", "hipMemcpyAsync", "hipMalloc", "hipFree" })
+    {
+        ok = ok && add_string(value);
+    }
+    for(const std::string& value : m_names.kernels)
+    {
+        ok = ok && add_string(value);
+    }
+    return ok;
+}
+
+bool
+RocpdWriter::Initialize()
+{
+    if(!CreateSchema())
+    {
+        return false;
+    }
+    m_insert_api = m_db.Prepare("INSERT INTO rocpd_api (id, pid, tid, start, \"end\", apiName_id, args_id)"
+                                " VALUES (?, ?, ?, ?, ?, ?, ?);");
+    m_insert_op  = m_db.Prepare("INSERT INTO rocpd_op (id, gpuId, queueId, sequenceId, completionSignal, start,"
+                                " \"end\", description_id, opType_id) VALUES (?, ?, ?, ?, '', ?, ?, ?, ?);");
+    m_insert_api_op = m_db.Prepare("INSERT INTO rocpd_api_ops (api_id, op_id) VALUES (?, ?);");
+    m_insert_kernel_api =
+        m_db.Prepare("INSERT INTO rocpd_kernelapi (api_ptr_id, stream, gridX, gridY, gridZ, workgroupX,"
+                     " workgroupY, workgroupZ, groupSegmentSize, privateSegmentSize, codeObject_id,"
+                     " kernelName_id, kernelArgAddress, aquireFence, releaseFence)"
+                     " VALUES (?, ?, ?, 1, 1, 256, 1, 1, 0, 0, 1, ?, '', '', '');");
+    m_insert_copy_api =
+        m_db.Prepare("INSERT INTO rocpd_copyapi (api_ptr_id, stream, size, width, height, kind, dst, src,"
+                     " dstDevice, srcDevice, sync, pinned) VALUES (?, ?, ?, 0, 0, 1, '', '', ?, 0, 0, 0);");
+    m_insert_monitor = m_db.Prepare("INSERT INTO rocpd_monitor (id, deviceType, deviceId, monitorType, start,"
+                                    " \"end\", value) VALUES (?, 'gpu', ?, ?, ?, ?, ?);");
+    return m_insert_api && m_insert_op && m_insert_api_op && m_insert_kernel_api && m_insert_copy_api &&
+           m_insert_monitor;
+}
+
+uint64_t
+RocpdWriter::ApiCallNameId(const Region& region) const
+{
+    if(region.is_marker)
+    {
+        return kFirstNameString + region.name;
+    }
+    uint64_t launch_base = m_api_base + m_names.api_calls.size();
+    switch(region.kind)
+    {
+        case LeafKind::Launch: return launch_base;
+        case LeafKind::Copy: return launch_base + 1;
+        case LeafKind::Allocate: return launch_base + 2;
+        case LeafKind::Free: return launch_base + 3;
+        default: return m_api_base + region.name;
+    }
+}
+
+bool
+RocpdWriter::WriteRegion(const Region& region)
+{
+    BindInt(m_insert_api, 1, region.id);
+    BindInt(m_insert_api, 2, region.pid);
+    BindInt(m_insert_api, 3, region.tid);
+    BindInt(m_insert_api, 4, region.start);
+    BindInt(m_insert_api, 5, region.end);
+    BindInt(m_insert_api, 6, ApiCallNameId(region));
+    BindInt(m_insert_api, 7, region.is_marker ? kEmptyString : kLaunchArgs);
+    return m_db.Step(m_insert_api);
+}
+
+bool
+RocpdWriter::WriteOperation(const GpuOperation& operation, uint64_t description_id, uint64_t type_id)
+{
+    uint64_t op_id = ++m_op_id;
+    BindInt(m_insert_op, 1, op_id);
+    BindInt(m_insert_op, 2, m_node.GpuAgentId(operation.gpu));
+    BindInt(m_insert_op, 3, m_node.QueueId(operation.launch->process, operation.gpu, operation.queue));
+    BindInt(m_insert_op, 4, operation.id);
+    BindInt(m_insert_op, 5, operation.start);
+    BindInt(m_insert_op, 6, operation.end);
+    BindInt(m_insert_op, 7, description_id);
+    BindInt(m_insert_op, 8, type_id);
+    bool ok = m_db.Step(m_insert_op);
+    if(ok && operation.correlation_id != 0)
+    {
+        BindInt(m_insert_api_op, 1, operation.correlation_id);
+        BindInt(m_insert_api_op, 2, op_id);
+        ok = m_db.Step(m_insert_api_op);
+    }
+    return ok;
+}
+
+bool
+RocpdWriter::WriteDispatch(const GpuOperation& dispatch)
+{
+    std::string stream = "0x" + std::to_string(dispatch.queue);
+    BindInt(m_insert_kernel_api, 1, dispatch.launch->id);
+    BindText(m_insert_kernel_api, 2, stream);
+    BindInt(m_insert_kernel_api, 3, 256 * (1 + dispatch.kernel % 1024));
+    BindInt(m_insert_kernel_api, 4, m_kernel_base + dispatch.kernel);
+    return m_db.Step(m_insert_kernel_api) &&
+           WriteOperation(dispatch, m_kernel_base + dispatch.kernel, kKernelExecution);
+}
+
+bool
+RocpdWriter::WriteCopy(const GpuOperation& copy)
+{
+    std::string stream = "0x" + std::to_string(copy.queue);
+    BindInt(m_insert_copy_api, 1, copy.launch->id);
+    BindText(m_insert_copy_api, 2, stream);
+    BindInt(m_insert_copy_api, 3, copy.size);
+    BindInt(m_insert_copy_api, 4, m_node.GpuAgentId(copy.gpu));
+    return m_db.Step(m_insert_copy_api) && WriteOperation(copy, kEmptyString, kCopyHostToDevice);
+}
+
+bool
+RocpdWriter::WriteAllocation(const GpuOperation& allocation, bool is_free)
+{
+    // only the hipMalloc and hipFree calls are recorded
+    (void) allocation;
+    (void) is_free;
+    return true;
+}
+
+bool
+RocpdWriter::WriteCounterSample(const CounterSample& sample)
+{
+    bool ok = true;
+    for(uint32_t c = 0; ok && c < sample.values.size(); c++)
+    {
+        std::string value = std::to_string(sample.values[c]);
+        BindInt(m_insert_monitor, 1, ++m_monitor_id);
+        BindInt(m_insert_monitor, 2, m_node.GpuAgentId(sample.gpu));
+        sqlite3_bind_text(m_insert_monitor, 3, s_smi_counter_names[c], -1, SQLITE_STATIC);
+        BindInt(m_insert_monitor, 4, sample.timestamp);
+        BindInt(m_insert_monitor, 5, sample.timestamp);
+        BindText(m_insert_monitor, 6, value);
+        ok = m_db.Step(m_insert_monitor);
+    }
+    return ok;
+}
+
+// Lays out the events of one node and hands them to the writer in completion order
+class NodeGenerator
+{
+public:
+    NodeGenerator(const GeneratorOptions& options, const NodeShape& node, TraceWriter& writer,
+                  GeneratorStats& stats);
+
+    bool Run();
+
+private:
+    struct QueueState
+    {
+        uint64_t busy_until = 0;
+    };
+
+    struct ThreadState
+    {
+        uint32_t                  process;
+        uint64_t                  pid;
+        uint64_t                  tid;
+        uint32_t                  gpu;
+        uint64_t                  regions;
+        std::vector<GpuOperation> allocations;
+    };
+
+    uint64_t EmitRegion(ThreadState& thread, uint64_t parent_id, uint32_t depth, uint64_t start);
+    bool     EmitLeafOperation(ThreadState& thread, const Region& region);
+    bool     EmitCounterSamples();
+    uint64_t Duration(uint64_t min_ns, uint64_t max_ns);
+    QueueState& Queue(const ThreadState& thread, uint32_t gpu, uint32_t queue);
+
+    const GeneratorOptions& m_options;
+    const NodeShape&        m_node;
+    TraceWriter&            m_writer;
+    GeneratorStats&         m_stats;
+    Random                  m_random;
+    std::vector<QueueState> m_queues;
+    uint64_t                m_region_id;
+    uint64_t                m_operation_id;
+    uint64_t                m_trace_end;
+    bool                    m_ok;
+};
+
+NodeGenerator::NodeGenerator(const GeneratorOptions& options, const NodeShape& node,
+                             TraceWriter& writer, GeneratorStats& stats)
+: m_options(options)
+, m_node(node)
+, m_writer(writer)
+, m_stats(stats)
+, m_random(options.seed * 7919 + node.index)
+, m_queues(node.processes.size() * node.gpus * node.queues)
+, m_region_id(0)
+, m_operation_id(0)
+, m_trace_end(TRACE_BASE_TIMESTAMP)
+, m_ok(true)
+{}
+
+uint64_t
+NodeGenerator::Duration(uint64_t min_ns, uint64_t max_ns)
+{
+    // mostly short with a long tail
+    double u = m_random.Uniform();
+    return min_ns + static_cast<uint64_t>((max_ns - min_ns) * u * u);
+}
+
+NodeGenerator::QueueState&
+NodeGenerator::Queue(const ThreadState& thread, uint32_t gpu, uint32_t queue)
+{
+    return m_queues[m_node.QueueId(thread.process, gpu, queue) - 1];
+}
+
+bool
+NodeGenerator::EmitLeafOperation(ThreadState& thread, const Region& region)
+{
+    GpuOperation operation;
+    operation.id             = ++m_operation_id;
+    operation.launch         = &region;
+    operation.correlation_id = m_random.Chance(m_options.flow_density) ? region.id : 0;
+    operation.gpu            = thread.gpu;
+    operation.queue          = static_cast<uint32_t>(m_random.Range(0, m_node.queues - 1));
+    operation.kernel         = 0;
+    operation.size           = 0;
+    operation.address        = 0;
+    QueueState& queue        = Queue(thread, operation.gpu, operation.queue);
+    operation.start          = std::max(region.start + 2000, queue.busy_until + 500);
+    bool ok                  = true;
+    switch(region.kind)
+    {
+        case LeafKind::Launch:
+        {
+            operation.kernel = m_random.Skewed(m_options.kernel_names);
+            // every kernel has a typical duration, the dispatch varies around it
+            uint64_t typical = 5000 + (operation.kernel * 2654435761ull) % 500000;
+            operation.end    = operation.start + typical / 2 + Duration(0, typical);
+            for(uint32_t c = 0; c < m_node.dispatch_counters; c++)
+            {
+                operation.counters.push_back(static_cast<double>(m_random.Range(0, 1u << 24)));
+            }
+            queue.busy_until = operation.end;
+            ok               = m_writer.WriteDispatch(operation);
+            break;
+        }
+        case LeafKind::Copy:
+        {
+            operation.size    = 4096ull << m_random.Range(0, 16);
+            operation.address = ALLOCATION_BASE_ADDRESS + m_random.Range(0, 1ull << 36);
+            // about 50 GB/s
+            operation.end    = operation.start + 1000 + operation.size / 50;
+            queue.busy_until = operation.end;
+            ok               = m_writer.WriteCopy(operation);
+            break;
+        }
+        case LeafKind::Allocate:
+        {
+            operation.size    = 4096ull << m_random.Range(0, 18);
+            operation.address = ALLOCATION_BASE_ADDRESS + (operation.id << 24);
+            operation.start   = region.start + 500;
+            operation.end     = region.end - 500;
+            thread.allocations.push_back(operation);
+            ok = m_writer.WriteAllocation(operation, false);
+            break;
+        }
+        case LeafKind::Free:
+        {
+            if(!thread.allocations.empty())
+            {
+                GpuOperation allocation = thread.allocations.front();
+                thread.allocations.erase(thread.allocations.begin());
+                allocation.id             = operation.id;
+                allocation.launch         = &region;
+                allocation.correlation_id = operation.correlation_id;
+                allocation.start          = region.start + 500;
+                allocation.end            = region.end - 500;
+                ok = m_writer.WriteAllocation(allocation, true);
+            }
+            return ok;
+        }
+        default: return true;
+    }
+    m_trace_end = std::max(m_trace_end, operation.end);
+    m_stats.gpu_operations.fetch_add(1, std::memory_order_relaxed);
+    return ok;
+}
+
+uint64_t
+NodeGenerator::EmitRegion(ThreadState& thread, uint64_t parent_id, uint32_t depth, uint64_t start)
+{
+    Region region;
+    region.id        = ++m_region_id;
+    region.parent_id = parent_id;
+    region.process   = thread.process;
+    region.pid       = thread.pid;
+    region.tid       = thread.tid;
+    region.start     = start;
+    region.is_marker = depth + 1 < m_options.depth;
+    region.kind      = LeafKind::Call;
+    thread.regions++;
+    if(region.is_marker)
+    {
+        region.name  = m_random.Skewed(m_options.marker_names);
+        uint64_t end = start + Duration(200, 5000);
+        for(uint32_t c = 0; c < m_options.fanout && thread.regions < m_options.regions_per_thread; c++)
+        {
+            end = EmitRegion(thread, region.id, depth + 1, end) + Duration(200, 5000);
+        }
+        region.end = end;
+    }
+    else
+    {
+        double kind = m_random.Uniform();
+        if(kind < m_options.launch_ratio)
+        {
+            region.kind = LeafKind::Launch;
+        }
+        else if(kind < m_options.launch_ratio + m_options.copy_ratio)
+        {
+            region.kind = LeafKind::Copy;
+        }
+        else if(kind < m_options.launch_ratio + m_options.copy_ratio + m_options.alloc_ratio)
+        {
+            region.kind = thread.allocations.size() > 4 || (!thread.allocations.empty() && m_random.Chance(0.5))
+                              ? LeafKind::Free
+                              : LeafKind::Allocate;
+        }
+        region.name = static_cast<uint32_t>(m_random.Range(0, sizeof(s_hip_api_names) / sizeof(s_hip_api_names[0]) - 1));
+        region.end  = start + Duration(1000, 20000);
+        m_ok        = m_ok && EmitLeafOperation(thread, region);
+    }
+    m_ok        = m_ok && m_writer.WriteRegion(region);
+    m_trace_end = std::max(m_trace_end, region.end);
+    uint64_t total = m_stats.regions.fetch_add(1, std::memory_order_relaxed) + 1;
+    if(total % PROGRESS_REGION_STEP == 0)
+    {
+        std::cerr << "  " << total << " regions, " << m_stats.rows.load() << " rows" << std::endl;
+    }
+    return region.end;
+}
+
+bool
+NodeGenerator::EmitCounterSamples()
+{
+    if(m_node.smi_counters == 0)
+    {
+        return true;
+    }
+    uint64_t interval = static_cast<uint64_t>(1e9 / m_options.smi_rate);
+    for(uint32_t g = 0; g < m_node.gpus && m_ok; g++)
+    {
+        CounterSample sample;
+        sample.gpu = g;
+        sample.values.assign(m_node.smi_counters, 50.0);
+        for(uint64_t ts = TRACE_BASE_TIMESTAMP; ts <= m_trace_end && m_ok; ts += interval)
+        {
+            sample.timestamp = ts;
+            for(double& value : sample.values)
+            {
+                // random walk within [0, 100]
+                value = std::min(100.0, std::max(0.0, value + (m_random.Uniform() - 0.5) * 10.0));
+            }
+            m_ok = m_writer.WriteCounterSample(sample);
+            m_stats.samples.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    return m_ok;
+}
+
+bool
+NodeGenerator::Run()
+{
+    for(uint32_t p = 0; p < m_node.processes.size() && m_ok; p++)
+    {
+        const ProcessShape& process = m_node.processes[p];
+        for(uint32_t t = 0; t < process.tids.size() && m_ok; t++)
+        {
+            ThreadState thread;
+            thread.process = p;
+            thread.pid     = process.pid;
+            thread.tid     = process.tids[t];
+            thread.gpu     = static_cast<uint32_t>((p * process.tids.size() + t) % m_node.gpus);
+            thread.regions = 0;
+            // threads start staggered within the first millisecond
+            uint64_t cursor = TRACE_BASE_TIMESTAMP + m_random.Range(0, 1000000);
+            while(thread.regions < m_options.regions_per_thread && m_ok)
+            {
+                cursor = EmitRegion(thread, 0, 0, cursor) + Duration(1000, 50000);
+            }
+        }
+    }
+    return m_ok && EmitCounterSamples();
+}
+
+// Generates the nodes into one database
+static bool
+GenerateDatabase(const GeneratorOptions& options, const TraceNames& names,
+                 const std::vector<NodeShape>& nodes, const std::string& path, GeneratorStats& stats)
+{
+    Database db(stats);
+    if(!db.Open(path))
+    {
+        return false;
+    }
+    bool                     ok = true;
+    std::vector<std::string> suffixes;
+    for(const NodeShape& node : nodes)
+    {
+        if(options.format == TraceFormat::Rocprof)
+        {
+            RocprofWriter writer(db, node, names, options.args_per_call);
+            NodeGenerator generator(options, node, writer, stats);
+            ok = ok && writer.Initialize() && generator.Run();
+            std::string suffix = node.guid;
+            std::replace(suffix.begin(), suffix.end(), '-', '_');
+            suffixes.push_back("_" + suffix);
+        }
+        else
+        {
+            RocpdWriter   writer(db, node, names);
+            NodeGenerator generator(options, node, writer, stats);
+            ok = ok && writer.Initialize() && generator.Run();
+        }
+        db.FinalizeStatements();
+    }
+    if(ok && options.format == TraceFormat::Rocprof)
+    {
+        ok = RocprofWriter::CreateViews(db, suffixes);
+    }
+    return db.Close() && ok;
+}
+
+int
+main(int argc, char** argv)
+{
+    GeneratorOptions options;
+    if(!ParseOptions(argc, argv, options))
+    {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    TraceNames             names = BuildNames(options);
+    std::vector<NodeShape> nodes;
+    for(uint32_t n = 0; n < options.nodes; n++)
+    {
+        nodes.push_back(BuildNodeShape(options, n));
+    }
+
+    GeneratorStats stats;
+    auto           start = std::chrono::steady_clock::now();
+    bool           ok    = true;
+    std::vector<std::string> files;
+    if(EndsWith(options.output_file, ".yaml"))
+    {
+        // one database per node, generated in parallel
+        std::filesystem::path yaml_path(options.output_file);
+        std::filesystem::path directory = yaml_path.parent_path();
+        std::string           stem      = yaml_path.stem().string();
+        std::vector<std::thread> threads;
+        std::mutex               mutex;
+        for(const NodeShape& node : nodes)
+        {
+            std::string file = stem + "_node" + std::to_string(node.index) + ".db";
+            files.push_back((directory / file).string());
+        }
+        for(size_t n = 0; n < nodes.size(); n++)
+        {
+            threads.emplace_back([&, n]() {
+                bool result = GenerateDatabase(options, names, { nodes[n] }, files[n], stats);
+                std::lock_guard<std::mutex> lock(mutex);
+                ok = ok && result;
+            });
+        }
+        for(std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        std::ofstream yaml(options.output_file);
+        yaml << "rocprofiler-sdk:\n  rocpd:\n    files:\n";
+        for(const std::string& file : files)
+        {
+            yaml << "      - " << std::filesystem::path(file).filename().string() << "\n";
+        }
+        ok = ok && yaml.good();
+    }
+    else
+    {
+        files.push_back(options.output_file);
+        ok = GenerateDatabase(options, names, nodes, options.output_file, stats);
+    }
+
+    double   seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    uint64_t bytes   = 0;
+    for(const std::string& file : files)
+    {
+        std::error_code error;
+        uint64_t        size = std::filesystem::file_size(file, error);
+        bytes += error ? 0 : size;
+    }
+    std::cout << (ok ? "Generated " : "Failed after ") << stats.regions.load() << " regions, "
+              << stats.gpu_operations.load() << " GPU operations and " << stats.samples.load()
+              << " counter samples (" << stats.rows.load() << " rows, " << bytes / (1024 * 1024)
+              << " MB) in " << seconds << " s" << std::endl;
+    return ok ? 0 : 1;
+}
@@ -87,5 +87,41 @@ EventModel::GetEventTimeRange(const std::vector<uint64_t>& event_ids, double& st
     return found;
 }
 
+const std::vector<FlowEdgeData>&
+EventModel::GetFlowRangeEdges() const
+{
+    return m_flow_range_edges;
+}
+
+void
+EventModel::SetFlowRangeEdges(double start_ts, double end_ts,
+                              std::vector<uint64_t>       track_ids,
+                              std::vector<FlowEdgeData>&& edges)
+{
+    m_flow_range_start_ts  = start_ts;
+    m_flow_range_end_ts    = end_ts;
+    m_flow_range_track_ids = std::move(track_ids);
+    m_flow_range_edges     = std::move(edges);
+}
+
+void
+EventModel::ClearFlowRangeEdges()
+{
+    m_flow_range_edges.clear();
+    m_flow_range_track_ids.clear();
+    m_flow_range_start_ts = 0;
+    m_flow_range_end_ts   = 0;
+}
+
+bool
+EventModel::FlowRangeContains(double start_ts, double end_ts,
+                              const std::vector<uint64_t>& track_ids) const
+{
+    return m_flow_range_start_ts < m_flow_range_end_ts &&
+           m_flow_range_start_ts <= start_ts && end_ts <= m_flow_range_end_ts &&
+           std::includes(m_flow_range_track_ids.begin(), m_flow_range_track_ids.end(),
+                         track_ids.begin(), track_ids.end());
+}
+
 }  // namespace View
 }  // namespace RocProfVis
@@ -6,6 +6,7 @@
 #include "rocprofvis_model_types.h"
 
 #include <unordered_map>
+#include <vector>
 
 namespace RocProfVis
 {
@@ -33,8 +34,21 @@ public:
     bool GetEventTimeRange(const std::vector<uint64_t>& event_ids, double& start_ts_out,
                            double& end_ts_out) const;
 
+    // Flow edges of the visible time range
+    const std::vector<FlowEdgeData>& GetFlowRangeEdges() const;
+    // track_ids must be sorted
+    void SetFlowRangeEdges(double start_ts, double end_ts, std::vector<uint64_t> track_ids,
+                           std::vector<FlowEdgeData>&& edges);
+    void ClearFlowRangeEdges();
+    bool FlowRangeContains(double start_ts, double end_ts,
+                           const std::vector<uint64_t>& track_ids) const;
+
 private:
     std::unordered_map<uint64_t, EventInfo> m_event_data;
+    std::vector<FlowEdgeData>               m_flow_range_edges;
+    std::vector<uint64_t>                   m_flow_range_track_ids;
+    double                                  m_flow_range_start_ts = 0;
+    double                                  m_flow_range_end_ts   = 0;
 };
 
 }  // namespace View
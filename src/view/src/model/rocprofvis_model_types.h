@@ -117,6 +117,13 @@ struct EventFlowData
     std::string name;
 };
 
+// Origin / target pair of a flow edge that was read for a time range
+struct FlowEdgeData
+{
+    EventFlowData origin;
+    EventFlowData target;
+};
+
 struct CallStackData
 {
     std::string  file;
@@ -114,6 +114,7 @@ TraceDataModel::Clear()
     m_tables.ClearAllTables();
     m_summary.Clear();
     m_events.ClearEvents();
+    m_events.ClearFlowRangeEdges();
     m_analysis.Clear();
     m_trace_file_path.clear();
     m_compare_sources.clear();
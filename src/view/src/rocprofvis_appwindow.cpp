@@ -11,6 +11,7 @@
 
 #include "rocprofvis_appmonitor.h"
 #include "rocprofvis_controller.h"
+#include "rocprofvis_core_profile.h"
 #include "rocprofvis_events.h"
 #include "rocprofvis_project.h"
 #include "rocprofvis_settings_manager.h"
@@ -115,6 +116,8 @@ AppWindow::AppWindow()
 , m_font_changed_token(EventManager::InvalidSubscriptionToken)
 #ifdef ROCPROFVIS_DEVELOPER_MODE
 , m_show_debug_window(false)
+, m_show_query_profiler(false)
+, m_show_memory_usage(false)
 , m_show_provider_test_widow(false)
 , m_show_metrics(false)
 #endif
@@ -1254,6 +1257,21 @@ AppWindow::RenderHelpMenu()
         {
             m_open_about_dialog = true;
         }
+        ImGui::Separator();
+        // Self-profiling capture for diagnosing slow traces, opens in Optiq itself
+        bool capturing = Core::Profiler::IsEnabled();
+        if(ImGui::MenuItem("Record Performance Capture", nullptr, capturing))
+        {
+            if(!capturing)
+            {
+                Core::Profiler::Clear();
+            }
+            Core::Profiler::SetEnabled(!capturing);
+        }
+        if(ImGui::MenuItem("Save Performance Capture..."))
+        {
+            HandleSavePerformanceCapture();
+        }
         ImGui::EndMenu();
     }
 }
@@ -1326,6 +1344,26 @@ AppWindow::HandleSaveAsFile()
     }
 }
 
+void
+AppWindow::HandleSavePerformanceCapture()
+{
+    FileFilter capture_filter;
+    capture_filter.m_name       = "Chrome Trace";
+    capture_filter.m_extensions = { "json" };
+
+    std::vector<FileFilter> filters;
+    filters.push_back(capture_filter);
+
+    ShowSaveFileDialog("Save Performance Capture", filters, "",
+                       [this](std::string file_path) {
+                           if(!Core::Profiler::ExportChromeTrace(file_path))
+                           {
+                               ShowMessageDialog("Performance Capture",
+                                                 "Failed to write " + file_path);
+                           }
+                       });
+}
+
 void
 AppWindow::HandleTabClosed(std::shared_ptr<RocEvent> e)
 {
@@ -1887,6 +1925,16 @@ AppWindow::RenderDeveloperMenu()
                 ImGui::SetWindowFocus("Debug Window");
             }
         }
+        // Toggle SQL query statistics of the current trace
+        if(ImGui::MenuItem("Show Query Profiler", nullptr, m_show_query_profiler))
+        {
+            m_show_query_profiler = !m_show_query_profiler;
+        }
+        // Toggle memory breakdown of the current trace
+        if(ImGui::MenuItem("Show Memory Usage", nullptr, m_show_memory_usage))
+        {
+            m_show_memory_usage = !m_show_memory_usage;
+        }
         // Open a file to test the DataProvider
         if(ImGui::MenuItem("Test Provider", nullptr))
         {
@@ -2053,6 +2101,28 @@ AppWindow::RenderDebugOuput()
         DebugWindow::GetInstance()->Render();
     }
 
+    if(m_show_query_profiler || m_show_memory_usage)
+    {
+        Project*      project       = GetCurrentProject();
+        DataProvider* data_provider = nullptr;
+        if(project)
+        {
+            RootView* root_view = dynamic_cast<RootView*>(project->GetView().get());
+            if(root_view)
+            {
+                data_provider = root_view->GetDataProvider();
+            }
+        }
+        if(m_show_query_profiler)
+        {
+            m_query_profiler.Render(data_provider, &m_show_query_profiler);
+        }
+        if(m_show_memory_usage)
+        {
+            m_memory_usage.Render(data_provider, &m_show_memory_usage);
+        }
+    }
+
     if(m_show_provider_test_widow)
     {
         RenderProviderTest(m_test_data_provider);
@@ -13,6 +13,8 @@
 #include "rocprofvis_view_module.h"
 #include "widgets/rocprofvis_split_containers.h"
 #include "widgets/rocprofvis_tab_container.h"
+#include "widgets/rocprofvis_memory_panel.h"
+#include "widgets/rocprofvis_query_profiler.h"
 // TEMPORARY (remote/SSH): the SSH test dialog is a remote-only dev aid.
 // Remove this guard when the remote feature graduates.
 #ifdef ROCPROFVIS_ENABLE_REMOTE
@@ -141,6 +143,7 @@ private:
     void HandleCompareFiles();
     void HandleCompareFileBrowse(CompareFilesDialog::FileSlot slot);
     void HandleSaveAsFile();
+    void HandleSavePerformanceCapture();
     void ConfigureFileDialogBackend();
     void BeginAppShutdown();
     void DetachProjectProviderCleanup(Project& project, ProviderCleanupReason reason);
@@ -187,6 +190,10 @@ private:
 #endif
     bool         m_show_metrics;
     bool         m_show_debug_window;
+    bool         m_show_query_profiler;
+    QueryProfilerWindow m_query_profiler;
+    bool         m_show_memory_usage;
+    MemoryUsageWindow m_memory_usage;
     DataProvider m_test_data_provider;
     bool         m_show_provider_test_widow;
 #endif
@@ -60,6 +60,12 @@ const uint64_t DataProvider::FETCH_COMPUTE_TRACE_REQUEST_ID =
     RequestIdBuilder::MakeRequestId(RequestType::kFetchComputeTrace);
 const uint64_t DataProvider::METRIC_PIVOT_TABLE_REQUEST_ID =
     RequestIdBuilder::MakeRequestId(RequestType::kFetchMetricPivotTable);
+const uint64_t DataProvider::FLOW_RANGE_REQUEST_ID =
+    RequestIdBuilder::MakeRequestId(RequestType::kFetchFlowRange);
+const uint64_t DataProvider::PREFETCH_TRACKS_REQUEST_ID =
+    RequestIdBuilder::MakeRequestId(RequestType::kPrefetchTracks);
+const uint64_t DataProvider::MEMORY_REPORT_REQUEST_ID =
+    RequestIdBuilder::MakeRequestId(RequestType::kFetchMemoryReport);
 
 DataProvider::DataProvider()
 : m_state(ProviderState::kInit)
@@ -74,6 +80,7 @@ DataProvider::DataProvider()
 , m_cleanup_database_callback(nullptr)
 , m_table_export_callback(nullptr)
 , m_progress_percent(0)
+, m_memory_report_ready(false)
 , m_model()
 {}
 
@@ -103,6 +110,10 @@ DataProvider::SetSelectedState(const std::string& id)
 void
 DataProvider::FreeRequests()
 {
+    // Conversions read controller data, finish them before the requests are freed
+    m_track_converter.Cancel();
+    m_converted_responses.clear();
+
     DataProviderCleanupWork cleanup_work;
     cleanup_work.trace_file_path = m_model.GetTraceFilePath();
     cleanup_work.requests        = std::move(m_requests);
@@ -120,6 +131,10 @@ DataProvider::GetPendingRequestCount() const
 DataProviderCleanupWork
 DataProvider::DetachCleanupWork()
 {
+    // Conversions read controller data, finish them before the controller is released
+    m_track_converter.Cancel();
+    m_converted_responses.clear();
+
     DataProviderCleanupWork cleanup_work;
     cleanup_work.trace_file_path = m_model.GetTraceFilePath();
     cleanup_work.requests        = std::move(m_requests);
@@ -131,6 +146,8 @@ DataProvider::DetachCleanupWork()
     m_model.Clear();
     m_progress_mesage.clear();
     m_progress_percent = 0;
+    m_memory_report       = MemoryReport();
+    m_memory_report_ready = false;
     m_state            = ProviderState::kInit;
 
     return cleanup_work;
@@ -190,6 +207,11 @@ DataProvider::CleanupDetachedResources(DataProviderCleanupWork cleanup_work)
         }
         if(req.request_obj_handle)
         {
+            // the memory report is owned by its request, other objects by the controller
+            if(req.request_type == RequestType::kFetchMemoryReport)
+            {
+                rocprofvis_controller_memory_report_free(req.request_obj_handle);
+            }
             req.request_obj_handle = nullptr;
         }
     }
@@ -1313,6 +1335,251 @@ DataProvider::SaveTrimmedTrace(const std::string& path, double start_ns, double
     return false;
 }
 
+bool
+DataProvider::SetQueryTelemetry(bool enabled, double slow_query_ms)
+{
+    if(m_trace_controller == nullptr)
+    {
+        return false;
+    }
+    rocprofvis_result_t result = rocprofvis_controller_set_query_telemetry(
+        m_trace_controller, enabled ? 1 : 0, slow_query_ms);
+    return result == kRocProfVisResultSuccess;
+}
+
+bool
+DataProvider::ClearQueryTelemetry()
+{
+    if(m_trace_controller == nullptr)
+    {
+        return false;
+    }
+    return rocprofvis_controller_query_telemetry_clear(m_trace_controller) ==
+           kRocProfVisResultSuccess;
+}
+
+bool
+DataProvider::FetchQueryTelemetry(std::vector<QueryTelemetryStats>& queries,
+                                  std::vector<SlowQueryInfo>&       slow_queries)
+{
+    queries.clear();
+    slow_queries.clear();
+    if(m_state != ProviderState::kReady)
+    {
+        return false;
+    }
+
+    rocprofvis_controller_query_telemetry_t* telemetry =
+        rocprofvis_controller_query_telemetry_alloc();
+    ROCPROFVIS_ASSERT(telemetry);
+
+    rocprofvis_result_t result =
+        rocprofvis_controller_query_telemetry_fetch(m_trace_controller, telemetry);
+    if(result == kRocProfVisResultSuccess)
+    {
+        uint64_t count = 0;
+        rocprofvis_controller_get_uint64(telemetry, kRPVControllerQueryTelemetryNumQueries,
+                                         0, &count);
+        queries.resize(count);
+        for(uint64_t i = 0; i < count; i++)
+        {
+            QueryTelemetryStats& stats = queries[i];
+            stats.query_template =
+                GetString(telemetry, kRPVControllerQueryTelemetryQueryTemplateIndexed, i);
+            stats.connection =
+                GetString(telemetry, kRPVControllerQueryTelemetryQueryConnectionIndexed, i);
+            stats.plan = GetString(telemetry, kRPVControllerQueryTelemetryQueryPlanIndexed, i);
+            rocprofvis_controller_get_uint64(
+                telemetry, kRPVControllerQueryTelemetryQueryCountIndexed, i, &stats.count);
+            rocprofvis_controller_get_uint64(
+                telemetry, kRPVControllerQueryTelemetryQueryFailuresIndexed, i,
+                &stats.failures);
+            rocprofvis_controller_get_double(
+                telemetry, kRPVControllerQueryTelemetryQueryTotalTimeIndexed, i,
+                &stats.total_ms);
+            rocprofvis_controller_get_double(
+                telemetry, kRPVControllerQueryTelemetryQueryMaxTimeIndexed, i,
+                &stats.max_ms);
+            rocprofvis_controller_get_uint64(
+                telemetry, kRPVControllerQueryTelemetryQueryRowsIndexed, i, &stats.rows);
+            rocprofvis_controller_get_uint64(
+                telemetry, kRPVControllerQueryTelemetryQueryBytesIndexed, i, &stats.bytes);
+        }
+
+        count = 0;
+        rocprofvis_controller_get_uint64(telemetry,
+                                         kRPVControllerQueryTelemetryNumSlowQueries, 0,
+                                         &count);
+        slow_queries.resize(count);
+        for(uint64_t i = 0; i < count; i++)
+        {
+            SlowQueryInfo& query = slow_queries[i];
+            query.query =
+                GetString(telemetry, kRPVControllerQueryTelemetrySlowQueryTextIndexed, i);
+            query.connection = GetString(
+                telemetry, kRPVControllerQueryTelemetrySlowQueryConnectionIndexed, i);
+            rocprofvis_controller_get_double(
+                telemetry, kRPVControllerQueryTelemetrySlowQueryTimeIndexed, i,
+                &query.duration_ms);
+            rocprofvis_controller_get_uint64(
+                telemetry, kRPVControllerQueryTelemetrySlowQueryRowsIndexed, i,
+                &query.rows);
+            rocprofvis_controller_get_uint64(
+                telemetry, kRPVControllerQueryTelemetrySlowQueryBytesIndexed, i,
+                &query.bytes);
+            query.error =
+                GetString(telemetry, kRPVControllerQueryTelemetrySlowQueryErrorIndexed, i);
+        }
+    }
+    else
+    {
+        spdlog::debug("Failed to fetch query telemetry, result: {}",
+                      static_cast<int>(result));
+    }
+    rocprofvis_controller_query_telemetry_free(telemetry);
+    return result == kRocProfVisResultSuccess;
+}
+
+bool
+DataProvider::RequestMemoryReport()
+{
+    if(m_state != ProviderState::kReady)
+    {
+        return false;
+    }
+    if(m_requests.find(MEMORY_REPORT_REQUEST_ID) != m_requests.end())
+    {
+        spdlog::debug("Memory report request already pending");
+        return false;
+    }
+
+    rocprofvis_controller_memory_report_t* controller_report =
+        rocprofvis_controller_memory_report_alloc();
+    ROCPROFVIS_ASSERT(controller_report);
+    rocprofvis_controller_future_t* future = rocprofvis_controller_future_alloc();
+    ROCPROFVIS_ASSERT(future);
+
+    rocprofvis_result_t result = rocprofvis_controller_memory_report_fetch_async(
+        m_trace_controller, future, controller_report);
+    if(result != kRocProfVisResultSuccess)
+    {
+        spdlog::debug("Failed to request memory report, result: {}", static_cast<int>(result));
+        rocprofvis_controller_future_free(future);
+        rocprofvis_controller_memory_report_free(controller_report);
+        return false;
+    }
+    m_requests.emplace(MEMORY_REPORT_REQUEST_ID,
+                       RequestInfo{ MEMORY_REPORT_REQUEST_ID, future, nullptr,
+                                    controller_report, nullptr, RequestState::kLoading,
+                                    RequestType::kFetchMemoryReport });
+    return true;
+}
+
+bool
+DataProvider::TakeMemoryReport(MemoryReport& report)
+{
+    if(!m_memory_report_ready)
+    {
+        return false;
+    }
+    report                = std::move(m_memory_report);
+    m_memory_report       = MemoryReport();
+    m_memory_report_ready = false;
+    return true;
+}
+
+void
+DataProvider::ProcessMemoryReportRequest(RequestInfo& req)
+{
+    MemoryReport& report = m_memory_report;
+    report.entries.clear();
+    report.trace_budget = 0;
+    report.total_budget = 0;
+
+    rocprofvis_controller_memory_report_t* controller_report = req.request_obj_handle;
+    req.request_obj_handle                                   = nullptr;
+    if(controller_report && req.response_code == kRocProfVisResultSuccess)
+    {
+        uint64_t count = 0;
+        rocprofvis_controller_get_uint64(controller_report,
+                                         kRPVControllerMemoryReportNumEntries, 0, &count);
+        report.entries.resize(count);
+        for(uint64_t i = 0; i < count; i++)
+        {
+            MemoryReportEntry& entry = report.entries[i];
+            entry.name = GetString(controller_report, kRPVControllerMemoryReportNameIndexed, i);
+            rocprofvis_controller_get_uint64(
+                controller_report, kRPVControllerMemoryReportParentIndexed, i, &entry.parent);
+            rocprofvis_controller_get_uint64(
+                controller_report, kRPVControllerMemoryReportBytesIndexed, i, &entry.bytes);
+            rocprofvis_controller_get_uint64(
+                controller_report, kRPVControllerMemoryReportItemsIndexed, i, &entry.items);
+        }
+        rocprofvis_controller_get_uint64(controller_report,
+                                         kRPVControllerMemoryReportTraceBudget, 0,
+                                         &report.trace_budget);
+        rocprofvis_controller_get_uint64(controller_report,
+                                         kRPVControllerMemoryReportTotalBudget, 0,
+                                         &report.total_budget);
+    }
+    else
+    {
+        spdlog::debug("Memory report request failed with code {}", req.response_code);
+    }
+    if(controller_report)
+    {
+        rocprofvis_controller_memory_report_free(controller_report);
+    }
+
+    // view side buffers, kept as a separate top level entry
+    auto add_entry = [&report](const std::string& name, uint64_t parent) {
+        report.entries.push_back({ name, parent, 0, 0 });
+        return static_cast<uint64_t>(report.entries.size() - 1);
+    };
+    auto accumulate = [&report](uint64_t index, uint64_t bytes, uint64_t items) {
+        while(index < report.entries.size())
+        {
+            report.entries[index].bytes += bytes;
+            report.entries[index].items += items;
+            index = report.entries[index].parent;
+        }
+    };
+
+    const TimelineModel& timeline = m_model.GetTimeline();
+    uint64_t             view     = add_entry("View", MemoryReportEntry::NO_PARENT);
+    uint64_t             tracks   = add_entry("Track data", view);
+    for(const TrackInfo* track : timeline.GetTrackList())
+    {
+        const RawTrackData* data = timeline.GetTrackData(track->id);
+        if(data)
+        {
+            size_t items = 0;
+            if(data->GetType() == kRPVControllerTrackTypeEvents)
+            {
+                items = static_cast<const RawTrackEventData*>(data)->GetData().size();
+            }
+            else if(data->GetType() == kRPVControllerTrackTypeSamples)
+            {
+                items = static_cast<const RawTrackSampleData*>(data)->GetData().size();
+            }
+            accumulate(add_entry(track->main_name + " " + track->sub_name, tracks),
+                       data->GetMemoryUsage(), items);
+        }
+    }
+
+    size_t mini_map_bytes = 0;
+    for(const auto& pair : timeline.GetMiniMap())
+    {
+        mini_map_bytes += sizeof(pair) + pair.second.capacity() * sizeof(double);
+    }
+    accumulate(add_entry("Histogram", view),
+               timeline.GetHistogram().capacity() * sizeof(double),
+               timeline.GetHistogram().size());
+    accumulate(add_entry("Mini map", view), mini_map_bytes, timeline.GetMiniMap().size());
+
+    m_memory_report_ready = true;
+}
+
 bool
 DataProvider::CleanupDatabase(bool rebuild)
 {
@@ -2207,7 +2474,7 @@ DataProvider::FetchEventSearch(const EventSearchRequestParams& table_params)
 }
 
 bool
-DataProvider::FetchSummary()
+DataProvider::FetchSummary(double start_ts, double end_ts, bool kernels_only)
 {
     if(m_state != ProviderState::kReady)
     {
@@ -2222,10 +2489,13 @@ DataProvider::FetchSummary()
         rocprofvis_controller_arguments_t* args = rocprofvis_controller_arguments_alloc();
         ROCPROFVIS_ASSERT(args != nullptr);
         result = rocprofvis_controller_set_double(
-            args, kRPVControllerSummaryArgsStartTimestamp, 0, m_model.GetTimeline().GetStartTime());
+            args, kRPVControllerSummaryArgsStartTimestamp, 0, start_ts);
         ROCPROFVIS_ASSERT(result == kRocProfVisResultSuccess);
         result = rocprofvis_controller_set_double(
-            args, kRPVControllerSummaryArgsEndTimestamp, 0, m_model.GetTimeline().GetEndTime());
+            args, kRPVControllerSummaryArgsEndTimestamp, 0, end_ts);
+        ROCPROFVIS_ASSERT(result == kRocProfVisResultSuccess);
+        result = rocprofvis_controller_set_uint64(
+            args, kRPVControllerSummaryArgsKernelsOnly, 0, kernels_only ? 1 : 0);
         ROCPROFVIS_ASSERT(result == kRocProfVisResultSuccess);
         rocprofvis_handle_t* summary_handle = nullptr;
         result                              = rocprofvis_controller_get_object(
@@ -2345,7 +2615,13 @@ DataProvider::CancelRequest(uint64_t request_id)
     if(it != m_requests.end())
     {
         spdlog::debug("Cancelling request id: {}", request_id);
-        RequestInfo&        request_info = it->second;
+        RequestInfo& request_info = it->second;
+        if(request_info.loading_state == RequestState::kConverting)
+        {
+            // The future is already released, the converted data is discarded when merged
+            request_info.response_code = kRocProfVisResultCancelled;
+            return true;
+        }
         rocprofvis_result_t result =
             rocprofvis_controller_future_cancel(request_info.request_future);
         if(result == kRocProfVisResultSuccess)
@@ -2368,11 +2644,51 @@ DataProvider::CancelRequest(uint64_t request_id)
 void
 DataProvider::HandleRequests()
 {
+    const std::chrono::steady_clock::time_point deadline =
+        std::chrono::steady_clock::now() + RESPONSE_FRAME_BUDGET;
+    bool handled_any = false;
+    auto budget_left = [&]() {
+        return !handled_any || std::chrono::steady_clock::now() < deadline;
+    };
+
+    // Merge track data converted by the workers, leftovers wait for the next frame
+    m_track_converter.TakeReady(m_converted_responses);
+    while(!m_converted_responses.empty() && budget_left())
+    {
+        std::unique_ptr<ConvertedTrackResponse> converted =
+            std::move(m_converted_responses.front());
+        m_converted_responses.pop_front();
+
+        auto it = m_requests.find(converted->request_id);
+        if(it == m_requests.end() || it->second.loading_state != RequestState::kConverting)
+        {
+            continue;
+        }
+        RequestInfo& req  = it->second;
+        req.loading_state = RequestState::kReady;
+        if(req.request_type == RequestType::kFetchGraph)
+        {
+            ProcessGraphRequest(req, converted.get());
+        }
+        else
+        {
+            ProcessTrackRequest(req, converted.get());
+        }
+        m_requests.erase(it);
+        handled_any = true;
+    }
+
     if(m_requests.size() > 0)
     {
-        for(auto it = m_requests.begin(); it != m_requests.end();)
+        for(auto it = m_requests.begin(); it != m_requests.end() && budget_left();)
         {
-            RequestInfo&        req = it->second;
+            RequestInfo& req = it->second;
+            if(req.loading_state == RequestState::kConverting)
+            {
+                ++it;
+                continue;
+            }
+
             rocprofvis_result_t result =
                 rocprofvis_controller_future_wait(req.request_future, 0);
             ROCPROFVIS_ASSERT(result == kRocProfVisResultSuccess ||
@@ -2390,7 +2706,14 @@ DataProvider::HandleRequests()
 
                 rocprofvis_controller_future_free(req.request_future);
                 req.request_future = nullptr;
+                if(SubmitTrackConversion(req))
+                {
+                    // stays pending until the converted data is merged
+                    ++it;
+                    continue;
+                }
                 ProcessRequest(req);
+                handled_any = true;
                 // remove request from processing container
                 it = m_requests.erase(it);
             }
@@ -2402,6 +2725,35 @@ DataProvider::HandleRequests()
     }
 }
 
+bool
+DataProvider::SubmitTrackConversion(RequestInfo& req)
+{
+    if((req.request_type != RequestType::kFetchTrack &&
+        req.request_type != RequestType::kFetchGraph) ||
+       req.response_code != kRocProfVisResultSuccess || !req.request_array)
+    {
+        return false;
+    }
+
+    auto track_params = std::dynamic_pointer_cast<TrackRequestParams>(req.custom_params);
+    if(!track_params)
+    {
+        return false;
+    }
+    const TrackInfo* metadata = m_model.GetTimeline().GetTrack(track_params->m_track_id);
+    if(!metadata || (metadata->track_type != kRPVControllerTrackTypeEvents &&
+                     metadata->track_type != kRPVControllerTrackTypeSamples))
+    {
+        return false;
+    }
+
+    // the converter owns and frees the array from here on
+    m_track_converter.Submit(req.request_id, metadata->track_type, req.request_array);
+    req.request_array = nullptr;
+    req.loading_state = RequestState::kConverting;
+    return true;
+}
+
 void
 DataProvider::UpdateRequestProgress(RequestInfo& req)
 {
@@ -2867,6 +3219,104 @@ DataProvider::ProcessEventFlowDetailsRequest(RequestInfo& req)
     req.request_array = nullptr;
 }
 
+void
+DataProvider::ReadFlowControl(rocprofvis_handle_t* flow_control_handle, EventFlowData& flow)
+{
+    uint64_t data = 0;
+    if(rocprofvis_controller_get_uint64(flow_control_handle, kRPVControllerFlowControltId,
+                                        0, &data) == kRocProfVisResultSuccess)
+    {
+        flow.id.uuid = data;
+    }
+    data = 0;
+    rocprofvis_controller_get_uint64(flow_control_handle,
+                                     kRPVControllerFlowControlTimestamp, 0, &data);
+    flow.start_timestamp = data;
+    data = 0;
+    rocprofvis_controller_get_uint64(flow_control_handle,
+                                     kRPVControllerFlowControlEndTimestamp, 0, &data);
+    flow.end_timestamp = data;
+    data = 0;
+    rocprofvis_controller_get_uint64(flow_control_handle,
+                                     kRPVControllerFlowControlTrackId, 0, &data);
+    flow.track_id = data;
+    data = 0;
+    rocprofvis_controller_get_uint64(flow_control_handle,
+                                     kRPVControllerFlowControlDirection, 0, &data);
+    flow.direction = data;
+    data = 0;
+    rocprofvis_controller_get_uint64(flow_control_handle, kRPVControllerFlowControlLevel,
+                                     0, &data);
+    flow.level = data;
+    flow.name  = GetString(flow_control_handle, kRPVControllerFlowControlName, 0);
+}
+
+void
+DataProvider::ProcessFlowRangeRequest(RequestInfo& req)
+{
+    std::shared_ptr<FlowRangeRequestParams> flow_params =
+        std::dynamic_pointer_cast<FlowRangeRequestParams>(req.custom_params);
+
+    if(req.response_code != kRocProfVisResultSuccess)
+    {
+        spdlog::debug("Flow range request failed, result: {}", req.response_code);
+    }
+    else if(req.request_array && flow_params)
+    {
+        uint64_t            count  = 0;
+        rocprofvis_result_t result = rocprofvis_controller_get_uint64(
+            req.request_array, kRPVControllerArrayNumEntries, 0, &count);
+        if(result == kRocProfVisResultSuccess)
+        {
+            std::vector<FlowEdgeData> edges;
+            edges.reserve(count / 2);
+            // Entries come in origin / target pairs
+            for(uint64_t j = 0; j + 1 < count; j += 2)
+            {
+                rocprofvis_handle_t* origin_handle = nullptr;
+                rocprofvis_handle_t* target_handle = nullptr;
+                if(rocprofvis_controller_get_object(req.request_array,
+                                                    kRPVControllerArrayEntryIndexed, j,
+                                                    &origin_handle) !=
+                       kRocProfVisResultSuccess ||
+                   rocprofvis_controller_get_object(req.request_array,
+                                                    kRPVControllerArrayEntryIndexed, j + 1,
+                                                    &target_handle) !=
+                       kRocProfVisResultSuccess ||
+                   !origin_handle || !target_handle)
+                {
+                    spdlog::warn("Failed to get flow control handles for entry {}", j);
+                    continue;
+                }
+                FlowEdgeData edge;
+                ReadFlowControl(origin_handle, edge.origin);
+                ReadFlowControl(target_handle, edge.target);
+                edges.push_back(std::move(edge));
+            }
+            m_model.GetEvents().SetFlowRangeEdges(flow_params->m_start_ts,
+                                                  flow_params->m_end_ts,
+                                                  flow_params->m_track_ids,
+                                                  std::move(edges));
+        }
+        else
+        {
+            spdlog::error("Failed to get flow range array entry count, result: {}",
+                          static_cast<int>(result));
+        }
+    }
+
+    if(req.request_array)
+    {
+        rocprofvis_controller_array_free(req.request_array);
+        req.request_array = nullptr;
+    }
+    if(req.request_args)
+    {
+        rocprofvis_controller_arguments_free(req.request_args);
+        req.request_args = nullptr;
+    }
+}
+
 void
 DataProvider::ProcessRequest(RequestInfo& req)
 {
@@ -2897,6 +3347,34 @@ DataProvider::ProcessRequest(RequestInfo& req)
             ProcessEventFlowDetailsRequest(req);
             break;
         }
+        case RequestType::kFetchFlowRange:
+        {
+            ProcessFlowRangeRequest(req);
+            break;
+        }
+        case RequestType::kLoadTracks:
+        case RequestType::kPrefetchTracks:
+        {
+            spdlog::debug("Track load request {} complete with result: {}",
+                          req.request_id, req.response_code);
+            if(req.request_args)
+            {
+                rocprofvis_controller_arguments_free(req.request_args);
+                req.request_args = nullptr;
+            }
+            break;
+        }
+        case RequestType::kPrefetchEventProperties:
+        {
+            spdlog::debug("Event prefetch request {} complete with result: {}",
+                          req.request_id, req.response_code);
+            if(req.request_args)
+            {
+                rocprofvis_controller_arguments_free(req.request_args);
+                req.request_args = nullptr;
+            }
+            break;
+        }
         case RequestType::kFetchTrackEventTable:
         case RequestType::kFetchTrackSampleTable:
         case RequestType::kFetchEventSearchTable:
@@ -2936,6 +3414,11 @@ DataProvider::ProcessRequest(RequestInfo& req)
             ProcessSummaryRequest(req);
             break;
         }
+        case RequestType::kFetchMemoryReport:
+        {
+            ProcessMemoryReportRequest(req);
+            break;
+        }
         case RequestType::kFetchAnalysisTrackStatistics:
         {
             ProcessAnalysisTrackStatisticsRequest(req);
@@ -3569,7 +4052,7 @@ DataProvider::ProcessTableExportRequest(RequestInfo& req)
 }
 
 void
-DataProvider::ProcessTrackRequest(RequestInfo& req)
+DataProvider::ProcessTrackRequest(RequestInfo& req, ConvertedTrackResponse* converted)
 {
     spdlog::debug("Processing track data {}", req.request_id);
 
@@ -3587,12 +4070,16 @@ DataProvider::ProcessTrackRequest(RequestInfo& req)
     {
         case kRPVControllerTrackTypeEvents:
         {
-            CreateRawEventData(*track_params, req);
+            CreateRawEventData(*track_params, req,
+                               converted ? std::move(converted->events)
+                                         : std::vector<TraceEvent>());
             break;
         }
         case kRPVControllerTrackTypeSamples:
         {
-            CreateRawSampleData(*track_params, req);
+            CreateRawSampleData(*track_params, req,
+                                converted ? std::move(converted->samples)
+                                          : std::vector<TraceCounter>());
             break;
         }
         default:
@@ -3618,7 +4105,7 @@ DataProvider::ProcessTrackRequest(RequestInfo& req)
 }
 
 void
-DataProvider::ProcessGraphRequest(RequestInfo& req)
+DataProvider::ProcessGraphRequest(RequestInfo& req, ConvertedTrackResponse* converted)
 {
     spdlog::debug("Processing graph data {}", req.request_id);
 
@@ -3686,12 +4173,16 @@ DataProvider::ProcessGraphRequest(RequestInfo& req)
         {
             case kRPVControllerTrackTypeEvents:
             {
-                CreateRawEventData(*track_params, req);
+                CreateRawEventData(*track_params, req,
+                                   converted ? std::move(converted->events)
+                                             : std::vector<TraceEvent>());
                 break;
             }
             case kRPVControllerTrackTypeSamples:
             {
-                CreateRawSampleData(*track_params, req);
+                CreateRawSampleData(*track_params, req,
+                                    converted ? std::move(converted->samples)
+                                              : std::vector<TraceCounter>());
                 break;
             }
             default:
@@ -3723,30 +4214,31 @@ DataProvider::ProcessGraphRequest(RequestInfo& req)
 }
 
 void
-DataProvider::CreateRawSampleData(const TrackRequestParams& params,
-                                  const RequestInfo&        req)
+DataProvider::CreateRawSampleData(const TrackRequestParams& params, const RequestInfo& req,
+                                  std::vector<TraceCounter>&& buffer)
 {
-    rocprofvis_controller_array_t*               track_data   = req.request_array;
     const std::chrono::steady_clock::time_point& request_time = req.request_time;
     bool response_valid = (req.response_code == kRocProfVisResultSuccess);
 
-    uint64_t count = 0;
-
-    if(response_valid)
+    // The request was superseded or its track unloaded. An empty chunk would count
+    // towards the expected chunks and make the track look loaded, blocking a refetch.
+    if(req.response_code == kRocProfVisResultCancelled)
     {
-        rocprofvis_result_t result = rocprofvis_controller_get_uint64(
-            track_data, kRPVControllerArrayNumEntries, 0, &count);
-        ROCPROFVIS_ASSERT(result == kRocProfVisResultSuccess);
+        spdlog::debug("Dropping cancelled response for sample track {}",
+                      params.m_track_id);
+        return;
     }
-    else
+
+    if(!response_valid)
     {
         // Silence out of range warnings as they are shown for empty areas of the track.         
         if(req.response_code != kRocProfVisResultOutOfRange)
         {
             spdlog::warn("Sample track data request failed with code {}", req.response_code);
         }
-        count = 0;
+        buffer.clear();
     }
+    size_t count = buffer.size();
 
     RawTrackSampleData* raw_sample_data   = nullptr;
     const RawTrackData* existing_raw_data = m_model.GetTimeline().GetTrackData(params.m_track_id);
@@ -3784,15 +4276,6 @@ DataProvider::CreateRawSampleData(const TrackRequestParams& params,
 
     if(!raw_sample_data)
     {
-        // The track was unloaded and its requests cancelled. Creating an empty
-        // object here would make the track look loaded and block a refetch.
-        if(req.response_code == kRocProfVisResultCancelled)
-        {
-            spdlog::debug("Dropping cancelled response for sample track {}",
-                          params.m_track_id);
-            return;
-        }
-
         spdlog::debug("Create sample track {} data with {} entries", params.m_track_id,
                       count);
         raw_sample_data =
@@ -3800,78 +4283,38 @@ DataProvider::CreateRawSampleData(const TrackRequestParams& params,
                                    params.m_data_group_id, params.m_chunk_count);
     }
 
-    std::vector<TraceCounter> buffer;
-    buffer.reserve(count);
-
-    std::unordered_set              timepoint_set = raw_sample_data->GetWritableIdSet();
-    rocprofvis_controller_sample_t* sample        = nullptr;
-    for(uint64_t i = 0; i < count; i++)
-    {
-        rocprofvis_result_t result = rocprofvis_controller_get_object(
-            track_data, kRPVControllerArrayEntryIndexed, i, &sample);
-        ROCPROFVIS_ASSERT(result == kRocProfVisResultSuccess && sample);
-
-        double start_ts = 0;
-        result = rocprofvis_controller_get_double(sample, kRPVControllerSampleTimestamp,
-                                                  0, &start_ts);
-        ROCPROFVIS_ASSERT(result == kRocProfVisResultSuccess);
-
-        auto [_, inserted] = timepoint_set.insert(start_ts);
-        if(!inserted)
-        {
-            spdlog::debug("Skipping duplicate sample timepoint {} on track {}", start_ts,
-                          params.m_track_id);
-            continue;  // skip duplicate samples
-        }
-
-        // Construct TraceCounter item in-place
-        buffer.emplace_back();
-        TraceCounter& trace_counter = buffer.back();
-
-        double value = 0;
-        result = rocprofvis_controller_get_double(sample, kRPVControllerSampleValue, 0,
-                                                  &value);
-        ROCPROFVIS_ASSERT(result == kRocProfVisResultSuccess);
-
-        double end_ts = 0;
-        result        = rocprofvis_controller_get_double(
-            sample, kRPVControllerSampleEndTimestamp, 0, &end_ts);
-        ROCPROFVIS_ASSERT(result == kRocProfVisResultSuccess);
-
-        trace_counter.m_start_ts = start_ts;
-        trace_counter.m_end_ts   = end_ts;
-        trace_counter.m_value    = value;
-    }
-
+    // duplicate sample timepoints are dropped while the chunk is added
     raw_sample_data->AddChunk(params.m_chunk_index, std::move(buffer));
 
     m_model.GetTimeline().SetTrackData(params.m_track_id, raw_sample_data);
 }
 
 void
-DataProvider::CreateRawEventData(const TrackRequestParams& params, const RequestInfo& req)
+DataProvider::CreateRawEventData(const TrackRequestParams& params, const RequestInfo& req,
+                                 std::vector<TraceEvent>&& buffer)
 {
-    rocprofvis_controller_array_t*               track_data   = req.request_array;
     const std::chrono::steady_clock::time_point& request_time = req.request_time;
     bool response_valid = (req.response_code == kRocProfVisResultSuccess);
 
-    uint64_t count = 0;
-
-    if(response_valid)
+    // The request was superseded or its track unloaded. An empty chunk would count
+    // towards the expected chunks and make the track look loaded, blocking a refetch.
+    if(req.response_code == kRocProfVisResultCancelled)
     {
-        rocprofvis_result_t result = rocprofvis_controller_get_uint64(
-            track_data, kRPVControllerArrayNumEntries, 0, &count);
-        ROCPROFVIS_ASSERT(result == kRocProfVisResultSuccess);
+        spdlog::debug("Dropping cancelled response for event track {}",
+                      params.m_track_id);
+        return;
     }
-    else
+
+    if(!response_valid)
     {
         // Silence out of range warnings as they are shown for empty areas of the track.         
         if(req.response_code != kRocProfVisResultOutOfRange)
         {
             spdlog::warn("Event track data request failed with code {}", req.response_code);
         }
-        count = 0;
+        buffer.clear();
     }
+    size_t count = buffer.size();
 
     RawTrackEventData*  raw_event_data    = nullptr;
     const RawTrackData* existing_raw_data = m_model.GetTimeline().GetTrackData(params.m_track_id);
@@ -3909,15 +4352,6 @@ DataProvider::CreateRawEventData(const TrackRequestParams& params, const Request
 
     if(!raw_event_data)
     {
-        // The track was unloaded and its requests cancelled. Creating an empty
-        // object here would make the track look loaded and block a refetch.
-        if(req.response_code == kRocProfVisResultCancelled)
-        {
-            spdlog::debug("Dropping cancelled response for event track {}",
-                          params.m_track_id);
-            return;
-        }
-
         spdlog::debug("Creating event track {} data with {} entries", params.m_track_id,
                       count);
         raw_event_data =
@@ -3925,75 +4359,8 @@ DataProvider::CreateRawEventData(const TrackRequestParams& params, const Request
                                   params.m_data_group_id, params.m_chunk_count);
     }
 
-    std::vector<TraceEvent> buffer;
-    buffer.reserve(count);
-
-    std::unordered_set event_set = raw_event_data->GetWritableIdSet();
-
-    size_t real_count = 0;
-    for(uint64_t i = 0; i < count; i++)
-    {
-        rocprofvis_controller_event_t* event  = nullptr;
-        rocprofvis_result_t            result = rocprofvis_controller_get_object(
-            track_data, kRPVControllerArrayEntryIndexed, i, &event);
-        ROCPROFVIS_ASSERT(result == kRocProfVisResultSuccess && event);
-
-        uint64_t id = 0;
-        result = rocprofvis_controller_get_uint64(event, kRPVControllerEventId, 0, &id);
-        ROCPROFVIS_ASSERT(result == kRocProfVisResultSuccess);
-
-        auto [_, inserted] = event_set.insert(id);
-        if(!inserted)
-        {
-            spdlog::debug("Skipping duplicate event id {} on track {}", id,
-                          params.m_track_id);
-            continue;  // skip duplicate events
-        }
-
-        // Construct TraceEvent item in-place
-        buffer.emplace_back();
-        TraceEvent& trace_event = buffer.back();
-        trace_event.m_id.uuid     = id;
-
-        double start_ts = 0;
-        result          = rocprofvis_controller_get_double(
-            event, kRPVControllerEventStartTimestamp, 0, &start_ts);
-        ROCPROFVIS_ASSERT(result == kRocProfVisResultSuccess);
-        trace_event.m_start_ts = start_ts;
-
-        double end_ts = 0;
-        result = rocprofvis_controller_get_double(event, kRPVControllerEventEndTimestamp,
-                                                  0, &end_ts);
-        ROCPROFVIS_ASSERT(result == kRocProfVisResultSuccess);
-        trace_event.m_duration = end_ts - start_ts;
-
-        uint64_t level = 0;
-        result =
-            rocprofvis_controller_get_uint64(event, kRPVControllerEventLevel, 0, &level);
-        ROCPROFVIS_ASSERT(result == kRocProfVisResultSuccess);
-        trace_event.m_level = static_cast<uint32_t>(level);
-
-        uint64_t child_count = 0;
-        result = rocprofvis_controller_get_uint64(event, kRPVControllerEventNumChildren,
-                                                  0, &child_count);
-        ROCPROFVIS_ASSERT(result == kRocProfVisResultSuccess);
-        trace_event.m_child_count = static_cast<uint32_t>(child_count);
-
-        // get event name
-        result = GetString(event, kRPVControllerEventName, 0, trace_event.m_name);
-        ROCPROFVIS_ASSERT(result == kRocProfVisResultSuccess);
-        if(trace_event.m_child_count > 1)
-        {
-            result = GetString(event, kRPVControllerEventTopCombinedName, 0,
-                               trace_event.m_top_combined_name);
-            ROCPROFVIS_ASSERT(result == kRocProfVisResultSuccess);
-        }
-
-        real_count++;
-    }
-
-    // Add the buffer to the raw event data
-    spdlog::debug("Adding {} event entries to track id {}", real_count,
+    // Add the buffer to the raw event data, duplicate event ids are dropped
+    spdlog::debug("Adding {} event entries to track id {}", buffer.size(),
                   params.m_track_id);
     raw_event_data->AddChunk(params.m_chunk_index, std::move(buffer));
     m_model.GetTimeline().SetTrackData(params.m_track_id, raw_event_data);
@@ -4117,6 +4484,362 @@ DataProvider::FetchEventFlowDetails(uint64_t event_id)
     }
 }
 
+bool
+DataProvider::FetchFlowRange(double start_ts, double end_ts,
+                             const std::vector<uint64_t>& track_ids)
+{
+    if(m_state != ProviderState::kReady)
+    {
+        spdlog::debug("Cannot fetch, provider not ready or error, state: {}",
+                      static_cast<int>(m_state));
+        return false;
+    }
+
+    if(IsRequestPending(FLOW_RANGE_REQUEST_ID))
+    {
+        spdlog::debug("Flow range request already pending");
+        return false;
+    }
+
+    auto future   = rocprofvis_controller_future_alloc();
+    auto outArray = rocprofvis_controller_array_alloc(0);
+    auto args     = rocprofvis_controller_arguments_alloc();
+    ROCPROFVIS_ASSERT(future != nullptr);
+    ROCPROFVIS_ASSERT(outArray != nullptr);
+    ROCPROFVIS_ASSERT(args != nullptr);
+
+    rocprofvis_controller_set_double(args, kRPVControllerFlowArgsStartTime, 0, start_ts);
+    rocprofvis_controller_set_double(args, kRPVControllerFlowArgsEndTime, 0, end_ts);
+    rocprofvis_controller_set_uint64(args, kRPVControllerFlowArgsNumTracks, 0,
+                                     track_ids.size());
+    for(uint64_t i = 0; i < track_ids.size(); i++)
+    {
+        rocprofvis_controller_set_uint64(args, kRPVControllerFlowArgsTracksIndexed, i,
+                                         track_ids[i]);
+    }
+
+    rocprofvis_result_t result =
+        rocprofvis_controller_flow_fetch_async(m_trace_controller, args, future, outArray);
+
+    if(result == kRocProfVisResultSuccess)
+    {
+        RequestInfo request_info;
+        request_info.request_array      = outArray;
+        request_info.request_future     = future;
+        request_info.request_obj_handle = nullptr;
+        request_info.request_args       = args;
+        request_info.request_id         = FLOW_RANGE_REQUEST_ID;
+        request_info.loading_state      = RequestState::kLoading;
+        request_info.request_type       = RequestType::kFetchFlowRange;
+        request_info.custom_params =
+            std::make_shared<FlowRangeRequestParams>(start_ts, end_ts, track_ids);
+
+        m_requests.emplace(request_info.request_id, request_info);
+        return true;
+    }
+    else
+    {
+        spdlog::error("Failed to fetch flow range, result: {}", static_cast<int>(result));
+        rocprofvis_controller_future_free(future);
+        rocprofvis_controller_array_free(outArray);
+        rocprofvis_controller_arguments_free(args);
+        return false;
+    }
+}
+
+std::pair<bool, uint64_t>
+DataProvider::LoadTracks(const std::vector<uint64_t>& track_ids, double start_ts,
+                         double end_ts)
+{
+    uint64_t request_id = RequestIdBuilder::MakeClientRequestId(
+        RequestType::kLoadTracks, IdGenerator::GetInstance().GenerateId());
+    return { IssueTrackLoad(track_ids, start_ts, end_ts, request_id,
+                            RequestType::kLoadTracks),
+             request_id };
+}
+
+bool
+DataProvider::IssueTrackLoad(const std::vector<uint64_t>& track_ids, double start_ts,
+                             double end_ts, uint64_t request_id, RequestType request_type,
+                             uint32_t resolution)
+{
+    if(m_state != ProviderState::kReady)
+    {
+        spdlog::debug("Cannot fetch, provider not ready or error, state: {}",
+                      static_cast<int>(m_state));
+        return false;
+    }
+
+    auto future = rocprofvis_controller_future_alloc();
+    auto args   = rocprofvis_controller_arguments_alloc();
+    ROCPROFVIS_ASSERT(future != nullptr);
+    ROCPROFVIS_ASSERT(args != nullptr);
+
+    rocprofvis_controller_set_double(args, kRPVControllerTrackLoadArgsStartTime, 0,
+                                     start_ts);
+    rocprofvis_controller_set_double(args, kRPVControllerTrackLoadArgsEndTime, 0, end_ts);
+    rocprofvis_controller_set_uint64(args, kRPVControllerTrackLoadArgsNumTracks, 0,
+                                     track_ids.size());
+    for(uint64_t i = 0; i < track_ids.size(); i++)
+    {
+        rocprofvis_controller_set_uint64(args, kRPVControllerTrackLoadArgsTracksIndexed, i,
+                                         track_ids[i]);
+    }
+    if(resolution > 0)
+    {
+        rocprofvis_controller_set_uint64(args, kRPVControllerTrackLoadArgsResolution, 0,
+                                         resolution);
+    }
+
+    rocprofvis_result_t result =
+        rocprofvis_controller_track_load_async(m_trace_controller, args, future);
+
+    if(result == kRocProfVisResultSuccess)
+    {
+        RequestInfo request_info;
+        request_info.request_array      = nullptr;
+        request_info.request_future     = future;
+        request_info.request_obj_handle = nullptr;
+        request_info.request_args       = args;
+        request_info.request_id         = request_id;
+        request_info.loading_state      = RequestState::kLoading;
+        request_info.request_type       = request_type;
+        request_info.custom_params =
+            std::make_shared<TrackLoadRequestParams>(start_ts, end_ts, track_ids);
+
+        m_requests.emplace(request_info.request_id, request_info);
+        return true;
+    }
+    else
+    {
+        spdlog::error("Failed to load {} tracks, result: {}", track_ids.size(),
+                      static_cast<int>(result));
+        rocprofvis_controller_future_free(future);
+        rocprofvis_controller_arguments_free(args);
+        return false;
+    }
+}
+
+std::pair<bool, uint64_t>
+DataProvider::PrefetchEventProperties(const std::vector<uint64_t>& event_ids)
+{
+    if(m_state != ProviderState::kReady)
+    {
+        spdlog::debug("Cannot fetch, provider not ready or error, state: {}",
+                      static_cast<int>(m_state));
+        return { false, 0 };
+    }
+
+    uint64_t request_id = RequestIdBuilder::MakeClientRequestId(
+        RequestType::kPrefetchEventProperties, IdGenerator::GetInstance().GenerateId());
+
+    auto future = rocprofvis_controller_future_alloc();
+    auto args   = rocprofvis_controller_arguments_alloc();
+    ROCPROFVIS_ASSERT(future != nullptr);
+    ROCPROFVIS_ASSERT(args != nullptr);
+
+    rocprofvis_controller_set_uint64(args, kRPVControllerEventPrefetchArgsNumEvents, 0,
+                                     event_ids.size());
+    for(uint64_t i = 0; i < event_ids.size(); i++)
+    {
+        rocprofvis_controller_set_uint64(args, kRPVControllerEventPrefetchArgsEventsIndexed,
+                                         i, event_ids[i]);
+    }
+
+    rocprofvis_result_t result =
+        rocprofvis_controller_event_prefetch_async(m_trace_controller, args, future);
+
+    if(result == kRocProfVisResultSuccess)
+    {
+        RequestInfo request_info;
+        request_info.request_array      = nullptr;
+        request_info.request_future     = future;
+        request_info.request_obj_handle = nullptr;
+        request_info.request_args       = args;
+        request_info.request_id         = request_id;
+        request_info.loading_state      = RequestState::kLoading;
+        request_info.request_type       = RequestType::kPrefetchEventProperties;
+
+        m_requests.emplace(request_info.request_id, request_info);
+        return { true, request_id };
+    }
+    else
+    {
+        spdlog::error("Failed to prefetch {} events, result: {}", event_ids.size(),
+                      static_cast<int>(result));
+        rocprofvis_controller_future_free(future);
+        rocprofvis_controller_arguments_free(args);
+        return { false, 0 };
+    }
+}
+
+bool
+DataProvider::HasPendingTrackRequests() const
+{
+    for(const auto& item : m_requests)
+    {
+        RequestType type = item.second.request_type;
+        if(type == RequestType::kFetchTrack || type == RequestType::kFetchGraph ||
+           type == RequestType::kLoadTracks)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+DataProvider::PostTrackTask(std::function<void()> task)
+{
+    m_track_converter.Post(std::move(task));
+}
+
+bool
+DataProvider::IsTrackLoading(uint64_t track_id, double start_ts, double end_ts) const
+{
+    for(const auto& item : m_requests)
+    {
+        const RequestInfo& req = item.second;
+        if(req.request_type != RequestType::kLoadTracks &&
+           req.request_type != RequestType::kPrefetchTracks)
+        {
+            continue;
+        }
+        auto params = std::dynamic_pointer_cast<TrackLoadRequestParams>(req.custom_params);
+        if(params && params->m_start_ts < end_ts && params->m_end_ts > start_ts &&
+           params->m_track_ids.count(track_id) > 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+DataProvider::UpdatePrefetch(const std::vector<uint64_t>& track_ids, double view_start_ts,
+                             double view_end_ts, double loaded_start_ts,
+                             double loaded_end_ts, uint32_t loaded_resolution)
+{
+    auto   now    = std::chrono::steady_clock::now();
+    double width  = view_end_ts - view_start_ts;
+    double center = (view_start_ts + view_end_ts) * 0.5;
+    if(width <= 0.0 || loaded_end_ts <= loaded_start_ts)
+    {
+        return;
+    }
+
+    PrefetchState& state = m_prefetch;
+    double elapsed = std::chrono::duration<double>(now - state.last_update).count();
+    if(state.last_width <= 0.0 || now - state.last_update > PREFETCH_IDLE_RESET)
+    {
+        state.pan_velocity  = 0.0;
+        state.zoom_velocity = 0.0;
+    }
+    else if(elapsed > 0.0)
+    {
+        double pan  = (center - state.last_center) / width / elapsed;
+        double zoom = std::log(width / state.last_width) / elapsed;
+        state.pan_velocity += (pan - state.pan_velocity) * PREFETCH_SMOOTHING;
+        state.zoom_velocity += (zoom - state.zoom_velocity) * PREFETCH_SMOOTHING;
+    }
+    state.last_update = now;
+    state.last_center = center;
+    state.last_width  = width;
+
+    PrefetchDirection direction = PrefetchDirection::kNone;
+    if(state.zoom_velocity > PREFETCH_ZOOM_VELOCITY)
+    {
+        direction = PrefetchDirection::kZoomOut;
+    }
+    else if(state.pan_velocity > PREFETCH_PAN_VELOCITY)
+    {
+        direction = PrefetchDirection::kRight;
+    }
+    else if(state.pan_velocity < -PREFETCH_PAN_VELOCITY)
+    {
+        direction = PrefetchDirection::kLeft;
+    }
+
+    // A prefetch for a direction the user left is wasted work, drop it. One for the
+    // direction the view stopped in is still what the next request needs.
+    if(IsPrefetchStale(state.direction, direction) &&
+       IsRequestPending(PREFETCH_TRACKS_REQUEST_ID))
+    {
+        CancelRequest(PREFETCH_TRACKS_REQUEST_ID);
+    }
+    if(direction == PrefetchDirection::kNone || track_ids.empty())
+    {
+        return;
+    }
+
+    double   start_ts   = loaded_start_ts;
+    double   end_ts     = loaded_end_ts;
+    uint32_t resolution = 0;
+    GetPrefetchRange(direction, width, loaded_start_ts, loaded_end_ts, loaded_resolution,
+                     start_ts, end_ts, resolution);
+
+    // Prefetches only run while no data the view is waiting for is in flight, the
+    // controller serves jobs in order and would otherwise delay the visible tracks
+    if(IsRequestPending(PREFETCH_TRACKS_REQUEST_ID) || HasPendingTrackRequests() ||
+       (direction == state.direction && start_ts >= state.start_ts &&
+        end_ts <= state.end_ts))
+    {
+        return;
+    }
+
+    if(IssueTrackLoad(track_ids, start_ts, end_ts, PREFETCH_TRACKS_REQUEST_ID,
+                      RequestType::kPrefetchTracks, resolution))
+    {
+        spdlog::debug("Prefetching {} tracks from {} to {} at {} pixels", track_ids.size(),
+                      start_ts, end_ts, resolution);
+        state.direction = direction;
+        state.start_ts  = start_ts;
+        state.end_ts    = end_ts;
+    }
+}
+
+void
+DataProvider::GetPrefetchRange(PrefetchDirection direction, double view_width,
+                               double loaded_start_ts, double loaded_end_ts,
+                               uint32_t loaded_resolution, double& start_ts,
+                               double& end_ts, uint32_t& resolution)
+{
+    // The next data request covers the loaded range moved by one viewport, or
+    // doubled around it when zooming out. It keeps the pixel count of the loaded
+    // range, so zooming out reads the next coarser graph level of detail.
+    double loaded_width = loaded_end_ts - loaded_start_ts;
+    start_ts            = loaded_start_ts;
+    end_ts              = loaded_end_ts;
+    resolution          = loaded_resolution;
+    switch(direction)
+    {
+        case PrefetchDirection::kRight:
+            start_ts = loaded_end_ts;
+            end_ts   = loaded_end_ts + view_width;
+            break;
+        case PrefetchDirection::kLeft:
+            start_ts = loaded_start_ts - view_width;
+            end_ts   = loaded_start_ts;
+            break;
+        case PrefetchDirection::kZoomOut:
+            start_ts = loaded_start_ts - loaded_width * 0.5;
+            end_ts   = loaded_end_ts + loaded_width * 0.5;
+            break;
+        default: break;
+    }
+    if(loaded_width > 0.0 && direction != PrefetchDirection::kZoomOut)
+    {
+        resolution = static_cast<uint32_t>(
+            std::ceil(loaded_resolution * (end_ts - start_ts) / loaded_width));
+    }
+}
+
+bool
+DataProvider::IsPrefetchStale(PrefetchDirection issued, PrefetchDirection current)
+{
+    return current != PrefetchDirection::kNone && current != issued;
+}
+
 bool
 DataProvider::FetchEventCallStackData(uint64_t event_id)
 {
@@ -7,10 +7,13 @@
 #include "rocprofvis_controller_types.h"
 #include "rocprofvis_raw_track_data.h"
 #include "rocprofvis_requests.h"
+#include "rocprofvis_track_response_converter.h"
 #include "model/rocprofvis_trace_data_model.h"
 #include "model/compute/rocprofvis_compute_data_model.h"
 
 
+#include <chrono>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -44,8 +47,55 @@ struct DataProviderCleanupResult
     size_t      request_count = 0;
 };
 
+// Aggregated statistics of one SQL query template, see DataProvider::FetchQueryTelemetry
+struct QueryTelemetryStats
+{
+    std::string query_template;
+    std::string connection;
+    std::string plan;
+    uint64_t    count    = 0;
+    uint64_t    failures = 0;
+    double      total_ms = 0.0;
+    double      max_ms   = 0.0;
+    uint64_t    rows     = 0;
+    uint64_t    bytes    = 0;
+};
+
+struct SlowQueryInfo
+{
+    std::string query;
+    std::string connection;
+    double      duration_ms = 0.0;
+    uint64_t    rows        = 0;
+    uint64_t    bytes       = 0;
+    std::string error;  // empty if the query succeeded
+};
+
+// One node of the memory report tree, see DataProvider::RequestMemoryReport.
+// Entries are listed parents first, bytes and items include those of the children.
+struct MemoryReportEntry
+{
+    static constexpr uint64_t NO_PARENT = UINT64_MAX;
+
+    std::string name;
+    uint64_t    parent = NO_PARENT;
+    uint64_t    bytes  = 0;
+    uint64_t    items  = 0;
+};
+
+struct MemoryReport
+{
+    std::vector<MemoryReportEntry> entries;
+    // pool storage the trace may hold before segments are evicted
+    uint64_t                       trace_budget = 0;
+    // pool storage shared by all open traces
+    uint64_t                       total_budget = 0;
+};
+
 class DataProvider
 {
+    friend struct DataProviderTestPeer;
+
 public:
     static const uint64_t EVENT_TABLE_REQUEST_ID;
     static const uint64_t SAMPLE_TABLE_REQUEST_ID;
@@ -66,6 +116,9 @@ public:
     static const uint64_t ANALYSIS_TOP_LAUNCH_SAMPLED_TABLE_REQUEST_ID;
     static const uint64_t FETCH_COMPUTE_TRACE_REQUEST_ID;
     static const uint64_t METRIC_PIVOT_TABLE_REQUEST_ID;
+    static const uint64_t FLOW_RANGE_REQUEST_ID;
+    static const uint64_t PREFETCH_TRACKS_REQUEST_ID;
+    static const uint64_t MEMORY_REPORT_REQUEST_ID;
 
     DataProvider();
     ~DataProvider();
@@ -79,6 +132,71 @@ public:
     bool FetchEventFlowDetails(uint64_t event_id);
     bool FetchEventCallStackData(uint64_t event_id);
 
+    /*
+     * Fetches all flow edges that overlap a time range from the controller.
+     * Stores the edges in the event model, replacing any previous range.
+     * @param start_ts: The start timestamp of the range
+     * @param end_ts: The end timestamp of the range
+     * @param track_ids: Tracks to filter by, empty for all tracks
+     */
+    bool FetchFlowRange(double start_ts, double end_ts,
+                        const std::vector<uint64_t>& track_ids = {});
+
+    /*
+     * Loads the data of several tracks for a time range in one controller request.
+     * Track data is not returned, the track and graph fetches issued once the load
+     * has completed are answered from the loaded data, see IsTrackLoading.
+     * @param track_ids: Tracks to load
+     * @param start_ts: The start timestamp of the range
+     * @param end_ts: The end timestamp of the range
+     * @return: Whether the request was issued, and its id
+     */
+    std::pair<bool, uint64_t> LoadTracks(const std::vector<uint64_t>& track_ids,
+                                         double start_ts, double end_ts);
+
+    /*
+     * Loads the extended data, flow details and call stack of several events in one
+     * controller request. Nothing is returned, the event fetches issued once the
+     * prefetch has completed are answered from the data model cache.
+     * @param event_ids: Events to prefetch
+     * @return: Whether the request was issued, and its id
+     */
+    std::pair<bool, uint64_t> PrefetchEventProperties(
+        const std::vector<uint64_t>& event_ids);
+
+    /*
+     * Returns true while a track load or prefetch covering part of the range of the
+     * track is in flight. Fetches of that range are held back until it completes,
+     * so they do not block controller workers waiting for the loaded segments.
+     * @param track_id: The track to check
+     * @param start_ts: The start timestamp of the range to fetch
+     * @param end_ts: The end timestamp of the range to fetch
+     */
+    bool IsTrackLoading(uint64_t track_id, double start_ts, double end_ts) const;
+
+    /*
+     * Runs per-track background work on the track response workers.
+     * The task must not touch the data provider or the data model.
+     * @param task: Work to run on a worker thread
+     */
+    void PostTrackTask(std::function<void()> task);
+
+    /*
+     * Feeds the current view to the prefetch scheduler, call once per frame.
+     * While the view keeps panning or zooming out, the range the next data request
+     * will cover is loaded ahead of time, along with the graph level of detail it
+     * reads. A prefetch is cancelled when the view turns to another direction.
+     * @param track_ids: Tracks to prefetch, usually the visible tracks
+     * @param view_start_ts: Start of the visible time range
+     * @param view_end_ts: End of the visible time range
+     * @param loaded_start_ts: Start of the range of the last data request
+     * @param loaded_end_ts: End of the range of the last data request
+     * @param loaded_resolution: Horizontal pixels of the last data request
+     */
+    void UpdatePrefetch(const std::vector<uint64_t>& track_ids, double view_start_ts,
+                        double view_end_ts, double loaded_start_ts, double loaded_end_ts,
+                        uint32_t loaded_resolution);
+
     /*
      *   Close the controller.
      */
@@ -104,6 +222,13 @@ public:
     static DataProviderCleanupResult CleanupDetachedResources(
         DataProviderCleanupWork cleanup_work);
 
+    /*
+     * Reads a string property from a controller handle, safe to call from any thread.
+     */
+    static rocprofvis_result_t GetString(rocprofvis_handle_t*  handle,
+                                         rocprofvis_property_t property, uint64_t index,
+                                         std::string& out_string);
+
     /*
      * Loads the trace data into the controller.
      * Any previous data will be cleared.
@@ -182,7 +307,11 @@ public:
 
     bool FetchTable(const TableRequestParams& table_params);
 
-    bool FetchSummary();
+    /*
+     * Fetches the summary of a time range.
+     * @param kernels_only: Refresh only the top kernels, used while the range is dragged
+     */
+    bool FetchSummary(double start_ts, double end_ts, bool kernels_only = false);
 
     bool FetchAnalysisTrackStatistics(const AnalysisTrackStatisticsRequestParams& params);
 
@@ -233,6 +362,21 @@ public:
 
     bool CleanupDatabase(bool rebuild);
 
+    // SQL query telemetry of the trace database, collection is off until enabled.
+    // Fetch is synchronous, it copies the statistics gathered so far.
+    bool SetQueryTelemetry(bool enabled, double slow_query_ms);
+    bool ClearQueryTelemetry();
+    bool FetchQueryTelemetry(std::vector<QueryTelemetryStats>& queries,
+                             std::vector<SlowQueryInfo>&       slow_queries);
+
+    // Memory held by the trace in the data model, database and controller, followed
+    // by a tree for the track data and buffers held by the view. The controller part
+    // is measured on a worker thread, returns false if a request is already pending.
+    bool RequestMemoryReport();
+    // Moves the report out once the last request completed.
+    // @return true if a new report was written to the output
+    bool TakeMemoryReport(MemoryReport& report);
+
     void SetCleanupDatabaseCallback(const std::function<void(bool)>& callback);
 
     const TraceDataModel& DataModel() const { return m_model; };
@@ -287,32 +431,37 @@ private:
     void UpdateRequestProgress(RequestInfo& req);
 
     void ProcessRequest(RequestInfo& req);
+    bool IssueTrackLoad(const std::vector<uint64_t>& track_ids, double start_ts,
+                        double end_ts, uint64_t request_id, RequestType request_type,
+                        uint32_t resolution = 0);
+    bool HasPendingTrackRequests() const;
     void ProcessLoadSystemTrace(RequestInfo& req);
     void ProcessEventExtendedRequest(RequestInfo& req);
     void ProcessEventFlowDetailsRequest(RequestInfo& req);
+    void ProcessFlowRangeRequest(RequestInfo& req);
+    void ReadFlowControl(rocprofvis_handle_t* flow_control_handle, EventFlowData& flow);
     void ProcessEventCallStackRequest(RequestInfo& req);
-    void ProcessGraphRequest(RequestInfo& req);
-    void ProcessTrackRequest(RequestInfo& req);
+    void ProcessGraphRequest(RequestInfo& req, ConvertedTrackResponse* converted = nullptr);
+    void ProcessTrackRequest(RequestInfo& req, ConvertedTrackResponse* converted = nullptr);
+    bool SubmitTrackConversion(RequestInfo& req);
     void ProcessTableRequest(RequestInfo& req);
     void ProcessTableExportRequest(RequestInfo& req);
     void ProcessSaveTrimmedTraceRequest(RequestInfo& req);
     void ProcessCleanupDatabaseRequest(RequestInfo& req);
     void ProcessSummaryRequest(RequestInfo& req);
+    void ProcessMemoryReportRequest(RequestInfo& req);
     void ProcessAnalysisTrackStatisticsRequest(RequestInfo& req);
 
     bool SetupCommonTableArguments(rocprofvis_controller_arguments_t* args,
                                    const TableRequestParams&          table_params);
 
-    void CreateRawEventData(const TrackRequestParams& params, const RequestInfo& req);
-    void CreateRawSampleData(const TrackRequestParams& params,
-                             const RequestInfo&    req);
+    void CreateRawEventData(const TrackRequestParams& params, const RequestInfo& req,
+                            std::vector<TraceEvent>&& buffer);
+    void CreateRawSampleData(const TrackRequestParams& params, const RequestInfo& req,
+                             std::vector<TraceCounter>&& buffer);
     void CreateSummaryData(rocprofvis_handle_t* metrics_handle,
                            std::vector<size_t>& sub_metrics_idx);
 
-    rocprofvis_result_t GetString(rocprofvis_handle_t*  handle,
-                                  rocprofvis_property_t property, uint64_t index,
-                                  std::string& out_string);
-
     std::string GetString(rocprofvis_handle_t* handle, rocprofvis_property_t property,
                           uint64_t index);
 
@@ -325,6 +474,48 @@ private:
     TraceDataModel m_model;
 
     std::unordered_map<int64_t, RequestInfo> m_requests;
+    // Converts track and graph responses into view buffers off the UI thread
+    TrackResponseConverter m_track_converter;
+    // Converted responses not yet merged into the model, carried over between frames
+    std::deque<std::unique_ptr<ConvertedTrackResponse>> m_converted_responses;
+    // UI thread time spent on responses per frame, at least one response is always handled
+    static constexpr std::chrono::microseconds RESPONSE_FRAME_BUDGET{ 4000 };
+
+    enum class PrefetchDirection
+    {
+        kNone,
+        kLeft,
+        kRight,
+        kZoomOut
+    };
+    // View motion tracked by UpdatePrefetch
+    struct PrefetchState
+    {
+        std::chrono::steady_clock::time_point last_update;
+        double            last_center   = 0.0;
+        double            last_width    = 0.0;
+        double            pan_velocity  = 0.0;  // viewports per second, positive to the right
+        double            zoom_velocity = 0.0;  // log of width change per second
+        PrefetchDirection direction     = PrefetchDirection::kNone;  // of the last prefetch
+        double            start_ts      = 0.0;  // range of the last prefetch
+        double            end_ts        = 0.0;
+    };
+    PrefetchState m_prefetch;
+    // Range and horizontal resolution of the data request that follows a move in
+    // the direction, the request repeats the loaded range at the same resolution
+    static void GetPrefetchRange(PrefetchDirection direction, double view_width,
+                                 double loaded_start_ts, double loaded_end_ts,
+                                 uint32_t loaded_resolution, double& start_ts,
+                                 double& end_ts, uint32_t& resolution);
+    // A prefetch is only wasted once the view moves another way, not when it stops
+    static bool IsPrefetchStale(PrefetchDirection issued, PrefetchDirection current);
+    // Weight of the newest frame in the smoothed velocities
+    static constexpr double PREFETCH_SMOOTHING = 0.3;
+    // Velocities that start a prefetch
+    static constexpr double PREFETCH_PAN_VELOCITY  = 0.5;
+    static constexpr double PREFETCH_ZOOM_VELOCITY = 0.5;
+    // Frames further apart than this restart the velocity estimate
+    static constexpr std::chrono::milliseconds PREFETCH_IDLE_RESET{ 250 };
     // Called when track metadata has changed
     std::function<void(const std::string&)> m_track_metadata_changed_callback;
     // Called when table data has changed
@@ -353,6 +544,9 @@ private:
     std::string m_progress_mesage;
     // Current loading status progress in percents
     uint64_t m_progress_percent;
+    // Last completed memory report, until it is taken
+    MemoryReport m_memory_report;
+    bool         m_memory_report_ready;
 
     void ProcessLoadComputeTrace(RequestInfo& req);
     inline void LoadWorkload(uint64_t workload_index);
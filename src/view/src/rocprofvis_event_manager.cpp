@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: MIT
 
 #include "rocprofvis_event_manager.h"
+#include "rocprofvis_core_profile.h"
 #include "spdlog/spdlog.h"
 
 #include <algorithm>
@@ -32,13 +33,14 @@ EventManager::DestroyInstance()
     }
 }
 
-EventManager::EventManager(): m_next_token(0) {};
+EventManager::EventManager(): m_next_token(0), m_open_track_data_source(0) {};
 
 EventManager::~EventManager()
 {
     {
         std::lock_guard<std::mutex> lock(m_queue_mutex);
         m_event_queue.clear();
+        m_open_track_data_batch.reset();
     }
     m_subscriptions.clear();
     m_next_token = 0;
@@ -49,6 +51,41 @@ EventManager::AddEvent(std::shared_ptr<RocEvent> event)
 {
     std::lock_guard<std::mutex> lock(m_queue_mutex);
     m_event_queue.push_back(std::move(event));
+    m_open_track_data_batch.reset();
+}
+
+uint32_t
+EventManager::RegisterSource(const std::string& source_id)
+{
+    std::lock_guard<std::mutex> lock(m_source_mutex);
+    auto it = std::find(m_sources.begin(), m_sources.end(), source_id);
+    if(it != m_sources.end())
+    {
+        return static_cast<uint32_t>(it - m_sources.begin());
+    }
+    m_sources.push_back(source_id);
+    return static_cast<uint32_t>(m_sources.size() - 1);
+}
+
+void
+EventManager::AddTrackDataEvent(const TrackDataNotice& notice)
+{
+    std::lock_guard<std::mutex> lock(m_queue_mutex);
+    if(!m_open_track_data_batch || m_open_track_data_source != notice.source)
+    {
+        std::string source_id;
+        {
+            std::lock_guard<std::mutex> source_lock(m_source_mutex);
+            if(notice.source < m_sources.size())
+            {
+                source_id = m_sources[notice.source];
+            }
+        }
+        m_open_track_data_batch  = std::make_shared<TrackDataBatchEvent>(source_id);
+        m_open_track_data_source = notice.source;
+        m_event_queue.push_back(m_open_track_data_batch);
+    }
+    m_open_track_data_batch->AddNotice(notice);
 }
 
 bool
@@ -108,30 +145,40 @@ EventManager::Unsubscribe(int event_id, SubscriptionToken token)
 void
 EventManager::DispatchEvents()
 {
-    std::list<std::shared_ptr<RocEvent>> pending;
+    PROFILE_ZONE("view", "Dispatch events");
     {
         std::lock_guard<std::mutex> lock(m_queue_mutex);
-        pending.swap(m_event_queue);
+        m_dispatch_queue.swap(m_event_queue);
+        m_open_track_data_batch.reset();
     }
+    PROFILE_COUNTER("View event queue depth", m_dispatch_queue.size());
 
-    for(auto& event : pending)
+    // Handlers may queue new events, those are dispatched on the next call.
+    for(const std::shared_ptr<RocEvent>& event : m_dispatch_queue)
     {
-        if(!event)
-        {
-            continue;
-        }
+        DispatchEvent(event);
+    }
+    m_dispatch_queue.clear();
+}
+
+void
+EventManager::DispatchEvent(const std::shared_ptr<RocEvent>& event)
+{
+    if(!event)
+    {
+        return;
+    }
 
-        auto it = m_subscriptions.find(event->GetId());
-        if(it != m_subscriptions.end())
+    auto it = m_subscriptions.find(event->GetId());
+    if(it != m_subscriptions.end())
+    {
+        auto& handlers = it->second;
+        for(auto& handler : handlers)
         {
-            auto& handlers = it->second;
-            for(auto& handler : handlers)
+            handler.second(event);
+            if(!event->CanPropagate())
             {
-                handler.second(event);
-                if(!event->CanPropagate())
-                {
-                    break;
-                }
+                break;
             }
         }
     }
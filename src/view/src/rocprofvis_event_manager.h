@@ -6,11 +6,12 @@
 #include "rocprofvis_events.h"
 #include "rocprofvis_shared_types.h"
 
+#include <cstdint>
 #include <functional>
-#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <vector>
 
 namespace RocProfVis
@@ -38,6 +39,15 @@ public:
     // Thread-safe. Queues an event for the next DispatchEvents() on the main thread.
     void AddEvent(std::shared_ptr<RocEvent> event);
 
+    // Thread-safe. Returns the handle of a source ID for track data notices,
+    // the same ID always maps to the same handle.
+    uint32_t RegisterSource(const std::string& source_id);
+
+    // Thread-safe. Queues a track data response. Responses of one source queued
+    // back to back are appended to the same TrackDataBatchEvent, which keeps its
+    // place among the other queued events.
+    void AddTrackDataEvent(const TrackDataNotice& notice);
+
     // Thread-safe. True while events are queued for deferred dispatch (keeps
     // lazy render on).
     bool HasPendingEvents() const;
@@ -45,11 +55,20 @@ public:
 private:
     EventManager();
     ~EventManager();
+    void DispatchEvent(const std::shared_ptr<RocEvent>& event);
+
     size_t m_next_token;
     std::map<int, std::vector<std::pair<SubscriptionToken, EventHandler>>>
-                                         m_subscriptions;
-    mutable std::mutex                   m_queue_mutex;
-    std::list<std::shared_ptr<RocEvent>> m_event_queue;
+                                           m_subscriptions;
+    mutable std::mutex                     m_queue_mutex;
+    std::vector<std::shared_ptr<RocEvent>> m_event_queue;
+    std::vector<std::shared_ptr<RocEvent>> m_dispatch_queue;  // Main thread only
+    // Last queued event when it is a track data batch, guarded by m_queue_mutex
+    std::shared_ptr<TrackDataBatchEvent>   m_open_track_data_batch;
+    uint32_t                               m_open_track_data_source;
+
+    std::mutex               m_source_mutex;
+    std::vector<std::string> m_sources;
 
     static EventManager* s_instance;
 };
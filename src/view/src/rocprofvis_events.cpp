@@ -83,35 +83,24 @@ RocEvent::GetSourceId() const
     return m_source_id;
 }
 
-// TrackDataEvent Implementation
+// TrackDataBatchEvent Implementation
 
-TrackDataEvent::TrackDataEvent(int event_id, uint64_t track_id,
-                               const std::string& source_id, uint64_t request_id,
-                               uint64_t response_code)
-: RocEvent(event_id, source_id)
-, m_track_id(track_id)
-, m_request_id(request_id)
-, m_response_code(response_code)
+TrackDataBatchEvent::TrackDataBatchEvent(const std::string& source_id)
+: RocEvent(static_cast<int>(RocEvents::kNewTrackData), source_id)
 {
     m_event_type = RocEventType::kTrackDataEvent;
 }
 
-uint64_t
-TrackDataEvent::GetTrackID() const
-{
-    return m_track_id;
-}
-
-uint64_t
-TrackDataEvent::GetRequestID() const
+void
+TrackDataBatchEvent::AddNotice(const TrackDataNotice& notice)
 {
-    return m_request_id;
+    m_notices.push_back(notice);
 }
 
-uint64_t
-TrackDataEvent::GetResponseCode() const
+const std::vector<TrackDataNotice>&
+TrackDataBatchEvent::GetNotices() const
 {
-    return m_response_code;
+    return m_notices;
 }
 
 TableDataEvent::TableDataEvent(const std::string& source_id, uint64_t request_id, uint64_t response_code)
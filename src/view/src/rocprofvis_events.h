@@ -155,19 +155,25 @@ private:
     uint64_t m_track_id;
 };
 
-class TrackDataEvent : public RocEvent
+// Fixed size payload of a track data response.
+struct TrackDataNotice
+{
+    uint64_t track_id;
+    uint64_t request_id;
+    uint64_t response_code;
+    uint32_t source;  // Source handle from EventManager::RegisterSource()
+};
+
+// Track data responses of one source that were queued back to back.
+class TrackDataBatchEvent : public RocEvent
 {
 public:
-    TrackDataEvent(int event_id, uint64_t track_id, const std::string& source_id,
-                   uint64_t request_id, uint64_t response_code);
-    uint64_t           GetTrackID() const;
-    uint64_t           GetRequestID() const;
-    uint64_t           GetResponseCode() const;
+    TrackDataBatchEvent(const std::string& source_id);
+    void                                AddNotice(const TrackDataNotice& notice);
+    const std::vector<TrackDataNotice>& GetNotices() const;
 
 private:
-    uint64_t    m_track_id;
-    uint64_t    m_request_id;
-    uint64_t    m_response_code;
+    std::vector<TrackDataNotice> m_notices;
 };
 
 class TableDataEvent : public RocEvent
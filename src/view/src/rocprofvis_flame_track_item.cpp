@@ -39,6 +39,11 @@ inline constexpr float FLAME_MIN_TRACK_HEIGHT   = 28.0f;
 inline constexpr float MIN_EVENT_BOX_HEIGHT     = 1.0f;
 inline constexpr float DEFAULT_VISIBLE_LEVELS   = 2.0f;
 inline constexpr float TRACK_HEIGHT_EPSILON     = 1.0f;
+// Graph widths of geometry cached on either side of the view, pans within it only
+// translate the cached vertices.
+inline constexpr float GEOMETRY_CACHE_MARGIN = 1.0f;
+// Distinct event names kept in the label layout cache before it is reset.
+inline constexpr size_t LABEL_LAYOUT_CACHE_MAX_ENTRIES = 65536;
 
 /*
 For IMGUI rectangle borders ANTI_ALIASING_WORKAROUND is needed to avoid anti-aliasing
@@ -49,6 +54,10 @@ constexpr float ANTI_ALIASING_WORKAROUND = 1.0f;
 const std::string FlameTrackItem::s_child_info_separator  = "|";
 float             FlameTrackItem::s_max_event_label_width = 0.0f;
 
+std::unordered_map<size_t, FlameTrackItem::LabelLayout> FlameTrackItem::s_label_layouts;
+const ImFont* FlameTrackItem::s_label_layout_font      = nullptr;
+float         FlameTrackItem::s_label_layout_font_size = 0.0f;
+
 void
 FlameTrackItem::CalculateMaxEventLabelWidth()
 {
@@ -179,8 +188,8 @@ FlameTrackItem::RenderMetaAreaExpand()
             ImGui::SetCursorPos(button_pos);
             if(ImGui::ArrowButton("##contract", ImGuiDir_Up))
             {
-                m_options->m_height       = default_height;
-                m_track_height_changed    = true;
+                m_options->m_height = default_height;
+                MarkTrackHeightChanged();
                 m_event_options->m_expand = false;
             }
             if(ImGui::IsItemHovered()) SetTooltipStyled("Contract track to default height");
@@ -255,8 +264,8 @@ FlameTrackItem::Update()
                 }
                 else if(was_default)
                 {
-                    m_options->m_height    = DefaultTrackHeight();
-                    m_track_height_changed = true;
+                    m_options->m_height = DefaultTrackHeight();
+                    MarkTrackHeightChanged();
                 }
             }
         }
@@ -270,8 +279,8 @@ FlameTrackItem::Update()
     UpdateMinTrackHeight();
     if(m_options && m_options->m_height < m_min_track_height)
     {
-        m_options->m_height    = m_min_track_height;
-        m_track_height_changed = true;
+        m_options->m_height = m_min_track_height;
+        MarkTrackHeightChanged();
     }
 
     TrackItem::Update();
@@ -283,6 +292,7 @@ FlameTrackItem::ReleaseData()
     if(TrackItem::ReleaseData())
     {
         m_chart_items.clear();
+        InvalidateGeometryCache();
         return true;
     }
     return false;
@@ -323,6 +333,8 @@ FlameTrackItem::ExtractPointsFromData()
         return;
     }
 
+    InvalidateGeometryCache();
+
     // Update selection state cache.
     const std::vector<TraceEvent>& events_data = event_track->GetData();
     m_chart_items.resize(events_data.size());
@@ -468,8 +480,8 @@ FlameTrackItem::HandleFontSizeChanged(std::shared_ptr<RocEvent> e)
 
     if(was_default)
     {
-        m_options->m_height    = DefaultTrackHeight();
-        m_track_height_changed = true;
+        m_options->m_height = DefaultTrackHeight();
+        MarkTrackHeightChanged();
     }
     else if(was_expanded)
     {
@@ -483,7 +495,7 @@ FlameTrackItem::HandleFontSizeChanged(std::shared_ptr<RocEvent> e)
     {
         const float scale   = m_level_height / previous_level_height;
         m_options->m_height = std::max(m_min_track_height, m_options->m_height * scale);
-        m_track_height_changed = true;
+        MarkTrackHeightChanged();
     }
 }
 
@@ -537,6 +549,71 @@ FlameTrackItem::TextGlyphCenter()
     return s_cached_glyph_center;
 }
 
+size_t
+FlameTrackItem::VisibleLabelLength(const std::string& label, size_t label_hash,
+                                   float available_width)
+{
+    // Layouts only depend on the font, drop them all when it changes
+    ImFont*     font      = ImGui::GetFont();
+    const float font_size = ImGui::GetFontSize();
+    if(font != s_label_layout_font || font_size != s_label_layout_font_size ||
+       s_label_layouts.size() >= LABEL_LAYOUT_CACHE_MAX_ENTRIES)
+    {
+        s_label_layouts.clear();
+        s_label_layout_font      = font;
+        s_label_layout_font_size = font_size;
+    }
+
+    LabelLayout& layout = s_label_layouts[label_hash];
+    if(layout.text != label || layout.prefix_widths.size() != label.size())
+    {
+        // New name or a hash collision, measure the name once
+        layout.text = label;
+        layout.prefix_widths.resize(label.size());
+
+        ImFontBaked* baked = ImGui::GetFontBaked();
+        const float  scale =
+            (baked && baked->Size > 0.0f) ? font_size / baked->Size : 1.0f;
+        float  width = 0.0f;
+        size_t i     = 0;
+        while(i < label.size())
+        {
+            const unsigned char c      = static_cast<unsigned char>(label[i]);
+            size_t              length = 1;
+            if(c < 0x80)
+            {
+                width += baked ? baked->GetCharAdvance(static_cast<ImWchar>(c)) * scale
+                               : 0.0f;
+            }
+            else
+            {
+                length = (c >= 0xF0) ? 4 : (c >= 0xE0) ? 3 : (c >= 0xC0) ? 2 : 1;
+                length = std::min(length, label.size() - i);
+                width += font->CalcTextSizeA(font_size, FLT_MAX, 0.0f, label.c_str() + i,
+                                             label.c_str() + i + length)
+                             .x;
+            }
+            std::fill_n(layout.prefix_widths.begin() + i, length, width);
+            i += length;
+        }
+    }
+
+    // Longest prefix that fits, plus the character cut by the edge which the clip
+    // rect trims.
+    const std::vector<float>& widths = layout.prefix_widths;
+    size_t                    length =
+        std::upper_bound(widths.begin(), widths.end(), available_width) - widths.begin();
+    if(length < widths.size())
+    {
+        const float cut_width = widths[length];
+        while(length < widths.size() && widths[length] == cut_width)
+        {
+            length++;
+        }
+    }
+    return length;
+}
+
 float
 FlameTrackItem::ComputeTextVerticalOffset(float box_height) const
 {
@@ -547,38 +624,14 @@ FlameTrackItem::ComputeTextVerticalOffset(float box_height) const
     return std::max(0.0f, box_height * 0.5f - TextGlyphCenter());
 }
 
-void
-FlameTrackItem::DrawBox(ImVec2 start_position, ChartItem& chart_item, float duration,
-                        ImDrawList* draw_list, bool use_highlight_color)
+ImU32
+FlameTrackItem::GetBoxColor(const ChartItem& chart_item, bool use_highlight_color,
+                            size_t& color_index) const
 {
-    ImVec2 cursor_position = ImGui::GetCursorScreenPos();
-    ImVec2 content_size    = ImGui::GetContentRegionAvail();
-
-    const float box_height = EventBoxHeight();
-
-    ImVec2 rectMin = ImVec2(start_position.x, start_position.y + cursor_position.y);
-    ImVec2 rectMax = ImVec2(start_position.x + duration,
-                            start_position.y + box_height + cursor_position.y);
-
-#ifdef IMGUI_ENABLE_TEST_ENGINE
-    // Bars are raw draw_list rects with no ImGui ID, so the Test Engine can't
-    // find them by ref. Register each bar's bounding box with the engine under a
-    // stable per-event ID; tests then locate bars via GatherItems/ItemInfo. This
-    // compiles out of production and adds no widget.
-    {
-        ImGuiContext& g           = *GImGui;
-        ImGuiWindow*  test_window = ImGui::GetCurrentWindow();
-        ImGuiID       bar_id      = test_window->GetID(
-            reinterpret_cast<const void*>(
-                static_cast<uintptr_t>(chart_item.event.m_id.uuid)));
-        IMGUI_TEST_ENGINE_ITEM_ADD(bar_id, ImRect(rectMin, rectMax), nullptr);
-    }
-#endif
-
     const std::vector<ImU32>& color_wheel =
         use_highlight_color ? m_settings.GetHighlightedEventColorWheel()
                             : m_settings.GetColorWheel();
-    size_t color_index = 0;
+    color_index     = 0;
     ImU32 rectColor = use_highlight_color ? color_wheel[0]
                                           : m_settings.GetColor(Colors::kFlameChartColor);
     if(m_event_options)
@@ -603,6 +656,15 @@ FlameTrackItem::DrawBox(ImVec2 start_position, ChartItem& chart_item, float dura
         color_index = static_cast<size_t>(chart_item.name_hash) % color_wheel.size();
         rectColor   = color_wheel[color_index];
     }
+    return rectColor;
+}
+
+void
+FlameTrackItem::DrawBox(ImVec2 rectMin, ImVec2 rectMax, const ChartItem& chart_item,
+                        ImU32 rectColor, ImDrawList* draw_list, bool pin_label,
+                        std::vector<GeometryLabel>* labels, size_t item_index)
+{
+    const float box_height = rectMax.y - rectMin.y;
 
     float rounding = 2.0f;
     draw_list->AddRectFilled(rectMin, rectMax, rectColor, rounding);
@@ -610,105 +672,112 @@ FlameTrackItem::DrawBox(ImVec2 start_position, ChartItem& chart_item, float dura
     if(rectMax.x - rectMin.x > MIN_LABEL_WIDTH &&
        box_height >= ImGui::GetTextLineHeight())
     {
-        draw_list->PushClipRect(rectMin, rectMax, true);
-        const std::string label =
-            (chart_item.event.m_child_count > 1)
-                ? std::to_string(chart_item.event.m_child_count) + " events"
-                : chart_item.event.m_name;
-        const float text_y  = rectMin.y + m_text_vertical_offset;
+        // Clip the glyphs on the CPU so the label needs no draw command of its own
+        // and its vertices can be replayed anywhere.
+        const ImVec4 clip_rect(rectMin.x, rectMin.y, rectMax.x, rectMax.y);
+        const float  text_y  = rectMin.y + m_text_vertical_offset;
         ImVec2      textPos = ImVec2(rectMin.x + m_text_padding.x, text_y);
 
-        if(chart_item.event.m_child_count > 1)
+        // Labels of combined events are never pinned.
+        const bool pinnable = chart_item.event.m_child_count <= 1;
+        if(pinnable && pin_label && rectMin.x < draw_list->GetClipRectMin().x &&
+           rectMax.x > draw_list->GetClipRectMin().x)
+        {
+            // If the rectangle is partially outside the viewport then start rendering
+            // the text at the viewport edge to maintain readability.
+            textPos = ImVec2(draw_list->GetClipRectMin().x + m_text_padding.x, text_y);
+        }
+
+        // Names are cut to the glyphs that reach into the box, long kernel names
+        // would otherwise be laid out in full for every box.
+        std::string combined_label;
+        const char* label        = chart_item.event.m_name.c_str();
+        size_t      label_length = 0;
+        if(pinnable)
         {
-            draw_list->AddText(textPos, m_settings.GetColor(Colors::kTextMain),
-                               label.c_str());
+            label_length = VisibleLabelLength(chart_item.event.m_name, chart_item.name_hash,
+                                              rectMax.x - textPos.x);
         }
         else
         {
-            if(rectMin.x < draw_list->GetClipRectMin().x &&
-               rectMax.x > draw_list->GetClipRectMin().x)
-            {
-                // If the rectangle is partially outside the viewport then start rendering
-                // the text at the viewport edge to maintain readability.
-                textPos =
-                    ImVec2(draw_list->GetClipRectMin().x + m_text_padding.x, text_y);
-                draw_list->AddText(textPos, m_settings.GetColor(Colors::kTextMain),
-                                   label.c_str());
-            }
-            else
-            {
-                // The rectangle is fully inside the viewport, render text normally.
-                draw_list->AddText(textPos, m_settings.GetColor(Colors::kTextMain),
-                                   label.c_str());
-            }
+            combined_label = std::to_string(chart_item.event.m_child_count) + " events";
+            label          = combined_label.c_str();
+            label_length   = combined_label.size();
+        }
+
+        const int idx_start = draw_list->IdxBuffer.Size;
+        draw_list->AddText(ImGui::GetFont(), ImGui::GetFontSize(), textPos,
+                           m_settings.GetColor(Colors::kTextMain), label,
+                           label + label_length, 0.0f, &clip_rect);
+        if(pinnable && labels)
+        {
+            // Cached labels are drawn unpinned, replay swaps in a pinned one as needed.
+            labels->push_back({ item_index, rectMin.x, rectMax.x, idx_start,
+                                draw_list->IdxBuffer.Size - idx_start });
         }
-        draw_list->PopClipRect();
     }
-    if(ImGui::IsMouseHoveringRect(rectMin, rectMax) &&
-       ImGui::IsWindowHovered(ImGuiHoveredFlags_RootAndChildWindows |
-                              ImGuiHoveredFlags_NoPopupHierarchy))
+}
+
+void
+FlameTrackItem::HandleBoxInteraction(ChartItem& chart_item, bool use_highlight_color)
+{
+    // Select on click
+    if(IsMouseReleasedWithDragCheck(ImGuiMouseButton_Left) &&
+       TimelineFocusManager::GetInstance().GetFocusedLayer() !=
+           Layer::kInteractiveLayer)
+    {
+        // Defer on click execution to next frame if no other layer takes focus
+        TimelineFocusManager::GetInstance().RequestLayerFocus(Layer::kGraphLayer);
+    }
+    // Execute deferred click if layer has focus
+    else if(!m_deferred_click_handled &&
+            TimelineFocusManager::GetInstance().GetFocusedLayer() ==
+                Layer::kGraphLayer)
     {
-        // Select on click
-        if(IsMouseReleasedWithDragCheck(ImGuiMouseButton_Left) &&
-           TimelineFocusManager::GetInstance().GetFocusedLayer() !=
-               Layer::kInteractiveLayer)
+        m_deferred_click_handled       = true;
+        MeasurementController& measure = *m_measurement;
+
+        if(measure.IsMeasurementMode() && !measure.IsFreehandMode())
         {
-            // Defer on click execution to next frame if no other layer takes focus
-            TimelineFocusManager::GetInstance().RequestLayerFocus(Layer::kGraphLayer);
+            // Clicking after a complete measurement starts a new one.
+            if(measure.GetMeasurementState() == MeasurementState::kComplete)
+            {
+                m_timeline_selection->UnhighlightPersistentEvents();
+                measure.ClearMeasurement();
+            }
+            measure.SetMeasurementPoint(
+                chart_item.event.m_start_ts, chart_item.event.m_duration, m_track_id,
+                chart_item.event.m_level, chart_item.event.m_name,
+                chart_item.event.m_id.uuid);
+            m_timeline_selection->HighlightTrackEventPersistent(
+                m_track_id, chart_item.event.m_id.uuid);
         }
-        // Execute deferred click if layer has focus
-        else if(!m_deferred_click_handled &&
-                TimelineFocusManager::GetInstance().GetFocusedLayer() ==
-                    Layer::kGraphLayer)
+        else if(!measure.IsMeasurementMode())
         {
-            m_deferred_click_handled       = true;
-            MeasurementController& measure = *m_measurement;
+            chart_item.selected = !chart_item.selected;
 
-            if(measure.IsMeasurementMode() && !measure.IsFreehandMode())
+            if(!HotkeyManager::GetInstance().IsActionHeld(
+                   HotkeyActionId::kMultiSelect))
             {
-                // Clicking after a complete measurement starts a new one.
-                if(measure.GetMeasurementState() == MeasurementState::kComplete)
-                {
-                    m_timeline_selection->UnhighlightPersistentEvents();
-                    measure.ClearMeasurement();
-                }
-                measure.SetMeasurementPoint(
-                    chart_item.event.m_start_ts, chart_item.event.m_duration, m_track_id,
-                    chart_item.event.m_level, chart_item.event.m_name,
-                    chart_item.event.m_id.uuid);
-                m_timeline_selection->HighlightTrackEventPersistent(
-                    m_track_id, chart_item.event.m_id.uuid);
+                m_timeline_selection->UnselectAllEvents();
             }
-            else if(!measure.IsMeasurementMode())
-            {
-                chart_item.selected = !chart_item.selected;
 
-                if(!HotkeyManager::GetInstance().IsActionHeld(
-                       HotkeyActionId::kMultiSelect))
-                {
-                    m_timeline_selection->UnselectAllEvents();
-                }
-
-                chart_item.selected ? m_timeline_selection->SelectTrackEvent(
-                                          m_track_id, chart_item.event.m_id.uuid)
-                                    : m_timeline_selection->UnselectTrackEvent(
-                                          m_track_id, chart_item.event.m_id.uuid);
-            }
-            TimelineFocusManager::GetInstance().RequestLayerFocus(Layer::kNone);
-        }
-
-        // only show one tooltip per render cycle and if no other layer has focus
-        if(!m_has_drawn_tool_tip &&
-           TimelineFocusManager::GetInstance().GetFocusedLayer() == Layer::kNone)
-        {
-            RenderTooltip(chart_item, color_index);
-            m_has_drawn_tool_tip = true;
+            chart_item.selected ? m_timeline_selection->SelectTrackEvent(
+                                      m_track_id, chart_item.event.m_id.uuid)
+                                : m_timeline_selection->UnselectTrackEvent(
+                                      m_track_id, chart_item.event.m_id.uuid);
         }
+        TimelineFocusManager::GetInstance().RequestLayerFocus(Layer::kNone);
     }
 
-    if(chart_item.selected || chart_item.highlighted)
+    // only show one tooltip per render cycle and if no other layer has focus
+    if(!m_has_drawn_tool_tip &&
+       TimelineFocusManager::GetInstance().GetFocusedLayer() == Layer::kNone)
     {
-        m_selected_chart_items.push_back(chart_item);
+        size_t color_index = 0;
+        GetBoxColor(chart_item, use_highlight_color, color_index);
+        RenderTooltip(chart_item, color_index);
+        m_has_drawn_tool_tip = true;
     }
 }
 
@@ -894,8 +963,8 @@ FlameTrackItem::RecalculateTrackHeight()
 {
     if(m_options)
     {
-        m_options->m_height    = std::max(ExpandedTrackHeight(), DefaultTrackHeight());
-        m_track_height_changed = true;
+        m_options->m_height = std::max(ExpandedTrackHeight(), DefaultTrackHeight());
+        MarkTrackHeightChanged();
     }
 }
 
@@ -934,6 +1003,232 @@ FlameTrackItem::EventBoxHeight() const
                     m_level_height - m_settings.GetEventLevelSpacing());
 }
 
+bool
+FlameTrackItem::GeometryKey::operator==(const GeometryKey& other) const
+{
+    return pixels_per_ns == other.pixels_per_ns && graph_width == other.graph_width &&
+           level_height == other.level_height && box_height == other.box_height &&
+           font_size == other.font_size && font == other.font &&
+           font_texture == other.font_texture &&
+           font_uv_scale.x == other.font_uv_scale.x &&
+           font_uv_scale.y == other.font_uv_scale.y &&
+           color_wheel == other.color_wheel && flame_color == other.flame_color &&
+           text_color == other.text_color && color_mode == other.color_mode &&
+           has_range_selection == other.has_range_selection &&
+           range_start_ns == other.range_start_ns && range_end_ns == other.range_end_ns;
+}
+
+FlameTrackItem::GeometryKey
+FlameTrackItem::MakeGeometryKey(float graph_width, bool has_range_selection,
+                                double range_start_ns, double range_end_ns) const
+{
+    const ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+
+    GeometryKey key;
+    key.pixels_per_ns       = m_tpt->GetPixelsPerNs();
+    key.graph_width         = graph_width;
+    key.level_height        = m_level_height;
+    key.box_height          = EventBoxHeight();
+    key.font_size           = ImGui::GetFontSize();
+    key.font                = ImGui::GetFont();
+    // Glyph UVs move when the atlas texture is rebuilt or grows
+    key.font_texture        = atlas->TexData;
+    key.font_uv_scale       = atlas->TexUvScale;
+    key.color_wheel         = m_settings.GetColorWheel().data();
+    key.flame_color         = m_settings.GetColor(Colors::kFlameChartColor);
+    key.text_color          = m_settings.GetColor(Colors::kTextMain);
+    key.color_mode          = m_event_options
+                                  ? static_cast<int>(m_event_options->m_color_mode)
+                                  : -1;
+    key.has_range_selection = has_range_selection;
+    key.range_start_ns      = has_range_selection ? range_start_ns : 0.0;
+    key.range_end_ns        = has_range_selection ? range_end_ns : 0.0;
+    return key;
+}
+
+bool
+FlameTrackItem::NeedsGeometryRebuild(const GeometryCache& cache, const GeometryKey& key,
+                                     double pan_x)
+{
+    return !cache.built || !(cache.key == key) ||
+           (cache.valid && std::abs(pan_x) > GEOMETRY_CACHE_MARGIN * key.graph_width);
+}
+
+bool
+FlameTrackItem::BuildGeometryCache(const GeometryKey& key, ImDrawList* draw_list,
+                                   ImVec2 container_pos, ImVec2 cursor_position)
+{
+    GeometryCache& cache = m_geometry_cache;
+    cache.built          = true;
+    cache.valid          = false;
+    cache.key            = key;
+    cache.view_offset_ns = m_tpt->GetViewTimeOffsetNs();
+    cache.origin         = ImVec2(container_pos.x, cursor_position.y);
+    cache.vertices.clear();
+    cache.indices.clear();
+    cache.labels.clear();
+
+    const int          vtx_start = draw_list->VtxBuffer.Size;
+    const int          idx_start = draw_list->IdxBuffer.Size;
+    const unsigned int vtx_base  = draw_list->_VtxCurrentIdx;
+    const int          cmd_count = draw_list->CmdBuffer.Size;
+
+    const float  box_height = EventBoxHeight();
+    const double span_min_x = container_pos.x - GEOMETRY_CACHE_MARGIN * key.graph_width;
+    const double span_max_x =
+        container_pos.x + (1.0f + GEOMETRY_CACHE_MARGIN) * key.graph_width;
+    for(size_t i = 0; i < m_chart_items.size(); i++)
+    {
+        const ChartItem& item = m_chart_items[i];
+
+        double normalized_start =
+            container_pos.x + m_tpt->RawTimeToPixel(item.event.m_start_ts);
+        double normalized_duration =
+            std::max(item.event.m_duration * m_tpt->GetPixelsPerNs(), 1.0);
+        if(normalized_start + normalized_duration < span_min_x ||
+           normalized_start > span_max_x)
+        {
+            continue;
+        }
+        if(normalized_duration > std::numeric_limits<float>::max())
+        {
+            normalized_duration = std::numeric_limits<float>::max();
+        }
+
+        const float box_y   = item.event.m_level * m_level_height + cursor_position.y;
+        ImVec2      rectMin = ImVec2(static_cast<float>(normalized_start), box_y);
+        ImVec2      rectMax = ImVec2(
+            static_cast<float>(normalized_start + normalized_duration), box_y + box_height);
+
+        const bool use_highlight_color =
+            key.has_range_selection && item.event.m_start_ts <= key.range_end_ns &&
+            item.event.m_start_ts + item.event.m_duration >= key.range_start_ns;
+        size_t color_index = 0;
+        DrawBox(rectMin, rectMax, item, GetBoxColor(item, use_highlight_color, color_index),
+                draw_list, false, &cache.labels, i);
+    }
+
+    const int vtx_count = draw_list->VtxBuffer.Size - vtx_start;
+    const int idx_count = draw_list->IdxBuffer.Size - idx_start;
+    if(draw_list->CmdBuffer.Size != cmd_count ||
+       draw_list->_VtxCurrentIdx != vtx_base + static_cast<unsigned int>(vtx_count))
+    {
+        // The draw list started a new command (16-bit index wrap or a font texture
+        // change), the geometry cannot be moved. Keep it drawn as is for this frame.
+        spdlog::debug("Flame track {} geometry not cacheable", m_track_id);
+        cache.labels.clear();
+        return vtx_count > 0;
+    }
+
+    cache.vertices.assign(draw_list->VtxBuffer.Data + vtx_start,
+                          draw_list->VtxBuffer.Data + vtx_start + vtx_count);
+    cache.indices.resize(idx_count);
+    for(int i = 0; i < idx_count; i++)
+    {
+        cache.indices[i] =
+            static_cast<ImDrawIdx>(draw_list->IdxBuffer[idx_start + i] - vtx_base);
+    }
+    for(GeometryLabel& label : cache.labels)
+    {
+        label.idx_start -= idx_start;
+    }
+    cache.valid = true;
+
+    // Take the geometry back out of the draw list, the replay emits it
+    draw_list->VtxBuffer.shrink(vtx_start);
+    draw_list->IdxBuffer.shrink(idx_start);
+    draw_list->_VtxWritePtr   = draw_list->VtxBuffer.Data + vtx_start;
+    draw_list->_IdxWritePtr   = draw_list->IdxBuffer.Data + idx_start;
+    draw_list->_VtxCurrentIdx = vtx_base;
+    draw_list->CmdBuffer.back().ElemCount -= idx_count;
+    return false;
+}
+
+void
+FlameTrackItem::ReplayGeometryCache(ImDrawList* draw_list, ImVec2 container_pos,
+                                    ImVec2 cursor_position)
+{
+    const GeometryCache& cache = m_geometry_cache;
+    if(cache.vertices.empty())
+    {
+        return;
+    }
+
+    const double pan_x = (m_tpt->GetViewTimeOffsetNs() - cache.view_offset_ns) *
+                         m_tpt->GetPixelsPerNs();
+    const float dx = static_cast<float>(container_pos.x - cache.origin.x - pan_x);
+    const float dy = cursor_position.y - cache.origin.y;
+
+    // Labels of boxes straddling the left edge are drawn pinned to it instead
+    const float clip_min_x = draw_list->GetClipRectMin().x;
+    int         idx_count  = static_cast<int>(cache.indices.size());
+    m_pinned_labels.clear();
+    for(size_t i = 0; i < cache.labels.size(); i++)
+    {
+        const GeometryLabel& label = cache.labels[i];
+        if(label.box_min_x + dx < clip_min_x && label.box_max_x + dx > clip_min_x)
+        {
+            m_pinned_labels.push_back(i);
+            idx_count -= label.idx_count;
+        }
+    }
+
+    const int vtx_count = static_cast<int>(cache.vertices.size());
+    draw_list->PrimReserve(idx_count, vtx_count);
+    // Read after reserving, it restarts at 0 when the draw list moves to a new
+    // vertex offset
+    const unsigned int vtx_base = draw_list->_VtxCurrentIdx;
+
+    auto write_indices = [&](int begin, int end) {
+        for(int i = begin; i < end; i++)
+        {
+            draw_list->PrimWriteIdx(static_cast<ImDrawIdx>(vtx_base + cache.indices[i]));
+        }
+    };
+    int next_idx = 0;
+    for(size_t label_index : m_pinned_labels)
+    {
+        const GeometryLabel& label = cache.labels[label_index];
+        write_indices(next_idx, label.idx_start);
+        next_idx = label.idx_start + label.idx_count;
+    }
+    write_indices(next_idx, static_cast<int>(cache.indices.size()));
+
+    for(const ImDrawVert& vertex : cache.vertices)
+    {
+        draw_list->PrimWriteVtx(ImVec2(vertex.pos.x + dx, vertex.pos.y + dy), vertex.uv,
+                                vertex.col);
+    }
+
+    for(size_t label_index : m_pinned_labels)
+    {
+        const GeometryLabel& label = cache.labels[label_index];
+        const ChartItem&     item  = m_chart_items[label.item_index];
+
+        const float  box_y  = item.event.m_level * m_level_height + cursor_position.y;
+        const float  text_x = clip_min_x + m_text_padding.x;
+        const ImVec4 clip_rect(label.box_min_x + dx, box_y, label.box_max_x + dx,
+                               box_y + EventBoxHeight());
+        const char*  text   = item.event.m_name.c_str();
+        draw_list->AddText(ImGui::GetFont(), ImGui::GetFontSize(),
+                           ImVec2(text_x, box_y + m_text_vertical_offset),
+                           m_settings.GetColor(Colors::kTextMain), text,
+                           text + VisibleLabelLength(item.event.m_name, item.name_hash,
+                                                     clip_rect.z - text_x),
+                           0.0f, &clip_rect);
+    }
+}
+
+void
+FlameTrackItem::InvalidateGeometryCache()
+{
+    m_geometry_cache.built = false;
+    m_geometry_cache.valid = false;
+    m_geometry_cache.vertices.clear();
+    m_geometry_cache.indices.clear();
+    m_geometry_cache.labels.clear();
+}
+
 void
 FlameTrackItem::RenderChart(float graph_width)
 {
@@ -956,9 +1251,34 @@ FlameTrackItem::RenderChart(float graph_width)
     const bool has_time_range_selection =
         m_timeline_selection->GetSelectedTimeRange(range_start_ns, range_end_ns);
 
-    for(ChartItem& item : m_chart_items)
+    ImVec2 container_pos   = ImGui::GetWindowPos();
+    ImVec2 cursor_position = ImGui::GetCursorScreenPos();
+
+    // Replay the cached boxes and labels unless something other than the position
+    // changed or the view was panned past the cached span.
+    const GeometryKey key =
+        MakeGeometryKey(graph_width, has_time_range_selection, range_start_ns, range_end_ns);
+    const double pan_x =
+        (m_tpt->GetViewTimeOffsetNs() - m_geometry_cache.view_offset_ns) *
+        m_tpt->GetPixelsPerNs();
+    bool drawn = false;
+    if(NeedsGeometryRebuild(m_geometry_cache, key, pan_x))
+    {
+        drawn = BuildGeometryCache(key, draw_list, container_pos, cursor_position);
+    }
+    if(m_geometry_cache.valid)
     {
-        ImVec2 container_pos = ImGui::GetWindowPos();
+        ReplayGeometryCache(draw_list, container_pos, cursor_position);
+        drawn = true;
+    }
+
+    // Hit testing and the selection outline still need the visible items.
+    const bool window_hovered = ImGui::IsWindowHovered(
+        ImGuiHoveredFlags_RootAndChildWindows | ImGuiHoveredFlags_NoPopupHierarchy);
+    const float box_height = EventBoxHeight();
+    for(size_t i = 0; i < m_chart_items.size(); i++)
+    {
+        ChartItem& item = m_chart_items[i];
 
         double normalized_start =
             container_pos.x + m_tpt->RawTimeToPixel(item.event.m_start_ts);
@@ -967,12 +1287,6 @@ FlameTrackItem::RenderChart(float graph_width)
             std::max(item.event.m_duration * m_tpt->GetPixelsPerNs(), 1.0);
         double normalized_end = normalized_start + normalized_duration;
 
-        ImVec2 start_position;
-
-        // Calculate the start position based on the normalized start time and level
-        start_position = ImVec2(static_cast<float>(normalized_start),
-                                item.event.m_level * m_level_height);
-
         if(normalized_end < container_pos.x ||
            normalized_start > container_pos.x + graph_width)
         {
@@ -984,17 +1298,52 @@ FlameTrackItem::RenderChart(float graph_width)
             normalized_duration = std::numeric_limits<float>::max();
         }
 
+        // Calculate the box based on the normalized start time and level
+        const float box_y   = item.event.m_level * m_level_height + cursor_position.y;
+        ImVec2      rectMin = ImVec2(static_cast<float>(normalized_start), box_y);
+        ImVec2      rectMax = ImVec2(
+            static_cast<float>(normalized_start + normalized_duration), box_y + box_height);
+
         const bool use_highlight_color =
             has_time_range_selection && item.event.m_start_ts <= range_end_ns &&
             item.event.m_start_ts + item.event.m_duration >= range_start_ns;
 
-        DrawBox(start_position, item, static_cast<float>(normalized_duration), draw_list,
-                use_highlight_color);
+        if(!drawn)
+        {
+            size_t color_index = 0;
+            DrawBox(rectMin, rectMax, item,
+                    GetBoxColor(item, use_highlight_color, color_index), draw_list, true,
+                    nullptr, i);
+        }
+
+#ifdef IMGUI_ENABLE_TEST_ENGINE
+        // Bars are raw draw_list rects with no ImGui ID, so the Test Engine can't
+        // find them by ref. Register each bar's bounding box with the engine under a
+        // stable per-event ID; tests then locate bars via GatherItems/ItemInfo. This
+        // compiles out of production and adds no widget.
+        {
+            ImGuiContext& g           = *GImGui;
+            ImGuiWindow*  test_window = ImGui::GetCurrentWindow();
+            ImGuiID       bar_id      = test_window->GetID(
+                reinterpret_cast<const void*>(
+                    static_cast<uintptr_t>(item.event.m_id.uuid)));
+            IMGUI_TEST_ENGINE_ITEM_ADD(bar_id, ImRect(rectMin, rectMax), nullptr);
+        }
+#endif
+
+        if(window_hovered && ImGui::IsMouseHoveringRect(rectMin, rectMax))
+        {
+            HandleBoxInteraction(item, use_highlight_color);
+        }
+
+        if(item.selected || item.highlighted)
+        {
+            m_selected_chart_items.push_back(item);
+        }
     }
 
     for(ChartItem& item : m_selected_chart_items)
     {
-        ImVec2 container_pos = ImGui::GetWindowPos();
         double normalized_start =
             container_pos.x + m_tpt->RawTimeToPixel(item.event.m_start_ts);
 
@@ -1005,10 +1354,6 @@ FlameTrackItem::RenderChart(float graph_width)
         ImVec2 start_position = ImVec2(static_cast<float>(normalized_start),
                                        item.event.m_level * m_level_height);
 
-        ImVec2 cursor_position = ImGui::GetCursorScreenPos();
-
-        const float box_height = EventBoxHeight();
-
         ImVec2 rectMin = ImVec2(start_position.x - HIGHLIGHT_THICKNESS_HALF,
                                 start_position.y + cursor_position.y +
                                     HIGHLIGHT_THICKNESS_HALF - ANTI_ALIASING_WORKAROUND);
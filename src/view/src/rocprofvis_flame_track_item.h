@@ -9,6 +9,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace RocProfVis
@@ -67,12 +68,81 @@ private:
         std::vector<ChildEventInfo> child_info;
     };
 
+    // Everything the chart geometry depends on apart from its position.
+    struct GeometryKey
+    {
+        double        pixels_per_ns;
+        float         graph_width;
+        float         level_height;
+        float         box_height;
+        float         font_size;
+        const ImFont* font;
+        const void*   font_texture;
+        ImVec2        font_uv_scale;
+        const void*   color_wheel;
+        ImU32         flame_color;
+        ImU32         text_color;
+        int           color_mode;
+        bool          has_range_selection;
+        double        range_start_ns;
+        double        range_end_ns;
+
+        bool operator==(const GeometryKey& other) const;
+    };
+
+    // Label width after each byte at the cached font, all bytes of a multi-byte
+    // character carry the width up to the end of that character.
+    struct LabelLayout
+    {
+        std::string        text;
+        std::vector<float> prefix_widths;
+    };
+
+    // Label that is pinned to the left edge while its box straddles it.
+    struct GeometryLabel
+    {
+        size_t item_index;
+        float  box_min_x;
+        float  box_max_x;
+        int    idx_start;
+        int    idx_count;
+    };
+
+    // Boxes and labels as emitted into the draw list, replayed while the key is
+    // unchanged and translated for pans within the cached span.
+    struct GeometryCache
+    {
+        bool                       built = false;
+        bool                       valid = false;
+        GeometryKey                key   = {};
+        double                     view_offset_ns = 0.0;
+        ImVec2                     origin;  // Window x and cursor y at build time
+        std::vector<ImDrawVert>    vertices;
+        std::vector<ImDrawIdx>     indices;  // Relative to the first vertex
+        std::vector<GeometryLabel> labels;
+    };
+
     void HandleTimelineSelectionChanged(std::shared_ptr<RocEvent> e);
     void HandleTimelineHighlightChanged(std::shared_ptr<RocEvent> e);
     void HandleFontSizeChanged(std::shared_ptr<RocEvent> e);
 
-    void DrawBox(ImVec2 start_position, ChartItem& flame, float duration,
-                 ImDrawList* draw_list, bool use_highlight_color);
+    ImU32 GetBoxColor(const ChartItem& chart_item, bool use_highlight_color,
+                      size_t& color_index) const;
+    void  DrawBox(ImVec2 rect_min, ImVec2 rect_max, const ChartItem& chart_item,
+                  ImU32 color, ImDrawList* draw_list, bool pin_label,
+                  std::vector<GeometryLabel>* labels, size_t item_index);
+    void  HandleBoxInteraction(ChartItem& chart_item, bool use_highlight_color);
+
+    GeometryKey MakeGeometryKey(float graph_width, bool has_range_selection,
+                                double range_start_ns, double range_end_ns) const;
+    // True unless the cache was built for key and pan_x pixels stay within its span.
+    static bool NeedsGeometryRebuild(const GeometryCache& cache, const GeometryKey& key,
+                                     double pan_x);
+    bool        BuildGeometryCache(const GeometryKey& key, ImDrawList* draw_list,
+                                   ImVec2 container_pos, ImVec2 cursor_position);
+    void        ReplayGeometryCache(ImDrawList* draw_list, ImVec2 container_pos,
+                                    ImVec2 cursor_position);
+    void        InvalidateGeometryCache();
 
     void ExtractPointsFromData() override;
     bool ExtractChildInfo(ChartItem& item);
@@ -88,6 +158,10 @@ private:
     float ComputeTextVerticalOffset(float box_height) const;
     // Font-size-dependent glyph ink center, shared/cached across all tracks.
     static float TextGlyphCenter();
+    // Bytes of an event name to draw so that every glyph starting within
+    // available_width is emitted, from layouts shared across all tracks.
+    static size_t VisibleLabelLength(const std::string& label, size_t label_hash,
+                                     float available_width);
 
     std::vector<ChartItem>                 m_chart_items;
     ImVec2                                 m_text_padding;
@@ -106,10 +180,16 @@ private:
     EventManager::SubscriptionToken m_timeline_event_highlight_changed_token;
     EventManager::SubscriptionToken m_font_size_changed_token;
     ImVec2                          m_tooltip_size;
+    GeometryCache                   m_geometry_cache;
+    std::vector<size_t>             m_pinned_labels;  // Indices into cache labels
 
     static float             s_max_event_label_width;
     static const std::string s_child_info_separator;
 
+    static std::unordered_map<size_t, LabelLayout> s_label_layouts;
+    static const ImFont*                           s_label_layout_font;
+    static float                                   s_label_layout_font_size;
+
     Pill* m_pill_analysis_queue;
 
 #ifdef IMGUI_ENABLE_TEST_ENGINE
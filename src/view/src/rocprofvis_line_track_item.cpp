@@ -10,6 +10,7 @@
 #include "rocprofvis_utils.h"
 #include "spdlog/spdlog.h"
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <iomanip>
 #include <sstream>
@@ -29,13 +30,15 @@ constexpr float Y_AXIS_GRID_LINE_ALPHA      = 0.10f;
 constexpr float Y_AXIS_LABEL_SPACING_FACTOR = 2.5f;
 // Interior ticks/labels/grid lines only show above this height.
 constexpr float Y_AXIS_LABEL_MIN_TRACK_HEIGHT = 2.0f * DEFAULT_TRACK_HEIGHT;
+// Decimation keeps up to this many samples per pixel column.
+constexpr size_t DECIMATION_POINTS_PER_COLUMN = 4;
 
 LineTrackItem::LineTrackItem(DataProvider& dp, uint64_t track_id,
                              TimelineTrackOptions&               track_options,
                              std::shared_ptr<TimePixelTransform> tpt,
                              std::shared_ptr<TimelineSelection>  timeline_selection)
 : TrackItem(dp, track_id, track_options, tpt, timeline_selection)
-, m_data({})
+, m_data(nullptr)
 , m_min_y("edit_min")
 , m_max_y("edit_max")
 , m_dp(dp)
@@ -82,7 +85,13 @@ LineTrackItem::LineTrackItem(DataProvider& dp, uint64_t track_id,
     ROCPROFVIS_ASSERT(m_counter_options);
 }
 
-LineTrackItem::~LineTrackItem() {}
+LineTrackItem::~LineTrackItem()
+{
+    if(m_decimation_job)
+    {
+        m_decimation_job->cancelled.store(true);
+    }
+}
 
 void
 LineTrackItem::UpdateMetadata()
@@ -184,14 +193,46 @@ LineTrackItem::BoxPlotRender(float graph_width)
         }
     }
 
+    UpdateDecimation();
+
+    // Draw the decimated points when available, hover and stripes refer to the
+    // samples they were taken from.
+    static const std::vector<TraceCounter> no_samples;
+    const std::vector<TraceCounter>*       source = m_data ? m_data.get() : &no_samples;
+    const std::vector<TraceCounter>*       points = source;
+    const std::vector<size_t>*             source_indices = nullptr;
+    if(m_decimated && !m_decimated->passthrough)
+    {
+        source         = m_decimated->source.get();
+        points         = &m_decimated->points;
+        source_indices = &m_decimated->source_indices;
+    }
+
+    // Only points overlapping the visible range, plus the neighbour before it
+    const double view_start = m_tpt->GetMinX() + m_tpt->GetViewTimeOffsetNs();
+    const double view_end   = view_start + m_tpt->GetVWidth();
+    auto         by_start   = [](const TraceCounter& point, double ts) {
+        return point.m_start_ts < ts;
+    };
+    size_t first = std::lower_bound(points->begin(), points->end(), view_start, by_start) -
+                   points->begin();
+    size_t last = std::lower_bound(points->begin() + first, points->end(), view_end,
+                                   by_start) -
+                  points->begin();
+    first       = first > 0 ? first - 1 : first;
+    last        = std::min(last + 1, points->size());
+
     int hovered_idx = -1;
-    size_t data_len = m_data.size();
-    for(size_t i = 0; i < data_len; ++i)
+    size_t data_len = points->size();
+    for(size_t i = first; i < last; ++i)
     {
-        ImVec2 point_start = MapToUI(m_data[i].m_start_ts, m_data[i].m_value,
-                                     cursor_position, content_size, scale_y);
-        ImVec2 point_end = MapToUI(m_data[i].m_end_ts, m_data[i].m_value, cursor_position,
-                                   content_size, scale_y);
+        const TraceCounter& point = (*points)[i];
+        size_t source_idx         = source_indices ? (*source_indices)[i] : i;
+
+        ImVec2 point_start = MapToUI(point.m_start_ts, point.m_value, cursor_position,
+                                     content_size, scale_y);
+        ImVec2 point_end   = MapToUI(point.m_end_ts, point.m_value, cursor_position,
+                                     content_size, scale_y);
 
         if(data_len == 1)
         {
@@ -204,7 +245,7 @@ LineTrackItem::BoxPlotRender(float graph_width)
         {
             if(m_counter_options->m_boxplot.enabled)
             {
-                if(m_counter_options->m_boxplot.stripes && (i % 2))
+                if(m_counter_options->m_boxplot.stripes && (source_idx % 2))
                 {
                     fill_color = alt_fill_color;
                 }
@@ -219,11 +260,12 @@ LineTrackItem::BoxPlotRender(float graph_width)
                                  ImVec2(point_end.x, bottom_of_chart), fill_color);
         draw_list->AddLine(point_start, point_end, outline_color, DEFAULT_LINE_THICKNESS);
 
-        if(i + 1 < m_data.size())
+        if(i + 1 < data_len)
         {
             // Map the start of the next box
-            ImVec2 next_point_start =
-                MapToUI(m_data[i + 1].m_start_ts, m_data[i + 1].m_value, cursor_position,
+            const TraceCounter& next_point = (*points)[i + 1];
+            ImVec2              next_point_start =
+                MapToUI(next_point.m_start_ts, next_point.m_value, cursor_position,
                         content_size, scale_y);
 
             draw_list->AddLine(point_end, next_point_start, outline_color,
@@ -236,7 +278,7 @@ LineTrackItem::BoxPlotRender(float graph_width)
                                   ImGuiHoveredFlags_NoPopupHierarchy) &&
            TimelineFocusManager::GetInstance().GetFocusedLayer() == Layer::kNone)
         {
-            hovered_idx = static_cast<int>(i);
+            hovered_idx = static_cast<int>(source_idx);
         }
     }
 
@@ -247,7 +289,7 @@ LineTrackItem::BoxPlotRender(float graph_width)
 
     if(hovered_idx != -1)
     {
-        auto&       hovered_item = m_data[hovered_idx];
+        auto&       hovered_item = (*source)[hovered_idx];
         const auto& time_format  = m_settings.GetUserSettings().unit_settings.time_format;
         std::string start_str    = nanosecond_to_formatted_str(
             hovered_item.m_start_ts - m_tpt->GetMinX(), time_format, true);
@@ -350,8 +392,9 @@ LineTrackItem::ReleaseData()
 {
     if(TrackItem::ReleaseData())
     {
-        m_data.clear();
-        m_data = {};
+        // A running decimation is cancelled by UpdateDecimation()
+        m_data.reset();
+        m_decimated.reset();
 
         return true;
     }
@@ -385,9 +428,131 @@ LineTrackItem::ExtractPointsFromData()
         spdlog::debug("No data for track {}", m_track_id);
         return;
     }
-    const std::vector<TraceCounter>& track_data = sample_track->GetData();
+    m_data = sample_track->GetSharedData();
+}
+
+void
+LineTrackItem::UpdateDecimation()
+{
+    if(m_decimation_job && m_decimation_job->done.load(std::memory_order_acquire))
+    {
+        if(m_decimation_job->result)
+        {
+            m_decimated = m_decimation_job->result;
+        }
+        m_decimation_job.reset();
+    }
+
+    // Below a few samples per column decimation cannot reduce anything
+    const double pixels_per_ns = m_tpt->GetPixelsPerNs();
+    if(!m_data || pixels_per_ns <= 0.0 ||
+       m_data->size() <= DECIMATION_POINTS_PER_COLUMN *
+                             static_cast<size_t>(std::max(0.0f, m_tpt->GetGraphSizeX())))
+    {
+        m_decimated.reset();
+        if(m_decimation_job)
+        {
+            m_decimation_job->cancelled.store(true);
+            m_decimation_job.reset();
+        }
+        return;
+    }
+    if(m_decimated && m_decimated->source == m_data &&
+       m_decimated->pixels_per_ns == pixels_per_ns)
+    {
+        return;
+    }
+    if(m_decimation_job && m_decimation_job->source == m_data &&
+       m_decimation_job->pixels_per_ns == pixels_per_ns)
+    {
+        return;
+    }
+    // A job for another zoom level or older samples is stale, cancel it and start
+    // over. Until the new one finishes the previous result is drawn.
+    if(m_decimation_job)
+    {
+        m_decimation_job->cancelled.store(true);
+    }
+    std::shared_ptr<DecimationJob> job = std::make_shared<DecimationJob>();
+    job->source                        = m_data;
+    job->pixels_per_ns                 = pixels_per_ns;
+    m_decimation_job                   = job;
+
+    double min_x = m_tpt->GetMinX();
+    m_data_provider.PostTrackTask([job, min_x]() {
+        if(!job->cancelled.load())
+        {
+            job->result = Decimate(job->source, min_x, job->pixels_per_ns, &job->cancelled);
+        }
+        job->done.store(true, std::memory_order_release);
+    });
+}
+
+std::shared_ptr<const LineTrackItem::DecimatedSamples>
+LineTrackItem::Decimate(std::shared_ptr<const std::vector<TraceCounter>> source,
+                        double min_x, double pixels_per_ns,
+                        const std::atomic<bool>* cancelled)
+{
+    std::shared_ptr<DecimatedSamples> result = std::make_shared<DecimatedSamples>();
+    result->source                           = source;
+    result->pixels_per_ns                    = pixels_per_ns;
+
+    const std::vector<TraceCounter>& samples = *source;
+    const size_t                     count   = samples.size();
+    auto column_of = [&](size_t i) {
+        return std::floor((samples[i].m_start_ts - min_x) * pixels_per_ns);
+    };
+
+    size_t begin = 0;
+    while(begin < count)
+    {
+        if(cancelled && cancelled->load(std::memory_order_relaxed))
+        {
+            return nullptr;
+        }
+        const double column  = column_of(begin);
+        size_t       end     = begin + 1;
+        size_t       min_idx = begin;
+        size_t       max_idx = begin;
+        while(end < count && column_of(end) == column)
+        {
+            if(samples[end].m_value < samples[min_idx].m_value)
+            {
+                min_idx = end;
+            }
+            if(samples[end].m_value > samples[max_idx].m_value)
+            {
+                max_idx = end;
+            }
+            end++;
+        }
+
+        std::array<size_t, DECIMATION_POINTS_PER_COLUMN> picks = { begin, min_idx, max_idx,
+                                                                   end - 1 };
+        std::sort(picks.begin(), picks.end());
+        auto picks_end = std::unique(picks.begin(), picks.end());
+        for(auto it = picks.begin(); it != picks_end; ++it)
+        {
+            TraceCounter point = samples[*it];
+            if(it + 1 != picks_end)
+            {
+                point.m_end_ts = samples[*(it + 1)].m_start_ts;
+            }
+            result->points.push_back(point);
+            result->source_indices.push_back(*it);
+        }
+        begin = end;
+    }
 
-    m_data = track_data;
+    if(result->points.size() == count)
+    {
+        result->passthrough = true;
+        result->points.clear();
+        result->points.shrink_to_fit();
+        result->source_indices.clear();
+        result->source_indices.shrink_to_fit();
+    }
+    return result;
 }
 
 float
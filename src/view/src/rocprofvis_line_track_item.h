@@ -8,6 +8,7 @@
 #include "rocprofvis_time_to_pixel.h"
 #include <memory>
 #include "widgets/rocprofvis_editable_textfield.h"
+#include <atomic>
 #include <string>
 #include <vector>
 
@@ -25,6 +26,7 @@ class TimelineTrackOptions;
 class LineTrackItem : public TrackItem
 {
     friend CounterTrackOptions;
+    friend struct LineTrackItemTestPeer;
 
     class VerticalLimits
     {
@@ -56,6 +58,31 @@ class LineTrackItem : public TrackItem
         EditableTextField m_text_field;
     };
 
+    // Samples reduced to the first, last, min and max sample of every pixel column
+    // at one zoom level. Points keep the timestamps of their source sample, a point
+    // followed by another point of the same column is stretched to reach it.
+    struct DecimatedSamples
+    {
+        std::shared_ptr<const std::vector<TraceCounter>> source;
+        double                                           pixels_per_ns = 0.0;
+        // Set when no column held more than one sample, the source is drawn as is
+        bool                                             passthrough = false;
+        std::vector<TraceCounter>                        points;
+        std::vector<size_t>                              source_indices;
+    };
+
+    // Decimation running on a track response worker. Shared with the task so the
+    // track never waits for it, a replaced or destroyed track only sets cancelled.
+    struct DecimationJob
+    {
+        std::shared_ptr<const std::vector<TraceCounter>> source;
+        double                                           pixels_per_ns = 0.0;
+        std::atomic<bool>                                cancelled{ false };
+        std::atomic<bool>                                done{ false };
+        // Written by the worker before done is set, null when cancelled
+        std::shared_ptr<const DecimatedSamples>          result;
+    };
+
 public:
     LineTrackItem(DataProvider& dp, uint64_t track_id,
                   TimelineTrackOptions&               track_options,
@@ -84,10 +111,21 @@ private:
     void   ExtractPointsFromData() override;
     float  CalculateMissingX(float x1, float y1, float x2, float y2, float known_y);
     void   BoxPlotRender(float graph_width);
+    // Collects a finished decimation and starts a new one when the zoom, the graph
+    // width or the samples changed. UI thread only.
+    void   UpdateDecimation();
+    // Runs on a worker thread, columns are aligned to the trace start so panning
+    // does not invalidate the result. Returns null once cancelled is set.
+    static std::shared_ptr<const DecimatedSamples> Decimate(
+        std::shared_ptr<const std::vector<TraceCounter>> source, double min_x,
+        double pixels_per_ns, const std::atomic<bool>* cancelled = nullptr);
     void   RenderHighlightBand(ImDrawList* draw_list, const ImVec2& cursor_position,
                                const ImVec2& content_size, double scale_y);
 
-    std::vector<TraceCounter> m_data;
+    // Snapshot of the raw track samples, shared with the data model
+    std::shared_ptr<const std::vector<TraceCounter>>     m_data;
+    std::shared_ptr<const DecimatedSamples>              m_decimated;
+    std::shared_ptr<DecimationJob>                       m_decimation_job;
 
     VerticalLimits m_min_y;
     VerticalLimits m_max_y;
@@ -4,8 +4,35 @@
 #include "rocprofvis_raw_track_data.h"
 #include "spdlog/spdlog.h"
 
+#include <algorithm>
+#include <cstring>
+
 using namespace RocProfVis::View;
 
+namespace
+{
+// Heap bytes of a string, zero when it fits the small string buffer
+size_t
+StringHeapBytes(const std::string& str)
+{
+    const char* data   = str.data();
+    const char* object = reinterpret_cast<const char*>(&str);
+    return (data >= object && data < object + sizeof(str)) ? 0 : str.capacity() + 1;
+}
+
+size_t
+EntryHeapBytes(const TraceEvent& event)
+{
+    return StringHeapBytes(event.m_name) + StringHeapBytes(event.m_top_combined_name);
+}
+
+size_t
+EntryHeapBytes(const TraceCounter&)
+{
+    return 0;
+}
+}  // namespace
+
 RawTrackData::RawTrackData(rocprofvis_controller_track_type_t track_type,
                            uint64_t track_id, double start_ts, double end_ts,
                            uint64_t data_group_id, size_t chunk_count)
@@ -69,18 +96,171 @@ RawTrackData::AllDataReady() const
     return m_chunk_info.size() == m_expected_chunk_count;
 }
 
+size_t
+RawTrackData::GetMemoryUsage() const
+{
+    // std::map nodes carry the key/value pair plus three pointers and a color
+    return sizeof(RawTrackData) +
+           m_chunk_info.size() * (sizeof(std::pair<const size_t, size_t>) + 4 * sizeof(void*));
+}
+
+template <typename K>
+TrackIdSet<K>::TrackIdSet()
+: m_size(0)
+, m_mask(0)
+{}
+
+template <typename K>
+uint64_t
+TrackIdSet<K>::Hash(K id)
+{
+    uint64_t bits = 0;
+    if constexpr(std::is_floating_point_v<K>)
+    {
+        // -0.0 and 0.0 compare equal and must land in the same slot
+        double value = (id == 0) ? 0.0 : static_cast<double>(id);
+        std::memcpy(&bits, &value, sizeof(bits));
+    }
+    else
+    {
+        bits = static_cast<uint64_t>(id);
+    }
+    // splitmix64 finalizer, ids are often sequential
+    bits ^= bits >> 30;
+    bits *= 0xbf58476d1ce4e5b9ULL;
+    bits ^= bits >> 27;
+    bits *= 0x94d049bb133111ebULL;
+    bits ^= bits >> 31;
+    return bits;
+}
+
+template <typename K>
+void
+TrackIdSet<K>::Rehash(size_t capacity)
+{
+    std::vector<K>       keys(capacity);
+    std::vector<uint8_t> used(capacity, 0);
+    size_t               mask = capacity - 1;
+    for(size_t i = 0; i < m_keys.size(); i++)
+    {
+        if(m_used[i])
+        {
+            size_t slot = Hash(m_keys[i]) & mask;
+            while(used[slot])
+            {
+                slot = (slot + 1) & mask;
+            }
+            keys[slot] = m_keys[i];
+            used[slot] = 1;
+        }
+    }
+    m_keys.swap(keys);
+    m_used.swap(used);
+    m_mask = mask;
+}
+
+template <typename K>
+void
+TrackIdSet<K>::Reserve(size_t additional)
+{
+    // Keep the load factor at or below one half
+    size_t required = (m_size + additional) * 2;
+    if(required <= m_keys.size())
+    {
+        return;
+    }
+    size_t capacity = std::max(m_keys.size(), MIN_CAPACITY);
+    while(capacity < required)
+    {
+        capacity *= 2;
+    }
+    Rehash(capacity);
+}
+
+template <typename K>
+bool
+TrackIdSet<K>::Insert(K id)
+{
+    Reserve(1);
+    size_t slot = Hash(id) & m_mask;
+    while(m_used[slot])
+    {
+        if(m_keys[slot] == id)
+        {
+            return false;
+        }
+        slot = (slot + 1) & m_mask;
+    }
+    m_keys[slot] = id;
+    m_used[slot] = 1;
+    m_size++;
+    return true;
+}
+
+template <typename K>
+bool
+TrackIdSet<K>::Contains(K id) const
+{
+    if(m_size == 0)
+    {
+        return false;
+    }
+    size_t slot = Hash(id) & m_mask;
+    while(m_used[slot])
+    {
+        if(m_keys[slot] == id)
+        {
+            return true;
+        }
+        slot = (slot + 1) & m_mask;
+    }
+    return false;
+}
+
+template <typename K>
+size_t
+TrackIdSet<K>::Size() const
+{
+    return m_size;
+}
+
+template <typename K>
+size_t
+TrackIdSet<K>::GetMemoryUsage() const
+{
+    return m_keys.capacity() * sizeof(K) + m_used.capacity();
+}
+
+template <typename K>
+void
+TrackIdSet<K>::Clear()
+{
+    m_keys.clear();
+    m_used.clear();
+    m_size = 0;
+    m_mask = 0;
+}
+
 template <typename T>
 TemplatedRawTrackData<T>::TemplatedRawTrackData(uint64_t track_id, double start_ts, double end_ts,
                                                  uint64_t data_group_id, size_t chunk_count)
 : RawTrackData(data_traits<T>::track_type, track_id, start_ts, end_ts, data_group_id, chunk_count)
+, m_data(std::make_shared<std::vector<T>>())
 {}
 
 template <typename T>
-TemplatedRawTrackData<T>::~TemplatedRawTrackData() { m_data.clear(); }
+TemplatedRawTrackData<T>::~TemplatedRawTrackData() { m_data.reset(); }
 
 template <typename T>
 const std::vector<T>&
 TemplatedRawTrackData<T>::GetData() const
+{
+    return *m_data;
+}
+
+template <typename T>
+std::shared_ptr<const std::vector<T>>
+TemplatedRawTrackData<T>::GetSharedData() const
 {
     return m_data;
 }
@@ -89,24 +269,43 @@ template <typename T>
 void
 TemplatedRawTrackData<T>::SetData(std::vector<T>&& data)
 {
-    m_data = std::move(data);
+    m_data = std::make_shared<std::vector<T>>(std::move(data));
 }
 
 template <typename T>
-std::unordered_set<typename TemplatedRawTrackData<T>::id_type>&
-TemplatedRawTrackData<T>::GetWritableIdSet()
+size_t
+TemplatedRawTrackData<T>::GetMemoryUsage() const
 {
-    return m_ids;
+    size_t size = RawTrackData::GetMemoryUsage() - sizeof(RawTrackData) + sizeof(*this) +
+                  m_ids.GetMemoryUsage() + m_data->capacity() * sizeof(T);
+    for(const T& entry : *m_data)
+    {
+        size += EntryHeapBytes(entry);
+    }
+    return size;
 }
 
 template <typename T>
-bool TemplatedRawTrackData<T>::AddChunk(size_t chunk_index, const std::vector<T> &&chunk_data) {
+bool TemplatedRawTrackData<T>::AddChunk(size_t chunk_index, std::vector<T> &&chunk_data) {
         // Prevent adding same chunk index
         if (m_chunk_info.count(chunk_index)) {
             spdlog::error("Chunk index {} already exists for track ID {}", chunk_index, GetTrackID());
             return false;
         }
 
+        // Drop entries already received, the whole chunk is inserted with one reserve
+        m_ids.Reserve(chunk_data.size());
+        size_t received = chunk_data.size();
+        chunk_data.erase(std::remove_if(chunk_data.begin(), chunk_data.end(),
+                                        [this](const T& entry) {
+                                            return !m_ids.Insert(data_traits<T>::GetId(entry));
+                                        }),
+                         chunk_data.end());
+        if (chunk_data.size() != received) {
+            spdlog::debug("Skipped {} duplicate entries in chunk {} of track ID {}",
+                          received - chunk_data.size(), chunk_index, GetTrackID());
+        }
+
         // Calculate the insertion position (offset)
         size_t insertion_offset = 0;
         for (const auto& pair : m_chunk_info) {
@@ -118,13 +317,26 @@ bool TemplatedRawTrackData<T>::AddChunk(size_t chunk_index, const std::vector<T>
             }
         }
 
-        // Insert the new chunk's data
+        // Insert the new chunk's data. A snapshot handed out by GetSharedData() is
+        // never modified, the merge then goes into a new vector instead
         if (!chunk_data.empty()) {
-            m_data.insert(
-                m_data.begin() + insertion_offset,
-                std::make_move_iterator(chunk_data.begin()),
-                std::make_move_iterator(chunk_data.end())
-            );
+            if (m_data.use_count() > 1) {
+                auto merged = std::make_shared<std::vector<T>>();
+                merged->reserve(m_data->size() + chunk_data.size());
+                merged->insert(merged->end(), m_data->begin(),
+                               m_data->begin() + insertion_offset);
+                merged->insert(merged->end(), std::make_move_iterator(chunk_data.begin()),
+                               std::make_move_iterator(chunk_data.end()));
+                merged->insert(merged->end(), m_data->begin() + insertion_offset,
+                               m_data->end());
+                m_data = std::move(merged);
+            } else {
+                m_data->insert(
+                    m_data->begin() + insertion_offset,
+                    std::make_move_iterator(chunk_data.begin()),
+                    std::make_move_iterator(chunk_data.end())
+                );
+            }
         }
 
         // Record the new chunk's size
@@ -134,5 +346,7 @@ bool TemplatedRawTrackData<T>::AddChunk(size_t chunk_index, const std::vector<T>
     }
 
 // Explicit template instantiation (must be after all template member definitions)
+template class RocProfVis::View::TrackIdSet<uint64_t>;
+template class RocProfVis::View::TrackIdSet<double>;
 template class RocProfVis::View::TemplatedRawTrackData<TraceCounter>;
 template class RocProfVis::View::TemplatedRawTrackData<TraceEvent>;
@@ -9,9 +9,9 @@
 
 #include <chrono>
 #include <map>
+#include <memory>
 #include <string>
 #include <type_traits>
-#include <unordered_set>
 #include <vector>
 
 namespace RocProfVis
@@ -50,6 +50,8 @@ public:
     uint64_t                           GetDataGroupID() const;
     size_t                             GetChunkCount() const;
     bool                               AllDataReady() const;
+    // Bytes held by the track data, including entry strings and the id set
+    virtual size_t                     GetMemoryUsage() const;
 
     void SetDataRequestTimePoint(
         const std::chrono::steady_clock::time_point& request_time);
@@ -78,6 +80,7 @@ struct data_traits<TraceEvent>
 {
     using id_type = uint64_t;
     static constexpr rocprofvis_controller_track_type_t track_type = kRPVControllerTrackTypeEvents;
+    static id_type GetId(const TraceEvent& event) { return event.m_id.uuid; }
 };
 
 template <>
@@ -85,6 +88,36 @@ struct data_traits<TraceCounter>
 {
     using id_type = double;
     static constexpr rocprofvis_controller_track_type_t track_type = kRPVControllerTrackTypeSamples;
+    static id_type GetId(const TraceCounter& counter) { return counter.m_start_ts; }
+};
+
+// Open addressing set of entry ids with linear probing over flat arrays.
+// Ids are only ever added while a track is loaded, so there is no erase.
+template <typename K>
+class TrackIdSet
+{
+public:
+    TrackIdSet();
+
+    // Grows the table so that additional ids can be inserted without rehashing
+    void Reserve(size_t additional);
+    // Returns false if the id is already present
+    bool   Insert(K id);
+    bool   Contains(K id) const;
+    size_t Size() const;
+    void   Clear();
+    size_t GetMemoryUsage() const;
+
+private:
+    static constexpr size_t MIN_CAPACITY = 64;
+
+    static uint64_t Hash(K id);
+    void            Rehash(size_t capacity);
+
+    std::vector<K>       m_keys;
+    std::vector<uint8_t> m_used;
+    size_t               m_size;
+    size_t               m_mask;
 };
 
 template <typename T>
@@ -98,15 +131,26 @@ public:
     virtual ~TemplatedRawTrackData();
 
     const std::vector<T>& GetData() const;
+    /*
+     * Returns the entries as a shared snapshot. The snapshot stays valid and
+     * unchanged while held, later chunks are merged into a fresh copy.
+     */
+    std::shared_ptr<const std::vector<T>> GetSharedData() const;
     void SetData(std::vector<T>&& data);
 
-    std::unordered_set<id_type>& GetWritableIdSet();
+    /*
+     * Adds a chunk of data, dropping entries whose id was already received with
+     * an earlier chunk or earlier in the same chunk. The chunk is filtered in place.
+     * @param chunk_index: Position of the chunk within the track
+     * @param chunk_data: Chunk entries, consumed by the call
+     */
+    bool AddChunk(size_t chunk_index, std::vector<T>&& chunk_data);
 
-    bool AddChunk(size_t chunk_index, const std::vector<T> &&chunk_data);
+    size_t GetMemoryUsage() const override;
 
 private:
-    std::vector<T> m_data;
-    std::unordered_set<id_type> m_ids;
+    std::shared_ptr<std::vector<T>> m_data;
+    TrackIdSet<id_type> m_ids;
 };
 
 using RawTrackSampleData = TemplatedRawTrackData<TraceCounter>;
@@ -7,6 +7,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "rocprofvis_controller_analysis.h"
@@ -46,12 +47,18 @@ enum class RequestType
     kFetchMetrics,
     kFetchMetricPivotTable,
     kFetchPcSampling,
+    kFetchFlowRange,
+    kLoadTracks,
+    kPrefetchTracks,
+    kFetchMemoryReport,
+    kPrefetchEventProperties,
 };
 
 enum class RequestState
 {
     kInit,
     kLoading,
+    kConverting,  // response received, converting to view data off the UI thread
     kReady,
     kError
 };
@@ -270,6 +277,44 @@ public:
     {}
 };
 
+// Flow range request parameters
+class FlowRangeRequestParams : public RequestParamsBase
+{
+public:
+    double                m_start_ts;   // start of the requested time range
+    double                m_end_ts;     // end of the requested time range
+    std::vector<uint64_t> m_track_ids;  // tracks to filter by, empty for all tracks
+
+    FlowRangeRequestParams(const FlowRangeRequestParams& other)            = default;
+    FlowRangeRequestParams& operator=(const FlowRangeRequestParams& other) = default;
+
+    FlowRangeRequestParams(double start_ts, double end_ts,
+                           const std::vector<uint64_t>& track_ids)
+    : m_start_ts(start_ts)
+    , m_end_ts(end_ts)
+    , m_track_ids(track_ids)
+    {}
+};
+
+// Track load and prefetch request parameters
+class TrackLoadRequestParams : public RequestParamsBase
+{
+public:
+    double                       m_start_ts;   // start of the loaded time range
+    double                       m_end_ts;     // end of the loaded time range
+    std::unordered_set<uint64_t> m_track_ids;  // tracks being loaded
+
+    TrackLoadRequestParams(const TrackLoadRequestParams& other)            = default;
+    TrackLoadRequestParams& operator=(const TrackLoadRequestParams& other) = default;
+
+    TrackLoadRequestParams(double start_ts, double end_ts,
+                           const std::vector<uint64_t>& track_ids)
+    : m_start_ts(start_ts)
+    , m_end_ts(end_ts)
+    , m_track_ids(track_ids.begin(), track_ids.end())
+    {}
+};
+
 class AnalysisTrackStatisticsRequestParams : public RequestParamsBase
 {
 public:
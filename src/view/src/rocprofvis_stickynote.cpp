@@ -805,7 +805,7 @@ StickyNote::HandleDrag(const ImVec2&                       window_position,
         new_y = std::clamp(new_y, min_y, std::max(min_y, max_y));
 
         m_time_ns = conversion_manager->PixelToTime(new_x);
-        // Re-anchor only on drop (track_at scans every graph); hold an absolute Y.
+        // Re-anchor only on drop; hold an absolute Y while dragging.
         m_drag_abs_y = new_y;
         m_v_max_x    = conversion_manager->GetVMaxX();
         m_v_min_x    = conversion_manager->GetVMinX();
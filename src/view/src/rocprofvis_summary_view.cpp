@@ -7,6 +7,7 @@
 #include "model/rocprofvis_common_defs.h"
 #include "rocprofvis_data_provider.h"
 #include "rocprofvis_settings_manager.h"
+#include "rocprofvis_timeline_selection.h"
 #include "rocprofvis_utils.h"
 #include "widgets/rocprofvis_gui_helpers.h"
 #include "widgets/rocprofvis_infinite_scroll_table.h"
@@ -53,6 +54,7 @@ SummaryView::SummaryView(DataProvider&                      dp,
                          std::shared_ptr<TimelineSelection> timeline_selection)
 : m_data_provider(dp)
 , m_settings(SettingsManager::GetInstance())
+, m_timeline_selection(timeline_selection)
 , m_h_container(nullptr)
 , m_v_container(nullptr)
 , m_kernel_instance_table(nullptr)
@@ -63,6 +65,9 @@ SummaryView::SummaryView(DataProvider&                      dp,
 , m_kernel_instance_table_item(nullptr)
 , m_open(SettingsManager::GetInstance().GetAppWindowSettings().show_summary)
 , m_fetched(false)
+, m_fetched_start_ts(0.0)
+, m_fetched_end_ts(0.0)
+, m_fetched_kernels_only(false)
 {
     m_kernel_instance_table =
         std::make_shared<KernelInstanceTable>(m_data_provider, timeline_selection);
@@ -106,12 +111,48 @@ SummaryView::Update()
         {
             m_top_kernels->Update();
         }
-        if(m_settings.GetAppWindowSettings().show_summary && !m_fetched &&
+        // Only one summary request is in flight, while the range is dragged the
+        // latest range is fetched as soon as the previous one has completed
+        if(m_settings.GetAppWindowSettings().show_summary &&
            !m_data_provider.IsRequestPending(DataProvider::SUMMARY_REQUEST_ID))
         {
-            m_fetched = m_data_provider.FetchSummary();
+            double start_ts = 0.0;
+            double end_ts   = 0.0;
+            bool   preview  = GetSummaryTimeRange(start_ts, end_ts);
+            // A dragged range refreshes only the top kernels, the full summary is
+            // fetched once the range is committed
+            if(!m_fetched || start_ts != m_fetched_start_ts ||
+               end_ts != m_fetched_end_ts || (m_fetched_kernels_only && !preview))
+            {
+                m_fetched = m_data_provider.FetchSummary(start_ts, end_ts, preview);
+                if(m_fetched)
+                {
+                    m_fetched_start_ts     = start_ts;
+                    m_fetched_end_ts       = end_ts;
+                    m_fetched_kernels_only = preview;
+                }
+            }
+        }
+    }
+}
+
+bool
+SummaryView::GetSummaryTimeRange(double& start_ts, double& end_ts) const
+{
+    if(m_timeline_selection)
+    {
+        if(m_timeline_selection->GetPreviewTimeRange(start_ts, end_ts))
+        {
+            return true;
+        }
+        if(m_timeline_selection->GetSelectedTimeRange(start_ts, end_ts))
+        {
+            return false;
         }
     }
+    start_ts = m_data_provider.DataModel().GetTimeline().GetStartTime();
+    end_ts   = m_data_provider.DataModel().GetTimeline().GetEndTime();
+    return false;
 }
 
 void
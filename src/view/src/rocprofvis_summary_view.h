@@ -31,8 +31,12 @@ public:
 
 private:
     friend struct SummaryViewTestPeer;
-    DataProvider&    m_data_provider;
-    SettingsManager& m_settings;
+    // Returns true if the range is a dragged preview
+    bool GetSummaryTimeRange(double& start_ts, double& end_ts) const;
+
+    DataProvider&                      m_data_provider;
+    SettingsManager&                   m_settings;
+    std::shared_ptr<TimelineSelection> m_timeline_selection;
 
     std::unique_ptr<HSplitContainer>     m_h_container;
     std::shared_ptr<VSplitContainer>     m_v_container;
@@ -44,8 +48,11 @@ private:
     LayoutItem::Ptr m_top_kernels_item;
     LayoutItem::Ptr m_kernel_instance_table_item;
 
-    bool m_open;
-    bool m_fetched;
+    bool   m_open;
+    bool   m_fetched;
+    double m_fetched_start_ts;
+    double m_fetched_end_ts;
+    bool   m_fetched_kernels_only;
 };
 
 class HWUtilization : public RocWidget
@@ -8,6 +8,8 @@
 #include "rocprofvis_track_item.h"
 #include "spdlog/spdlog.h"
 
+#include <algorithm>
+
 namespace RocProfVis
 {
 namespace View
@@ -41,9 +43,107 @@ TimelineArrow::SetRenderStyle(RenderStyle style)
     m_render_style = style;
 }
 
+namespace
+{
+
+void
+DrawFlowArrow(ImDrawList* draw_list, const ImVec2& p_from, const ImVec2& p_to,
+              ImU32 color, float thickness, float head_size)
+{
+    float  curve_offset = 0.25f * (p_to.x - p_from.x);
+    ImVec2 p_ctrl1      = ImVec2(p_from.x + curve_offset, p_from.y);
+    ImVec2 p_ctrl2      = ImVec2(p_to.x - curve_offset, p_to.y);
+
+    draw_list->AddBezierCubic(p_from, p_ctrl1, p_ctrl2, p_to, color, thickness,
+                              BEZIER_CURVE_SEGMENTS);
+
+    ImVec2 dir = ImVec2(p_to.x - p_ctrl2.x, p_to.y - p_ctrl2.y);
+    float  len = sqrtf(dir.x * dir.x + dir.y * dir.y);
+    if(len > 0.0f)
+    {
+        dir.x /= len;
+        dir.y /= len;
+    }
+    else
+    {
+        dir = ImVec2(p_to.x - p_from.x, p_to.y - p_from.y);
+        len = sqrtf(dir.x * dir.x + dir.y * dir.y);
+        if(len > 0.0f)
+        {
+            dir.x /= len;
+            dir.y /= len;
+        }
+        else
+        {
+            dir = ImVec2(1.0f, 0.0f);
+        }
+    }
+    ImVec2 ortho(-dir.y, dir.x);
+
+    ImVec2 p1 = p_to;
+    ImVec2 p2 = ImVec2(p_to.x - dir.x * head_size - ortho.x * head_size * 0.5f,
+                       p_to.y - dir.y * head_size - ortho.y * head_size * 0.5f);
+    ImVec2 p3 = ImVec2(p_to.x - dir.x * head_size + ortho.x * head_size * 0.5f,
+                       p_to.y - dir.y * head_size + ortho.y * head_size * 0.5f);
+    draw_list->AddTriangleFilled(p1, p2, p3, color);
+}
+
+}  // namespace
+
+bool
+TimelineArrow::GetFlowPoint(const EventFlowData& flow, uint64_t timestamp,
+                            const ImVec2                               window,
+                            const std::vector<float>&                  track_offsets_y,
+                            const std::shared_ptr<std::vector<TrackItem*>> tracks,
+                            std::shared_ptr<TimePixelTransform> tpt, ImVec2& point) const
+{
+    SettingsManager& settings   = SettingsManager::GetInstance();
+    TimelineModel&   tlm        = m_data_provider.DataModel().GetTimeline();
+    const TrackInfo* track_info = tlm.GetTrack(flow.track_id);
+    if(!track_info || track_info->index >= tracks->size() ||
+       track_info->index + 1 >= track_offsets_y.size() || !(*tracks)[track_info->index])
+    {
+        return false;
+    }
+    const TrackItem& track = *(*tracks)[track_info->index];
+    if(!track.IsDisplayed()) return false;
+
+    float level_height = track.IsCompactMode() ? settings.GetEventLevelCompactHeight()
+                                               : settings.GetEventLevelHeight();
+
+    float x = tpt->RawTimeToPixel(static_cast<double>(timestamp));
+    float y = track_offsets_y[track_info->index] +
+              std::min(level_height * flow.level + level_height / 2, track.GetTrackHeight());
+    point   = ImVec2(window.x + x, window.y + y);
+    return true;
+}
+
+void
+TimelineArrow::Update(double start_ts, double end_ts, std::vector<uint64_t>&& track_ids)
+{
+    if(m_flow_display_mode != FlowDisplayMode::kShowAll || start_ts >= end_ts ||
+       track_ids.empty())
+    {
+        return;
+    }
+
+    std::sort(track_ids.begin(), track_ids.end());
+    EventModel& events = m_data_provider.DataModel().GetEvents();
+    if(events.FlowRangeContains(start_ts, end_ts, track_ids) ||
+       m_data_provider.IsRequestPending(DataProvider::FLOW_RANGE_REQUEST_ID))
+    {
+        return;
+    }
+
+    // Over-fetch by one view width on each side so small pans reuse the result
+    double width = end_ts - start_ts;
+    m_data_provider.FetchFlowRange(std::max(0.0, start_ts - width), end_ts + width,
+                                   track_ids);
+}
+
 void
 TimelineArrow::Render(ImDrawList* draw_list, const ImVec2 window,
-                      const std::unordered_map<uint64_t, float>& track_position_y,
+                      const std::vector<float>&                  track_offsets_y,
                       const std::shared_ptr<std::vector<TrackItem*>> tracks,
                       std::shared_ptr<TimePixelTransform>                    tpt) const
 {
@@ -54,12 +154,33 @@ TimelineArrow::Render(ImDrawList* draw_list, const ImVec2 window,
         return;
     }
 
-    SettingsManager& settings     = SettingsManager::GetInstance();
-    ImU32            color        = settings.GetColor(Colors::kArrowColor);
-    float            thickness    = LINE_THICKNESS;
-    float            head_size    = ARROW_HEAD_SIZE;
-    float            level_height = settings.GetEventLevelHeight();
-    TimelineModel&   tlm          = m_data_provider.DataModel().GetTimeline();
+    SettingsManager& settings  = SettingsManager::GetInstance();
+    ImU32            color     = settings.GetColor(Colors::kArrowColor);
+    float            thickness = LINE_THICKNESS;
+    float            head_size = ARROW_HEAD_SIZE;
+
+    // Flow edges of the visible range
+    float view_min_x = window.x;
+    float view_max_x = window.x + ImGui::GetWindowWidth();
+    for(const FlowEdgeData& edge : m_data_provider.DataModel().GetEvents().GetFlowRangeEdges())
+    {
+        ImVec2 p_origin;
+        ImVec2 p_target;
+        if(!GetFlowPoint(edge.origin, edge.origin.end_timestamp, window, track_offsets_y,
+                         tracks, tpt, p_origin) ||
+           !GetFlowPoint(edge.target, edge.target.start_timestamp, window, track_offsets_y,
+                         tracks, tpt, p_target))
+        {
+            continue;
+        }
+        if(std::max(p_origin.x, p_target.x) < view_min_x ||
+           std::min(p_origin.x, p_target.x) > view_max_x)
+        {
+            continue;
+        }
+        if(p_origin.x == p_target.x && p_origin.y == p_target.y) continue;
+        DrawFlowArrow(draw_list, p_origin, p_target, color, thickness, head_size);
+    }
 
     for(const EventInfo* event : m_selected_event_data)
     {
@@ -71,92 +192,26 @@ TimelineArrow::Render(ImDrawList* draw_list, const ImVec2 window,
         {
             // True view: origin + multiple targets
             const EventFlowData& origin = flows[0];
-            const TrackInfo*      origin_track_info = tlm.GetTrack(origin.track_id);
-            if(!origin_track_info || !(*tracks)[origin_track_info->index]) continue;
-            const TrackItem& origin_track = *(*tracks)[origin_track_info->index];
-            if(!origin_track.IsDisplayed())
+            ImVec2               p_origin;
+            if(!GetFlowPoint(origin, origin.end_timestamp, window, track_offsets_y, tracks,
+                             tpt, p_origin))
             {
                 continue;
             }
-            if(origin_track.IsCompactMode())
-            {
-                level_height = settings.GetEventLevelCompactHeight();
-            }
-            else
-            {
-                level_height = settings.GetEventLevelHeight();
-            }
-
-            float origin_x = tpt->RawTimeToPixel(static_cast<double>(origin.end_timestamp));
-            float origin_y = track_position_y.at(origin.track_id) +
-                             std::min(level_height * origin.level + level_height / 2,
-                                      origin_track.GetTrackHeight());
-            ImVec2 p_origin = ImVec2(window.x + origin_x, window.y + origin_y);
 
             for(size_t i = 1; i < flows.size(); ++i)
             {
                 const EventFlowData& target = flows[i];
-                const TrackInfo*     target_track_info = tlm.GetTrack(target.track_id);
-                if(!target_track_info || !(*tracks)[target_track_info->index]) continue;
-                const TrackItem& target_track =
-                    *(*tracks)[target_track_info->index];
-                if(!target_track.IsDisplayed()) continue;
-
-                if(target_track.IsCompactMode())
+                ImVec2               p_target;
+                if(!GetFlowPoint(target, target.start_timestamp, window, track_offsets_y,
+                                 tracks, tpt, p_target))
                 {
-                    level_height = settings.GetEventLevelCompactHeight();
+                    continue;
                 }
-                else
-                {
-                    level_height = settings.GetEventLevelHeight();
-                }
-
-                float target_x = tpt->RawTimeToPixel(static_cast<double>(target.start_timestamp));
-                float target_y = track_position_y.at(target.track_id) +
-                                 std::min(level_height * target.level + level_height / 2,
-                                          target_track.GetTrackHeight());
-                ImVec2 p_target = ImVec2(window.x + target_x, window.y + target_y);
 
                 if(p_origin.x == p_target.x && p_origin.y == p_target.y) continue;
 
-                float  curve_offset = 0.25f * (p_target.x - p_origin.x);
-                ImVec2 p_ctrl1      = ImVec2(p_origin.x + curve_offset, p_origin.y);
-                ImVec2 p_ctrl2      = ImVec2(p_target.x - curve_offset, p_target.y);
-
-                draw_list->AddBezierCubic(p_origin, p_ctrl1, p_ctrl2, p_target, color,
-                                          thickness, BEZIER_CURVE_SEGMENTS);
-
-                ImVec2 dir = ImVec2(p_target.x - p_ctrl2.x, p_target.y - p_ctrl2.y);
-                float  len = sqrtf(dir.x * dir.x + dir.y * dir.y);
-                if(len > 0.0f)
-                {
-                    dir.x /= len;
-                    dir.y /= len;
-                }
-                else
-                {
-                    dir = ImVec2(p_target.x - p_origin.x, p_target.y - p_origin.y);
-                    len = sqrtf(dir.x * dir.x + dir.y * dir.y);
-                    if(len > 0.0f)
-                    {
-                        dir.x /= len;
-                        dir.y /= len;
-                    }
-                    else
-                    {
-                        dir = ImVec2(1.0f, 0.0f);
-                    }
-                }
-                ImVec2 ortho(-dir.y, dir.x);
-
-                ImVec2 p1 = p_target;
-                ImVec2 p2 =
-                    ImVec2(p_target.x - dir.x * head_size - ortho.x * head_size * 0.5f,
-                           p_target.y - dir.y * head_size - ortho.y * head_size * 0.5f);
-                ImVec2 p3 =
-                    ImVec2(p_target.x - dir.x * head_size + ortho.x * head_size * 0.5f,
-                           p_target.y - dir.y * head_size + ortho.y * head_size * 0.5f);
-                draw_list->AddTriangleFilled(p1, p2, p3, color);
+                DrawFlowArrow(draw_list, p_origin, p_target, color, thickness, head_size);
             }
         }
         else
@@ -167,85 +222,19 @@ TimelineArrow::Render(ImDrawList* draw_list, const ImVec2 window,
                 const EventFlowData& from = flows[i];
                 const EventFlowData& to   = flows[i + 1];
 
-                const TrackInfo* from_track_info = tlm.GetTrack(from.track_id);
-                const TrackInfo* to_track_info   = tlm.GetTrack(to.track_id);
-                if(!from_track_info || !(*tracks)[from_track_info->index] || !to_track_info || !(*tracks)[to_track_info->index]) continue;
-
-                const TrackItem& from_track = *(*tracks)[from_track_info->index];
-                const TrackItem& to_track   = *(*tracks)[to_track_info->index];
-
-                if(!from_track.IsDisplayed() || !to_track.IsDisplayed()) continue;
-
-                if(from_track.IsCompactMode())
-                {
-                    level_height = settings.GetEventLevelCompactHeight();
-                }
-                else
+                ImVec2 p_from;
+                ImVec2 p_to;
+                if(!GetFlowPoint(from, from.end_timestamp, window, track_offsets_y, tracks,
+                                 tpt, p_from) ||
+                   !GetFlowPoint(to, to.start_timestamp, window, track_offsets_y, tracks,
+                                 tpt, p_to))
                 {
-                    level_height = settings.GetEventLevelHeight();
+                    continue;
                 }
 
-                float from_x = tpt->RawTimeToPixel(static_cast<double>(from.end_timestamp));
-                float from_y = track_position_y.at(from.track_id) +
-                               std::min(level_height * from.level + level_height / 2,
-                                        from_track.GetTrackHeight());
-                ImVec2 p_from = ImVec2(window.x + from_x, window.y + from_y);
-
-                if(to_track.IsCompactMode())
-                {
-                    level_height = settings.GetEventLevelCompactHeight();
-                }
-                else
-                {
-                    level_height = settings.GetEventLevelHeight();
-                }
-
-                float to_x = tpt->RawTimeToPixel(static_cast<double>(to.start_timestamp));
-                float to_y = track_position_y.at(to.track_id) +
-                             std::min(level_height * to.level + level_height / 2,
-                                      to_track.GetTrackHeight());
-                ImVec2 p_to = ImVec2(window.x + to_x, window.y + to_y);
-
                 if(p_from.x == p_to.x && p_from.y == p_to.y) continue;
 
-                float  curve_offset = 0.25f * (p_to.x - p_from.x);
-                ImVec2 p_ctrl1      = ImVec2(p_from.x + curve_offset, p_from.y);
-                ImVec2 p_ctrl2      = ImVec2(p_to.x - curve_offset, p_to.y);
-
-                draw_list->AddBezierCubic(p_from, p_ctrl1, p_ctrl2, p_to, color,
-                                          thickness, BEZIER_CURVE_SEGMENTS);
-
-                ImVec2 dir = ImVec2(p_to.x - p_ctrl2.x, p_to.y - p_ctrl2.y);
-                float  len = sqrtf(dir.x * dir.x + dir.y * dir.y);
-                if(len > 0.0f)
-                {
-                    dir.x /= len;
-                    dir.y /= len;
-                }
-                else
-                {
-                    dir = ImVec2(p_to.x - p_from.x, p_to.y - p_from.y);
-                    len = sqrtf(dir.x * dir.x + dir.y * dir.y);
-                    if(len > 0.0f)
-                    {
-                        dir.x /= len;
-                        dir.y /= len;
-                    }
-                    else
-                    {
-                        dir = ImVec2(1.0f, 0.0f);
-                    }
-                }
-                ImVec2 ortho(-dir.y, dir.x);
-
-                ImVec2 p1 = p_to;
-                ImVec2 p2 =
-                    ImVec2(p_to.x - dir.x * head_size - ortho.x * head_size * 0.5f,
-                           p_to.y - dir.y * head_size - ortho.y * head_size * 0.5f);
-                ImVec2 p3 =
-                    ImVec2(p_to.x - dir.x * head_size + ortho.x * head_size * 0.5f,
-                           p_to.y - dir.y * head_size + ortho.y * head_size * 0.5f);
-                draw_list->AddTriangleFilled(p1, p2, p3, color);
+                DrawFlowArrow(draw_list, p_from, p_to, color, thickness, head_size);
             }
         }
     }
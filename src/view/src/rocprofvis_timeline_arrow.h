@@ -8,6 +8,7 @@
 #include "rocprofvis_event_manager.h"
 
 #include <memory>
+#include <vector>
 
 namespace RocProfVis
 {
@@ -45,11 +46,18 @@ public:
     // Draws an arrow from (start_time, y_start) to (end_time, y_end) using the given
     // mapping
     void Render(ImDrawList* draw_list, const ImVec2 window,
-                const std::unordered_map<uint64_t, float>&             track_position_y,
+                const std::vector<float>&                              track_offsets_y,
                 const std::shared_ptr<std::vector<TrackItem*>>         tracks,
                 std::shared_ptr<TimePixelTransform>                    tpt) const;
+    // Requests the flow edges of the given tracks around the visible time range
+    // when they are not covered by the last fetched range
+    void Update(double start_ts, double end_ts, std::vector<uint64_t>&& track_ids);
 
 private:
+    bool GetFlowPoint(const EventFlowData& flow, uint64_t timestamp, const ImVec2 window,
+                      const std::vector<float>&                      track_offsets_y,
+                      const std::shared_ptr<std::vector<TrackItem*>> tracks,
+                      std::shared_ptr<TimePixelTransform> tpt, ImVec2& point) const;
     void HandleEventSelectionChanged(std::shared_ptr<RocEvent> e);
 
     DataProvider&                      m_data_provider;
@@ -18,6 +18,8 @@ namespace View
 TimelineSelection::TimelineSelection(DataProvider& dp)
 : m_selected_range_start(INVALID_SELECTION_TIME)
 , m_selected_range_end(INVALID_SELECTION_TIME)
+, m_preview_range_start(INVALID_SELECTION_TIME)
+, m_preview_range_end(INVALID_SELECTION_TIME)
 , m_data_provider(dp)
 , m_last_highlighted_event_id(INVALID_SELECTION_ID)
 {}
@@ -92,6 +94,8 @@ TimelineSelection::IsTrackSelected(TrackItem& track) const
 void
 TimelineSelection::SelectTimeRange(double start_ts, double end_ts)
 {
+    m_preview_range_start = INVALID_SELECTION_TIME;
+    m_preview_range_end   = INVALID_SELECTION_TIME;
     if(start_ts != m_selected_range_start || end_ts != m_selected_range_end)
     {
         m_selected_range_start = start_ts;
@@ -116,6 +120,8 @@ TimelineSelection::GetSelectedTimeRange(double& start_ts_out, double& end_ts_out
 void
 TimelineSelection::ClearTimeRange()
 {
+    m_preview_range_start  = TimelineSelection::INVALID_SELECTION_TIME;
+    m_preview_range_end    = TimelineSelection::INVALID_SELECTION_TIME;
     m_selected_range_start = TimelineSelection::INVALID_SELECTION_TIME;
     m_selected_range_end   = TimelineSelection::INVALID_SELECTION_TIME;
     SendTimeRangeChanged(m_selected_range_start, m_selected_range_end);
@@ -128,6 +134,27 @@ TimelineSelection::HasValidTimeRangeSelection() const
            m_selected_range_end != TimelineSelection::INVALID_SELECTION_TIME;
 }
 
+void
+TimelineSelection::PreviewTimeRange(double start_ts, double end_ts)
+{
+    m_preview_range_start = start_ts;
+    m_preview_range_end   = end_ts;
+}
+
+bool
+TimelineSelection::GetPreviewTimeRange(double& start_ts_out, double& end_ts_out) const
+{
+    if(m_preview_range_start == TimelineSelection::INVALID_SELECTION_TIME ||
+       m_preview_range_end == TimelineSelection::INVALID_SELECTION_TIME)
+    {
+        return false;
+    }
+
+    start_ts_out = m_preview_range_start;
+    end_ts_out   = m_preview_range_end;
+    return true;
+}
+
 void
 TimelineSelection::SelectTrackEvent(uint64_t track_id, uint64_t event_id)
 {
@@ -51,6 +51,13 @@ public:
     void ClearTimeRange();
     bool HasValidTimeRangeSelection() const;
 
+    /*
+     * Range being dragged but not yet committed. Not broadcast, consumers that can
+     * refresh cheaply poll it to follow the drag.
+     */
+    void PreviewTimeRange(double start_ts, double end_ts);
+    bool GetPreviewTimeRange(double& start_ts_out, double& end_ts_out) const;
+
     void SelectTrackEvent(uint64_t track_id, uint64_t event_id);
     void UnselectTrackEvent(uint64_t track_id, uint64_t event_id);
     bool GetSelectedEvents(std::vector<uint64_t>& event_ids) const;
@@ -94,6 +101,8 @@ private:
     std::unordered_set<uint64_t> m_selected_track_ids;
     double                       m_selected_range_start;
     double                       m_selected_range_end;
+    double                       m_preview_range_start;
+    double                       m_preview_range_end;
 
     std::unordered_set<uint64_t>              m_selected_event_ids;
     std::unordered_map<uint64_t, HighlightInfo> m_highlighted_events;
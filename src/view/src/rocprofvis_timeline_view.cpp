@@ -21,6 +21,7 @@
 #include "widgets/rocprofvis_notification_manager.h"
 #include "widgets/rocprofvis_gui_helpers.h"
 #include <algorithm>
+#include <limits>
 #include <sstream>
 #include <unordered_set>
 
@@ -106,6 +107,8 @@ TimelineView::TimelineView(DataProvider&                          dp,
 , m_last_zoom(1.0f)
 , m_last_graph_size(0.0f, 0.0f)
 , m_reorder_request({ true, 0, 0 })
+, m_track_layout_dirty(true)
+, m_track_height_change_count(0)
 , m_track_height_sum(0.0f)
 , m_hidden_track_count(0)
 , m_arrow_layer(m_data_provider, timeline_selection)
@@ -226,7 +229,8 @@ TimelineView::TimelineView(DataProvider&                          dp,
             {
                 m_data_provider.DataModel().GetTimeline().UpdateHistogram(
                     *m_tracks.get());
-                m_resize_activity = true;
+                m_resize_activity    = true;
+                m_track_layout_dirty = true;
             }
         });
 
@@ -262,7 +266,7 @@ TimelineView::RenderInteractiveUI()
     ImDrawList* draw_list       = ImGui::GetWindowDrawList();
     ImVec2      window_position = ImGui::GetWindowPos();
 
-    m_arrow_layer.Render(draw_list, window_position, m_track_position_y, m_tracks, m_tpt);
+    m_arrow_layer.Render(draw_list, window_position, m_track_offsets_y, m_tracks, m_tpt);
 
     RenderMeasurement(draw_list, window_position);
 
@@ -279,83 +283,206 @@ TimelineView::BuildTrackLayout()
     TrackLayout layout;
 
     layout.top_of = [this](uint64_t track_id, float& out_top_y) -> bool {
-        auto it = m_track_position_y.find(track_id);
-        if(it == m_track_position_y.end()) return false;
-        out_top_y = it->second;
+        return GetTrackTopY(track_id, out_top_y);
+    };
+
+    layout.height_of = [this](uint64_t track_id, float& out_height) -> bool {
+        const TrackInfo* metadata =
+            m_data_provider.DataModel().GetTimeline().GetTrack(track_id);
+        if(!metadata || !m_tracks || metadata->index >= m_tracks->size()) return false;
+        const TrackItem* track = (*m_tracks)[metadata->index];
+        if(!track) return false;
+        out_height = track->GetTrackHeight();
         return true;
     };
 
-    // Snapshot heights once so per-note lookups are O(1), not a per-note rescan.
-    std::unordered_map<uint64_t, float> track_heights;
-    if(m_tracks)
-    {
-        for(TrackItem* track : *m_tracks)
+    layout.track_at = [this](float abs_y, uint64_t& out_track_id,
+                             float& out_top_y) -> bool {
+        if(!m_tracks || m_track_offsets_y.size() != m_tracks->size() + 1) return false;
+        const float total_height = m_track_offsets_y.back();
+        if(total_height <= 0.0f) return false;
+
+        // Search the track bottoms: the first bottom past abs_y belongs to the hit
+        // track, hidden tracks have no height and are never hit. Outside all tracks
+        // clamp to the nearest end so the note stays anchored while keeping the
+        // user's vertical offset.
+        auto   bottoms = m_track_offsets_y.begin() + 1;
+        size_t index   = 0;
+        if(abs_y >= total_height)
         {
-            if(track)
-            {
-                track_heights[track->GetID()] = track->GetTrackHeight();
-            }
+            index = std::lower_bound(bottoms, m_track_offsets_y.end(), total_height) -
+                    bottoms;
         }
-    }
-    layout.height_of = [heights = std::move(track_heights)](
-                           uint64_t track_id, float& out_height) -> bool {
-        auto it = heights.find(track_id);
-        if(it == heights.end()) return false;
-        out_height = it->second;
+        else
+        {
+            index = std::upper_bound(bottoms, m_track_offsets_y.end(),
+                                     std::max(abs_y, 0.0f)) -
+                    bottoms;
+        }
+        // Tracks of unsupported types have no item, take the nearest one above
+        while(index > 0 && !(*m_tracks)[index])
+        {
+            index--;
+        }
+        if(!(*m_tracks)[index]) return false;
+        out_track_id = (*m_tracks)[index]->GetID();
+        out_top_y    = m_track_offsets_y[index];
         return true;
     };
 
-    layout.track_at = [this](float abs_y, uint64_t& out_track_id,
-                             float& out_top_y) -> bool {
-        if(!m_tracks || m_tracks->empty()) return false;
+    // Visible track viewport in content-space Y, used to keep a dragged anchor
+    // on-screen (see StickyNote::HandleDrag).
+    layout.view_min_y = m_scroll_position_y;
+    layout.view_max_y = m_scroll_position_y + GetTrackViewportHeight();
 
-        bool     have_first = false;
-        uint64_t first_id   = 0;
-        float    first_top  = 0.0f;
-        uint64_t last_id    = 0;
-        float    last_top   = 0.0f;
+    return layout;
+}
 
-        for(TrackItem* track : *m_tracks)
-        {
-            if(!track || !track->IsDisplayed()) continue;
-            const uint64_t track_id = track->GetID();
-            auto           pos      = m_track_position_y.find(track_id);
-            if(pos == m_track_position_y.end()) continue;
-            const float top    = pos->second;
-            const float height = track->GetTrackHeight();
+void
+TimelineView::RebuildTrackOffsets()
+{
+    const size_t count = m_tracks ? m_tracks->size() : 0;
+    m_track_offsets_y.resize(count + 1);
+    m_displayed_track_prefix.resize(count + 1);
+
+    float    track_y   = 0.0f;
+    uint32_t displayed = 0;
+    m_hidden_track_count = 0;
+    for(size_t i = 0; i < count; i++)
+    {
+        m_track_offsets_y[i]        = track_y;
+        m_displayed_track_prefix[i] = displayed;
 
-            if(!have_first)
+        TrackItem* track = (*m_tracks)[i];
+        if(track)
+        {
+            // Pending height changes are covered by this rebuild
+            track->TrackHeightChanged();
+            if(track->IsDisplayed())
             {
-                have_first = true;
-                first_id   = track_id;
-                first_top  = top;
+                track_y += track->GetTrackHeight();
+                displayed++;
             }
-            last_id  = track_id;
-            last_top = top;
-
-            if(abs_y >= top && abs_y < top + height)
+            else
             {
-                out_track_id = track_id;
-                out_top_y    = top;
-                return true;
+                m_hidden_track_count++;
             }
         }
+    }
+    m_track_offsets_y[count]        = track_y;
+    m_displayed_track_prefix[count] = displayed;
 
-        if(!have_first) return false;
+    m_track_height_sum          = track_y;
+    m_track_height_change_count = TrackItem::GetHeightChangeCount();
+    m_track_layout_dirty        = false;
+}
 
-        // Outside all tracks: clamp to the nearest end so the note stays
-        // anchored while keeping the user's vertical offset.
-        out_track_id = (abs_y < first_top) ? first_id : last_id;
-        out_top_y    = (abs_y < first_top) ? first_top : last_top;
-        return true;
-    };
+void
+TimelineView::ApplyTrackHeightChanges()
+{
+    if(!m_tracks || m_track_offsets_y.size() != m_tracks->size() + 1)
+    {
+        RebuildTrackOffsets();
+        return;
+    }
 
-    // Visible track viewport in content-space Y, used to keep a dragged anchor
-    // on-screen (see StickyNote::HandleDrag).
-    layout.view_min_y = m_scroll_position_y;
-    layout.view_max_y = m_scroll_position_y + GetTrackViewportHeight();
+    // Offsets above the topmost resized track of this view stay as they are
+    size_t first = m_tracks->size();
+    for(TrackItem* track : TrackItem::GetHeightChangedTracks())
+    {
+        const TrackInfo* metadata = track->GetTrackInfo();
+        if(metadata && metadata->index < first && (*m_tracks)[metadata->index] == track)
+        {
+            first = metadata->index;
+        }
+    }
 
-    return layout;
+    // Every track below a resized one moves by the accumulated height difference
+    float shift = 0.0f;
+    for(size_t i = first; i < m_tracks->size(); i++)
+    {
+        m_track_offsets_y[i] += shift;
+
+        TrackItem* track = (*m_tracks)[i];
+        if(track && track->TrackHeightChanged() && track->IsDisplayed())
+        {
+            // The next offset is not shifted yet
+            float previous_height = m_track_offsets_y[i + 1] + shift - m_track_offsets_y[i];
+            shift += track->GetTrackHeight() - previous_height;
+        }
+    }
+    m_track_offsets_y.back() += shift;
+
+    m_track_height_sum          = m_track_offsets_y.back();
+    m_track_height_change_count = TrackItem::GetHeightChangeCount();
+}
+
+bool
+TimelineView::GetTrackTopY(uint64_t track_id, float& out_top_y) const
+{
+    const TrackInfo* metadata = m_data_provider.DataModel().GetTimeline().GetTrack(track_id);
+    if(!metadata || metadata->index + 1 >= m_track_offsets_y.size())
+    {
+        return false;
+    }
+    out_top_y = m_track_offsets_y[metadata->index];
+    return true;
+}
+
+void
+TimelineView::GetTrackRange(float top, float bottom, size_t& first, size_t& last) const
+{
+    first = 0;
+    last  = 0;
+    if(m_track_offsets_y.size() < 2)
+    {
+        return;
+    }
+
+    // First track whose bottom reaches top, then the first track starting past bottom
+    auto bottoms = m_track_offsets_y.begin() + 1;
+    first        = std::lower_bound(bottoms, m_track_offsets_y.end(), top) - bottoms;
+    last         = std::upper_bound(m_track_offsets_y.begin() + first,
+                                    m_track_offsets_y.end() - 1, bottom) -
+           m_track_offsets_y.begin();
+}
+
+void
+TimelineView::ReleaseTracksOutsideBand()
+{
+    for(TrackItem* track : m_previous_band_tracks)
+    {
+        if(std::binary_search(m_band_tracks.begin(), m_band_tracks.end(), track))
+        {
+            continue;
+        }
+        // Left the band: past the unload distance, free its data to save memory
+        track->SetInViewVertical(false);
+        track->SetDistanceToView(std::numeric_limits<float>::max());
+        if(track->HasData() || track->HasPendingRequests())
+        {
+            track->ReleaseData();
+            m_released_tracks.push_back(track);
+        }
+    }
+
+    // Cancellation is best effort, responses that still land recreate the data.
+    // Keep releasing until nothing is in flight or the track is back in the band.
+    m_released_tracks.erase(
+        std::remove_if(m_released_tracks.begin(), m_released_tracks.end(),
+                       [this](TrackItem* track) {
+                           if(std::binary_search(m_band_tracks.begin(),
+                                                 m_band_tracks.end(), track))
+                           {
+                               return true;
+                           }
+                           if(track->HasData() || track->HasPendingRequests())
+                           {
+                               track->ReleaseData();
+                           }
+                           return !track->HasData() && !track->HasPendingRequests();
+                       }),
+        m_released_tracks.end());
 }
 
 bool
@@ -364,13 +491,11 @@ TimelineView::IsAnnotationTrackVisible(uint64_t track_id) const
     // Notes that aren't bound to a track (legacy / free-floating) always show.
     if(track_id == INVALID_TRACK_ID || !m_tracks) return true;
 
-    for(TrackItem* track : *m_tracks)
+    const TrackInfo* metadata = m_data_provider.DataModel().GetTimeline().GetTrack(track_id);
+    if(metadata && metadata->index < m_tracks->size() && (*m_tracks)[metadata->index])
     {
-        if(track && track->GetID() == track_id)
-        {
-            // A note follows its track's eye-toggle: hidden track, hidden note.
-            return track->IsDisplayed();
-        }
+        // A note follows its track's eye-toggle: hidden track, hidden note.
+        return (*m_tracks)[metadata->index]->IsDisplayed();
     }
 
     // Bound track is no longer present in the current view; keep the note so it
@@ -619,9 +744,9 @@ TimelineView::RenderMeasurement(ImDrawList* draw_list, ImVec2 window_position)
     // Resolves Y position for a measurement point
     auto point_y = [&](const MeasurementPoint& pt) -> float {
         if(pt.freehand) return visible_center_y;
-        auto it = m_track_position_y.find(pt.track_id);
-        if(it != m_track_position_y.end())
-            return it->second + level_height * pt.level + level_height * 0.5f;
+        float track_top_y = 0.0f;
+        if(GetTrackTopY(pt.track_id, track_top_y))
+            return track_top_y + level_height * pt.level + level_height * 0.5f;
         return visible_center_y;
     };
 
@@ -894,9 +1019,9 @@ TimelineView::RenderTimelineViewOptionsMenu(ImVec2 window_position)
 void
 TimelineView::ScrollToTrack(const uint64_t& track_id)
 {
-    if(m_track_position_y.count(track_id) > 0)
+    float track_y = 0.0f;
+    if(GetTrackTopY(track_id, track_y))
     {
-        float track_y = m_track_position_y[track_id];
         m_scroll_position_y =
             std::clamp(track_y - m_tpt->GetGraphSizeY() * 0.5f, 0.0f,
                        m_content_max_y_scroll);
@@ -1146,69 +1271,76 @@ TimelineView::HandleNewTrackData(std::shared_ptr<RocEvent> e)
         return;
     }
 
-    std::shared_ptr<TrackDataEvent> tde = std::dynamic_pointer_cast<TrackDataEvent>(e);
-    if(!tde)
+    std::shared_ptr<TrackDataBatchEvent> batch =
+        std::dynamic_pointer_cast<TrackDataBatchEvent>(e);
+    if(!batch)
     {
         spdlog::debug("Invalid event type {}, cannot process new track data",
                       static_cast<int>(e->GetType()));
+        return;
     }
-    else
+
+    const std::string& trace_path = batch->GetSourceId();
+    // check if event trace path matches the current our data provider's trace path
+    // since events are global for all views
+    if(m_data_provider.GetTraceFilePath() != trace_path)
     {
-        const std::string& trace_path = tde->GetSourceId();
-        // check if event trace path matches the current our data provider's trace path
-        // since events are global for all views
-        if(m_data_provider.GetTraceFilePath() != trace_path)
-        {
-            spdlog::debug("Trace path {} does not match current trace path {}",
-                          trace_path, m_data_provider.GetTraceFilePath());
-            return;
-        }
+        spdlog::debug("Trace path {} does not match current trace path {}", trace_path,
+                      m_data_provider.GetTraceFilePath());
+        return;
+    }
 
-        const TrackInfo* metadata =
-            m_data_provider.DataModel().GetTimeline().GetTrack(tde->GetTrackID());
-        if(!metadata)
-        {
-            spdlog::warn(
-                "No metadata found for track id {}, cannot process new track data",
-                tde->GetTrackID());
-            
-            // try to find request by request id on all tracks so that it can
-            // be cleared from pending queue
-            for(size_t i = 0; i < m_tracks->size(); ++i)
-            {
-                TrackItem *track = (*m_tracks)[i];
-                if(track && track->HasPendingRequest(tde->GetRequestID()))
-                {
-                    track->HandleTrackDataChanged(tde->GetRequestID(),
-                                                  tde->GetResponseCode());
-                    break;
-                }
-            }
-            return;
-        }
+    for(const TrackDataNotice& notice : batch->GetNotices())
+    {
+        HandleTrackDataNotice(notice);
+    }
+}
+
+void
+TimelineView::HandleTrackDataNotice(const TrackDataNotice& notice)
+{
+    const TrackInfo* metadata =
+        m_data_provider.DataModel().GetTimeline().GetTrack(notice.track_id);
+    if(!metadata)
+    {
+        spdlog::warn("No metadata found for track id {}, cannot process new track data",
+                     notice.track_id);
 
-        uint64_t track_index = metadata->index;
-        if(track_index < m_tracks->size())
+        // try to find request by request id on all tracks so that it can
+        // be cleared from pending queue
+        for(size_t i = 0; i < m_tracks->size(); ++i)
         {
-            if((*m_tracks)[track_index])
+            TrackItem* track = (*m_tracks)[i];
+            if(track && track->HasPendingRequest(notice.request_id))
             {
-                (*m_tracks)[track_index]->HandleTrackDataChanged(
-                    tde->GetRequestID(), tde->GetResponseCode());
-            }
-            else
-            {
-                spdlog::error("Chart object for track index {} is null. Cannot handle "
-                              "track data changed.",
-                              track_index);
+                track->HandleTrackDataChanged(notice.request_id, notice.response_code);
+                break;
             }
         }
+        return;
+    }
+
+    uint64_t track_index = metadata->index;
+    if(track_index < m_tracks->size())
+    {
+        if((*m_tracks)[track_index])
+        {
+            (*m_tracks)[track_index]->HandleTrackDataChanged(notice.request_id,
+                                                             notice.response_code);
+        }
         else
         {
-            spdlog::warn("Track index {} not found in graph_map. Cannot handle track "
-                         "data changed.",
-                         track_index);
+            spdlog::error("Chart object for track index {} is null. Cannot handle "
+                          "track data changed.",
+                          track_index);
         }
     }
+    else
+    {
+        spdlog::warn("Track index {} not found in graph_map. Cannot handle track "
+                     "data changed.",
+                     track_index);
+    }
 }
 
 void
@@ -1262,25 +1394,14 @@ TimelineView::Update()
                 }
             }
         }
-        // Rebuild the positioning map.
-        if(m_resize_activity || !m_reorder_request.handled)
+        // Rebuild the track offsets, or only shift them when tracks were resized.
+        if(m_track_layout_dirty || !m_reorder_request.handled)
         {
-            m_track_position_y.clear();
-            m_track_height_sum   = 0;
-            m_hidden_track_count = 0;
-            for(int i = 0; i < m_tracks->size(); i++)
-            {
-                if((*m_tracks)[i])
-                {
-                    const bool displayed = (*m_tracks)[i]->IsDisplayed();
-                    m_track_position_y[(*m_tracks)[i]->GetID()] = m_track_height_sum;
-                    m_track_height_sum +=
-                        displayed ? (*m_tracks)[i]
-                                        ->GetTrackHeight()  // Get the height of the track.
-                                  : 0;
-                    m_hidden_track_count += displayed ? 0 : 1;
-                }
-            }
+            RebuildTrackOffsets();
+        }
+        else if(m_track_height_change_count != TrackItem::GetHeightChangeCount())
+        {
+            ApplyTrackHeightChanges();
         }
         m_reorder_request.handled = true;
         m_resize_activity         = false;
@@ -1288,13 +1409,19 @@ TimelineView::Update()
         {
             m_track_options_context_menu->Update();
         }
-        for(TrackItem* track : *m_tracks)
+        // Tracks outside the loading band have nothing to request or display.
+        std::vector<uint64_t> band_track_ids;
+        band_track_ids.reserve(m_band_tracks.size());
+        for(TrackItem* track : m_band_tracks)
         {
-            if(track)
+            track->Update();
+            if(track->IsDisplayed())
             {
-                track->Update();
+                band_track_ids.push_back(track->GetID());
             }
         }
+        m_arrow_layer.Update(m_tpt->GetVMinX(), m_tpt->GetVMaxX(),
+                             std::move(band_track_ids));
     }
 
     // Loading-timer debounce, sticky-note drag and reorder auto-scroll advance
@@ -1451,6 +1578,20 @@ TimelineView::CalculateHighlightTimeWithShimmy(float mouse_x, float origin_x)
                       m_tpt->GetRangeX());
 }
 
+void
+TimelineView::PreviewHighlightedRegion()
+{
+    if(m_highlighted_region.first != TimelineSelection::INVALID_SELECTION_TIME &&
+       m_highlighted_region.second != TimelineSelection::INVALID_SELECTION_TIME)
+    {
+        m_timeline_selection->PreviewTimeRange(
+            m_tpt->DenormalizeTime(
+                std::min(m_highlighted_region.first, m_highlighted_region.second)),
+            m_tpt->DenormalizeTime(
+                std::max(m_highlighted_region.first, m_highlighted_region.second)));
+    }
+}
+
 void
 TimelineView::RenderScrubber(ImVec2 screen_pos)
 {
@@ -1524,6 +1665,10 @@ TimelineView::RenderScrubber(ImVec2 screen_pos)
             m_highlighted_region.second =
                 CalculateHighlightTimeWithShimmy(mouse_pos.x, window_position.x);
         }
+        if(m_dragging_selection_start || m_dragging_selection_end)
+        {
+            PreviewHighlightedRegion();
+        }
     }
 
     if(m_highlighted_region.first != TimelineSelection::INVALID_SELECTION_TIME)
@@ -1821,17 +1966,101 @@ TimelineView::RenderGraphView()
     }
 
     bool request_data = IsRequestDataNeeded();
+    if(request_data)
+    {
+        // Everything still loading for the previous range is obsolete
+        for(TrackItem* track_item : *m_tracks)
+        {
+            if(track_item)
+            {
+                track_item->CancelPendingRequests();
+            }
+        }
+        if(m_data_provider.IsRequestPending(m_track_load_request_id))
+        {
+            m_data_provider.CancelRequest(m_track_load_request_id);
+        }
+    }
 
     // Reset per frame; set by RenderReorderingTrack while a track drag is active.
     m_reordering_track_id = INVALID_TRACK_ID;
     // Re-set each frame by RenderReorderingTrack while in the auto-scroll zone.
     m_reorder_auto_scrolling = false;
 
-    for(int index = 0; index < m_tracks->size(); index++)
+    if(m_track_offsets_y.size() != m_tracks->size() + 1)
+    {
+        RebuildTrackOffsets();
+    }
+
+    // Only tracks within the unload distance of the viewport are visited, spacers
+    // stand in for the content height of all others.
+    const float view_top    = ImGui::GetScrollY();
+    const float view_bottom = view_top + ImGui::GetWindowHeight();
+    size_t      first       = 0;
+    size_t      last        = 0;
+    GetTrackRange(view_top - m_unload_track_distance,
+                  view_bottom + m_unload_track_distance, first, last);
+
+    m_previous_band_tracks.swap(m_band_tracks);
+    m_band_tracks.clear();
+    if(m_track_offsets_y[first] > 0.0f)
+    {
+        ImGui::Dummy(ImVec2(0, m_track_offsets_y[first]));
+    }
+    for(size_t index = first; index < last; index++)
+    {
+        RenderTrack(static_cast<int>(index), request_data, window_flags, container_size);
+        if((*m_tracks)[index])
+        {
+            m_band_tracks.push_back((*m_tracks)[index]);
+        }
+    }
+    if(m_track_height_sum > m_track_offsets_y[last])
+    {
+        ImGui::Dummy(ImVec2(0, m_track_height_sum - m_track_offsets_y[last]));
+    }
+    std::sort(m_band_tracks.begin(), m_band_tracks.end());
+    ReleaseTracksOutsideBand();
+
+    // A track resized while rendering; keeps the surface from also taking the drag
+    // as a pan. The offsets are shifted in the next Update().
+    if(m_track_height_change_count != TrackItem::GetHeightChangeCount())
+    {
+        m_resize_activity = true;
+    }
+
+    TimelineModel& tlm = m_data_provider.DataModel().GetTimeline();
+    // The dragged track keeps its preview after auto-scroll moved it out of the band
+    const ImGuiPayload* payload = ImGui::GetDragDropPayload();
+    if(payload && payload->IsDataType("reorder_request"))
+    {
+        const TrackInfo* metadata = tlm.GetTrack(m_reorder_request.track_id);
+        if(metadata && (metadata->index < first || metadata->index >= last) &&
+           metadata->index < m_tracks->size() && (*m_tracks)[metadata->index])
+        {
+            RenderReorderingTrack((*m_tracks)[metadata->index], container_size);
+        }
+    }
+    // Selected tracks keep their statistics current wherever they are
+    if(m_loading_timer.IsExpired() && m_timeline_selection)
     {
-        RenderTrack(index, request_data, window_flags, container_size);
+        m_selected_track_ids.clear();
+        m_timeline_selection->GetSelectedTracks(m_selected_track_ids);
+        for(uint64_t track_id : m_selected_track_ids)
+        {
+            const TrackInfo* metadata = tlm.GetTrack(track_id);
+            if(metadata && (metadata->index < first || metadata->index >= last) &&
+               metadata->index < m_tracks->size() && (*m_tracks)[metadata->index] &&
+               (*m_tracks)[metadata->index]->IsDisplayed())
+            {
+                (*m_tracks)[metadata->index]->RequestAnalysis();
+            }
+        }
     }
 
+    RequestQueuedTrackData();
+    UpdatePrefetch();
+
     RenderEmptyTrackAreaMenu();
 
     TrackItem::SetSidebarSize(m_sidebar_size);
@@ -1940,8 +2169,6 @@ TimelineView::RenderTrack(int track_index, bool request_data,
     TrackItem* track_item = (*m_tracks)[track_index];
     if(track_item)
     {
-        m_resize_activity |= track_item->TrackHeightChanged();
-
         if(track_item->IsDisplayed())
         {
             // Get track height and position to check if the track is in view
@@ -2027,15 +2254,75 @@ TimelineView::RequestDataIfEmpty(TrackItem* track_item, bool request_data)
             track_item->ReleaseData();
         }
 
-        // Request one viewport worth of data on each side of the current
-        // view.
-        double buffer_distance = m_tpt->GetVWidth();
-        track_item->RequestData(
-            (m_tpt->GetViewTimeOffsetNs() - buffer_distance) + m_tpt->GetMinX(),
-            (m_tpt->GetViewTimeOffsetNs() + m_tpt->GetVWidth() + buffer_distance) +
-                m_tpt->GetMinX(),
-            m_tpt->GetGraphSizeX() * 3);
+        m_data_request_tracks.push_back(track_item);
+    }
+}
+
+void
+TimelineView::RequestQueuedTrackData()
+{
+    if(m_data_request_tracks.empty())
+    {
+        return;
+    }
+
+    // Request one viewport worth of data on each side of the current
+    // view.
+    double buffer_distance = m_tpt->GetVWidth();
+    double start = (m_tpt->GetViewTimeOffsetNs() - buffer_distance) + m_tpt->GetMinX();
+    double end   = (m_tpt->GetViewTimeOffsetNs() + m_tpt->GetVWidth() + buffer_distance) +
+                 m_tpt->GetMinX();
+
+    // Load all tracks with a single request first, so the controller can read tracks
+    // sharing database tables together. The per track requests are queued behind it
+    // and sent once it completes, answered from the loaded data instead of querying
+    // each track separately.
+    if(m_data_request_tracks.size() > 1)
+    {
+        std::vector<uint64_t> track_ids;
+        track_ids.reserve(m_data_request_tracks.size());
+        for(TrackItem* track_item : m_data_request_tracks)
+        {
+            track_ids.push_back(track_item->GetID());
+        }
+        std::pair<bool, uint64_t> result = m_data_provider.LoadTracks(track_ids, start, end);
+        if(result.first)
+        {
+            m_track_load_request_id = result.second;
+        }
+    }
+
+    for(TrackItem* track_item : m_data_request_tracks)
+    {
+        track_item->RequestData(start, end, m_tpt->GetGraphSizeX() * 3);
+    }
+    m_data_request_tracks.clear();
+}
+
+void
+TimelineView::UpdatePrefetch()
+{
+    if(!m_loading_timer.IsExpired() || m_last_data_req_v_width <= 0.0)
+    {
+        return;
+    }
+
+    std::vector<uint64_t> track_ids;
+    for(TrackItem* track_item : m_band_tracks)
+    {
+        if(track_item->IsDisplayed() && track_item->IsInViewVertical())
+        {
+            track_ids.push_back(track_item->GetID());
+        }
     }
+
+    // Same range as the last RequestQueuedTrackData() call
+    double view_start = m_tpt->GetViewTimeOffsetNs() + m_tpt->GetMinX();
+    double loaded_start =
+        m_last_data_req_view_time_offset_ns - m_last_data_req_v_width + m_tpt->GetMinX();
+    m_data_provider.UpdatePrefetch(track_ids, view_start, view_start + m_tpt->GetVWidth(),
+                                   loaded_start, loaded_start + m_last_data_req_v_width * 3,
+                                   static_cast<uint32_t>(m_tpt->GetGraphSizeX() * 3));
 }
 
 void
@@ -2306,6 +2593,10 @@ TimelineView::DestroyGraphs()
         }
         m_tracks->clear();
     }
+    m_band_tracks.clear();
+    m_previous_band_tracks.clear();
+    m_released_tracks.clear();
+    m_data_request_tracks.clear();
     m_meta_map_made = false;
 }
 
@@ -2382,9 +2673,10 @@ TimelineView::MakeGraphView()
 
     m_data_provider.DataModel().GetTimeline().UpdateHistogram(*m_tracks.get());
     UpdateMaxMetaAreaSize();
-    m_histogram       = &tlm.GetHistogram();
-    m_meta_map_made   = true;
-    m_resize_activity = true;
+    m_histogram          = &tlm.GetHistogram();
+    m_meta_map_made      = true;
+    m_resize_activity    = true;
+    m_track_layout_dirty = true;
 
     CalculateTrackCounts();
 
@@ -2462,8 +2754,9 @@ TimelineView::ApplyTrackOrder(const std::vector<uint64_t>& order)
     }
 
     RebuildTrackVectorFromMetadata();
-    // Force the position map / layout to recompute on the next Update().
-    m_resize_activity = true;
+    // Force the track offsets / layout to recompute on the next Update().
+    m_resize_activity    = true;
+    m_track_layout_dirty = true;
     return true;
 }
 
@@ -3527,6 +3820,7 @@ TimelineView::HandleTopSurfaceTouch()
 
             ImVec2 mouse_pos = ImGui::GetMousePos();
             m_highlighted_region.second = CalculateHighlightTimeWithShimmy(mouse_pos.x, graph_area_min.x);
+            PreviewHighlightedRegion();
             // Update offset_ns in case shimmy changed the view
             offset_ns = m_tpt->GetViewTimeOffsetNs();
         }
@@ -3771,52 +4065,39 @@ TimelineView::GetVisibleTrackFractions(float& start_fraction, float& end_fractio
     start_fraction = 0.0f;
     end_fraction   = 1.0f;
 
-    if(!m_tracks || m_tracks->empty()) return;
-
-    // Count displayed tracks and find visible range
-    int   displayed_count = 0;
-    float first_visible   = -1.0f;
-    float last_visible    = -1.0f;
-    float view_top        = static_cast<float>(m_scroll_position_y);
-    float view_bottom     = view_top + GetTrackViewportHeight();
-    float cumulative_y    = 0.0f;
-
-    for(int i = 0; i < static_cast<int>(m_tracks->size()); i++)
-    {
-        const auto& track = (*m_tracks)[i];
-        if(!track || !track->IsDisplayed()) continue;
-
-        float track_height = track->GetTrackHeight();
-        float track_top    = cumulative_y;
-        float track_bottom = cumulative_y + track_height;
+    if(!m_tracks || m_tracks->empty() ||
+       m_track_offsets_y.size() != m_tracks->size() + 1)
+        return;
 
-        // Check if this track overlaps with the viewport
-        if(track_bottom > view_top && track_top < view_bottom)
-        {
-            // Calculate fractional visibility within this track
-            float visible_top    = std::max(track_top, view_top);
-            float visible_bottom = std::min(track_bottom, view_bottom);
+    const uint32_t displayed_count = m_displayed_track_prefix.back();
+    if(displayed_count == 0) return;
 
-            if(first_visible < 0.0f)
-            {
-                // First visible track - include partial
-                float partial = (visible_top - track_top) / track_height;
-                first_visible = static_cast<float>(displayed_count) + partial;
-            }
-            // Update last visible with partial coverage
-            float partial = (visible_bottom - track_top) / track_height;
-            last_visible  = static_cast<float>(displayed_count) + partial;
-        }
+    float  view_top    = static_cast<float>(m_scroll_position_y);
+    float  view_bottom = view_top + GetTrackViewportHeight();
+    size_t first       = 0;
+    size_t last        = 0;
+    GetTrackRange(view_top, view_bottom, first, last);
 
-        cumulative_y += track_height;
-        displayed_count++;
-    }
-
-    if(displayed_count > 0 && first_visible >= 0.0f)
-    {
-        start_fraction = first_visible / static_cast<float>(displayed_count);
-        end_fraction   = last_visible / static_cast<float>(displayed_count);
-    }
+    // Drop hidden tracks and tracks only touching the viewport edge
+    auto overlaps = [&](size_t index) {
+        const float top    = m_track_offsets_y[index];
+        const float bottom = m_track_offsets_y[index + 1];
+        return bottom > top && bottom > view_top && top < view_bottom;
+    };
+    while(first < last && !overlaps(first)) first++;
+    while(last > first && !overlaps(last - 1)) last--;
+    if(first == last) return;
+
+    // Position in displayed tracks, including the partially visible part of a track
+    auto track_fraction = [&](size_t index, float y) {
+        const float top    = m_track_offsets_y[index];
+        const float height = m_track_offsets_y[index + 1] - top;
+        return static_cast<float>(m_displayed_track_prefix[index]) + (y - top) / height;
+    };
+    start_fraction = track_fraction(first, std::max(m_track_offsets_y[first], view_top)) /
+                     static_cast<float>(displayed_count);
+    end_fraction = track_fraction(last - 1, std::min(m_track_offsets_y[last], view_bottom)) /
+                   static_cast<float>(displayed_count);
 }
 
 TimelineArrow&
@@ -114,12 +114,14 @@ public:
     float          GetScrollPosition();
     void           TimelineDragShimmy(int shimmy_amount);
     double         CalculateHighlightTimeWithShimmy(float mouse_x, float origin_x);
+    void           PreviewHighlightedRegion();
     void           RenderScrubber(ImVec2 screen_pos);
     void           RenderSplitter();
     void           RenderGraphView();
     void           HandleTopSurfaceTouch();
     void           HandleHistogramTouch();
     void           HandleNewTrackData(std::shared_ptr<RocEvent> e);
+    void           HandleTrackDataNotice(const TrackDataNotice& notice);
     void           CalculateGridInterval();
     ImVec2         GetGraphSize();
     void           RenderAnnotations(ImDrawList* draw_list, ImVec2 window_position);
@@ -227,6 +229,8 @@ private:
     void RenderEmptyTrackAreaMenu();
     bool IsRequestDataNeeded();
     void RequestDataIfEmpty(TrackItem* track_item, bool request_data);
+    void RequestQueuedTrackData();
+    void UpdatePrefetch();
     void RenderNormalTrack(TrackItem* track_item, int track_index, ImGuiWindowFlags window_flags,
                    bool is_reordering);
     void RenderTimeRangeSelectionFill(ImDrawList* draw_list, ImVec2 lane_min,
@@ -241,6 +245,18 @@ private:
     void                            ZoomToMeasurement();
 
     TrackLayout                     BuildTrackLayout();
+
+    // Recomputes m_track_offsets_y from scratch, after reordering or visibility
+    // changes.
+    void RebuildTrackOffsets();
+    // Shifts the offsets below tracks whose height changed since the last call.
+    void ApplyTrackHeightChanges();
+    // Content-space top of a track, false if the track is unknown.
+    bool GetTrackTopY(uint64_t track_id, float& out_top_y) const;
+    // Index range [first, last) of the tracks overlapping content-space [top, bottom].
+    void GetTrackRange(float top, float bottom, size_t& first, size_t& last) const;
+    // Releases data of tracks that left the loading band, see RenderGraphView().
+    void ReleaseTracksOutsideBand();
     EventManager::SubscriptionToken m_scroll_to_track_token;
     EventManager::SubscriptionToken m_navigation_token;
     EventManager::SubscriptionToken m_new_track_token;
@@ -277,7 +293,13 @@ private:
     TimelineArrow                       m_arrow_layer;
     bool                                m_stop_user_interaction;
     float                               m_last_zoom;
-    std::unordered_map<uint64_t, float> m_track_position_y;  // Track index to height
+    // Content-space top of every track, indexed like m_tracks, hidden tracks take no
+    // height. The extra last entry equals m_track_height_sum.
+    std::vector<float>                  m_track_offsets_y;
+    // Number of displayed tracks before each track, indexed like m_track_offsets_y.
+    std::vector<uint32_t>               m_displayed_track_prefix;
+    bool                                m_track_layout_dirty;
+    uint64_t                            m_track_height_change_count;
     float                               m_track_height_sum;
     size_t                              m_hidden_track_count;
     std::shared_ptr<TimelineSelection>  m_timeline_selection;
@@ -287,6 +309,15 @@ private:
     bool                                m_histogram_pseudo_focus;
     float                               m_max_meta_scale_area_size;
     std::shared_ptr<std::vector<TrackItem*>>          m_tracks;
+    std::vector<TrackItem*>                           m_data_request_tracks;  // Tracks to request data for this frame
+    uint64_t                                          m_track_load_request_id = 0;  // Last track load, cancelled when the range moves
+    // Tracks within the unload distance of the viewport as of the last frame. Only
+    // these are rendered and updated; the list is sorted by pointer.
+    std::vector<TrackItem*>                           m_band_tracks;
+    std::vector<TrackItem*>                           m_previous_band_tracks;
+    // Tracks that left the band while requests were still in flight
+    std::vector<TrackItem*>                           m_released_tracks;
+    std::vector<uint64_t>                             m_selected_track_ids;  // Scratch list
     std::shared_ptr<TimePixelTransform>               m_tpt;
     std::unique_ptr<TimelineTrackOptions>             m_track_options_context_menu;
 
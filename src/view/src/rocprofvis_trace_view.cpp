@@ -24,6 +24,7 @@
 #include "widgets/rocprofvis_dialog.h"
 #include "widgets/rocprofvis_gui_helpers.h"
 #include "widgets/rocprofvis_notification_manager.h"
+#include <algorithm>
 
 namespace RocProfVis
 {
@@ -32,6 +33,8 @@ namespace View
 
 constexpr ImVec2 MINIMAP_POPUP_SIZE(600.0f, 435.0f);
 constexpr ImVec2 MINIMAP_POPUP_MIN_SIZE(500.0f, 360.0f);
+// Selections of at least this many events prefetch the details of all of them at once
+constexpr size_t EVENT_PREFETCH_MIN_EVENTS = 8;
 
 TraceView::TraceView()
 : m_timeline_view(nullptr)
@@ -46,6 +49,7 @@ TraceView::TraceView()
 , m_event_selection_changed_event_token(EventManager::InvalidSubscriptionToken)
 , m_progress_update_event_token(EventManager::InvalidSubscriptionToken)
 , m_save_notification_id("")
+, m_event_prefetch_request_id(INVALID_UINT64_INDEX)
 , m_project_settings(nullptr)
 , m_annotations(nullptr)
 , m_event_search(nullptr)
@@ -76,10 +80,17 @@ TraceView::TraceView()
     });
 
     m_data_provider.SetTrackDataReadyCallback(
-        [](uint64_t track_id, const std::string& trace_path, const RequestInfo& req) {
-            EventManager::GetInstance()->AddEvent(std::make_shared<TrackDataEvent>(
-                static_cast<int>(RocEvents::kNewTrackData), track_id, trace_path,
-                req.request_id, req.response_code));
+        [source_path = std::string(), source = uint32_t(0)](
+            uint64_t track_id, const std::string& trace_path,
+            const RequestInfo& req) mutable {
+            // Responses are batched per source, resolve its handle once per trace
+            if(source_path != trace_path)
+            {
+                source_path = trace_path;
+                source      = EventManager::GetInstance()->RegisterSource(trace_path);
+            }
+            EventManager::GetInstance()->AddTrackDataEvent(
+                { track_id, req.request_id, req.response_code, source });
         });
 
     auto new_tab_selected_handler = [this](std::shared_ptr<RocEvent> e) {
@@ -147,15 +158,26 @@ TraceView::TraceView()
         {
             if(event->EventSelected())
             {
-                m_data_provider.FetchEvent(event->GetEventTrackID(), event->GetEventID());
+                m_pending_event_fetches.emplace_back(event->GetEventTrackID(),
+                                                     event->GetEventID());
             }
             else if(event->IsBatch())
             {
+                m_pending_event_fetches.clear();
+                m_event_prefetch_request_id = INVALID_UINT64_INDEX;
                 m_data_provider.DataModel().GetEvents().ClearEvents();
             }
             else
             {
-                m_data_provider.DataModel().GetEvents().RemoveEvent(event->GetEventID());
+                uint64_t event_id = event->GetEventID();
+                m_pending_event_fetches.erase(
+                    std::remove_if(m_pending_event_fetches.begin(),
+                                   m_pending_event_fetches.end(),
+                                   [event_id](const std::pair<uint64_t, uint64_t>& item) {
+                                       return item.second == event_id;
+                                   }),
+                    m_pending_event_fetches.end());
+                m_data_provider.DataModel().GetEvents().RemoveEvent(event_id);
             }
         }
     };
@@ -248,6 +270,8 @@ TraceView::Update()
         }
     }
 
+    FetchPendingEvents();
+
     if(m_timeline_view)
     {
         m_timeline_view->Update();
@@ -362,6 +386,43 @@ TraceView::LoadTrace(rocprofvis_controller_t* controller, const std::string& fil
     return result;
 }
 
+void
+TraceView::FetchPendingEvents()
+{
+    if(m_pending_event_fetches.empty())
+    {
+        return;
+    }
+    if(m_event_prefetch_request_id == INVALID_UINT64_INDEX &&
+       m_pending_event_fetches.size() >= EVENT_PREFETCH_MIN_EVENTS)
+    {
+        std::vector<uint64_t> event_ids;
+        event_ids.reserve(m_pending_event_fetches.size());
+        for(const std::pair<uint64_t, uint64_t>& item : m_pending_event_fetches)
+        {
+            event_ids.push_back(item.second);
+        }
+        std::pair<bool, uint64_t> result =
+            m_data_provider.PrefetchEventProperties(event_ids);
+        if(result.first)
+        {
+            m_event_prefetch_request_id = result.second;
+        }
+    }
+    // Event fetches wait for the prefetch, so they are served from the cache
+    if(m_event_prefetch_request_id != INVALID_UINT64_INDEX &&
+       m_data_provider.IsRequestPending(m_event_prefetch_request_id))
+    {
+        return;
+    }
+    m_event_prefetch_request_id = INVALID_UINT64_INDEX;
+    for(const std::pair<uint64_t, uint64_t>& item : m_pending_event_fetches)
+    {
+        m_data_provider.FetchEvent(item.first, item.second);
+    }
+    m_pending_event_fetches.clear();
+}
+
 void 
 TraceView::Render()
 {
@@ -85,6 +85,7 @@ private:
     void RenderAnnotationControls();
     void RenderEventSearch();
     void RenderMeasurementControls();
+    void FetchPendingEvents();
 
     std::shared_ptr<TimelineView>      m_timeline_view;
     std::shared_ptr<TimelineSelection> m_timeline_selection;
@@ -123,6 +124,12 @@ private:
 
     std::string m_save_notification_id;
 
+    // Selected events whose details have not been fetched yet, as track / event id
+    // pairs. Fetched on the next update, after a prefetch of all of them if there
+    // are many.
+    std::vector<std::pair<uint64_t, uint64_t>> m_pending_event_fetches;
+    uint64_t                                   m_event_prefetch_request_id;
+
     std::unique_ptr<SystemTraceProjectSettings> m_project_settings;
 };
 
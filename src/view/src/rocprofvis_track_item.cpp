@@ -32,7 +32,9 @@ inline constexpr float    META_FRAME_PADDING_Y           = 4.0f;
 inline constexpr float    META_ITEM_SPACING_Y            = 3.0f;
 constexpr const char*     TRACK_COPY_MENU_POPUP_NAME     = "TrackCopyMenu";
 
-float TrackItem::s_metadata_width = 400.0f;
+float    TrackItem::s_metadata_width      = 400.0f;
+uint64_t TrackItem::s_height_change_count = 0;
+std::vector<TrackItem*> TrackItem::s_height_changed_tracks;
 
 static ImU32
 CompareSourceColor(const CompareSourceInfo& source, SettingsManager& settings)
@@ -166,6 +168,7 @@ TrackItem::~TrackItem()
     EventManager::GetInstance()->Unsubscribe(
         static_cast<int>(RocEvents::kTimelineTrackSelectionChanged),
         m_selected_changed_token);
+    TrackHeightChanged();
 }
 
 bool
@@ -206,9 +209,42 @@ TrackItem::TrackHeightChanged()
 {
     bool height_changed    = m_track_height_changed;
     m_track_height_changed = false;
+    if(height_changed)
+    {
+        auto it = std::find(s_height_changed_tracks.begin(),
+                            s_height_changed_tracks.end(), this);
+        if(it != s_height_changed_tracks.end())
+        {
+            *it = s_height_changed_tracks.back();
+            s_height_changed_tracks.pop_back();
+        }
+    }
     return height_changed;
 }
 
+uint64_t
+TrackItem::GetHeightChangeCount()
+{
+    return s_height_change_count;
+}
+
+const std::vector<TrackItem*>&
+TrackItem::GetHeightChangedTracks()
+{
+    return s_height_changed_tracks;
+}
+
+void
+TrackItem::MarkTrackHeightChanged()
+{
+    if(!m_track_height_changed)
+    {
+        s_height_changed_tracks.push_back(this);
+    }
+    m_track_height_changed = true;
+    s_height_change_count++;
+}
+
 float
 TrackItem::GetTrackHeight() const
 {
@@ -607,7 +643,7 @@ TrackItem::RenderResizeBar(const ImVec2& parent_size)
             m_options->m_height = std::max(
                 m_options->m_height + ImGui::GetMouseDragDelta(ImGuiMouseButton_Left).y,
                 m_min_track_height);
-            m_track_height_changed = true;
+            MarkTrackHeightChanged();
         }
         ImGui::ResetMouseDragDelta();
         ImGui::EndDragDropSource();
@@ -701,6 +737,15 @@ TrackItem::Update()
 void
 TrackItem::FetchHelper()
 {
+    // Held back while a track load is reading the range, Update() retries once it is
+    // done and the fetches are answered from the loaded segments.
+    if(!m_request_queue.empty() &&
+       m_data_provider.IsTrackLoading(m_track_id, m_request_queue.front().m_start_ts,
+                                      m_request_queue.back().m_end_ts))
+    {
+        return;
+    }
+
     while(!m_request_queue.empty())
     {
         TrackRequestParams&       req    = m_request_queue.front();
@@ -117,12 +117,19 @@ public:
     float GetDistanceToView() const;
 
     bool        TrackHeightChanged();
-    static void SetSidebarSize(float sidebar_size);
+    // Counts height changes of all tracks, views compare it to skip polling every
+    // track with TrackHeightChanged() on frames where nothing was resized.
+    static uint64_t GetHeightChangeCount();
+    // Tracks of all views whose height changed since their view last applied it.
+    static const std::vector<TrackItem*>& GetHeightChangedTracks();
+    static void     SetSidebarSize(float sidebar_size);
 
     virtual bool HasData() const;
     bool         AllDataReady() const;
     virtual bool ReleaseData();
     virtual void RequestData(double min, double max, float width);
+    // Asks the controller to stop the track's in-flight requests, once per batch
+    void         CancelPendingRequests();
     void         RequestAnalysis();
     virtual void HandleTrackDataChanged(uint64_t request_id, uint64_t response_code);
     virtual bool HasPendingRequests() const;
@@ -151,12 +158,12 @@ protected:
     virtual void  ExtractPointsFromData() = 0;
 
     void  FetchHelper();
-    void  CancelPendingRequests();
     void  SetDefaultPillLabel(const TrackInfo* track_info);
     void  SetMetaAreaLabel(const TrackInfo* track_info);
     void  SetNodeColor(const TrackInfo* track_info);
     Pill* AddPill(bool shown = true, bool active = true);
     bool  HasSavedTrackHeight() const;
+    void  MarkTrackHeightChanged();
     float GetMetaAreaMinHeight() const;
 
     const TrackInfo*                    m_track_metadata;
@@ -189,6 +196,8 @@ protected:
     std::deque<TrackRequestParams>                   m_request_queue;
     std::unordered_map<uint64_t, TrackRequestParams> m_pending_requests;
     static float                                     s_metadata_width;
+    static uint64_t                                  s_height_change_count;
+    static std::vector<TrackItem*>                   s_height_changed_tracks;
     std::string                                      m_meta_area_label;
     std::string                                      m_meta_area_tooltip;
 
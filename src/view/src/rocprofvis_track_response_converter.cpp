@@ -0,0 +1,301 @@
+// Copyright Advanced Micro Devices, Inc.
+// SPDX-License-Identifier: MIT
+
+#include "rocprofvis_track_response_converter.h"
+#include "rocprofvis_controller.h"
+#include "rocprofvis_data_provider.h"
+#include "rocprofvis_core_assert.h"
+#include "rocprofvis_core_profile.h"
+
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <string>
+
+namespace RocProfVis
+{
+namespace View
+{
+
+TrackResponseConverter::TrackResponseConverter()
+: m_active_jobs(0)
+, m_shutdown(false)
+, m_ready_head(nullptr)
+{}
+
+TrackResponseConverter::~TrackResponseConverter()
+{
+    Cancel();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shutdown = true;
+    }
+    m_job_cv.notify_all();
+    for(std::thread& worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+void
+TrackResponseConverter::StartWorkers()
+{
+    // Keep most cores for the controller, conversion is a small share of the work
+    unsigned worker_count =
+        std::clamp(std::thread::hardware_concurrency() / 4, 1u, MAX_WORKERS);
+    for(unsigned i = 0; i < worker_count; i++)
+    {
+        m_workers.emplace_back(&TrackResponseConverter::WorkerLoop, this, i);
+    }
+    spdlog::debug("Started {} track response conversion workers", worker_count);
+}
+
+void
+TrackResponseConverter::Submit(uint64_t request_id,
+                               rocprofvis_controller_track_type_t track_type,
+                               rocprofvis_controller_array_t*     array)
+{
+    if(m_workers.empty())
+    {
+        StartWorkers();
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.push_back({ request_id, track_type, array, nullptr });
+        PROFILE_COUNTER("Track conversion queue depth", m_jobs.size());
+    }
+    m_job_cv.notify_one();
+}
+
+void
+TrackResponseConverter::Post(std::function<void()> task)
+{
+    if(m_workers.empty())
+    {
+        StartWorkers();
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.push_back({ 0, kRPVControllerTrackTypeSamples, nullptr, std::move(task) });
+    }
+    m_job_cv.notify_one();
+}
+
+void
+TrackResponseConverter::TakeReady(std::deque<std::unique_ptr<ConvertedTrackResponse>>& output)
+{
+    // Swap out the whole list, workers keep pushing to a fresh head
+    ConvertedTrackResponse* head = m_ready_head.exchange(nullptr, std::memory_order_acquire);
+
+    // The list is in LIFO order, reverse it so that earlier conversions are merged first
+    ConvertedTrackResponse* reversed = nullptr;
+    while(head)
+    {
+        ConvertedTrackResponse* next = head->next;
+        head->next                   = reversed;
+        reversed                     = head;
+        head                         = next;
+    }
+    while(reversed)
+    {
+        ConvertedTrackResponse* next = reversed->next;
+        reversed->next               = nullptr;
+        output.emplace_back(reversed);
+        reversed = next;
+    }
+}
+
+void
+TrackResponseConverter::Cancel()
+{
+    std::deque<Job> dropped;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        // Posted tasks stay queued, their owners cancel them
+        std::deque<Job> kept;
+        for(Job& job : m_jobs)
+        {
+            (job.task ? kept : dropped).push_back(std::move(job));
+        }
+        m_jobs.swap(kept);
+        m_idle_cv.wait(lock, [this]() { return m_active_jobs == 0; });
+    }
+    for(Job& job : dropped)
+    {
+        rocprofvis_controller_array_free(job.array);
+    }
+
+    std::deque<std::unique_ptr<ConvertedTrackResponse>> discarded;
+    TakeReady(discarded);
+    if(!dropped.empty() || !discarded.empty())
+    {
+        spdlog::debug("Discarded {} queued and {} converted track responses",
+                      dropped.size(), discarded.size());
+    }
+}
+
+void
+TrackResponseConverter::Publish(ConvertedTrackResponse* response)
+{
+    ConvertedTrackResponse* head = m_ready_head.load(std::memory_order_relaxed);
+    do
+    {
+        response->next = head;
+    } while(!m_ready_head.compare_exchange_weak(head, response, std::memory_order_release,
+                                                std::memory_order_relaxed));
+}
+
+void
+TrackResponseConverter::WorkerLoop(unsigned worker_index)
+{
+    Core::Profiler::SetThreadName("Track Conversion Worker " +
+                                  std::to_string(worker_index));
+    while(true)
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_job_cv.wait(lock, [this]() { return m_shutdown || !m_jobs.empty(); });
+            if(m_shutdown)
+            {
+                break;
+            }
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+            m_active_jobs++;
+        }
+
+        if(job.task)
+        {
+            job.task();
+            job.task = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_active_jobs--;
+            }
+            m_idle_cv.notify_all();
+            continue;
+        }
+
+        ConvertedTrackResponse* response = new ConvertedTrackResponse();
+        response->request_id             = job.request_id;
+        {
+            PROFILE_ZONE("view", "Convert track response");
+            if(job.track_type == kRPVControllerTrackTypeEvents)
+            {
+                ConvertEvents(job.array, response->events);
+            }
+            else if(job.track_type == kRPVControllerTrackTypeSamples)
+            {
+                ConvertSamples(job.array, response->samples);
+            }
+        }
+        PROFILE_COUNTER("Converted track bytes",
+                        response->events.size() * sizeof(TraceEvent) +
+                            response->samples.size() * sizeof(TraceCounter));
+        rocprofvis_controller_array_free(job.array);
+        Publish(response);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_active_jobs--;
+        }
+        m_idle_cv.notify_all();
+    }
+}
+
+void
+TrackResponseConverter::ConvertEvents(rocprofvis_controller_array_t* array,
+                                      std::vector<TraceEvent>&       output)
+{
+    uint64_t            count  = 0;
+    rocprofvis_result_t result = rocprofvis_controller_get_uint64(
+        array, kRPVControllerArrayNumEntries, 0, &count);
+    ROCPROFVIS_ASSERT(result == kRocProfVisResultSuccess);
+
+    output.resize(count);
+    for(uint64_t i = 0; i < count; i++)
+    {
+        rocprofvis_controller_event_t* event = nullptr;
+        result = rocprofvis_controller_get_object(array, kRPVControllerArrayEntryIndexed, i,
+                                                  &event);
+        ROCPROFVIS_ASSERT(result == kRocProfVisResultSuccess && event);
+
+        TraceEvent& trace_event = output[i];
+
+        uint64_t id = 0;
+        result = rocprofvis_controller_get_uint64(event, kRPVControllerEventId, 0, &id);
+        ROCPROFVIS_ASSERT(result == kRocProfVisResultSuccess);
+        trace_event.m_id.uuid = id;
+
+        double start_ts = 0;
+        result          = rocprofvis_controller_get_double(
+            event, kRPVControllerEventStartTimestamp, 0, &start_ts);
+        ROCPROFVIS_ASSERT(result == kRocProfVisResultSuccess);
+        trace_event.m_start_ts = start_ts;
+
+        double end_ts = 0;
+        result = rocprofvis_controller_get_double(event, kRPVControllerEventEndTimestamp,
+                                                  0, &end_ts);
+        ROCPROFVIS_ASSERT(result == kRocProfVisResultSuccess);
+        trace_event.m_duration = end_ts - start_ts;
+
+        uint64_t level = 0;
+        result =
+            rocprofvis_controller_get_uint64(event, kRPVControllerEventLevel, 0, &level);
+        ROCPROFVIS_ASSERT(result == kRocProfVisResultSuccess);
+        trace_event.m_level = static_cast<uint32_t>(level);
+
+        uint64_t child_count = 0;
+        result = rocprofvis_controller_get_uint64(event, kRPVControllerEventNumChildren,
+                                                  0, &child_count);
+        ROCPROFVIS_ASSERT(result == kRocProfVisResultSuccess);
+        trace_event.m_child_count = static_cast<uint32_t>(child_count);
+
+        result = DataProvider::GetString(event, kRPVControllerEventName, 0,
+                                         trace_event.m_name);
+        ROCPROFVIS_ASSERT(result == kRocProfVisResultSuccess);
+        if(trace_event.m_child_count > 1)
+        {
+            result = DataProvider::GetString(event, kRPVControllerEventTopCombinedName,
+                                             0, trace_event.m_top_combined_name);
+            ROCPROFVIS_ASSERT(result == kRocProfVisResultSuccess);
+        }
+    }
+}
+
+void
+TrackResponseConverter::ConvertSamples(rocprofvis_controller_array_t* array,
+                                       std::vector<TraceCounter>&     output)
+{
+    uint64_t            count  = 0;
+    rocprofvis_result_t result = rocprofvis_controller_get_uint64(
+        array, kRPVControllerArrayNumEntries, 0, &count);
+    ROCPROFVIS_ASSERT(result == kRocProfVisResultSuccess);
+
+    output.resize(count);
+    for(uint64_t i = 0; i < count; i++)
+    {
+        rocprofvis_controller_sample_t* sample = nullptr;
+        result = rocprofvis_controller_get_object(array, kRPVControllerArrayEntryIndexed, i,
+                                                  &sample);
+        ROCPROFVIS_ASSERT(result == kRocProfVisResultSuccess && sample);
+
+        TraceCounter& trace_counter = output[i];
+
+        result = rocprofvis_controller_get_double(sample, kRPVControllerSampleTimestamp, 0,
+                                                  &trace_counter.m_start_ts);
+        ROCPROFVIS_ASSERT(result == kRocProfVisResultSuccess);
+
+        result = rocprofvis_controller_get_double(sample, kRPVControllerSampleValue, 0,
+                                                  &trace_counter.m_value);
+        ROCPROFVIS_ASSERT(result == kRocProfVisResultSuccess);
+
+        result = rocprofvis_controller_get_double(sample, kRPVControllerSampleEndTimestamp,
+                                                  0, &trace_counter.m_end_ts);
+        ROCPROFVIS_ASSERT(result == kRocProfVisResultSuccess);
+    }
+}
+
+}  // namespace View
+}  // namespace RocProfVis
@@ -0,0 +1,110 @@
+// Copyright Advanced Micro Devices, Inc.
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "rocprofvis_controller_enums.h"
+#include "rocprofvis_controller_types.h"
+#include "rocprofvis_raw_track_data.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace RocProfVis
+{
+namespace View
+{
+
+// Track response converted into view buffers, waiting to be merged into the model
+struct ConvertedTrackResponse
+{
+    uint64_t                  request_id;
+    std::vector<TraceEvent>   events;
+    std::vector<TraceCounter> samples;
+    ConvertedTrackResponse*   next = nullptr;  // link in the ready list
+};
+
+/*
+ * Converts controller track arrays into TraceEvent / TraceCounter buffers on
+ * worker threads so that large responses do not stall the UI thread.
+ * Finished buffers are pushed to a lock-free multi-producer list which the UI
+ * thread swaps out in one exchange per frame.
+ * Other per-track background work, like counter decimation, is posted to the
+ * same workers so that the view keeps a single bounded pool of threads.
+ */
+class TrackResponseConverter
+{
+public:
+    TrackResponseConverter();
+    ~TrackResponseConverter();
+
+    TrackResponseConverter(const TrackResponseConverter&)            = delete;
+    TrackResponseConverter& operator=(const TrackResponseConverter&) = delete;
+
+    /*
+     * Queues a response for conversion. The converter takes ownership of the array
+     * and frees it once the buffer has been built.
+     * @param request_id: ID of the request the array belongs to
+     * @param track_type: Type of the track, selects event or sample conversion
+     * @param array: Controller array holding the response entries
+     */
+    void Submit(uint64_t request_id, rocprofvis_controller_track_type_t track_type,
+                rocprofvis_controller_array_t* array);
+
+    /*
+     * Queues a task on the conversion workers. Tasks are not dropped by Cancel(),
+     * owners stop them through their own cancellation flag.
+     * @param task: Work to run on a worker thread
+     */
+    void Post(std::function<void()> task);
+
+    /*
+     * Moves all finished conversions to the output, oldest first. UI thread only.
+     */
+    void TakeReady(std::deque<std::unique_ptr<ConvertedTrackResponse>>& output);
+
+    /*
+     * Drops queued conversions, waits for running jobs and discards their results.
+     */
+    void Cancel();
+
+private:
+    static constexpr unsigned MAX_WORKERS = 4;
+
+    struct Job
+    {
+        uint64_t                           request_id;
+        rocprofvis_controller_track_type_t track_type;
+        rocprofvis_controller_array_t*     array;
+        std::function<void()>              task;  // set for posted tasks
+    };
+
+    void StartWorkers();
+    void WorkerLoop(unsigned worker_index);
+    void Publish(ConvertedTrackResponse* response);
+
+    static void ConvertEvents(rocprofvis_controller_array_t* array,
+                              std::vector<TraceEvent>&       output);
+    static void ConvertSamples(rocprofvis_controller_array_t* array,
+                               std::vector<TraceCounter>&     output);
+
+    std::vector<std::thread> m_workers;
+    std::mutex               m_mutex;
+    std::condition_variable  m_job_cv;
+    std::condition_variable  m_idle_cv;
+    std::deque<Job>          m_jobs;
+    size_t                   m_active_jobs;
+    bool                     m_shutdown;
+
+    std::atomic<ConvertedTrackResponse*> m_ready_head;
+};
+
+}  // namespace View
+}  // namespace RocProfVis
@@ -3,6 +3,7 @@
 
 #include "rocprofvis_view_module.h"
 #include "rocprofvis_appwindow.h"
+#include "rocprofvis_core_profile.h"
 #include "rocprofvis_utils.h"
 #include "widgets/rocprofvis_image_helpers.h"
 #include "spdlog/spdlog.h"
@@ -13,6 +14,7 @@ bool
 rocprofvis_view_init(std::function<void(int)>                 notification_callback,
                      rocprofvis_view_file_dialog_preference_t file_dialog_pref)
 {
+    RocProfVis::Core::Profiler::SetThreadName("Main");
     auto app = AppWindow::GetInstance();
     app->SetFileDialogPreference(file_dialog_pref);
     bool result = app->Init();
@@ -31,6 +33,7 @@ rocprofvis_view_init(std::function<void(int)>                 notification_callb
 void
 rocprofvis_view_render(const rocprofvis_view_render_options_t& render_options)
 {
+    PROFILE_ZONE("view", "Frame");
     if(static_cast<int>(render_options) &
        static_cast<int>(rocprofvis_view_render_options_t::kRocProfVisViewRenderOption_RequestExit))
     {
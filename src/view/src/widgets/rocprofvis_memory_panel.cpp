@@ -0,0 +1,200 @@
+// Copyright Advanced Micro Devices, Inc.
+// SPDX-License-Identifier: MIT
+
+#include "rocprofvis_memory_panel.h"
+
+#include "imgui.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+using namespace RocProfVis::View;
+
+namespace
+{
+constexpr float  MEMORY_PANEL_DEFAULT_WIDTH    = 700.0f;
+constexpr float  MEMORY_PANEL_DEFAULT_HEIGHT   = 500.0f;
+constexpr float  MEMORY_PANEL_NUMBER_WIDTH     = 100.0f;
+constexpr double MEMORY_PANEL_REFRESH_INTERVAL = 1.0;
+
+std::string
+FormatBytes(uint64_t bytes)
+{
+    static const char* units[] = { "B", "KB", "MB", "GB", "TB" };
+    double             value   = static_cast<double>(bytes);
+    size_t             unit    = 0;
+    while(value >= 1024.0 && unit < (sizeof(units) / sizeof(units[0])) - 1)
+    {
+        value /= 1024.0;
+        unit++;
+    }
+    char buffer[32];
+    if(unit == 0)
+    {
+        snprintf(buffer, sizeof(buffer), "%llu B", static_cast<unsigned long long>(bytes));
+    }
+    else
+    {
+        snprintf(buffer, sizeof(buffer), "%.2f %s", value, units[unit]);
+    }
+    return buffer;
+}
+}  // namespace
+
+MemoryUsageWindow::MemoryUsageWindow()
+: m_data_provider(nullptr)
+, m_auto_refresh(true)
+, m_last_refresh_time(0.0)
+{}
+
+void
+MemoryUsageWindow::Refresh(DataProvider* data_provider)
+{
+    m_last_refresh_time = ImGui::GetTime();
+    if(data_provider)
+    {
+        data_provider->RequestMemoryReport();
+    }
+}
+
+void
+MemoryUsageWindow::BuildTree()
+{
+    m_roots.clear();
+    m_children.assign(m_report.entries.size(), {});
+    for(size_t i = 0; i < m_report.entries.size(); i++)
+    {
+        uint64_t parent = m_report.entries[i].parent;
+        if(parent < i)
+        {
+            m_children[parent].push_back(i);
+        }
+        else
+        {
+            m_roots.push_back(i);
+        }
+    }
+    // largest consumers first
+    auto by_bytes = [this](size_t a, size_t b) {
+        return m_report.entries[a].bytes > m_report.entries[b].bytes;
+    };
+    for(std::vector<size_t>& children : m_children)
+    {
+        std::stable_sort(children.begin(), children.end(), by_bytes);
+    }
+}
+
+void
+MemoryUsageWindow::RenderNav(DataProvider* data_provider)
+{
+    ImGui::BeginDisabled(data_provider == nullptr);
+    ImGui::Checkbox("Auto refresh", &m_auto_refresh);
+    ImGui::SameLine();
+    if(ImGui::Button("Refresh"))
+    {
+        Refresh(data_provider);
+    }
+    ImGui::EndDisabled();
+
+    ImGui::Text("Trace pool budget: %s", m_report.trace_budget
+                                            ? FormatBytes(m_report.trace_budget).c_str()
+                                            : "n/a");
+    ImGui::SameLine();
+    ImGui::Text("Total pool budget: %s", m_report.total_budget
+                                            ? FormatBytes(m_report.total_budget).c_str()
+                                            : "n/a");
+}
+
+void
+MemoryUsageWindow::RenderEntry(size_t index)
+{
+    const MemoryReportEntry& entry = m_report.entries[index];
+
+    ImGui::TableNextRow();
+    ImGui::TableSetColumnIndex(0);
+    ImGui::PushID(static_cast<int>(index));
+    bool open = false;
+    if(m_children[index].empty())
+    {
+        ImGui::TreeNodeEx(entry.name.c_str(), ImGuiTreeNodeFlags_Leaf |
+                                                  ImGuiTreeNodeFlags_NoTreePushOnOpen |
+                                                  ImGuiTreeNodeFlags_SpanFullWidth);
+    }
+    else
+    {
+        open = ImGui::TreeNodeEx(entry.name.c_str(), ImGuiTreeNodeFlags_SpanFullWidth);
+    }
+    ImGui::PopID();
+    ImGui::TableSetColumnIndex(1);
+    ImGui::TextUnformatted(FormatBytes(entry.bytes).c_str());
+    ImGui::TableSetColumnIndex(2);
+    ImGui::Text("%llu", static_cast<unsigned long long>(entry.items));
+
+    if(open)
+    {
+        for(size_t child : m_children[index])
+        {
+            RenderEntry(child);
+        }
+        ImGui::TreePop();
+    }
+}
+
+void
+MemoryUsageWindow::RenderTree()
+{
+    constexpr ImGuiTableFlags table_flags =
+        ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerH |
+        ImGuiTableFlags_Resizable | ImGuiTableFlags_SizingStretchProp;
+
+    ImVec2 table_size = ImVec2(0.0f, ImGui::GetContentRegionAvail().y);
+    if(ImGui::BeginTable("##memory_usage", 3, table_flags, table_size))
+    {
+        ImGui::TableSetupColumn("Name", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("Bytes", ImGuiTableColumnFlags_WidthFixed,
+                                MEMORY_PANEL_NUMBER_WIDTH);
+        ImGui::TableSetupColumn("Items", ImGuiTableColumnFlags_WidthFixed,
+                                MEMORY_PANEL_NUMBER_WIDTH);
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableHeadersRow();
+
+        for(size_t root : m_roots)
+        {
+            RenderEntry(root);
+        }
+        ImGui::EndTable();
+    }
+}
+
+void
+MemoryUsageWindow::Render(DataProvider* data_provider, bool* open)
+{
+    if(data_provider != m_data_provider)
+    {
+        m_data_provider = data_provider;
+        m_report        = MemoryReport();
+        BuildTree();
+        Refresh(data_provider);
+    }
+    else if(m_auto_refresh &&
+            ImGui::GetTime() - m_last_refresh_time > MEMORY_PANEL_REFRESH_INTERVAL)
+    {
+        Refresh(data_provider);
+    }
+    if(data_provider && data_provider->TakeMemoryReport(m_report))
+    {
+        BuildTree();
+    }
+
+    ImGui::SetNextWindowSize(
+        ImVec2(MEMORY_PANEL_DEFAULT_WIDTH, MEMORY_PANEL_DEFAULT_HEIGHT),
+        ImGuiCond_FirstUseEver);
+    if(ImGui::Begin("Memory Usage", open, ImGuiWindowFlags_None))
+    {
+        RenderNav(data_provider);
+        ImGui::Separator();
+        RenderTree();
+    }
+    ImGui::End();
+}
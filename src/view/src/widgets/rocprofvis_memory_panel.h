@@ -0,0 +1,42 @@
+// Copyright Advanced Micro Devices, Inc.
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "rocprofvis_data_provider.h"
+#include <vector>
+
+namespace RocProfVis
+{
+namespace View
+{
+
+// Developer-mode panel breaking down the memory held for the current trace by
+// the data model, database, controller and view, with the pool memory budget.
+class MemoryUsageWindow
+{
+public:
+    MemoryUsageWindow();
+
+    // Renders the window for the provider of the current trace, which may be null.
+    void Render(DataProvider* data_provider, bool* open);
+
+private:
+    void RenderNav(DataProvider* data_provider);
+    void RenderTree();
+    void RenderEntry(size_t index);
+    // Requests a new report, it is shown once the provider completes it
+    void Refresh(DataProvider* data_provider);
+    void BuildTree();
+
+    DataProvider*                    m_data_provider;
+    bool                             m_auto_refresh;
+    double                           m_last_refresh_time;
+    MemoryReport                     m_report;
+    // child entry indices of every entry, the roots are kept in m_roots
+    std::vector<std::vector<size_t>> m_children;
+    std::vector<size_t>              m_roots;
+};
+
+}  // namespace View
+}  // namespace RocProfVis
@@ -0,0 +1,244 @@
+// Copyright Advanced Micro Devices, Inc.
+// SPDX-License-Identifier: MIT
+
+#include "rocprofvis_query_profiler.h"
+
+#include "imgui.h"
+
+#include <algorithm>
+#include <filesystem>
+
+using namespace RocProfVis::View;
+
+namespace
+{
+constexpr float  QUERY_PROFILER_DEFAULT_WIDTH    = 900.0f;
+constexpr float  QUERY_PROFILER_DEFAULT_HEIGHT   = 500.0f;
+constexpr float  QUERY_PROFILER_THRESHOLD_WIDTH  = 120.0f;
+constexpr float  QUERY_PROFILER_NUMBER_WIDTH     = 80.0f;
+constexpr double QUERY_PROFILER_REFRESH_INTERVAL = 1.0;
+constexpr double QUERY_PROFILER_DEFAULT_SLOW_MS  = 250.0;
+
+std::string
+FileName(const std::string& path)
+{
+    return std::filesystem::path(path).filename().string();
+}
+}  // namespace
+
+QueryProfilerWindow::QueryProfilerWindow()
+: m_data_provider(nullptr)
+, m_enabled(false)
+, m_slow_query_ms(QUERY_PROFILER_DEFAULT_SLOW_MS)
+, m_last_refresh_time(0.0)
+{}
+
+void
+QueryProfilerWindow::Refresh(DataProvider* data_provider)
+{
+    m_last_refresh_time = ImGui::GetTime();
+    if(data_provider)
+    {
+        data_provider->FetchQueryTelemetry(m_queries, m_slow_queries);
+    }
+    else
+    {
+        m_queries.clear();
+        m_slow_queries.clear();
+    }
+}
+
+void
+QueryProfilerWindow::RenderNav(DataProvider* data_provider)
+{
+    ImGui::BeginDisabled(data_provider == nullptr);
+    if(ImGui::Checkbox("Collect", &m_enabled))
+    {
+        data_provider->SetQueryTelemetry(m_enabled, m_slow_query_ms);
+    }
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(QUERY_PROFILER_THRESHOLD_WIDTH);
+    if(ImGui::InputDouble("Slow query ms", &m_slow_query_ms, 0.0, 0.0, "%.0f",
+                          ImGuiInputTextFlags_EnterReturnsTrue))
+    {
+        m_slow_query_ms = std::max(m_slow_query_ms, 0.0);
+        if(m_enabled)
+        {
+            data_provider->SetQueryTelemetry(m_enabled, m_slow_query_ms);
+        }
+    }
+    ImGui::SameLine();
+    if(ImGui::Button("Refresh"))
+    {
+        Refresh(data_provider);
+    }
+    ImGui::SameLine();
+    if(ImGui::Button("Clear"))
+    {
+        data_provider->ClearQueryTelemetry();
+        Refresh(data_provider);
+    }
+    ImGui::EndDisabled();
+}
+
+void
+QueryProfilerWindow::RenderQueries()
+{
+    constexpr ImGuiTableFlags table_flags =
+        ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerH |
+        ImGuiTableFlags_Resizable | ImGuiTableFlags_SizingStretchProp;
+
+    ImGui::Text("Queries (%zu)", m_queries.size());
+    ImVec2 table_size = ImVec2(0.0f, ImGui::GetContentRegionAvail().y * 0.6f);
+    if(ImGui::BeginTable("##query_profiler_queries", 9, table_flags, table_size))
+    {
+        ImGui::TableSetupColumn("Query", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("Count", ImGuiTableColumnFlags_WidthFixed,
+                                QUERY_PROFILER_NUMBER_WIDTH);
+        ImGui::TableSetupColumn("Failed", ImGuiTableColumnFlags_WidthFixed,
+                                QUERY_PROFILER_NUMBER_WIDTH);
+        ImGui::TableSetupColumn("Total ms", ImGuiTableColumnFlags_WidthFixed,
+                                QUERY_PROFILER_NUMBER_WIDTH);
+        ImGui::TableSetupColumn("Avg ms", ImGuiTableColumnFlags_WidthFixed,
+                                QUERY_PROFILER_NUMBER_WIDTH);
+        ImGui::TableSetupColumn("Max ms", ImGuiTableColumnFlags_WidthFixed,
+                                QUERY_PROFILER_NUMBER_WIDTH);
+        ImGui::TableSetupColumn("Rows", ImGuiTableColumnFlags_WidthFixed,
+                                QUERY_PROFILER_NUMBER_WIDTH);
+        ImGui::TableSetupColumn("Bytes", ImGuiTableColumnFlags_WidthFixed,
+                                QUERY_PROFILER_NUMBER_WIDTH);
+        ImGui::TableSetupColumn("Database", ImGuiTableColumnFlags_WidthFixed,
+                                QUERY_PROFILER_NUMBER_WIDTH * 2);
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableHeadersRow();
+
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(m_queries.size()));
+        while(clipper.Step())
+        {
+            for(int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
+            {
+                const QueryTelemetryStats& stats = m_queries[row];
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0);
+                ImGui::PushID(row);
+                ImGui::Selectable(stats.query_template.c_str(), false,
+                                  ImGuiSelectableFlags_SpanAllColumns);
+                if(ImGui::IsItemHovered())
+                {
+                    ImGui::BeginTooltip();
+                    ImGui::PushTextWrapPos(ImGui::GetFontSize() * 50.0f);
+                    ImGui::TextUnformatted(stats.query_template.c_str());
+                    ImGui::PopTextWrapPos();
+                    ImGui::Separator();
+                    ImGui::TextUnformatted("Query plan");
+                    ImGui::TextUnformatted(stats.plan.empty() ? "(not captured)"
+                                                              : stats.plan.c_str());
+                    ImGui::EndTooltip();
+                }
+                ImGui::PopID();
+                ImGui::TableSetColumnIndex(1);
+                ImGui::Text("%llu", static_cast<unsigned long long>(stats.count));
+                ImGui::TableSetColumnIndex(2);
+                ImGui::Text("%llu", static_cast<unsigned long long>(stats.failures));
+                ImGui::TableSetColumnIndex(3);
+                ImGui::Text("%.2f", stats.total_ms);
+                ImGui::TableSetColumnIndex(4);
+                ImGui::Text("%.2f", stats.count ? stats.total_ms / stats.count : 0.0);
+                ImGui::TableSetColumnIndex(5);
+                ImGui::Text("%.2f", stats.max_ms);
+                ImGui::TableSetColumnIndex(6);
+                ImGui::Text("%llu", static_cast<unsigned long long>(stats.rows));
+                ImGui::TableSetColumnIndex(7);
+                ImGui::Text("%llu", static_cast<unsigned long long>(stats.bytes));
+                ImGui::TableSetColumnIndex(8);
+                ImGui::TextUnformatted(FileName(stats.connection).c_str());
+            }
+        }
+        ImGui::EndTable();
+    }
+}
+
+void
+QueryProfilerWindow::RenderSlowQueries()
+{
+    constexpr ImGuiTableFlags table_flags =
+        ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerH |
+        ImGuiTableFlags_Resizable | ImGuiTableFlags_SizingStretchProp;
+
+    ImGui::Text("Slow and failed queries (%zu)", m_slow_queries.size());
+    ImVec2 table_size = ImVec2(0.0f, ImGui::GetContentRegionAvail().y);
+    if(ImGui::BeginTable("##query_profiler_slow_queries", 6, table_flags, table_size))
+    {
+        ImGui::TableSetupColumn("Time ms", ImGuiTableColumnFlags_WidthFixed,
+                                QUERY_PROFILER_NUMBER_WIDTH);
+        ImGui::TableSetupColumn("Rows", ImGuiTableColumnFlags_WidthFixed,
+                                QUERY_PROFILER_NUMBER_WIDTH);
+        ImGui::TableSetupColumn("Bytes", ImGuiTableColumnFlags_WidthFixed,
+                                QUERY_PROFILER_NUMBER_WIDTH);
+        ImGui::TableSetupColumn("Database", ImGuiTableColumnFlags_WidthFixed,
+                                QUERY_PROFILER_NUMBER_WIDTH * 2);
+        ImGui::TableSetupColumn("Error", ImGuiTableColumnFlags_WidthFixed,
+                                QUERY_PROFILER_NUMBER_WIDTH * 2);
+        ImGui::TableSetupColumn("Query", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableHeadersRow();
+
+        // newest first
+        for(auto it = m_slow_queries.rbegin(); it != m_slow_queries.rend(); ++it)
+        {
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0);
+            ImGui::Text("%.2f", it->duration_ms);
+            ImGui::TableSetColumnIndex(1);
+            ImGui::Text("%llu", static_cast<unsigned long long>(it->rows));
+            ImGui::TableSetColumnIndex(2);
+            ImGui::Text("%llu", static_cast<unsigned long long>(it->bytes));
+            ImGui::TableSetColumnIndex(3);
+            ImGui::TextUnformatted(FileName(it->connection).c_str());
+            ImGui::TableSetColumnIndex(4);
+            ImGui::TextUnformatted(it->error.c_str());
+            ImGui::TableSetColumnIndex(5);
+            ImGui::TextUnformatted(it->query.c_str());
+            if(ImGui::IsItemHovered())
+            {
+                ImGui::BeginTooltip();
+                ImGui::PushTextWrapPos(ImGui::GetFontSize() * 50.0f);
+                ImGui::TextUnformatted(it->query.c_str());
+                ImGui::PopTextWrapPos();
+                ImGui::EndTooltip();
+            }
+        }
+        ImGui::EndTable();
+    }
+}
+
+void
+QueryProfilerWindow::Render(DataProvider* data_provider, bool* open)
+{
+    if(data_provider != m_data_provider)
+    {
+        // collection state belongs to the trace, start over on a trace switch
+        m_data_provider = data_provider;
+        m_enabled       = false;
+        Refresh(data_provider);
+    }
+    else if(m_enabled &&
+            ImGui::GetTime() - m_last_refresh_time > QUERY_PROFILER_REFRESH_INTERVAL)
+    {
+        Refresh(data_provider);
+    }
+
+    ImGui::SetNextWindowSize(
+        ImVec2(QUERY_PROFILER_DEFAULT_WIDTH, QUERY_PROFILER_DEFAULT_HEIGHT),
+        ImGuiCond_FirstUseEver);
+    if(ImGui::Begin("Query Profiler", open, ImGuiWindowFlags_None))
+    {
+        RenderNav(data_provider);
+        ImGui::Separator();
+        RenderQueries();
+        ImGui::Separator();
+        RenderSlowQueries();
+    }
+    ImGui::End();
+}
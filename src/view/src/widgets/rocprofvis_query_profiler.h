@@ -0,0 +1,40 @@
+// Copyright Advanced Micro Devices, Inc.
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "rocprofvis_data_provider.h"
+#include <string>
+#include <vector>
+
+namespace RocProfVis
+{
+namespace View
+{
+
+// Developer-mode panel for the SQL query telemetry of the current trace: per
+// template statistics with the captured query plan, and the slow query log.
+class QueryProfilerWindow
+{
+public:
+    QueryProfilerWindow();
+
+    // Renders the window for the provider of the current trace, which may be null.
+    void Render(DataProvider* data_provider, bool* open);
+
+private:
+    void RenderNav(DataProvider* data_provider);
+    void RenderQueries();
+    void RenderSlowQueries();
+    void Refresh(DataProvider* data_provider);
+
+    DataProvider*                    m_data_provider;
+    bool                             m_enabled;
+    double                           m_slow_query_ms;
+    double                           m_last_refresh_time;
+    std::vector<QueryTelemetryStats> m_queries;
+    std::vector<SlowQueryInfo>       m_slow_queries;
+};
+
+}  // namespace View
+}  // namespace RocProfVis
@@ -9,9 +9,12 @@
 #include "imgui.h"
 
 #include "rocprofvis_analysis_view.h"
+#include "rocprofvis_batch_runner.h"
+#include "rocprofvis_data_provider.h"
 #include "rocprofvis_event_search.h"
 #include "rocprofvis_events_view.h"
 #include "rocprofvis_flame_track_item.h"
+#include "rocprofvis_line_track_item.h"
 #include "rocprofvis_measurement_controller.h"
 #include "rocprofvis_minimap.h"
 #include "rocprofvis_summary_view.h"
@@ -25,11 +28,61 @@
 #include "widgets/rocprofvis_infinite_scroll_table.h"
 #include "widgets/rocprofvis_tab_container.h"
 
+#include <sstream>
+
 namespace RocProfVis
 {
 namespace View
 {
 
+// Prefetch planning helpers of the data provider, they depend on no provider state.
+struct DataProviderTestPeer
+{
+    using Direction = DataProvider::PrefetchDirection;
+
+    static bool IsPrefetchStale(Direction issued, Direction current)
+    {
+        return DataProvider::IsPrefetchStale(issued, current);
+    }
+    static void GetPrefetchRange(Direction direction, double view_width,
+                                 double loaded_start_ts, double loaded_end_ts,
+                                 uint32_t loaded_resolution, double& start_ts,
+                                 double& end_ts, uint32_t& resolution)
+    {
+        DataProvider::GetPrefetchRange(direction, view_width, loaded_start_ts,
+                                       loaded_end_ts, loaded_resolution, start_ts, end_ts,
+                                       resolution);
+    }
+};
+
+// Per-pixel counter decimation, a pure function of the samples and the zoom.
+struct LineTrackItemTestPeer
+{
+    using DecimatedSamples = LineTrackItem::DecimatedSamples;
+
+    static std::shared_ptr<const DecimatedSamples> Decimate(
+        std::shared_ptr<const std::vector<TraceCounter>> source, double min_x,
+        double pixels_per_ns, const std::atomic<bool>* cancelled = nullptr)
+    {
+        return LineTrackItem::Decimate(source, min_x, pixels_per_ns, cancelled);
+    }
+};
+
+// Batch script parsing, runs without a trace or a controller.
+struct BatchRunnerTestPeer
+{
+    BatchRunner& v;
+    bool Parse(const std::string& script)
+    {
+        std::istringstream input(script);
+        return v.ParseScript(input);
+    }
+    size_t CommandCount() const { return v.m_commands.size(); }
+    const std::string& Name(size_t i) const { return v.m_commands[i].name; }
+    const std::string& Line(size_t i) const { return v.m_commands[i].line; }
+    const std::vector<std::string>& Args(size_t i) const { return v.m_commands[i].args; }
+};
+
 struct EventsViewTestPeer
 {
     const EventsView& v;
@@ -138,7 +191,7 @@ struct FlameTrackItemTestPeer
         else
         {
             v.m_event_options->m_height = v.DefaultTrackHeight();
-            v.m_track_height_changed    = true;
+            v.MarkTrackHeightChanged();
             v.m_event_options->m_expand = false;
         }
     }
@@ -148,11 +201,36 @@ struct FlameTrackItemTestPeer
     void SetTrackHeight(float height)
     {
         v.m_event_options->m_height = height;
-        v.m_track_height_changed    = true;
+        v.MarkTrackHeightChanged();
     }
 
     size_t ChartItemCount() const { return v.m_chart_items.size(); }
 
+    // Geometry cache rebuild decision, a pure function of the cache and the key.
+    using GeometryKey   = FlameTrackItem::GeometryKey;
+    using GeometryCache = FlameTrackItem::GeometryCache;
+    static bool NeedsGeometryRebuild(const GeometryCache& cache, const GeometryKey& key,
+                                     double pan_x)
+    {
+        return FlameTrackItem::NeedsGeometryRebuild(cache, key, pan_x);
+    }
+    bool GeometryCacheBuilt() const { return v.m_geometry_cache.built; }
+    // Runs the same path as a data response for the already loaded track data.
+    void ReextractData() { v.ExtractPointsFromData(); }
+
+    // Label cut of event names at the current font.
+    static size_t VisibleLabelLength(const std::string& label, float available_width)
+    {
+        return FlameTrackItem::VisibleLabelLength(label, std::hash<std::string>{}(label),
+                                                  available_width);
+    }
+    static std::vector<float> LabelPrefixWidths(const std::string& label)
+    {
+        VisibleLabelLength(label, 0.0f);
+        return FlameTrackItem::s_label_layouts[std::hash<std::string>{}(label)]
+            .prefix_widths;
+    }
+
     // Identity of the earliest event (smallest m_start_ts) in this track. Chart
     // item ordering is not guaranteed stable, so tests pick by timestamp rather
     // than index. Returns false when the track holds no events.